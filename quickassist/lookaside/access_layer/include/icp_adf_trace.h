@@ -0,0 +1,126 @@
+/*****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ *****************************************************************************/
+
+/*****************************************************************************
+ * @file icp_adf_trace.h
+ *
+ * @description
+ *      File contains the trace points of the request lifecycle trace. The
+ *      record and file layouts are described in icp_sal_trace.h.
+ *
+ *****************************************************************************/
+#ifndef ICP_ADF_TRACE_H
+#define ICP_ADF_TRACE_H
+
+#include "cpa.h"
+#include "icp_sal_trace.h"
+
+/*
+ * Identifier standing for the last request enqueued by the calling thread
+ */
+#define ICP_ADF_TRACE_ID_CURRENT (~0ULL)
+
+/*
+ * Non-zero while tracing is enabled. Only read by ICP_ADF_TRACE.
+ */
+extern volatile Cpa32U icp_adf_traceEnabled;
+
+/*
+ * icp_adf_traceRecord
+ *
+ * Description:
+ * Record an event in the calling thread's trace ring. ENQUEUE events also
+ * make id the thread's current request.
+ */
+void icp_adf_traceRecord(Cpa16U event, Cpa64U id, Cpa32U arg);
+
+/*
+ * ICP_ADF_TRACE
+ *
+ * Description:
+ * Trace point. Costs a predicted branch while tracing is disabled.
+ */
+#define ICP_ADF_TRACE(event, id, arg)                                          \
+    do                                                                         \
+    {                                                                          \
+        if (__builtin_expect(icp_adf_traceEnabled, 0))                         \
+        {                                                                      \
+            icp_adf_traceRecord((event), (Cpa64U)(id), (arg));                 \
+        }                                                                      \
+    } while (0)
+
+/*
+ * The functions below implement the icp_sal_Trace API of the same names.
+ */
+CpaStatus icp_adf_traceEnable(Cpa32U numEntries);
+
+CpaStatus icp_adf_traceDisable(void);
+
+CpaStatus icp_adf_traceDump(const char *fileName);
+
+CpaStatus icp_adf_traceFree(void);
+
+CpaStatus icp_adf_traceMeasureOverhead(Cpa32U numEvents,
+                                       Cpa64U *pDisabledNs,
+                                       Cpa64U *pEnabledNs);
+
+#endif /* ICP_ADF_TRACE_H */
@@ -248,6 +248,25 @@ CpaStatus icp_adf_transPutMsg(icp_comms_trans_handle trans_handle,
                               Cpa32U bufLen,
                               Cpa64U *seq_num);
 
+/*
+ * icp_adf_transPutMsgs
+ *
+ * Description:
+ * Put up to numMsgs messages onto the transport handle, making them
+ * visible to the device with a single tail update. numPut returns how
+ * many messages fitted on the ring.
+ *
+ * Returns:
+ *   CPA_STATUS_SUCCESS   at least one message was put
+ *   CPA_STATUS_RETRY     the ring is full
+ *   CPA_STATUS_FAIL      on failure
+ */
+CpaStatus icp_adf_transPutMsgs(icp_comms_trans_handle trans_handle,
+                               Cpa32U **inBufs,
+                               Cpa32U bufLen,
+                               Cpa32U numMsgs,
+                               Cpa32U *numPut);
+
 /*
  * icp_adf_getInflightRequests
  *
@@ -263,6 +282,33 @@ CpaStatus icp_adf_getInflightRequests(icp_comms_trans_handle trans_handle,
                                       Cpa32U *maxInflightRequests,
                                       Cpa32U *numInflightRequests);
 
+/*
+ * Wakeup notifier attached to a request ring.
+ * When armed is non-zero the next message put on the ring clears it and
+ * writes to the eventfd fd, so a polling thread blocked on fd learns that
+ * new requests are in flight.
+ */
+typedef struct icp_adf_wakeup_s
+{
+    int fd;
+    volatile Cpa32U armed;
+} icp_adf_wakeup_t;
+
+/*
+ * icp_adf_transSetWakeup
+ *
+ * Description:
+ * Attach a wakeup notifier to a request ring, or detach it when wakeup
+ * is NULL. The caller must ensure no message is being put on the ring
+ * while the notifier is detached.
+ *
+ * Returns:
+ *   CPA_STATUS_SUCCESS        on success
+ *   CPA_STATUS_INVALID_PARAM  invalid parameter
+ */
+CpaStatus icp_adf_transSetWakeup(icp_comms_trans_handle trans_handle,
+                                 icp_adf_wakeup_t *wakeup);
+
 /*
  * icp_adf_transPutMsgSync
  *
@@ -105,6 +105,32 @@ extern "C" {
  * @retval CPA_STATUS_FAIL           Operation failed
  */
 CpaStatus icp_sal_dc_simulate_error(Cpa8U numErrors, Cpa8S dcError);
+
+/*
+ * icp_sal_dc_simulate_retry
+ *
+ * @description:
+ *  This function makes a defined number of compression requests fail to
+ *  be sent with CPA_STATUS_RETRY, as if the request ring was full
+ *
+ * @context
+ *      This function is called from the user process context
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in] numRetries             Num requests to reject
+ *                                   0 - No rejection
+ *                                   1-0xFE - Num requests to reject
+ *                                   0xFF - Always reject requests
+ * @retval CPA_STATUS_SUCCESS        No error
+ */
+CpaStatus icp_sal_dc_simulate_retry(Cpa8U numRetries);
 #endif
 
 /*
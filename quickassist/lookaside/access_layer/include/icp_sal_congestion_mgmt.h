@@ -119,6 +119,28 @@ CpaStatus icp_sal_AsymGetInflightRequests(CpaInstanceHandle instanceHandle,
                                           Cpa32U *maxInflightRequests,
                                           Cpa32U *numInflightRequests);
 
+/*
+ *****************************************************************************
+ * @ingroup SalUserCongsMgmt
+ *      Compression get in-flight requests
+ *
+ * @description
+ *      This function is used to fetch in-flight and max in-flight request
+ *      counts for the given compression instance handle.
+ *
+ * @param[in]  instanceHandle         Compression instance handle
+ * @param[out] maxInflightRequests    Max in-flight request count
+ * @param[out] numInflightRequests    Current in-flight request count
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcGetInflightRequests(CpaInstanceHandle instanceHandle,
+                                        Cpa32U *maxInflightRequests,
+                                        Cpa32U *numInflightRequests);
+
 /*
  *****************************************************************************
  * @ingroup SalUserCongsMgmt
@@ -0,0 +1,167 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+/*
+ ***************************************************************************
+ * @file icp_sal_dc_chain_batch.h
+ *
+ * @ingroup SalDcChainBatch
+ *
+ * This file contains the function prototype for submitting a burst of
+ * compression and crypto chaining requests on one chaining session with
+ * a single ring doorbell.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_DC_CHAIN_BATCH_H
+#define ICP_SAL_DC_CHAIN_BATCH_H
+
+#include "cpa.h"
+#include "cpa_dc_chain.h"
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcChainBatch
+ *      Maximum number of requests in one batch
+ *
+ *****************************************************************************/
+#define ICP_SAL_DC_CHAIN_MAX_BATCH (256)
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcChainBatch
+ *      One chaining request of a batch
+ *
+ * @description
+ *      The arguments cpaDcChainPerformOp takes for a single request.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_dc_chain_request_s
+{
+    CpaBufferList *pSrcBuff;
+    /**< Source buffer */
+    CpaBufferList *pDestBuff;
+    /**< Destination buffer */
+    CpaDcChainOpData *pChainOpData;
+    /**< Array of numOpDatas operations, one per link of the chain */
+    CpaDcChainRqResults *pResults;
+    /**< Results of the request */
+    void *callbackTag;
+    /**< Opaque tag passed to the session callback */
+} icp_sal_dc_chain_request_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcChainBatch
+ *      Submit a batch of chaining requests
+ *
+ * @description
+ *      Builds numRequests chaining requests as cpaDcChainPerformOp does
+ *      and puts them on the ring with a single tail update. Each request
+ *      completes through the session callback with its own callbackTag.
+ *
+ *      Requests are submitted in order and the batch stops at the first
+ *      one that cannot be: when the ring fills up, when no more cookies
+ *      are available or when a request is invalid. As long as one request
+ *      was submitted the function returns CPA_STATUS_SUCCESS, and
+ *      *pNumSubmitted tells how many were. The caller resubmits the
+ *      remaining requests, which reports the error of the first of them
+ *      if it persists.
+ *
+ * @context
+ *      This function cannot sleep. It can be executed in a context that
+ *      does not permit sleeping.
+ * @assumptions
+ *      The session was initialised with a callback function.
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  dcInstance            Compression instance handle
+ * @param[in]  pSessionHandle        Chaining session handle
+ * @param[in]  operation             Chaining operation of the session
+ * @param[in]  numOpDatas            Number of links of the chain
+ * @param[in]  pRequests             Array of numRequests requests
+ * @param[in]  numRequests           Number of requests, at most
+ *                                   ICP_SAL_DC_CHAIN_MAX_BATCH
+ * @param[out] pNumSubmitted         Number of requests submitted
+ *
+ * @retval CPA_STATUS_SUCCESS        At least one request was submitted
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RETRY          Resubmit the batch
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ * @retval CPA_STATUS_UNSUPPORTED    Chaining is not supported
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcChainPerformOpBatch(CpaInstanceHandle dcInstance,
+                                        CpaDcSessionHandle pSessionHandle,
+                                        CpaDcChainOperations operation,
+                                        Cpa8U numOpDatas,
+                                        icp_sal_dc_chain_request_t *pRequests,
+                                        Cpa32U numRequests,
+                                        Cpa32U *pNumSubmitted);
+
+#endif
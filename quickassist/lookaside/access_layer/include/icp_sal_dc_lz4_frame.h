@@ -0,0 +1,293 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_dc_lz4_frame.h
+ *
+ * @ingroup SalDcLz4Frame
+ *
+ * This file contains the function prototypes for the LZ4 frame
+ * compression APIs, which write complete LZ4 frames, with header, block
+ * checksums and footer, around the output of several blocks in flight on
+ * a compression instance.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_DC_LZ4_FRAME_H
+#define ICP_SAL_DC_LZ4_FRAME_H
+
+#include "cpa.h"
+#include "cpa_dc.h"
+
+/**< Blocks in flight when icp_sal_dc_lz4_frame_setup_t.maxInflight is 0 */
+#define ICP_SAL_DC_LZ4_FRAME_DEFAULT_INFLIGHT (8)
+
+/**< Upper bound on the blocks in flight on one frame stream */
+#define ICP_SAL_DC_LZ4_FRAME_MAX_INFLIGHT (64)
+
+/**< Upper bound on the buffers of a destination buffer list */
+#define ICP_SAL_DC_LZ4_FRAME_MAX_BUFFERS (16)
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcLz4Frame
+ *      LZ4 frame stream handle
+ *
+ * @description
+ *      Handle to an LZ4 frame stream created by icp_sal_DcLz4FrameCreate.
+ *
+ *****************************************************************************/
+typedef void *icp_sal_dc_lz4_frame_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcLz4Frame
+ *      LZ4 frame stream setup data
+ *
+ * @description
+ *      The frames use independent blocks. blockChecksum and
+ *      contentChecksum set the B.Checksum and C.Checksum flags of the
+ *      frame header. Both checksums are XXH32 computed by the host as the
+ *      blocks complete, so each costs a pass over the compressed or the
+ *      input data on the completing thread.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_dc_lz4_frame_setup_s
+{
+    CpaDcCompLvl compLevel;
+    /**< Compression level */
+    CpaDcCompLZ4BlockMaxSize blockMaxSize;
+    /**< Block maximum size of the frame, also the largest input of a block */
+    CpaBoolean blockChecksum;
+    /**< CPA_TRUE to follow every data block with its XXH32 */
+    CpaBoolean contentChecksum;
+    /**< CPA_TRUE to end every frame with the XXH32 of its content */
+    Cpa32U maxInflight;
+    /**< Blocks of the stream in flight at once, 0 for
+     * ICP_SAL_DC_LZ4_FRAME_DEFAULT_INFLIGHT */
+} icp_sal_dc_lz4_frame_setup_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcLz4Frame
+ *      Create an LZ4 frame stream
+ *
+ * @description
+ *      Creates a stream of LZ4 frames on a compression instance. Every
+ *      input passed to icp_sal_DcLz4FrameCompress becomes one independent
+ *      data block of the current frame, so that up to pSetup->maxInflight
+ *      of them are compressed at once. Written back to back, the outputs
+ *      of the blocks form LZ4 frames as read by the reference lz4 tool.
+ *
+ *      pCallback is called once for every block, in the order the blocks
+ *      were submitted, whatever order the hardware completes them in.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      The instance is started, has address translation set up and
+ *      supports LZ4 compression.
+ * @sideEffects
+ *      Creates a stateless session on the instance.
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Compression instance handle
+ * @param[in]  pSetup                Frame stream setup data
+ * @param[in]  pCallback             Completion callback of the blocks
+ * @param[out] pFrame                Created frame stream
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ * @retval CPA_STATUS_UNSUPPORTED    The instance does not support LZ4
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcLz4FrameCreate(CpaInstanceHandle instanceHandle,
+                                   const icp_sal_dc_lz4_frame_setup_t *pSetup,
+                                   CpaDcCallbackFn pCallback,
+                                   icp_sal_dc_lz4_frame_t *pFrame);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcLz4Frame
+ *      Size the destination of a block
+ *
+ * @description
+ *      Returns the destination size icp_sal_DcLz4FrameCompress needs for
+ *      a block of inputSize bytes, including room for the frame header,
+ *      the block checksum and the frame footer.
+ *
+ * @param[in]  frame                 Frame stream handle
+ * @param[in]  inputSize             Block input size in bytes
+ * @param[out] pOutputSize           Required destination size in bytes
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcLz4FrameCompressBound(icp_sal_dc_lz4_frame_t frame,
+                                          Cpa32U inputSize,
+                                          Cpa32U *pOutputSize);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcLz4Frame
+ *      Submit the next block of a frame
+ *
+ * @description
+ *      Submits pSrcBuff as the next data block of the current frame and
+ *      returns without waiting for it. The source must be no larger than
+ *      the block maximum size of the stream.
+ *
+ *      The compressed block is written in place behind space reserved in
+ *      pDestBuff, so no data is copied to add the frame around it: the
+ *      first block of a frame is preceded by the frame header, every block
+ *      is followed by its checksum when block checksums are on, and the
+ *      block with lastBlock set is followed by the end mark and content
+ *      checksum. The next block submitted after the last one starts a new
+ *      frame.
+ *
+ *      When the callback runs, pResults->consumed is the length of the
+ *      block input, pResults->produced the number of bytes written to
+ *      pDestBuff, frame header and footer included, and
+ *      pResults->checksum the XXH32 of the frame content up to and
+ *      including the block when content checksums are on, 0 otherwise.
+ *
+ *      Blocks must be submitted from one thread at a time. The buffers
+ *      and pResults must stay valid until the callback of the block.
+ *
+ * @context
+ *      This function may be called from the callback of the stream.
+ * @assumptions
+ *      The buffers are DMA-able memory.
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  frame                 Frame stream handle
+ * @param[in]  pSrcBuff              Block input, at most the block
+ *                                   maximum size
+ * @param[out] pDestBuff             Destination of the block, at least
+ *                                   icp_sal_DcLz4FrameCompressBound() bytes
+ *                                   in at most
+ *                                   ICP_SAL_DC_LZ4_FRAME_MAX_BUFFERS
+ *                                   buffers
+ * @param[out] pResults              Results of the block
+ * @param[in]  lastBlock             CPA_TRUE for the last block of the
+ *                                   frame
+ * @param[in]  callbackTag           Passed to the callback of the stream
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_RETRY          maxInflight blocks are in flight or
+ *                                   the ring is full, resubmit later
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcLz4FrameCompress(icp_sal_dc_lz4_frame_t frame,
+                                     CpaBufferList *pSrcBuff,
+                                     CpaBufferList *pDestBuff,
+                                     CpaDcRqResults *pResults,
+                                     CpaBoolean lastBlock,
+                                     void *callbackTag);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcLz4Frame
+ *      Remove an LZ4 frame stream
+ *
+ * @description
+ *      Removes the session of the stream and frees it.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  frame                 Frame stream handle
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_RETRY          Blocks of the stream are in flight
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcLz4FrameRemove(icp_sal_dc_lz4_frame_t frame);
+
+#endif
@@ -0,0 +1,260 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_dc_ns_prepared.h
+ *
+ * @ingroup SalDcNsPrepared
+ *
+ * This file contains the function prototypes for prepared no-session
+ * compression, which validates a CpaDcNsSetupData and builds its firmware
+ * request template once, ahead of the requests that use it.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_DC_NS_PREPARED_H
+#define ICP_SAL_DC_NS_PREPARED_H
+
+#include "cpa.h"
+#include "cpa_dc.h"
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcNsPrepared
+ *      Prepared no-session setup handle
+ *
+ * @description
+ *      Opaque handle to a checked copy of a CpaDcNsSetupData together with
+ *      the firmware request built from it.
+ *
+ *****************************************************************************/
+typedef void *icp_sal_dc_ns_prepared_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcNsPrepared
+ *      Prepare a no-session setup
+ *
+ * @description
+ *      Checks pSetupData against the instance and builds the request
+ *      template that cpaDcNsCompressData and cpaDcNsDecompressData
+ *      otherwise rebuild on every call. The setup data is copied, so the
+ *      caller may release it on return. The direction of the handle is
+ *      pSetupData->sessDirection, which must be CPA_DC_DIR_COMPRESS or
+ *      CPA_DC_DIR_DECOMPRESS.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  dcInstance            Compression instance handle
+ * @param[in]  pSetupData            No-session setup data
+ * @param[out] pPrepared             Prepared setup handle
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ * @retval CPA_STATUS_UNSUPPORTED    The setup is not supported
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcNsPrepare(CpaInstanceHandle dcInstance,
+                              CpaDcNsSetupData *pSetupData,
+                              icp_sal_dc_ns_prepared_t *pPrepared);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcNsPrepared
+ *      Compress with a prepared no-session setup
+ *
+ * @description
+ *      Behaves as cpaDcNsCompressData on the instance and setup data the
+ *      handle was prepared from. Only the request specific parameters are
+ *      checked, and the firmware request is copied from the template
+ *      rather than built.
+ *
+ * @context
+ *      When called as an asynchronous function it cannot sleep. It can be
+ *      executed in a context that does not permit sleeping.
+ *      When called as a synchronous function it may sleep. It MUST NOT be
+ *      executed in a context that DOES NOT permit sleeping.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  prepared              Handle prepared for compression
+ * @param[in]  pSrcBuff              Data to compress
+ * @param[out] pDestBuff             Compressed data
+ * @param[in]  pOpData               Request parameters
+ * @param[out] pResults              Results of the request
+ * @param[in]  callbackFn            Callback, NULL for a synchronous call
+ * @param[in]  callbackTag           Opaque tag passed to the callback
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RETRY          Resubmit the request
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ * @retval CPA_STATUS_UNSUPPORTED    The request is not supported
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcNsCompressDataPrepared(icp_sal_dc_ns_prepared_t prepared,
+                                           CpaBufferList *pSrcBuff,
+                                           CpaBufferList *pDestBuff,
+                                           CpaDcOpData *pOpData,
+                                           CpaDcRqResults *pResults,
+                                           CpaDcCallbackFn callbackFn,
+                                           void *callbackTag);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcNsPrepared
+ *      Decompress with a prepared no-session setup
+ *
+ * @description
+ *      Behaves as cpaDcNsDecompressData on the instance and setup data the
+ *      handle was prepared from, with the same savings as
+ *      icp_sal_DcNsCompressDataPrepared.
+ *
+ * @context
+ *      When called as an asynchronous function it cannot sleep. It can be
+ *      executed in a context that does not permit sleeping.
+ *      When called as a synchronous function it may sleep. It MUST NOT be
+ *      executed in a context that DOES NOT permit sleeping.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  prepared              Handle prepared for decompression
+ * @param[in]  pSrcBuff              Data to decompress
+ * @param[out] pDestBuff             Decompressed data
+ * @param[in]  pOpData               Request parameters
+ * @param[out] pResults              Results of the request
+ * @param[in]  callbackFn            Callback, NULL for a synchronous call
+ * @param[in]  callbackTag           Opaque tag passed to the callback
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RETRY          Resubmit the request
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcNsDecompressDataPrepared(
+    icp_sal_dc_ns_prepared_t prepared,
+    CpaBufferList *pSrcBuff,
+    CpaBufferList *pDestBuff,
+    CpaDcOpData *pOpData,
+    CpaDcRqResults *pResults,
+    CpaDcCallbackFn callbackFn,
+    void *callbackTag);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcNsPrepared
+ *      Free a prepared no-session setup
+ *
+ * @description
+ *      The handle must not be in use by any request in flight.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  prepared              Prepared setup handle
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcNsFreePrepared(icp_sal_dc_ns_prepared_t prepared);
+
+#endif
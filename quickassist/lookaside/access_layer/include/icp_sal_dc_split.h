@@ -0,0 +1,207 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_dc_split.h
+ *
+ * @ingroup SalDcSplit
+ *
+ * This file contains the function prototypes for the split compression
+ * APIs, which compress one large buffer across several compression
+ * instances.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_DC_SPLIT_H
+#define ICP_SAL_DC_SPLIT_H
+
+#include "cpa.h"
+#include "cpa_dc.h"
+
+/**< Chunk size used when icp_sal_dc_split_setup_t.chunkSize is 0 */
+#define ICP_SAL_DC_SPLIT_DEFAULT_CHUNK_SIZE (256 * 1024)
+
+/**< Smallest accepted chunk size */
+#define ICP_SAL_DC_SPLIT_MIN_CHUNK_SIZE (4 * 1024)
+
+/**< Upper bound on the number of instances of one split request */
+#define ICP_SAL_DC_SPLIT_MAX_INSTANCES (64)
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcSplit
+ *      Split compression setup data
+ *
+ * @description
+ *      The checksum selects the container of the output: CPA_DC_CRC32
+ *      produces a gzip (RFC 1952) member and CPA_DC_ADLER32 a zlib
+ *      (RFC 1950) stream.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_dc_split_setup_s
+{
+    CpaDcCompLvl compLevel;
+    /**< Compression level */
+    CpaDcHuffType huffType;
+    /**< Huffman tree type */
+    CpaDcChecksum checksum;
+    /**< CPA_DC_CRC32 (gzip) or CPA_DC_ADLER32 (zlib) */
+    Cpa32U chunkSize;
+    /**< Bytes of input per independently compressed chunk, 0 for
+     * ICP_SAL_DC_SPLIT_DEFAULT_CHUNK_SIZE */
+} icp_sal_dc_split_setup_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcSplit
+ *      Size the destination buffer of a split compression
+ *
+ * @description
+ *      Returns the destination buffer size icp_sal_DcSplitCompress needs
+ *      for an input of inputSize bytes on the given instances. This covers
+ *      the worst case of every chunk as well as the stream header and
+ *      footer.
+ *
+ * @param[in]  pInstances            Array of compression instance handles
+ * @param[in]  numInstances          Number of instances
+ * @param[in]  pSetup                Split compression setup data
+ * @param[in]  inputSize             Input size in bytes
+ * @param[out] pOutputSize           Required destination size in bytes
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcSplitCompressBound(const CpaInstanceHandle *pInstances,
+                                       Cpa32U numInstances,
+                                       const icp_sal_dc_split_setup_t *pSetup,
+                                       Cpa32U inputSize,
+                                       Cpa64U *pOutputSize);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcSplit
+ *      Compress a buffer across several compression instances
+ *
+ * @description
+ *      The source buffer is cut into chunks of pSetup->chunkSize bytes which
+ *      are compressed statelessly and independently of each other. Chunks
+ *      are handed to whichever instance has room, up to a small number in
+ *      flight on each instance, so the latency of a large request scales
+ *      down with the number of instances given.
+ *
+ *      Every chunk but the last is ended with a full flush, leaving the
+ *      deflate stream byte aligned and open. The outputs are then laid out
+ *      back to back behind the stream header, the per-chunk checksums are
+ *      combined and the footer is written, so the destination holds a
+ *      single gzip or zlib stream. Chunks share no history, which costs
+ *      some compression ratio for small chunk sizes.
+ *
+ *      The call is synchronous. It polls the instances itself, which is
+ *      safe alongside polling threads of the application.
+ *
+ *      On return pResults->consumed is the source length, pResults->produced
+ *      the length of the stream and pResults->checksum its CRC-32 or
+ *      Adler-32. When a chunk fails, pResults->status holds its error.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      The instances are started, have address translation set up and
+ *      support compress and verify. The source and destination buffers are
+ *      DMA-able memory.
+ * @sideEffects
+ *      Creates and removes a stateless session on each instance.
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  pInstances            Array of compression instance handles
+ * @param[in]  numInstances          Number of instances, at most
+ *                                   ICP_SAL_DC_SPLIT_MAX_INSTANCES
+ * @param[in]  pSetup                Split compression setup data
+ * @param[in]  pSrcBuff              Data to compress
+ * @param[out] pDestBuff             Destination of the stream, at least
+ *                                   icp_sal_DcSplitCompressBound() bytes
+ * @param[out] pResults              Results of the whole request
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           A chunk failed or was not returned in
+ *                                   time
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESTARTING     An instance is restarting
+ * @retval CPA_STATUS_UNSUPPORTED    An instance lacks a required feature
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcSplitCompress(const CpaInstanceHandle *pInstances,
+                                  Cpa32U numInstances,
+                                  const icp_sal_dc_split_setup_t *pSetup,
+                                  CpaFlatBuffer *pSrcBuff,
+                                  CpaFlatBuffer *pDestBuff,
+                                  CpaDcRqResults *pResults);
+
+#endif
@@ -0,0 +1,284 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_dc_stream.h
+ *
+ * @ingroup SalDcStream
+ *
+ * This file contains the function prototypes for the pipelined stream
+ * compression APIs, which keep several consecutive chunks of one deflate
+ * stream in flight on a compression instance.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_DC_STREAM_H
+#define ICP_SAL_DC_STREAM_H
+
+#include "cpa.h"
+#include "cpa_dc.h"
+
+/**< Chunks in flight when icp_sal_dc_stream_setup_t.maxInflight is 0 */
+#define ICP_SAL_DC_STREAM_DEFAULT_INFLIGHT (8)
+
+/**< Upper bound on the chunks in flight on one stream */
+#define ICP_SAL_DC_STREAM_MAX_INFLIGHT (64)
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcStream
+ *      Stream compression handle
+ *
+ * @description
+ *      Handle to a compression stream created by icp_sal_DcStreamCreate.
+ *
+ *****************************************************************************/
+typedef void *icp_sal_dc_stream_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcStream
+ *      Stream compression setup data
+ *
+ * @description
+ *      The checksum selects the container of the output: CPA_DC_CRC32
+ *      produces a gzip (RFC 1952) member and CPA_DC_ADLER32 a zlib
+ *      (RFC 1950) stream.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_dc_stream_setup_s
+{
+    CpaDcCompLvl compLevel;
+    /**< Compression level */
+    CpaDcHuffType huffType;
+    /**< Huffman tree type */
+    CpaDcChecksum checksum;
+    /**< CPA_DC_CRC32 (gzip) or CPA_DC_ADLER32 (zlib) */
+    Cpa32U maxInflight;
+    /**< Chunks of the stream in flight at once, 0 for
+     * ICP_SAL_DC_STREAM_DEFAULT_INFLIGHT. 1 serialises the stream like a
+     * stateful session. */
+} icp_sal_dc_stream_setup_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcStream
+ *      Create a compression stream
+ *
+ * @description
+ *      Creates a stream on a compression instance. Chunks passed to
+ *      icp_sal_DcStreamCompress are compressed statelessly, so that up to
+ *      pSetup->maxInflight of them are processed at once. Every chunk but
+ *      the last ends with a full flush, which leaves the deflate stream
+ *      byte aligned and open. Written back to back, the outputs of the
+ *      chunks form a single gzip or zlib stream.
+ *
+ *      The chunks share no history: every chunk is compressed as if it
+ *      were the start of the data, since the hardware cannot prime a
+ *      stateless request with the previous chunk or a preset dictionary.
+ *      Neither a history window across chunks nor a preset dictionary
+ *      (zlib FDICT) is supported. This costs some compression ratio for
+ *      small chunks; a stream that needs either must use a stateful
+ *      session (CPA_DC_STATEFUL) instead, at one request in flight.
+ *
+ *      pCallback is called once for every chunk, in the order the chunks
+ *      were submitted, whatever order the hardware completes them in.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      The instance is started, has address translation set up and
+ *      supports compress and verify.
+ * @sideEffects
+ *      Creates a stateless session on the instance.
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Compression instance handle
+ * @param[in]  pSetup                Stream setup data
+ * @param[in]  pCallback             Completion callback of the chunks
+ * @param[out] pStream               Created stream
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ * @retval CPA_STATUS_UNSUPPORTED    The instance lacks a required feature
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcStreamCreate(CpaInstanceHandle instanceHandle,
+                                 const icp_sal_dc_stream_setup_t *pSetup,
+                                 CpaDcCallbackFn pCallback,
+                                 icp_sal_dc_stream_t *pStream);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcStream
+ *      Size the destination buffer of a chunk
+ *
+ * @description
+ *      Returns the destination buffer size icp_sal_DcStreamCompress needs
+ *      for a chunk of inputSize bytes, including room for the stream
+ *      header and footer.
+ *
+ * @param[in]  stream                Stream handle
+ * @param[in]  inputSize             Chunk size in bytes
+ * @param[out] pOutputSize           Required destination size in bytes
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcStreamCompressBound(icp_sal_dc_stream_t stream,
+                                        Cpa32U inputSize,
+                                        Cpa32U *pOutputSize);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcStream
+ *      Submit the next chunk of a stream
+ *
+ * @description
+ *      Submits pSrcBuff as the next chunk of the stream and returns
+ *      without waiting for it. The first chunk of a stream is preceded by
+ *      the gzip or zlib header in pDestBuff, and the chunk with lastChunk
+ *      set is followed by the footer. The next chunk submitted after the
+ *      last one starts a new stream.
+ *
+ *      When the callback runs, pResults->consumed is the length of the
+ *      chunk, pResults->produced the number of bytes written to pDestBuff,
+ *      header and footer included, and pResults->checksum the checksum of
+ *      the stream up to and including the chunk.
+ *
+ *      Chunks must be submitted from one thread at a time. The buffers
+ *      and pResults must stay valid until the callback of the chunk.
+ *
+ * @context
+ *      This function may be called from the callback of the stream.
+ * @assumptions
+ *      The buffers are DMA-able memory.
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  stream                Stream handle
+ * @param[in]  pSrcBuff              Chunk to compress
+ * @param[out] pDestBuff             Destination of the chunk, at least
+ *                                   icp_sal_DcStreamCompressBound() bytes
+ * @param[out] pResults              Results of the chunk
+ * @param[in]  lastChunk             CPA_TRUE for the last chunk of the
+ *                                   stream
+ * @param[in]  callbackTag           Passed to the callback of the stream
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_RETRY          maxInflight chunks are in flight or
+ *                                   the ring is full, resubmit later
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcStreamCompress(icp_sal_dc_stream_t stream,
+                                   CpaFlatBuffer *pSrcBuff,
+                                   CpaFlatBuffer *pDestBuff,
+                                   CpaDcRqResults *pResults,
+                                   CpaBoolean lastChunk,
+                                   void *callbackTag);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcStream
+ *      Remove a compression stream
+ *
+ * @description
+ *      Removes the session of the stream and frees it.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  stream                Stream handle
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_RETRY          Chunks of the stream are in flight
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcStreamRemove(icp_sal_dc_stream_t stream);
+
+#endif
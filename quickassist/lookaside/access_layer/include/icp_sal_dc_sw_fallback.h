@@ -0,0 +1,266 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_dc_sw_fallback.h
+ *
+ * @ingroup SalDcSwFallback
+ *
+ * This file contains the function prototypes for the software compression
+ * fallback, a host DEFLATE engine which processes the requests of a
+ * compression instance that the device cannot take.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_DC_SW_FALLBACK_H
+#define ICP_SAL_DC_SW_FALLBACK_H
+
+#include "cpa.h"
+#include "cpa_dc.h"
+
+/**< Host threads when icp_sal_dc_sw_fallback_policy_t.numWorkers is 0 */
+#define ICP_SAL_DC_SW_FALLBACK_DEFAULT_WORKERS (2)
+
+/**< Upper bound on the host threads of an instance */
+#define ICP_SAL_DC_SW_FALLBACK_MAX_WORKERS (64)
+
+/**< Queued requests when icp_sal_dc_sw_fallback_policy_t.queueDepth is 0 */
+#define ICP_SAL_DC_SW_FALLBACK_DEFAULT_QUEUE_DEPTH (64)
+
+/**< Upper bound on the queued requests of an instance */
+#define ICP_SAL_DC_SW_FALLBACK_MAX_QUEUE_DEPTH (4096)
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcSwFallback
+ *      Fallback policy
+ *
+ * @description
+ *      Selects the requests of an instance which are processed on the host.
+ *      Each criterion can be enabled on its own.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_dc_sw_fallback_policy_s
+{
+    Cpa32U ringFullPercent;
+    /**< Requests are processed on the host while the request ring of the
+     * instance is at least this percent full, and whenever the ring
+     * rejects one with CPA_STATUS_RETRY. 0 disables the ring full
+     * criterion. */
+    CpaBoolean onDeviceError;
+    /**< Requests are processed on the host while the instance is
+     * restarting or in error, instead of failing with
+     * CPA_STATUS_RESTARTING or CPA_STATUS_FAIL */
+    Cpa32U smallRequestBytes;
+    /**< Requests with fewer source bytes than this are processed on the
+     * host, for which the device round trip costs more than the
+     * compression. 0 disables the size criterion. */
+    Cpa32U numWorkers;
+    /**< Host threads processing requests, 0 for
+     * ICP_SAL_DC_SW_FALLBACK_DEFAULT_WORKERS */
+    Cpa32U queueDepth;
+    /**< Requests waiting for a host thread, 0 for
+     * ICP_SAL_DC_SW_FALLBACK_DEFAULT_QUEUE_DEPTH. While the queue is full
+     * small requests go to the device, and requests of a full ring or a
+     * failed device are rejected with CPA_STATUS_RETRY. */
+} icp_sal_dc_sw_fallback_policy_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcSwFallback
+ *      Fallback statistics
+ *
+ *****************************************************************************/
+typedef struct icp_sal_dc_sw_fallback_stats_s
+{
+    Cpa64U numRingFull;
+    /**< Requests taken because the request ring was full */
+    Cpa64U numDeviceError;
+    /**< Requests taken because the instance was restarting or in error */
+    Cpa64U numSmallRequest;
+    /**< Requests taken because of their size */
+    Cpa64U numQueueFull;
+    /**< Requests not taken because the queue was full */
+    Cpa64U numCompleted;
+    /**< Requests completed successfully */
+    Cpa64U numCompletedErrors;
+    /**< Requests completed with an error */
+} icp_sal_dc_sw_fallback_stats_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcSwFallback
+ *      Enable the software fallback of an instance
+ *
+ * @description
+ *      Starts the host threads of the instance and applies pPolicy to the
+ *      requests submitted from then on. Calling it again replaces the
+ *      policy and the threads.
+ *
+ *      Only requests of the traditional API on stateless DEFLATE sessions
+ *      with no checksum, CRC32 or Adler32 are eligible. Other requests,
+ *      and Data Plane, no-session and chained requests, always go to the
+ *      device.
+ *
+ *      A request processed on the host completes through the callback of
+ *      its session, from a host thread, with the same results as a device
+ *      request: the checksum is seeded the same way, and the CRC data of
+ *      an integrity checked request is filled as by the device. The output
+ *      is a raw DEFLATE stream which the device can decompress, but not
+ *      the same bytes the device would produce. A compression which
+ *      overflows the destination reports CPA_DC_OVERFLOW with nothing
+ *      consumed or produced.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      No request is submitted on the instance while the fallback is
+ *      enabled or disabled.
+ * @sideEffects
+ *      Starts pPolicy->numWorkers threads.
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  instanceHandle        Compression instance handle
+ * @param[in]  pPolicy               Fallback policy
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RESOURCE       Memory or thread allocation failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_UNSUPPORTED    The library was built without the
+ *                                   fallback
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcSwFallbackEnable(
+    CpaInstanceHandle instanceHandle,
+    const icp_sal_dc_sw_fallback_policy_t *pPolicy);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcSwFallback
+ *      Disable the software fallback of an instance
+ *
+ * @description
+ *      Completes the requests queued on the host and stops the host
+ *      threads. Stopping the instance disables the fallback as well.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      No request is submitted on the instance meanwhile.
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  instanceHandle        Compression instance handle
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_UNSUPPORTED    The library was built without the
+ *                                   fallback
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcSwFallbackDisable(CpaInstanceHandle instanceHandle);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDcSwFallback
+ *      Query the software fallback statistics of an instance
+ *
+ * @description
+ *      Returns the statistics since the fallback was last enabled.
+ *
+ * @context
+ *      This function may be called from any context.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Compression instance handle
+ * @param[out] pStats                Fallback statistics
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           The fallback is not enabled
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_UNSUPPORTED    The library was built without the
+ *                                   fallback
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcSwFallbackQueryStats(
+    CpaInstanceHandle instanceHandle,
+    icp_sal_dc_sw_fallback_stats_t *pStats);
+
+#endif
@@ -0,0 +1,129 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_dispatch.h
+ *
+ * @ingroup SalDispatch
+ *
+ * This file contains the function prototype of the instance dispatcher,
+ * which picks an instance for the calling thread.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_DISPATCH_H
+#define ICP_SAL_DISPATCH_H
+
+#include "icp_sal.h"
+
+/*
+ *****************************************************************************
+ * @ingroup SalDispatch
+ *      Get the instance the calling thread should submit to
+ *
+ * @description
+ *      Picks among the started instances of the given service type the one
+ *      with the lowest score. The score is the fraction of the instance's
+ *      request ring in flight (as reported by
+ *      icp_sal_SymGetInflightRequests, icp_sal_AsymGetInflightRequests and
+ *      icp_sal_DcGetInflightRequests) plus a penalty when the instance's
+ *      nodeAffinity differs from the NUMA node the thread runs on.
+ *
+ *      Each thread sticks to the instance it was last given, which keeps
+ *      its sessions and buffers warm on one device. The choice is revisited
+ *      every few calls, or sooner once the instance is half full, and is
+ *      only changed when another instance scores clearly better.
+ *
+ *      For CPA_ACC_SVC_TYPE_CRYPTO the load of a combined instance is that
+ *      of its symmetric and asymmetric rings together.
+ *
+ * @context
+ *      This function may be called from any thread, at submission rate.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  serviceType           CPA_ACC_SVC_TYPE_CRYPTO,
+ *                                   CPA_ACC_SVC_TYPE_CRYPTO_SYM,
+ *                                   CPA_ACC_SVC_TYPE_CRYPTO_ASYM or
+ *                                   CPA_ACC_SVC_TYPE_DATA_COMPRESSION
+ * @param[out] pInstanceHandle       Selected instance
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_RESOURCE       No instance of the type is started, or
+ *                                   memory allocation failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DispatchGetInstance(
+    const CpaAccelerationServiceType serviceType,
+    CpaInstanceHandle *pInstanceHandle);
+
+#endif
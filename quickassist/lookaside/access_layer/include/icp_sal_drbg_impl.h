@@ -0,0 +1,221 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_drbg_impl.h
+ *
+ * @ingroup SalDrbgImpl
+ *
+ * This file contains the registration APIs for the implementation
+ * specific functions used by the DRBG (cpaCyDrbg) implementation.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_DRBG_IMPL_H
+#define ICP_SAL_DRBG_IMPL_H
+
+#include "cpa.h"
+#include "cpa_cy_drbg.h"
+
+/*
+ *****************************************************************************
+ * @ingroup SalDrbgImpl
+ *      Get Entropy Input and Get Nonce operation data
+ *
+ * @description
+ *      Describes the entropy input (or nonce) requested for a DRBG session.
+ *      The buffer handed to the function is at least maxLength bytes long.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_drbg_get_entropy_op_data_s
+{
+    CpaCyDrbgSessionHandle sessionHandle;
+    /**< Session the input is requested for */
+    Cpa32U minEntropy;
+    /**< Minimum amount of entropy in bits */
+    Cpa32U minLength;
+    /**< Minimum number of bytes to return */
+    Cpa32U maxLength;
+    /**< Maximum number of bytes to return */
+} icp_sal_drbg_get_entropy_op_data_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalDrbgImpl
+ *      Get Entropy Input callback
+ *
+ * @description
+ *      Completion callback of an asynchronous Get Entropy Input function.
+ *      The DRBG implementation always requests entropy synchronously, so
+ *      this is only used by functions which are chained to other
+ *      implementations.
+ *
+ *****************************************************************************/
+typedef void (*IcpSalDrbgGetEntropyInputCbFunc)(void *pCallbackTag,
+                                                CpaStatus opStatus,
+                                                void *pOpData,
+                                                Cpa32U lenEntropy,
+                                                CpaFlatBuffer *pEntropy);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDrbgImpl
+ *      Get Entropy Input function
+ *
+ * @description
+ *      Fills pBuffer with between minLength and maxLength bytes holding at
+ *      least minEntropy bits of entropy and returns the number of bytes in
+ *      pLengthReturned. The DRBG calls it with pCb set to NULL and expects
+ *      the data on return.
+ *
+ *****************************************************************************/
+typedef CpaStatus (*IcpSalDrbgGetEntropyInputFunc)(
+    IcpSalDrbgGetEntropyInputCbFunc pCb,
+    void *pCallbackTag,
+    icp_sal_drbg_get_entropy_op_data_t *pOpData,
+    CpaFlatBuffer *pBuffer,
+    Cpa32U *pLengthReturned);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDrbgImpl
+ *      Get Nonce function
+ *
+ * @description
+ *      Fills pBuffer with a nonce of between minLength and maxLength bytes.
+ *      Only used when the derivation function is required.
+ *
+ *****************************************************************************/
+typedef CpaStatus (*IcpSalDrbgGetNonceFunc)(
+    icp_sal_drbg_get_entropy_op_data_t *pOpData,
+    CpaFlatBuffer *pBuffer,
+    Cpa32U *pLengthReturned);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDrbgImpl
+ *      Is Derivation Function Required function
+ *
+ * @description
+ *      Returns CPA_TRUE when the entropy source does not deliver full
+ *      entropy and the derivation function must be used. Without it the
+ *      entropy input must be 48 bytes of full entropy.
+ *
+ *****************************************************************************/
+typedef CpaBoolean (*IcpSalDrbgIsDFReqFunc)(void);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDrbgImpl
+ *      Register the Get Entropy Input function
+ *
+ * @description
+ *      The default function reads the kernel random number generator
+ *      (getrandom). Passing NULL restores the default. The function is
+ *      sampled at every instantiate and reseed, so it must not be changed
+ *      while it can be running.
+ *
+ * @param[in] func                   New function or NULL
+ *
+ * @retval The previously registered function, NULL for the default
+ *
+ *****************************************************************************/
+IcpSalDrbgGetEntropyInputFunc icp_sal_drbgGetEntropyInputFuncRegister(
+    IcpSalDrbgGetEntropyInputFunc func);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDrbgImpl
+ *      Register the Get Nonce function
+ *
+ * @description
+ *      The default function reads the kernel random number generator
+ *      (getrandom). Passing NULL restores the default.
+ *
+ * @param[in] func                   New function or NULL
+ *
+ * @retval The previously registered function, NULL for the default
+ *
+ *****************************************************************************/
+IcpSalDrbgGetNonceFunc icp_sal_drbgGetNonceFuncRegister(
+    IcpSalDrbgGetNonceFunc func);
+
+/*
+ *****************************************************************************
+ * @ingroup SalDrbgImpl
+ *      Register the Is Derivation Function Required function
+ *
+ * @description
+ *      By default the derivation function is used. The function is sampled
+ *      when a session is initialised. Passing NULL restores the default.
+ *
+ * @param[in] func                   New function or NULL
+ *
+ * @retval The previously registered function, NULL for the default
+ *
+ *****************************************************************************/
+IcpSalDrbgIsDFReqFunc icp_sal_drbgIsDFReqFuncRegister(
+    IcpSalDrbgIsDFReqFunc func);
+
+#endif
@@ -0,0 +1,223 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_ecdsa_prepared.h
+ *
+ * @ingroup SalEcdsaPrepared
+ *
+ * This file contains the function prototypes for ECDSA signing with a
+ * prepared key: a curve and private key validated and laid out for the
+ * accelerator once, then referenced by each signature.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_ECDSA_PREPARED_H
+#define ICP_SAL_ECDSA_PREPARED_H
+
+#include "cpa.h"
+#include "cpa_cy_ecdsa.h"
+
+/**< Opaque handle of a prepared ECDSA signing key */
+typedef void *icp_sal_ecdsa_prepared_key_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalEcdsaPrepared
+ *      Prepare an ECDSA signing key
+ *
+ * @description
+ *      cpaCyEcdsaSignRS validates the curve, selects the firmware function
+ *      and pads every parameter to the operand size on each request. For a
+ *      key which signs many messages this work only depends on the curve
+ *      and on d, so it can be done once here.
+ *
+ *      The curve (fieldType, q, a, b, n, xg, yg) and the private key d are
+ *      taken from pOpData and checked as cpaCyEcdsaSignRS would. k and m
+ *      are not read. The prepared key holds the firmware function id, the
+ *      operand size and a copy of d (and for curves other than NIST P-256
+ *      and P-384, of the curve) padded to that size in DMA-able memory
+ *      owned by the instance. pOpData may be freed once the call returns.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      The instance is started and supports ECDSA.
+ * @sideEffects
+ *      Allocates memory.
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Instance the key will be used on
+ * @param[in]  pOpData               Curve and private key
+ * @param[out] pKey                  Prepared key
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_EcdsaSignRSPrepareKey(
+    const CpaInstanceHandle instanceHandle,
+    const CpaCyEcdsaSignRSOpData *pOpData,
+    icp_sal_ecdsa_prepared_key_t *pKey);
+
+/*
+ *****************************************************************************
+ * @ingroup SalEcdsaPrepared
+ *      Sign a message with a prepared key
+ *
+ * @description
+ *      Equivalent to cpaCyEcdsaSignRS with the curve and d of the prepared
+ *      key. Only k and m are read from pOpData; the other fields are
+ *      ignored. pOpData is returned to the callback as usual. Besides the
+ *      per-request checks on k (0 < k < n) and m, no curve validation or
+ *      curve detection is done, and d is passed to the accelerator from
+ *      the prepared buffer without being copied.
+ *
+ *      m is truncated to its least significant bytes as in
+ *      cpaCyEcdsaSignRS on NIST P-256 and P-384. On other curves it must
+ *      fit in the operand size chosen for the curve.
+ *
+ *      The key must not be freed while requests using it are in flight.
+ *
+ * @context
+ *      When called as an asynchronous function it cannot sleep. It can be
+ *      executed in a context that does not permit sleeping.
+ *      When called as a synchronous function it may sleep.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Instance the key was prepared on
+ * @param[in]  pCb                   Callback function pointer. If this is
+ *                                   set to a NULL value the function will
+ *                                   operate synchronously.
+ * @param[in]  pCallbackTag          User-supplied value to help identify
+ *                                   request.
+ * @param[in]  key                   Prepared key
+ * @param[in]  pOpData               k and m of the signature
+ * @param[out] pMultiplyStatus       In synchronous mode, the multiply
+ *                                   output is valid (CPA_TRUE) or the
+ *                                   output is invalid (CPA_FALSE).
+ * @param[out] pR                    ECDSA message signature r
+ * @param[out] pS                    ECDSA message signature s
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RETRY          Resubmit the request
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Error related to system resources
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_EcdsaSignRSPrepared(const CpaInstanceHandle instanceHandle,
+                                      const CpaCyEcdsaSignRSCbFunc pCb,
+                                      void *pCallbackTag,
+                                      icp_sal_ecdsa_prepared_key_t key,
+                                      const CpaCyEcdsaSignRSOpData *pOpData,
+                                      CpaBoolean *pMultiplyStatus,
+                                      CpaFlatBuffer *pR,
+                                      CpaFlatBuffer *pS);
+
+/*
+ *****************************************************************************
+ * @ingroup SalEcdsaPrepared
+ *      Free a prepared key
+ *
+ * @description
+ *      Zeroizes the copy of the private key and frees the prepared key.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      No request using the key is in flight.
+ * @sideEffects
+ *      Frees memory.
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Instance the key was prepared on
+ * @param[in]  key                   Prepared key
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_EcdsaSignRSFreePreparedKey(
+    const CpaInstanceHandle instanceHandle,
+    icp_sal_ecdsa_prepared_key_t key);
+
+#endif /* ICP_SAL_ECDSA_PREPARED_H */
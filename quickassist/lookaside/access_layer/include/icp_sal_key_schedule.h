@@ -0,0 +1,404 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_key_schedule.h
+ *
+ * @ingroup SalKeySchedule
+ *
+ * This file contains the function prototypes for the TLS 1.3 key
+ * schedule, which derives the secrets of a handshake with chained HKDF
+ * requests, and for batches of independent TLS key derivations.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_KEY_SCHEDULE_H
+#define ICP_SAL_KEY_SCHEDULE_H
+
+#include "cpa.h"
+#include "cpa_cy_key.h"
+
+/**< Largest transcript hash and secret, SHA-384 */
+#define ICP_SAL_TLS3_MAX_HASH_SZ (CPA_CY_HKDF_KEY_MAX_HMAC_SZ)
+
+/**< Largest traffic key, AES-256 and ChaCha20 */
+#define ICP_SAL_TLS3_MAX_KEY_SZ (32)
+
+/**< Traffic IV length of every TLS 1.3 cipher suite */
+#define ICP_SAL_TLS3_IV_SZ (12)
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      Key schedule and batch callback
+ *
+ * @description
+ *      Invoked once the whole key schedule or batch has completed. For a
+ *      batch, status is CPA_STATUS_SUCCESS only when every derivation
+ *      succeeded, the status of each one is in its operation.
+ *
+ *****************************************************************************/
+typedef void (*icp_sal_key_cb_func_t)(void *pCallbackTag, CpaStatus status);
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      TLS 1.3 key schedule operation data
+ *
+ * @description
+ *      Inputs of the key schedule of RFC8446 section 7.1. The transcript
+ *      hashes are as long as the hash of the cipher suite. The structure
+ *      must stay valid until the callback.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_tls3_schedule_op_data_s
+{
+    CpaCyKeyHKDFCipherSuite cipherSuite;
+    /**< Cipher suite, which selects the hash and traffic key length */
+    CpaFlatBuffer psk;
+    /**< Pre-shared key, no data for a handshake without PSK. At most
+     * CPA_CY_HKDF_KEY_MAX_SECRET_SZ bytes */
+    CpaBoolean externalPsk;
+    /**< The binder key is "ext binder" rather than "res binder" */
+    CpaFlatBuffer sharedSecret;
+    /**< (EC)DHE shared secret, no data for psk_ke. At most
+     * CPA_CY_HKDF_KEY_MAX_SECRET_SZ bytes */
+    CpaBoolean deriveEarlyTraffic;
+    /**< Derive the client early traffic secret, with a PSK only */
+    Cpa8U clientHelloHash[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Transcript hash of the ClientHello, for the early traffic secret */
+    Cpa8U serverHelloHash[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Transcript hash up to the ServerHello */
+    Cpa8U serverFinishedHash[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Transcript hash up to the server Finished */
+    CpaBoolean deriveResumption;
+    /**< Derive the resumption master secret */
+    Cpa8U clientFinishedHash[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Transcript hash up to the client Finished, for the resumption
+     * master secret */
+} icp_sal_tls3_schedule_op_data_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      TLS 1.3 traffic secret
+ *
+ * @description
+ *      A secret with the keys expanded from it. Only the keys that the
+ *      secret is used for are set, the others are zero.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_tls3_secret_s
+{
+    Cpa8U secret[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Secret, hash length bytes */
+    Cpa8U key[ICP_SAL_TLS3_MAX_KEY_SZ];
+    /**< Traffic key, key length bytes */
+    Cpa8U iv[ICP_SAL_TLS3_IV_SZ];
+    /**< Traffic IV */
+    Cpa8U finishedKey[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Finished key, hash length bytes */
+} icp_sal_tls3_secret_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      TLS 1.3 key schedule results
+ *
+ * @description
+ *      Secrets and keys of one handshake. Secrets that were not asked for
+ *      are zero.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_tls3_schedule_s
+{
+    Cpa32U hashLenInBytes;
+    /**< Length of the secrets and finished keys */
+    Cpa32U keyLenInBytes;
+    /**< Length of the traffic keys */
+    Cpa8U earlySecret[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Early secret */
+    icp_sal_tls3_secret_t binder;
+    /**< Binder key and its finished key, with a PSK only */
+    icp_sal_tls3_secret_t clientEarlyTraffic;
+    /**< Client early traffic secret, key and IV */
+    Cpa8U handshakeSecret[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Handshake secret */
+    icp_sal_tls3_secret_t clientHandshakeTraffic;
+    /**< Client handshake traffic secret, key, IV and finished key */
+    icp_sal_tls3_secret_t serverHandshakeTraffic;
+    /**< Server handshake traffic secret, key, IV and finished key */
+    Cpa8U masterSecret[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Master secret */
+    icp_sal_tls3_secret_t clientApplicationTraffic;
+    /**< Client application traffic secret, key and IV */
+    icp_sal_tls3_secret_t serverApplicationTraffic;
+    /**< Server application traffic secret, key and IV */
+    Cpa8U exporterMasterSecret[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Exporter master secret */
+    Cpa8U resumptionMasterSecret[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /**< Resumption master secret */
+} icp_sal_tls3_schedule_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      Key derivation of a batch
+ *****************************************************************************/
+typedef enum icp_sal_key_gen_type_e
+{
+    ICP_SAL_KEY_GEN_TLS2 = 0,
+    /**< cpaCyKeyGenTls2 */
+    ICP_SAL_KEY_GEN_TLS3
+    /**< cpaCyKeyGenTls3 */
+} icp_sal_key_gen_type_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      Key derivation of a batch
+ *
+ * @description
+ *      The operation data and generated key buffer follow the rules of
+ *      cpaCyKeyGenTls2 and cpaCyKeyGenTls3, in particular they are DMA-able
+ *      memory.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_key_gen_op_s
+{
+    icp_sal_key_gen_type_t type;
+    /**< Derivation to perform */
+    union {
+        struct
+        {
+            CpaCyKeyGenTlsOpData *pOpData;
+            /**< TLS 1.2 operation data */
+            CpaCySymHashAlgorithm hashAlgorithm;
+            /**< Hash of the PRF */
+        } tls2;
+        struct
+        {
+            CpaCyKeyGenHKDFOpData *pOpData;
+            /**< HKDF operation data */
+            CpaCyKeyHKDFCipherSuite cipherSuite;
+            /**< Cipher suite */
+        } tls3;
+    } u;
+    CpaFlatBuffer *pGeneratedKeyBuffer;
+    /**< Generated key */
+    CpaStatus status;
+    /**< Set by the batch: status of the derivation, CPA_STATUS_RETRY when
+     * it could not be sent */
+    void *pPrivate;
+    /**< Set by the batch, must not be changed until the callback */
+} icp_sal_key_gen_op_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      Get the size of a key schedule context
+ *
+ * @description
+ *      A context holds the requests of one key schedule or batch while it
+ *      runs. The caller allocates it in pinned, physically contiguous
+ *      memory aligned on 8 bytes, as the requests are read from it by the
+ *      accelerator, and may reuse it once the callback has been invoked.
+ *
+ * @context
+ *      This function may be called from any context.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Instance handle
+ * @param[out] pCtxSize              Size of a context in bytes
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_CyKeyScheduleCtxGetSize(
+    const CpaInstanceHandle instanceHandle,
+    Cpa32U *pCtxSize);
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      Derive the TLS 1.3 key schedule of a handshake
+ *
+ * @description
+ *      Derives the secrets of a handshake with three HKDF Extract and
+ *      Expand Label requests, for the early, handshake and master secrets.
+ *      Each extracts one secret and expands from it, along with the
+ *      "derived" secret that salts the next request, every secret and
+ *      traffic key that depends on it. The next request is sent from the
+ *      completion of the previous one, so the application sees a single
+ *      callback per handshake.
+ *
+ *      Many handshakes may run at once, each with its own context. A
+ *      request that cannot be sent from a completion ends the schedule
+ *      with its status.
+ *
+ * @context
+ *      This function is asynchronous and does not sleep. It may be called
+ *      from a callback.
+ * @assumptions
+ *      The instance is started, has address translation set up and
+ *      supports HKDF.
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Instance handle
+ * @param[in]  pCb                   Callback, invoked once the schedule
+ *                                   completes or fails
+ * @param[in]  pCallbackTag          Opaque data returned in the callback
+ * @param[in]  pOpData               Key schedule inputs
+ * @param[in]  pCtx                  Context, see
+ *                                   icp_sal_CyKeyScheduleCtxGetSize
+ * @param[out] pSchedule             Secrets and keys, valid in the callback
+ *
+ * @retval CPA_STATUS_SUCCESS        The schedule was started, the callback
+ *                                   reports its result
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RETRY          Resubmit the request
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Error related to system resources
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_CyKeyGenTls3Schedule(
+    const CpaInstanceHandle instanceHandle,
+    const icp_sal_key_cb_func_t pCb,
+    void *pCallbackTag,
+    const icp_sal_tls3_schedule_op_data_t *pOpData,
+    void *pCtx,
+    icp_sal_tls3_schedule_t *pSchedule);
+
+/*
+ *****************************************************************************
+ * @ingroup SalKeySchedule
+ *      Run a batch of independent TLS key derivations
+ *
+ * @description
+ *      Sends the first maxInflight derivations of pOps from the caller and
+ *      each further one from the completion of an earlier one, so up to
+ *      maxInflight are in flight, and invokes the callback once all have
+ *      completed. Derivations may complete in any order.
+ *
+ *      If the first derivation cannot be sent the batch does not start
+ *      and its status is returned. A later derivation that cannot be sent
+ *      is not retried, its status is recorded in its operation and the
+ *      batch goes on with the next one.
+ *
+ * @context
+ *      This function is asynchronous and does not sleep. The callback may
+ *      be invoked before it returns.
+ * @assumptions
+ *      The instance is started and has address translation set up.
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Instance handle
+ * @param[in]  pCb                   Callback, invoked once every
+ *                                   derivation has completed
+ * @param[in]  pCallbackTag          Opaque data returned in the callback
+ * @param[in,out] pOps               Derivations, valid until the callback
+ * @param[in]  numOps                Number of derivations
+ * @param[in]  maxInflight           Derivations in flight at once, 0 for
+ *                                   all of them
+ * @param[in]  pCtx                  Context, see
+ *                                   icp_sal_CyKeyScheduleCtxGetSize
+ *
+ * @retval CPA_STATUS_SUCCESS        The batch was started, the callback
+ *                                   reports its result
+ * @retval CPA_STATUS_FAIL           Function failed
+ * @retval CPA_STATUS_RETRY          Resubmit the batch
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Error related to system resources
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_CyKeyGenBatch(const CpaInstanceHandle instanceHandle,
+                                const icp_sal_key_cb_func_t pCb,
+                                void *pCallbackTag,
+                                icp_sal_key_gen_op_t *pOps,
+                                Cpa32U numOps,
+                                Cpa32U maxInflight,
+                                void *pCtx);
+
+#endif /* ICP_SAL_KEY_SCHEDULE_H */
@@ -551,6 +551,168 @@ CpaStatus icp_sal_DcPutFileDescriptor(CpaInstanceHandle instanceHandle, int fd);
  *****************************************************************************/
 CpaStatus icp_sal_CyPutFileDescriptor(CpaInstanceHandle instanceHandle, int fd);
 
+/*****************************************************************************
+ * @ingroup SalPoll
+ *      Polling engine configuration
+ *
+ * @description
+ *      Tuning parameters for @ref icp_sal_PollEngineStart. A value of zero
+ *      selects the default given for each field.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_poll_engine_config_s
+{
+    Cpa32U spinPolls;
+    /**< Consecutive empty polls before the engine stops spinning.
+     * Default 256. */
+    Cpa32U minBackoffUsecs;
+    /**< First sleep while requests are in flight. Default 10us. */
+    Cpa32U maxBackoffUsecs;
+    /**< Upper bound of the exponential backoff. Default 1000us. */
+    Cpa32U responseQuota;
+    /**< Response quota passed to the instance poll function.
+     * Default 0 (all responses on the ring). */
+} icp_sal_poll_engine_config_t;
+
+/*****************************************************************************
+ * @ingroup SalPoll
+ *      Polling engine statistics
+ *
+ * @description
+ *      Counters maintained by the polling engine thread. All times are in
+ *      nanoseconds of the monotonic clock. busyNs + spinNs + sleepNs is the
+ *      wall time the engine has been running; busyNs + spinNs is the time
+ *      it kept a core busy.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_poll_engine_stats_s
+{
+    Cpa64U busyPolls;
+    /**< Polls that retrieved at least one response */
+    Cpa64U idlePolls;
+    /**< Polls that found the response rings empty */
+    Cpa64U busyNs;
+    /**< Time spent in polls that retrieved responses */
+    Cpa64U spinNs;
+    /**< Time spent in empty polls */
+    Cpa64U sleepNs;
+    /**< Time spent waiting in the kernel */
+    Cpa64U sleeps;
+    /**< Timed waits taken while requests were in flight */
+    Cpa64U blocks;
+    /**< Untimed waits taken while no request was in flight */
+    Cpa64U wakeups;
+    /**< Waits ended by a submission on the instance */
+    Cpa64U fdWakeups;
+    /**< Waits ended by the instance file descriptor (epoll mode) */
+} icp_sal_poll_engine_stats_t;
+
+/*****************************************************************************
+ * @ingroup SalPoll
+ *      Start the adaptive polling engine of an instance
+ *
+ * @description
+ *      Creates a thread which polls the instance. The thread busy-polls
+ *      while responses keep arriving. After spinPolls consecutive empty
+ *      polls it sleeps with an exponential backoff between minBackoffUsecs
+ *      and maxBackoffUsecs if requests are in flight, and blocks until the
+ *      next submission if none are. Instances in epoll mode also wake up
+ *      on the instance file descriptor (@ref icp_sal_CyGetFileDescriptor).
+ *
+ *      The engine replaces the application polling thread; the instance
+ *      must not be polled by other threads while it runs. Only the
+ *      traditional API is supported: the data plane in-flight counters
+ *      are not updated atomically.
+ *
+ * @context
+ *      This function is called from the user process context
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      Creates a thread and an eventfd
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] instanceHandle         Crypto or Data Compression instance
+ *                                   handle.
+ * @param[in] pConfig                Engine configuration, NULL selects the
+ *                                   defaults.
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully.
+ * @retval CPA_STATUS_FAIL           Function failed or the engine is
+ *                                   already running on this instance.
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter passed in.
+ * @retval CPA_STATUS_RESOURCE       Thread or eventfd creation failed.
+ * @retval CPA_STATUS_UNSUPPORTED    Instance type not supported.
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_PollEngineStart(CpaInstanceHandle instanceHandle,
+                                  const icp_sal_poll_engine_config_t *pConfig);
+
+/*****************************************************************************
+ * @ingroup SalPoll
+ *      Stop the adaptive polling engine of an instance
+ *
+ * @description
+ *      Wakes the engine thread, waits for it to exit and releases its
+ *      resources. No request may be submitted on the instance while this
+ *      function runs. Requests still in flight are not polled anymore.
+ *
+ * @context
+ *      This function is called from the user process context
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] instanceHandle         Crypto or Data Compression instance
+ *                                   handle.
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully.
+ * @retval CPA_STATUS_FAIL           The engine is not running.
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter passed in.
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_PollEngineStop(CpaInstanceHandle instanceHandle);
+
+/*****************************************************************************
+ * @ingroup SalPoll
+ *      Read the adaptive polling engine counters of an instance
+ *
+ * @description
+ *      Copies the counters of a running engine. The copy is not atomic
+ *      with respect to the engine thread, so the fields may be from
+ *      slightly different points in time.
+ *
+ * @context
+ *      This function is called from the user process context
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] instanceHandle         Crypto or Data Compression instance
+ *                                   handle.
+ * @param[out] pStats                Counters of the engine.
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully.
+ * @retval CPA_STATUS_FAIL           The engine is not running.
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter passed in.
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_PollEngineGetStats(CpaInstanceHandle instanceHandle,
+                                     icp_sal_poll_engine_stats_t *pStats);
+
 #ifdef __cplusplus
 } /* close the extern "C" { */
 #endif
@@ -0,0 +1,321 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_prime_sieve.h
+ *
+ * @ingroup SalPrimeSieve
+ *
+ * This file contains the function prototypes for the host-side prime
+ * sieve and for the prime search, which tests a run of candidates on the
+ * accelerator with several requests in flight.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_PRIME_SIEVE_H
+#define ICP_SAL_PRIME_SIEVE_H
+
+#include "cpa.h"
+#include "cpa_cy_prime.h"
+
+/**< Odd numbers per sieve window when no window size is given */
+#define ICP_SAL_PRIME_SIEVE_DEFAULT_WINDOW (4096)
+
+/**< Smallest accepted sieve window */
+#define ICP_SAL_PRIME_SIEVE_MIN_WINDOW (64)
+
+/**< Largest accepted sieve window */
+#define ICP_SAL_PRIME_SIEVE_MAX_WINDOW (1024 * 1024)
+
+/**< Requests in flight of a search when none is given */
+#define ICP_SAL_PRIME_SEARCH_DEFAULT_INFLIGHT (16)
+
+/**< Upper bound on the requests in flight of a search */
+#define ICP_SAL_PRIME_SEARCH_MAX_INFLIGHT (128)
+
+/**< Opaque handle of a prime sieve */
+typedef void *icp_sal_prime_sieve_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalPrimeSieve
+ *      Prime search operation data
+ *
+ * @description
+ *      The candidates of a search are the odd numbers startCandidate,
+ *      startCandidate + 2, startCandidate + 4 and so on. The tests fields
+ *      have the meaning of the fields of the same name in
+ *      CpaCyPrimeTestOpData and are applied to every candidate sent to the
+ *      accelerator. The Miller-Rabin random numbers are shared by all
+ *      candidates, so each of them must be greater than 1 and less than
+ *      startCandidate - 1.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_prime_search_op_data_s
+{
+    CpaFlatBuffer startCandidate;
+    /**< First candidate, odd and in the size range of cpaCyPrimeTest */
+    CpaBoolean useSieve;
+    /**< Drop candidates with a small factor on the host */
+    Cpa32U windowSize;
+    /**< Odd numbers per sieve window, 0 for
+     * ICP_SAL_PRIME_SIEVE_DEFAULT_WINDOW */
+    Cpa32U maxCandidates;
+    /**< Odd numbers examined before the search gives up */
+    Cpa32U maxInflight;
+    /**< Prime tests in flight at once, 0 for
+     * ICP_SAL_PRIME_SEARCH_DEFAULT_INFLIGHT */
+    CpaBoolean performGcdTest;
+    /**< Perform the GCD primality test on each candidate */
+    CpaBoolean performFermatTest;
+    /**< Perform the Fermat primality test on each candidate */
+    Cpa32U numMillerRabinRounds;
+    /**< Number of Miller-Rabin rounds, at most 50 */
+    CpaFlatBuffer millerRabinRandomInput;
+    /**< Random numbers of the Miller-Rabin rounds, laid out as in
+     * CpaCyPrimeTestOpData */
+    CpaBoolean performLucasTest;
+    /**< Perform the Lucas primality test on each candidate */
+} icp_sal_prime_search_op_data_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalPrimeSieve
+ *      Prime search results
+ *****************************************************************************/
+typedef struct icp_sal_prime_search_results_s
+{
+    CpaBoolean found;
+    /**< A candidate passed all the tests */
+    Cpa64U numExamined;
+    /**< Odd numbers from startCandidate up to the prime found, or all
+     * maxCandidates of them when none was found */
+    Cpa64U numTested;
+    /**< Prime tests sent to the accelerator. This includes tests of
+     * candidates beyond the prime which were in flight when it was found */
+    Cpa64U numSieved;
+    /**< Odd numbers dropped by the sieve below the last candidate sent */
+} icp_sal_prime_search_results_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalPrimeSieve
+ *      Create a prime sieve
+ *
+ * @description
+ *      A sieve walks the odd numbers from pStart upwards and returns only
+ *      those without a prime factor below 2^14. About one odd number in
+ *      nine survives, and every number it drops is composite, so it can be
+ *      put in front of cpaCyPrimeTest to save the accelerator the GCD,
+ *      Fermat and Miller-Rabin work on candidates that are easy to reject.
+ *
+ *      The remainders of the start value modulo the small primes are
+ *      computed once. Each window of windowSize odd numbers is then sieved
+ *      by striking out multiples, and moving to the next window updates
+ *      the remainders without any multiple precision arithmetic.
+ *
+ *      The sieve runs on the host only and is not bound to an instance.
+ *      pStart may be freed once the call returns.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      Allocates memory.
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  pStart                First number to examine, odd and of at
+ *                                   least 32 bits
+ * @param[in]  windowSize            Odd numbers per window, 0 for
+ *                                   ICP_SAL_PRIME_SIEVE_DEFAULT_WINDOW
+ * @param[out] pSieve                Sieve
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_PrimeSieveCreate(const CpaFlatBuffer *pStart,
+                                   Cpa32U windowSize,
+                                   icp_sal_prime_sieve_t *pSieve);
+
+/*
+ *****************************************************************************
+ * @ingroup SalPrimeSieve
+ *      Get the next candidate of a sieve
+ *
+ * @description
+ *      Writes the next odd number without a small factor, big-endian and
+ *      padded to the length of the start value, to pCandidate.
+ *
+ * @context
+ *      This function may be called from any context.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  sieve                 Sieve
+ * @param[out] pCandidate            Candidate, as long as the start value
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_FAIL           The next candidate does not fit in the
+ *                                   length of the start value
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_PrimeSieveNext(icp_sal_prime_sieve_t sieve,
+                                 CpaFlatBuffer *pCandidate);
+
+/*
+ *****************************************************************************
+ * @ingroup SalPrimeSieve
+ *      Free a prime sieve
+ *
+ * @description
+ *      Zeroizes the position of the sieve, which reveals the candidates,
+ *      and frees it.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      Frees memory.
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  sieve                 Sieve
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_PrimeSieveFree(icp_sal_prime_sieve_t sieve);
+
+/*
+ *****************************************************************************
+ * @ingroup SalPrimeSieve
+ *      Search for a prime
+ *
+ * @description
+ *      Tests the candidates of pOpData on the accelerator until one passes
+ *      or maxCandidates odd numbers were examined. With useSieve set the
+ *      candidates first go through a prime sieve and only the survivors
+ *      are sent to the accelerator.
+ *
+ *      Up to maxInflight prime tests are kept in flight, in increasing
+ *      order of candidate. Once a candidate passes no further ones are
+ *      sent and the requests in flight are drained, so the prime returned
+ *      is the smallest candidate that passes, the same one a search
+ *      testing one candidate at a time would return.
+ *
+ *      The call is synchronous. It polls the instance itself, which is
+ *      safe alongside polling threads of the application.
+ *
+ * @context
+ *      This function may sleep and must not be called from a callback.
+ * @assumptions
+ *      The instance is started, has address translation set up and
+ *      supports prime testing. The Miller-Rabin random input is DMA-able
+ *      memory.
+ * @sideEffects
+ *      Allocates and frees memory.
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle        Instance handle
+ * @param[in]  pOpData               Search operation data
+ * @param[out] pPrime                Prime found, as long as the start
+ *                                   candidate
+ * @param[out] pResults              Results of the search
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully, check
+ *                                   pResults->found
+ * @retval CPA_STATUS_FAIL           A prime test failed or was not returned
+ *                                   in time
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_RESTARTING     The instance is restarting
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_CyPrimeSearch(const CpaInstanceHandle instanceHandle,
+                                const icp_sal_prime_search_op_data_t *pOpData,
+                                CpaFlatBuffer *pPrime,
+                                icp_sal_prime_search_results_t *pResults);
+
+#endif /* ICP_SAL_PRIME_SIEVE_H */
@@ -0,0 +1,266 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/*
+ ***************************************************************************
+ * @file icp_sal_priority.h
+ *
+ * @ingroup SalPriority
+ *
+ * This file contains the function prototypes for request priority
+ * classes, which send the requests of latency critical sessions on a
+ * ring pair of their own.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_PRIORITY_H
+#define ICP_SAL_PRIORITY_H
+
+#include "cpa.h"
+#include "cpa_cy_sym.h"
+#include "cpa_dc.h"
+
+/**< Percentage of a poll quota kept for the normal priority rings when
+ * icp_sal_PriorityPairSet is given 0 */
+#define ICP_SAL_PRIORITY_DEFAULT_NORMAL_SHARE (25)
+
+/*
+ *****************************************************************************
+ * @ingroup SalPriority
+ *      Priority class of the requests of a session
+ *****************************************************************************/
+typedef enum _icp_sal_priority
+{
+    ICP_SAL_PRIORITY_NORMAL = 0,
+    /**< Requests are sent on the instance they are submitted on */
+    ICP_SAL_PRIORITY_HIGH
+    /**< Requests are sent on the high priority ring pair of the instance */
+} icp_sal_priority_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalPriority
+ *      Give an instance a high priority ring pair
+ *
+ * @description
+ *      A ring is served in order, so a request submitted behind a backlog
+ *      of large requests waits for all of them. The device arbitrates
+ *      between rings, and on devices with a single ring pair per bank
+ *      another ring pair is that of another instance. This function
+ *      dedicates the ring pair of highInstanceHandle to the high priority
+ *      sessions of instanceHandle (see icp_sal_DcSessionSetPriority and
+ *      icp_sal_CySymSessionSetPriority): their requests are sent on it,
+ *      and polling instanceHandle polls it first.
+ *
+ *      A poll with a response quota keeps normalPollShare percent of it,
+ *      and at least one response, for the rings of instanceHandle, so that
+ *      a busy high priority class cannot starve the normal one. A quota
+ *      of 0 drains both, the high priority rings first.
+ *
+ *      While paired, highInstanceHandle should not be handed other work:
+ *      icp_sal_DispatchGetInstance skips it. Stopping either instance
+ *      removes the pairing; the stop returns CPA_STATUS_RETRY while the
+ *      high priority ring pair has requests in flight, which polling
+ *      instanceHandle completes.
+ *
+ * @context
+ *      This function should be called before high priority sessions are
+ *      used, and not while requests are submitted on the instances.
+ * @assumptions
+ *      Both instances are polled.
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] instanceHandle         Started instance taking the normal
+ *                                   priority requests
+ * @param[in] highInstanceHandle     Started instance on the same device
+ *                                   and of the same service type, not
+ *                                   part of another pair
+ * @param[in] normalPollShare        Percentage, below 100, of a poll
+ *                                   quota kept for the normal priority
+ *                                   rings, 0 for
+ *                                   ICP_SAL_PRIORITY_DEFAULT_NORMAL_SHARE
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter, the instances are
+ *                                   on different devices, or an instance
+ *                                   is already part of a pair
+ * @retval CPA_STATUS_RESTARTING     An instance is not running
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_PriorityPairSet(CpaInstanceHandle instanceHandle,
+                                  CpaInstanceHandle highInstanceHandle,
+                                  Cpa32U normalPollShare);
+
+/*
+ *****************************************************************************
+ * @ingroup SalPriority
+ *      Remove the high priority ring pair of an instance
+ *
+ * @description
+ *      The requests of high priority sessions are sent on instanceHandle
+ *      again. The high priority instance must still be polled until its
+ *      requests in flight have completed.
+ *
+ * @context
+ *      This function should not be called while requests are submitted
+ *      on the instance.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] instanceHandle         Instance given to
+ *                                   icp_sal_PriorityPairSet
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_PriorityPairClear(CpaInstanceHandle instanceHandle);
+
+/*
+ *****************************************************************************
+ * @ingroup SalPriority
+ *      Set the priority class of a compression session
+ *
+ * @description
+ *      The requests of a high priority session submitted with
+ *      cpaDcCompressData, cpaDcCompressData2, cpaDcDecompressData or
+ *      cpaDcDecompressData2 on an instance with a high priority ring pair
+ *      are sent on that ring pair. Without one, or while its instance is
+ *      not running, they are sent on the instance they are submitted on.
+ *      Sessions start with ICP_SAL_PRIORITY_NORMAL.
+ *
+ * @context
+ *      This function must not be called while the session has requests
+ *      in flight.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in] dcInstance             Instance the session was set up on
+ * @param[in] pSessionHandle         Traditional API session
+ * @param[in] priority               Priority class
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RETRY          The session has requests in flight
+ * @retval CPA_STATUS_UNSUPPORTED    Data plane sessions are not supported
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_DcSessionSetPriority(CpaInstanceHandle dcInstance,
+                                       CpaDcSessionHandle pSessionHandle,
+                                       icp_sal_priority_t priority);
+
+/*
+ *****************************************************************************
+ * @ingroup SalPriority
+ *      Set the priority class of a symmetric session
+ *
+ * @description
+ *      The requests of a high priority session submitted with
+ *      cpaCySymPerformOp on an instance with a high priority ring pair are
+ *      sent on that ring pair. Without one, or while its instance is not
+ *      running, they are sent on the instance they are submitted on.
+ *      Sessions start with ICP_SAL_PRIORITY_NORMAL.
+ *
+ * @context
+ *      This function must not be called while the session has requests
+ *      in flight.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in] instanceHandle         Instance the session was set up on
+ * @param[in] sessionCtx             Traditional API session
+ * @param[in] priority               Priority class
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RETRY          The session has requests in flight
+ * @retval CPA_STATUS_UNSUPPORTED    Data plane sessions are not supported
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_CySymSessionSetPriority(CpaInstanceHandle instanceHandle,
+                                          CpaCySymSessionCtx sessionCtx,
+                                          icp_sal_priority_t priority);
+
+#endif
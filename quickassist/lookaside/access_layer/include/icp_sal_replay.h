@@ -0,0 +1,177 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/*
+ ***************************************************************************
+ * @file icp_sal_replay.h
+ *
+ * @ingroup SalReplay
+ *
+ * This file contains function prototypes for the in-flight request replay
+ * APIs.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_REPLAY_H
+#define ICP_SAL_REPLAY_H
+
+#include "icp_sal.h"
+
+/*
+ *****************************************************************************
+ * @ingroup SalReplay
+ *      Replay statistics
+ *
+ * @description
+ *      Counters reported by icp_sal_ReplayGetStats. They are cumulative
+ *      since replay was last configured on the instance.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_replay_stats_s
+{
+    Cpa64U numHeld;
+    /**< In-flight requests held when the device failed */
+    Cpa64U numReplayed;
+    /**< Held requests resubmitted to the restarted device */
+    Cpa64U numFailed;
+    /**< In-flight requests completed with CPA_STATUS_FAIL instead */
+    Cpa32U numPending;
+    /**< Requests currently held, waiting for the restart */
+    Cpa32U replayWindow;
+    /**< Configured window, 0 when replay is disabled */
+} icp_sal_replay_stats_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalReplay
+ *      Configure in-flight request replay across device restarts
+ *
+ * @description
+ *      When a device fails, the requests it has not answered are normally
+ *      completed with CPA_STATUS_FAIL once the instance is polled in the
+ *      error state. With replay enabled, up to replayWindow of these
+ *      requests, oldest first, are instead held with their built ring
+ *      message and resubmitted to the instance's rings once the device has
+ *      restarted. The application sees a single, normal completion for each
+ *      of them; requests beyond the window are failed as before.
+ *
+ *      Only requests which may safely run twice are held: stateless
+ *      compression and decompression requests, and PKE operations made of
+ *      a single firmware request. Stateful compression requests, chained
+ *      PKE requests and requests without a send sequence number (such as
+ *      session-less compression) are always failed.
+ *
+ *      Held requests keep their callback tags, buffers and sessions in
+ *      use: applications must not free or reuse them, or remove the
+ *      sessions, until their callbacks have run. If the instance is
+ *      stopped before the device restarts, held requests are failed.
+ *
+ *      Replay is disabled by default. The window is capped to the number
+ *      of requests the instance can have in flight.
+ *
+ * @context
+ *      This function must be called while the instance is running and
+ *      not concurrently with device event handling.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      Allocates (replayWindow != 0) or frees (replayWindow == 0) memory.
+ *      Resets the statistics.
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in] instanceHandle         Compression, crypto or asymmetric
+ *                                   crypto instance handle
+ * @param[in] replayWindow           Maximum number of requests held, 0 to
+ *                                   disable
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESTARTING     Instance is not running
+ * @retval CPA_STATUS_RETRY          Requests are held from a previous failure
+ * @retval CPA_STATUS_UNSUPPORTED    Instance has no replayable requests
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_ReplayConfig(CpaInstanceHandle instanceHandle,
+                               Cpa32U replayWindow);
+
+/*
+ *****************************************************************************
+ * @ingroup SalReplay
+ *      Read the in-flight request replay statistics
+ *
+ * @param[in]  instanceHandle        Compression, crypto or asymmetric
+ *                                   crypto instance handle
+ * @param[out] pStats                Statistics
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_UNSUPPORTED    Instance has no replayable requests
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_ReplayGetStats(CpaInstanceHandle instanceHandle,
+                                 icp_sal_replay_stats_t *pStats);
+
+#endif
@@ -0,0 +1,176 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_sym_precomp_cache.h
+ *
+ * @ingroup SalSymPrecompCache
+ *
+ * This file contains function prototypes for the symmetric hash
+ * precompute cache APIs.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_SYM_PRECOMP_CACHE_H
+#define ICP_SAL_SYM_PRECOMP_CACHE_H
+
+#include "icp_sal.h"
+
+/**< Upper bound on the number of entries of a per-instance cache */
+#define ICP_SAL_SYM_PRECOMP_CACHE_MAX_ENTRIES (4096)
+
+/*
+ *****************************************************************************
+ * @ingroup SalSymPrecompCache
+ *      Precompute cache statistics
+ *
+ * @description
+ *      Counters reported by icp_sal_SymPrecompCacheGetStats. They are
+ *      cumulative since the cache was last configured.
+ *
+ *****************************************************************************/
+typedef struct icp_sal_sym_precomp_cache_stats_s
+{
+    Cpa64U hits;
+    /**< Session setups served from the cache */
+    Cpa64U misses;
+    /**< Cacheable session setups which had to precompute */
+    Cpa64U evictions;
+    /**< Entries evicted (and zeroized) to make room */
+    Cpa32U numEntries;
+    /**< Entries currently held */
+    Cpa32U maxEntries;
+    /**< Configured capacity, 0 when the cache is disabled */
+} icp_sal_sym_precomp_cache_stats_t;
+
+/*
+ *****************************************************************************
+ * @ingroup SalSymPrecompCache
+ *      Configure the symmetric hash precompute cache
+ *
+ * @description
+ *      Session initialisation for HMAC, AES-XCBC and AES-CMAC derives
+ *      per-key state (the HMAC inner/outer hash states, the XCBC and CMAC
+ *      subkeys) in software. Workloads which set up many sessions with a
+ *      small set of authentication keys can enable a per-instance LRU cache
+ *      of these results so that repeated keys skip the derivation.
+ *
+ *      The cache never stores authentication keys. Entries are looked up by
+ *      algorithm, key length and a 128-bit SipHash-2-4 digest of the key
+ *      computed under a random per-instance secret. The derived state is
+ *      key-equivalent material: it is zeroized on eviction, on
+ *      reconfiguration and when the instance is stopped.
+ *
+ *      The cache is disabled by default. Enabling it means a key's derived
+ *      state outlives the sessions using it, and session setup time reveals
+ *      whether a key was recently used on the instance; applications should
+ *      only enable it when both are acceptable.
+ *
+ *      Reconfiguring the cache flushes all entries and draws a new secret.
+ *
+ * @context
+ *      This function may be called from any thread, including while
+ *      sessions are being initialised on the instance.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      Allocates (maxEntries != 0) or frees (maxEntries == 0) memory.
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] instanceHandle         Symmetric instance handle
+ * @param[in] maxEntries             Number of entries, 0 to disable.
+ *                                   At most
+ *                                   ICP_SAL_SYM_PRECOMP_CACHE_MAX_ENTRIES.
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           No secret could be obtained
+ * @retval CPA_STATUS_RESOURCE       Memory allocation failed
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_UNSUPPORTED    Instance has no software precomputes
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_SymPrecompCacheConfig(CpaInstanceHandle instanceHandle,
+                                        Cpa32U maxEntries);
+
+/*
+ *****************************************************************************
+ * @ingroup SalSymPrecompCache
+ *      Read the symmetric hash precompute cache statistics
+ *
+ * @param[in]  instanceHandle        Symmetric instance handle
+ * @param[out] pStats                Statistics
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_UNSUPPORTED    Instance has no software precomputes
+ *
+ *****************************************************************************/
+CpaStatus icp_sal_SymPrecompCacheGetStats(
+    CpaInstanceHandle instanceHandle,
+    icp_sal_sym_precomp_cache_stats_t *pStats);
+
+#endif
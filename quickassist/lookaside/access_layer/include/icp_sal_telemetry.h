@@ -0,0 +1,275 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_telemetry.h
+ *
+ * @ingroup SalTelemetry
+ *
+ * This file contains the live telemetry API and the layout of the shared
+ * memory segment it publishes.
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_TELEMETRY_H
+#define ICP_SAL_TELEMETRY_H
+
+#include "cpa.h"
+
+/* The segment of process <pid> is named ICP_SAL_TELEMETRY_SHM_PREFIX<pid> */
+#define ICP_SAL_TELEMETRY_SHM_PREFIX "/qat_telemetry."
+
+/* Environment variable read by icp_sal_userStart(). When set to a number of
+ * milliseconds, telemetry is published at that interval. */
+#define ICP_SAL_TELEMETRY_ENV "QAT_TELEMETRY_INTERVAL_MS"
+
+/* Magic number at the start of the segment, "QTLM" */
+#define ICP_SAL_TELEMETRY_MAGIC (0x4D4C5451U)
+
+/* Version of the segment layout */
+#define ICP_SAL_TELEMETRY_VERSION (1)
+
+/* Publishing interval used when none is given, and its limits */
+#define ICP_SAL_TELEMETRY_DEFAULT_INTERVAL_MS (1000)
+#define ICP_SAL_TELEMETRY_MIN_INTERVAL_MS (10)
+#define ICP_SAL_TELEMETRY_MAX_INTERVAL_MS (60 * 60 * 1000)
+
+/* Entries in the segment; further instances and pools are not published */
+#define ICP_SAL_TELEMETRY_MAX_INSTANCES (256)
+#define ICP_SAL_TELEMETRY_MAX_POOLS (1024)
+
+#define ICP_SAL_TELEMETRY_NAME_LEN (32)
+#define ICP_SAL_TELEMETRY_POOL_NAME_LEN (16)
+
+/* Instance types */
+#define ICP_SAL_TELEMETRY_TYPE_CY (1)
+#define ICP_SAL_TELEMETRY_TYPE_SYM (2)
+#define ICP_SAL_TELEMETRY_TYPE_ASYM (3)
+#define ICP_SAL_TELEMETRY_TYPE_DC (4)
+
+/*
+ ***************************************************************************
+ * @ingroup SalTelemetry
+ *      Telemetry of one instance
+ *
+ * @description
+ *      The request counters are the symmetric crypto statistics for CY and
+ *      SYM instances, the sum of the compression and decompression
+ *      statistics for DC instances and zero for ASYM instances. They stay
+ *      at zero when statistics are disabled in the configuration. The
+ *      in-flight counts are those of the request rings; the peaks are the
+ *      highest counts seen by the publisher since it was started.
+ ***************************************************************************/
+typedef struct icp_sal_telemetry_instance_s
+{
+    Cpa16U type;
+    /**< One of ICP_SAL_TELEMETRY_TYPE_* */
+    Cpa16U accelId;
+    /**< Accelerator the instance belongs to */
+    Cpa32U instance;
+    /**< Instance number within its accelerator and type */
+    Cpa32U running;
+    /**< 1 when the instance was running at the last update */
+    Cpa32U symInflight;
+    Cpa32U symMaxInflight;
+    Cpa32U symPeakInflight;
+    /**< Symmetric crypto ring, CY and SYM instances */
+    Cpa32U asymInflight;
+    Cpa32U asymMaxInflight;
+    Cpa32U asymPeakInflight;
+    /**< Asymmetric crypto ring, CY and ASYM instances */
+    Cpa32U dcInflight;
+    Cpa32U dcMaxInflight;
+    Cpa32U dcPeakInflight;
+    /**< Compression ring, DC instances */
+    Cpa64U numRequests;
+    Cpa64U numRequestErrors;
+    Cpa64U numCompleted;
+    Cpa64U numCompletedErrors;
+} icp_sal_telemetry_instance_t;
+
+/*
+ ***************************************************************************
+ * @ingroup SalTelemetry
+ *      Telemetry of one memory pool
+ *
+ * @description
+ *      minAvailBlks is the low-water mark of availBlks since the pool was
+ *      created; numBlks - minAvailBlks is its high-water mark of use.
+ *      numAllocFails counts allocations refused because the pool was
+ *      empty.
+ ***************************************************************************/
+typedef struct icp_sal_telemetry_pool_s
+{
+    char name[ICP_SAL_TELEMETRY_POOL_NAME_LEN];
+    Cpa32U numBlks;
+    Cpa32U blkSizeInBytes;
+    Cpa32U availBlks;
+    Cpa32U minAvailBlks;
+    Cpa64U numAllocFails;
+} icp_sal_telemetry_pool_t;
+
+/*
+ ***************************************************************************
+ * @ingroup SalTelemetry
+ *      Layout of the shared memory segment
+ *
+ * @description
+ *      The publisher increments seq before and after every update, so seq
+ *      is odd while an update is in progress. A reader copies the segment
+ *      and keeps the copy only if seq was even and unchanged across the
+ *      copy. updateNs is the CLOCK_MONOTONIC time of the last update.
+ ***************************************************************************/
+typedef struct icp_sal_telemetry_shm_s
+{
+    Cpa32U magic;
+    /**< ICP_SAL_TELEMETRY_MAGIC */
+    Cpa16U version;
+    /**< ICP_SAL_TELEMETRY_VERSION */
+    Cpa16U reserved;
+    Cpa32U size;
+    /**< sizeof(icp_sal_telemetry_shm_t) */
+    Cpa32U pid;
+    /**< Publishing process */
+    volatile Cpa32U seq;
+    /**< Sequence counter, odd during updates */
+    Cpa32U intervalMs;
+    /**< Publishing interval */
+    Cpa64U updateNs;
+    /**< Time of the last update */
+    Cpa64U numUpdates;
+    /**< Updates since the publisher was started */
+    char processName[ICP_SAL_TELEMETRY_NAME_LEN];
+    /**< Section name the process was started with */
+    Cpa32U numInstances;
+    /**< Valid entries in instances */
+    Cpa32U numPools;
+    /**< Valid entries in pools */
+    icp_sal_telemetry_instance_t instances[ICP_SAL_TELEMETRY_MAX_INSTANCES];
+    icp_sal_telemetry_pool_t pools[ICP_SAL_TELEMETRY_MAX_POOLS];
+} icp_sal_telemetry_shm_t;
+
+/*
+ ***************************************************************************
+ * @ingroup SalTelemetry
+ *      Start publishing telemetry
+ *
+ * @description
+ *      Creates the shared memory segment of the calling process and starts
+ *      a thread that updates it every intervalMs milliseconds with the
+ *      state of all instances and memory pools of the process. The data
+ *      path is not touched by the publisher. icp_sal_userStart() calls
+ *      this function when ICP_SAL_TELEMETRY_ENV is set.
+ *
+ * @context
+ *      This function may be called at any time.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] intervalMs    Publishing interval in milliseconds, or 0 for
+ *                          ICP_SAL_TELEMETRY_DEFAULT_INTERVAL_MS
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  intervalMs out of range
+ * @retval CPA_STATUS_FAIL           Telemetry is already being published
+ * @retval CPA_STATUS_RESOURCE       The segment or thread could not be
+ *                                   created
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_TelemetryStart(Cpa32U intervalMs);
+
+/*
+ ***************************************************************************
+ * @ingroup SalTelemetry
+ *      Stop publishing telemetry
+ *
+ * @description
+ *      Stops the publisher thread and removes the shared memory segment.
+ *      icp_sal_userStop() calls this function before the instances are
+ *      shut down.
+ *
+ * @context
+ *      This function may be called at any time.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_TelemetryStop(void);
+
+#endif
@@ -0,0 +1,322 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+
+
+/*
+ ***************************************************************************
+ * @file icp_sal_trace.h
+ *
+ * @ingroup SalTrace
+ *
+ * This file contains the request lifecycle trace API and the layout of the
+ * trace files written by icp_sal_TraceDump().
+ *
+ ***************************************************************************/
+
+#ifndef ICP_SAL_TRACE_H
+#define ICP_SAL_TRACE_H
+
+#include "cpa.h"
+
+/* Magic number at the start of a trace file, "QATT" */
+#define ICP_SAL_TRACE_FILE_MAGIC (0x54544151U)
+
+/* Version of the trace file layout */
+#define ICP_SAL_TRACE_FILE_VERSION (1)
+
+/* Number of trace records per thread used when none is given */
+#define ICP_SAL_TRACE_DEFAULT_ENTRIES (64 * 1024)
+
+/* Smallest and largest number of trace records per thread */
+#define ICP_SAL_TRACE_MIN_ENTRIES (64)
+#define ICP_SAL_TRACE_MAX_ENTRIES (16 * 1024 * 1024)
+
+/*
+ ***************************************************************************
+ * @ingroup SalTrace
+ *      Trace events
+ *
+ * @description
+ *      ENQUEUE and the CALLBACK events carry the request identifier, which
+ *      is the address of the CpaCySymOpData for symmetric requests and of
+ *      the CpaDcRqResults for compression requests. RING_PUT and
+ *      TAIL_WRITE carry the identifier of the last request enqueued by the
+ *      same thread. DEQUEUE is recorded before the response is handed to
+ *      the service and carries no identifier; it belongs to the next
+ *      CALLBACK_START of the same thread.
+ ***************************************************************************/
+typedef enum icp_sal_trace_event_e
+{
+    ICP_SAL_TRACE_EVENT_ENQUEUE = 1,
+    /**< Request accepted by the service; arg is the service */
+    ICP_SAL_TRACE_EVENT_RING_PUT,
+    /**< Ring space reserved; arg is the ring */
+    ICP_SAL_TRACE_EVENT_TAIL_WRITE,
+    /**< Ring tail written to the device; arg is the ring */
+    ICP_SAL_TRACE_EVENT_DEQUEUE,
+    /**< Response taken from the ring; arg is the ring */
+    ICP_SAL_TRACE_EVENT_CALLBACK_START,
+    /**< User callback about to be called; arg is the service */
+    ICP_SAL_TRACE_EVENT_CALLBACK_END,
+    /**< User callback returned; arg is the service */
+    ICP_SAL_TRACE_EVENT_CALIBRATE,
+    /**< Written by icp_sal_TraceMeasureOverhead(), ignored by tools */
+} icp_sal_trace_event_t;
+
+/* Services reported in the arg of ENQUEUE and CALLBACK events */
+#define ICP_SAL_TRACE_SERVICE_SYM (1)
+#define ICP_SAL_TRACE_SERVICE_DC (2)
+
+/* Ring reported in the arg of ring events */
+#define ICP_SAL_TRACE_RING(accelId, bankNum, ringNum)                          \
+    ((((accelId)&0xFFFF) << 16) | (((bankNum)&0xFF) << 8) | ((ringNum)&0xFF))
+
+/*
+ ***************************************************************************
+ * @ingroup SalTrace
+ *      Trace record, as kept in memory and written to trace files
+ ***************************************************************************/
+typedef struct icp_sal_trace_record_s
+{
+    Cpa64U timestampNs;
+    /**< CLOCK_MONOTONIC time of the event in nanoseconds */
+    Cpa64U id;
+    /**< Request identifier, 0 if none */
+    Cpa32U arg;
+    /**< Event argument, see icp_sal_trace_event_t */
+    Cpa16U event;
+    /**< One of icp_sal_trace_event_t */
+    Cpa16U reserved;
+    Cpa32U threadId;
+    /**< Kernel thread id of the recording thread */
+    Cpa32U reserved2;
+} icp_sal_trace_record_t;
+
+/*
+ ***************************************************************************
+ * @ingroup SalTrace
+ *      Trace file header, followed by numRecords icp_sal_trace_record_t.
+ *      The records of each thread are contiguous and oldest first.
+ ***************************************************************************/
+typedef struct icp_sal_trace_file_header_s
+{
+    Cpa32U magic;
+    /**< ICP_SAL_TRACE_FILE_MAGIC */
+    Cpa16U version;
+    /**< ICP_SAL_TRACE_FILE_VERSION */
+    Cpa16U recordSize;
+    /**< sizeof(icp_sal_trace_record_t) */
+    Cpa64U numRecords;
+    /**< Number of records in the file */
+} icp_sal_trace_file_header_t;
+
+/*
+ ***************************************************************************
+ * @ingroup SalTrace
+ *      Enable request tracing
+ *
+ * @description
+ *      Starts recording trace events. Each thread that records an event
+ *      gets its own ring of numEntries records, allocated on its first
+ *      event; once full, the oldest records are overwritten. Recording
+ *      takes no lock. The ring size is fixed when the first ring is
+ *      allocated and only changes after icp_sal_TraceFree().
+ *
+ * @context
+ *      This function may be called at any time.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] numEntries    Records per thread, rounded up to a power of 2,
+ *                          or 0 for ICP_SAL_TRACE_DEFAULT_ENTRIES
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  numEntries out of range
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_TraceEnable(Cpa32U numEntries);
+
+/*
+ ***************************************************************************
+ * @ingroup SalTrace
+ *      Disable request tracing
+ *
+ * @description
+ *      Stops recording trace events. Recorded events are kept.
+ *
+ * @context
+ *      This function may be called at any time.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_TraceDisable(void);
+
+/*
+ ***************************************************************************
+ * @ingroup SalTrace
+ *      Write the recorded events to a file
+ *
+ * @description
+ *      Writes an icp_sal_trace_file_header_t followed by the records of
+ *      every thread. Records written while tracing is enabled may be
+ *      overwritten during the dump; disable tracing first for a consistent
+ *      snapshot.
+ *
+ * @context
+ *      This function may be called at any time.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] fileName      Path of the file to write
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_FAIL           The file could not be written
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_TraceDump(const char *fileName);
+
+/*
+ ***************************************************************************
+ * @ingroup SalTrace
+ *      Free the trace rings
+ *
+ * @description
+ *      Drops all recorded events and frees the per-thread rings.
+ *
+ * @context
+ *      Tracing must be disabled and no thread may be submitting or polling
+ *      requests.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Tracing is enabled
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_TraceFree(void);
+
+/*
+ ***************************************************************************
+ * @ingroup SalTrace
+ *      Measure the cost of a trace point
+ *
+ * @description
+ *      Times numEvents trace points with tracing disabled and then enabled
+ *      and returns the average cost of each in nanoseconds. The enabled
+ *      run records ICP_SAL_TRACE_EVENT_CALIBRATE events into the calling
+ *      thread's ring. The enabled state of tracing is restored on return.
+ *
+ * @context
+ *      This function may be called at any time.
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @param[in]  numEvents     Number of trace points to time
+ * @param[out] pDisabledNs   Average cost of a disabled trace point
+ * @param[out] pEnabledNs    Average cost of an enabled trace point
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter
+ * @retval CPA_STATUS_RESOURCE       The trace ring could not be allocated
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_TraceMeasureOverhead(Cpa32U numEvents,
+                                       Cpa64U *pDisabledNs,
+                                       Cpa64U *pEnabledNs);
+
+#endif
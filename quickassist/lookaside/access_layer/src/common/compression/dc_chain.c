@@ -103,6 +103,8 @@
 #include "lac_sym_hash.h"
 #include "lac_sym_alg_chain.h"
 #include "lac_sym_auth_enc.h"
+#include "lac_sync.h"
+#include "icp_sal_dc_chain_batch.h"
 
 
 static const dc_chain_cmd_tbl_t dc_chain_cmd_table[] = {
@@ -651,6 +653,7 @@ CpaStatus dcChainInitSessions(CpaInstanceHandle dcInstance,
     Cpa32U i;
     CpaBoolean cyInitialized = CPA_FALSE;
     lac_session_desc_t *pCySessDesc = NULL;
+    icp_qat_fw_chain_stor2_req_t *pChainStor2Req = NULL;
     sal_compression_service_t *pService =
         (sal_compression_service_t *)dcInstance;
 
@@ -674,13 +677,12 @@ CpaStatus dcChainInitSessions(CpaInstanceHandle dcInstance,
             {
                 if (CPA_TRUE == cyInitialized)
                 {
-                    /* For crypto, destroy spinlock and mutex */
+                    /* For crypto, reset the session update state */
                     pCySessDesc = pSessHead->pCySessionDesc;
 #ifdef ICP_PARAM_CHECK
                     LAC_CHECK_NULL_PARAM(pCySessDesc);
 #endif
-                    LAC_SPINLOCK_DESTROY(&pCySessDesc->requestQueueLock);
-                    osalAtomicSet(0, &pCySessDesc->accessLock);
+                    osalAtomicSet(0, &pCySessDesc->updateInProgress);
                 }
                 LAC_LOG_ERROR("Init compression session failure\n");
                 return status;
@@ -739,6 +741,13 @@ CpaStatus dcChainInitSessions(CpaInstanceHandle dcInstance,
             ICP_QAT_FW_COMN_HDR_FLAGS_BUILD(ICP_QAT_FW_COMN_REQ_FLAG_SET);
         pSessHead->hdr.comn_hdr.resrvd1 = 0;
         pSessHead->hdr.comn_hdr.numLinks = numSessions;
+
+        /* Prebuild the request every chaining operation starts from */
+        LAC_OS_BZERO(&pSessHead->reqTemplate,
+                     sizeof(icp_qat_fw_comp_chain_req_t));
+        osalMemCopy((void *)&pSessHead->reqTemplate,
+                    (void *)(&pSessHead->hdr.comn_hdr),
+                    sizeof(icp_qat_comp_chain_req_hdr_t));
     }
     else
     {
@@ -757,6 +766,14 @@ CpaStatus dcChainInitSessions(CpaInstanceHandle dcInstance,
                 ICP_QAT_FW_COMP_CHAIN_NO_CRC64_CTX);
         pSessHead->hdr.comn_hdr2.comn_req_flags = 0;
         pSessHead->hdr.comn_hdr2.extended_serv_specif_flags = 0;
+
+        /* Prebuild the request every chaining operation starts from */
+        pChainStor2Req =
+            (icp_qat_fw_chain_stor2_req_t *)&pSessHead->reqTemplate;
+        LAC_OS_BZERO(pChainStor2Req, sizeof(icp_qat_fw_comp_chain_req_t));
+        osalMemCopy((void *)(&pChainStor2Req->comn_hdr),
+                    (void *)(&pSessHead->hdr.comn_hdr2),
+                    sizeof(icp_qat_fw_comn_req_hdr_t));
     }
 
     return status;
@@ -851,13 +868,12 @@ CpaStatus cpaDcChainRemoveSession(const CpaInstanceHandle dcInstance,
         status = CPA_STATUS_RETRY;
     }
 
-    /* For crypto, destroy spinlock and mutex */
+    /* For crypto, reset the session update state */
     pCySessDesc = pSessHead->pCySessionDesc;
 #ifdef ICP_PARAM_CHECK
     LAC_CHECK_NULL_PARAM(pCySessDesc);
 #endif
-    LAC_SPINLOCK_DESTROY(&pCySessDesc->requestQueueLock);
-    osalAtomicSet(0, &pCySessDesc->accessLock);
+    osalAtomicSet(0, &pCySessDesc->updateInProgress);
 
     return status;
 }
@@ -1257,11 +1273,35 @@ STATIC void dcChainOp_MemPoolEntryFree(void *pEntry)
 /**
  *****************************************************************************
  * @ingroup Dc_Chaining
- *      Chaining perform operation
+ *      Release a chaining request that was built but not sent
+ *
+ * @param[in]       pChainCookie       Chaining cookie of the request
+ *
+ *****************************************************************************/
+STATIC void dcChainOp_Release(dc_chain_cookie_t *pChainCookie)
+{
+    dc_chain_session_head_t *pSessHead =
+        (dc_chain_session_head_t *)pChainCookie->pSessionHandle;
+
+    osalAtomicDec(&(pSessHead->pendingChainCbCount));
+    dcChainOp_MemPoolEntryFree(pChainCookie->pDcCookieAddr);
+    dcChainOp_MemPoolEntryFree(pChainCookie->pCyCookieAddr);
+    dcChainOp_MemPoolEntryFree(pChainCookie->pDcRspAddr);
+    dcChainOp_MemPoolEntryFree(pChainCookie->pCyRspAddr);
+    dcChainOp_MemPoolEntryFree(pChainCookie);
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_Chaining
+ *      Build a chaining request
  *
  * @description
- *      Chaining perform operation, it is called at cpaDcChainPerformOp,
- *      which is used to perform chaining requests.
+ *      Allocates the cookies of a chaining request and builds the
+ *      compression and crypto requests it links to, without putting it on
+ *      the ring. The chaining request starts from the template built at
+ *      session init, so only the fields that change per request are
+ *      written.
  *
  * @param[in]       dcInstance         Instance handle derived from discovery
  *                                     functions.
@@ -1273,6 +1313,7 @@ STATIC void dcChainOp_MemPoolEntryFree(void *pEntry)
  * @param[in,out]   pResults           Chaining response result
  * @param[in]       callbackTag        For synchronous operation this callback
  *                                     shall be a null pointer.
+ * @param[out]      ppChainCookie      Chaining cookie holding the request
  *
  * @retval CPA_STATUS_SUCCESS        Function executed successfully
  * @retval CPA_STATUS_FAIL           Function failed to find device
@@ -1281,15 +1322,15 @@ STATIC void dcChainOp_MemPoolEntryFree(void *pEntry)
  * @retval CPA_STATUS_RETRY          Request re-submission needed
  *
  *****************************************************************************/
-CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
-                           CpaDcSessionHandle pSessionHandle,
-                           CpaBufferList *pSrcBuff,
-                           CpaBufferList *pDestBuff,
-                           Cpa8U numOperations,
-                           CpaDcChainOpData *pChainOpData,
-                           CpaDcChainRqResults *pResults,
-                           void *callbackTag)
-
+STATIC CpaStatus dcChainBuildOp(CpaInstanceHandle dcInstance,
+                                CpaDcSessionHandle pSessionHandle,
+                                CpaBufferList *pSrcBuff,
+                                CpaBufferList *pDestBuff,
+                                Cpa8U numOperations,
+                                CpaDcChainOpData *pChainOpData,
+                                CpaDcChainRqResults *pResults,
+                                void *callbackTag,
+                                dc_chain_cookie_t **ppChainCookie)
 {
     /* Compression service and chain service */
     sal_compression_service_t *pDcService =
@@ -1304,7 +1345,6 @@ CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
     lac_sym_bulk_cookie_t *pCyCookie = NULL;
     /* Request for chaining (compression + crypto) */
     icp_qat_fw_comp_chain_req_t *pChainReq = NULL;
-    icp_qat_fw_chain_stor2_req_t *pChainStor2Req = NULL;
     CpaStatus status = CPA_STATUS_SUCCESS;
     Cpa8U *pTemp;
     Cpa32U i;
@@ -1324,34 +1364,25 @@ CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
     }
 
     /* Populate chaining cookie */
-    LAC_OS_BZERO(pChainCookie, sizeof(dc_chain_cookie_t));
     pChainCookie->dcInstance = dcInstance;
     pChainCookie->pSessionHandle = pSessionHandle;
     pChainCookie->pResults = pResults;
+    pChainCookie->pDcRspAddr = NULL;
+    pChainCookie->pCyRspAddr = NULL;
+    pChainCookie->pDcCookieAddr = NULL;
+    pChainCookie->pCyCookieAddr = NULL;
     pChainCookie->callbackTag = callbackTag;
 
-    /* Build chaining common header */
+    /* Start from the request prebuilt at session init */
+    osalMemCopy((void *)&pChainCookie->request,
+                (void *)&pSessHead->reqTemplate,
+                sizeof(icp_qat_fw_comp_chain_req_t));
     if (!pDcService->generic_service_info.isGen4)
     {
         pChainReq = (icp_qat_fw_comp_chain_req_t *)&pChainCookie->request;
-        LAC_OS_BZERO(pChainReq, sizeof(icp_qat_fw_comp_chain_req_t));
-        osalMemCopy((void *)pChainReq,
-                    (void *)(&pSessHead->hdr.comn_hdr),
-                    sizeof(icp_qat_comp_chain_req_hdr_t));
         /* Save cookie pointer into request descriptor */
         LAC_MEM_SHARED_WRITE_FROM_PTR(pChainReq->opaque_data, pChainCookie);
     }
-    else
-    {
-        pChainStor2Req = (icp_qat_fw_chain_stor2_req_t *)&pChainCookie->request;
-        LAC_OS_BZERO(pChainStor2Req, sizeof(icp_qat_fw_chain_stor2_req_t));
-
-        /* Populates the QAT common request header part of the message
-         * (LW 0 to 1) */
-        osalMemCopy((void *)(&pChainStor2Req->comn_hdr),
-                    (void *)(&pSessHead->hdr.comn_hdr2),
-                    sizeof(icp_qat_fw_comn_req_hdr_t));
-    }
 
     osalAtomicInc(&(pSessHead->pendingChainCbCount));
     pTemp = (Cpa8U *)pSessionHandle + sizeof(dc_chain_session_head_t);
@@ -1438,46 +1469,108 @@ CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
             0);
     }
 
-    /*Put message on the ring*/
-    status = SalQatMsg_transPutMsg(pDcService->trans_handle_compression_tx,
-                                   (void *)&pChainCookie->request,
-                                   LAC_QAT_DC_REQ_SZ_LW,
-                                   LAC_LOG_MSG_DC,
-                                   NULL);
+    *ppChainCookie = pChainCookie;
+    return CPA_STATUS_SUCCESS;
 
-    /*update stats*/
-    if (CPA_STATUS_SUCCESS == status)
+out_err:
+    osalAtomicDec(&(pSessHead->pendingChainCbCount));
+    dcChainOp_MemPoolEntryFree(pDcCookie);
+    dcChainOp_MemPoolEntryFree(pCyCookie);
+    dcChainOp_MemPoolEntryFree(pChainCookie->pDcRspAddr);
+    dcChainOp_MemPoolEntryFree(pChainCookie->pCyRspAddr);
+    dcChainOp_MemPoolEntryFree(pChainCookie);
+    return status;
+}
+
+/* Count a chaining request put on the ring, or refused by it */
+STATIC void dcChainOp_StatInc(sal_compression_service_t *pDcService,
+                              dc_chain_session_head_t *pSessHead,
+                              CpaBoolean sent)
+{
+    if (pSessHead->pDcSessionDesc->sessDirection == CPA_DC_DIR_COMPRESS)
     {
-        if (pDcSessDesc->sessDirection == CPA_DC_DIR_COMPRESS)
-        {
+        if (sent)
             COMPRESSION_STAT_INC(numCompRequests, pDcService);
-        }
         else
-        {
-            COMPRESSION_STAT_INC(numDecompRequests, pDcService);
-        }
+            COMPRESSION_STAT_INC(numCompRequestsErrors, pDcService);
     }
     else
     {
-        if (pDcSessDesc->sessDirection == CPA_DC_DIR_COMPRESS)
-        {
-            COMPRESSION_STAT_INC(numCompRequestsErrors, pDcService);
-        }
+        if (sent)
+            COMPRESSION_STAT_INC(numDecompRequests, pDcService);
         else
-        {
             COMPRESSION_STAT_INC(numDecompRequestsErrors, pDcService);
-        }
-        goto out_err;
     }
-    return CPA_STATUS_SUCCESS;
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_Chaining
+ *      Chaining perform operation
+ *
+ * @description
+ *      Chaining perform operation, it is called at cpaDcChainPerformOp,
+ *      which is used to perform chaining requests.
+ *
+ * @param[in]       dcInstance         Instance handle derived from discovery
+ *                                     functions.
+ * @param[in]       pSessionHandle     Pointer to a session handle.
+ * @param[in]       pSrcBuff           Source buffer
+ * @param[in]       pDestBuff          Destination buffer
+ * @param[in]       numOperations      Number of operations for the chaining
+ * @param[in]       pChainOpData       Chaining operation data
+ * @param[in,out]   pResults           Chaining response result
+ * @param[in]       callbackTag        For synchronous operation this callback
+ *                                     shall be a null pointer.
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully
+ * @retval CPA_STATUS_FAIL           Function failed to find device
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter passed in
+ * @retval CPA_STATUS_RESOURCE       Failed to allocate required resources
+ * @retval CPA_STATUS_RETRY          Request re-submission needed
+ *
+ *****************************************************************************/
+CpaStatus dcChainPerformOp(CpaInstanceHandle dcInstance,
+                           CpaDcSessionHandle pSessionHandle,
+                           CpaBufferList *pSrcBuff,
+                           CpaBufferList *pDestBuff,
+                           Cpa8U numOperations,
+                           CpaDcChainOpData *pChainOpData,
+                           CpaDcChainRqResults *pResults,
+                           void *callbackTag)
+
+{
+    sal_compression_service_t *pDcService =
+        (sal_compression_service_t *)dcInstance;
+    dc_chain_cookie_t *pChainCookie = NULL;
+    CpaStatus status;
+
+    status = dcChainBuildOp(dcInstance,
+                            pSessionHandle,
+                            pSrcBuff,
+                            pDestBuff,
+                            numOperations,
+                            pChainOpData,
+                            pResults,
+                            callbackTag,
+                            &pChainCookie);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    /*Put message on the ring*/
+    status = SalQatMsg_transPutMsg(pDcService->trans_handle_compression_tx,
+                                   (void *)&pChainCookie->request,
+                                   LAC_QAT_DC_REQ_SZ_LW,
+                                   LAC_LOG_MSG_DC,
+                                   NULL);
+
+    /*update stats*/
+    dcChainOp_StatInc(pDcService,
+                      (dc_chain_session_head_t *)pSessionHandle,
+                      (CPA_STATUS_SUCCESS == status) ? CPA_TRUE : CPA_FALSE);
+    if (CPA_STATUS_SUCCESS != status)
+        dcChainOp_Release(pChainCookie);
 
-out_err:
-    osalAtomicDec(&(pSessHead->pendingChainCbCount));
-    dcChainOp_MemPoolEntryFree(pDcCookie);
-    dcChainOp_MemPoolEntryFree(pCyCookie);
-    dcChainOp_MemPoolEntryFree(pChainCookie->pDcRspAddr);
-    dcChainOp_MemPoolEntryFree(pChainCookie->pCyRspAddr);
-    dcChainOp_MemPoolEntryFree(pChainCookie);
     return status;
 }
 
@@ -1537,6 +1630,119 @@ CpaStatus cpaDcChainPerformOp(CpaInstanceHandle dcInstance,
                             callbackTag);
 }
 
+CpaStatus icp_sal_DcChainPerformOpBatch(CpaInstanceHandle dcInstance,
+                                        CpaDcSessionHandle pSessionHandle,
+                                        CpaDcChainOperations operation,
+                                        Cpa8U numOpDatas,
+                                        icp_sal_dc_chain_request_t *pRequests,
+                                        Cpa32U numRequests,
+                                        Cpa32U *pNumSubmitted)
+{
+    CpaInstanceHandle insHandle = NULL;
+    sal_compression_service_t *pService = NULL;
+    dc_chain_session_head_t *pSessHead = NULL;
+    dc_chain_cookie_t *pChainCookies[ICP_SAL_DC_CHAIN_MAX_BATCH];
+    Cpa32U *pMsgs[ICP_SAL_DC_CHAIN_MAX_BATCH];
+    icp_sal_dc_chain_request_t *pRequest = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaStatus buildStatus = CPA_STATUS_SUCCESS;
+    Cpa32U numBuilt = 0;
+    Cpa32U numPut = 0;
+    Cpa32U i;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = dcInstance;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pRequests);
+    LAC_CHECK_NULL_PARAM(pNumSubmitted);
+    LAC_CHECK_NULL_PARAM(insHandle);
+    SAL_CHECK_ADDR_TRANS_SETUP(insHandle);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    LAC_CHECK_STATEMENT_LOG((0 == numRequests) ||
+                                (numRequests > ICP_SAL_DC_CHAIN_MAX_BATCH),
+                            "%s",
+                            "Invalid number of requests");
+    if (CPA_STATUS_SUCCESS !=
+        dcChainSession_CheckChainSessDesc(
+            (dc_chain_session_head_t *)pSessionHandle, operation, numOpDatas))
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    for (i = 0; i < numRequests; i++)
+    {
+        LAC_CHECK_NULL_PARAM(pRequests[i].pSrcBuff);
+        LAC_CHECK_NULL_PARAM(pRequests[i].pDestBuff);
+        LAC_CHECK_NULL_PARAM(pRequests[i].pChainOpData);
+        LAC_CHECK_NULL_PARAM(pRequests[i].pResults);
+    }
+#endif
+    pService = (sal_compression_service_t *)insHandle;
+    if (NULL == pService->pDcChainService)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    /* Check if SAL is initialised otherwise return an error */
+    SAL_RUNNING_CHECK(insHandle);
+
+    /* A synchronous session would block on the first request of the
+     * batch */
+    pSessHead = (dc_chain_session_head_t *)pSessionHandle;
+    if (LacSync_GenWakeupSyncCaller == pSessHead->pdcChainCb)
+    {
+        LAC_INVALID_PARAM_LOG("Batches need a session with a callback");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    *pNumSubmitted = 0;
+    for (numBuilt = 0; numBuilt < numRequests; numBuilt++)
+    {
+        pRequest = &pRequests[numBuilt];
+        buildStatus = dcChainBuildOp(insHandle,
+                                     pSessionHandle,
+                                     pRequest->pSrcBuff,
+                                     pRequest->pDestBuff,
+                                     numOpDatas,
+                                     pRequest->pChainOpData,
+                                     pRequest->pResults,
+                                     pRequest->callbackTag,
+                                     &pChainCookies[numBuilt]);
+        if (CPA_STATUS_SUCCESS != buildStatus)
+            break;
+        pMsgs[numBuilt] = (Cpa32U *)&pChainCookies[numBuilt]->request;
+    }
+    if (0 == numBuilt)
+        return buildStatus;
+
+    /* One doorbell for every request that was built */
+    status = icp_adf_transPutMsgs(pService->trans_handle_compression_tx,
+                                  pMsgs,
+                                  LAC_QAT_DC_REQ_SZ_LW,
+                                  numBuilt,
+                                  &numPut);
+    if (CPA_STATUS_SUCCESS != status)
+        numPut = 0;
+
+    for (i = 0; i < numBuilt; i++)
+    {
+        dcChainOp_StatInc(
+            pService, pSessHead, (i < numPut) ? CPA_TRUE : CPA_FALSE);
+        if (i >= numPut)
+            dcChainOp_Release(pChainCookies[i]);
+    }
+
+    *pNumSubmitted = numPut;
+    return status;
+}
+
 /**
  ************************************************************************
  * @ingroup Dc_Chaining
@@ -75,6 +75,65 @@
 
 #include "dc_crc32.h"
 
+/* Reflected CRC-32 polynomial (RFC 1952) */
+#define DC_CRC32_POLY_REFLECTED (0xedb88320)
+
+/* Largest prime smaller than 65536 (RFC 1950) */
+#define DC_ADLER32_BASE (65521U)
+
+/* x^(2^n) modulo the CRC-32 polynomial, n = 0..31 */
+static const Cpa32U dcCrc32X2nTable[] = {
+    0x40000000, 0x20000000, 0x08000000, 0x00800000, 0x00008000, 0xedb88320,
+    0xb1e6b092, 0xa06a2517, 0xed627dae, 0x88d14467, 0xd7bbfe6a, 0xec447f11,
+    0x8e7ea170, 0x6427800e, 0x4d47bae0, 0x09fe548f, 0x83852d0f, 0x30362f1a,
+    0x7b5a9cc3, 0x31fec169, 0x9fec022a, 0x6c8dedc4, 0x15d6874d, 0x5fde7a4e,
+    0xbad90e37, 0x2e4e5eef, 0x4eaba214, 0xa8a472c0, 0x429a969e, 0x148d302a,
+    0xc40ba6d0, 0xc4e22c3c
+};
+
+/**
+ * @description
+ *     Multiplies a and b modulo the CRC-32 polynomial (reflected).
+ */
+STATIC Cpa32U dcCrc32MultModP(Cpa32U a, Cpa32U b)
+{
+    Cpa32U m = 1U << 31;
+    Cpa32U p = 0;
+
+    while (m)
+    {
+        if (a & m)
+        {
+            p ^= b;
+            if (0 == (a & (m - 1)))
+                break;
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ DC_CRC32_POLY_REFLECTED : b >> 1;
+    }
+
+    return p;
+}
+
+/**
+ * @description
+ *     Returns x^(n * 2^k) modulo the CRC-32 polynomial (reflected).
+ */
+STATIC Cpa32U dcCrc32X2nModP(Cpa64U n, Cpa32U k)
+{
+    Cpa32U p = 1U << 31; /* x^0 */
+
+    while (n)
+    {
+        if (n & 1)
+            p = dcCrc32MultModP(dcCrc32X2nTable[k & 31], p);
+        n >>= 1;
+        k++;
+    }
+
+    return p;
+}
+
 /**
  * @description
  *     Calculates CRC-32 checksum for given Buffer List
@@ -135,3 +194,43 @@ Cpa32U dcCalculateCrc32(CpaBufferList *pBufferList,
 
     return currentCrc;
 }
+
+Cpa32U dcCrc32Combine(Cpa32U crc1, Cpa32U crc2, Cpa64U len2)
+{
+    /* Shifting crc1 through len2 zero bytes is a multiplication by
+     * x^(8 * len2), after which crc2 accounts for the second block. */
+    return dcCrc32MultModP(dcCrc32X2nModP(len2, 3), crc1) ^ crc2;
+}
+
+Cpa32U dcAdler32Combine(Cpa32U adler1, Cpa32U adler2, Cpa64U len2)
+{
+    Cpa32U rem = (Cpa32U)(len2 % DC_ADLER32_BASE);
+    Cpa64U sum1 = adler1 & 0xffff;
+    Cpa64U sum2 = ((Cpa64U)rem * sum1) % DC_ADLER32_BASE;
+
+    sum1 += (adler2 & 0xffff) + DC_ADLER32_BASE - 1;
+    sum2 += ((adler1 >> 16) & 0xffff) + ((adler2 >> 16) & 0xffff) +
+            DC_ADLER32_BASE - rem;
+    if (sum1 >= DC_ADLER32_BASE)
+        sum1 -= DC_ADLER32_BASE;
+    if (sum1 >= DC_ADLER32_BASE)
+        sum1 -= DC_ADLER32_BASE;
+    if (sum2 >= ((Cpa64U)DC_ADLER32_BASE << 1))
+        sum2 -= ((Cpa64U)DC_ADLER32_BASE << 1);
+    if (sum2 >= DC_ADLER32_BASE)
+        sum2 -= DC_ADLER32_BASE;
+
+    return (Cpa32U)(sum1 | (sum2 << 16));
+}
+
+Cpa32U dcChecksumCombine(CpaDcChecksum checksumType,
+                         Cpa32U checksum1,
+                         Cpa32U checksum2,
+                         Cpa64U len2)
+{
+    if (CPA_DC_CRC32 == checksumType)
+    {
+        return dcCrc32Combine(checksum1, checksum2, len2);
+    }
+    return dcAdler32Combine(checksum1, checksum2, len2);
+}
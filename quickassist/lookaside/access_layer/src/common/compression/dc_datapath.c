@@ -96,9 +96,11 @@
 #include "lac_mem.h"
 #include "lac_mem_pools.h"
 #include "lac_log.h"
+#include "icp_adf_trace.h"
 #include "dc_stats.h"
 #include "lac_buffer_desc.h"
 #include "lac_sal.h"
+#include "lac_sal_ctrl.h"
 #include "lac_sync.h"
 #include "sal_service_state.h"
 #include "sal_qat_cmn_msg.h"
@@ -106,6 +108,7 @@
 #include "dc_err_sim.h"
 #endif
 #include "dc_error_counter.h"
+#include "dc_sw_fallback.h"
 #ifndef KERNEL_SPACE
 #include <stdlib.h>
 #include "dc_crc32.h"
@@ -174,9 +177,9 @@ STATIC void dcUpdateCompStateCrc(dc_compression_cookie_t *pCookie,
     }
 }
 
-STATIC void dcHandleIntegrityChecksums(dc_compression_cookie_t *pCookie,
-                                       CpaCrcData *crc_external,
-                                       CpaDcRqResults *pDcResults)
+void dcHandleIntegrityChecksums(dc_compression_cookie_t *pCookie,
+                                CpaCrcData *crc_external,
+                                CpaDcRqResults *pDcResults)
 {
     dc_integrity_crc_fw_t *crc_internal = &pCookie->dataIntegrityCrcs;
     dc_session_desc_t *pSessionDesc =
@@ -326,9 +329,9 @@ STATIC void dcHandleIntegrityChecksums(dc_compression_cookie_t *pCookie,
     }
 }
 
-STATIC void dcHandleIntegrityChecksumsGen4(dc_compression_cookie_t *pCookie,
-                                           CpaCrcData *crc_external,
-                                           CpaDcRqResults *pDcResults)
+void dcHandleIntegrityChecksumsGen4(dc_compression_cookie_t *pCookie,
+                                    CpaCrcData *crc_external,
+                                    CpaDcRqResults *pDcResults)
 {
     dc_integrity_crc_fw_t *crc_internal = &pCookie->dataIntegrityCrcs;
     dc_session_desc_t *pSessionDesc =
@@ -574,7 +577,13 @@ void dcCompression_ProcessCallback(void *pRespMsg)
             }
             if (NULL != pCbFunc)
             {
+                ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_CALLBACK_START,
+                              (LAC_ARCH_UINT)pResults,
+                              ICP_SAL_TRACE_SERVICE_DC);
                 pCbFunc(callbackTag, status);
+                ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_CALLBACK_END,
+                              (LAC_ARCH_UINT)pResults,
+                              ICP_SAL_TRACE_SERVICE_DC);
             }
         }
         if (DC_COMPRESSION_REQUEST == compDecomp)
@@ -892,7 +901,13 @@ void dcCompression_ProcessCallback(void *pRespMsg)
 
         if (NULL != pCbFunc)
         {
+            ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_CALLBACK_START,
+                          (LAC_ARCH_UINT)pResults,
+                          ICP_SAL_TRACE_SERVICE_DC);
             pCbFunc(callbackTag, status);
+            ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_CALLBACK_END,
+                          (LAC_ARCH_UINT)pResults,
+                          ICP_SAL_TRACE_SERVICE_DC);
         }
     }
 }
@@ -1731,12 +1746,26 @@ STATIC CpaStatus dcSendRequest(dc_compression_cookie_t *pCookie,
     CpaStatus status = CPA_STATUS_SUCCESS;
     Cpa64U seq_num = ICP_ADF_INVALID_SEND_SEQ;
 
-    /* Send to QAT */
-    status = SalQatMsg_transPutMsg(pService->trans_handle_compression_tx,
-                                   (void *)&(pCookie->request),
-                                   LAC_QAT_DC_REQ_SZ_LW,
-                                   LAC_LOG_MSG_DC,
-                                   &seq_num);
+    ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_ENQUEUE,
+                  (LAC_ARCH_UINT)pCookie->pResults,
+                  ICP_SAL_TRACE_SERVICE_DC);
+
+#ifdef ICP_DC_ERROR_SIMULATION
+    /* Reject the request as a full ring would */
+    if (CPA_TRUE == dcGetRetry())
+    {
+        status = CPA_STATUS_RETRY;
+    }
+    else
+#endif
+    {
+        /* Send to QAT */
+        status = SalQatMsg_transPutMsg(pService->trans_handle_compression_tx,
+                                       (void *)&(pCookie->request),
+                                       LAC_QAT_DC_REQ_SZ_LW,
+                                       LAC_LOG_MSG_DC,
+                                       &seq_num);
+    }
 
     if ((CPA_DC_STATEFUL == pSessionDesc->sessState) &&
         (CPA_STATUS_RETRY == status))
@@ -1803,6 +1832,9 @@ STATIC CpaStatus dcCompDecompData(sal_compression_service_t *pService,
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
     dc_compression_cookie_t *pCookie = NULL;
+#ifdef ICP_DC_SW_FALLBACK
+    dc_sw_fallback_reason_t reason = DC_SW_FALLBACK_NONE;
+#endif
 
     if ((LacSync_GenWakeupSyncCaller == pSessionDesc->pCompressionCb) &&
         isAsyncMode == CPA_TRUE)
@@ -1866,6 +1898,38 @@ STATIC CpaStatus dcCompDecompData(sal_compression_service_t *pService,
         return status;
     }
 
+    /* High priority requests go to the ring pair paired with the instance,
+     * which then owns the cookie and completes the request */
+    if (unlikely(CPA_TRUE == pSessionDesc->isHighPriority))
+    {
+        pService = (sal_compression_service_t *)SalCtrl_PriorityRoute(
+            &pService->generic_service_info);
+    }
+
+#ifdef ICP_DC_SW_FALLBACK
+    if (unlikely(NULL != pService->pDcSwFallback))
+    {
+        reason = dcSwFallbackSelect(
+            pService, pSessionDesc, pSrcBuff, CPA_STATUS_SUCCESS);
+        if (DC_SW_FALLBACK_NONE != reason)
+        {
+            return dcSwFallbackSubmit(pService,
+                                      pSessionDesc,
+                                      pSessionHandle,
+                                      pSrcBuff,
+                                      pDestBuff,
+                                      pResults,
+                                      flushFlag,
+                                      pOpData,
+                                      callbackTag,
+                                      compDecomp,
+                                      reason);
+        }
+        /* The API let the request through for the fallback to take it */
+        SAL_RUNNING_CHECK(pService);
+    }
+#endif
+
     /* Allocate the compression cookie
      * The memory is freed in callback or in sendRequest if an error occurs
      */
@@ -1954,6 +2018,29 @@ STATIC CpaStatus dcCompDecompData(sal_compression_service_t *pService,
         }
     }
 
+#ifdef ICP_DC_SW_FALLBACK
+    /* The ring is full, the fallback may take the request instead */
+    if (unlikely(CPA_STATUS_RETRY == status) &&
+        (NULL != pService->pDcSwFallback))
+    {
+        reason = dcSwFallbackSelect(pService, pSessionDesc, pSrcBuff, status);
+        if (DC_SW_FALLBACK_NONE != reason)
+        {
+            status = dcSwFallbackSubmit(pService,
+                                        pSessionDesc,
+                                        pSessionHandle,
+                                        pSrcBuff,
+                                        pDestBuff,
+                                        pResults,
+                                        flushFlag,
+                                        pOpData,
+                                        callbackTag,
+                                        compDecomp,
+                                        reason);
+        }
+    }
+#endif
+
     return status;
 }
 
@@ -2165,7 +2252,7 @@ CpaStatus cpaDcCompressData(CpaInstanceHandle dcInstance,
 #endif
 
     /* Check if SAL is initialised otherwise return an error */
-    SAL_RUNNING_CHECK(insHandle);
+    DC_RUNNING_CHECK(pService);
 
     /* This check is outside the parameter checking as it is needed to manage
      * zero length requests */
@@ -2327,7 +2414,7 @@ CpaStatus cpaDcCompressData2(CpaInstanceHandle dcInstance,
 #endif
 
     /* Check if SAL is initialised otherwise return an error */
-    SAL_RUNNING_CHECK(insHandle);
+    DC_RUNNING_CHECK(pService);
 
     /* This check is outside the parameter checking as it is needed to manage
      * zero length requests */
@@ -2504,7 +2591,7 @@ CpaStatus cpaDcDecompressData(CpaInstanceHandle dcInstance,
 #endif
 
     /* Check if SAL is initialised otherwise return an error */
-    SAL_RUNNING_CHECK(insHandle);
+    DC_RUNNING_CHECK(pService);
 
     /* This check is outside the parameter checking as it is needed to manage
      * zero length requests */
@@ -2647,7 +2734,7 @@ CpaStatus cpaDcDecompressData2(CpaInstanceHandle dcInstance,
 #endif
 
     /* Check if SAL is initialised otherwise return an error */
-    SAL_RUNNING_CHECK(insHandle);
+    DC_RUNNING_CHECK(pService);
 
     /* This check is outside the parameter checking as it is needed to manage
      * zero length requests */
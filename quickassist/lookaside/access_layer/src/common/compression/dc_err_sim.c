@@ -76,6 +76,7 @@
 
 static Cpa8U num_dc_errors;
 static CpaDcReqStatus dc_error;
+static Cpa8U num_dc_retries;
 
 CpaStatus dcSetNumError(Cpa8U numErrors, CpaDcReqStatus dcError)
 {
@@ -122,3 +123,27 @@ CpaDcReqStatus dcGetErrors(void)
     }
     return error;
 }
+
+CpaStatus dcSetNumRetry(Cpa8U numRetries)
+{
+    num_dc_retries = numRetries;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaBoolean dcGetRetry(void)
+{
+    if (DC_ERROR_SIM == num_dc_retries)
+    {
+        return CPA_TRUE;
+    }
+    else if (num_dc_retries > 0)
+    {
+        num_dc_retries--;
+        return CPA_TRUE;
+    }
+    else
+    {
+        return CPA_FALSE;
+    }
+}
@@ -255,6 +255,32 @@ CpaStatus cpaDcGenerateHeader(CpaDcSessionHandle pSessionHandle,
     return CPA_STATUS_SUCCESS;
 }
 
+Cpa32U dcDeflateFooterWrite(Cpa8U *pDest,
+                            CpaDcChecksum checksumType,
+                            Cpa32U checksum,
+                            Cpa64U inputSize)
+{
+    if (CPA_DC_CRC32 == checksumType)
+    {
+        pDest[0] = (Cpa8U)checksum;
+        pDest[1] = (Cpa8U)(checksum >> LAC_NUM_BITS_IN_BYTE);
+        pDest[2] = (Cpa8U)(checksum >> 2 * LAC_NUM_BITS_IN_BYTE);
+        pDest[3] = (Cpa8U)(checksum >> 3 * LAC_NUM_BITS_IN_BYTE);
+        /* ISIZE is the input length modulo 2^32 */
+        pDest[4] = (Cpa8U)inputSize;
+        pDest[5] = (Cpa8U)(inputSize >> LAC_NUM_BITS_IN_BYTE);
+        pDest[6] = (Cpa8U)(inputSize >> 2 * LAC_NUM_BITS_IN_BYTE);
+        pDest[7] = (Cpa8U)(inputSize >> 3 * LAC_NUM_BITS_IN_BYTE);
+        return DC_GZIP_FOOTER_SIZE;
+    }
+
+    pDest[0] = (Cpa8U)(checksum >> 3 * LAC_NUM_BITS_IN_BYTE);
+    pDest[1] = (Cpa8U)(checksum >> 2 * LAC_NUM_BITS_IN_BYTE);
+    pDest[2] = (Cpa8U)(checksum >> LAC_NUM_BITS_IN_BYTE);
+    pDest[3] = (Cpa8U)checksum;
+    return DC_ZLIB_FOOTER_SIZE;
+}
+
 CpaStatus cpaDcGenerateFooter(CpaDcSessionHandle pSessionHandle,
                               CpaFlatBuffer *pDestBuff,
                               CpaDcRqResults *pRes)
@@ -310,19 +336,11 @@ CpaStatus cpaDcGenerateFooter(CpaDcSessionHandle pSessionHandle,
             }
 #endif
 
-            /* Crc32 of the uncompressed data */
-            pDest[0] = (Cpa8U)crc32;
-            pDest[1] = (Cpa8U)(crc32 >> LAC_NUM_BITS_IN_BYTE);
-            pDest[2] = (Cpa8U)(crc32 >> 2 * LAC_NUM_BITS_IN_BYTE);
-            pDest[3] = (Cpa8U)(crc32 >> 3 * LAC_NUM_BITS_IN_BYTE);
-
-            /* Length of the uncompressed data */
-            pDest[4] = (Cpa8U)totalLenBeforeCompress;
-            pDest[5] = (Cpa8U)(totalLenBeforeCompress >> LAC_NUM_BITS_IN_BYTE);
-            pDest[6] =
-                (Cpa8U)(totalLenBeforeCompress >> 2 * LAC_NUM_BITS_IN_BYTE);
-            pDest[7] =
-                (Cpa8U)(totalLenBeforeCompress >> 3 * LAC_NUM_BITS_IN_BYTE);
+            /* Crc32 and length of the uncompressed data */
+            dcDeflateFooterWrite(pDest,
+                                 CPA_DC_CRC32,
+                                 crc32,
+                                 totalLenBeforeCompress);
 
             /* Increment produced by the number of bytes added to the buffer */
             pRes->produced += DC_GZIP_FOOTER_SIZE;
@@ -342,10 +360,7 @@ CpaStatus cpaDcGenerateFooter(CpaDcSessionHandle pSessionHandle,
 #endif
 
             /* Adler32 of the uncompressed data */
-            pDest[0] = (Cpa8U)(adler32 >> 3 * LAC_NUM_BITS_IN_BYTE);
-            pDest[1] = (Cpa8U)(adler32 >> 2 * LAC_NUM_BITS_IN_BYTE);
-            pDest[2] = (Cpa8U)(adler32 >> LAC_NUM_BITS_IN_BYTE);
-            pDest[3] = (Cpa8U)adler32;
+            dcDeflateFooterWrite(pDest, CPA_DC_ADLER32, adler32, 0);
 
             /* Increment produced by the number of bytes added to the buffer */
             pRes->produced += DC_ZLIB_FOOTER_SIZE;
@@ -133,6 +133,18 @@ CpaStatus dc_lz4_generate_header(const CpaFlatBuffer *dest_buff,
                                  const CpaDcCompLZ4BlockMaxSize max_block_size,
                                  const CpaBoolean block_indep,
                                  Cpa32U *count)
+{
+    return dc_lz4_generate_frame_header(
+        dest_buff, max_block_size, block_indep, CPA_FALSE, CPA_TRUE, count);
+}
+
+CpaStatus dc_lz4_generate_frame_header(
+    const CpaFlatBuffer *dest_buff,
+    const CpaDcCompLZ4BlockMaxSize max_block_size,
+    const CpaBoolean block_indep,
+    const CpaBoolean block_cksum,
+    const CpaBoolean content_cksum,
+    Cpa32U *count)
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
     lz4_hdr_t *header_ptr;
@@ -140,6 +152,8 @@ CpaStatus dc_lz4_generate_header(const CpaFlatBuffer *dest_buff,
     /* Check parameters */
 #ifdef ICP_PARAM_CHECK
     LAC_CHECK_PARAM_RANGE(block_indep, 0, 2);
+    LAC_CHECK_PARAM_RANGE(block_cksum, 0, 2);
+    LAC_CHECK_PARAM_RANGE(content_cksum, 0, 2);
     LAC_CHECK_NULL_PARAM(dest_buff);
     LAC_CHECK_NULL_PARAM(dest_buff->pData);
     LAC_CHECK_NULL_PARAM(count);
@@ -160,7 +174,8 @@ CpaStatus dc_lz4_generate_header(const CpaFlatBuffer *dest_buff,
     header_ptr->magic = DC_LZ4_FH_ID;
     header_ptr->bit_field.version = DC_LZ4_FH_FLG_VERSION;
     header_ptr->bit_field.blk_indep = block_indep;
-    header_ptr->bit_field.cnt_cksum = 1;
+    header_ptr->bit_field.blk_cksum = block_cksum;
+    header_ptr->bit_field.cnt_cksum = content_cksum;
     header_ptr->blk_maxsize = max_block_size + DC_LZ4_FH_MAX_BLK_SIZE_ENUM_MIN;
 
     status = dcXxhash32Lz4HdrChecksum(
@@ -0,0 +1,816 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file dc_lz4_frame.c
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Implementation of LZ4 frame compression: consecutive blocks of a
+ *      frame are compressed independently with several of them in flight,
+ *      and the frame header, block checksums and footer are written around
+ *      them in the destination as they complete in submission order.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_dc_lz4_frame.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_log.h"
+#include "sal_service_state.h"
+#include "sal_types_compression.h"
+#include "dc_datapath.h"
+#include "lac_buffer_desc.h"
+#include "dc_header_footer_lz4.h"
+#include "dc_xxhash32.h"
+
+/* Slot states, the callback moves a slot from BUSY to DONE */
+#define DC_LZ4_FRAME_SLOT_FREE (0)
+#define DC_LZ4_FRAME_SLOT_BUSY (1)
+#define DC_LZ4_FRAME_SLOT_DONE (2)
+
+/* Size field ahead of every data block, its high bit flags stored data */
+#define DC_LZ4_BLOCK_SIZE_FIELD (4)
+#define DC_LZ4_BLOCK_UNCOMPRESSED (0x80000000U)
+#define DC_LZ4_BLOCK_CKSUM_SIZE (4)
+#define DC_LZ4_END_MARK_SIZE (4)
+#define DC_LZ4_CONTENT_CKSUM_SIZE (4)
+
+/* Block maximum size in bytes, 64 KiB times 4 to the power of the enum */
+#define DC_LZ4_BLOCK_MAX_BYTES(maxSize) ((Cpa32U)(64 * 1024) << (2 * (maxSize)))
+
+struct dc_lz4_frame_s;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      One block of a frame in flight
+ *****************************************************************************/
+typedef struct dc_lz4_frame_slot_s
+{
+    OsalAtomic state;
+    /* DC_LZ4_FRAME_SLOT_FREE, _BUSY or _DONE */
+    CpaStatus cbStatus;
+    /* Status passed to the callback */
+    CpaBoolean firstBlock;
+    CpaBoolean lastBlock;
+    Cpa32U headerSize;
+    /* Bytes of frame header reserved ahead of the block */
+    CpaDcRqResults results;
+    /* Results of the block alone */
+    CpaDcRqResults *pUserResults;
+    CpaBufferList *pUserSrc;
+    CpaBufferList *pUserDest;
+    void *callbackTag;
+    CpaFlatBuffer dstFlats[ICP_SAL_DC_LZ4_FRAME_MAX_BUFFERS];
+    CpaBufferList dstList;
+    /* The user destination less the reserved header and trailer */
+    struct dc_lz4_frame_s *pFrame;
+} dc_lz4_frame_slot_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Frame stream state
+ *
+ * @description
+ *      The slots form a ring of maxInflight entries. The submitting thread
+ *      owns tail and startNext. head and contentHash are updated by
+ *      callbacks under lock.
+ *****************************************************************************/
+typedef struct dc_lz4_frame_s
+{
+    CpaInstanceHandle instance;
+    CpaDcSessionHandle sessionHandle;
+    CpaDcCallbackFn pCallback;
+    CpaDcCompLZ4BlockMaxSize blockMaxSize;
+    Cpa32U blockMaxBytes;
+    CpaBoolean blockChecksum;
+    CpaBoolean contentChecksum;
+    Cpa32U maxInflight;
+    Cpa32U footerSize;
+    Cpa8U *pMetaData;
+    /* Buffer list metadata of all slots, DMA-able */
+    dc_lz4_frame_slot_t *pSlots;
+    Cpa32U tail;
+    /* Next slot to submit */
+    CpaBoolean startNext;
+    /* The next block starts a frame */
+    Cpa32U head;
+    /* Next slot to complete */
+    dc_xxhash32_state_t contentHash;
+    /* XXH32 of the frame up to the last completed block */
+    lac_lock_t lock;
+} dc_lz4_frame_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Copy between a flat array and a buffer list at an offset
+ *
+ * @description
+ *      Copies len bytes to the list from pData when toList is CPA_TRUE,
+ *      from the list to pData otherwise. Fails if the list ends first.
+ *****************************************************************************/
+STATIC CpaStatus dcLz4FrameCopy(const CpaBufferList *pList,
+                                Cpa32U offset,
+                                Cpa8U *pData,
+                                Cpa32U len,
+                                CpaBoolean toList)
+{
+    const CpaFlatBuffer *pFlat = pList->pBuffers;
+    Cpa32U i = 0;
+    Cpa32U n = 0;
+
+    for (i = 0; i < pList->numBuffers && len > 0; i++, pFlat++)
+    {
+        if (offset >= pFlat->dataLenInBytes)
+        {
+            offset -= pFlat->dataLenInBytes;
+            continue;
+        }
+        n = pFlat->dataLenInBytes - offset;
+        if (n > len)
+        {
+            n = len;
+        }
+        if (CPA_TRUE == toList)
+        {
+            osalMemCopy(pFlat->pData + offset, pData, n);
+        }
+        else
+        {
+            osalMemCopy(pData, pFlat->pData + offset, n);
+        }
+        offset = 0;
+        pData += n;
+        len -= n;
+    }
+
+    return (0 == len) ? CPA_STATUS_SUCCESS : CPA_STATUS_FAIL;
+}
+
+/* Hash len bytes of a buffer list from an offset */
+STATIC CpaStatus dcLz4FrameHash(dc_xxhash32_state_t *pState,
+                                const CpaBufferList *pList,
+                                Cpa32U offset,
+                                Cpa32U len)
+{
+    const CpaFlatBuffer *pFlat = pList->pBuffers;
+    Cpa32U i = 0;
+    Cpa32U n = 0;
+
+    for (i = 0; i < pList->numBuffers && len > 0; i++, pFlat++)
+    {
+        if (offset >= pFlat->dataLenInBytes)
+        {
+            offset -= pFlat->dataLenInBytes;
+            continue;
+        }
+        n = pFlat->dataLenInBytes - offset;
+        if (n > len)
+        {
+            n = len;
+        }
+        dcXxhash32Update(pState, pFlat->pData + offset, n);
+        offset = 0;
+        len -= n;
+    }
+
+    return (0 == len) ? CPA_STATUS_SUCCESS : CPA_STATUS_FAIL;
+}
+
+STATIC void dcLz4FrameWrite32(Cpa8U *pDest, Cpa32U value)
+{
+    pDest[0] = (Cpa8U)value;
+    pDest[1] = (Cpa8U)(value >> LAC_NUM_BITS_IN_BYTE);
+    pDest[2] = (Cpa8U)(value >> 2 * LAC_NUM_BITS_IN_BYTE);
+    pDest[3] = (Cpa8U)(value >> 3 * LAC_NUM_BITS_IN_BYTE);
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Describe the part of a destination the hardware writes
+ *
+ * @description
+ *      Builds in pShadow the buffers of pDest less head bytes at the front
+ *      and tail bytes at the back, without copying any data.
+ *****************************************************************************/
+STATIC CpaStatus dcLz4FrameTrimList(const CpaBufferList *pDest,
+                                    Cpa32U head,
+                                    Cpa32U tail,
+                                    CpaBufferList *pShadow)
+{
+    CpaFlatBuffer *pFlat = NULL;
+    Cpa64U destSize = 0;
+    Cpa32U numBuffers = 0;
+    Cpa32U i = 0;
+
+    if (LacBuffDesc_BufferListVerify(
+            pDest, &destSize, LAC_NO_ALIGNMENT_SHIFT) != CPA_STATUS_SUCCESS)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid destination buffer list parameter");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (destSize <= (Cpa64U)head + tail)
+    {
+        LAC_INVALID_PARAM_LOG("The destination buffer is too small");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    for (i = 0; i < pDest->numBuffers; i++)
+    {
+        pFlat = &pDest->pBuffers[i];
+        if (head >= pFlat->dataLenInBytes)
+        {
+            head -= pFlat->dataLenInBytes;
+            continue;
+        }
+        if (numBuffers == ICP_SAL_DC_LZ4_FRAME_MAX_BUFFERS)
+        {
+            LAC_INVALID_PARAM_LOG("Too many destination buffers");
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        pShadow->pBuffers[numBuffers].pData = pFlat->pData + head;
+        pShadow->pBuffers[numBuffers].dataLenInBytes =
+            pFlat->dataLenInBytes - head;
+        head = 0;
+        numBuffers++;
+    }
+
+    /* Give the trailer back from the last buffers */
+    while (tail > 0)
+    {
+        pFlat = &pShadow->pBuffers[numBuffers - 1];
+        if (tail < pFlat->dataLenInBytes)
+        {
+            pFlat->dataLenInBytes -= tail;
+            break;
+        }
+        tail -= pFlat->dataLenInBytes;
+        numBuffers--;
+    }
+
+    pShadow->numBuffers = numBuffers;
+    return CPA_STATUS_SUCCESS;
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Frame a completed block
+ *
+ * @description
+ *      Appends the block checksum and, for the last block, the frame
+ *      footer behind the block in the user destination, and adds the block
+ *      input to the content checksum. *pTrailerSize is set to the bytes
+ *      written behind the block. The hardware writes one data block, size
+ *      field first, for an input of at most the block maximum size.
+ *****************************************************************************/
+STATIC CpaStatus dcLz4FrameFinishBlock(dc_lz4_frame_t *pFrame,
+                                       dc_lz4_frame_slot_t *pSlot,
+                                       Cpa32U *pTrailerSize)
+{
+    CpaDcRqResults *pRes = &pSlot->results;
+    Cpa8U trailer[DC_LZ4_BLOCK_CKSUM_SIZE + DC_LZ4_END_MARK_SIZE +
+                  DC_LZ4_CONTENT_CKSUM_SIZE];
+    Cpa8U sizeField[DC_LZ4_BLOCK_SIZE_FIELD];
+    dc_xxhash32_state_t blockHash;
+    Cpa32U blockSize = 0;
+    Cpa32U trailerSize = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (CPA_TRUE == pFrame->blockChecksum)
+    {
+        status = dcLz4FrameCopy(pSlot->pUserDest,
+                                pSlot->headerSize,
+                                sizeField,
+                                DC_LZ4_BLOCK_SIZE_FIELD,
+                                CPA_FALSE);
+        LAC_CHECK_STATUS(status);
+        blockSize = ((Cpa32U)sizeField[0] |
+                     ((Cpa32U)sizeField[1] << LAC_NUM_BITS_IN_BYTE) |
+                     ((Cpa32U)sizeField[2] << 2 * LAC_NUM_BITS_IN_BYTE) |
+                     ((Cpa32U)sizeField[3] << 3 * LAC_NUM_BITS_IN_BYTE)) &
+                    ~DC_LZ4_BLOCK_UNCOMPRESSED;
+        if (DC_LZ4_BLOCK_SIZE_FIELD + blockSize != pRes->produced)
+        {
+            LAC_LOG_ERROR("Unexpected LZ4 block layout");
+            return CPA_STATUS_FAIL;
+        }
+        dcXxhash32Init(&blockHash, 0);
+        status = dcLz4FrameHash(&blockHash,
+                                pSlot->pUserDest,
+                                pSlot->headerSize + DC_LZ4_BLOCK_SIZE_FIELD,
+                                blockSize);
+        LAC_CHECK_STATUS(status);
+        dcLz4FrameWrite32(trailer, dcXxhash32Digest(&blockHash));
+        trailerSize += DC_LZ4_BLOCK_CKSUM_SIZE;
+    }
+
+    if (CPA_TRUE == pFrame->contentChecksum)
+    {
+        status = dcLz4FrameHash(
+            &pFrame->contentHash, pSlot->pUserSrc, 0, pRes->consumed);
+        LAC_CHECK_STATUS(status);
+    }
+
+    if (CPA_TRUE == pSlot->lastBlock)
+    {
+        dcLz4FrameWrite32(trailer + trailerSize, DC_LZ4_FF_END_MARK);
+        trailerSize += DC_LZ4_END_MARK_SIZE;
+        if (CPA_TRUE == pFrame->contentChecksum)
+        {
+            dcLz4FrameWrite32(trailer + trailerSize,
+                              dcXxhash32Digest(&pFrame->contentHash));
+            trailerSize += DC_LZ4_CONTENT_CKSUM_SIZE;
+        }
+    }
+
+    if (trailerSize > 0)
+    {
+        status = dcLz4FrameCopy(pSlot->pUserDest,
+                                pSlot->headerSize + pRes->produced,
+                                trailer,
+                                trailerSize,
+                                CPA_TRUE);
+        LAC_CHECK_STATUS(status);
+    }
+
+    *pTrailerSize = trailerSize;
+    return CPA_STATUS_SUCCESS;
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Complete the blocks at the head of the ring
+ *
+ * @description
+ *      Completes blocks in submission order for as long as the oldest one
+ *      is done, so the content checksum sees the blocks in frame order.
+ *****************************************************************************/
+STATIC void dcLz4FrameComplete(dc_lz4_frame_t *pFrame)
+{
+    dc_lz4_frame_slot_t *pSlot = NULL;
+    CpaDcRqResults *pRes = NULL;
+    CpaDcRqResults *pUserRes = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    void *callbackTag = NULL;
+    Cpa32U trailerSize = 0;
+
+    LAC_SPINLOCK(&pFrame->lock);
+    pSlot = &pFrame->pSlots[pFrame->head];
+    while (DC_LZ4_FRAME_SLOT_DONE == osalAtomicGet(&pSlot->state))
+    {
+        pRes = &pSlot->results;
+        pUserRes = pSlot->pUserResults;
+        status = pSlot->cbStatus;
+        trailerSize = 0;
+
+        if (CPA_TRUE == pSlot->firstBlock)
+        {
+            dcXxhash32Init(&pFrame->contentHash, 0);
+        }
+        if (CPA_STATUS_SUCCESS == status && CPA_DC_OK == pRes->status)
+        {
+            status = dcLz4FrameFinishBlock(pFrame, pSlot, &trailerSize);
+        }
+
+        *pUserRes = *pRes;
+        pUserRes->produced = pSlot->headerSize + pRes->produced + trailerSize;
+        pUserRes->checksum = (CPA_TRUE == pFrame->contentChecksum)
+                                 ? dcXxhash32Digest(&pFrame->contentHash)
+                                 : 0;
+        callbackTag = pSlot->callbackTag;
+
+        /* The slot is free before the callback, so the callback may
+         * submit the next block */
+        pFrame->head = (pFrame->head + 1) % pFrame->maxInflight;
+        osalAtomicSet(DC_LZ4_FRAME_SLOT_FREE, &pSlot->state);
+        pFrame->pCallback(callbackTag, status);
+
+        pSlot = &pFrame->pSlots[pFrame->head];
+    }
+    LAC_SPINUNLOCK(&pFrame->lock);
+}
+
+STATIC void dcLz4FrameCallback(void *callbackTag, CpaStatus status)
+{
+    dc_lz4_frame_slot_t *pSlot = (dc_lz4_frame_slot_t *)callbackTag;
+
+    pSlot->cbStatus = status;
+    /* Full barrier: the results are visible before the slot is DONE */
+    osalAtomicInc(&pSlot->state);
+    dcLz4FrameComplete(pSlot->pFrame);
+}
+
+STATIC CpaStatus dcLz4FrameCheckSetup(
+    const icp_sal_dc_lz4_frame_setup_t *pSetup,
+    Cpa32U *pMaxInflight)
+{
+    Cpa32U maxInflight = pSetup->maxInflight;
+
+    if ((pSetup->blockMaxSize < CPA_DC_LZ4_MAX_BLOCK_SIZE_64K) ||
+        (pSetup->blockMaxSize > CPA_DC_LZ4_MAX_BLOCK_SIZE_4M))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid blockMaxSize value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if ((CPA_FALSE != pSetup->blockChecksum &&
+         CPA_TRUE != pSetup->blockChecksum) ||
+        (CPA_FALSE != pSetup->contentChecksum &&
+         CPA_TRUE != pSetup->contentChecksum))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid checksum setting");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == maxInflight)
+    {
+        maxInflight = ICP_SAL_DC_LZ4_FRAME_DEFAULT_INFLIGHT;
+    }
+    if (maxInflight > ICP_SAL_DC_LZ4_FRAME_MAX_INFLIGHT)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid maxInflight");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    *pMaxInflight = maxInflight;
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC void dcLz4FrameFree(dc_lz4_frame_t *pFrame)
+{
+    if (NULL != pFrame->sessionHandle)
+    {
+        cpaDcRemoveSession(pFrame->instance, pFrame->sessionHandle);
+        LAC_OS_CAFREE(pFrame->sessionHandle);
+    }
+    LAC_SPINLOCK_DESTROY(&pFrame->lock);
+    LAC_OS_CAFREE(pFrame->pMetaData);
+    LAC_OS_FREE(pFrame->pSlots);
+    LAC_OS_FREE(pFrame);
+}
+
+CpaStatus icp_sal_DcLz4FrameCreate(CpaInstanceHandle instanceHandle,
+                                   const icp_sal_dc_lz4_frame_setup_t *pSetup,
+                                   CpaDcCallbackFn pCallback,
+                                   icp_sal_dc_lz4_frame_t *pFrame)
+{
+    CpaInstanceHandle insHandle = NULL;
+    sal_compression_service_t *pService = NULL;
+    CpaDcInstanceCapabilities dcCap = { 0 };
+    CpaDcSessionSetupData sessionData = { 0 };
+    dc_lz4_frame_t *pNew = NULL;
+    dc_lz4_frame_slot_t *pSlot = NULL;
+    Cpa32U maxInflight = 0;
+    Cpa32U sessionSize = 0;
+    Cpa32U contextSize = 0;
+    Cpa32U metaSize = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = instanceHandle;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(insHandle);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    LAC_CHECK_NULL_PARAM(pSetup);
+    LAC_CHECK_NULL_PARAM(pCallback);
+    LAC_CHECK_NULL_PARAM(pFrame);
+#endif
+    SAL_RUNNING_CHECK(insHandle);
+    status = dcLz4FrameCheckSetup(pSetup, &maxInflight);
+    LAC_CHECK_STATUS(status);
+
+    status = cpaDcQueryCapabilities(insHandle, &dcCap);
+    LAC_CHECK_STATUS(status);
+    if (CPA_TRUE != dcCap.statelessLZ4Compression)
+    {
+        LAC_UNSUPPORTED_PARAM_LOG("LZ4 compression is not supported");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    pService = (sal_compression_service_t *)insHandle;
+
+    sessionData.compLevel = pSetup->compLevel;
+    sessionData.compType = CPA_DC_LZ4;
+    sessionData.huffType = CPA_DC_HT_STATIC;
+    sessionData.autoSelectBestHuffmanTree = CPA_DC_ASB_DISABLED;
+    sessionData.sessDirection = CPA_DC_DIR_COMPRESS;
+    sessionData.sessState = CPA_DC_STATELESS;
+    sessionData.lz4BlockMaxSize = pSetup->blockMaxSize;
+    sessionData.lz4BlockChecksum = CPA_FALSE;
+    sessionData.lz4BlockIndependence = CPA_TRUE;
+    sessionData.checksum = CPA_DC_XXHASH32;
+    sessionData.accumulateXXHash = CPA_FALSE;
+
+    status = cpaDcGetSessionSize(
+        insHandle, &sessionData, &sessionSize, &contextSize);
+    LAC_CHECK_STATUS(status);
+    status = cpaDcBufferListGetMetaSize(
+        insHandle, ICP_SAL_DC_LZ4_FRAME_MAX_BUFFERS, &metaSize);
+    LAC_CHECK_STATUS(status);
+    metaSize = LAC_ALIGN_POW2_ROUNDUP(metaSize, LAC_64BYTE_ALIGNMENT);
+
+    status = LAC_OS_MALLOC(&pNew, sizeof(dc_lz4_frame_t));
+    LAC_CHECK_STATUS(status);
+    osalMemSet(pNew, 0, sizeof(dc_lz4_frame_t));
+    pNew->instance = insHandle;
+    pNew->pCallback = pCallback;
+    pNew->blockMaxSize = pSetup->blockMaxSize;
+    pNew->blockMaxBytes = DC_LZ4_BLOCK_MAX_BYTES(pSetup->blockMaxSize);
+    pNew->blockChecksum = pSetup->blockChecksum;
+    pNew->contentChecksum = pSetup->contentChecksum;
+    pNew->maxInflight = maxInflight;
+    pNew->startNext = CPA_TRUE;
+    pNew->footerSize = DC_LZ4_END_MARK_SIZE;
+    if (CPA_TRUE == pSetup->contentChecksum)
+    {
+        pNew->footerSize += DC_LZ4_CONTENT_CKSUM_SIZE;
+    }
+
+    status = LAC_SPINLOCK_INIT(&pNew->lock);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_FREE(pNew);
+        return status;
+    }
+    status = LAC_OS_MALLOC(&pNew->pSlots, maxInflight * sizeof(*pSlot));
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        osalMemSet(pNew->pSlots, 0, maxInflight * sizeof(*pSlot));
+        status = LAC_OS_CAMALLOC(&pNew->pMetaData,
+                                 maxInflight * metaSize,
+                                 LAC_64BYTE_ALIGNMENT,
+                                 pService->nodeAffinity);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LAC_OS_CAMALLOC(&pNew->sessionHandle,
+                                 sessionSize,
+                                 LAC_64BYTE_ALIGNMENT,
+                                 pService->nodeAffinity);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaDcInitSession(insHandle,
+                                  pNew->sessionHandle,
+                                  &sessionData,
+                                  NULL,
+                                  dcLz4FrameCallback);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            LAC_OS_CAFREE(pNew->sessionHandle);
+        }
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        dcLz4FrameFree(pNew);
+        return status;
+    }
+
+    for (i = 0; i < maxInflight; i++)
+    {
+        pSlot = &pNew->pSlots[i];
+        osalAtomicSet(DC_LZ4_FRAME_SLOT_FREE, &pSlot->state);
+        pSlot->pFrame = pNew;
+        pSlot->dstList.pBuffers = pSlot->dstFlats;
+        pSlot->dstList.pPrivateMetaData = pNew->pMetaData + i * metaSize;
+    }
+
+    *pFrame = pNew;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcLz4FrameCompressBound(icp_sal_dc_lz4_frame_t frame,
+                                          Cpa32U inputSize,
+                                          Cpa32U *pOutputSize)
+{
+    dc_lz4_frame_t *pFrame = (dc_lz4_frame_t *)frame;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U bound = 0;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pFrame);
+    LAC_CHECK_NULL_PARAM(pOutputSize);
+#endif
+    status = cpaDcLZ4CompressBound(pFrame->instance, inputSize, &bound);
+    LAC_CHECK_STATUS(status);
+
+    *pOutputSize = bound + DC_LZ4_HEADER_SIZE + pFrame->footerSize;
+    if (CPA_TRUE == pFrame->blockChecksum)
+    {
+        *pOutputSize += DC_LZ4_BLOCK_CKSUM_SIZE;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcLz4FrameCompress(icp_sal_dc_lz4_frame_t frame,
+                                     CpaBufferList *pSrcBuff,
+                                     CpaBufferList *pDestBuff,
+                                     CpaDcRqResults *pResults,
+                                     CpaBoolean lastBlock,
+                                     void *callbackTag)
+{
+    dc_lz4_frame_t *pFrame = (dc_lz4_frame_t *)frame;
+    dc_lz4_frame_slot_t *pSlot = NULL;
+    Cpa8U header[DC_LZ4_HEADER_SIZE];
+    CpaFlatBuffer headerFlat = { 0 };
+    Cpa64U srcSize = 0;
+    Cpa32U headerSize = 0;
+    Cpa32U trailerSize = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pFrame);
+    LAC_CHECK_NULL_PARAM(pResults);
+    LAC_CHECK_NULL_PARAM(pSrcBuff);
+    LAC_CHECK_NULL_PARAM(pDestBuff);
+#endif
+    SAL_RUNNING_CHECK(pFrame->instance);
+
+    if (LacBuffDesc_BufferListVerify(
+            pSrcBuff, &srcSize, LAC_NO_ALIGNMENT_SHIFT) != CPA_STATUS_SUCCESS)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid source buffer list parameter");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if ((0 == srcSize) || (srcSize > pFrame->blockMaxBytes))
+    {
+        LAC_INVALID_PARAM_LOG("The source must be 1 byte up to the block "
+                              "maximum size");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* Blocks complete in order, so the tail slot is free unless
+     * maxInflight blocks are in flight */
+    pSlot = &pFrame->pSlots[pFrame->tail];
+    if (DC_LZ4_FRAME_SLOT_FREE != osalAtomicGet(&pSlot->state))
+    {
+        return CPA_STATUS_RETRY;
+    }
+
+    if (CPA_TRUE == pFrame->startNext)
+    {
+        headerSize = DC_LZ4_HEADER_SIZE;
+    }
+    if (CPA_TRUE == pFrame->blockChecksum)
+    {
+        trailerSize += DC_LZ4_BLOCK_CKSUM_SIZE;
+    }
+    if (CPA_TRUE == lastBlock)
+    {
+        trailerSize += pFrame->footerSize;
+    }
+    status = dcLz4FrameTrimList(
+        pDestBuff, headerSize, trailerSize, &pSlot->dstList);
+    LAC_CHECK_STATUS(status);
+
+    if (CPA_TRUE == pFrame->startNext)
+    {
+        headerFlat.pData = header;
+        headerFlat.dataLenInBytes = sizeof(header);
+        status = dc_lz4_generate_frame_header(&headerFlat,
+                                              pFrame->blockMaxSize,
+                                              CPA_TRUE,
+                                              pFrame->blockChecksum,
+                                              pFrame->contentChecksum,
+                                              &headerSize);
+        LAC_CHECK_STATUS(status);
+        status = dcLz4FrameCopy(pDestBuff, 0, header, headerSize, CPA_TRUE);
+        LAC_CHECK_STATUS(status);
+    }
+
+    pSlot->firstBlock = pFrame->startNext;
+    pSlot->lastBlock = lastBlock;
+    pSlot->headerSize = headerSize;
+    pSlot->pUserResults = pResults;
+    pSlot->pUserSrc = pSrcBuff;
+    pSlot->pUserDest = pDestBuff;
+    pSlot->callbackTag = callbackTag;
+    osalMemSet(&pSlot->results, 0, sizeof(pSlot->results));
+
+    osalAtomicSet(DC_LZ4_FRAME_SLOT_BUSY, &pSlot->state);
+    status = cpaDcCompressData(pFrame->instance,
+                               pFrame->sessionHandle,
+                               pSrcBuff,
+                               &pSlot->dstList,
+                               &pSlot->results,
+                               CPA_DC_FLUSH_FINAL,
+                               pSlot);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        osalAtomicSet(DC_LZ4_FRAME_SLOT_FREE, &pSlot->state);
+        return status;
+    }
+
+    pFrame->tail = (pFrame->tail + 1) % pFrame->maxInflight;
+    pFrame->startNext = lastBlock;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcLz4FrameRemove(icp_sal_dc_lz4_frame_t frame)
+{
+    dc_lz4_frame_t *pFrame = (dc_lz4_frame_t *)frame;
+    Cpa32U i = 0;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pFrame);
+#endif
+    for (i = 0; i < pFrame->maxInflight; i++)
+    {
+        if (DC_LZ4_FRAME_SLOT_FREE !=
+            osalAtomicGet(&pFrame->pSlots[i].state))
+        {
+            return CPA_STATUS_RETRY;
+        }
+    }
+
+    dcLz4FrameFree(pFrame);
+    return CPA_STATUS_SUCCESS;
+}
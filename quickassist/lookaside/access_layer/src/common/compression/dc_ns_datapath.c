@@ -83,6 +83,7 @@
 #include "cpa_dc.h"
 #include "cpa_dc_dp.h"
 #include "icp_qat_hw_20_comp.h"
+#include "icp_sal_dc_ns_prepared.h"
 
 /*
 *******************************************************************************
@@ -112,6 +113,24 @@
 #include "dc_crc64.h"
 #include "sal_misc_error_stats.h"
 
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Prepared NS setup
+ *
+ * @description
+ *      Holds a validated copy of the setup data and the base request built
+ *      from it, which every request made with the handle starts from.
+ *****************************************************************************/
+typedef struct dc_ns_prepared_s
+{
+    CpaInstanceHandle instance;
+    /* Instance the setup was validated against */
+    CpaDcNsSetupData setupData;
+    icp_qat_fw_comp_req_t baseRequest;
+    /* Output of dcNsCreateBaseRequest for setupData */
+} dc_ns_prepared_t;
+
 STATIC void dcNsHandleIntegrityChecksums(dc_compression_cookie_t *pCookie,
                                          CpaCrcData *crc_external,
                                          CpaDcRqResults *pDcResults,
@@ -1275,6 +1294,7 @@ CpaStatus dcNsCreateBaseRequest(icp_qat_fw_comp_req_t *pMsg,
 STATIC CpaStatus dcNsCreateRequest(dc_compression_cookie_t *pCookie,
                                    sal_compression_service_t *pService,
                                    CpaDcNsSetupData *pSetupData,
+                                   const icp_qat_fw_comp_req_t *pBaseRequest,
                                    CpaBufferList *pSrcBuff,
                                    CpaBufferList *pDestBuff,
                                    CpaDcRqResults *pResults,
@@ -1305,11 +1325,22 @@ STATIC CpaStatus dcNsCreateRequest(dc_compression_cookie_t *pCookie,
 
     pMsg = &pCookie->request;
 
-    status = dcNsCreateBaseRequest(pMsg, pService, pSetupData);
-
-    if (status != CPA_STATUS_SUCCESS)
+    if (NULL != pBaseRequest)
     {
-        return status;
+        /* Fills the msg from the template built when the setup was
+         * prepared */
+        osalMemCopy((void *)pMsg,
+                    (void *)pBaseRequest,
+                    LAC_QAT_DC_REQ_SZ_LW * LAC_LONG_WORD_IN_BYTES);
+    }
+    else
+    {
+        status = dcNsCreateBaseRequest(pMsg, pService, pSetupData);
+
+        if (status != CPA_STATUS_SUCCESS)
+        {
+            return status;
+        }
     }
 
     /* Write the buffer descriptors */
@@ -1541,6 +1572,7 @@ STATIC CpaStatus dcNsCreateRequest(dc_compression_cookie_t *pCookie,
 
 STATIC CpaStatus dcNsCompDecompData(sal_compression_service_t *pService,
                                     CpaDcNsSetupData *pSetupData,
+                                    const icp_qat_fw_comp_req_t *pBaseRequest,
                                     CpaDcCallbackFn callbackFn,
                                     CpaInstanceHandle dcInstance,
                                     CpaBufferList *pSrcBuff,
@@ -1618,6 +1650,7 @@ STATIC CpaStatus dcNsCompDecompData(sal_compression_service_t *pService,
         status = dcNsCreateRequest(pCookie,
                                    pService,
                                    pSetupData,
+                                   pBaseRequest,
                                    pSrcBuff,
                                    pDestBuff,
                                    pResults,
@@ -1630,6 +1663,12 @@ STATIC CpaStatus dcNsCompDecompData(sal_compression_service_t *pService,
 
     if (status == CPA_STATUS_SUCCESS)
     {
+        /* Requests without a session are not sequenced. The cookie may
+         * still carry the send sequence of an earlier session request,
+         * which would make the software responses and replay take it for
+         * one, so clear it before the response can free the cookie */
+        LAC_MEM_POOL_BLK_SET_OPAQUE(pCookie, ICP_ADF_INVALID_SEND_SEQ);
+
         /* Send to QAT */
         status = SalQatMsg_transPutMsg(pService->trans_handle_compression_tx,
                                        (void *)&(pCookie->request),
@@ -1710,6 +1749,118 @@ STATIC CpaStatus dcNsCompDecompData(sal_compression_service_t *pService,
     return status;
 }
 
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Check NS setup data against an instance
+ *
+ * @description
+ *      Checks that do not depend on the request, run once by
+ *      icp_sal_DcNsPrepare and on every request of the cpaDcNs APIs.
+ *****************************************************************************/
+STATIC CpaStatus dcNsCheckSetupData(CpaInstanceHandle insHandle,
+                                    CpaDcNsSetupData *pSetupData,
+                                    CpaDcSessionDir sessDirection)
+{
+    /* Check that the parameters defined in pSetupData are valid for the
+     * device */
+    if (dcCheckSessionData((CpaDcSessionSetupData *)pSetupData, insHandle) !=
+        CPA_STATUS_SUCCESS)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (pSetupData->sessDirection != sessDirection)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid sessDirection value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (pSetupData->sessState == CPA_DC_STATEFUL)
+    {
+        LAC_INVALID_PARAM_LOG("Stateful mode of operation not available");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (CPA_DC_DIR_COMPRESS == sessDirection &&
+        CPA_DC_LZ4 == pSetupData->compType &&
+        CPA_TRUE == pSetupData->accumulateXXHash)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid accumulateXXHash value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC CpaStatus dcNsDecompressOp(sal_compression_service_t *pService,
+                                  CpaDcNsSetupData *pSetupData,
+                                  const icp_qat_fw_comp_req_t *pBaseRequest,
+                                  CpaBufferList *pSrcBuff,
+                                  CpaBufferList *pDestBuff,
+                                  CpaDcOpData *pOpData,
+                                  CpaDcRqResults *pResults,
+                                  CpaDcCallbackFn callbackFn,
+                                  void *callbackTag)
+{
+#ifdef ICP_PARAM_CHECK
+    Cpa64U srcBuffSize = 0;
+
+    if (dcCheckOpData(pService, pOpData) != CPA_STATUS_SUCCESS)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (pOpData->flushFlag == CPA_DC_FLUSH_NONE ||
+        pOpData->flushFlag == CPA_DC_FLUSH_SYNC)
+    {
+        LAC_INVALID_PARAM_LOG(
+            "Flush flags specific to stateful mode of operation not allowed");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (LacBuffDesc_BufferListVerifyNull(
+            pSrcBuff, &srcBuffSize, LAC_NO_ALIGNMENT_SHIFT) !=
+        CPA_STATUS_SUCCESS)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid source buffer list parameter");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (dcNsCheckSourceData(srcBuffSize) != CPA_STATUS_SUCCESS)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (dcNsCheckDestinationData(
+            pService, pSetupData, pDestBuff, DC_DECOMPRESSION_REQUEST) !=
+        CPA_STATUS_SUCCESS)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (pSrcBuff == pDestBuff)
+    {
+        LAC_INVALID_PARAM_LOG("In place operation not supported");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+
+    return dcNsCompDecompData(pService,
+                              pSetupData,
+                              pBaseRequest,
+                              callbackFn,
+                              (CpaInstanceHandle)pService,
+                              pSrcBuff,
+                              pDestBuff,
+                              pResults,
+                              pOpData->flushFlag,
+                              pOpData,
+                              callbackTag,
+                              DC_DECOMPRESSION_REQUEST,
+                              DC_NO_CNV);
+}
+
 CpaStatus cpaDcNsDecompressData(CpaInstanceHandle dcInstance,
                                 CpaDcNsSetupData *pSetupData,
                                 CpaBufferList *pSrcBuff,
@@ -1720,9 +1871,6 @@ CpaStatus cpaDcNsDecompressData(CpaInstanceHandle dcInstance,
                                 void *callbackTag)
 {
     sal_compression_service_t *pService = NULL;
-#ifdef ICP_PARAM_CHECK
-    Cpa64U srcBuffSize = 0;
-#endif
 
 #ifdef ICP_TRACE
     LAC_LOG8("Called with params (0x%lx, 0x%lx, 0x%lx, 0x%lx, 0x%lx, "
@@ -1762,27 +1910,59 @@ CpaStatus cpaDcNsDecompressData(CpaInstanceHandle dcInstance,
     SAL_RUNNING_CHECK(dcInstance);
 
 #ifdef ICP_PARAM_CHECK
-    /* Check that the parameters defined in pSetupData are valid for the
-     * device */
-    if (dcCheckSessionData((CpaDcSessionSetupData *)pSetupData, dcInstance) !=
+    if (dcNsCheckSetupData(dcInstance, pSetupData, CPA_DC_DIR_DECOMPRESS) !=
         CPA_STATUS_SUCCESS)
     {
         return CPA_STATUS_INVALID_PARAM;
     }
+#endif
 
-    if (pSetupData->sessDirection != CPA_DC_DIR_DECOMPRESS)
+    return dcNsDecompressOp(pService,
+                            pSetupData,
+                            NULL,
+                            pSrcBuff,
+                            pDestBuff,
+                            pOpData,
+                            pResults,
+                            callbackFn,
+                            callbackTag);
+}
+
+STATIC CpaStatus dcNsCompressOp(sal_compression_service_t *pService,
+                                CpaDcNsSetupData *pSetupData,
+                                const icp_qat_fw_comp_req_t *pBaseRequest,
+                                CpaBufferList *pSrcBuff,
+                                CpaBufferList *pDestBuff,
+                                CpaDcOpData *pOpData,
+                                CpaDcRqResults *pResults,
+                                CpaDcCallbackFn callbackFn,
+                                void *callbackTag)
+{
+    Cpa64U srcBuffSize = 0;
+    dc_cnv_mode_t cnvMode = DC_NO_CNV;
+
+#ifdef ICP_PARAM_CHECK
+    if (CPA_DC_LZ4 == pSetupData->compType &&
+        CPA_TRUE == pOpData->integrityCrcCheck)
     {
-        LAC_INVALID_PARAM_LOG("Invalid sessDirection value");
+        LAC_INVALID_PARAM_LOG("LZ4 with integrityCrcCheck is not supported"
+                              " in the compression direction");
         return CPA_STATUS_INVALID_PARAM;
     }
 
-    if (pSetupData->sessState == CPA_DC_STATEFUL)
+    if (dcCheckOpData(pService, pOpData) != CPA_STATUS_SUCCESS)
     {
-        LAC_INVALID_PARAM_LOG("Stateful mode of operation not available");
         return CPA_STATUS_INVALID_PARAM;
     }
 
-    if (dcCheckOpData(pService, pOpData) != CPA_STATUS_SUCCESS)
+    if (pOpData->compressAndVerifyAndRecover != CPA_TRUE &&
+        pOpData->compressAndVerifyAndRecover != CPA_FALSE)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (pOpData->compressAndVerify == CPA_FALSE &&
+        pOpData->compressAndVerifyAndRecover == CPA_TRUE)
     {
         return CPA_STATUS_INVALID_PARAM;
     }
@@ -1794,7 +1974,10 @@ CpaStatus cpaDcNsDecompressData(CpaInstanceHandle dcInstance,
             "Flush flags specific to stateful mode of operation not allowed");
         return CPA_STATUS_INVALID_PARAM;
     }
+#endif
 
+    /* This check is outside the parameter checking as it is needed to manage
+     * zero length requests */
     if (LacBuffDesc_BufferListVerifyNull(
             pSrcBuff, &srcBuffSize, LAC_NO_ALIGNMENT_SHIFT) !=
         CPA_STATUS_SUCCESS)
@@ -1803,13 +1986,14 @@ CpaStatus cpaDcNsDecompressData(CpaInstanceHandle dcInstance,
         return CPA_STATUS_INVALID_PARAM;
     }
 
+#ifdef ICP_PARAM_CHECK
     if (dcNsCheckSourceData(srcBuffSize) != CPA_STATUS_SUCCESS)
     {
         return CPA_STATUS_INVALID_PARAM;
     }
 
     if (dcNsCheckDestinationData(
-            pService, pSetupData, pDestBuff, DC_DECOMPRESSION_REQUEST) !=
+            pService, pSetupData, pDestBuff, DC_COMPRESSION_REQUEST) !=
         CPA_STATUS_SUCCESS)
     {
         return CPA_STATUS_INVALID_PARAM;
@@ -1822,18 +2006,36 @@ CpaStatus cpaDcNsDecompressData(CpaInstanceHandle dcInstance,
     }
 #endif
 
+    if (!(pService->generic_service_info.dcExtendedFeatures &
+          DC_CNV_EXTENDED_CAPABILITY) &&
+        (pOpData->compressAndVerify == CPA_TRUE))
+    {
+        LAC_INVALID_PARAM_LOG("CompressAndVerify feature not supported");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    if (pOpData->compressAndVerifyAndRecover == CPA_TRUE)
+    {
+        cnvMode = DC_CNVNR;
+    }
+    else if (pOpData->compressAndVerify == CPA_TRUE)
+    {
+        cnvMode = DC_CNV;
+    }
+
     return dcNsCompDecompData(pService,
                               pSetupData,
+                              pBaseRequest,
                               callbackFn,
-                              dcInstance,
+                              (CpaInstanceHandle)pService,
                               pSrcBuff,
                               pDestBuff,
                               pResults,
                               pOpData->flushFlag,
                               pOpData,
                               callbackTag,
-                              DC_DECOMPRESSION_REQUEST,
-                              DC_NO_CNV);
+                              DC_COMPRESSION_REQUEST,
+                              cnvMode);
 }
 
 CpaStatus cpaDcNsCompressData(CpaInstanceHandle dcInstance,
@@ -1847,8 +2049,6 @@ CpaStatus cpaDcNsCompressData(CpaInstanceHandle dcInstance,
 {
     sal_compression_service_t *pService = NULL;
     CpaInstanceHandle insHandle = NULL;
-    Cpa64U srcBuffSize = 0;
-    dc_cnv_mode_t cnvMode = DC_NO_CNV;
 
     LAC_CHECK_NULL_PARAM(pOpData);
 
@@ -1900,135 +2100,189 @@ CpaStatus cpaDcNsCompressData(CpaInstanceHandle dcInstance,
     SAL_RUNNING_CHECK(insHandle);
 
 #ifdef ICP_PARAM_CHECK
-    /* Check that the parameters defined in pSetupData are valid for the
-     * device */
-    if (dcCheckSessionData((CpaDcSessionSetupData *)pSetupData, insHandle) !=
+    if (dcNsCheckSetupData(insHandle, pSetupData, CPA_DC_DIR_COMPRESS) !=
         CPA_STATUS_SUCCESS)
     {
         return CPA_STATUS_INVALID_PARAM;
     }
+#endif
 
-    if (pSetupData->sessDirection != CPA_DC_DIR_COMPRESS)
+#ifdef ICP_DC_DYN_NOT_SUPPORTED
+    if (pSetupData->huffType == CPA_DC_HT_FULL_DYNAMIC)
     {
-        LAC_INVALID_PARAM_LOG("Invalid sessDirection value");
+        LAC_INVALID_PARAM_LOG("Invalid huffType value, dynamic compression "
+                              "not supported");
         return CPA_STATUS_INVALID_PARAM;
     }
+#endif
 
-    if (pSetupData->sessState == CPA_DC_STATEFUL)
-    {
-        LAC_INVALID_PARAM_LOG("Stateful mode of operation not available");
-        return CPA_STATUS_INVALID_PARAM;
-    }
+    return dcNsCompressOp(pService,
+                          pSetupData,
+                          NULL,
+                          pSrcBuff,
+                          pDestBuff,
+                          pOpData,
+                          pResults,
+                          callbackFn,
+                          callbackTag);
+}
 
-    if (CPA_DC_LZ4 == pSetupData->compType &&
-        CPA_TRUE == pSetupData->accumulateXXHash)
-    {
-        LAC_INVALID_PARAM_LOG("Invalid accumulateXXHash value");
-        return CPA_STATUS_INVALID_PARAM;
-    }
+CpaStatus icp_sal_DcNsPrepare(CpaInstanceHandle dcInstance,
+                              CpaDcNsSetupData *pSetupData,
+                              icp_sal_dc_ns_prepared_t *pPrepared)
+{
+    sal_compression_service_t *pService = NULL;
+    CpaInstanceHandle insHandle = NULL;
+    dc_ns_prepared_t *pNew = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
 
-    if (CPA_DC_LZ4 == pSetupData->compType &&
-        CPA_TRUE == pOpData->integrityCrcCheck)
+    if (dcInstance == CPA_INSTANCE_HANDLE_SINGLE)
     {
-        LAC_INVALID_PARAM_LOG("LZ4 with integrityCrcCheck is not supported"
-                              " in the compression direction");
-        return CPA_STATUS_INVALID_PARAM;
+        insHandle = dcGetFirstHandle();
     }
-
-    if (dcCheckOpData(pService, pOpData) != CPA_STATUS_SUCCESS)
+    else
     {
-        return CPA_STATUS_INVALID_PARAM;
+        insHandle = dcInstance;
     }
 
-    if (pOpData->compressAndVerifyAndRecover != CPA_TRUE &&
-        pOpData->compressAndVerifyAndRecover != CPA_FALSE)
+    LAC_CHECK_NULL_PARAM(insHandle);
+    LAC_CHECK_NULL_PARAM(pSetupData);
+    LAC_CHECK_NULL_PARAM(pPrepared);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    SAL_RUNNING_CHECK(insHandle);
+
+    /* The setup is checked here once whatever ICP_PARAM_CHECK says, the
+     * requests made with the handle only check their own parameters */
+    if (CPA_DC_DIR_COMPRESS != pSetupData->sessDirection &&
+        CPA_DC_DIR_DECOMPRESS != pSetupData->sessDirection)
     {
+        LAC_INVALID_PARAM_LOG("Invalid sessDirection value");
         return CPA_STATUS_INVALID_PARAM;
     }
-
-    if (pOpData->compressAndVerify == CPA_FALSE &&
-        pOpData->compressAndVerifyAndRecover == CPA_TRUE)
+    if (dcNsCheckSetupData(insHandle, pSetupData, pSetupData->sessDirection) !=
+        CPA_STATUS_SUCCESS)
     {
         return CPA_STATUS_INVALID_PARAM;
     }
-
-    if (pOpData->flushFlag == CPA_DC_FLUSH_NONE ||
-        pOpData->flushFlag == CPA_DC_FLUSH_SYNC)
+#ifdef ICP_DC_DYN_NOT_SUPPORTED
+    if (CPA_DC_DIR_COMPRESS == pSetupData->sessDirection &&
+        pSetupData->huffType == CPA_DC_HT_FULL_DYNAMIC)
     {
-        LAC_INVALID_PARAM_LOG(
-            "Flush flags specific to stateful mode of operation not allowed");
+        LAC_INVALID_PARAM_LOG("Invalid huffType value, dynamic compression "
+                              "not supported");
         return CPA_STATUS_INVALID_PARAM;
     }
 #endif
 
-    /* This check is outside the parameter checking as it is needed to manage
-     * zero length requests */
-    if (LacBuffDesc_BufferListVerifyNull(
-            pSrcBuff, &srcBuffSize, LAC_NO_ALIGNMENT_SHIFT) !=
-        CPA_STATUS_SUCCESS)
-    {
-        LAC_INVALID_PARAM_LOG("Invalid source buffer list parameter");
-        return CPA_STATUS_INVALID_PARAM;
-    }
+    pService = (sal_compression_service_t *)insHandle;
 
-#ifdef ICP_PARAM_CHECK
-    if (dcNsCheckSourceData(srcBuffSize) != CPA_STATUS_SUCCESS)
+    status = LAC_OS_MALLOC(&pNew, sizeof(dc_ns_prepared_t));
+    LAC_CHECK_STATUS(status);
+    osalMemSet(pNew, 0, sizeof(dc_ns_prepared_t));
+    pNew->instance = insHandle;
+    pNew->setupData = *pSetupData;
+
+    status = dcNsCreateBaseRequest(
+        &pNew->baseRequest, pService, &pNew->setupData);
+    if (CPA_STATUS_SUCCESS != status)
     {
-        return CPA_STATUS_INVALID_PARAM;
+        LAC_OS_FREE(pNew);
+        return status;
     }
 
-    if (dcNsCheckDestinationData(
-            pService, pSetupData, pDestBuff, DC_COMPRESSION_REQUEST) !=
-        CPA_STATUS_SUCCESS)
+    *pPrepared = pNew;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcNsCompressDataPrepared(icp_sal_dc_ns_prepared_t prepared,
+                                           CpaBufferList *pSrcBuff,
+                                           CpaBufferList *pDestBuff,
+                                           CpaDcOpData *pOpData,
+                                           CpaDcRqResults *pResults,
+                                           CpaDcCallbackFn callbackFn,
+                                           void *callbackTag)
+{
+    dc_ns_prepared_t *pPrepared = (dc_ns_prepared_t *)prepared;
+
+    LAC_CHECK_NULL_PARAM(pOpData);
+
+    if (pOpData->compressAndVerify != CPA_TRUE)
     {
-        return CPA_STATUS_INVALID_PARAM;
+        LAC_INVALID_PARAM_LOG(
+            "Data compression without verification not allowed");
+        return CPA_STATUS_UNSUPPORTED;
     }
 
-    if (pSrcBuff == pDestBuff)
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pPrepared);
+    LAC_CHECK_NULL_PARAM(pResults);
+    SAL_CHECK_ADDR_TRANS_SETUP(pPrepared->instance);
+    if (CPA_DC_DIR_COMPRESS != pPrepared->setupData.sessDirection)
     {
-        LAC_INVALID_PARAM_LOG("In place operation not supported");
+        LAC_INVALID_PARAM_LOG("The setup was prepared for decompression");
         return CPA_STATUS_INVALID_PARAM;
     }
 #endif
 
-#ifdef ICP_DC_DYN_NOT_SUPPORTED
-    if (pSetupData->huffType == CPA_DC_HT_FULL_DYNAMIC)
+    /* Check if SAL is initialised otherwise return an error */
+    SAL_RUNNING_CHECK(pPrepared->instance);
+
+    return dcNsCompressOp((sal_compression_service_t *)pPrepared->instance,
+                          &pPrepared->setupData,
+                          &pPrepared->baseRequest,
+                          pSrcBuff,
+                          pDestBuff,
+                          pOpData,
+                          pResults,
+                          callbackFn,
+                          callbackTag);
+}
+
+CpaStatus icp_sal_DcNsDecompressDataPrepared(
+    icp_sal_dc_ns_prepared_t prepared,
+    CpaBufferList *pSrcBuff,
+    CpaBufferList *pDestBuff,
+    CpaDcOpData *pOpData,
+    CpaDcRqResults *pResults,
+    CpaDcCallbackFn callbackFn,
+    void *callbackTag)
+{
+    dc_ns_prepared_t *pPrepared = (dc_ns_prepared_t *)prepared;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pPrepared);
+    LAC_CHECK_NULL_PARAM(pOpData);
+    LAC_CHECK_NULL_PARAM(pResults);
+    SAL_CHECK_ADDR_TRANS_SETUP(pPrepared->instance);
+    if (CPA_DC_DIR_DECOMPRESS != pPrepared->setupData.sessDirection)
     {
-        LAC_INVALID_PARAM_LOG("Invalid huffType value, dynamic compression "
-                              "not supported");
+        LAC_INVALID_PARAM_LOG("The setup was prepared for compression");
         return CPA_STATUS_INVALID_PARAM;
     }
 #endif
 
-    if (!(pService->generic_service_info.dcExtendedFeatures &
-          DC_CNV_EXTENDED_CAPABILITY) &&
-        (pOpData->compressAndVerify == CPA_TRUE))
-    {
-        LAC_INVALID_PARAM_LOG("CompressAndVerify feature not supported");
-        return CPA_STATUS_UNSUPPORTED;
-    }
+    /* Check if SAL is initialised otherwise return an error */
+    SAL_RUNNING_CHECK(pPrepared->instance);
+
+    return dcNsDecompressOp((sal_compression_service_t *)pPrepared->instance,
+                            &pPrepared->setupData,
+                            &pPrepared->baseRequest,
+                            pSrcBuff,
+                            pDestBuff,
+                            pOpData,
+                            pResults,
+                            callbackFn,
+                            callbackTag);
+}
 
-    if (pOpData->compressAndVerifyAndRecover == CPA_TRUE)
-    {
-        cnvMode = DC_CNVNR;
-    }
-    else if (pOpData->compressAndVerify == CPA_TRUE)
-    {
-        cnvMode = DC_CNV;
-    }
+CpaStatus icp_sal_DcNsFreePrepared(icp_sal_dc_ns_prepared_t prepared)
+{
+    dc_ns_prepared_t *pPrepared = (dc_ns_prepared_t *)prepared;
 
-    return dcNsCompDecompData(pService,
-                              pSetupData,
-                              callbackFn,
-                              insHandle,
-                              pSrcBuff,
-                              pDestBuff,
-                              pResults,
-                              pOpData->flushFlag,
-                              pOpData,
-                              callbackTag,
-                              DC_COMPRESSION_REQUEST,
-                              cnvMode);
+    LAC_CHECK_NULL_PARAM(pPrepared);
+    LAC_OS_FREE(pPrepared);
+
+    return CPA_STATUS_SUCCESS;
 }
 
 CpaStatus dcNsSetCnvErrorInj(CpaInstanceHandle dcInstance,
@@ -78,6 +78,7 @@
  */
 #include "cpa.h"
 #include "cpa_dc.h"
+#include "icp_sal_priority.h"
 
 #include "icp_qat_fw.h"
 #include "icp_qat_fw_comp.h"
@@ -1805,6 +1806,53 @@ CpaStatus cpaDcRemoveSession(const CpaInstanceHandle dcInstance,
     return status;
 }
 
+CpaStatus icp_sal_DcSessionSetPriority(CpaInstanceHandle dcInstance,
+                                       CpaDcSessionHandle pSessionHandle,
+                                       icp_sal_priority_t priority)
+{
+    CpaInstanceHandle insHandle = NULL;
+    dc_session_desc_t *pSessionDesc = NULL;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == dcInstance)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = dcInstance;
+    }
+
+    LAC_CHECK_NULL_PARAM(insHandle);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    LAC_CHECK_NULL_PARAM(pSessionHandle);
+    pSessionDesc = DC_SESSION_DESC_FROM_CTX_GET(pSessionHandle);
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+    if ((ICP_SAL_PRIORITY_NORMAL != priority) &&
+        (ICP_SAL_PRIORITY_HIGH != priority))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid priority");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* Data plane requests are sent on the ring of the instance given to
+     * the data plane calls */
+    if (CPA_TRUE == pSessionDesc->isDcDp)
+    {
+        LAC_UNSUPPORTED_PARAM_LOG("Data plane sessions are not supported");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    if ((0 != osalAtomicGet(&(pSessionDesc->pendingStatelessCbCount))) ||
+        (0 != osalAtomicGet(&(pSessionDesc->pendingStatefulCbCount))))
+    {
+        return CPA_STATUS_RETRY;
+    }
+
+    pSessionDesc->isHighPriority =
+        (ICP_SAL_PRIORITY_HIGH == priority) ? CPA_TRUE : CPA_FALSE;
+    return CPA_STATUS_SUCCESS;
+}
+
 CpaStatus dcGetSessionSize(CpaInstanceHandle dcInstance,
                            CpaDcSessionSetupData *pSessionData,
                            Cpa32U *pSessionSize,
@@ -0,0 +1,643 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file dc_split.c
+ *
+ * @defgroup Dc_DataCompression DC Data Compression
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Implementation of split compression: a large buffer is cut into
+ *      chunks which are compressed independently on several instances and
+ *      joined into a single gzip or zlib stream.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_poll.h"
+#include "icp_sal_dc_split.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_log.h"
+#include "lac_sync.h"
+#include "sal_service_state.h"
+#include "sal_types_compression.h"
+#include "dc_datapath.h"
+#include "dc_header_footer.h"
+#include "dc_crc32.h"
+
+/* Chunks in flight on one instance */
+#define DC_SPLIT_MAX_INFLIGHT (8)
+
+/* Time without any chunk completing after which the request fails */
+#define DC_SPLIT_TIMEOUT_NS ((Cpa64U)DC_SYNC_CALLBACK_TIMEOUT * 1000000ULL)
+
+/* Slot states, the callback moves a slot from BUSY to DONE */
+#define DC_SPLIT_SLOT_FREE (0)
+#define DC_SPLIT_SLOT_BUSY (1)
+#define DC_SPLIT_SLOT_DONE (2)
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      One request in flight on an instance
+ *****************************************************************************/
+typedef struct dc_split_slot_s
+{
+    OsalAtomic state;
+    /* DC_SPLIT_SLOT_FREE, _BUSY or _DONE */
+    CpaStatus cbStatus;
+    /* Status passed to the callback */
+    Cpa32U chunk;
+    /* Index of the chunk being compressed */
+    CpaFlatBuffer srcFlat;
+    CpaFlatBuffer dstFlat;
+    CpaBufferList srcList;
+    CpaBufferList dstList;
+} dc_split_slot_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Per-instance state of a split request
+ *****************************************************************************/
+typedef struct dc_split_inst_s
+{
+    CpaInstanceHandle instance;
+    CpaDcSessionHandle sessionHandle;
+    Cpa8U *pMetaData;
+    /* Buffer list metadata of all slots, DMA-able */
+    Cpa32U numInflight;
+    dc_split_slot_t slots[DC_SPLIT_MAX_INFLIGHT];
+} dc_split_inst_t;
+
+STATIC void dcSplitCallback(void *callbackTag, CpaStatus status)
+{
+    dc_split_slot_t *pSlot = (dc_split_slot_t *)callbackTag;
+
+    pSlot->cbStatus = status;
+    /* Full barrier: the results are visible before the slot is DONE */
+    osalAtomicInc(&pSlot->state);
+}
+
+STATIC CpaStatus dcSplitCheckSetup(const icp_sal_dc_split_setup_t *pSetup,
+                                   Cpa32U *pChunkSize)
+{
+    Cpa32U chunkSize = pSetup->chunkSize;
+
+    if ((CPA_DC_CRC32 != pSetup->checksum) &&
+        (CPA_DC_ADLER32 != pSetup->checksum))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid checksum, CRC32 or ADLER32 expected");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if ((CPA_DC_HT_STATIC != pSetup->huffType) &&
+        (CPA_DC_HT_FULL_DYNAMIC != pSetup->huffType))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid huffType value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == chunkSize)
+    {
+        chunkSize = ICP_SAL_DC_SPLIT_DEFAULT_CHUNK_SIZE;
+    }
+    if (chunkSize < ICP_SAL_DC_SPLIT_MIN_CHUNK_SIZE)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid chunkSize");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    *pChunkSize = chunkSize;
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC CpaStatus dcSplitCheckInstances(const CpaInstanceHandle *pInstances,
+                                       Cpa32U numInstances)
+{
+    CpaInstanceHandle insHandle = NULL;
+    Cpa32U i = 0;
+
+    LAC_CHECK_NULL_PARAM(pInstances);
+    LAC_CHECK_PARAM_RANGE(numInstances, 1, ICP_SAL_DC_SPLIT_MAX_INSTANCES + 1);
+
+    for (i = 0; i < numInstances; i++)
+    {
+        insHandle = pInstances[i];
+        if (CPA_INSTANCE_HANDLE_SINGLE == insHandle)
+        {
+            insHandle = dcGetFirstHandle();
+        }
+        LAC_CHECK_INSTANCE_HANDLE(insHandle);
+        SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC INLINE CpaInstanceHandle dcSplitInstance(CpaInstanceHandle instance)
+{
+    return (CPA_INSTANCE_HANDLE_SINGLE == instance) ? dcGetFirstHandle()
+                                                    : instance;
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Compute the stream layout of a split request
+ *
+ * @description
+ *      Each chunk gets a destination slot large enough for its worst case
+ *      on any of the instances. Slots follow the stream header.
+ *****************************************************************************/
+STATIC CpaStatus dcSplitLayout(const CpaInstanceHandle *pInstances,
+                               Cpa32U numInstances,
+                               const icp_sal_dc_split_setup_t *pSetup,
+                               Cpa32U chunkSize,
+                               Cpa32U inputSize,
+                               Cpa32U *pSlotSize,
+                               Cpa64U *pOutputSize)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U slotSize = 0;
+    Cpa32U bound = 0;
+    Cpa32U numChunks = 0;
+    Cpa32U i = 0;
+
+    if (inputSize < chunkSize)
+    {
+        chunkSize = inputSize;
+    }
+    for (i = 0; i < numInstances; i++)
+    {
+        status = cpaDcDeflateCompressBound(dcSplitInstance(pInstances[i]),
+                                           pSetup->huffType,
+                                           chunkSize,
+                                           &bound);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+        if (bound > slotSize)
+        {
+            slotSize = bound;
+        }
+    }
+
+    numChunks = (inputSize + chunkSize - 1) / chunkSize;
+    *pSlotSize = slotSize;
+    if (CPA_DC_CRC32 == pSetup->checksum)
+    {
+        *pOutputSize = DC_GZIP_HEADER_SIZE + DC_GZIP_FOOTER_SIZE;
+    }
+    else
+    {
+        *pOutputSize = DC_ZLIB_HEADER_SIZE + DC_ZLIB_FOOTER_SIZE;
+    }
+    *pOutputSize += (Cpa64U)numChunks * slotSize;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcSplitCompressBound(const CpaInstanceHandle *pInstances,
+                                       Cpa32U numInstances,
+                                       const icp_sal_dc_split_setup_t *pSetup,
+                                       Cpa32U inputSize,
+                                       Cpa64U *pOutputSize)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U chunkSize = 0;
+    Cpa32U slotSize = 0;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSetup);
+    LAC_CHECK_NULL_PARAM(pOutputSize);
+    status = dcSplitCheckInstances(pInstances, numInstances);
+    LAC_CHECK_STATUS(status);
+    if (0 == inputSize)
+    {
+        LAC_INVALID_PARAM_LOG("The input size needs to be greater than zero");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+    status = dcSplitCheckSetup(pSetup, &chunkSize);
+    LAC_CHECK_STATUS(status);
+
+    return dcSplitLayout(pInstances,
+                         numInstances,
+                         pSetup,
+                         chunkSize,
+                         inputSize,
+                         &slotSize,
+                         pOutputSize);
+}
+
+STATIC void dcSplitInstFree(dc_split_inst_t *pInst)
+{
+    if (NULL != pInst->sessionHandle)
+    {
+        cpaDcRemoveSession(pInst->instance, pInst->sessionHandle);
+        LAC_OS_CAFREE(pInst->sessionHandle);
+    }
+    LAC_OS_CAFREE(pInst->pMetaData);
+}
+
+STATIC CpaStatus dcSplitInstInit(dc_split_inst_t *pInst,
+                                 CpaInstanceHandle instance,
+                                 const icp_sal_dc_split_setup_t *pSetup)
+{
+    sal_compression_service_t *pService =
+        (sal_compression_service_t *)instance;
+    CpaDcSessionSetupData sessionData = { 0 };
+    CpaDcSessionHandle sessionHandle = NULL;
+    dc_split_slot_t *pSlot = NULL;
+    Cpa32U sessionSize = 0;
+    Cpa32U contextSize = 0;
+    Cpa32U metaSize = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pInst->instance = instance;
+
+    sessionData.compLevel = pSetup->compLevel;
+    sessionData.compType = CPA_DC_DEFLATE;
+    sessionData.huffType = pSetup->huffType;
+    sessionData.autoSelectBestHuffmanTree = CPA_DC_ASB_DISABLED;
+    sessionData.sessDirection = CPA_DC_DIR_COMPRESS;
+    sessionData.sessState = CPA_DC_STATELESS;
+    sessionData.checksum = pSetup->checksum;
+
+    status = cpaDcGetSessionSize(
+        instance, &sessionData, &sessionSize, &contextSize);
+    LAC_CHECK_STATUS(status);
+    status = cpaDcBufferListGetMetaSize(instance, 1, &metaSize);
+    LAC_CHECK_STATUS(status);
+    metaSize = LAC_ALIGN_POW2_ROUNDUP(metaSize, LAC_64BYTE_ALIGNMENT);
+
+    status = LAC_OS_CAMALLOC(&pInst->pMetaData,
+                             2 * DC_SPLIT_MAX_INFLIGHT * metaSize,
+                             LAC_64BYTE_ALIGNMENT,
+                             pService->nodeAffinity);
+    LAC_CHECK_STATUS(status);
+    status = LAC_OS_CAMALLOC(&sessionHandle,
+                             sessionSize,
+                             LAC_64BYTE_ALIGNMENT,
+                             pService->nodeAffinity);
+    LAC_CHECK_STATUS(status);
+
+    status = cpaDcInitSession(
+        instance, sessionHandle, &sessionData, NULL, dcSplitCallback);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_CAFREE(sessionHandle);
+        return status;
+    }
+    pInst->sessionHandle = sessionHandle;
+
+    for (i = 0; i < DC_SPLIT_MAX_INFLIGHT; i++)
+    {
+        pSlot = &pInst->slots[i];
+        osalAtomicSet(DC_SPLIT_SLOT_FREE, &pSlot->state);
+        pSlot->srcList.numBuffers = 1;
+        pSlot->srcList.pBuffers = &pSlot->srcFlat;
+        pSlot->srcList.pPrivateMetaData =
+            pInst->pMetaData + (2 * i) * metaSize;
+        pSlot->dstList.numBuffers = 1;
+        pSlot->dstList.pBuffers = &pSlot->dstFlat;
+        pSlot->dstList.pPrivateMetaData =
+            pInst->pMetaData + (2 * i + 1) * metaSize;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcSplitCompress(const CpaInstanceHandle *pInstances,
+                                  Cpa32U numInstances,
+                                  const icp_sal_dc_split_setup_t *pSetup,
+                                  CpaFlatBuffer *pSrcBuff,
+                                  CpaFlatBuffer *pDestBuff,
+                                  CpaDcRqResults *pResults)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    dc_split_inst_t *pInsts = NULL;
+    dc_split_inst_t *pInst = NULL;
+    dc_split_slot_t *pSlot = NULL;
+    CpaDcRqResults *pChunkResults = NULL;
+    CpaDcRqResults *pRes = NULL;
+    CpaDcFlush flushFlag = CPA_DC_FLUSH_FULL;
+    Cpa8U *pSlots = NULL;
+    Cpa32U inputSize = 0;
+    Cpa32U chunkSize = 0;
+    Cpa32U slotSize = 0;
+    Cpa32U numChunks = 0;
+    Cpa32U nextChunk = 0;
+    Cpa32U numDone = 0;
+    Cpa32U numInflight = 0;
+    Cpa32U headerSize = 0;
+    Cpa32U checksum = 0;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+    Cpa64U outputSize = 0;
+    Cpa64U offset = 0;
+    Cpa64U lastProgress = 0;
+    CpaBoolean progress = CPA_FALSE;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pSetup);
+    LAC_CHECK_NULL_PARAM(pResults);
+    LAC_CHECK_FLAT_BUFFER(pSrcBuff);
+    LAC_CHECK_FLAT_BUFFER(pDestBuff);
+    status = dcSplitCheckInstances(pInstances, numInstances);
+    LAC_CHECK_STATUS(status);
+    if (0 == pSrcBuff->dataLenInBytes)
+    {
+        LAC_INVALID_PARAM_LOG("The source buffer needs to be non empty");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+    for (i = 0; i < numInstances; i++)
+    {
+        SAL_RUNNING_CHECK(dcSplitInstance(pInstances[i]));
+    }
+    status = dcSplitCheckSetup(pSetup, &chunkSize);
+    LAC_CHECK_STATUS(status);
+
+    inputSize = pSrcBuff->dataLenInBytes;
+    status = dcSplitLayout(pInstances,
+                           numInstances,
+                           pSetup,
+                           chunkSize,
+                           inputSize,
+                           &slotSize,
+                           &outputSize);
+    LAC_CHECK_STATUS(status);
+    if (outputSize > pDestBuff->dataLenInBytes)
+    {
+        LAC_INVALID_PARAM_LOG("The destination buffer is smaller than "
+                              "icp_sal_DcSplitCompressBound");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    numChunks = (inputSize + chunkSize - 1) / chunkSize;
+
+    status = LAC_OS_MALLOC(&pInsts, numInstances * sizeof(dc_split_inst_t));
+    LAC_CHECK_STATUS(status);
+    osalMemSet(pInsts, 0, numInstances * sizeof(dc_split_inst_t));
+    status = LAC_OS_MALLOC(&pChunkResults, numChunks * sizeof(CpaDcRqResults));
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_FREE(pInsts);
+        return status;
+    }
+
+    for (i = 0; i < numInstances && CPA_STATUS_SUCCESS == status; i++)
+    {
+        status =
+            dcSplitInstInit(&pInsts[i], dcSplitInstance(pInstances[i]), pSetup);
+    }
+
+    /* The header goes first, chunk slots follow it */
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaDcGenerateHeader(
+            pInsts[0].sessionHandle, pDestBuff, &headerSize);
+    }
+    pSlots = pDestBuff->pData + headerSize;
+
+    lastProgress = osalTimestampGetNs();
+    while (CPA_STATUS_SUCCESS == status ? numDone < numChunks
+                                        : numInflight > 0)
+    {
+        progress = CPA_FALSE;
+
+        for (i = 0; i < numInstances; i++)
+        {
+            pInst = &pInsts[i];
+
+            /* Fill the free slots of the instance with the next chunks */
+            for (j = 0; j < DC_SPLIT_MAX_INFLIGHT &&
+                        CPA_STATUS_SUCCESS == status &&
+                        nextChunk < numChunks;
+                 j++)
+            {
+                pSlot = &pInst->slots[j];
+                if (DC_SPLIT_SLOT_FREE != osalAtomicGet(&pSlot->state))
+                {
+                    continue;
+                }
+
+                offset = (Cpa64U)nextChunk * chunkSize;
+                pSlot->chunk = nextChunk;
+                pSlot->srcFlat.pData = pSrcBuff->pData + offset;
+                pSlot->srcFlat.dataLenInBytes =
+                    (inputSize - offset < chunkSize) ? inputSize - offset
+                                                     : chunkSize;
+                pSlot->dstFlat.pData =
+                    pSlots + (Cpa64U)nextChunk * slotSize;
+                pSlot->dstFlat.dataLenInBytes = slotSize;
+                flushFlag = (nextChunk == numChunks - 1)
+                                ? CPA_DC_FLUSH_FINAL
+                                : CPA_DC_FLUSH_FULL;
+
+                /* After a full flush the session treats the next request
+                 * as a continuation and seeds its checksum from the
+                 * results, so every chunk is seeded explicitly. */
+                pRes = &pChunkResults[nextChunk];
+                osalMemSet(pRes, 0, sizeof(*pRes));
+                pRes->checksum = (CPA_DC_CRC32 == pSetup->checksum)
+                                     ? DC_DEFAULT_CRC
+                                     : DC_DEFAULT_ADLER32;
+                osalAtomicSet(DC_SPLIT_SLOT_BUSY, &pSlot->state);
+                status = cpaDcCompressData(pInst->instance,
+                                           pInst->sessionHandle,
+                                           &pSlot->srcList,
+                                           &pSlot->dstList,
+                                           pRes,
+                                           flushFlag,
+                                           pSlot);
+                if (CPA_STATUS_SUCCESS != status)
+                {
+                    osalAtomicSet(DC_SPLIT_SLOT_FREE, &pSlot->state);
+                    if (CPA_STATUS_RETRY == status)
+                    {
+                        /* Ring full, try this instance next round */
+                        status = CPA_STATUS_SUCCESS;
+                        break;
+                    }
+                    continue;
+                }
+                pInst->numInflight++;
+                numInflight++;
+                nextChunk++;
+            }
+
+            if (0 == pInst->numInflight)
+            {
+                continue;
+            }
+            icp_sal_DcPollInstance(pInst->instance, 0);
+
+            /* Reap the completed chunks */
+            for (j = 0; j < DC_SPLIT_MAX_INFLIGHT; j++)
+            {
+                pSlot = &pInst->slots[j];
+                if (DC_SPLIT_SLOT_DONE != osalAtomicGet(&pSlot->state))
+                {
+                    continue;
+                }
+
+                pRes = &pChunkResults[pSlot->chunk];
+                if (CPA_STATUS_SUCCESS == status &&
+                    (CPA_STATUS_SUCCESS != pSlot->cbStatus ||
+                     CPA_DC_OK != pRes->status ||
+                     pRes->consumed != pSlot->srcFlat.dataLenInBytes))
+                {
+                    LAC_LOG_ERROR1("Split compression of chunk %u failed\n",
+                                   pSlot->chunk);
+                    pResults->status = pRes->status;
+                    status = CPA_STATUS_FAIL;
+                }
+                osalAtomicSet(DC_SPLIT_SLOT_FREE, &pSlot->state);
+                pInst->numInflight--;
+                numInflight--;
+                numDone++;
+                progress = CPA_TRUE;
+            }
+        }
+
+        if (CPA_TRUE == progress)
+        {
+            lastProgress = osalTimestampGetNs();
+        }
+        else if (osalTimestampGetNs() - lastProgress > DC_SPLIT_TIMEOUT_NS)
+        {
+            break;
+        }
+        else
+        {
+            osalYield();
+        }
+    }
+
+    if (numInflight > 0)
+    {
+        /* Requests still reference the sessions and slots, so these are
+         * leaked rather than freed under the hardware. */
+        LAC_LOG_ERROR("Timed out waiting for split compression chunks\n");
+        return CPA_STATUS_FAIL;
+    }
+    if (CPA_STATUS_SUCCESS == status && numDone < numChunks)
+    {
+        LAC_LOG_ERROR("Timed out submitting split compression chunks\n");
+        status = CPA_STATUS_FAIL;
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        /* Close the gaps between the slots and combine the checksums */
+        offset = headerSize + pChunkResults[0].produced;
+        checksum = pChunkResults[0].checksum;
+        for (i = 1; i < numChunks; i++)
+        {
+            pRes = &pChunkResults[i];
+            memmove(pDestBuff->pData + offset,
+                    pSlots + (Cpa64U)i * slotSize,
+                    pRes->produced);
+            offset += pRes->produced;
+            checksum = dcChecksumCombine(
+                pSetup->checksum, checksum, pRes->checksum, pRes->consumed);
+        }
+        offset += dcDeflateFooterWrite(pDestBuff->pData + offset,
+                                       pSetup->checksum,
+                                       checksum,
+                                       inputSize);
+
+        pResults->status = CPA_DC_OK;
+        pResults->consumed = inputSize;
+        pResults->produced = (Cpa32U)offset;
+        pResults->checksum = checksum;
+        pResults->endOfLastBlock = CPA_TRUE;
+    }
+
+    for (i = 0; i < numInstances; i++)
+    {
+        dcSplitInstFree(&pInsts[i]);
+    }
+    LAC_OS_FREE(pChunkResults);
+    LAC_OS_FREE(pInsts);
+
+    return status;
+}
@@ -0,0 +1,549 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file dc_stream.c
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Implementation of pipelined stream compression: consecutive chunks
+ *      of one deflate stream are compressed independently with several of
+ *      them in flight, and completed in submission order.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_dc_stream.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_log.h"
+#include "sal_service_state.h"
+#include "sal_types_compression.h"
+#include "dc_datapath.h"
+#include "dc_header_footer.h"
+#include "dc_crc32.h"
+
+/* Slot states, the callback moves a slot from BUSY to DONE */
+#define DC_STREAM_SLOT_FREE (0)
+#define DC_STREAM_SLOT_BUSY (1)
+#define DC_STREAM_SLOT_DONE (2)
+
+struct dc_stream_s;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      One chunk of a stream in flight
+ *****************************************************************************/
+typedef struct dc_stream_slot_s
+{
+    OsalAtomic state;
+    /* DC_STREAM_SLOT_FREE, _BUSY or _DONE */
+    CpaStatus cbStatus;
+    /* Status passed to the callback */
+    CpaBoolean firstChunk;
+    CpaBoolean lastChunk;
+    Cpa32U headerSize;
+    /* Bytes of header written ahead of the chunk output */
+    CpaDcRqResults results;
+    /* Results of the chunk alone */
+    CpaDcRqResults *pUserResults;
+    CpaFlatBuffer *pUserDest;
+    void *callbackTag;
+    CpaFlatBuffer srcFlat;
+    CpaFlatBuffer dstFlat;
+    CpaBufferList srcList;
+    CpaBufferList dstList;
+    struct dc_stream_s *pStream;
+} dc_stream_slot_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Stream state
+ *
+ * @description
+ *      The slots form a ring of maxInflight entries. The submitting thread
+ *      owns tail and startNext. head, checksum and totalIn are updated by
+ *      callbacks under lock.
+ *****************************************************************************/
+typedef struct dc_stream_s
+{
+    CpaInstanceHandle instance;
+    CpaDcSessionHandle sessionHandle;
+    CpaDcCallbackFn pCallback;
+    CpaDcChecksum checksumType;
+    CpaDcHuffType huffType;
+    Cpa32U maxInflight;
+    Cpa32U headerSize;
+    Cpa32U footerSize;
+    Cpa8U *pMetaData;
+    /* Buffer list metadata of all slots, DMA-able */
+    dc_stream_slot_t *pSlots;
+    Cpa32U tail;
+    /* Next slot to submit */
+    CpaBoolean startNext;
+    /* The next chunk starts a stream */
+    Cpa32U head;
+    /* Next slot to complete */
+    Cpa32U checksum;
+    /* Checksum of the stream up to the last completed chunk */
+    Cpa64U totalIn;
+    /* Input length of the stream up to the last completed chunk */
+    lac_lock_t lock;
+} dc_stream_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Complete the chunks at the head of the ring
+ *
+ * @description
+ *      Completes chunks in submission order for as long as the oldest one
+ *      is done. A chunk finishing ahead of an older one stays DONE until
+ *      the callback of the older one gets here.
+ *****************************************************************************/
+STATIC void dcStreamComplete(dc_stream_t *pStream)
+{
+    dc_stream_slot_t *pSlot = NULL;
+    CpaDcRqResults *pRes = NULL;
+    CpaDcRqResults *pUserRes = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    void *callbackTag = NULL;
+    Cpa32U produced = 0;
+
+    LAC_SPINLOCK(&pStream->lock);
+    pSlot = &pStream->pSlots[pStream->head];
+    while (DC_STREAM_SLOT_DONE == osalAtomicGet(&pSlot->state))
+    {
+        pRes = &pSlot->results;
+        pUserRes = pSlot->pUserResults;
+        status = pSlot->cbStatus;
+
+        if (CPA_TRUE == pSlot->firstChunk)
+        {
+            pStream->checksum = pRes->checksum;
+            pStream->totalIn = pRes->consumed;
+        }
+        else
+        {
+            pStream->checksum = dcChecksumCombine(pStream->checksumType,
+                                                  pStream->checksum,
+                                                  pRes->checksum,
+                                                  pRes->consumed);
+            pStream->totalIn += pRes->consumed;
+        }
+
+        produced = pSlot->headerSize + pRes->produced;
+        if (CPA_STATUS_SUCCESS == status && CPA_DC_OK == pRes->status &&
+            CPA_TRUE == pSlot->lastChunk)
+        {
+            produced += dcDeflateFooterWrite(pSlot->pUserDest->pData +
+                                                 produced,
+                                             pStream->checksumType,
+                                             pStream->checksum,
+                                             pStream->totalIn);
+        }
+
+        *pUserRes = *pRes;
+        pUserRes->produced = produced;
+        pUserRes->checksum = pStream->checksum;
+        callbackTag = pSlot->callbackTag;
+
+        /* The slot is free before the callback, so the callback may
+         * submit the next chunk */
+        pStream->head = (pStream->head + 1) % pStream->maxInflight;
+        osalAtomicSet(DC_STREAM_SLOT_FREE, &pSlot->state);
+        pStream->pCallback(callbackTag, status);
+
+        pSlot = &pStream->pSlots[pStream->head];
+    }
+    LAC_SPINUNLOCK(&pStream->lock);
+}
+
+STATIC void dcStreamCallback(void *callbackTag, CpaStatus status)
+{
+    dc_stream_slot_t *pSlot = (dc_stream_slot_t *)callbackTag;
+
+    pSlot->cbStatus = status;
+    /* Full barrier: the results are visible before the slot is DONE */
+    osalAtomicInc(&pSlot->state);
+    dcStreamComplete(pSlot->pStream);
+}
+
+STATIC CpaStatus dcStreamCheckSetup(const icp_sal_dc_stream_setup_t *pSetup,
+                                    Cpa32U *pMaxInflight)
+{
+    Cpa32U maxInflight = pSetup->maxInflight;
+
+    if ((CPA_DC_CRC32 != pSetup->checksum) &&
+        (CPA_DC_ADLER32 != pSetup->checksum))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid checksum, CRC32 or ADLER32 expected");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if ((CPA_DC_HT_STATIC != pSetup->huffType) &&
+        (CPA_DC_HT_FULL_DYNAMIC != pSetup->huffType))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid huffType value");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == maxInflight)
+    {
+        maxInflight = ICP_SAL_DC_STREAM_DEFAULT_INFLIGHT;
+    }
+    if (maxInflight > ICP_SAL_DC_STREAM_MAX_INFLIGHT)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid maxInflight");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    *pMaxInflight = maxInflight;
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC void dcStreamFree(dc_stream_t *pStream)
+{
+    if (NULL != pStream->sessionHandle)
+    {
+        cpaDcRemoveSession(pStream->instance, pStream->sessionHandle);
+        LAC_OS_CAFREE(pStream->sessionHandle);
+    }
+    LAC_SPINLOCK_DESTROY(&pStream->lock);
+    LAC_OS_CAFREE(pStream->pMetaData);
+    LAC_OS_FREE(pStream->pSlots);
+    LAC_OS_FREE(pStream);
+}
+
+CpaStatus icp_sal_DcStreamCreate(CpaInstanceHandle instanceHandle,
+                                 const icp_sal_dc_stream_setup_t *pSetup,
+                                 CpaDcCallbackFn pCallback,
+                                 icp_sal_dc_stream_t *pStream)
+{
+    CpaInstanceHandle insHandle = NULL;
+    sal_compression_service_t *pService = NULL;
+    CpaDcSessionSetupData sessionData = { 0 };
+    dc_stream_t *pNew = NULL;
+    dc_stream_slot_t *pSlot = NULL;
+    Cpa32U maxInflight = 0;
+    Cpa32U sessionSize = 0;
+    Cpa32U contextSize = 0;
+    Cpa32U metaSize = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = instanceHandle;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(insHandle);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    LAC_CHECK_NULL_PARAM(pSetup);
+    LAC_CHECK_NULL_PARAM(pCallback);
+    LAC_CHECK_NULL_PARAM(pStream);
+#endif
+    SAL_RUNNING_CHECK(insHandle);
+    status = dcStreamCheckSetup(pSetup, &maxInflight);
+    LAC_CHECK_STATUS(status);
+
+    pService = (sal_compression_service_t *)insHandle;
+
+    sessionData.compLevel = pSetup->compLevel;
+    sessionData.compType = CPA_DC_DEFLATE;
+    sessionData.huffType = pSetup->huffType;
+    sessionData.autoSelectBestHuffmanTree = CPA_DC_ASB_DISABLED;
+    sessionData.sessDirection = CPA_DC_DIR_COMPRESS;
+    sessionData.sessState = CPA_DC_STATELESS;
+    sessionData.checksum = pSetup->checksum;
+
+    status = cpaDcGetSessionSize(
+        insHandle, &sessionData, &sessionSize, &contextSize);
+    LAC_CHECK_STATUS(status);
+    status = cpaDcBufferListGetMetaSize(insHandle, 1, &metaSize);
+    LAC_CHECK_STATUS(status);
+    metaSize = LAC_ALIGN_POW2_ROUNDUP(metaSize, LAC_64BYTE_ALIGNMENT);
+
+    status = LAC_OS_MALLOC(&pNew, sizeof(dc_stream_t));
+    LAC_CHECK_STATUS(status);
+    osalMemSet(pNew, 0, sizeof(dc_stream_t));
+    pNew->instance = insHandle;
+    pNew->pCallback = pCallback;
+    pNew->checksumType = pSetup->checksum;
+    pNew->huffType = pSetup->huffType;
+    pNew->maxInflight = maxInflight;
+    pNew->startNext = CPA_TRUE;
+    if (CPA_DC_CRC32 == pSetup->checksum)
+    {
+        pNew->headerSize = DC_GZIP_HEADER_SIZE;
+        pNew->footerSize = DC_GZIP_FOOTER_SIZE;
+    }
+    else
+    {
+        pNew->headerSize = DC_ZLIB_HEADER_SIZE;
+        pNew->footerSize = DC_ZLIB_FOOTER_SIZE;
+    }
+
+    status = LAC_SPINLOCK_INIT(&pNew->lock);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_FREE(pNew);
+        return status;
+    }
+    status = LAC_OS_MALLOC(&pNew->pSlots, maxInflight * sizeof(*pSlot));
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        osalMemSet(pNew->pSlots, 0, maxInflight * sizeof(*pSlot));
+        status = LAC_OS_CAMALLOC(&pNew->pMetaData,
+                                 2 * maxInflight * metaSize,
+                                 LAC_64BYTE_ALIGNMENT,
+                                 pService->nodeAffinity);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LAC_OS_CAMALLOC(&pNew->sessionHandle,
+                                 sessionSize,
+                                 LAC_64BYTE_ALIGNMENT,
+                                 pService->nodeAffinity);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaDcInitSession(insHandle,
+                                  pNew->sessionHandle,
+                                  &sessionData,
+                                  NULL,
+                                  dcStreamCallback);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            LAC_OS_CAFREE(pNew->sessionHandle);
+        }
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        dcStreamFree(pNew);
+        return status;
+    }
+
+    for (i = 0; i < maxInflight; i++)
+    {
+        pSlot = &pNew->pSlots[i];
+        osalAtomicSet(DC_STREAM_SLOT_FREE, &pSlot->state);
+        pSlot->pStream = pNew;
+        pSlot->srcList.numBuffers = 1;
+        pSlot->srcList.pBuffers = &pSlot->srcFlat;
+        pSlot->srcList.pPrivateMetaData = pNew->pMetaData + (2 * i) * metaSize;
+        pSlot->dstList.numBuffers = 1;
+        pSlot->dstList.pBuffers = &pSlot->dstFlat;
+        pSlot->dstList.pPrivateMetaData =
+            pNew->pMetaData + (2 * i + 1) * metaSize;
+    }
+
+    *pStream = pNew;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcStreamCompressBound(icp_sal_dc_stream_t stream,
+                                        Cpa32U inputSize,
+                                        Cpa32U *pOutputSize)
+{
+    dc_stream_t *pStream = (dc_stream_t *)stream;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U bound = 0;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pStream);
+    LAC_CHECK_NULL_PARAM(pOutputSize);
+#endif
+    status = cpaDcDeflateCompressBound(
+        pStream->instance, pStream->huffType, inputSize, &bound);
+    LAC_CHECK_STATUS(status);
+
+    *pOutputSize = bound + pStream->headerSize + pStream->footerSize;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcStreamCompress(icp_sal_dc_stream_t stream,
+                                   CpaFlatBuffer *pSrcBuff,
+                                   CpaFlatBuffer *pDestBuff,
+                                   CpaDcRqResults *pResults,
+                                   CpaBoolean lastChunk,
+                                   void *callbackTag)
+{
+    dc_stream_t *pStream = (dc_stream_t *)stream;
+    dc_stream_slot_t *pSlot = NULL;
+    Cpa32U headerSize = 0;
+    Cpa32U reserved = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pStream);
+    LAC_CHECK_NULL_PARAM(pResults);
+    LAC_CHECK_FLAT_BUFFER(pSrcBuff);
+    LAC_CHECK_FLAT_BUFFER(pDestBuff);
+#endif
+    SAL_RUNNING_CHECK(pStream->instance);
+
+    reserved = (CPA_TRUE == lastChunk) ? pStream->footerSize : 0;
+    if (CPA_TRUE == pStream->startNext)
+    {
+        reserved += pStream->headerSize;
+    }
+    if (pDestBuff->dataLenInBytes <= reserved)
+    {
+        LAC_INVALID_PARAM_LOG("The destination buffer is too small");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* Chunks complete in order, so the tail slot is free unless
+     * maxInflight chunks are in flight */
+    pSlot = &pStream->pSlots[pStream->tail];
+    if (DC_STREAM_SLOT_FREE != osalAtomicGet(&pSlot->state))
+    {
+        return CPA_STATUS_RETRY;
+    }
+
+    if (CPA_TRUE == pStream->startNext)
+    {
+        status = cpaDcGenerateHeader(
+            pStream->sessionHandle, pDestBuff, &headerSize);
+        LAC_CHECK_STATUS(status);
+    }
+
+    pSlot->firstChunk = pStream->startNext;
+    pSlot->lastChunk = lastChunk;
+    pSlot->headerSize = headerSize;
+    pSlot->pUserResults = pResults;
+    pSlot->pUserDest = pDestBuff;
+    pSlot->callbackTag = callbackTag;
+    pSlot->srcFlat = *pSrcBuff;
+    pSlot->dstFlat.pData = pDestBuff->pData + headerSize;
+    pSlot->dstFlat.dataLenInBytes = pDestBuff->dataLenInBytes - reserved;
+
+    /* After a full flush the session treats the next request as a
+     * continuation and seeds its checksum from the results, so every
+     * chunk is seeded explicitly and the checksums combined on
+     * completion. */
+    osalMemSet(&pSlot->results, 0, sizeof(pSlot->results));
+    pSlot->results.checksum = (CPA_DC_CRC32 == pStream->checksumType)
+                                  ? DC_DEFAULT_CRC
+                                  : DC_DEFAULT_ADLER32;
+
+    osalAtomicSet(DC_STREAM_SLOT_BUSY, &pSlot->state);
+    status = cpaDcCompressData(pStream->instance,
+                               pStream->sessionHandle,
+                               &pSlot->srcList,
+                               &pSlot->dstList,
+                               &pSlot->results,
+                               (CPA_TRUE == lastChunk) ? CPA_DC_FLUSH_FINAL
+                                                       : CPA_DC_FLUSH_FULL,
+                               pSlot);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        osalAtomicSet(DC_STREAM_SLOT_FREE, &pSlot->state);
+        return status;
+    }
+
+    pStream->tail = (pStream->tail + 1) % pStream->maxInflight;
+    pStream->startNext = lastChunk;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcStreamRemove(icp_sal_dc_stream_t stream)
+{
+    dc_stream_t *pStream = (dc_stream_t *)stream;
+    Cpa32U i = 0;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pStream);
+#endif
+    for (i = 0; i < pStream->maxInflight; i++)
+    {
+        if (DC_STREAM_SLOT_FREE != osalAtomicGet(&pStream->pSlots[i].state))
+        {
+            return CPA_STATUS_RETRY;
+        }
+    }
+
+    dcStreamFree(pStream);
+    return CPA_STATUS_SUCCESS;
+}
@@ -0,0 +1,1071 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file dc_sw_fallback.c
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Implementation of the software compression fallback. The requests
+ *      the policy of an instance selects are queued to a bounded pool of
+ *      host threads, processed with zlib and completed through the session
+ *      callback with the results and integrity CRCs the device reports.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_dc_sw_fallback.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_log.h"
+#include "sal_service_state.h"
+#include "sal_types_compression.h"
+#include "dc_datapath.h"
+#include "dc_sw_fallback.h"
+
+#ifdef ICP_DC_SW_FALLBACK
+#include <string.h>
+#include <zlib.h>
+#include "icp_adf_transport.h"
+#include "dc_stats.h"
+#include "dc_error_counter.h"
+#include "dc_crc32.h"
+#include "dc_crc64.h"
+
+/* The device produces and consumes raw DEFLATE with a 32KB window */
+#define DC_SW_FALLBACK_WINDOW_BITS (-MAX_WBITS)
+#define DC_SW_FALLBACK_MEM_LEVEL (8)
+#define DC_SW_FALLBACK_MAX_PERCENT (100)
+
+#define DC_SW_FALLBACK_NUM_STATS                                               \
+    (sizeof(icp_sal_dc_sw_fallback_stats_t) / sizeof(Cpa64U))
+
+#define DC_SW_FALLBACK_STAT_INC(statistic, pFallback)                          \
+    osalAtomicInc(                                                             \
+        &(pFallback)->stats[offsetof(icp_sal_dc_sw_fallback_stats_t,           \
+                                     statistic) /                              \
+                            sizeof(Cpa64U)])
+
+/* Status of the device for the inflate errors zlib reports */
+static const struct
+{
+    const char *pMsg;
+    CpaDcReqStatus status;
+} dcSwFallbackInflateErrors[] = {
+    { "invalid block type", CPA_DC_INVALID_BLOCK_TYPE },
+    { "invalid stored block lengths", CPA_DC_BAD_STORED_BLOCK_LEN },
+    { "too many length or distance symbols", CPA_DC_TOO_MANY_CODES },
+    { "invalid code lengths set", CPA_DC_INCOMPLETE_CODE_LENS },
+    { "invalid bit length repeat", CPA_DC_MORE_REPEAT },
+    { "invalid literal/lengths set", CPA_DC_BAD_LITLEN_CODES },
+    { "invalid distances set", CPA_DC_BAD_DIST_CODES },
+    { "invalid literal/length code", CPA_DC_INVALID_CODE },
+    { "invalid distance code", CPA_DC_INVALID_DIST },
+    { "invalid distance too far back", CPA_DC_INVALID_DIST },
+};
+
+struct dc_sw_fallback_s;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Host thread, with the zlib streams it reuses across requests
+ *****************************************************************************/
+typedef struct dc_sw_fallback_worker_s
+{
+    struct dc_sw_fallback_s *pFallback;
+    OsalThread thread;
+    OsalCompletion exited;
+    /* Signalled by the thread as it returns */
+    z_stream deflateStrm;
+    z_stream inflateStrm;
+    CpaBoolean deflateReady;
+    CpaBoolean inflateReady;
+} dc_sw_fallback_worker_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Fallback of an instance
+ *
+ * @description
+ *      The queue is a ring of policy.queueDepth cookies. A queued request
+ *      is held in a cookie of the fallback rather than of the instance
+ *      pool: when the device fails, the requests in the pool are completed
+ *      with an error, and those on the host must not be among them.
+ *****************************************************************************/
+typedef struct dc_sw_fallback_s
+{
+    sal_compression_service_t *pService;
+    icp_sal_dc_sw_fallback_policy_t policy;
+    OsalMutex lock;
+    OsalSemaphore work;
+    /* Posted once for every queued request, and once for every thread when
+     * the threads are stopped */
+    dc_compression_cookie_t *pQueue;
+    Cpa32U head;
+    /* Oldest queued request */
+    volatile Cpa32U numQueued;
+    CpaBoolean stop;
+    dc_sw_fallback_worker_t *pWorkers;
+    Cpa32U numWorkers;
+    /* Threads started */
+    OsalAtomic stats[DC_SW_FALLBACK_NUM_STATS];
+} dc_sw_fallback_t;
+
+STATIC CpaBoolean dcSwFallbackEligible(dc_session_desc_t *pSessionDesc)
+{
+    if ((CPA_DC_DEFLATE != pSessionDesc->compType) ||
+        (CPA_DC_STATELESS != pSessionDesc->sessState) ||
+        (CPA_TRUE == pSessionDesc->isDcDp))
+    {
+        return CPA_FALSE;
+    }
+
+    return ((CPA_DC_NONE == pSessionDesc->checksumType) ||
+            (CPA_DC_CRC32 == pSessionDesc->checksumType) ||
+            (CPA_DC_ADLER32 == pSessionDesc->checksumType))
+               ? CPA_TRUE
+               : CPA_FALSE;
+}
+
+/* Returns whether the list holds fewer than limit bytes */
+STATIC CpaBoolean dcSwFallbackIsSmall(const CpaBufferList *pBufferList,
+                                      Cpa32U limit)
+{
+    Cpa64U length = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pBufferList->numBuffers && length < limit; i++)
+    {
+        length += pBufferList->pBuffers[i].dataLenInBytes;
+    }
+
+    return (length < limit) ? CPA_TRUE : CPA_FALSE;
+}
+
+CpaBoolean dcSwFallbackCoversDevice(sal_compression_service_t *pService)
+{
+    dc_sw_fallback_t *pFallback = pService->pDcSwFallback;
+
+    if (CPA_TRUE != pFallback->policy.onDeviceError)
+    {
+        return CPA_FALSE;
+    }
+
+    return ((CPA_TRUE == Sal_ServiceIsRestarting(pService)) ||
+            (CPA_TRUE == Sal_ServiceIsInError(pService)))
+               ? CPA_TRUE
+               : CPA_FALSE;
+}
+
+dc_sw_fallback_reason_t dcSwFallbackSelect(sal_compression_service_t *pService,
+                                           dc_session_desc_t *pSessionDesc,
+                                           CpaBufferList *pSrcBuff,
+                                           CpaStatus hwStatus)
+{
+    dc_sw_fallback_t *pFallback = pService->pDcSwFallback;
+    icp_sal_dc_sw_fallback_policy_t *pPolicy = &pFallback->policy;
+    Cpa32U maxInflight = 0;
+    Cpa32U numInflight = 0;
+
+    if (CPA_TRUE != dcSwFallbackEligible(pSessionDesc))
+    {
+        return DC_SW_FALLBACK_NONE;
+    }
+
+    if (CPA_STATUS_RETRY == hwStatus)
+    {
+        return (0 != pPolicy->ringFullPercent) ? DC_SW_FALLBACK_RING_FULL
+                                               : DC_SW_FALLBACK_NONE;
+    }
+
+    if (CPA_TRUE != Sal_ServiceIsRunning(pService))
+    {
+        return (CPA_TRUE == dcSwFallbackCoversDevice(pService))
+                   ? DC_SW_FALLBACK_DEVICE_ERROR
+                   : DC_SW_FALLBACK_NONE;
+    }
+
+    /* Small requests are only taken while the queue has room, the device
+     * is there to process them otherwise */
+    if ((0 != pPolicy->smallRequestBytes) &&
+        (pFallback->numQueued < pPolicy->queueDepth) &&
+        (CPA_TRUE == dcSwFallbackIsSmall(pSrcBuff, pPolicy->smallRequestBytes)))
+    {
+        return DC_SW_FALLBACK_SMALL_REQUEST;
+    }
+
+    if ((0 != pPolicy->ringFullPercent) &&
+        (CPA_STATUS_SUCCESS ==
+         icp_adf_getInflightRequests(pService->trans_handle_compression_tx,
+                                     &maxInflight,
+                                     &numInflight)) &&
+        ((Cpa64U)numInflight * DC_SW_FALLBACK_MAX_PERCENT >=
+         (Cpa64U)maxInflight * pPolicy->ringFullPercent))
+    {
+        return DC_SW_FALLBACK_RING_FULL;
+    }
+
+    return DC_SW_FALLBACK_NONE;
+}
+
+CpaStatus dcSwFallbackSubmit(sal_compression_service_t *pService,
+                             dc_session_desc_t *pSessionDesc,
+                             CpaDcSessionHandle pSessionHandle,
+                             CpaBufferList *pSrcBuff,
+                             CpaBufferList *pDestBuff,
+                             CpaDcRqResults *pResults,
+                             CpaDcFlush flushFlag,
+                             CpaDcOpData *pOpData,
+                             void *callbackTag,
+                             dc_request_dir_t compDecomp,
+                             dc_sw_fallback_reason_t reason)
+{
+    dc_sw_fallback_t *pFallback = pService->pDcSwFallback;
+    dc_compression_cookie_t *pCookie = NULL;
+    Cpa32U tail = 0;
+
+    osalMutexLock(&pFallback->lock, OSAL_WAIT_FOREVER);
+    if ((CPA_TRUE == pFallback->stop) ||
+        (pFallback->numQueued == pFallback->policy.queueDepth))
+    {
+        osalMutexUnlock(&pFallback->lock);
+        DC_SW_FALLBACK_STAT_INC(numQueueFull, pFallback);
+        return CPA_STATUS_RETRY;
+    }
+
+    tail = (pFallback->head + pFallback->numQueued) %
+           pFallback->policy.queueDepth;
+    pCookie = &pFallback->pQueue[tail];
+    osalMemSet(pCookie, 0, sizeof(*pCookie));
+    pCookie->dcInstance = pService;
+    pCookie->pSessionHandle = pSessionHandle;
+    pCookie->pSessionDesc = pSessionDesc;
+    pCookie->callbackTag = callbackTag;
+    pCookie->pDcOpData = pOpData;
+    pCookie->pResults = pResults;
+    pCookie->compDecomp = compDecomp;
+    pCookie->pUserSrcBuff = pSrcBuff;
+    pCookie->pUserDestBuff = pDestBuff;
+    pCookie->checksumType = pSessionDesc->checksumType;
+    pCookie->flushFlag = flushFlag;
+    if (NULL != pOpData)
+    {
+        pCookie->flushFlag = pOpData->flushFlag;
+        pCookie->integrityCrcCheck = pOpData->integrityCrcCheck;
+        pCookie->verifyHwIntegrityCrcs = pOpData->verifyHwIntegrityCrcs;
+    }
+
+    /* Seed the checksums as dcCreateRequest seeds the device */
+    pCookie->dataIntegrityCrcs.crc32 = DC_DEFAULT_CRC;
+    pCookie->dataIntegrityCrcs.adler32 = DC_DEFAULT_ADLER32;
+    if (DC_REQUEST_SUBSEQUENT == pSessionDesc->requestType)
+    {
+        if (CPA_DC_CRC32 == pSessionDesc->checksumType)
+        {
+            pCookie->dataIntegrityCrcs.crc32 = pResults->checksum;
+        }
+        else if (CPA_DC_ADLER32 == pSessionDesc->checksumType)
+        {
+            pCookie->dataIntegrityCrcs.adler32 = pResults->checksum;
+        }
+    }
+
+    osalAtomicInc(&(pSessionDesc->pendingStatelessCbCount));
+    pFallback->numQueued++;
+    osalMutexUnlock(&pFallback->lock);
+    osalSemaphorePost(&pFallback->work);
+
+    switch (reason)
+    {
+        case DC_SW_FALLBACK_RING_FULL:
+            DC_SW_FALLBACK_STAT_INC(numRingFull, pFallback);
+            break;
+        case DC_SW_FALLBACK_DEVICE_ERROR:
+            DC_SW_FALLBACK_STAT_INC(numDeviceError, pFallback);
+            break;
+        default:
+            DC_SW_FALLBACK_STAT_INC(numSmallRequest, pFallback);
+            break;
+    }
+    if (DC_COMPRESSION_REQUEST == compDecomp)
+    {
+        COMPRESSION_STAT_INC(numCompRequests, pService);
+    }
+    else
+    {
+        COMPRESSION_STAT_INC(numDecompRequests, pService);
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Run a zlib stream from a source list into a destination list
+ *
+ * @description
+ *      For deflate, flush is applied once the last source buffer is in.
+ *
+ * @retval Z_STREAM_END          The end of the stream was reached
+ * @retval Z_OK                  Deflate flushed all the input, or inflate
+ *                               consumed it without reaching the end
+ * @retval Z_BUF_ERROR           The destination is full
+ * @retval others                zlib error
+ *
+ *****************************************************************************/
+STATIC int dcSwFallbackRun(z_stream *pStrm,
+                           CpaBoolean deflating,
+                           int flush,
+                           const CpaBufferList *pSrc,
+                           const CpaBufferList *pDst)
+{
+    Cpa32U srcIndex = 0;
+    Cpa32U dstIndex = 0;
+    CpaBoolean lastIn = CPA_FALSE;
+    int ret = Z_OK;
+
+    pStrm->avail_in = 0;
+    pStrm->avail_out = 0;
+    for (;;)
+    {
+        while ((0 == pStrm->avail_in) && (srcIndex < pSrc->numBuffers))
+        {
+            pStrm->next_in = pSrc->pBuffers[srcIndex].pData;
+            pStrm->avail_in = pSrc->pBuffers[srcIndex].dataLenInBytes;
+            srcIndex++;
+        }
+        while ((0 == pStrm->avail_out) && (dstIndex < pDst->numBuffers))
+        {
+            pStrm->next_out = pDst->pBuffers[dstIndex].pData;
+            pStrm->avail_out = pDst->pBuffers[dstIndex].dataLenInBytes;
+            dstIndex++;
+        }
+        lastIn = (srcIndex == pSrc->numBuffers) ? CPA_TRUE : CPA_FALSE;
+
+        if (0 == pStrm->avail_out)
+        {
+            return Z_BUF_ERROR;
+        }
+        if (CPA_TRUE == deflating)
+        {
+            ret = deflate(pStrm, (CPA_TRUE == lastIn) ? flush : Z_NO_FLUSH);
+            /* A flush is complete once it leaves room in the output */
+            if ((Z_OK == ret) && (Z_FINISH != flush) && (CPA_TRUE == lastIn) &&
+                (0 == pStrm->avail_in) && (0 != pStrm->avail_out))
+            {
+                return Z_OK;
+            }
+        }
+        else
+        {
+            if ((0 == pStrm->avail_in) && (CPA_TRUE == lastIn))
+            {
+                return Z_OK;
+            }
+            ret = inflate(pStrm, Z_NO_FLUSH);
+        }
+        if ((Z_OK != ret) && (Z_BUF_ERROR != ret))
+        {
+            return ret;
+        }
+    }
+}
+
+STATIC CpaDcReqStatus dcSwFallbackDeflate(dc_sw_fallback_worker_t *pWorker,
+                                          dc_compression_cookie_t *pCookie,
+                                          Cpa32U *pConsumed,
+                                          Cpa32U *pProduced)
+{
+    dc_session_desc_t *pSessionDesc = pCookie->pSessionDesc;
+    z_stream *pStrm = &pWorker->deflateStrm;
+    int level = (int)pSessionDesc->compLevel;
+    int strategy = (CPA_DC_HT_STATIC == pSessionDesc->huffType)
+                       ? Z_FIXED
+                       : Z_DEFAULT_STRATEGY;
+    int ret = Z_OK;
+
+    if (level > Z_BEST_COMPRESSION)
+    {
+        level = Z_BEST_COMPRESSION;
+    }
+
+    if (CPA_TRUE != pWorker->deflateReady)
+    {
+        ret = deflateInit2(pStrm,
+                           level,
+                           Z_DEFLATED,
+                           DC_SW_FALLBACK_WINDOW_BITS,
+                           DC_SW_FALLBACK_MEM_LEVEL,
+                           strategy);
+        pWorker->deflateReady = (Z_OK == ret) ? CPA_TRUE : CPA_FALSE;
+    }
+    else
+    {
+        ret = deflateReset(pStrm);
+        if (Z_OK == ret)
+        {
+            ret = deflateParams(pStrm, level, strategy);
+        }
+    }
+    if (Z_OK != ret)
+    {
+        LAC_LOG_ERROR1("Failed to set up deflate (%d)", ret);
+        return CPA_DC_FATALERR;
+    }
+
+    ret = dcSwFallbackRun(pStrm,
+                          CPA_TRUE,
+                          (CPA_DC_FLUSH_FINAL == pCookie->flushFlag)
+                              ? Z_FINISH
+                              : Z_FULL_FLUSH,
+                          pCookie->pUserSrcBuff,
+                          pCookie->pUserDestBuff);
+    switch (ret)
+    {
+        case Z_STREAM_END:
+        case Z_OK:
+            *pConsumed = (Cpa32U)pStrm->total_in;
+            *pProduced = (Cpa32U)pStrm->total_out;
+            return CPA_DC_OK;
+        case Z_BUF_ERROR:
+            /* The truncated output is not a stream the request could be
+             * resumed from, so none of it is reported */
+            *pConsumed = 0;
+            *pProduced = 0;
+            return CPA_DC_OVERFLOW;
+        default:
+            LAC_LOG_ERROR1("Deflate failed (%d)", ret);
+            return CPA_DC_FATALERR;
+    }
+}
+
+STATIC CpaDcReqStatus dcSwFallbackInflate(dc_sw_fallback_worker_t *pWorker,
+                                          dc_compression_cookie_t *pCookie,
+                                          Cpa32U *pConsumed,
+                                          Cpa32U *pProduced,
+                                          CpaBoolean *pEndOfLastBlock)
+{
+    z_stream *pStrm = &pWorker->inflateStrm;
+    Cpa32U i = 0;
+    int ret = Z_OK;
+
+    if (CPA_TRUE != pWorker->inflateReady)
+    {
+        ret = inflateInit2(pStrm, DC_SW_FALLBACK_WINDOW_BITS);
+        pWorker->inflateReady = (Z_OK == ret) ? CPA_TRUE : CPA_FALSE;
+    }
+    else
+    {
+        ret = inflateReset(pStrm);
+    }
+    if (Z_OK != ret)
+    {
+        LAC_LOG_ERROR1("Failed to set up inflate (%d)", ret);
+        return CPA_DC_FATALERR;
+    }
+
+    ret = dcSwFallbackRun(pStrm,
+                          CPA_FALSE,
+                          Z_NO_FLUSH,
+                          pCookie->pUserSrcBuff,
+                          pCookie->pUserDestBuff);
+    *pConsumed = (Cpa32U)pStrm->total_in;
+    *pProduced = (Cpa32U)pStrm->total_out;
+    *pEndOfLastBlock = (Z_STREAM_END == ret) ? CPA_TRUE : CPA_FALSE;
+    switch (ret)
+    {
+        case Z_STREAM_END:
+        case Z_OK:
+            /* Input ending mid stream is an incomplete file, which the
+             * device does not report as an error for DEFLATE */
+            return CPA_DC_OK;
+        case Z_BUF_ERROR:
+            return CPA_DC_OVERFLOW;
+        case Z_DATA_ERROR:
+            for (i = 0; NULL != pStrm->msg &&
+                        i < sizeof(dcSwFallbackInflateErrors) /
+                                sizeof(dcSwFallbackInflateErrors[0]);
+                 i++)
+            {
+                if (0 == strcmp(pStrm->msg, dcSwFallbackInflateErrors[i].pMsg))
+                {
+                    return dcSwFallbackInflateErrors[i].status;
+                }
+            }
+            return CPA_DC_INVALID_CODE;
+        default:
+            LAC_LOG_ERROR1("Inflate failed (%d)", ret);
+            return CPA_DC_FATALERR;
+    }
+}
+
+/* Checksum of the first length bytes of a list with a zlib checksum */
+STATIC Cpa32U dcSwFallbackChecksum(const CpaBufferList *pBufferList,
+                                   Cpa32U length,
+                                   Cpa32U seed,
+                                   uLong (*pChecksumFn)(uLong,
+                                                        const Bytef *,
+                                                        uInt))
+{
+    uLong checksum = seed;
+    Cpa32U chunk = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < pBufferList->numBuffers && length > 0; i++)
+    {
+        chunk = pBufferList->pBuffers[i].dataLenInBytes;
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+        checksum = pChecksumFn(checksum, pBufferList->pBuffers[i].pData, chunk);
+        length -= chunk;
+    }
+
+    return (Cpa32U)checksum;
+}
+
+/* Fill the CRC table of the cookie as the device does */
+STATIC void dcSwFallbackFillCrcs(dc_compression_cookie_t *pCookie,
+                                 CpaBoolean integrity,
+                                 Cpa32U consumed,
+                                 Cpa32U produced)
+{
+    sal_compression_service_t *pService = pCookie->dcInstance;
+    dc_integrity_crc_fw_t *pCrcs = &pCookie->dataIntegrityCrcs;
+    CpaBufferList *pClear = pCookie->pUserSrcBuff;
+    Cpa32U clearLength = consumed;
+
+    /* The checksums cover the uncompressed data */
+    if (DC_DECOMPRESSION_REQUEST == pCookie->compDecomp)
+    {
+        pClear = pCookie->pUserDestBuff;
+        clearLength = produced;
+    }
+    if ((CPA_TRUE == integrity) || (CPA_DC_CRC32 == pCookie->checksumType))
+    {
+        pCrcs->crc32 =
+            dcSwFallbackChecksum(pClear, clearLength, pCrcs->crc32, crc32);
+    }
+    if ((CPA_TRUE == integrity) || (CPA_DC_ADLER32 == pCookie->checksumType))
+    {
+        pCrcs->adler32 =
+            dcSwFallbackChecksum(pClear, clearLength, pCrcs->adler32, adler32);
+    }
+    if (CPA_TRUE != integrity)
+    {
+        return;
+    }
+
+    /* Without a translator the output is reported as a static block */
+    if (!pService->generic_service_info.isGen4)
+    {
+        pCrcs->iCrc32Cpr =
+            dcCalculateCrc32(pCookie->pUserSrcBuff, consumed, DC_DEFAULT_CRC);
+        pCrcs->oCrc32Cpr =
+            dcCalculateCrc32(pCookie->pUserDestBuff, produced, DC_DEFAULT_CRC);
+        pCrcs->deflateBlockType = DC_STATIC_TYPE;
+    }
+    else
+    {
+        pCrcs->iCrc64Cpr =
+            dcCalculateCrc64(pCookie->pUserSrcBuff, consumed, DC_DEFAULT_CRC);
+        pCrcs->oCrc64Cpr =
+            dcCalculateCrc64(pCookie->pUserDestBuff, produced, DC_DEFAULT_CRC);
+        pCrcs->oCrc64Xlt = pCrcs->oCrc64Cpr;
+    }
+}
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Process a request and complete it
+ *
+ * @description
+ *      Mirrors the handling of a device response in
+ *      dcCompression_ProcessCallback.
+ *
+ *****************************************************************************/
+STATIC void dcSwFallbackProcess(dc_sw_fallback_worker_t *pWorker,
+                                dc_compression_cookie_t *pCookie)
+{
+    dc_sw_fallback_t *pFallback = pWorker->pFallback;
+    sal_compression_service_t *pService = pCookie->dcInstance;
+    dc_session_desc_t *pSessionDesc = pCookie->pSessionDesc;
+    CpaDcRqResults *pResults = pCookie->pResults;
+    CpaDcOpData *pOpData = pCookie->pDcOpData;
+    CpaDcCallbackFn pCbFunc = pSessionDesc->pCompressionCb;
+    dc_request_dir_t compDecomp = pCookie->compDecomp;
+    CpaBoolean endOfLastBlock = CPA_FALSE;
+    CpaBoolean integrity = CPA_FALSE;
+    CpaBoolean pass = CPA_TRUE;
+    Cpa32U consumed = 0;
+    Cpa32U produced = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if ((CPA_TRUE == pService->generic_service_info.integrityCrcCheck) &&
+        (CPA_TRUE == pCookie->integrityCrcCheck) && (NULL != pOpData) &&
+        (NULL != pOpData->pCrcData))
+    {
+        integrity = CPA_TRUE;
+    }
+
+    if (DC_COMPRESSION_REQUEST == compDecomp)
+    {
+        pResults->status =
+            dcSwFallbackDeflate(pWorker, pCookie, &consumed, &produced);
+    }
+    else
+    {
+        pResults->status = dcSwFallbackInflate(
+            pWorker, pCookie, &consumed, &produced, &endOfLastBlock);
+    }
+    dcErrorLog(pResults->status);
+
+    /* The next stateless request carries on the checksum unless this one
+     * ended the data */
+    pSessionDesc->requestType = ((CPA_DC_FLUSH_FINAL == pCookie->flushFlag) &&
+                                 (CPA_DC_OK == pResults->status))
+                                    ? DC_REQUEST_FIRST
+                                    : DC_REQUEST_SUBSEQUENT;
+
+    /* Stateless overflow is only valid in the compression direction */
+    if ((CPA_DC_OK != pResults->status) &&
+        ((CPA_DC_OVERFLOW != pResults->status) ||
+         (DC_COMPRESSION_REQUEST != compDecomp)))
+    {
+        pass = CPA_FALSE;
+    }
+
+    if (CPA_TRUE == pass)
+    {
+        pResults->consumed = consumed;
+        pResults->produced = produced;
+        pSessionDesc->cumulativeConsumedBytes += consumed;
+
+        dcSwFallbackFillCrcs(pCookie, integrity, consumed, produced);
+        if (CPA_TRUE == integrity)
+        {
+            if (!pService->generic_service_info.isGen4)
+            {
+                dcHandleIntegrityChecksums(
+                    pCookie, pOpData->pCrcData, pResults);
+            }
+            else
+            {
+                dcHandleIntegrityChecksumsGen4(
+                    pCookie, pOpData->pCrcData, pResults);
+            }
+            if (CPA_DC_CRC_INTEG_ERR == pResults->status)
+            {
+                pass = CPA_FALSE;
+            }
+        }
+        else if (CPA_DC_CRC32 == pSessionDesc->checksumType)
+        {
+            pResults->checksum = pCookie->dataIntegrityCrcs.crc32;
+        }
+        else if (CPA_DC_ADLER32 == pSessionDesc->checksumType)
+        {
+            pResults->checksum = pCookie->dataIntegrityCrcs.adler32;
+        }
+    }
+
+    if (CPA_TRUE == pass)
+    {
+        if (DC_COMPRESSION_REQUEST == compDecomp)
+        {
+            if (pService->generic_service_info.isGen4)
+            {
+                pResults->dataUncompressed = CPA_FALSE;
+            }
+            COMPRESSION_STAT_INC(numCompCompleted, pService);
+        }
+        else
+        {
+            pResults->endOfLastBlock = endOfLastBlock;
+            COMPRESSION_STAT_INC(numDecompCompleted, pService);
+        }
+        DC_SW_FALLBACK_STAT_INC(numCompleted, pFallback);
+    }
+    else
+    {
+        pResults->consumed = 0;
+        pResults->produced = 0;
+        status = CPA_STATUS_FAIL;
+        if (DC_COMPRESSION_REQUEST == compDecomp)
+        {
+            COMPRESSION_STAT_INC(numCompCompletedErrors, pService);
+        }
+        else
+        {
+            COMPRESSION_STAT_INC(numDecompCompletedErrors, pService);
+        }
+        DC_SW_FALLBACK_STAT_INC(numCompletedErrors, pFallback);
+    }
+
+    osalAtomicDec(&(pSessionDesc->pendingStatelessCbCount));
+    if (NULL != pCbFunc)
+    {
+        pCbFunc(pCookie->callbackTag, status);
+    }
+}
+
+STATIC void dcSwFallbackWorker(void *pArg)
+{
+    dc_sw_fallback_worker_t *pWorker = (dc_sw_fallback_worker_t *)pArg;
+    dc_sw_fallback_t *pFallback = pWorker->pFallback;
+    dc_compression_cookie_t cookie;
+
+    for (;;)
+    {
+        osalSemaphoreWait(&pFallback->work, OSAL_WAIT_FOREVER);
+        osalMutexLock(&pFallback->lock, OSAL_WAIT_FOREVER);
+        /* Stopping threads drain the queue first */
+        if (0 == pFallback->numQueued)
+        {
+            osalMutexUnlock(&pFallback->lock);
+            break;
+        }
+        osalMemCopy(
+            &cookie, &pFallback->pQueue[pFallback->head], sizeof(cookie));
+        pFallback->head = (pFallback->head + 1) % pFallback->policy.queueDepth;
+        pFallback->numQueued--;
+        osalMutexUnlock(&pFallback->lock);
+
+        dcSwFallbackProcess(pWorker, &cookie);
+    }
+
+    /* The fallback may be freed as soon as this is signalled */
+    osalCompletionSignal(&pWorker->exited);
+}
+
+/* Stop the threads once the queue is drained and free the fallback */
+STATIC void dcSwFallbackFree(dc_sw_fallback_t *pFallback)
+{
+    dc_sw_fallback_worker_t *pWorker = NULL;
+    Cpa32U i = 0;
+
+    osalMutexLock(&pFallback->lock, OSAL_WAIT_FOREVER);
+    pFallback->stop = CPA_TRUE;
+    osalMutexUnlock(&pFallback->lock);
+    for (i = 0; i < pFallback->numWorkers; i++)
+    {
+        osalSemaphorePost(&pFallback->work);
+    }
+
+    for (i = 0; i < pFallback->numWorkers; i++)
+    {
+        pWorker = &pFallback->pWorkers[i];
+        osalCompletionWait(&pWorker->exited, OSAL_WAIT_FOREVER);
+        osalCompletionDestroy(&pWorker->exited);
+        if (CPA_TRUE == pWorker->deflateReady)
+        {
+            deflateEnd(&pWorker->deflateStrm);
+        }
+        if (CPA_TRUE == pWorker->inflateReady)
+        {
+            inflateEnd(&pWorker->inflateStrm);
+        }
+    }
+
+    osalSemaphoreDestroy(&pFallback->work);
+    osalMutexDestroy(&pFallback->lock);
+    LAC_OS_FREE(pFallback->pWorkers);
+    LAC_OS_FREE(pFallback->pQueue);
+    LAC_OS_FREE(pFallback);
+}
+
+void dcSwFallbackShutdown(sal_compression_service_t *pService)
+{
+    dc_sw_fallback_t *pFallback = pService->pDcSwFallback;
+
+    if (NULL != pFallback)
+    {
+        pService->pDcSwFallback = NULL;
+        dcSwFallbackFree(pFallback);
+    }
+}
+
+CpaStatus icp_sal_DcSwFallbackEnable(
+    CpaInstanceHandle instanceHandle,
+    const icp_sal_dc_sw_fallback_policy_t *pPolicy)
+{
+    CpaInstanceHandle insHandle = NULL;
+    sal_compression_service_t *pService = NULL;
+    icp_sal_dc_sw_fallback_policy_t policy;
+    dc_sw_fallback_t *pNew = NULL;
+    dc_sw_fallback_worker_t *pWorker = NULL;
+    OsalThreadAttr threadAttr = {0};
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = instanceHandle;
+    }
+
+    LAC_CHECK_INSTANCE_HANDLE(insHandle);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    LAC_CHECK_NULL_PARAM(pPolicy);
+
+    policy = *pPolicy;
+    if (0 == policy.numWorkers)
+    {
+        policy.numWorkers = ICP_SAL_DC_SW_FALLBACK_DEFAULT_WORKERS;
+    }
+    if (0 == policy.queueDepth)
+    {
+        policy.queueDepth = ICP_SAL_DC_SW_FALLBACK_DEFAULT_QUEUE_DEPTH;
+    }
+    if ((policy.ringFullPercent > DC_SW_FALLBACK_MAX_PERCENT) ||
+        (policy.numWorkers > ICP_SAL_DC_SW_FALLBACK_MAX_WORKERS) ||
+        (policy.queueDepth > ICP_SAL_DC_SW_FALLBACK_MAX_QUEUE_DEPTH))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid fallback policy");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    pService = (sal_compression_service_t *)insHandle;
+    dcSwFallbackShutdown(pService);
+
+    status = LAC_OS_MALLOC(&pNew, sizeof(dc_sw_fallback_t));
+    LAC_CHECK_STATUS(status);
+    osalMemSet(pNew, 0, sizeof(dc_sw_fallback_t));
+    pNew->pService = pService;
+    pNew->policy = policy;
+
+    status = LAC_OS_MALLOC(&pNew->pQueue,
+                           policy.queueDepth * sizeof(dc_compression_cookie_t));
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LAC_OS_MALLOC(
+            &pNew->pWorkers, policy.numWorkers * sizeof(*pWorker));
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_FREE(pNew->pQueue);
+        LAC_OS_FREE(pNew);
+        return status;
+    }
+    osalMemSet(
+        pNew->pWorkers, 0, policy.numWorkers * sizeof(dc_sw_fallback_worker_t));
+    if (OSAL_SUCCESS != osalMutexInit(&pNew->lock))
+    {
+        status = CPA_STATUS_RESOURCE;
+    }
+    else if (OSAL_SUCCESS != osalSemaphoreInit(&pNew->work, 0))
+    {
+        osalMutexDestroy(&pNew->lock);
+        status = CPA_STATUS_RESOURCE;
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_LOG_ERROR("Failed to initialise the fallback queue");
+        LAC_OS_FREE(pNew->pWorkers);
+        LAC_OS_FREE(pNew->pQueue);
+        LAC_OS_FREE(pNew);
+        return status;
+    }
+
+    /* The default OSAL policy is real time, which needs privileges the
+     * application may not have */
+    threadAttr.policy = OSAL_THREAD_SCHED_OTHER;
+    for (i = 0; i < policy.numWorkers; i++)
+    {
+        pWorker = &pNew->pWorkers[i];
+        pWorker->pFallback = pNew;
+        if (OSAL_SUCCESS != osalCompletionInit(&pWorker->exited))
+        {
+            status = CPA_STATUS_RESOURCE;
+        }
+        else if (OSAL_SUCCESS != osalThreadCreate(&pWorker->thread,
+                                                  &threadAttr,
+                                                  dcSwFallbackWorker,
+                                                  pWorker))
+        {
+            osalCompletionDestroy(&pWorker->exited);
+            status = CPA_STATUS_RESOURCE;
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            LAC_LOG_ERROR("Failed to start a fallback thread");
+            dcSwFallbackFree(pNew);
+            return status;
+        }
+        pNew->numWorkers++;
+    }
+
+    /* The threads are ready before the datapath sees the fallback */
+    __sync_synchronize();
+    pService->pDcSwFallback = pNew;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcSwFallbackDisable(CpaInstanceHandle instanceHandle)
+{
+    CpaInstanceHandle insHandle = NULL;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = instanceHandle;
+    }
+
+    LAC_CHECK_INSTANCE_HANDLE(insHandle);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+
+    dcSwFallbackShutdown((sal_compression_service_t *)insHandle);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_DcSwFallbackQueryStats(
+    CpaInstanceHandle instanceHandle,
+    icp_sal_dc_sw_fallback_stats_t *pStats)
+{
+    CpaInstanceHandle insHandle = NULL;
+    dc_sw_fallback_t *pFallback = NULL;
+    Cpa64U *pCounters = (Cpa64U *)pStats;
+    Cpa32U i = 0;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle)
+    {
+        insHandle = dcGetFirstHandle();
+    }
+    else
+    {
+        insHandle = instanceHandle;
+    }
+
+    LAC_CHECK_INSTANCE_HANDLE(insHandle);
+    SAL_CHECK_INSTANCE_TYPE(insHandle, SAL_SERVICE_TYPE_COMPRESSION);
+    LAC_CHECK_NULL_PARAM(pStats);
+
+    pFallback = ((sal_compression_service_t *)insHandle)->pDcSwFallback;
+    if (NULL == pFallback)
+    {
+        LAC_LOG_ERROR("The software fallback is not enabled");
+        return CPA_STATUS_FAIL;
+    }
+    for (i = 0; i < DC_SW_FALLBACK_NUM_STATS; i++)
+    {
+        pCounters[i] = (Cpa64U)osalAtomicGet(&pFallback->stats[i]);
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+#else
+
+CpaStatus icp_sal_DcSwFallbackEnable(
+    CpaInstanceHandle instanceHandle,
+    const icp_sal_dc_sw_fallback_policy_t *pPolicy)
+{
+    LAC_UNUSED_VARIABLE(instanceHandle);
+    LAC_UNUSED_VARIABLE(pPolicy);
+    LAC_LOG_ERROR("Built without the software compression fallback");
+    return CPA_STATUS_UNSUPPORTED;
+}
+
+CpaStatus icp_sal_DcSwFallbackDisable(CpaInstanceHandle instanceHandle)
+{
+    LAC_UNUSED_VARIABLE(instanceHandle);
+    return CPA_STATUS_UNSUPPORTED;
+}
+
+CpaStatus icp_sal_DcSwFallbackQueryStats(
+    CpaInstanceHandle instanceHandle,
+    icp_sal_dc_sw_fallback_stats_t *pStats)
+{
+    LAC_UNUSED_VARIABLE(instanceHandle);
+    LAC_UNUSED_VARIABLE(pStats);
+    return CPA_STATUS_UNSUPPORTED;
+}
+
+#endif /* ICP_DC_SW_FALLBACK */
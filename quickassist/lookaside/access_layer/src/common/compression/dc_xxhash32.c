@@ -83,7 +83,7 @@ static const Cpa32U XXHASH_PRIME32_C = 0xC2B2AE3DU;
 static const Cpa32U XXHASH_PRIME32_D = 0x27D4EB2FU;
 static const Cpa32U XXHASH_PRIME32_E = 0x165667B1U;
 
-#define XXH32_STRIP_SIZE 16
+#define XXH32_STRIP_SIZE DC_XXHASH32_STRIPE_SIZE
 #define ROTATE_LEFT_32(n, d) ((n << d) | (n >> (-d & 31)))
 
 /* Static function definitions */
@@ -180,3 +180,93 @@ static Cpa32U xxh32Avalanche(Cpa32U xxHash32)
     xxHash32 ^= xxHash32 >> 16;
     return (xxHash32);
 }
+
+static Cpa32U xxh32Read32(const Cpa8U *ptr)
+{
+    return (Cpa32U)ptr[0] | ((Cpa32U)ptr[1] << 8) | ((Cpa32U)ptr[2] << 16) |
+           ((Cpa32U)ptr[3] << 24);
+}
+
+static Cpa32U xxh32Round(Cpa32U accumulator, Cpa32U input)
+{
+    accumulator += input * XXHASH_PRIME32_B;
+    accumulator = ROTATE_LEFT_32(accumulator, 13);
+    return accumulator * XXHASH_PRIME32_A;
+}
+
+/* Consume one 16 byte stripe into the four accumulators */
+static void xxh32ConsumeStripe(Cpa32U *acc, const Cpa8U *ptr)
+{
+    acc[0] = xxh32Round(acc[0], xxh32Read32(ptr));
+    acc[1] = xxh32Round(acc[1], xxh32Read32(ptr + 4));
+    acc[2] = xxh32Round(acc[2], xxh32Read32(ptr + 8));
+    acc[3] = xxh32Round(acc[3], xxh32Read32(ptr + 12));
+}
+
+void dcXxhash32Init(dc_xxhash32_state_t *pState, Cpa32U seed)
+{
+    osalMemSet(pState, 0, sizeof(*pState));
+    pState->acc[0] = seed + XXHASH_PRIME32_A + XXHASH_PRIME32_B;
+    pState->acc[1] = seed + XXHASH_PRIME32_B;
+    pState->acc[2] = seed;
+    pState->acc[3] = seed - XXHASH_PRIME32_A;
+}
+
+void dcXxhash32Update(dc_xxhash32_state_t *pState,
+                      const Cpa8U *pData,
+                      Cpa32U dataLength)
+{
+    Cpa32U fill = 0;
+
+    pState->totalLength += dataLength;
+
+    /* Complete a stripe left over from the previous update first */
+    if (pState->stripeLength > 0)
+    {
+        fill = XXH32_STRIP_SIZE - pState->stripeLength;
+        if (fill > dataLength)
+            fill = dataLength;
+        osalMemCopy(pState->stripe + pState->stripeLength, pData, fill);
+        pState->stripeLength += fill;
+        pData += fill;
+        dataLength -= fill;
+        if (pState->stripeLength < XXH32_STRIP_SIZE)
+            return;
+        xxh32ConsumeStripe(pState->acc, pState->stripe);
+        pState->stripeLength = 0;
+    }
+
+    while (dataLength >= XXH32_STRIP_SIZE)
+    {
+        xxh32ConsumeStripe(pState->acc, pData);
+        pData += XXH32_STRIP_SIZE;
+        dataLength -= XXH32_STRIP_SIZE;
+    }
+
+    osalMemCopy(pState->stripe, pData, dataLength);
+    pState->stripeLength = dataLength;
+}
+
+Cpa32U dcXxhash32Digest(const dc_xxhash32_state_t *pState)
+{
+    Cpa32U xxHash32Accumulator = 0;
+
+    if (pState->totalLength >= XXH32_STRIP_SIZE)
+    {
+        xxHash32Accumulator = ROTATE_LEFT_32(pState->acc[0], 1) +
+                              ROTATE_LEFT_32(pState->acc[1], 7) +
+                              ROTATE_LEFT_32(pState->acc[2], 12) +
+                              ROTATE_LEFT_32(pState->acc[3], 18);
+    }
+    else
+    {
+        /* acc[2] still holds the seed */
+        xxHash32Accumulator = pState->acc[2] + XXHASH_PRIME32_E;
+    }
+
+    /* The length is added modulo 2^32 */
+    xxHash32Accumulator += (Cpa32U)pState->totalLength;
+
+    return xxh32ConsumeRemaining(
+        xxHash32Accumulator, pState->stripe, pState->stripeLength);
+}
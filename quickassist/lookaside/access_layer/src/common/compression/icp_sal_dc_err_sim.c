@@ -92,6 +92,11 @@ CpaStatus icp_sal_dc_simulate_error(Cpa8U numErrors, Cpa8S dcError)
 {
     return dcSetNumError(numErrors, dcError);
 }
+
+CpaStatus icp_sal_dc_simulate_retry(Cpa8U numRetries)
+{
+    return dcSetNumRetry(numRetries);
+}
 #endif
 
 Cpa64U icp_sal_get_dc_error(Cpa8S dcError)
@@ -136,6 +136,9 @@ typedef struct dc_chain_session_head_s
     /**< Callback function defined for the traditional compression session */
     OsalAtomic pendingChainCbCount;
     /**< Keeps track of number of pending requests on stateless session */
+    icp_qat_fw_comp_chain_req_t reqTemplate;
+    /**< Chaining request built at session init, copied into every request
+     * in place of zeroing the cookie and rebuilding the header */
 } dc_chain_session_head_t;
 
 /**
@@ -110,4 +110,49 @@ Cpa32U dcCalculateCrc32(CpaBufferList *pBufferList,
                         Cpa32U consumedBytes,
                         const Cpa32U seedChecksum);
 
+/**
+ * @description
+ *     Combines the CRC-32 checksums of two adjacent blocks of data.
+ *
+ *     Given crc1 = CRC-32(A) and crc2 = CRC-32(B), returns CRC-32(A || B)
+ *     in O(log len2) without touching the data, so that blocks checksummed
+ *     independently (e.g. on different instances) can be joined.
+ *
+ * @param[in]  crc1           CRC-32 of the first block
+ * @param[in]  crc2           CRC-32 of the second block
+ * @param[in]  len2           Length in bytes of the second block
+ *
+ * @retval Cpa32U             CRC-32 of the concatenated blocks
+ */
+Cpa32U dcCrc32Combine(Cpa32U crc1, Cpa32U crc2, Cpa64U len2);
+
+/**
+ * @description
+ *     Combines the Adler-32 checksums of two adjacent blocks of data.
+ *
+ * @param[in]  adler1         Adler-32 of the first block
+ * @param[in]  adler2         Adler-32 of the second block
+ * @param[in]  len2           Length in bytes of the second block
+ *
+ * @retval Cpa32U             Adler-32 of the concatenated blocks
+ */
+Cpa32U dcAdler32Combine(Cpa32U adler1, Cpa32U adler2, Cpa64U len2);
+
+/**
+ * @description
+ *     Combines the CRC-32 or Adler-32 checksums of two adjacent blocks of
+ *     data, depending on checksumType.
+ *
+ * @param[in]  checksumType   CPA_DC_CRC32 or CPA_DC_ADLER32
+ * @param[in]  checksum1      Checksum of the first block
+ * @param[in]  checksum2      Checksum of the second block
+ * @param[in]  len2           Length in bytes of the second block
+ *
+ * @retval Cpa32U             Checksum of the concatenated blocks
+ */
+Cpa32U dcChecksumCombine(CpaDcChecksum checksumType,
+                         Cpa32U checksum1,
+                         Cpa32U checksum2,
+                         Cpa64U len2);
+
 #endif /* end of DC_CRC32_H_ */
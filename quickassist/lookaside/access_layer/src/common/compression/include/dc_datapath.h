@@ -274,6 +274,31 @@ void dcCompression_ProcessCallback(void *pRespMsg);
 CpaStatus dcCheckOpData(sal_compression_service_t *pService,
                         CpaDcOpData *pOpData);
 #endif
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Report the end to end integrity CRCs of a request
+ *
+ * @description
+ *      Moves the CRCs written to pCookie->dataIntegrityCrcs into the CRC
+ *      data of the user, checks them against software CRCs when requested
+ *      and sets the checksum of the results. dcHandleIntegrityChecksums
+ *      serves QAT 1.x devices and dcHandleIntegrityChecksumsGen4 QAT 2.0
+ *      devices.
+ *
+ * @param[in]   pCookie             Cookie of the completed request
+ * @param[out]  crc_external        CRC data of the user
+ * @param[out]  pDcResults          Results of the request
+ *
+ *****************************************************************************/
+void dcHandleIntegrityChecksums(dc_compression_cookie_t *pCookie,
+                                CpaCrcData *crc_external,
+                                CpaDcRqResults *pDcResults);
+
+void dcHandleIntegrityChecksumsGen4(dc_compression_cookie_t *pCookie,
+                                    CpaCrcData *crc_external,
+                                    CpaDcRqResults *pDcResults);
 #endif
 
 /**
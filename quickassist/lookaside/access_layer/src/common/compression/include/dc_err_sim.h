@@ -82,5 +82,7 @@
 CpaDcReqStatus dcGetErrors(void);
 CpaStatus dcSetNumError(Cpa8U numErrors, CpaDcReqStatus dcError);
 CpaBoolean dcErrorSimEnabled(void);
+CpaStatus dcSetNumRetry(Cpa8U numRetries);
+CpaBoolean dcGetRetry(void);
 
 #endif /* DC_ERROR_SIM_H */
@@ -73,6 +73,8 @@
 #ifndef DC_HEADER_FOOTER_H_
 #define DC_HEADER_FOOTER_H_
 
+#include "cpa_dc.h"
+
 /* Header and footer sizes for Zlib and Gzip */
 #define DC_ZLIB_HEADER_SIZE (2)
 #define DC_GZIP_HEADER_SIZE (10)
@@ -100,4 +102,27 @@
 #define DC_GZIP_FAST_COMP (4)
 #define DC_GZIP_MAX_COMP (2)
 
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Write a gzip or zlib footer
+ *
+ * @description
+ *      Writes the gzip footer (CRC-32 and input size modulo 2^32) when
+ *      checksumType is CPA_DC_CRC32 and the zlib footer (Adler-32)
+ *      otherwise. The caller makes sure pDest has room for it.
+ *
+ * @param[out]  pDest             Where the footer is written
+ * @param[in]   checksumType      CPA_DC_CRC32 or CPA_DC_ADLER32
+ * @param[in]   checksum          Checksum of the uncompressed data
+ * @param[in]   inputSize         Length of the uncompressed data
+ *
+ * @retval Number of bytes written, DC_GZIP_FOOTER_SIZE or
+ *         DC_ZLIB_FOOTER_SIZE
+ *****************************************************************************/
+Cpa32U dcDeflateFooterWrite(Cpa8U *pDest,
+                            CpaDcChecksum checksumType,
+                            Cpa32U checksum,
+                            Cpa64U inputSize);
+
 #endif /* DC_HEADER_FOOTER_H_ */
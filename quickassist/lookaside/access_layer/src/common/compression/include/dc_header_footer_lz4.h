@@ -111,6 +111,37 @@ CpaStatus dc_lz4_generate_header(const CpaFlatBuffer *dest_buff,
                                  const CpaBoolean block_indep,
                                  Cpa32U *count);
 
+/**
+ *****************************************************************************
+ * @ingroup dc_lz4_generate_frame_header
+ *      Generate an LZ4 frame header with the given checksum flags.
+ *
+ * @description
+ *      This function generates the LZ4 frame header like
+ *      dc_lz4_generate_header, but lets the caller choose whether the
+ *      frame carries a checksum after every data block and a content
+ *      checksum in the footer.
+ *
+ * @param[in]       dest_buff        Pointer to the destination buffer the
+ *                                   LZ4 header will be written to.
+ * @param[in]       max_block_size   LZ4 Maximum block size.
+ * @param[in]       block_indep      LZ4 block independence value.
+ * @param[in]       block_cksum      LZ4 block checksum flag.
+ * @param[in]       content_cksum    LZ4 content checksum flag.
+ * @param[in,out]   count            Pointer to counter that stores
+ *                                   amount of generated bytes.
+ *
+ * @retval CPA_STATUS_SUCCESS        Function executed successfully.
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter passed in.
+ *****************************************************************************/
+CpaStatus dc_lz4_generate_frame_header(
+    const CpaFlatBuffer *dest_buff,
+    const CpaDcCompLZ4BlockMaxSize max_block_size,
+    const CpaBoolean block_indep,
+    const CpaBoolean block_cksum,
+    const CpaBoolean content_cksum,
+    Cpa32U *count);
+
 /**
  *****************************************************************************
  * @ingroup dc_lz4_generate_footer
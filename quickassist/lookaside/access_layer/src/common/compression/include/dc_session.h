@@ -311,6 +311,9 @@ typedef struct dc_session_desc_s
      * requests update */
     CpaBoolean isDcDp;
     /**< Indicates if the data plane API is used */
+    CpaBoolean isHighPriority;
+    /**< Requests are sent on the high priority ring pair of the instance,
+     * see icp_sal_DcSessionSetPriority */
     Cpa32U minContextSize;
     /**< Indicates the minimum size required to allocate the context buffer */
     CpaBufferList *pContextBuffer;
@@ -0,0 +1,194 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file dc_sw_fallback.h
+ *
+ * @ingroup Dc_DataCompression
+ *
+ * @description
+ *      Definition of the software compression fallback, which processes on
+ *      the host the requests a compression instance cannot send to its
+ *      device.
+ *
+ *****************************************************************************/
+#ifndef DC_SW_FALLBACK_H
+#define DC_SW_FALLBACK_H
+
+#include "cpa_dc.h"
+#include "sal_types_compression.h"
+#include "sal_service_state.h"
+#include "dc_session.h"
+#include "dc_datapath.h"
+
+#ifdef ICP_DC_SW_FALLBACK
+
+/* Why a request is processed on the host */
+typedef enum dc_sw_fallback_reason_e
+{
+    DC_SW_FALLBACK_NONE = 0,
+    /* The request goes to the device */
+    DC_SW_FALLBACK_RING_FULL,
+    DC_SW_FALLBACK_DEVICE_ERROR,
+    DC_SW_FALLBACK_SMALL_REQUEST
+} dc_sw_fallback_reason_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Check whether the fallback stands in for a failed device
+ *
+ * @description
+ *      Returns CPA_TRUE when the instance is restarting or in error and its
+ *      fallback policy takes requests of a failed device. The API running
+ *      check lets requests through in that case, and dcCompDecompData
+ *      repeats it for the requests the fallback cannot take.
+ *
+ * @param[in]   pService         Compression service with a fallback
+ *
+ *****************************************************************************/
+CpaBoolean dcSwFallbackCoversDevice(sal_compression_service_t *pService);
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Select the requests processed on the host
+ *
+ * @description
+ *      Applies the fallback policy of the service to a request. Before the
+ *      request is sent hwStatus is CPA_STATUS_SUCCESS, afterwards it is the
+ *      status the request ring returned.
+ *
+ * @param[in]   pService         Compression service with a fallback
+ * @param[in]   pSessionDesc     Session of the request
+ * @param[in]   pSrcBuff         Source of the request
+ * @param[in]   hwStatus         Status of the send to the device
+ *
+ * @retval DC_SW_FALLBACK_NONE   The request goes to the device
+ * @retval others                The request goes to dcSwFallbackSubmit
+ *
+ *****************************************************************************/
+dc_sw_fallback_reason_t dcSwFallbackSelect(sal_compression_service_t *pService,
+                                           dc_session_desc_t *pSessionDesc,
+                                           CpaBufferList *pSrcBuff,
+                                           CpaStatus hwStatus);
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Queue a request on the host
+ *
+ * @description
+ *      Queues a request selected by dcSwFallbackSelect for the host
+ *      threads, which complete it through the session callback. The
+ *      parameters are those of dcCompDecompData.
+ *
+ * @retval CPA_STATUS_SUCCESS    The request is queued
+ * @retval CPA_STATUS_RETRY      The queue is full
+ *
+ *****************************************************************************/
+CpaStatus dcSwFallbackSubmit(sal_compression_service_t *pService,
+                             dc_session_desc_t *pSessionDesc,
+                             CpaDcSessionHandle pSessionHandle,
+                             CpaBufferList *pSrcBuff,
+                             CpaBufferList *pDestBuff,
+                             CpaDcRqResults *pResults,
+                             CpaDcFlush flushFlag,
+                             CpaDcOpData *pOpData,
+                             void *callbackTag,
+                             dc_request_dir_t compDecomp,
+                             dc_sw_fallback_reason_t reason);
+
+/**
+ *****************************************************************************
+ * @ingroup Dc_DataCompression
+ *      Disable the fallback of a service
+ *
+ * @description
+ *      Completes the queued requests, stops the host threads and frees the
+ *      fallback. Does nothing if the fallback is not enabled.
+ *
+ * @param[in]   pService         Compression service
+ *
+ *****************************************************************************/
+void dcSwFallbackShutdown(sal_compression_service_t *pService);
+
+/* Running check of the API entry points, passed while the fallback stands
+ * in for a failed device */
+#define DC_RUNNING_CHECK(pService)                                             \
+    do                                                                         \
+    {                                                                          \
+        if ((NULL == (pService)->pDcSwFallback) ||                             \
+            (CPA_TRUE != dcSwFallbackCoversDevice(pService)))                  \
+        {                                                                      \
+            SAL_RUNNING_CHECK(pService);                                       \
+        }                                                                      \
+    } while (0)
+
+#else
+
+#define DC_RUNNING_CHECK(pService) SAL_RUNNING_CHECK(pService)
+
+#endif /* ICP_DC_SW_FALLBACK */
+
+#endif /* DC_SW_FALLBACK_H */
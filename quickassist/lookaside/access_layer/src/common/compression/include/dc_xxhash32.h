@@ -79,4 +79,54 @@ CpaStatus dcXxhash32Lz4HdrChecksum(const void *xxH32input,
                                    const Cpa32U dataLength,
                                    Cpa8U *checksum);
 
+/* Bytes consumed by one round of the four XXH32 accumulators */
+#define DC_XXHASH32_STRIPE_SIZE 16
+
+/**
+ * @description
+ *     State of an XXH32 calculation over data passed in pieces
+ */
+typedef struct dc_xxhash32_state_s
+{
+    Cpa32U acc[4];
+    /* Accumulators, acc[2] is the seed until a full stripe is consumed */
+    Cpa64U totalLength;
+    /* Bytes passed to dcXxhash32Update so far */
+    Cpa8U stripe[DC_XXHASH32_STRIPE_SIZE];
+    /* Bytes of an incomplete stripe */
+    Cpa32U stripeLength;
+} dc_xxhash32_state_t;
+
+/**
+ * @description
+ *     Start an XXH32 calculation
+ *
+ * @param[out] pState           State to initialise.
+ * @param[in] seed              Seed of the hash, 0 for LZ4 checksums.
+ */
+void dcXxhash32Init(dc_xxhash32_state_t *pState, Cpa32U seed);
+
+/**
+ * @description
+ *     Add data to an XXH32 calculation
+ *
+ * @param[in,out] pState        State of the calculation.
+ * @param[in] pData             Virtual addr of the data.
+ * @param[in] dataLength        Length in bytes of the data.
+ */
+void dcXxhash32Update(dc_xxhash32_state_t *pState,
+                      const Cpa8U *pData,
+                      Cpa32U dataLength);
+
+/**
+ * @description
+ *     Get the XXH32 of the data passed so far. The state is not changed,
+ *     so more data may be added afterwards.
+ *
+ * @param[in] pState            State of the calculation.
+ *
+ * @retval The hash of the data passed to dcXxhash32Update.
+ */
+Cpa32U dcXxhash32Digest(const dc_xxhash32_state_t *pState);
+
 #endif /* end of DC_XXHASH32_H_ */
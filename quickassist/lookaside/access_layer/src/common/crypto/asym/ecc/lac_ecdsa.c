@@ -107,6 +107,7 @@
 /* API Includes */
 #include "cpa.h"
 #include "cpa_cy_ecdsa.h"
+#include "icp_sal_ecdsa_prepared.h"
 
 /* OSAL Includes */
 #include "Osal.h"
@@ -361,10 +362,12 @@ LacEcdsa_SignSOpDataSizeGetMax(const CpaCyEcdsaSignSOpData *pOpData)
 /**
  ***************************************************************************
  * @ingroup Lac_Ec
- *      return the size of the biggest number in CpaCyEcdsaSignRSOpData
+ *      return the size of the biggest curve parameter or private key in
+ *      CpaCyEcdsaSignRSOpData
  *
  * @description
- *      return the size of the biggest number in CpaCyEcdsaSignRSOpData
+ *      return the size of the biggest number in CpaCyEcdsaSignRSOpData,
+ *      ignoring the per-signature parameters k and m
  *
  * @param[in]  pOpData      Pointer to a CpaCyEcdsaSignRSOpData structure
  *
@@ -372,17 +375,15 @@ LacEcdsa_SignSOpDataSizeGetMax(const CpaCyEcdsaSignSOpData *pOpData)
  *
  ***************************************************************************/
 STATIC Cpa32U
-LacEcdsa_SignRSOpDataSizeGetMax(const CpaCyEcdsaSignRSOpData *pOpData)
+LacEcdsa_SignRSKeySizeGetMax(const CpaCyEcdsaSignRSOpData *pOpData)
 {
     Cpa32U max = 0;
 
     /* need to find max size in bytes of number in input buffers */
     max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->xg)), max);
     max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->yg)), max);
-    max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->m)), max);
     max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->d)), max);
     max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->q)), max);
-    max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->k)), max);
     max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->n)), max);
     max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->a)), max);
     max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->b)), max);
@@ -390,6 +391,30 @@ LacEcdsa_SignRSOpDataSizeGetMax(const CpaCyEcdsaSignRSOpData *pOpData)
     return max;
 }
 
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *      return the size of the biggest number in CpaCyEcdsaSignRSOpData
+ *
+ * @description
+ *      return the size of the biggest number in CpaCyEcdsaSignRSOpData
+ *
+ * @param[in]  pOpData      Pointer to a CpaCyEcdsaSignRSOpData structure
+ *
+ * @retval max  the size in bytes of the biggest number
+ *
+ ***************************************************************************/
+STATIC Cpa32U
+LacEcdsa_SignRSOpDataSizeGetMax(const CpaCyEcdsaSignRSOpData *pOpData)
+{
+    Cpa32U max = LacEcdsa_SignRSKeySizeGetMax(pOpData);
+
+    max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->m)), max);
+    max = LAC_MAX(LacPke_GetMinBytes(&(pOpData->k)), max);
+
+    return max;
+}
+
 /**
  ***************************************************************************
  * @ingroup Lac_Ec
@@ -1671,29 +1696,18 @@ void LacEcdsa_SignRSCallback(CpaStatus status,
 /**
  ***************************************************************************
  * @ingroup Lac_Ec
- *      ECDSA Sign R & S parameter check
+ *      ECDSA Sign R & S curve and private key parameter check
  ***************************************************************************/
 STATIC
-CpaStatus LacEcdsa_SignRSBasicParamCheck(const CpaInstanceHandle instanceHandle,
-                                         const CpaCyEcdsaSignRSOpData *pOpData,
-                                         CpaBoolean *pMultiplyStatus,
-                                         CpaFlatBuffer *pR,
-                                         CpaFlatBuffer *pS)
+CpaStatus LacEcdsa_SignRSKeyParamCheck(const CpaCyEcdsaSignRSOpData *pOpData)
 {
-
-    /* check for NULL pointers */
-    LAC_CHECK_NULL_PARAM(pMultiplyStatus);
     LAC_CHECK_NULL_PARAM(pOpData);
-    LAC_CHECK_NULL_PARAM(pR);
-    LAC_CHECK_NULL_PARAM(pS);
 
     /* Check flat buffers in pOpData for NULL and dataLen of 0*/
     LAC_CHECK_NULL_PARAM(pOpData->a.pData);
     LAC_CHECK_SIZE(&(pOpData->a), CHECK_NONE, 0);
     LAC_CHECK_NULL_PARAM(pOpData->b.pData);
     LAC_CHECK_SIZE(&(pOpData->b), CHECK_NONE, 0);
-    LAC_CHECK_NULL_PARAM(pOpData->k.pData);
-    LAC_CHECK_SIZE(&(pOpData->k), CHECK_NONE, 0);
     LAC_CHECK_NULL_PARAM(pOpData->q.pData);
     LAC_CHECK_SIZE(&(pOpData->q), CHECK_NONE, 0);
     LAC_CHECK_NULL_PARAM(pOpData->xg.pData);
@@ -1702,14 +1716,8 @@ CpaStatus LacEcdsa_SignRSBasicParamCheck(const CpaInstanceHandle instanceHandle,
     LAC_CHECK_SIZE(&(pOpData->yg), CHECK_NONE, 0);
     LAC_CHECK_NULL_PARAM(pOpData->n.pData);
     LAC_CHECK_SIZE(&(pOpData->n), CHECK_NONE, 0);
-    LAC_CHECK_NULL_PARAM(pOpData->m.pData);
-    LAC_CHECK_SIZE(&(pOpData->m), CHECK_NONE, 0);
     LAC_CHECK_NULL_PARAM(pOpData->d.pData);
     LAC_CHECK_SIZE(&(pOpData->d), CHECK_NONE, 0);
-    LAC_CHECK_NULL_PARAM(pR->pData);
-    LAC_CHECK_SIZE(pR, CHECK_NONE, 0);
-    LAC_CHECK_NULL_PARAM(pS->pData);
-    LAC_CHECK_SIZE(pS, CHECK_NONE, 0);
 
     if (CPA_CY_EC_FIELD_TYPE_PRIME != pOpData->fieldType &&
         CPA_CY_EC_FIELD_TYPE_BINARY != pOpData->fieldType)
@@ -1725,8 +1733,297 @@ CpaStatus LacEcdsa_SignRSBasicParamCheck(const CpaInstanceHandle instanceHandle,
 
     return CPA_STATUS_SUCCESS;
 }
+
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *      ECDSA Sign R & S parameter check
+ ***************************************************************************/
+STATIC
+CpaStatus LacEcdsa_SignRSBasicParamCheck(const CpaInstanceHandle instanceHandle,
+                                         const CpaCyEcdsaSignRSOpData *pOpData,
+                                         CpaBoolean *pMultiplyStatus,
+                                         CpaFlatBuffer *pR,
+                                         CpaFlatBuffer *pS)
+{
+
+    /* check for NULL pointers */
+    LAC_CHECK_NULL_PARAM(pMultiplyStatus);
+    LAC_CHECK_NULL_PARAM(pOpData);
+    LAC_CHECK_NULL_PARAM(pR);
+    LAC_CHECK_NULL_PARAM(pS);
+
+    /* Check flat buffers in pOpData for NULL and dataLen of 0*/
+    LAC_CHECK_NULL_PARAM(pOpData->k.pData);
+    LAC_CHECK_SIZE(&(pOpData->k), CHECK_NONE, 0);
+    LAC_CHECK_NULL_PARAM(pOpData->m.pData);
+    LAC_CHECK_SIZE(&(pOpData->m), CHECK_NONE, 0);
+    LAC_CHECK_NULL_PARAM(pR->pData);
+    LAC_CHECK_SIZE(pR, CHECK_NONE, 0);
+    LAC_CHECK_NULL_PARAM(pS->pData);
+    LAC_CHECK_SIZE(pS, CHECK_NONE, 0);
+
+    return LacEcdsa_SignRSKeyParamCheck(pOpData);
+}
+
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *      ECDSA Sign R & S curve and private key range checks
+ *
+ * @description
+ *      Checks the curve and d of a request which does not use the optimised
+ *      P256/P384 path, for the given operand size. k is not checked.
+ ***************************************************************************/
+STATIC
+CpaStatus LacEcdsa_SignRSCurveCheck(const CpaCyEcdsaSignRSOpData *pOpData,
+                                    Cpa32U dataOperationSizeBytes)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32S compare = 0;
+    Cpa32U bit_pos_q = 0, bit_pos_x = 0, bit_pos_y = 0;
+    Cpa32U temp = 0;
+    CpaBoolean isZero = CPA_FALSE;
+
+    if (LAC_EC_SIZE_QW9_IN_BYTES == dataOperationSizeBytes)
+    {
+        /* 9QW checks */
+        if (CPA_CY_EC_FIELD_TYPE_PRIME == pOpData->fieldType)
+        {
+            /* Check if is is a NIST curve (if not it is an invalid param) */
+            /* Also checks that xG and yG are less than 2^521 */
+            status = LacEc_CheckCurve9QWGFP(&(pOpData->q),
+                                            &(pOpData->a),
+                                            &(pOpData->b),
+                                            &(pOpData->n),
+                                            NULL,
+                                            &(pOpData->xg),
+                                            &(pOpData->yg));
+        }
+        else
+        {
+            /* Check if is is a NIST curve (if not it is an invalid param) */
+            /* Also checks that xG and yG are less than 571 bits */
+            status = LacEc_CheckCurve9QWGF2(&(pOpData->q),
+                                            &(pOpData->a),
+                                            &(pOpData->b),
+                                            &(pOpData->n),
+                                            NULL,
+                                            &(pOpData->xg),
+                                            &(pOpData->yg));
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        /* Check  0 < d < n */
+        LAC_CHECK_NON_ZERO_PARAM(&(pOpData->d));
+
+        compare = LacPke_Compare(&(pOpData->d), 0, &(pOpData->n), 0);
+        if (compare >= 0)
+        {
+            LAC_INVALID_PARAM_LOG("d is not < n as required");
+            status = CPA_STATUS_INVALID_PARAM;
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        /* Ensure base point is not (0,0) */
+        if ((0 == LacPke_CompareZero(&(pOpData->xg), 0)) &&
+            (0 == LacPke_CompareZero(&(pOpData->yg), 0)))
+        {
+            LAC_INVALID_PARAM_LOG("Invalid base point");
+            status = CPA_STATUS_INVALID_PARAM;
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        /* For GFP check q>3 and xg and yg less than q */
+        if (CPA_CY_EC_FIELD_TYPE_PRIME == pOpData->fieldType)
+        {
+            /* Ensure q > 3 */
+            LacPke_GetBitPos(&(pOpData->q), &bit_pos_q, &temp, &isZero);
+            if (bit_pos_q < LAC_EC_MIN_MOD_BIT_POS_GFP)
+            {
+                LAC_INVALID_PARAM_LOG("q is not > 3 as required");
+                status = CPA_STATUS_INVALID_PARAM;
+            }
+            /* Ensure xg < q */
+            compare = LacPke_Compare(&(pOpData->xg), 0, &(pOpData->q), 0);
+            if (compare >= 0)
+            {
+                LAC_INVALID_PARAM_LOG("xg is not < q as required");
+                status = CPA_STATUS_INVALID_PARAM;
+            }
+            /* Ensure yg < q */
+            compare = LacPke_Compare(&(pOpData->yg), 0, &(pOpData->q), 0);
+            if (compare >= 0)
+            {
+                LAC_INVALID_PARAM_LOG("yg is not < q as required");
+                status = CPA_STATUS_INVALID_PARAM;
+            }
+        }
+        /* For GF2 4 and 8 QW check deg(q)>2 and deg(xg) and deg(yg) less
+           than deg(q) (note: already checked for 9QW case) */
+        if (((LAC_EC_SIZE_QW8_IN_BYTES == dataOperationSizeBytes) ||
+             (LAC_EC_SIZE_QW4_IN_BYTES == dataOperationSizeBytes)) &&
+            (CPA_CY_EC_FIELD_TYPE_BINARY == pOpData->fieldType))
+        {
+            LacPke_GetBitPos(&(pOpData->q), &bit_pos_q, &temp, &isZero);
+            if (bit_pos_q < LAC_EC_MIN_MOD_BIT_POS_GF2)
+            {
+                LAC_INVALID_PARAM_LOG("deg(q) is not > 2 as required");
+                status = CPA_STATUS_INVALID_PARAM;
+            }
+            /* Ensure deg(xg) < deg(q) for non zero xg */
+            LacPke_GetBitPos(&(pOpData->xg), &bit_pos_x, &temp, &isZero);
+            if ((CPA_TRUE != isZero) && (bit_pos_x >= bit_pos_q))
+            {
+                LAC_INVALID_PARAM_LOG("deg(xg) is not < deg(q) as required");
+                status = CPA_STATUS_INVALID_PARAM;
+            }
+            /* Ensure deg(yg) < deg(q) for non zero yg */
+            LacPke_GetBitPos(&(pOpData->yg), &bit_pos_y, &temp, &isZero);
+            if ((CPA_TRUE != isZero) && (bit_pos_y >= bit_pos_q))
+            {
+                LAC_INVALID_PARAM_LOG("deg(yg) is not < deg(q) as required");
+                status = CPA_STATUS_INVALID_PARAM;
+            }
+        }
+    }
+
+    return status;
+}
 #endif
 
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *      Get the operand size for the generic ECDSA Sign R & S functions
+ *
+ * @description
+ *      Selects the operand size from the biggest number maxSizeBytes and,
+ *      for binary curves of up to 4QW, whether the curve is a NIST one.
+ ***************************************************************************/
+STATIC CpaStatus
+LacEcdsa_SignRSGetOperationSize(const CpaCyEcdsaSignRSOpData *pOpData,
+                                Cpa32U maxSizeBytes,
+                                Cpa32U *pDataOperationSizeBytes)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    /* Determine size */
+    status = LacEc_GetRange(maxSizeBytes, pDataOperationSizeBytes);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        if ((LAC_EC_SIZE_QW4_IN_BYTES == *pDataOperationSizeBytes) &&
+            (CPA_CY_EC_FIELD_TYPE_BINARY == pOpData->fieldType))
+        {
+            /* Check if it is a NIST curve if not use 8QW */
+            LacEc_CheckCurve4QWGF2(pDataOperationSizeBytes,
+                                   &(pOpData->q),
+                                   &(pOpData->a),
+                                   &(pOpData->b),
+                                   &(pOpData->n),
+                                   NULL);
+        }
+    }
+
+    return status;
+}
+
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *      Fill MMP structs for the generic ECDSA Sign R & S functions
+ *
+ * @description
+ *      Selects the function id from the field type and operand size and
+ *      writes the concatenated input and the outputs to the MMP structs.
+ ***************************************************************************/
+STATIC CpaStatus
+LacEcdsa_SignRSFillMMPStructs(icp_qat_fw_mmp_input_param_t *pInRS,
+                              icp_qat_fw_mmp_output_param_t *pOutRS,
+                              CpaCyEcFieldType fieldType,
+                              Cpa32U dataOperationSizeBytes,
+                              CpaFlatBuffer *pInBuff,
+                              CpaFlatBuffer *pR,
+                              CpaFlatBuffer *pS,
+                              Cpa32U *pFunctionID)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    /* Populate input buffers and output buffers and set function IDs */
+    if (CPA_CY_EC_FIELD_TYPE_PRIME == fieldType)
+    {
+        switch (dataOperationSizeBytes)
+        {
+            case LAC_EC_SIZE_QW4_IN_BYTES:
+                LacEcdsaSignRSOpDataWrite(pInRS->mmp_ecdsa_sign_rs_gfp_l256,
+                                          pOutRS->mmp_ecdsa_sign_rs_gfp_l256,
+                                          pInBuff,
+                                          pR,
+                                          pS);
+                *pFunctionID = PKE_ECDSA_SIGN_RS_GFP_L256;
+                break;
+            case LAC_EC_SIZE_QW8_IN_BYTES:
+                LacEcdsaSignRSOpDataWrite(pInRS->mmp_ecdsa_sign_rs_gfp_l512,
+                                          pOutRS->mmp_ecdsa_sign_rs_gfp_l512,
+                                          pInBuff,
+                                          pR,
+                                          pS);
+                *pFunctionID = PKE_ECDSA_SIGN_RS_GFP_L512;
+                break;
+            case LAC_EC_SIZE_QW9_IN_BYTES:
+                LacEcdsaSignRSOpDataWrite(pInRS->mmp_ecdsa_sign_rs_gfp_521,
+                                          pOutRS->mmp_ecdsa_sign_rs_gfp_521,
+                                          pInBuff,
+                                          pR,
+                                          pS);
+                *pFunctionID = PKE_ECDSA_SIGN_RS_GFP_521;
+                break;
+            default:
+                status = CPA_STATUS_INVALID_PARAM;
+                break;
+        }
+    }
+    else
+    {
+        switch (dataOperationSizeBytes)
+        {
+            case LAC_EC_SIZE_QW4_IN_BYTES:
+                LacEcdsaSignRSOpDataWrite(pInRS->mmp_ecdsa_sign_rs_gf2_l256,
+                                          pOutRS->mmp_ecdsa_sign_rs_gf2_l256,
+                                          pInBuff,
+                                          pR,
+                                          pS);
+                *pFunctionID = PKE_ECDSA_SIGN_RS_GF2_L256;
+                break;
+            case LAC_EC_SIZE_QW8_IN_BYTES:
+                LacEcdsaSignRSOpDataWrite(pInRS->mmp_ecdsa_sign_rs_gf2_l512,
+                                          pOutRS->mmp_ecdsa_sign_rs_gf2_l512,
+                                          pInBuff,
+                                          pR,
+                                          pS);
+                *pFunctionID = PKE_ECDSA_SIGN_RS_GF2_L512;
+                break;
+            case LAC_EC_SIZE_QW9_IN_BYTES:
+                LacEcdsaSignRSOpDataWrite(pInRS->mmp_ecdsa_sign_rs_gf2_571,
+                                          pOutRS->mmp_ecdsa_sign_rs_gf2_571,
+                                          pInBuff,
+                                          pR,
+                                          pS);
+                *pFunctionID = PKE_ECDSA_SIGN_RS_GF2_571;
+                break;
+            default:
+                status = CPA_STATUS_INVALID_PARAM;
+                break;
+        }
+    }
+
+    return status;
+}
+
 CpaStatus LacEcdsa_OptimisedSignRS(const CpaInstanceHandle instanceHandle,
                                    const CpaCyEcdsaSignRSCbFunc pCb,
                                    void *pCallbackTag,
@@ -1858,10 +2155,7 @@ CpaStatus cpaCyEcdsaSignRS(const CpaInstanceHandle instanceHandle_in,
     sal_crypto_service_t *pCryptoService = NULL;
 #ifdef ICP_PARAM_CHECK
     Cpa32S compare = 0;
-    Cpa32U bit_pos_q = 0, bit_pos_x = 0, bit_pos_y = 0;
-    Cpa32U temp = 0;
     Cpa32U maxModLen = 0;
-    CpaBoolean isZero = CPA_FALSE;
 #endif
 
     if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
@@ -1954,56 +2248,17 @@ CpaStatus cpaCyEcdsaSignRS(const CpaInstanceHandle instanceHandle_in,
 
     if (CPA_STATUS_SUCCESS == status)
     {
-        /* Determine size */
-        status = LacEc_GetRange(LacEcdsa_SignRSOpDataSizeGetMax(pOpData),
-                                &dataOperationSizeBytes);
-    }
-    if (CPA_STATUS_SUCCESS == status)
-    {
-        if ((LAC_EC_SIZE_QW4_IN_BYTES == dataOperationSizeBytes) &&
-            (CPA_CY_EC_FIELD_TYPE_BINARY == pOpData->fieldType))
-        {
-            /* Check if it is a NIST curve if not use 8QW */
-            LacEc_CheckCurve4QWGF2(&dataOperationSizeBytes,
-                                   &(pOpData->q),
-                                   &(pOpData->a),
-                                   &(pOpData->b),
-                                   &(pOpData->n),
-                                   NULL);
-        }
+        status = LacEcdsa_SignRSGetOperationSize(
+            pOpData,
+            LacEcdsa_SignRSOpDataSizeGetMax(pOpData),
+            &dataOperationSizeBytes);
     }
 
 #ifdef ICP_PARAM_CHECK
-    if ((CPA_STATUS_SUCCESS == status) &&
-        (LAC_EC_SIZE_QW9_IN_BYTES == dataOperationSizeBytes))
+    if (CPA_STATUS_SUCCESS == status)
     {
-        /* 9QW checks */
-        if (CPA_CY_EC_FIELD_TYPE_PRIME == pOpData->fieldType)
-        {
-            /* Check if is is a NIST curve (if not it is an invalid param) */
-            /* Also checks that xG and yG are less than 2^521 */
-            status = LacEc_CheckCurve9QWGFP(&(pOpData->q),
-                                            &(pOpData->a),
-                                            &(pOpData->b),
-                                            &(pOpData->n),
-                                            NULL,
-                                            &(pOpData->xg),
-                                            &(pOpData->yg));
-        }
-        else
-        {
-            /* Check if is is a NIST curve (if not it is an invalid param) */
-            /* Also checks that xG and yG are less than 571 bits */
-            status = LacEc_CheckCurve9QWGF2(&(pOpData->q),
-                                            &(pOpData->a),
-                                            &(pOpData->b),
-                                            &(pOpData->n),
-                                            NULL,
-                                            &(pOpData->xg),
-                                            &(pOpData->yg));
-        }
+        status = LacEcdsa_SignRSCurveCheck(pOpData, dataOperationSizeBytes);
     }
-
     if (CPA_STATUS_SUCCESS == status)
     {
         /* Check  0 < k < n */
@@ -2016,83 +2271,6 @@ CpaStatus cpaCyEcdsaSignRS(const CpaInstanceHandle instanceHandle_in,
             status = CPA_STATUS_INVALID_PARAM;
         }
     }
-    if (CPA_STATUS_SUCCESS == status)
-    {
-        /* Check  0 < d < n */
-        LAC_CHECK_NON_ZERO_PARAM(&(pOpData->d));
-
-        compare = LacPke_Compare(&(pOpData->d), 0, &(pOpData->n), 0);
-        if (compare >= 0)
-        {
-            LAC_INVALID_PARAM_LOG("d is not < n as required");
-            status = CPA_STATUS_INVALID_PARAM;
-        }
-    }
-    if (CPA_STATUS_SUCCESS == status)
-    {
-        /* Ensure base point is not (0,0) */
-        if ((0 == LacPke_CompareZero(&(pOpData->xg), 0)) &&
-            (0 == LacPke_CompareZero(&(pOpData->yg), 0)))
-        {
-            LAC_INVALID_PARAM_LOG("Invalid base point");
-            status = CPA_STATUS_INVALID_PARAM;
-        }
-    }
-    if (CPA_STATUS_SUCCESS == status)
-    {
-        /* For GFP check q>3 and xg and yg less than q */
-        if (CPA_CY_EC_FIELD_TYPE_PRIME == pOpData->fieldType)
-        {
-            /* Ensure q > 3 */
-            LacPke_GetBitPos(&(pOpData->q), &bit_pos_q, &temp, &isZero);
-            if (bit_pos_q < LAC_EC_MIN_MOD_BIT_POS_GFP)
-            {
-                LAC_INVALID_PARAM_LOG("q is not > 3 as required");
-                status = CPA_STATUS_INVALID_PARAM;
-            }
-            /* Ensure xg < q */
-            compare = LacPke_Compare(&(pOpData->xg), 0, &(pOpData->q), 0);
-            if (compare >= 0)
-            {
-                LAC_INVALID_PARAM_LOG("xg is not < q as required");
-                status = CPA_STATUS_INVALID_PARAM;
-            }
-            /* Ensure yg < q */
-            compare = LacPke_Compare(&(pOpData->yg), 0, &(pOpData->q), 0);
-            if (compare >= 0)
-            {
-                LAC_INVALID_PARAM_LOG("yg is not < q as required");
-                status = CPA_STATUS_INVALID_PARAM;
-            }
-        }
-        /* For GF2 4 and 8 QW check deg(q)>2 and deg(xg) and deg(yg) less
-           than deg(q) (note: already checked for 9QW case) */
-        if (((LAC_EC_SIZE_QW8_IN_BYTES == dataOperationSizeBytes) ||
-             (LAC_EC_SIZE_QW4_IN_BYTES == dataOperationSizeBytes)) &&
-            (CPA_CY_EC_FIELD_TYPE_BINARY == pOpData->fieldType))
-        {
-            LacPke_GetBitPos(&(pOpData->q), &bit_pos_q, &temp, &isZero);
-            if (bit_pos_q < LAC_EC_MIN_MOD_BIT_POS_GF2)
-            {
-                LAC_INVALID_PARAM_LOG("deg(q) is not > 2 as required");
-                status = CPA_STATUS_INVALID_PARAM;
-            }
-            /* Ensure deg(xg) < deg(q) for non zero xg */
-            LacPke_GetBitPos(&(pOpData->xg), &bit_pos_x, &temp, &isZero);
-            if ((CPA_TRUE != isZero) && (bit_pos_x >= bit_pos_q))
-            {
-                LAC_INVALID_PARAM_LOG("deg(xg) is not < deg(q) as required");
-                status = CPA_STATUS_INVALID_PARAM;
-            }
-            /* Ensure deg(yg) < deg(q) for non zero yg */
-            LacPke_GetBitPos(&(pOpData->yg), &bit_pos_y, &temp, &isZero);
-            if ((CPA_TRUE != isZero) && (bit_pos_y >= bit_pos_q))
-            {
-                LAC_INVALID_PARAM_LOG("deg(yg) is not < deg(q) as required");
-                status = CPA_STATUS_INVALID_PARAM;
-            }
-        }
-    }
 #endif
 
     if (CPA_STATUS_SUCCESS == status)
@@ -2184,79 +2362,14 @@ CpaStatus cpaCyEcdsaSignRS(const CpaInstanceHandle instanceHandle_in,
             LAC_EC_SET_LIST_PARAMS(
                 internalMemOutList, LAC_ECDSA_SIGNRS_NUM_OUT_ARGS, CPA_FALSE);
 
-            /* Populate input buffers and output buffers and set function IDs */
-            if (CPA_CY_EC_FIELD_TYPE_PRIME == pOpData->fieldType)
-            {
-                switch (dataOperationSizeBytes)
-                {
-                    case LAC_EC_SIZE_QW4_IN_BYTES:
-                        LacEcdsaSignRSOpDataWrite(
-                            inRS.mmp_ecdsa_sign_rs_gfp_l256,
-                            outRS.mmp_ecdsa_sign_rs_gfp_l256,
-                            pInBuff,
-                            pR,
-                            pS);
-                        functionID = PKE_ECDSA_SIGN_RS_GFP_L256;
-                        break;
-                    case LAC_EC_SIZE_QW8_IN_BYTES:
-                        LacEcdsaSignRSOpDataWrite(
-                            inRS.mmp_ecdsa_sign_rs_gfp_l512,
-                            outRS.mmp_ecdsa_sign_rs_gfp_l512,
-                            pInBuff,
-                            pR,
-                            pS);
-                        functionID = PKE_ECDSA_SIGN_RS_GFP_L512;
-                        break;
-                    case LAC_EC_SIZE_QW9_IN_BYTES:
-                        LacEcdsaSignRSOpDataWrite(
-                            inRS.mmp_ecdsa_sign_rs_gfp_521,
-                            outRS.mmp_ecdsa_sign_rs_gfp_521,
-                            pInBuff,
-                            pR,
-                            pS);
-                        functionID = PKE_ECDSA_SIGN_RS_GFP_521;
-                        break;
-                    default:
-                        status = CPA_STATUS_INVALID_PARAM;
-                        break;
-                }
-            }
-            else
-            {
-                switch (dataOperationSizeBytes)
-                {
-                    case LAC_EC_SIZE_QW4_IN_BYTES:
-                        LacEcdsaSignRSOpDataWrite(
-                            inRS.mmp_ecdsa_sign_rs_gf2_l256,
-                            outRS.mmp_ecdsa_sign_rs_gf2_l256,
-                            pInBuff,
-                            pR,
-                            pS);
-                        functionID = PKE_ECDSA_SIGN_RS_GF2_L256;
-                        break;
-                    case LAC_EC_SIZE_QW8_IN_BYTES:
-                        LacEcdsaSignRSOpDataWrite(
-                            inRS.mmp_ecdsa_sign_rs_gf2_l512,
-                            outRS.mmp_ecdsa_sign_rs_gf2_l512,
-                            pInBuff,
-                            pR,
-                            pS);
-                        functionID = PKE_ECDSA_SIGN_RS_GF2_L512;
-                        break;
-                    case LAC_EC_SIZE_QW9_IN_BYTES:
-                        LacEcdsaSignRSOpDataWrite(
-                            inRS.mmp_ecdsa_sign_rs_gf2_571,
-                            outRS.mmp_ecdsa_sign_rs_gf2_571,
-                            pInBuff,
-                            pR,
-                            pS);
-                        functionID = PKE_ECDSA_SIGN_RS_GF2_571;
-                        break;
-                    default:
-                        status = CPA_STATUS_INVALID_PARAM;
-                        break;
-                }
-            }
+            status = LacEcdsa_SignRSFillMMPStructs(&inRS,
+                                                   &outRS,
+                                                   pOpData->fieldType,
+                                                   dataOperationSizeBytes,
+                                                   pInBuff,
+                                                   pR,
+                                                   pS,
+                                                   &functionID);
 
             /* Send pke request */
             if (CPA_STATUS_SUCCESS == status)
@@ -2299,6 +2412,519 @@ CpaStatus cpaCyEcdsaSignRS(const CpaInstanceHandle instanceHandle_in,
     return status;
 }
 
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *      Prepared ECDSA signing key
+ *
+ * @description
+ *      pParams holds the inputs of the key in DMA-able memory, padded to
+ *      the operand size. For the optimised P256/P384 functions these are d
+ *      and n. For the generic functions it is the concatenated input of the
+ *      firmware (d, m, k, b, a, q, n, yg, xg) with m and k left zero; each
+ *      request copies it to an ec pool entry and fills in m and k.
+ ***************************************************************************/
+typedef struct lac_ecdsa_prepared_key_s
+{
+    CpaInstanceHandle instanceHandle;
+    /**< Instance the key was prepared on */
+    CpaCyEcFieldType fieldType;
+    /**< Field type of the curve */
+    Cpa32U functionID;
+    /**< Firmware function of the optimised curves */
+    Cpa32U dataOperationSizeBytes;
+    /**< Operand size */
+    Cpa32U minOutputLenInBytes;
+    /**< Minimum length of the r and s buffers */
+    CpaBoolean optimised;
+    /**< Uses the P256/P384 functions */
+    CpaFlatBuffer d;
+    /**< Padded private key (optimised functions only) */
+    CpaFlatBuffer n;
+    /**< Padded order of the base point, for the check of k */
+    Cpa8U *pParams;
+    /**< Padded inputs */
+    Cpa32U paramsLenInBytes;
+    /**< Size of pParams */
+} lac_ecdsa_prepared_key_t;
+
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_EcdsaSignRSPrepareKey(
+    const CpaInstanceHandle instanceHandle_in,
+    const CpaCyEcdsaSignRSOpData *pOpData,
+    icp_sal_ecdsa_prepared_key_t *pKey)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaInstanceHandle instanceHandle = NULL;
+    sal_crypto_service_t *pCryptoService = NULL;
+    lac_ecdsa_prepared_key_t *pPrepared = NULL;
+    Cpa32U dataOperationSizeBytes = 0;
+    Cpa32U functionID = 0;
+    CpaBoolean optCurve = CPA_FALSE;
+    Cpa8U *pConcateTemp = NULL;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
+    {
+        instanceHandle = Lac_GetFirstHandle(SAL_SERVICE_TYPE_CRYPTO_ASYM);
+    }
+    else
+    {
+        instanceHandle = instanceHandle_in;
+    }
+
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_RUNNING_CHECK(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_ASYM));
+    LAC_CHECK_NULL_PARAM(pKey);
+#ifdef ICP_PARAM_CHECK
+    status = LacEcdsa_SignRSKeyParamCheck(pOpData);
+    LAC_CHECK_STATUS(status);
+#else
+    LAC_CHECK_NULL_PARAM(pOpData);
+#endif
+
+    pCryptoService = (sal_crypto_service_t *)instanceHandle;
+    *pKey = NULL;
+
+    optCurve = LacEcdsa_SignRSGetOptFunctionId(pOpData->fieldType,
+                                               &(pOpData->q),
+                                               &(pOpData->n),
+                                               &(pOpData->a),
+                                               &(pOpData->b),
+                                               &dataOperationSizeBytes,
+                                               &functionID);
+    if (CPA_TRUE == optCurve)
+    {
+#ifdef ICP_PARAM_CHECK
+        /* Check  0 < d < n, as the optimised request path does */
+        LAC_CHECK_NON_ZERO_PARAM(&(pOpData->d));
+
+        if (LacPke_Compare(&(pOpData->d), 0, &(pOpData->n), 0) >= 0)
+        {
+            LAC_INVALID_PARAM_LOG("d is not < n as required");
+            return CPA_STATUS_INVALID_PARAM;
+        }
+#endif
+    }
+    else
+    {
+        status = LacEcdsa_SignRSGetOperationSize(
+            pOpData,
+            LacEcdsa_SignRSKeySizeGetMax(pOpData),
+            &dataOperationSizeBytes);
+#ifdef ICP_PARAM_CHECK
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status =
+                LacEcdsa_SignRSCurveCheck(pOpData, dataOperationSizeBytes);
+        }
+#endif
+        LAC_CHECK_STATUS(status);
+    }
+
+    status = LAC_OS_MALLOC(&pPrepared, sizeof(lac_ecdsa_prepared_key_t));
+    LAC_CHECK_STATUS(status);
+    LAC_OS_BZERO(pPrepared, sizeof(lac_ecdsa_prepared_key_t));
+
+    pPrepared->instanceHandle = instanceHandle;
+    pPrepared->fieldType = pOpData->fieldType;
+    pPrepared->functionID = functionID;
+    pPrepared->dataOperationSizeBytes = dataOperationSizeBytes;
+    pPrepared->minOutputLenInBytes = LacPke_GetMinBytes(&(pOpData->n));
+    pPrepared->optimised = optCurve;
+    pPrepared->paramsLenInBytes =
+        dataOperationSizeBytes *
+        ((CPA_TRUE == optCurve) ? 2 : LAC_ECDSA_SIGNRS_NUM_IN_QA_API);
+
+    status = LAC_OS_CAMALLOC(&pPrepared->pParams,
+                             pPrepared->paramsLenInBytes,
+                             LAC_64BYTE_ALIGNMENT,
+                             pCryptoService->nodeAffinity);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_FREE(pPrepared);
+        return status;
+    }
+
+    pConcateTemp = pPrepared->pParams;
+    if (CPA_TRUE == optCurve)
+    {
+        pPrepared->d.pData = pConcateTemp;
+        pPrepared->d.dataLenInBytes = dataOperationSizeBytes;
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->d), dataOperationSizeBytes);
+        pPrepared->n.pData = pConcateTemp;
+        pPrepared->n.dataLenInBytes = dataOperationSizeBytes;
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->n), dataOperationSizeBytes);
+    }
+    else
+    {
+        /* Same layout as cpaCyEcdsaSignRS, m and k are written per request */
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->d), dataOperationSizeBytes);
+        LAC_OS_BZERO(pConcateTemp, 2 * dataOperationSizeBytes);
+        pConcateTemp += 2 * dataOperationSizeBytes;
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->b), dataOperationSizeBytes);
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->a), dataOperationSizeBytes);
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->q), dataOperationSizeBytes);
+        pPrepared->n.pData = pConcateTemp;
+        pPrepared->n.dataLenInBytes = dataOperationSizeBytes;
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->n), dataOperationSizeBytes);
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->yg), dataOperationSizeBytes);
+        LacEc_FlatBuffToConcate(
+            &pConcateTemp, &(pOpData->xg), dataOperationSizeBytes);
+    }
+
+    *pKey = (icp_sal_ecdsa_prepared_key_t)pPrepared;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *      ECDSA Sign R & S with a prepared key, synchronous function
+ ***************************************************************************/
+STATIC CpaStatus
+LacEcdsa_SignRSPreparedSyn(const CpaInstanceHandle instanceHandle,
+                           icp_sal_ecdsa_prepared_key_t key,
+                           const CpaCyEcdsaSignRSOpData *pOpData,
+                           CpaBoolean *pMultiplyStatus,
+                           CpaFlatBuffer *pR,
+                           CpaFlatBuffer *pS)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    lac_sync_op_data_t *pSyncCallbackData = NULL;
+    sal_crypto_service_t *pCryptoService =
+        (sal_crypto_service_t *)instanceHandle;
+
+    status = LacSync_CreateSyncCookie(&pSyncCallbackData);
+    /*
+     * Call the asynchronous version of the function
+     * with the generic synchronous callback function as a parameter.
+     */
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_EcdsaSignRSPrepared(instanceHandle,
+                                             LacSync_GenDualFlatBufVerifyCb,
+                                             pSyncCallbackData,
+                                             key,
+                                             pOpData,
+                                             pMultiplyStatus,
+                                             pR,
+                                             pS);
+    }
+    else
+    {
+        LAC_ECDSA_STAT_INC(numEcdsaSignRSRequestErrors, pCryptoService);
+        return status;
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        CpaStatus wCbStatus = CPA_STATUS_FAIL;
+        wCbStatus = LacSync_WaitForCallback(pSyncCallbackData,
+                                            LAC_PKE_SYNC_CALLBACK_TIMEOUT,
+                                            &status,
+                                            pMultiplyStatus);
+
+        if (CPA_STATUS_SUCCESS != wCbStatus)
+        {
+            LAC_ECDSA_STAT_INC(numEcdsaSignRSCompletedErrors, pCryptoService);
+            status = wCbStatus;
+        }
+    }
+    else
+    {
+        /* As the Request was not sent the Callback will never
+         * be called, so need to indicate that we're finished
+         * with cookie so it can be destroyed. */
+        LacSync_SetSyncCookieComplete(pSyncCallbackData);
+    }
+
+    LacSync_DestroySyncCookie(&pSyncCallbackData);
+    return status;
+}
+
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_EcdsaSignRSPrepared(const CpaInstanceHandle instanceHandle_in,
+                                      const CpaCyEcdsaSignRSCbFunc pCb,
+                                      void *pCallbackTag,
+                                      icp_sal_ecdsa_prepared_key_t key,
+                                      const CpaCyEcdsaSignRSOpData *pOpData,
+                                      CpaBoolean *pMultiplyStatus,
+                                      CpaFlatBuffer *pR,
+                                      CpaFlatBuffer *pS)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaInstanceHandle instanceHandle = NULL;
+    sal_crypto_service_t *pCryptoService = NULL;
+    lac_ecdsa_prepared_key_t *pPrepared = (lac_ecdsa_prepared_key_t *)key;
+    Cpa8U *pMemPoolConcate = NULL;
+    Cpa8U *pConcateTemp = NULL;
+    CpaFlatBuffer *pInBuff = NULL;
+    Cpa32U size = 0;
+    Cpa32U functionID = 0;
+
+    icp_qat_fw_mmp_input_param_t inRS = {.flat_array = {0}};
+    icp_qat_fw_mmp_output_param_t outRS = {.flat_array = {0}};
+    lac_pke_op_cb_data_t cbData = {0};
+
+    /* Holding the calculated size of the input/output parameters */
+    Cpa32U inArgSizeList[LAC_MAX_MMP_INPUT_PARAMS] = {0};
+    Cpa32U outArgSizeList[LAC_MAX_MMP_OUTPUT_PARAMS] = {0};
+
+    CpaBoolean internalMemInList[LAC_MAX_MMP_INPUT_PARAMS] = {CPA_FALSE};
+    CpaBoolean internalMemOutList[LAC_MAX_MMP_OUTPUT_PARAMS] = {CPA_FALSE};
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
+    {
+        instanceHandle = Lac_GetFirstHandle(SAL_SERVICE_TYPE_CRYPTO_ASYM);
+    }
+    else
+    {
+        instanceHandle = instanceHandle_in;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_ADDR_TRANS_SETUP(instanceHandle);
+#endif
+    SAL_RUNNING_CHECK(instanceHandle);
+#ifdef ICP_PARAM_CHECK
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_ASYM));
+    LAC_CHECK_NULL_PARAM(pPrepared);
+    if (pPrepared->instanceHandle != instanceHandle)
+    {
+        LAC_INVALID_PARAM_LOG("Key was prepared on another instance");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+
+    if (NULL == pCb)
+    {
+#ifdef ICP_PARAM_CHECK
+        LAC_CHECK_NULL_PARAM(pMultiplyStatus);
+#endif
+        return LacEcdsa_SignRSPreparedSyn(
+            instanceHandle, key, pOpData, pMultiplyStatus, pR, pS);
+    }
+
+    pCryptoService = (sal_crypto_service_t *)instanceHandle;
+    size = pPrepared->dataOperationSizeBytes;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pMultiplyStatus);
+    LAC_CHECK_NULL_PARAM(pOpData);
+    LAC_CHECK_NULL_PARAM(pR);
+    LAC_CHECK_NULL_PARAM(pS);
+    LAC_CHECK_NULL_PARAM(pOpData->k.pData);
+    LAC_CHECK_SIZE(&(pOpData->k), CHECK_NONE, 0);
+    LAC_CHECK_NULL_PARAM(pOpData->m.pData);
+    LAC_CHECK_SIZE(&(pOpData->m), CHECK_NONE, 0);
+    LAC_CHECK_NULL_PARAM(pR->pData);
+    LAC_CHECK_NULL_PARAM(pS->pData);
+    if ((pR->dataLenInBytes < pPrepared->minOutputLenInBytes) ||
+        (pS->dataLenInBytes < pPrepared->minOutputLenInBytes))
+    {
+        LAC_INVALID_PARAM_LOG("Output buffer not big enough");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* Check  0 < k < n */
+    LAC_CHECK_NON_ZERO_PARAM(&(pOpData->k));
+    if (LacPke_Compare(&(pOpData->k), 0, &(pPrepared->n), 0) >= 0)
+    {
+        LAC_INVALID_PARAM_LOG("k is not < n as required");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+    if ((CPA_TRUE != pPrepared->optimised) &&
+        (LacPke_GetMinBytes(&(pOpData->m)) > size))
+    {
+        LAC_INVALID_PARAM_LOG("m is wider than the curve");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* clear output buffers */
+    osalMemSet(pR->pData, 0, pR->dataLenInBytes);
+    osalMemSet(pS->pData, 0, pS->dataLenInBytes);
+
+    LAC_EC_SET_LIST_PARAMS(internalMemOutList,
+                           LAC_ECDSA_SIGNRS_NUM_OUT_ARGS,
+                           CPA_FALSE);
+    LAC_EC_SET_LIST_PARAMS(
+        outArgSizeList, LAC_ECDSA_SIGNRS_NUM_OUT_ARGS, size);
+
+    if (CPA_TRUE == pPrepared->optimised)
+    {
+        CpaCyEcdsaSignRSOpData opData;
+
+        functionID = pPrepared->functionID;
+        LAC_EC_SET_LIST_PARAMS(
+            inArgSizeList, LAC_ECDSA_SIGNRS_P256P384_NUM_IN_ARGS, size);
+        /* k and m come from the caller, d is already padded in DMA-able
+         * memory of the library so it is used in place */
+        opData.k = pOpData->k;
+        opData.m = pOpData->m;
+        opData.d = pPrepared->d;
+        internalMemInList[2] = CPA_TRUE; /* k, e, d */
+        if (PKE_ECDSA_SIGN_RS_P256 == functionID)
+        {
+            LacEcdsaP256P384SignRSOpDataWrite(inRS.mmp_ecdsa_sign_rs_p256,
+                                              outRS.mmp_ecdsa_sign_rs_p256,
+                                              (&opData),
+                                              pR,
+                                              pS);
+        }
+        else
+        {
+            LacEcdsaP256P384SignRSOpDataWrite(inRS.mmp_ecdsa_sign_rs_p384,
+                                              outRS.mmp_ecdsa_sign_rs_p384,
+                                              (&opData),
+                                              pR,
+                                              pS);
+        }
+    }
+    else
+    {
+        do
+        {
+            pMemPoolConcate =
+                (Cpa8U *)Lac_MemPoolEntryAlloc(pCryptoService->lac_ec_pool);
+            if (NULL == pMemPoolConcate)
+            {
+                LAC_LOG_ERROR("Cannot get mem pool entry");
+                status = CPA_STATUS_RESOURCE;
+            }
+            else if ((void *)CPA_STATUS_RETRY == pMemPoolConcate)
+            {
+                osalYield();
+            }
+        } while ((void *)CPA_STATUS_RETRY == pMemPoolConcate);
+
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            memcpy(pMemPoolConcate,
+                   pPrepared->pParams,
+                   pPrepared->paramsLenInBytes);
+            pConcateTemp = pMemPoolConcate + size;
+            LacEc_FlatBuffToConcate(&pConcateTemp, &(pOpData->m), size);
+            LacEc_FlatBuffToConcate(&pConcateTemp, &(pOpData->k), size);
+            pInBuff = (CpaFlatBuffer *)(pMemPoolConcate +
+                                        pPrepared->paramsLenInBytes);
+            pInBuff->dataLenInBytes = pPrepared->paramsLenInBytes;
+            pInBuff->pData = pMemPoolConcate;
+
+            LAC_EC_SET_LIST_PARAMS(inArgSizeList,
+                                   LAC_ECDSA_SIGNRS_NUM_IN_ARGS,
+                                   pPrepared->paramsLenInBytes);
+            LAC_EC_SET_LIST_PARAMS(
+                internalMemInList, LAC_ECDSA_SIGNRS_NUM_IN_ARGS, CPA_TRUE);
+
+            status = LacEcdsa_SignRSFillMMPStructs(&inRS,
+                                                   &outRS,
+                                                   pPrepared->fieldType,
+                                                   size,
+                                                   pInBuff,
+                                                   pR,
+                                                   pS,
+                                                   &functionID);
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        cbData.pClientCb = pCb;
+        cbData.pCallbackTag = pCallbackTag;
+        cbData.pClientOpData = pOpData;
+        cbData.pOpaqueData = pMemPoolConcate;
+        cbData.pOutputData1 = pR;
+        cbData.pOutputData2 = pS;
+
+        status = LacPke_SendSingleRequest(functionID,
+                                          inArgSizeList,
+                                          outArgSizeList,
+                                          &inRS,
+                                          &outRS,
+                                          internalMemInList,
+                                          internalMemOutList,
+                                          LacEcdsa_SignRSCallback,
+                                          &cbData,
+                                          instanceHandle);
+        if ((CPA_STATUS_SUCCESS != status) && (NULL != pMemPoolConcate))
+        {
+            Lac_MemPoolEntryFree(pMemPoolConcate);
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        LAC_ECDSA_STAT_INC(numEcdsaSignRSRequests, pCryptoService);
+    }
+    else
+    {
+        LAC_ECDSA_STAT_INC(numEcdsaSignRSRequestErrors, pCryptoService);
+    }
+
+    return status;
+}
+
+/**
+ ***************************************************************************
+ * @ingroup Lac_Ec
+ *
+ ***************************************************************************/
+CpaStatus icp_sal_EcdsaSignRSFreePreparedKey(
+    const CpaInstanceHandle instanceHandle_in,
+    icp_sal_ecdsa_prepared_key_t key)
+{
+    CpaInstanceHandle instanceHandle = NULL;
+    lac_ecdsa_prepared_key_t *pPrepared = (lac_ecdsa_prepared_key_t *)key;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
+    {
+        instanceHandle = Lac_GetFirstHandle(SAL_SERVICE_TYPE_CRYPTO_ASYM);
+    }
+    else
+    {
+        instanceHandle = instanceHandle_in;
+    }
+
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    LAC_CHECK_NULL_PARAM(pPrepared);
+    if (pPrepared->instanceHandle != instanceHandle)
+    {
+        LAC_INVALID_PARAM_LOG("Key was prepared on another instance");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    osalMemZeroExplicit(pPrepared->pParams, pPrepared->paramsLenInBytes);
+    LAC_OS_CAFREE(pPrepared->pParams);
+    osalMemZeroExplicit(pPrepared, sizeof(lac_ecdsa_prepared_key_t));
+    LAC_OS_FREE(pPrepared);
+
+    return CPA_STATUS_SUCCESS;
+}
+
 /**
  ***************************************************************************
  * @ingroup Lac_Ec
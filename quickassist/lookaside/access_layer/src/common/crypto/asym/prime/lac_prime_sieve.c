@@ -0,0 +1,674 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file lac_prime_sieve.c
+ *
+ * @ingroup Lac_Prime
+ *
+ * @description
+ *      Implementation of the host-side prime sieve and of the prime search,
+ *      which keeps several prime tests of consecutive candidates in flight.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_cy_prime.h"
+#include "icp_sal_poll.h"
+#include "icp_sal_prime_sieve.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "Osal.h"
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_log.h"
+#include "lac_sync.h"
+#include "lac_pke_utils.h"
+#include "lac_sal_types_crypto.h"
+#include "sal_service_state.h"
+
+/* Small primes used by the sieve are the odd primes below this bound */
+#define LAC_PRIME_SIEVE_BOUND (1 << 14)
+
+/* Number of odd primes below LAC_PRIME_SIEVE_BOUND */
+#define LAC_PRIME_SIEVE_NUM_PRIMES (1899)
+
+/* Smallest start value, above every sieve prime */
+#define LAC_PRIME_SIEVE_MIN_START_BITS (32)
+
+/* Time without any test completing after which the search fails */
+#define LAC_PRIME_SEARCH_TIMEOUT_NS                                            \
+    ((Cpa64U)LAC_PKE_SYNC_CALLBACK_TIMEOUT * 1000000ULL)
+
+/* Slot states, the callback moves a slot from BUSY to DONE */
+#define LAC_PRIME_SEARCH_SLOT_FREE (0)
+#define LAC_PRIME_SEARCH_SLOT_BUSY (1)
+#define LAC_PRIME_SEARCH_SLOT_DONE (2)
+
+/**
+ *****************************************************************************
+ * @ingroup Lac_Prime
+ *      Prime sieve
+ *
+ * @description
+ *      Window index i stands for the odd number base + 2 * i, and
+ *      pResidues[k] holds base modulo pPrimes[k]. The arrays follow the
+ *      structure in the same allocation.
+ *****************************************************************************/
+typedef struct lac_prime_sieve_s
+{
+    Cpa32U lenInBytes;
+    /* Length of the start value and of the candidates */
+    Cpa32U windowSize;
+    /* Odd numbers per window */
+    Cpa32U numPrimes;
+    /* Number of sieve primes, 0 to return every odd number */
+    Cpa32U next;
+    /* Next window index to examine */
+    Cpa64U windowOffset;
+    /* Odd numbers between the start value and base */
+    Cpa16U *pPrimes;
+    Cpa16U *pResidues;
+    Cpa8U *pComposite;
+    /* One flag per window index, set when the number has a small factor */
+    Cpa8U *pBase;
+    /* Big-endian value of window index 0 */
+} lac_prime_sieve_t;
+
+/**
+ *****************************************************************************
+ * @ingroup Lac_Prime
+ *      One prime test in flight
+ *****************************************************************************/
+typedef struct lac_prime_search_slot_s
+{
+    OsalAtomic state;
+    /* LAC_PRIME_SEARCH_SLOT_FREE, _BUSY or _DONE */
+    CpaStatus cbStatus;
+    /* Status passed to the callback */
+    CpaBoolean testPassed;
+    /* Result passed to the callback */
+    CpaBoolean loaded;
+    /* The slot holds a candidate which was not sent yet */
+    Cpa64U offset;
+    /* Odd numbers between the start candidate and the candidate tested */
+    CpaCyPrimeTestOpData opData;
+} lac_prime_search_slot_t;
+
+/*
+ * Add a small value to a big-endian number, returns the carry out of the
+ * most significant byte
+ */
+STATIC Cpa32U LacPrimeSieve_Add(Cpa8U *pNum, Cpa32U lenInBytes, Cpa32U value)
+{
+    Cpa32U sum = 0;
+    Cpa32U i = lenInBytes;
+
+    while (i > 0 && value > 0)
+    {
+        i--;
+        sum = pNum[i] + (value & 0xff);
+        pNum[i] = (Cpa8U)sum;
+        value = (value >> LAC_NUM_BITS_IN_BYTE) + (sum >> LAC_NUM_BITS_IN_BYTE);
+    }
+    return value;
+}
+
+/* Strike out the multiples of the sieve primes in the current window */
+STATIC void LacPrimeSieve_Mark(lac_prime_sieve_t *pSieve)
+{
+    Cpa32U k = 0;
+    Cpa32U p = 0;
+    Cpa32U i = 0;
+
+    osalMemSet(pSieve->pComposite, 0, pSieve->windowSize);
+    for (k = 0; k < pSieve->numPrimes; k++)
+    {
+        p = pSieve->pPrimes[k];
+        /* base + 2 * i is a multiple of p for i = (p - r) / 2 modulo p,
+         * where (p - r) is made even by adding p when it is odd */
+        i = (0 == pSieve->pResidues[k]) ? 0 : p - pSieve->pResidues[k];
+        if (i & 1)
+        {
+            i += p;
+        }
+        for (i >>= 1; i < pSieve->windowSize; i += p)
+        {
+            pSieve->pComposite[i] = 1;
+        }
+    }
+    pSieve->next = 0;
+}
+
+/* Move the sieve to the window following the current one */
+STATIC CpaStatus LacPrimeSieve_Advance(lac_prime_sieve_t *pSieve)
+{
+    Cpa32U step = 2 * pSieve->windowSize;
+    Cpa32U k = 0;
+
+    if (0 != LacPrimeSieve_Add(pSieve->pBase, pSieve->lenInBytes, step))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    for (k = 0; k < pSieve->numPrimes; k++)
+    {
+        pSieve->pResidues[k] =
+            (Cpa16U)((pSieve->pResidues[k] + step) % pSieve->pPrimes[k]);
+    }
+    pSieve->windowOffset += pSieve->windowSize;
+    LacPrimeSieve_Mark(pSieve);
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ * Write the next surviving candidate to pCandidate and its distance from
+ * the start value, in odd numbers, to pOffset
+ */
+STATIC CpaStatus LacPrimeSieve_Next(lac_prime_sieve_t *pSieve,
+                                    Cpa8U *pCandidate,
+                                    Cpa64U *pOffset)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+    for (;;)
+    {
+        while (pSieve->next < pSieve->windowSize &&
+               pSieve->pComposite[pSieve->next])
+        {
+            pSieve->next++;
+        }
+        if (pSieve->next < pSieve->windowSize)
+        {
+            break;
+        }
+        status = LacPrimeSieve_Advance(pSieve);
+        LAC_CHECK_STATUS(status);
+    }
+
+    i = pSieve->next++;
+    memcpy(pCandidate, pSieve->pBase, pSieve->lenInBytes);
+    if (0 != LacPrimeSieve_Add(pCandidate, pSieve->lenInBytes, 2 * i))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    *pOffset = pSieve->windowOffset + i;
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC CpaStatus LacPrimeSieve_Create(const CpaFlatBuffer *pStart,
+                                      Cpa32U windowSize,
+                                      CpaBoolean useSieve,
+                                      lac_prime_sieve_t **ppSieve)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    lac_prime_sieve_t *pSieve = NULL;
+    Cpa32U numPrimes = (CPA_TRUE == useSieve) ? LAC_PRIME_SIEVE_NUM_PRIMES : 0;
+    Cpa32U sizeInBytes = 0;
+    Cpa32U n = 0;
+    Cpa32U p = 0;
+    Cpa32U j = 0;
+    Cpa32U k = 0;
+    Cpa32U r = 0;
+
+    if (0 == windowSize)
+    {
+        windowSize = ICP_SAL_PRIME_SIEVE_DEFAULT_WINDOW;
+    }
+    if (windowSize < ICP_SAL_PRIME_SIEVE_MIN_WINDOW ||
+        windowSize > ICP_SAL_PRIME_SIEVE_MAX_WINDOW)
+    {
+        LAC_INVALID_PARAM_LOG("Sieve window size out of range");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (CPA_TRUE == useSieve &&
+        LacPke_GetMinBytes(pStart) * LAC_NUM_BITS_IN_BYTE <=
+            LAC_PRIME_SIEVE_MIN_START_BITS)
+    {
+        LAC_INVALID_PARAM_LOG("Start value too small to sieve");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    sizeInBytes = sizeof(lac_prime_sieve_t) +
+                  2 * numPrimes * sizeof(Cpa16U) + windowSize +
+                  pStart->dataLenInBytes;
+    status = LAC_OS_MALLOC(&pSieve, sizeInBytes);
+    LAC_CHECK_STATUS(status);
+
+    pSieve->lenInBytes = pStart->dataLenInBytes;
+    pSieve->windowSize = windowSize;
+    pSieve->numPrimes = numPrimes;
+    pSieve->windowOffset = 0;
+    pSieve->pPrimes = (Cpa16U *)(pSieve + 1);
+    pSieve->pResidues = pSieve->pPrimes + numPrimes;
+    pSieve->pComposite = (Cpa8U *)(pSieve->pResidues + numPrimes);
+    pSieve->pBase = pSieve->pComposite + windowSize;
+    memcpy(pSieve->pBase, pStart->pData, pStart->dataLenInBytes);
+
+    /* Odd primes below the bound, by trial division with the smaller ones */
+    for (n = 3, k = 0; k < numPrimes; n += 2)
+    {
+        for (j = 0; j < k; j++)
+        {
+            p = pSieve->pPrimes[j];
+            if (p * p > n || 0 == n % p)
+            {
+                break;
+            }
+        }
+        if (j == k || 0 != n % pSieve->pPrimes[j])
+        {
+            pSieve->pPrimes[k++] = (Cpa16U)n;
+        }
+    }
+
+    /* The only multiple precision step: the start value modulo each prime */
+    for (k = 0; k < numPrimes; k++)
+    {
+        for (j = 0, r = 0; j < pSieve->lenInBytes; j++)
+        {
+            r = ((r << LAC_NUM_BITS_IN_BYTE) | pSieve->pBase[j]) %
+                pSieve->pPrimes[k];
+        }
+        pSieve->pResidues[k] = (Cpa16U)r;
+    }
+    LacPrimeSieve_Mark(pSieve);
+
+    *ppSieve = pSieve;
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC void LacPrimeSieve_Free(lac_prime_sieve_t *pSieve)
+{
+    osalMemZeroExplicit(pSieve->pBase, pSieve->lenInBytes);
+    osalMemZeroExplicit(pSieve->pResidues,
+                        pSieve->numPrimes * sizeof(Cpa16U));
+    LAC_OS_FREE(pSieve);
+}
+
+CpaStatus icp_sal_PrimeSieveCreate(const CpaFlatBuffer *pStart,
+                                   Cpa32U windowSize,
+                                   icp_sal_prime_sieve_t *pSieve)
+{
+    LAC_CHECK_NULL_PARAM(pSieve);
+    LAC_CHECK_FLAT_BUFFER_PARAM_PKE(pStart, CHECK_NONE, 0, LAC_CHECK_LSB_YES);
+
+    return LacPrimeSieve_Create(
+        pStart, windowSize, CPA_TRUE, (lac_prime_sieve_t **)pSieve);
+}
+
+CpaStatus icp_sal_PrimeSieveNext(icp_sal_prime_sieve_t sieve,
+                                 CpaFlatBuffer *pCandidate)
+{
+    lac_prime_sieve_t *pSieve = (lac_prime_sieve_t *)sieve;
+    Cpa64U offset = 0;
+
+    LAC_CHECK_NULL_PARAM(pSieve);
+    LAC_CHECK_FLAT_BUFFER(pCandidate);
+    if (pCandidate->dataLenInBytes != pSieve->lenInBytes)
+    {
+        LAC_INVALID_PARAM_LOG("Candidate and start value lengths differ");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    return LacPrimeSieve_Next(pSieve, pCandidate->pData, &offset);
+}
+
+CpaStatus icp_sal_PrimeSieveFree(icp_sal_prime_sieve_t sieve)
+{
+    LAC_CHECK_NULL_PARAM(sieve);
+
+    LacPrimeSieve_Free((lac_prime_sieve_t *)sieve);
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC void LacPrimeSearchCallback(void *pCallbackTag,
+                                   CpaStatus status,
+                                   void *pOpData,
+                                   CpaBoolean testPassed)
+{
+    lac_prime_search_slot_t *pSlot = (lac_prime_search_slot_t *)pCallbackTag;
+
+    pSlot->cbStatus = status;
+    pSlot->testPassed = testPassed;
+    /* Full barrier: the results are visible before the slot is DONE */
+    osalAtomicInc(&pSlot->state);
+}
+
+#ifdef ICP_PARAM_CHECK
+STATIC CpaStatus
+LacPrimeSearchParamCheck(const icp_sal_prime_search_op_data_t *pOpData,
+                         const CpaFlatBuffer *pPrime,
+                         const icp_sal_prime_search_results_t *pResults)
+{
+    LAC_CHECK_NULL_PARAM(pOpData);
+    LAC_CHECK_NULL_PARAM(pResults);
+    LAC_CHECK_FLAT_BUFFER(pPrime);
+    LAC_CHECK_FLAT_BUFFER_PARAM_PKE(
+        &pOpData->startCandidate,
+        CHECK_LESS_EQUALS,
+        LAC_BITS_TO_BYTES(LAC_MAX_PRIME_SIZE_IN_BITS),
+        LAC_CHECK_LSB_YES);
+    if (pPrime->dataLenInBytes != pOpData->startCandidate.dataLenInBytes)
+    {
+        LAC_INVALID_PARAM_LOG("Prime and start candidate lengths differ");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == pOpData->maxCandidates)
+    {
+        LAC_INVALID_PARAM_LOG("No candidate to examine");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (pOpData->maxInflight > ICP_SAL_PRIME_SEARCH_MAX_INFLIGHT)
+    {
+        LAC_INVALID_PARAM_LOG("Too many prime tests in flight");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (!(pOpData->performGcdTest || pOpData->performFermatTest ||
+          0 != pOpData->numMillerRabinRounds || pOpData->performLucasTest))
+    {
+        LAC_INVALID_PARAM_LOG("No prime test was selected");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (pOpData->numMillerRabinRounds > LAC_PRIME_MAX_MR)
+    {
+        LAC_INVALID_PARAM_LOG("Number of Miller-Rabin rounds too high");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+#endif
+
+CpaStatus icp_sal_CyPrimeSearch(const CpaInstanceHandle instanceHandle_in,
+                                const icp_sal_prime_search_op_data_t *pOpData,
+                                CpaFlatBuffer *pPrime,
+                                icp_sal_prime_search_results_t *pResults)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaInstanceHandle instanceHandle = NULL;
+    sal_crypto_service_t *pCryptoService = NULL;
+    lac_prime_sieve_t *pSieve = NULL;
+    lac_prime_search_slot_t *pSlots = NULL;
+    lac_prime_search_slot_t *pSlot = NULL;
+    Cpa8U *pCandidates = NULL;
+    Cpa32U lenInBytes = 0;
+    Cpa32U maxInflight = 0;
+    Cpa32U numInflight = 0;
+    Cpa32U first = 0;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+    Cpa64U bestOffset = 0;
+    Cpa64U numSent = 0;
+    Cpa64U lastProgress = 0;
+    CpaBoolean exhausted = CPA_FALSE;
+    CpaBoolean progress = CPA_FALSE;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
+    {
+        instanceHandle = Lac_GetFirstHandle(SAL_SERVICE_TYPE_CRYPTO_ASYM);
+    }
+    else
+    {
+        instanceHandle = instanceHandle_in;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_ADDR_TRANS_SETUP(instanceHandle);
+#endif
+    SAL_RUNNING_CHECK(instanceHandle);
+#ifdef ICP_PARAM_CHECK
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_ASYM));
+    status = LacPrimeSearchParamCheck(pOpData, pPrime, pResults);
+    LAC_CHECK_STATUS(status);
+#endif
+
+    pCryptoService = (sal_crypto_service_t *)instanceHandle;
+    lenInBytes = pOpData->startCandidate.dataLenInBytes;
+    maxInflight = (0 == pOpData->maxInflight)
+                      ? ICP_SAL_PRIME_SEARCH_DEFAULT_INFLIGHT
+                      : pOpData->maxInflight;
+    osalMemSet(pResults, 0, sizeof(*pResults));
+
+    status = LacPrimeSieve_Create(&pOpData->startCandidate,
+                                  pOpData->windowSize,
+                                  pOpData->useSieve,
+                                  &pSieve);
+    LAC_CHECK_STATUS(status);
+    status = LAC_OS_MALLOC(&pSlots,
+                           maxInflight * sizeof(lac_prime_search_slot_t));
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LacPrimeSieve_Free(pSieve);
+        return status;
+    }
+    osalMemSet(pSlots, 0, maxInflight * sizeof(lac_prime_search_slot_t));
+    status = LAC_OS_CAMALLOC(&pCandidates,
+                             maxInflight * lenInBytes,
+                             LAC_64BYTE_ALIGNMENT,
+                             pCryptoService->nodeAffinity);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_FREE(pSlots);
+        LacPrimeSieve_Free(pSieve);
+        return status;
+    }
+
+    for (i = 0; i < maxInflight; i++)
+    {
+        pSlot = &pSlots[i];
+        osalAtomicSet(LAC_PRIME_SEARCH_SLOT_FREE, &pSlot->state);
+        pSlot->opData.primeCandidate.pData = pCandidates + i * lenInBytes;
+        pSlot->opData.primeCandidate.dataLenInBytes = lenInBytes;
+        pSlot->opData.performGcdTest = pOpData->performGcdTest;
+        pSlot->opData.performFermatTest = pOpData->performFermatTest;
+        pSlot->opData.numMillerRabinRounds = pOpData->numMillerRabinRounds;
+        pSlot->opData.millerRabinRandomInput =
+            pOpData->millerRabinRandomInput;
+        pSlot->opData.performLucasTest = pOpData->performLucasTest;
+    }
+
+    /* Candidates go out in increasing order, so once one passes only the
+     * smaller ones still in flight can beat it */
+    lastProgress = osalTimestampGetNs();
+    while (numInflight > 0 ||
+           (CPA_STATUS_SUCCESS == status && CPA_FALSE == pResults->found &&
+            CPA_FALSE == exhausted))
+    {
+        progress = CPA_FALSE;
+
+        /* Start from the slot of a candidate refused by the ring, so it
+         * is sent again before any larger one */
+        for (j = 0; j < maxInflight && CPA_STATUS_SUCCESS == status &&
+                    CPA_FALSE == pResults->found && CPA_FALSE == exhausted;
+             j++)
+        {
+            i = (first + j) % maxInflight;
+            pSlot = &pSlots[i];
+            if (LAC_PRIME_SEARCH_SLOT_FREE != osalAtomicGet(&pSlot->state))
+            {
+                continue;
+            }
+
+            if (CPA_FALSE == pSlot->loaded)
+            {
+                if (CPA_STATUS_SUCCESS !=
+                        LacPrimeSieve_Next(pSieve,
+                                           pSlot->opData.primeCandidate.pData,
+                                           &pSlot->offset) ||
+                    pSlot->offset >= pOpData->maxCandidates)
+                {
+                    /* Past maxCandidates or the length of the buffer */
+                    exhausted = CPA_TRUE;
+                    break;
+                }
+                pSlot->loaded = CPA_TRUE;
+            }
+
+            osalAtomicSet(LAC_PRIME_SEARCH_SLOT_BUSY, &pSlot->state);
+            status = cpaCyPrimeTest(instanceHandle,
+                                    LacPrimeSearchCallback,
+                                    pSlot,
+                                    &pSlot->opData,
+                                    &pSlot->testPassed);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                osalAtomicSet(LAC_PRIME_SEARCH_SLOT_FREE, &pSlot->state);
+                if (CPA_STATUS_RETRY == status ||
+                    CPA_STATUS_RESOURCE == status)
+                {
+                    /* Ring full or request pools in use, poll first */
+                    status = CPA_STATUS_SUCCESS;
+                    first = i;
+                }
+                break;
+            }
+            pSlot->loaded = CPA_FALSE;
+            numInflight++;
+            numSent = pSlot->offset + 1;
+            pResults->numTested++;
+        }
+
+        icp_sal_CyPollInstance(instanceHandle, 0);
+
+        /* Reap the completed tests */
+        for (i = 0; i < maxInflight; i++)
+        {
+            pSlot = &pSlots[i];
+            if (LAC_PRIME_SEARCH_SLOT_DONE != osalAtomicGet(&pSlot->state))
+            {
+                continue;
+            }
+
+            if (CPA_STATUS_SUCCESS == status &&
+                CPA_STATUS_SUCCESS != pSlot->cbStatus)
+            {
+                LAC_LOG_ERROR("Prime test of a search candidate failed\n");
+                status = CPA_STATUS_FAIL;
+            }
+            if (CPA_STATUS_SUCCESS == status &&
+                CPA_TRUE == pSlot->testPassed &&
+                (CPA_FALSE == pResults->found || pSlot->offset < bestOffset))
+            {
+                memcpy(pPrime->pData,
+                       pSlot->opData.primeCandidate.pData,
+                       lenInBytes);
+                bestOffset = pSlot->offset;
+                pResults->found = CPA_TRUE;
+            }
+            osalAtomicSet(LAC_PRIME_SEARCH_SLOT_FREE, &pSlot->state);
+            numInflight--;
+            progress = CPA_TRUE;
+        }
+
+        if (CPA_TRUE == progress)
+        {
+            lastProgress = osalTimestampGetNs();
+        }
+        else if (osalTimestampGetNs() - lastProgress >
+                 LAC_PRIME_SEARCH_TIMEOUT_NS)
+        {
+            LAC_LOG_ERROR("Timed out waiting for prime tests\n");
+            status = CPA_STATUS_FAIL;
+            break;
+        }
+        else
+        {
+            osalYield();
+        }
+    }
+
+    if (numInflight > 0)
+    {
+        /* Requests still reference the slots and candidates, so these are
+         * leaked rather than freed under the hardware. */
+        LacPrimeSieve_Free(pSieve);
+        return CPA_STATUS_FAIL;
+    }
+    /* Candidates beyond the prime may have been tested for nothing, but
+     * they do not count as examined */
+    pResults->numExamined =
+        (CPA_TRUE == pResults->found)
+            ? bestOffset + 1
+            : ((CPA_TRUE == exhausted) ? pOpData->maxCandidates : numSent);
+    pResults->numSieved = numSent - pResults->numTested;
+
+    osalMemZeroExplicit(pCandidates, maxInflight * lenInBytes);
+    LAC_OS_CAFREE(pCandidates);
+    LAC_OS_FREE(pSlots);
+    LacPrimeSieve_Free(pSieve);
+
+    return status;
+}
@@ -78,6 +78,392 @@
 */
 #include "cpa.h"
 #include "cpa_cy_drbg.h"
+#include "icp_sal_drbg_impl.h"
+
+#include "Osal.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_common.h"
+#include "lac_log.h"
+#include "lac_mem.h"
+#include "lac_sal_types_crypto.h"
+#include "sal_service_state.h"
+#include "sal_statistics.h"
+#include "lac_sym_drbg.h"
+
+/**< Marks an initialised session */
+#define LAC_DRBG_SESSION_MAGIC (0x44524247)
+
+/**< Size of the per-session buffer of pregenerated output. Requests with
+ * neither additional input nor prediction resistance that fit in it are
+ * served from it, so one generate call covers many small requests. */
+#define LAC_DRBG_OUT_BUF_IN_BYTES (1024)
+
+/**< Largest entropy input and nonce requested from the registered
+ * functions when the derivation function is used */
+#define LAC_DRBG_MAX_ENTROPY_IN_BYTES LAC_DRBG_KEY_LEN_IN_BYTES
+#define LAC_DRBG_MAX_NONCE_IN_BYTES LAC_DRBG_BLOCK_LEN_IN_BYTES
+
+/* Number of DRBG statistics */
+#define LAC_DRBG_NUM_STATS (sizeof(CpaCyDrbgStats64) / sizeof(Cpa64U))
+
+#ifndef DISABLE_STATS
+#define LAC_DRBG_STAT_INC(statistic, pCryptoService)                           \
+    do                                                                         \
+    {                                                                          \
+        if (CPA_TRUE ==                                                        \
+            (pCryptoService)->generic_service_info.stats->bSymStatsEnabled)    \
+        {                                                                      \
+            osalAtomicInc(&(pCryptoService)                                    \
+                               ->pLacDrbgStatsArr[offsetof(CpaCyDrbgStats64,   \
+                                                           statistic) /        \
+                                                  sizeof(Cpa64U)]);            \
+        }                                                                      \
+    } while (0)
+/**<
+ * macro to increment a DRBG stat (derives offset into array of atomics) */
+#else
+#define LAC_DRBG_STAT_INC(statistic, pCryptoService)                           \
+    (pCryptoService) = (pCryptoService)
+#endif
+
+/**
+ *****************************************************************************
+ * @ingroup LacSym_Drbg
+ *      DRBG session
+ *
+ * @description
+ *      Lives in the memory the client passes as CpaCyDrbgSessionHandle.
+ *      The mutex serialises all requests on the session. A request may
+ *      wait for the entropy source or generate up to 64 KiB per call
+ *      while holding it, so waiters sleep rather than spin.
+ *
+ *****************************************************************************/
+typedef struct lac_drbg_session_s
+{
+    Cpa32U magic;
+    OsalMutex lock;
+    lac_drbg_ctr_state_t state;
+    CpaCyDrbgSecStrength secStrength;
+    CpaBoolean predictionResistanceRequired;
+    CpaCyGenFlatBufCbFunc pGenCb;
+    CpaCyGenericCbFunc pReseedCb;
+    Cpa32U outAvail;
+    /**< Unread bytes at the end of outBuf */
+    Cpa8U outBuf[LAC_DRBG_OUT_BUF_IN_BYTES];
+} lac_drbg_session_t;
+
+/* Registered implementation specific functions, NULL selects the default */
+static IcpSalDrbgGetEntropyInputFunc pLacDrbgGetEntropyInputFunc = NULL;
+static IcpSalDrbgGetNonceFunc pLacDrbgGetNonceFunc = NULL;
+static IcpSalDrbgIsDFReqFunc pLacDrbgIsDFReqFunc = NULL;
+
+/* Default Get Entropy Input: the kernel RNG, always synchronous */
+STATIC CpaStatus
+LacDrbg_DefaultGetEntropyInput(IcpSalDrbgGetEntropyInputCbFunc pCb,
+                               void *pCallbackTag,
+                               icp_sal_drbg_get_entropy_op_data_t *pOpData,
+                               CpaFlatBuffer *pBuffer,
+                               Cpa32U *pLengthReturned)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (OSAL_SUCCESS !=
+        osalGetRandomBytes(pBuffer->pData, pOpData->maxLength))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    if (NULL != pCb)
+    {
+        pCb(pCallbackTag, status, pOpData, pOpData->maxLength, pBuffer);
+    }
+    else
+    {
+        *pLengthReturned = pOpData->maxLength;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC CpaStatus
+LacDrbg_DefaultGetNonce(icp_sal_drbg_get_entropy_op_data_t *pOpData,
+                        CpaFlatBuffer *pBuffer,
+                        Cpa32U *pLengthReturned)
+{
+    *pLengthReturned = pOpData->maxLength;
+    if (OSAL_SUCCESS !=
+        osalGetRandomBytes(pBuffer->pData, pOpData->maxLength))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+STATIC Cpa32U LacDrbg_SecStrengthInBits(CpaCyDrbgSecStrength secStrength)
+{
+    switch (secStrength)
+    {
+        case CPA_CY_RBG_SEC_STRENGTH_112:
+            return 112;
+        case CPA_CY_RBG_SEC_STRENGTH_128:
+            return 128;
+        case CPA_CY_RBG_SEC_STRENGTH_192:
+            return 192;
+        default:
+            return 256;
+    }
+}
+
+/*
+ * Fetch entropy input (and a nonce when pNonce is not NULL) for the
+ * session from the registered functions. The lengths returned are checked
+ * against the request.
+ */
+STATIC CpaStatus LacDrbg_GetSeedInputs(lac_drbg_session_t *pSession,
+                                       Cpa8U *pEntropy,
+                                       Cpa32U *pEntropyLen,
+                                       Cpa8U *pNonce,
+                                       Cpa32U *pNonceLen)
+{
+    IcpSalDrbgGetEntropyInputFunc pGetEntropy = pLacDrbgGetEntropyInputFunc;
+    IcpSalDrbgGetNonceFunc pGetNonce = pLacDrbgGetNonceFunc;
+    icp_sal_drbg_get_entropy_op_data_t opData;
+    CpaFlatBuffer buffer;
+    Cpa32U strength = LacDrbg_SecStrengthInBits(pSession->secStrength);
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (NULL == pGetEntropy)
+    {
+        pGetEntropy = LacDrbg_DefaultGetEntropyInput;
+    }
+    if (NULL == pGetNonce)
+    {
+        pGetNonce = LacDrbg_DefaultGetNonce;
+    }
+
+    opData.sessionHandle = pSession;
+    if (CPA_TRUE == pSession->state.useDf)
+    {
+        opData.minEntropy = strength;
+        opData.minLength = strength / 8;
+        opData.maxLength = LAC_DRBG_MAX_ENTROPY_IN_BYTES;
+    }
+    else
+    {
+        /* Full entropy, seedlen bits */
+        opData.minEntropy = LAC_DRBG_SEED_LEN_IN_BYTES * 8;
+        opData.minLength = LAC_DRBG_SEED_LEN_IN_BYTES;
+        opData.maxLength = LAC_DRBG_SEED_LEN_IN_BYTES;
+    }
+    buffer.pData = pEntropy;
+    buffer.dataLenInBytes = opData.maxLength;
+    *pEntropyLen = 0;
+    status = pGetEntropy(NULL, NULL, &opData, &buffer, pEntropyLen);
+    if ((CPA_STATUS_SUCCESS != status) || (*pEntropyLen < opData.minLength) ||
+        (*pEntropyLen > opData.maxLength))
+    {
+        LAC_LOG_ERROR("Failed to get DRBG entropy input");
+        return CPA_STATUS_FAIL;
+    }
+
+    if (NULL == pNonce)
+    {
+        return CPA_STATUS_SUCCESS;
+    }
+    opData.minEntropy = strength / 2;
+    opData.minLength = strength / 16;
+    opData.maxLength = LAC_DRBG_MAX_NONCE_IN_BYTES;
+    buffer.pData = pNonce;
+    buffer.dataLenInBytes = opData.maxLength;
+    *pNonceLen = 0;
+    status = pGetNonce(&opData, &buffer, pNonceLen);
+    if ((CPA_STATUS_SUCCESS != status) || (*pNonceLen < opData.minLength) ||
+        (*pNonceLen > opData.maxLength))
+    {
+        LAC_LOG_ERROR("Failed to get DRBG nonce");
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Reseed from the entropy source; unread buffered output predates the new
+ * entropy and is discarded. Called with the session mutex held. */
+STATIC CpaStatus LacDrbg_SessionReseed(lac_drbg_session_t *pSession,
+                                       const CpaFlatBuffer *pAddIn)
+{
+    Cpa8U entropy[LAC_DRBG_SEED_LEN_IN_BYTES];
+    Cpa32U entropyLen = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    osalMemZeroExplicit(pSession->outBuf, sizeof(pSession->outBuf));
+    pSession->outAvail = 0;
+
+    status = LacDrbg_GetSeedInputs(pSession, entropy, &entropyLen, NULL, NULL);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LacDrbg_CtrReseed(&pSession->state,
+                                   entropy,
+                                   entropyLen,
+                                   (NULL != pAddIn) ? pAddIn->pData : NULL,
+                                   (NULL != pAddIn) ? pAddIn->dataLenInBytes
+                                                    : 0);
+    }
+    osalMemZeroExplicit(entropy, sizeof(entropy));
+    return status;
+}
+
+/* One SP 800-90A generate request, reseeding first when the reseed
+ * interval is exhausted or prediction resistance is asked for. Called with
+ * the session mutex held. */
+STATIC CpaStatus LacDrbg_SessionGenerate(lac_drbg_session_t *pSession,
+                                         CpaBoolean predictionResistance,
+                                         const CpaFlatBuffer *pAddIn,
+                                         Cpa8U *pOut,
+                                         Cpa32U outLen)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if ((CPA_TRUE == predictionResistance) ||
+        (pSession->state.reseedCounter > LAC_DRBG_RESEED_INTERVAL))
+    {
+        status = LacDrbg_SessionReseed(
+            pSession, (CPA_TRUE == predictionResistance) ? pAddIn : NULL);
+        /* The additional input went into the reseed */
+        if (CPA_TRUE == predictionResistance)
+        {
+            pAddIn = NULL;
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LacDrbg_CtrGenerate(&pSession->state,
+                                     (NULL != pAddIn) ? pAddIn->pData : NULL,
+                                     (NULL != pAddIn) ? pAddIn->dataLenInBytes
+                                                      : 0,
+                                     pOut,
+                                     outLen);
+    }
+    return status;
+}
+
+/* Serve a request from the output buffer, refilling it with one generate
+ * call when it runs dry. Bytes are consumed from the front of the unread
+ * region and wiped as they are handed out. */
+STATIC CpaStatus LacDrbg_SessionGenerateBuffered(lac_drbg_session_t *pSession,
+                                                 Cpa8U *pOut,
+                                                 Cpa32U outLen)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa8U *pAvail = NULL;
+    Cpa32U len = 0;
+
+    while (outLen > 0)
+    {
+        if (0 == pSession->outAvail)
+        {
+            status = LacDrbg_SessionGenerate(pSession,
+                                             CPA_FALSE,
+                                             NULL,
+                                             pSession->outBuf,
+                                             LAC_DRBG_OUT_BUF_IN_BYTES);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                return status;
+            }
+            pSession->outAvail = LAC_DRBG_OUT_BUF_IN_BYTES;
+        }
+        len = (outLen < pSession->outAvail) ? outLen : pSession->outAvail;
+        pAvail = pSession->outBuf + LAC_DRBG_OUT_BUF_IN_BYTES -
+                 pSession->outAvail;
+        memcpy(pOut, pAvail, len);
+        osalMemZeroExplicit(pAvail, len);
+        pSession->outAvail -= len;
+        pOut += len;
+        outLen -= len;
+    }
+    return status;
+}
+
+STATIC CpaInstanceHandle LacDrbg_GetInstance(CpaInstanceHandle instanceHandle)
+{
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle)
+    {
+        return Lac_GetFirstHandle(SAL_SERVICE_TYPE_CRYPTO_SYM);
+    }
+    return instanceHandle;
+}
+
+CpaStatus LacDrbg_Init(CpaInstanceHandle instanceHandle)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+
+    status = LacDrbg_CtrSelfTest();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    status = LAC_OS_MALLOC(&(pService->pLacDrbgStatsArr),
+                           LAC_DRBG_NUM_STATS * sizeof(OsalAtomic));
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        LacDrbg_StatsReset(instanceHandle);
+    }
+    return status;
+}
+
+void LacDrbg_StatsFree(CpaInstanceHandle instanceHandle)
+{
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+
+    if (NULL != pService->pLacDrbgStatsArr)
+    {
+        LAC_OS_FREE(pService->pLacDrbgStatsArr);
+    }
+}
+
+void LacDrbg_StatsReset(CpaInstanceHandle instanceHandle)
+{
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+
+    if (NULL != pService->pLacDrbgStatsArr)
+    {
+        LAC_OS_BZERO(
+            (void *)LAC_CONST_VOLATILE_PTR_CAST(pService->pLacDrbgStatsArr),
+            LAC_DRBG_NUM_STATS * sizeof(OsalAtomic));
+    }
+}
+
+IcpSalDrbgGetEntropyInputFunc icp_sal_drbgGetEntropyInputFuncRegister(
+    IcpSalDrbgGetEntropyInputFunc func)
+{
+    IcpSalDrbgGetEntropyInputFunc pPrev = pLacDrbgGetEntropyInputFunc;
+
+    pLacDrbgGetEntropyInputFunc = func;
+    return pPrev;
+}
+
+IcpSalDrbgGetNonceFunc icp_sal_drbgGetNonceFuncRegister(
+    IcpSalDrbgGetNonceFunc func)
+{
+    IcpSalDrbgGetNonceFunc pPrev = pLacDrbgGetNonceFunc;
+
+    pLacDrbgGetNonceFunc = func;
+    return pPrev;
+}
+
+IcpSalDrbgIsDFReqFunc icp_sal_drbgIsDFReqFuncRegister(
+    IcpSalDrbgIsDFReqFunc func)
+{
+    IcpSalDrbgIsDFReqFunc pPrev = pLacDrbgIsDFReqFunc;
+
+    pLacDrbgIsDFReqFunc = func;
+    return pPrev;
+}
 
 /**
  * @ingroup cpaCyDrbg
@@ -86,7 +472,19 @@ CpaStatus cpaCyDrbgSessionGetSize(const CpaInstanceHandle instanceHandle_in,
                                   const CpaCyDrbgSessionSetupData *pSetupData,
                                   Cpa32U *pSize)
 {
-    return CPA_STATUS_UNSUPPORTED;
+    CpaInstanceHandle instanceHandle = LacDrbg_GetInstance(instanceHandle_in);
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    LAC_CHECK_NULL_PARAM(pSetupData);
+    LAC_CHECK_NULL_PARAM(pSize);
+#endif
+
+    *pSize = sizeof(lac_drbg_session_t);
+    return CPA_STATUS_SUCCESS;
 }
 
 /**
@@ -99,7 +497,92 @@ CpaStatus cpaCyDrbgInitSession(const CpaInstanceHandle instanceHandle_in,
                                CpaCyDrbgSessionHandle sessionHandle,
                                Cpa32U *pSeedLen)
 {
-    return CPA_STATUS_UNSUPPORTED;
+    CpaInstanceHandle instanceHandle = LacDrbg_GetInstance(instanceHandle_in);
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+    lac_drbg_session_t *pSession = (lac_drbg_session_t *)sessionHandle;
+    IcpSalDrbgIsDFReqFunc pIsDFReq = pLacDrbgIsDFReqFunc;
+    Cpa8U entropy[LAC_DRBG_SEED_LEN_IN_BYTES];
+    Cpa8U nonce[LAC_DRBG_MAX_NONCE_IN_BYTES];
+    Cpa32U entropyLen = 0;
+    Cpa32U nonceLen = 0;
+    CpaBoolean useDf = CPA_TRUE;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    LAC_CHECK_NULL_PARAM(pSetupData);
+    LAC_CHECK_NULL_PARAM(sessionHandle);
+    LAC_CHECK_NULL_PARAM(pSeedLen);
+    LAC_CHECK_PARAM_RANGE(pSetupData->secStrength,
+                          CPA_CY_RBG_SEC_STRENGTH_112,
+                          CPA_CY_RBG_SEC_STRENGTH_256 + 1);
+    if (pSetupData->personalizationString.dataLenInBytes > 0)
+    {
+        LAC_CHECK_NULL_PARAM(pSetupData->personalizationString.pData);
+    }
+#endif
+    SAL_RUNNING_CHECK(instanceHandle);
+
+    if (NULL != pIsDFReq)
+    {
+        useDf = pIsDFReq();
+    }
+    if (pSetupData->personalizationString.dataLenInBytes >
+        ((CPA_TRUE == useDf) ? LAC_DRBG_MAX_INPUT_IN_BYTES
+                             : LAC_DRBG_SEED_LEN_IN_BYTES))
+    {
+        LAC_INVALID_PARAM_LOG("personalizationString too long");
+        LAC_DRBG_STAT_INC(numSessionErrors, pService);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    LAC_OS_BZERO(pSession, sizeof(lac_drbg_session_t));
+    pSession->state.useDf = useDf;
+    pSession->secStrength = pSetupData->secStrength;
+    pSession->predictionResistanceRequired =
+        pSetupData->predictionResistanceRequired;
+    pSession->pGenCb = pGenCb;
+    pSession->pReseedCb = pReseedCb;
+
+    status = LacDrbg_GetSeedInputs(pSession,
+                                   entropy,
+                                   &entropyLen,
+                                   (CPA_TRUE == useDf) ? nonce : NULL,
+                                   &nonceLen);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status =
+            LacDrbg_CtrInstantiate(&pSession->state,
+                                   useDf,
+                                   entropy,
+                                   entropyLen,
+                                   nonce,
+                                   nonceLen,
+                                   pSetupData->personalizationString.pData,
+                                   pSetupData->personalizationString
+                                       .dataLenInBytes);
+    }
+    osalMemZeroExplicit(entropy, sizeof(entropy));
+    osalMemZeroExplicit(nonce, sizeof(nonce));
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LAC_INIT_MUTEX(&pSession->lock);
+    }
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        osalMemZeroExplicit(pSession, sizeof(lac_drbg_session_t));
+        LAC_DRBG_STAT_INC(numSessionErrors, pService);
+        return status;
+    }
+
+    pSession->magic = LAC_DRBG_SESSION_MAGIC;
+    *pSeedLen = LAC_DRBG_SEED_LEN_IN_BYTES;
+    LAC_DRBG_STAT_INC(numSessionsInitialized, pService);
+    return CPA_STATUS_SUCCESS;
 }
 
 /**
@@ -110,7 +593,104 @@ CpaStatus cpaCyDrbgGen(const CpaInstanceHandle instanceHandle_in,
                        CpaCyDrbgGenOpData *pOpData,
                        CpaFlatBuffer *pPseudoRandomBits)
 {
-    return CPA_STATUS_UNSUPPORTED;
+    CpaInstanceHandle instanceHandle = LacDrbg_GetInstance(instanceHandle_in);
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+    lac_drbg_session_t *pSession = NULL;
+    const CpaFlatBuffer *pAddIn = NULL;
+    Cpa8U *pOut = NULL;
+    Cpa32U remaining = 0;
+    Cpa32U len = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    LAC_CHECK_NULL_PARAM(pOpData);
+    LAC_CHECK_NULL_PARAM(pOpData->sessionHandle);
+    LAC_CHECK_FLAT_BUFFER(pPseudoRandomBits);
+#endif
+    SAL_RUNNING_CHECK(instanceHandle);
+
+    pSession = (lac_drbg_session_t *)pOpData->sessionHandle;
+    if ((LAC_DRBG_SESSION_MAGIC != pSession->magic) ||
+        (0 == pOpData->lengthInBytes) ||
+        (pPseudoRandomBits->dataLenInBytes < pOpData->lengthInBytes) ||
+        (pOpData->secStrength < CPA_CY_RBG_SEC_STRENGTH_112) ||
+        (pOpData->secStrength > pSession->secStrength) ||
+        ((CPA_TRUE == pOpData->predictionResistanceRequired) &&
+         (CPA_TRUE != pSession->predictionResistanceRequired)) ||
+        ((pOpData->additionalInput.dataLenInBytes > 0) &&
+         (NULL == pOpData->additionalInput.pData)))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid DRBG generate request");
+        LAC_DRBG_STAT_INC(numGenRequestErrors, pService);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    LAC_DRBG_STAT_INC(numGenRequests, pService);
+
+    if (pOpData->additionalInput.dataLenInBytes > 0)
+    {
+        pAddIn = &pOpData->additionalInput;
+    }
+    pOut = pPseudoRandomBits->pData;
+    remaining = pOpData->lengthInBytes;
+
+    status = LAC_LOCK_MUTEX(&pSession->lock, OSAL_WAIT_FOREVER);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        if ((NULL == pAddIn) &&
+            (CPA_TRUE != pOpData->predictionResistanceRequired) &&
+            (remaining <= LAC_DRBG_OUT_BUF_IN_BYTES))
+        {
+            status =
+                LacDrbg_SessionGenerateBuffered(pSession, pOut, remaining);
+        }
+        else
+        {
+            /* Requests over the per-call limit are split */
+            while ((remaining > 0) && (CPA_STATUS_SUCCESS == status))
+            {
+                len = (remaining > LAC_DRBG_MAX_REQUEST_IN_BYTES)
+                          ? LAC_DRBG_MAX_REQUEST_IN_BYTES
+                          : remaining;
+                status = LacDrbg_SessionGenerate(
+                    pSession,
+                    pOpData->predictionResistanceRequired,
+                    pAddIn,
+                    pOut,
+                    len);
+                pOut += len;
+                remaining -= len;
+            }
+        }
+        LAC_UNLOCK_MUTEX(&pSession->lock);
+    }
+
+    if (CPA_STATUS_INVALID_PARAM == status)
+    {
+        /* Additional input longer than the mechanism accepts */
+        LAC_DRBG_STAT_INC(numGenRequestErrors, pService);
+        return status;
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        LAC_DRBG_STAT_INC(numGenCompleted, pService);
+    }
+    else
+    {
+        osalMemZeroExplicit(pPseudoRandomBits->pData, pOpData->lengthInBytes);
+        LAC_DRBG_STAT_INC(numGenCompletedErrors, pService);
+    }
+
+    /* The operation completes inline, the callback runs before return */
+    if (NULL != pSession->pGenCb)
+    {
+        pSession->pGenCb(pCallbackTag, status, pOpData, pPseudoRandomBits);
+        return CPA_STATUS_SUCCESS;
+    }
+    return status;
 }
 
 /**
@@ -120,7 +700,59 @@ CpaStatus cpaCyDrbgReseed(const CpaInstanceHandle instanceHandle_in,
                           void *pCallbackTag,
                           CpaCyDrbgReseedOpData *pOpData)
 {
-    return CPA_STATUS_UNSUPPORTED;
+    CpaInstanceHandle instanceHandle = LacDrbg_GetInstance(instanceHandle_in);
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+    lac_drbg_session_t *pSession = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    LAC_CHECK_NULL_PARAM(pOpData);
+    LAC_CHECK_NULL_PARAM(pOpData->sessionHandle);
+#endif
+    SAL_RUNNING_CHECK(instanceHandle);
+
+    pSession = (lac_drbg_session_t *)pOpData->sessionHandle;
+    if ((LAC_DRBG_SESSION_MAGIC != pSession->magic) ||
+        ((pOpData->additionalInput.dataLenInBytes > 0) &&
+         (NULL == pOpData->additionalInput.pData)))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid DRBG reseed request");
+        LAC_DRBG_STAT_INC(numReseedRequestErrors, pService);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    LAC_DRBG_STAT_INC(numReseedRequests, pService);
+
+    status = LAC_LOCK_MUTEX(&pSession->lock, OSAL_WAIT_FOREVER);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LacDrbg_SessionReseed(pSession, &pOpData->additionalInput);
+        LAC_UNLOCK_MUTEX(&pSession->lock);
+    }
+
+    if (CPA_STATUS_INVALID_PARAM == status)
+    {
+        LAC_DRBG_STAT_INC(numReseedRequestErrors, pService);
+        return status;
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        LAC_DRBG_STAT_INC(numReseedCompleted, pService);
+    }
+    else
+    {
+        LAC_DRBG_STAT_INC(numReseedCompletedErrors, pService);
+    }
+
+    if (NULL != pSession->pReseedCb)
+    {
+        pSession->pReseedCb(pCallbackTag, status, pOpData);
+        return CPA_STATUS_SUCCESS;
+    }
+    return status;
 }
 
 /**
@@ -129,7 +761,30 @@ CpaStatus cpaCyDrbgReseed(const CpaInstanceHandle instanceHandle_in,
 CpaStatus cpaCyDrbgRemoveSession(const CpaInstanceHandle instanceHandle_in,
                                  CpaCyDrbgSessionHandle sessionHandle)
 {
-    return CPA_STATUS_UNSUPPORTED;
+    CpaInstanceHandle instanceHandle = LacDrbg_GetInstance(instanceHandle_in);
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+    lac_drbg_session_t *pSession = (lac_drbg_session_t *)sessionHandle;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    LAC_CHECK_NULL_PARAM(sessionHandle);
+#endif
+
+    if (LAC_DRBG_SESSION_MAGIC != pSession->magic)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid DRBG session");
+        LAC_DRBG_STAT_INC(numSessionErrors, pService);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    LAC_DESTROY_MUTEX(&pSession->lock);
+    LacDrbg_CtrUninstantiate(&pSession->state);
+    osalMemZeroExplicit(pSession, sizeof(lac_drbg_session_t));
+    LAC_DRBG_STAT_INC(numSessionsRemoved, pService);
+    return CPA_STATUS_SUCCESS;
 }
 
 /**
@@ -138,5 +793,23 @@ CpaStatus cpaCyDrbgRemoveSession(const CpaInstanceHandle instanceHandle_in,
 CpaStatus cpaCyDrbgQueryStats64(const CpaInstanceHandle instanceHandle_in,
                                 CpaCyDrbgStats64 *pStats)
 {
-    return CPA_STATUS_UNSUPPORTED;
+    CpaInstanceHandle instanceHandle = LacDrbg_GetInstance(instanceHandle_in);
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+    Cpa32U i = 0;
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    LAC_CHECK_NULL_PARAM(pStats);
+#endif
+    SAL_RUNNING_CHECK(instanceHandle);
+
+    for (i = 0; i < LAC_DRBG_NUM_STATS; i++)
+    {
+        ((Cpa64U *)pStats)[i] =
+            osalAtomicGet(&pService->pLacDrbgStatsArr[i]);
+    }
+    return CPA_STATUS_SUCCESS;
 }
@@ -0,0 +1,651 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ *****************************************************************************
+ * @file lac_sym_drbg_ctr.c
+ *
+ * @ingroup LacSym_Drbg
+ *
+ * @description
+ *     CTR_DRBG mechanism (NIST SP 800-90A, section 10.2.1) using AES-256
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_cy_drbg.h"
+
+#include "Osal.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_common.h"
+#include "lac_log.h"
+#include "lac_sym_drbg.h"
+
+/**< Output bytes encrypted per key schedule by LacDrbg_CtrGenerate */
+#define LAC_DRBG_GEN_CHUNK_IN_BYTES (4096)
+
+/**< Number of AES blocks in the Block_Cipher_df and update temporaries */
+#define LAC_DRBG_SEED_LEN_IN_BLOCKS                                            \
+    (LAC_DRBG_SEED_LEN_IN_BYTES / LAC_DRBG_BLOCK_LEN_IN_BYTES)
+
+/**< Block_Cipher_df fixed key: 0x00 0x01 ... 0x1F */
+static const Cpa8U lacDrbgDfKey[LAC_DRBG_KEY_LEN_IN_BYTES] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+    0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15,
+    0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f};
+
+/**< One of the strings concatenated into the derivation function input */
+typedef struct lac_drbg_df_input_s
+{
+    const Cpa8U *pData;
+    Cpa32U dataLenInBytes;
+} lac_drbg_df_input_t;
+
+/**< Running BCC (CBC-MAC) over a byte stream */
+typedef struct lac_drbg_bcc_s
+{
+    Cpa8U key[LAC_DRBG_KEY_LEN_IN_BYTES];
+    Cpa8U chain[LAC_DRBG_BLOCK_LEN_IN_BYTES];
+    Cpa8U block[LAC_DRBG_BLOCK_LEN_IN_BYTES];
+    Cpa32U fill;
+} lac_drbg_bcc_t;
+
+/* V = (V + 1) mod 2^128, V big endian */
+STATIC void LacDrbg_IncV(Cpa8U *pV)
+{
+    Cpa32S i = 0;
+
+    for (i = LAC_DRBG_BLOCK_LEN_IN_BYTES - 1; i >= 0; i--)
+    {
+        if (0 != ++pV[i])
+        {
+            break;
+        }
+    }
+}
+
+/* Fill numBlocks blocks of pBuf with E(Key, V + 1), E(Key, V + 2), ...
+ * leaving V at the last counter used. */
+STATIC CpaStatus LacDrbg_CtrBlocks(lac_drbg_ctr_state_t *pState,
+                                   Cpa8U *pBuf,
+                                   Cpa32U numBlocks)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < numBlocks; i++)
+    {
+        LacDrbg_IncV(pState->v);
+        memcpy(pBuf + i * LAC_DRBG_BLOCK_LEN_IN_BYTES,
+               pState->v,
+               LAC_DRBG_BLOCK_LEN_IN_BYTES);
+    }
+    if (OSAL_SUCCESS != osalAESEncryptECB(pState->key,
+                                          LAC_DRBG_KEY_LEN_IN_BYTES,
+                                          pBuf,
+                                          pBuf,
+                                          numBlocks))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/* CTR_DRBG_Update (10.2.1.2) */
+STATIC CpaStatus LacDrbg_Update(lac_drbg_ctr_state_t *pState,
+                                const Cpa8U *pProvidedData)
+{
+    Cpa8U temp[LAC_DRBG_SEED_LEN_IN_BYTES];
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+    status = LacDrbg_CtrBlocks(pState, temp, LAC_DRBG_SEED_LEN_IN_BLOCKS);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        for (i = 0; i < LAC_DRBG_SEED_LEN_IN_BYTES; i++)
+        {
+            temp[i] ^= pProvidedData[i];
+        }
+        memcpy(pState->key, temp, LAC_DRBG_KEY_LEN_IN_BYTES);
+        memcpy(pState->v,
+               temp + LAC_DRBG_KEY_LEN_IN_BYTES,
+               LAC_DRBG_BLOCK_LEN_IN_BYTES);
+    }
+    osalMemZeroExplicit(temp, sizeof(temp));
+    return status;
+}
+
+STATIC CpaStatus LacDrbg_BccUpdate(lac_drbg_bcc_t *pBcc,
+                                   const Cpa8U *pData,
+                                   Cpa32U dataLenInBytes)
+{
+    Cpa32U len = 0;
+    Cpa32U i = 0;
+
+    while (dataLenInBytes > 0)
+    {
+        len = LAC_DRBG_BLOCK_LEN_IN_BYTES - pBcc->fill;
+        if (len > dataLenInBytes)
+        {
+            len = dataLenInBytes;
+        }
+        memcpy(pBcc->block + pBcc->fill, pData, len);
+        pBcc->fill += len;
+        pData += len;
+        dataLenInBytes -= len;
+
+        if (LAC_DRBG_BLOCK_LEN_IN_BYTES == pBcc->fill)
+        {
+            for (i = 0; i < LAC_DRBG_BLOCK_LEN_IN_BYTES; i++)
+            {
+                pBcc->chain[i] ^= pBcc->block[i];
+            }
+            if (OSAL_SUCCESS != osalAESEncrypt(pBcc->key,
+                                               LAC_DRBG_KEY_LEN_IN_BYTES,
+                                               pBcc->chain,
+                                               pBcc->chain))
+            {
+                return CPA_STATUS_FAIL;
+            }
+            pBcc->fill = 0;
+        }
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Block_Cipher_df (10.3.2) returning seedlen bytes, computed over the
+ * concatenation of the numInputs strings without copying them. */
+STATIC CpaStatus LacDrbg_BlockCipherDf(const lac_drbg_df_input_t *pInputs,
+                                       Cpa32U numInputs,
+                                       Cpa8U *pOut)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    lac_drbg_bcc_t bcc;
+    Cpa8U temp[LAC_DRBG_SEED_LEN_IN_BYTES];
+    Cpa8U lenFields[2 * sizeof(Cpa32U)];
+    Cpa8U iv[LAC_DRBG_BLOCK_LEN_IN_BYTES] = {0};
+    static const Cpa8U pad[LAC_DRBG_BLOCK_LEN_IN_BYTES] = {0x80};
+    Cpa32U inputLen = 0;
+    Cpa32U i = 0;
+    Cpa32U j = 0;
+
+    for (j = 0; j < numInputs; j++)
+    {
+        inputLen += pInputs[j].dataLenInBytes;
+    }
+    /* L || N, both 32-bit big endian */
+    lenFields[0] = (Cpa8U)(inputLen >> 24);
+    lenFields[1] = (Cpa8U)(inputLen >> 16);
+    lenFields[2] = (Cpa8U)(inputLen >> 8);
+    lenFields[3] = (Cpa8U)inputLen;
+    lenFields[4] = 0;
+    lenFields[5] = 0;
+    lenFields[6] = 0;
+    lenFields[7] = LAC_DRBG_SEED_LEN_IN_BYTES;
+
+    /* temp = BCC(K, IV_i || S) for i = 0, 1, 2 */
+    for (i = 0; (i < LAC_DRBG_SEED_LEN_IN_BLOCKS) &&
+                (CPA_STATUS_SUCCESS == status);
+         i++)
+    {
+        memset(&bcc, 0, sizeof(bcc));
+        memcpy(bcc.key, lacDrbgDfKey, sizeof(bcc.key));
+        iv[3] = (Cpa8U)i;
+        status = LacDrbg_BccUpdate(&bcc, iv, sizeof(iv));
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = LacDrbg_BccUpdate(&bcc, lenFields, sizeof(lenFields));
+        }
+        for (j = 0; (j < numInputs) && (CPA_STATUS_SUCCESS == status); j++)
+        {
+            status = LacDrbg_BccUpdate(
+                &bcc, pInputs[j].pData, pInputs[j].dataLenInBytes);
+        }
+        /* 0x80 then zero padding up to a whole block */
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = LacDrbg_BccUpdate(
+                &bcc, pad, LAC_DRBG_BLOCK_LEN_IN_BYTES - bcc.fill);
+        }
+        memcpy(temp + i * LAC_DRBG_BLOCK_LEN_IN_BYTES,
+               bcc.chain,
+               LAC_DRBG_BLOCK_LEN_IN_BYTES);
+    }
+
+    /* K = leftmost keylen bits of temp, X = next outlen bits,
+     * output X = E(K, X) repeatedly */
+    for (i = 0; (i < LAC_DRBG_SEED_LEN_IN_BLOCKS) &&
+                (CPA_STATUS_SUCCESS == status);
+         i++)
+    {
+        if (OSAL_SUCCESS !=
+            osalAESEncrypt(temp,
+                           LAC_DRBG_KEY_LEN_IN_BYTES,
+                           (0 == i) ? temp + LAC_DRBG_KEY_LEN_IN_BYTES
+                                    : pOut + (i - 1) *
+                                                 LAC_DRBG_BLOCK_LEN_IN_BYTES,
+                           pOut + i * LAC_DRBG_BLOCK_LEN_IN_BYTES))
+        {
+            status = CPA_STATUS_FAIL;
+        }
+    }
+
+    osalMemZeroExplicit(&bcc, sizeof(bcc));
+    osalMemZeroExplicit(temp, sizeof(temp));
+    return status;
+}
+
+/* Turn an additional input or personalization string into seedlen bytes:
+ * derived when the df is in use, zero padded otherwise. */
+STATIC CpaStatus LacDrbg_SeedLenInput(const lac_drbg_ctr_state_t *pState,
+                                      const Cpa8U *pIn,
+                                      Cpa32U inLen,
+                                      Cpa8U *pOut)
+{
+    lac_drbg_df_input_t input;
+
+    if (CPA_TRUE == pState->useDf)
+    {
+        if (inLen > LAC_DRBG_MAX_INPUT_IN_BYTES)
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        input.pData = pIn;
+        input.dataLenInBytes = inLen;
+        return LacDrbg_BlockCipherDf(&input, 1, pOut);
+    }
+
+    if (inLen > LAC_DRBG_SEED_LEN_IN_BYTES)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    memset(pOut, 0, LAC_DRBG_SEED_LEN_IN_BYTES);
+    if (inLen > 0)
+    {
+        memcpy(pOut, pIn, inLen);
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Shared by instantiate and reseed: seed_material is
+ * entropy || nonce || extra through the df, or entropy XOR extra. */
+STATIC CpaStatus LacDrbg_Seed(lac_drbg_ctr_state_t *pState,
+                              const Cpa8U *pEntropy,
+                              Cpa32U entropyLen,
+                              const Cpa8U *pNonce,
+                              Cpa32U nonceLen,
+                              const Cpa8U *pExtra,
+                              Cpa32U extraLen)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa8U seed[LAC_DRBG_SEED_LEN_IN_BYTES];
+    lac_drbg_df_input_t inputs[3];
+    Cpa32U i = 0;
+
+    if (CPA_TRUE == pState->useDf)
+    {
+        if ((0 == entropyLen) || (entropyLen > LAC_DRBG_MAX_INPUT_IN_BYTES) ||
+            (nonceLen > LAC_DRBG_MAX_INPUT_IN_BYTES) ||
+            (extraLen > LAC_DRBG_MAX_INPUT_IN_BYTES))
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        inputs[0].pData = pEntropy;
+        inputs[0].dataLenInBytes = entropyLen;
+        inputs[1].pData = pNonce;
+        inputs[1].dataLenInBytes = nonceLen;
+        inputs[2].pData = pExtra;
+        inputs[2].dataLenInBytes = extraLen;
+        status = LacDrbg_BlockCipherDf(inputs, 3, seed);
+    }
+    else
+    {
+        /* Full entropy input of seedlen bits is required */
+        if (LAC_DRBG_SEED_LEN_IN_BYTES != entropyLen)
+        {
+            return CPA_STATUS_INVALID_PARAM;
+        }
+        status = LacDrbg_SeedLenInput(pState, pExtra, extraLen, seed);
+        for (i = 0; i < LAC_DRBG_SEED_LEN_IN_BYTES; i++)
+        {
+            seed[i] ^= pEntropy[i];
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LacDrbg_Update(pState, seed);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pState->reseedCounter = 1;
+    }
+    osalMemZeroExplicit(seed, sizeof(seed));
+    return status;
+}
+
+CpaStatus LacDrbg_CtrInstantiate(lac_drbg_ctr_state_t *pState,
+                                 CpaBoolean useDf,
+                                 const Cpa8U *pEntropy,
+                                 Cpa32U entropyLen,
+                                 const Cpa8U *pNonce,
+                                 Cpa32U nonceLen,
+                                 const Cpa8U *pPers,
+                                 Cpa32U persLen)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    LAC_ENSURE_NOT_NULL(pState);
+    LAC_ENSURE_NOT_NULL(pEntropy);
+
+    memset(pState, 0, sizeof(*pState));
+    pState->useDf = useDf;
+
+    status = LacDrbg_Seed(pState,
+                          pEntropy,
+                          entropyLen,
+                          pNonce,
+                          (CPA_TRUE == useDf) ? nonceLen : 0,
+                          pPers,
+                          persLen);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LacDrbg_CtrUninstantiate(pState);
+    }
+    return status;
+}
+
+CpaStatus LacDrbg_CtrReseed(lac_drbg_ctr_state_t *pState,
+                            const Cpa8U *pEntropy,
+                            Cpa32U entropyLen,
+                            const Cpa8U *pAddIn,
+                            Cpa32U addInLen)
+{
+    LAC_ENSURE_NOT_NULL(pState);
+    LAC_ENSURE_NOT_NULL(pEntropy);
+
+    return LacDrbg_Seed(
+        pState, pEntropy, entropyLen, NULL, 0, pAddIn, addInLen);
+}
+
+CpaStatus LacDrbg_CtrGenerate(lac_drbg_ctr_state_t *pState,
+                              const Cpa8U *pAddIn,
+                              Cpa32U addInLen,
+                              Cpa8U *pOut,
+                              Cpa32U outLen)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa8U addIn[LAC_DRBG_SEED_LEN_IN_BYTES] = {0};
+    Cpa8U buf[LAC_DRBG_GEN_CHUNK_IN_BYTES];
+    /* Whole blocks of buf written, to be wiped on return */
+    Cpa32U bufUsed = LAC_ALIGN_POW2_ROUNDUP(
+        (outLen > sizeof(buf)) ? sizeof(buf) : outLen,
+        LAC_DRBG_BLOCK_LEN_IN_BYTES);
+    Cpa32U len = 0;
+
+    LAC_ENSURE_NOT_NULL(pState);
+    LAC_ENSURE_NOT_NULL(pOut);
+
+    if (outLen > LAC_DRBG_MAX_REQUEST_IN_BYTES)
+    {
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (addInLen > 0)
+    {
+        status = LacDrbg_SeedLenInput(pState, pAddIn, addInLen, addIn);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = LacDrbg_Update(pState, addIn);
+        }
+    }
+
+    while ((outLen > 0) && (CPA_STATUS_SUCCESS == status))
+    {
+        len = (outLen > sizeof(buf)) ? sizeof(buf) : outLen;
+        status = LacDrbg_CtrBlocks(
+            pState,
+            buf,
+            (len + LAC_DRBG_BLOCK_LEN_IN_BYTES - 1) /
+                LAC_DRBG_BLOCK_LEN_IN_BYTES);
+        memcpy(pOut, buf, len);
+        pOut += len;
+        outLen -= len;
+    }
+
+    /* Backtracking resistance: always move the key on */
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = LacDrbg_Update(pState, addIn);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pState->reseedCounter++;
+    }
+
+    osalMemZeroExplicit(buf, bufUsed);
+    osalMemZeroExplicit(addIn, sizeof(addIn));
+    return status;
+}
+
+void LacDrbg_CtrUninstantiate(lac_drbg_ctr_state_t *pState)
+{
+    osalMemZeroExplicit(pState, sizeof(*pState));
+}
+
+/*
+*******************************************************************************
+* Known answer tests
+*
+* Inputs are byte ramps: entropy 0x00.., reseed entropy 0x20.., nonce 0xa0..,
+* personalization 0x80.., additional input 0x40.. for the reseed and first
+* generate and 0xc0.. for the second generate. Each test instantiates,
+* optionally reseeds, generates 64 bytes twice and checks the second output.
+*******************************************************************************
+*/
+#define LAC_DRBG_KAT_OUT_LEN_IN_BYTES (64)
+#define LAC_DRBG_KAT_NONCE_LEN_IN_BYTES (16)
+#define LAC_DRBG_NUM_KATS (sizeof(lacDrbgKats) / sizeof(lacDrbgKats[0]))
+
+typedef struct lac_drbg_kat_s
+{
+    CpaBoolean useDf;
+    CpaBoolean reseed;
+    const Cpa8U *pExpected;
+} lac_drbg_kat_t;
+
+static const Cpa8U lacDrbgKatDfNoReseed[LAC_DRBG_KAT_OUT_LEN_IN_BYTES] = {
+    0x3c, 0xe2, 0xa3, 0x53, 0xe3, 0x57, 0x59, 0xc8,
+    0x69, 0x0d, 0x6a, 0xc5, 0xa6, 0xd6, 0x85, 0x90,
+    0x05, 0x2d, 0x78, 0x0e, 0xcf, 0xdd, 0x22, 0xc5,
+    0xc5, 0xd9, 0x73, 0x3c, 0x25, 0xf0, 0xf4, 0xf8,
+    0x54, 0x3b, 0xcf, 0xfb, 0xae, 0xb3, 0x53, 0xb4,
+    0x56, 0x02, 0xde, 0x10, 0x6d, 0x5d, 0xda, 0xbf,
+    0x15, 0x11, 0xdd, 0x42, 0xbf, 0xdc, 0x7a, 0x55,
+    0xd8, 0xbe, 0xeb, 0x59, 0x62, 0x3b, 0x56, 0x05};
+
+static const Cpa8U lacDrbgKatDfReseed[LAC_DRBG_KAT_OUT_LEN_IN_BYTES] = {
+    0x09, 0x37, 0x3e, 0x70, 0x7e, 0x8e, 0x96, 0xb1,
+    0x3f, 0xba, 0x64, 0xa8, 0x1c, 0x05, 0x9f, 0xaa,
+    0x7c, 0x92, 0x5f, 0x87, 0x0a, 0xe1, 0x12, 0x85,
+    0x41, 0xd5, 0x83, 0xfe, 0xe4, 0x27, 0x93, 0x04,
+    0x49, 0xab, 0xfe, 0x0c, 0xf0, 0x17, 0x9a, 0x89,
+    0x72, 0x74, 0x81, 0x4b, 0x63, 0xe3, 0xe0, 0x8e,
+    0x11, 0xb9, 0xee, 0x7b, 0x71, 0x41, 0xf3, 0x02,
+    0xcc, 0x2c, 0x28, 0x14, 0xd0, 0xf9, 0x09, 0x66};
+
+static const Cpa8U lacDrbgKatNoDfNoReseed[LAC_DRBG_KAT_OUT_LEN_IN_BYTES] = {
+    0x65, 0x4d, 0xb8, 0xe1, 0xcc, 0x56, 0x87, 0x3a,
+    0x45, 0x2a, 0x3e, 0x3e, 0x24, 0x09, 0x8f, 0x07,
+    0x4c, 0x57, 0x92, 0x77, 0xe3, 0x11, 0xeb, 0x87,
+    0xec, 0xa3, 0x53, 0x0c, 0x35, 0x30, 0xbf, 0xa9,
+    0xaa, 0x13, 0xff, 0x0e, 0x03, 0xc8, 0x4b, 0x37,
+    0x98, 0xbd, 0x61, 0x50, 0x0b, 0x82, 0xf0, 0x5d,
+    0x5c, 0xa7, 0x82, 0xa9, 0x88, 0x1f, 0xff, 0xdf,
+    0xac, 0x9d, 0x78, 0x44, 0x77, 0xb1, 0x13, 0xd8};
+
+static const Cpa8U lacDrbgKatNoDfReseed[LAC_DRBG_KAT_OUT_LEN_IN_BYTES] = {
+    0x53, 0xa3, 0xd4, 0xab, 0x4d, 0x13, 0xc0, 0x16,
+    0x5e, 0xc5, 0xbe, 0x85, 0x0e, 0xfc, 0x47, 0x07,
+    0xde, 0x83, 0x94, 0x39, 0x3f, 0x76, 0xef, 0xe6,
+    0xa0, 0x81, 0xb8, 0x60, 0x92, 0xbe, 0x5d, 0x17,
+    0x73, 0x4a, 0x67, 0x34, 0x1b, 0xdc, 0x56, 0xe3,
+    0xb0, 0x45, 0x60, 0xb5, 0xa6, 0x56, 0xb7, 0x67,
+    0x19, 0x19, 0x6b, 0xd5, 0xf6, 0x89, 0xdf, 0xf2,
+    0xb9, 0x32, 0x2e, 0x14, 0xac, 0xb9, 0x6b, 0x62};
+
+static const lac_drbg_kat_t lacDrbgKats[] = {
+    {CPA_TRUE, CPA_FALSE, lacDrbgKatDfNoReseed},
+    {CPA_TRUE, CPA_TRUE, lacDrbgKatDfReseed},
+    {CPA_FALSE, CPA_FALSE, lacDrbgKatNoDfNoReseed},
+    {CPA_FALSE, CPA_TRUE, lacDrbgKatNoDfReseed}};
+
+STATIC void LacDrbg_KatRamp(Cpa8U *pBuf, Cpa32U len, Cpa8U start)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < len; i++)
+    {
+        pBuf[i] = (Cpa8U)(start + i);
+    }
+}
+
+CpaStatus LacDrbg_CtrSelfTest(void)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    lac_drbg_ctr_state_t state;
+    Cpa8U entropy[LAC_DRBG_SEED_LEN_IN_BYTES];
+    Cpa8U reseedEntropy[LAC_DRBG_SEED_LEN_IN_BYTES];
+    Cpa8U nonce[LAC_DRBG_KAT_NONCE_LEN_IN_BYTES];
+    Cpa8U pers[LAC_DRBG_SEED_LEN_IN_BYTES];
+    Cpa8U addIn1[LAC_DRBG_SEED_LEN_IN_BYTES];
+    Cpa8U addIn2[LAC_DRBG_SEED_LEN_IN_BYTES];
+    Cpa8U out[LAC_DRBG_KAT_OUT_LEN_IN_BYTES];
+    Cpa32U entropyLen = 0;
+    Cpa32U i = 0;
+
+    LacDrbg_KatRamp(entropy, sizeof(entropy), 0x00);
+    LacDrbg_KatRamp(reseedEntropy, sizeof(reseedEntropy), 0x20);
+    LacDrbg_KatRamp(nonce, sizeof(nonce), 0xa0);
+    LacDrbg_KatRamp(pers, sizeof(pers), 0x80);
+    LacDrbg_KatRamp(addIn1, sizeof(addIn1), 0x40);
+    LacDrbg_KatRamp(addIn2, sizeof(addIn2), 0xc0);
+
+    for (i = 0; (i < LAC_DRBG_NUM_KATS) &&
+                (CPA_STATUS_SUCCESS == status);
+         i++)
+    {
+        /* security strength bits with the df, seedlen bits without */
+        entropyLen = (CPA_TRUE == lacDrbgKats[i].useDf)
+                         ? LAC_DRBG_KEY_LEN_IN_BYTES
+                         : LAC_DRBG_SEED_LEN_IN_BYTES;
+
+        status = LacDrbg_CtrInstantiate(&state,
+                                        lacDrbgKats[i].useDf,
+                                        entropy,
+                                        entropyLen,
+                                        nonce,
+                                        sizeof(nonce),
+                                        pers,
+                                        sizeof(pers));
+        if ((CPA_STATUS_SUCCESS == status) &&
+            (CPA_TRUE == lacDrbgKats[i].reseed))
+        {
+            status = LacDrbg_CtrReseed(
+                &state, reseedEntropy, entropyLen, addIn1, sizeof(addIn1));
+        }
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = LacDrbg_CtrGenerate(
+                &state, addIn1, sizeof(addIn1), out, sizeof(out));
+        }
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = LacDrbg_CtrGenerate(
+                &state, addIn2, sizeof(addIn2), out, sizeof(out));
+        }
+        if ((CPA_STATUS_SUCCESS == status) &&
+            (0 != memcmp(out, lacDrbgKats[i].pExpected, sizeof(out))))
+        {
+            status = CPA_STATUS_FAIL;
+        }
+        LacDrbg_CtrUninstantiate(&state);
+    }
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_LOG_ERROR1("DRBG known answer test %u failed\n", i - 1);
+        status = CPA_STATUS_FAIL;
+    }
+    osalMemZeroExplicit(out, sizeof(out));
+    return status;
+}
@@ -98,21 +98,30 @@
  * <b>LAC Perform </b>\n
  * The address for the session descriptor is got by dereferencing the first
  * bytes of the session memory (size of void *). For each successful
- * request put on the ring, the pendingCbCount for the session is incremented.
+ * request put on the ring, the pendingCb count for the session is
+ * incremented.
  *
  * <b>LAC Callback </b>\n
- * For each successful response the pendingCbCount for the session is
+ * For each successful response the pendingCb count for the session is
  * decremented. See \ref LacSymCb_ProcessCallbackInternal()
  *
  * <b>LAC Session Remove </b>\n
  * The address for the session descriptor is got by dereferencing the first
  * bytes of the session memory (size of void *).
- * The pendingCbCount for the session is checked to see if it is 0. If it is
+ * The pendingCb count for the session is checked to see if it is 0. If it is
  * non 0 then there are requests in flight. An error is returned to the user.
  *
  * <b>Concurrency</b>\n
  * A reference count is used to prevent the descriptor being removed
- * while there are requests in flight.
+ * while there are requests in flight. The same count guards session
+ * updates: the perform function takes its reference before reading the
+ * session, and the update function first sets updateInProgress and then
+ * checks the count is 0. Perform takes no lock; if it finds an update in
+ * progress it drops its reference and waits for the update to finish.
+ * The count is spread over per CPU counters (pendingCb), each on its own
+ * cache line, so that performs and callbacks on different CPUs do not
+ * write the same line. A request may be counted on one CPU and its
+ * response on another, so only the sum of the counters is meaningful.
  *
  * <b>Reference Count</b>\n
  * - The perform function increments the reference count for the session.
@@ -183,6 +192,31 @@ typedef enum lac_single_pass_state_e
     SPC_YES
 } lac_single_pass_state_t;
 
+#define LAC_SYM_SESSION_PENDING_CB_STRIPES (8)
+/**< @ingroup LacSym_Session
+ * Number of per CPU counters the pending requests of a session are counted
+ * on. CPUs beyond this number share the counters. */
+
+/**
+*******************************************************************************
+* @ingroup LacSym_Session
+*      Per CPU pending request counter
+*
+* @description
+*      One of the counters of the pending requests of a session. It is
+*      padded to a cache line so that counters of different CPUs do not
+*      share one. It can go negative when responses are counted on another
+*      CPU than their requests.
+*
+*****************************************************************************/
+typedef struct lac_session_pending_cb_s
+{
+    OsalAtomic count;
+    /**< Requests sent less responses received on this counter */
+    Cpa8U reserved[LAC_64BYTE_ALIGNMENT - sizeof(OsalAtomic)];
+    /**< Padding to the end of the cache line */
+} lac_session_pending_cb_t;
+
 /**
 *******************************************************************************
 * @ingroup LacSym_Session
@@ -243,27 +277,23 @@ typedef struct lac_session_desc_s
     CpaCySymCbFunc pSymCb;
     /**< symmetric function callback pointer */
     union {
-        OsalAtomic pendingCbCount;
-        /**< Keeps track of number of pending requests.  */
+        lac_session_pending_cb_t pendingCb[LAC_SYM_SESSION_PENDING_CB_STRIPES];
+        /**< Keeps track of number of pending requests, see
+         * LacSymSession_PendingCbGet() */
         Cpa64U pendingDpCbCount;
         /**< Keeps track of number of pending DP requests (not thread safe)*/
     } u;
     struct lac_sym_bulk_cookie_s *pRequestQueueHead;
-    /**< A fifo list of queued QAT requests. Head points to first queue entry */
-    struct lac_sym_bulk_cookie_s *pRequestQueueTail;
-    /**< A fifo list of queued QAT requests. Tail points to last queue entry */
-    lac_lock_t requestQueueLock;
-    /**< A lock to protect accesses to the above request queue  */
+    /**< A fifo list of queued QAT requests taken from requestQueueIn. Only
+     * accessed by the owner of the request queue */
+    OsalAtomic requestQueueIn;
+    /**< Lock-free lifo list of requests queued while a blocking operation
+     * (partial packet or hash precompute) is in flight. The low bit is set
+     * while the queue has an owner, see lac_sym_queue.h */
     CpaInstanceHandle pInstance;
     /**< Pointer to Crypto instance running this session. */
     CpaBoolean isAuthEncryptOp : 1;
     /**< if the algorithm chaining operation is auth encrypt */
-    CpaBoolean nonBlockingOpsInProgress : 1;
-    /**< Flag is set if a non blocking operation is in progress for a session.
-     * If set to false, new requests will be queued until the condition is
-     * cleared.
-     * ASSUMPTION: Only one blocking condition per session can exist at any time
-     */
     CpaBoolean internalSession : 1;
     /**< Flag which is set if the session was set up internally for DRBG */
     CpaBoolean isDPSession : 1;
@@ -282,6 +312,9 @@ typedef struct lac_session_desc_s
     /**< Flag indicating whether the SymConstantsTable can be used or not */
     CpaBoolean useOptimisedContentDesc : 1;
     /**< Flag indicating whether to use the optimised CD or not */
+    CpaBoolean isHighPriority : 1;
+    /**< Flag indicating whether requests are sent on the high priority
+     * ring pair of the instance */
     icp_qat_la_bulk_req_hdr_t shramReqCacheHdr;
     icp_qat_fw_la_key_gen_common_t shramReqCacheMid;
     icp_qat_la_bulk_req_ftr_t shramReqCacheFtr;
@@ -308,10 +341,8 @@ typedef struct lac_session_desc_s
      */
     void *writeRingMsgFunc;
     /**< function which will be called to write ring message */
-    OsalAtomic accessLock;
-    /**< Session access lock */
-    Cpa32U accessReaders;
-    /**< Session readers counter */
+    OsalAtomic updateInProgress;
+    /**< Non zero while cpaCySymUpdateSession rewrites the session */
     lac_single_pass_state_t singlePassState;
     /**< Flag indicating whether symOperation support single pass */
     icp_qat_fw_serv_specif_flags laCmdFlags;
@@ -415,27 +446,23 @@ typedef struct lac_session_desc_d1_s
     CpaCySymCbFunc pSymCb;
     /**< symmetric function callback pointer */
     union {
-        OsalAtomic pendingCbCount;
-        /**< Keeps track of number of pending requests.  */
+        lac_session_pending_cb_t pendingCb[LAC_SYM_SESSION_PENDING_CB_STRIPES];
+        /**< Keeps track of number of pending requests, see
+         * LacSymSession_PendingCbGet() */
         Cpa64U pendingDpCbCount;
         /**< Keeps track of number of pending DP requests (not thread safe)*/
     } u;
     struct lac_sym_bulk_cookie_s *pRequestQueueHead;
-    /**< A fifo list of queued QAT requests. Head points to first queue entry */
-    struct lac_sym_bulk_cookie_s *pRequestQueueTail;
-    /**< A fifo list of queued QAT requests. Tail points to last queue entry */
-    lac_lock_t requestQueueLock;
-    /**< A lock to protect accesses to the above request queue  */
+    /**< A fifo list of queued QAT requests taken from requestQueueIn. Only
+     * accessed by the owner of the request queue */
+    OsalAtomic requestQueueIn;
+    /**< Lock-free lifo list of requests queued while a blocking operation
+     * (partial packet or hash precompute) is in flight. The low bit is set
+     * while the queue has an owner, see lac_sym_queue.h */
     CpaInstanceHandle pInstance;
     /**< Pointer to Crypto instance running this session. */
     CpaBoolean isAuthEncryptOp : 1;
     /**< if the algorithm chaining operation is auth encrypt */
-    CpaBoolean nonBlockingOpsInProgress : 1;
-    /**< Flag is set if a non blocking operation is in progress for a session.
-     * If set to false, new requests will be queued until the condition is
-     * cleared.
-     * ASSUMPTION: Only one blocking condition per session can exist at any time
-     */
     CpaBoolean internalSession : 1;
     /**< Flag which is set if the session was set up internally for DRBG */
     CpaBoolean isDPSession : 1;
@@ -454,6 +481,9 @@ typedef struct lac_session_desc_d1_s
     /**< Flag indicating whether the SymConstantsTable can be used or not */
     CpaBoolean useOptimisedContentDesc : 1;
     /**< Flag indicating whether to use the optimised CD or not */
+    CpaBoolean isHighPriority : 1;
+    /**< Flag indicating whether requests are sent on the high priority
+     * ring pair of the instance */
     icp_qat_la_bulk_req_hdr_t shramReqCacheHdr;
     icp_qat_fw_la_key_gen_common_t shramReqCacheMid;
     icp_qat_la_bulk_req_ftr_t shramReqCacheFtr;
@@ -480,10 +510,8 @@ typedef struct lac_session_desc_d1_s
      */
     void *writeRingMsgFunc;
     /**< function which will be called to write ring message */
-    OsalMutex accessLock;
-    /**< Session access lock */
-    Cpa32U accessReaders;
-    /**< Session readers counter */
+    OsalAtomic updateInProgress;
+    /**< Non zero while cpaCySymUpdateSession rewrites the session */
     lac_single_pass_state_t singlePassState;
     /**< Flag indicating whether symOperation support single pass */
     icp_qat_fw_serv_specif_flags laCmdFlags;
@@ -554,27 +582,23 @@ typedef struct lac_session_desc_d2_s
     CpaCySymCbFunc pSymCb;
     /**< symmetric function callback pointer */
     union {
-        OsalAtomic pendingCbCount;
-        /**< Keeps track of number of pending requests.  */
+        lac_session_pending_cb_t pendingCb[LAC_SYM_SESSION_PENDING_CB_STRIPES];
+        /**< Keeps track of number of pending requests, see
+         * LacSymSession_PendingCbGet() */
         Cpa64U pendingDpCbCount;
         /**< Keeps track of number of pending DP requests (not thread safe)*/
     } u;
     struct lac_sym_bulk_cookie_s *pRequestQueueHead;
-    /**< A fifo list of queued QAT requests. Head points to first queue entry */
-    struct lac_sym_bulk_cookie_s *pRequestQueueTail;
-    /**< A fifo list of queued QAT requests. Tail points to last queue entry */
-    lac_lock_t requestQueueLock;
-    /**< A lock to protect accesses to the above request queue  */
+    /**< A fifo list of queued QAT requests taken from requestQueueIn. Only
+     * accessed by the owner of the request queue */
+    OsalAtomic requestQueueIn;
+    /**< Lock-free lifo list of requests queued while a blocking operation
+     * (partial packet or hash precompute) is in flight. The low bit is set
+     * while the queue has an owner, see lac_sym_queue.h */
     CpaInstanceHandle pInstance;
     /**< Pointer to Crypto instance running this session. */
     CpaBoolean isAuthEncryptOp : 1;
     /**< if the algorithm chaining operation is auth encrypt */
-    CpaBoolean nonBlockingOpsInProgress : 1;
-    /**< Flag is set if a non blocking operation is in progress for a session.
-     * If set to false, new requests will be queued until the condition is
-     * cleared.
-     * ASSUMPTION: Only one blocking condition per session can exist at any time
-     */
     CpaBoolean internalSession : 1;
     /**< Flag which is set if the session was set up internally for DRBG */
     CpaBoolean isDPSession : 1;
@@ -593,6 +617,9 @@ typedef struct lac_session_desc_d2_s
     /**< Flag indicating whether the SymConstantsTable can be used or not */
     CpaBoolean useOptimisedContentDesc : 1;
     /**< Flag indicating whether to use the optimised CD or not */
+    CpaBoolean isHighPriority : 1;
+    /**< Flag indicating whether requests are sent on the high priority
+     * ring pair of the instance */
     icp_qat_la_bulk_req_hdr_t shramReqCacheHdr;
     icp_qat_fw_la_key_gen_common_t shramReqCacheMid;
     icp_qat_la_bulk_req_ftr_t shramReqCacheFtr;
@@ -619,10 +646,8 @@ typedef struct lac_session_desc_d2_s
      */
     void *writeRingMsgFunc;
     /**< function which will be called to write ring message */
-    OsalMutex accessLock;
-    /**< Session access lock */
-    Cpa32U accessReaders;
-    /**< Session readers counter */
+    OsalAtomic updateInProgress;
+    /**< Non zero while cpaCySymUpdateSession rewrites the session */
     lac_single_pass_state_t singlePassState;
     /**< Flag indicating whether symOperation support single pass */
     icp_qat_fw_serv_specif_flags laCmdFlags;
@@ -680,6 +705,78 @@ typedef struct lac_session_desc_d2_s
  * that the user allocates. The pointer to the internally realigned address
  * is stored at the start of the session context that the user allocates */
 
+/**
+*******************************************************************************
+* @ingroup LacSym_Session
+*      Pending request counter of the current CPU
+*
+* @description
+*      Returns the counter which a request sent, or a response received, on
+*      the current CPU is counted on. A caller which undoes its own count
+*      must use the same counter again, even if it has moved CPU since.
+*
+* @param[in] pSessionDesc   Session descriptor
+*
+* @return the counter to increment or decrement
+*
+*****************************************************************************/
+static inline OsalAtomic *LacSymSession_PendingCbCounter(
+    lac_session_desc_t *pSessionDesc)
+{
+    return &(pSessionDesc->u
+                 .pendingCb[osalGetCurrentCpu() %
+                            LAC_SYM_SESSION_PENDING_CB_STRIPES]
+                 .count);
+}
+
+/**
+*******************************************************************************
+* @ingroup LacSym_Session
+*      Number of pending requests of a session
+*
+* @description
+*      Sums the per CPU counters of a non data plane session. The sum is not
+*      a snapshot: it is exact when no request is sent concurrently, and it
+*      never misses a request that was counted before the call started.
+*
+* @param[in] pSessionDesc   Session descriptor
+*
+* @return the number of requests sent on the session whose response has
+*         not been processed
+*
+*****************************************************************************/
+static inline Cpa64S LacSymSession_PendingCbGet(
+    lac_session_desc_t *pSessionDesc)
+{
+    Cpa64S pending = 0;
+    Cpa32U i;
+
+    for (i = 0; i < LAC_SYM_SESSION_PENDING_CB_STRIPES; i++)
+    {
+        pending += osalAtomicGet(&(pSessionDesc->u.pendingCb[i].count));
+    }
+    return pending;
+}
+
+/**
+*******************************************************************************
+* @ingroup LacSym_Session
+*      Reset the pending request counters of a session
+*
+* @param[in] pSessionDesc   Session descriptor
+*
+*****************************************************************************/
+static inline void LacSymSession_PendingCbReset(
+    lac_session_desc_t *pSessionDesc)
+{
+    Cpa32U i;
+
+    for (i = 0; i < LAC_SYM_SESSION_PENDING_CB_STRIPES; i++)
+    {
+        osalAtomicSet(0, &(pSessionDesc->u.pendingCb[i].count));
+    }
+}
+
 /**
 *******************************************************************************
 * @ingroup LacSym_Session
@@ -0,0 +1,261 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ ***************************************************************************
+ * @file lac_sym_drbg.h
+ *
+ * @defgroup LacSym_Drbg Deterministic Random Bit Generation
+ *
+ * @ingroup LacSym
+ *
+ * Software CTR_DRBG (NIST SP 800-90A) used by the cpaCyDrbg API
+ *
+ * @lld_start
+ * @lld_overview
+ * The mechanism is CTR_DRBG with AES-256 and a 128-bit counter, with or
+ * without the Block_Cipher_df derivation function. The working state is
+ * held in the client allocated session memory. AES is done in software
+ * through the OSAL; the blocks of one generate request are encrypted
+ * under a single key schedule. The known answer tests are run each time
+ * a symmetric instance is started.
+ * @lld_end
+ *
+ ***************************************************************************/
+
+#ifndef LAC_SYM_DRBG_H
+#define LAC_SYM_DRBG_H
+
+#include "cpa.h"
+#include "cpa_cy_drbg.h"
+
+#define LAC_DRBG_KEY_LEN_IN_BYTES (32)
+/**< AES-256 key length */
+#define LAC_DRBG_BLOCK_LEN_IN_BYTES (16)
+/**< AES block length, also the length of V */
+#define LAC_DRBG_SEED_LEN_IN_BYTES                                             \
+    (LAC_DRBG_KEY_LEN_IN_BYTES + LAC_DRBG_BLOCK_LEN_IN_BYTES)
+/**< seedlen of CTR_DRBG with AES-256 */
+#define LAC_DRBG_MAX_REQUEST_IN_BYTES (1 << 16)
+/**< Maximum number of bytes produced by one generate call (2^19 bits) */
+#define LAC_DRBG_MAX_INPUT_IN_BYTES (1 << 16)
+/**< Maximum length of entropy input, personalization string and
+ * additional input when the derivation function is used */
+#define LAC_DRBG_RESEED_INTERVAL (1 << 16)
+/**< Number of generate calls after which the state is reseeded */
+
+/**
+ *****************************************************************************
+ * @ingroup LacSym_Drbg
+ *      CTR_DRBG working state
+ *
+ *****************************************************************************/
+typedef struct lac_drbg_ctr_state_s
+{
+    Cpa8U key[LAC_DRBG_KEY_LEN_IN_BYTES];
+    Cpa8U v[LAC_DRBG_BLOCK_LEN_IN_BYTES];
+    Cpa64U reseedCounter;
+    /**< Generate calls since the last (re)seed, plus one */
+    CpaBoolean useDf;
+    /**< Block_Cipher_df is applied to all inputs */
+} lac_drbg_ctr_state_t;
+
+/**
+ ******************************************************************************
+ * @ingroup LacSym_Drbg
+ *      Instantiate a CTR_DRBG state
+ *
+ * @description
+ *      Without derivation function the entropy input must be exactly
+ *      LAC_DRBG_SEED_LEN_IN_BYTES of full entropy, the nonce is ignored
+ *      and the personalization string is at most that length.
+ *
+ * @param[out] pState           State to instantiate
+ * @param[in]  useDf            Use the derivation function
+ * @param[in]  pEntropy         Entropy input
+ * @param[in]  entropyLen       Entropy input length
+ * @param[in]  pNonce           Nonce, may be NULL when nonceLen is 0
+ * @param[in]  nonceLen         Nonce length
+ * @param[in]  pPers            Personalization string, may be NULL
+ * @param[in]  persLen          Personalization string length
+ *
+ * @retval CPA_STATUS_SUCCESS       Success
+ * @retval CPA_STATUS_INVALID_PARAM An input length is not supported
+ * @retval CPA_STATUS_FAIL          AES failed
+ *
+ *****************************************************************************/
+CpaStatus LacDrbg_CtrInstantiate(lac_drbg_ctr_state_t *pState,
+                                 CpaBoolean useDf,
+                                 const Cpa8U *pEntropy,
+                                 Cpa32U entropyLen,
+                                 const Cpa8U *pNonce,
+                                 Cpa32U nonceLen,
+                                 const Cpa8U *pPers,
+                                 Cpa32U persLen);
+
+/**
+ ******************************************************************************
+ * @ingroup LacSym_Drbg
+ *      Reseed a CTR_DRBG state
+ *
+ * @param[in,out] pState        Instantiated state
+ * @param[in]     pEntropy      Entropy input
+ * @param[in]     entropyLen    Entropy input length
+ * @param[in]     pAddIn        Additional input, may be NULL
+ * @param[in]     addInLen      Additional input length
+ *
+ * @retval CPA_STATUS_SUCCESS       Success
+ * @retval CPA_STATUS_INVALID_PARAM An input length is not supported
+ * @retval CPA_STATUS_FAIL          AES failed
+ *
+ *****************************************************************************/
+CpaStatus LacDrbg_CtrReseed(lac_drbg_ctr_state_t *pState,
+                            const Cpa8U *pEntropy,
+                            Cpa32U entropyLen,
+                            const Cpa8U *pAddIn,
+                            Cpa32U addInLen);
+
+/**
+ ******************************************************************************
+ * @ingroup LacSym_Drbg
+ *      Generate pseudorandom bytes
+ *
+ * @description
+ *      Runs the CTR_DRBG generate process for at most
+ *      LAC_DRBG_MAX_REQUEST_IN_BYTES. The caller is responsible for
+ *      reseeding once reseedCounter exceeds LAC_DRBG_RESEED_INTERVAL.
+ *
+ * @param[in,out] pState        Instantiated state
+ * @param[in]     pAddIn        Additional input, may be NULL
+ * @param[in]     addInLen      Additional input length
+ * @param[out]    pOut          Output buffer
+ * @param[in]     outLen        Number of bytes to generate
+ *
+ * @retval CPA_STATUS_SUCCESS       Success
+ * @retval CPA_STATUS_INVALID_PARAM An input length is not supported
+ * @retval CPA_STATUS_FAIL          AES failed
+ *
+ *****************************************************************************/
+CpaStatus LacDrbg_CtrGenerate(lac_drbg_ctr_state_t *pState,
+                              const Cpa8U *pAddIn,
+                              Cpa32U addInLen,
+                              Cpa8U *pOut,
+                              Cpa32U outLen);
+
+/**
+ ******************************************************************************
+ * @ingroup LacSym_Drbg
+ *      Zeroize a CTR_DRBG state
+ *
+ *****************************************************************************/
+void LacDrbg_CtrUninstantiate(lac_drbg_ctr_state_t *pState);
+
+/**
+ ******************************************************************************
+ * @ingroup LacSym_Drbg
+ *      Run the CTR_DRBG known answer tests
+ *
+ * @description
+ *      Instantiate, reseed and generate with and without derivation
+ *      function are checked against fixed vectors.
+ *
+ * @retval CPA_STATUS_SUCCESS   All tests passed
+ * @retval CPA_STATUS_FAIL      A test failed
+ *
+ *****************************************************************************/
+CpaStatus LacDrbg_CtrSelfTest(void);
+
+/**
+ ******************************************************************************
+ * @ingroup LacSym_Drbg
+ *      Initialise DRBG for a crypto instance
+ *
+ * @description
+ *      Runs the known answer tests and allocates the statistics.
+ *
+ * @param[in] instanceHandle    Crypto service handle
+ *
+ * @retval CPA_STATUS_SUCCESS   Success
+ * @retval CPA_STATUS_FAIL      Self test failed
+ * @retval CPA_STATUS_RESOURCE  Allocation failed
+ *
+ *****************************************************************************/
+CpaStatus LacDrbg_Init(CpaInstanceHandle instanceHandle);
+
+/**
+ ******************************************************************************
+ * @ingroup LacSym_Drbg
+ *      Free the DRBG statistics of a crypto instance
+ *
+ *****************************************************************************/
+void LacDrbg_StatsFree(CpaInstanceHandle instanceHandle);
+
+/**
+ ******************************************************************************
+ * @ingroup LacSym_Drbg
+ *      Clear the DRBG statistics of a crypto instance
+ *
+ *****************************************************************************/
+void LacDrbg_StatsReset(CpaInstanceHandle instanceHandle);
+
+#endif /* LAC_SYM_DRBG_H */
@@ -0,0 +1,195 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ ***************************************************************************
+ * @file lac_sym_hash_precomp_cache.h
+ *
+ * @defgroup LacHashPrecompCache Hash Precompute Cache
+ *
+ * @ingroup  LacHash
+ *
+ * Per-instance LRU cache of software hash precompute results
+ *
+ * @lld_start
+ * @lld_overview
+ * Entries hold the state derived from an authentication key (HMAC
+ * ipad/opad states, AES-XCBC and AES-CMAC subkeys). An entry is found by
+ * algorithm, key length and a 128-bit SipHash-2-4 digest of the key keyed
+ * with a random per-instance secret; the key itself is never stored.
+ * Lookups and insertions are serialised by one lock per instance. The
+ * cache is sized and enabled through icp_sal_SymPrecompCacheConfig().
+ * @lld_end
+ *
+ ***************************************************************************/
+
+#ifndef LAC_SYM_HASH_PRECOMP_CACHE_H
+#define LAC_SYM_HASH_PRECOMP_CACHE_H
+
+#include "cpa.h"
+#include "cpa_cy_sym.h"
+
+/**
+ *****************************************************************************
+ * @ingroup LacHashPrecompCache
+ *      Lookup tag
+ * @description
+ *      Filled in by LacSymHash_PrecompCacheLookup() on a miss and handed
+ *      back to LacSymHash_PrecompCacheInsert() once the state has been
+ *      computed, so the key digest is only computed once per setup.
+ *
+ *****************************************************************************/
+typedef struct lac_sym_hash_precomp_cache_tag_s
+{
+    Cpa64U digest[2];
+    /**< SipHash-2-4-128 of the authentication key */
+    Cpa32U generation;
+    /**< Cache generation the digest was computed for */
+    CpaCySymHashAlgorithm hashAlgorithm;
+    Cpa32U authKeyLenInBytes;
+    CpaBoolean valid;
+    /**< CPA_FALSE when the cache is disabled; insertion is then skipped */
+} lac_sym_hash_precomp_cache_tag_t;
+
+/**
+ ******************************************************************************
+ * @ingroup LacHashPrecompCache
+ *      Allocate the per-instance cache control structure
+ *
+ * @description
+ *      The cache starts disabled. Called at instance initialisation.
+ *
+ * @param[in] instanceHandle    Crypto service handle
+ *
+ * @retval CPA_STATUS_SUCCESS   Success
+ * @retval CPA_STATUS_RESOURCE  Allocation or lock creation failed
+ *
+ *****************************************************************************/
+CpaStatus LacSymHash_PrecompCacheCreate(CpaInstanceHandle instanceHandle);
+
+/**
+ ******************************************************************************
+ * @ingroup LacHashPrecompCache
+ *      Zeroize and free the per-instance cache
+ *
+ * @param[in] instanceHandle    Crypto service handle
+ *
+ *****************************************************************************/
+void LacSymHash_PrecompCacheDestroy(CpaInstanceHandle instanceHandle);
+
+/**
+ ******************************************************************************
+ * @ingroup LacHashPrecompCache
+ *      Look up cached precompute state
+ *
+ * @description
+ *      On a hit, stateSize bytes are copied to pState1 and, when pState2 is
+ *      not NULL, another stateSize bytes to pState2. On a miss pTag is
+ *      prepared for LacSymHash_PrecompCacheInsert().
+ *
+ * @param[in]  instanceHandle     Crypto service handle
+ * @param[in]  hashAlgorithm      Hash algorithm
+ * @param[in]  authKeyLenInBytes  Authentication key length
+ * @param[in]  pAuthKey           Authentication key
+ * @param[out] pTag               Lookup tag
+ * @param[out] pState1            First state buffer
+ * @param[out] pState2            Second state buffer or NULL
+ * @param[in]  stateSize          Size of each state buffer
+ *
+ * @retval CPA_TRUE   State was copied from the cache
+ * @retval CPA_FALSE  Miss or cache disabled
+ *
+ *****************************************************************************/
+CpaBoolean LacSymHash_PrecompCacheLookup(CpaInstanceHandle instanceHandle,
+                                         CpaCySymHashAlgorithm hashAlgorithm,
+                                         Cpa32U authKeyLenInBytes,
+                                         const Cpa8U *pAuthKey,
+                                         lac_sym_hash_precomp_cache_tag_t *pTag,
+                                         Cpa8U *pState1,
+                                         Cpa8U *pState2,
+                                         Cpa32U stateSize);
+
+/**
+ ******************************************************************************
+ * @ingroup LacHashPrecompCache
+ *      Insert freshly computed precompute state
+ *
+ * @description
+ *      No-op when the tag is not valid, when the state does not fit an
+ *      entry or when the cache was reconfigured since the lookup. Evicts
+ *      the least recently used entry when the cache is full.
+ *
+ * @param[in] instanceHandle    Crypto service handle
+ * @param[in] pTag              Tag from LacSymHash_PrecompCacheLookup()
+ * @param[in] pState1           First state buffer
+ * @param[in] pState2           Second state buffer or NULL
+ * @param[in] stateSize         Size of each state buffer
+ *
+ *****************************************************************************/
+void LacSymHash_PrecompCacheInsert(CpaInstanceHandle instanceHandle,
+                                   const lac_sym_hash_precomp_cache_tag_t *pTag,
+                                   const Cpa8U *pState1,
+                                   const Cpa8U *pState2,
+                                   Cpa32U stateSize);
+
+#endif /* LAC_SYM_HASH_PRECOMP_CACHE_H */
@@ -78,6 +78,18 @@
 #include "lac_session.h"
 #include "lac_sym.h"
 
+/**
+ * The request queue of a session is a single atomic word, requestQueueIn.
+ * While a blocking operation (a partial packet or a hash precompute) is in
+ * flight the queue has an owner, marked by the low bit of the word, and
+ * other submitters push their requests onto the lock-free lifo list held
+ * in the remaining bits. Ownership passes with the blocking operation to
+ * the thread that completes it, which takes the whole list with one
+ * exchange and sends the requests in order up to and including the next
+ * partial packet, or gives up ownership once the queue is empty.
+ */
+#define LAC_SYM_QUEUE_OWNED ((INT64)1)
+
 /**
 *******************************************************************************
 * @ingroup LacSymQueue
@@ -88,7 +100,8 @@
 *      blocking condition exists on the session (e.g. partial packet in flight,
 *      precompute in progress), then the message will instead be pushed on to
 *      the request queue for the session and will be sent later to the QAT
-*      once the blocking condition is cleared.
+*      once the blocking condition is cleared. Sending a partial packet makes
+*      the caller the owner of the queue until the packet completes.
 *
 * @param[in]  instanceHandle       Handle for instance of QAT
 * @param[in]  pRequest             Pointer to request cookie
@@ -106,4 +119,42 @@ CpaStatus LacSymQueue_RequestSend(const CpaInstanceHandle instanceHandle,
                                   lac_sym_bulk_cookie_t *pRequest,
                                   lac_session_desc_t *pSessionDesc);
 
+/**
+*******************************************************************************
+* @ingroup LacSymQueue
+*      Block the request queue of a session
+*
+* @description
+*      Takes ownership of the request queue for a blocking operation which
+*      is not a request, a hash precompute. Requests submitted on the session
+*      are queued until LacSymQueue_Release() is called on its completion.
+*      Must only be called while no request is in flight on the session.
+*
+* @param[in] pSessionDesc  Pointer to the session descriptor
+*
+*****************************************************************************/
+void LacSymQueue_Block(lac_session_desc_t *pSessionDesc);
+
+/**
+*******************************************************************************
+* @ingroup LacSymQueue
+*      Complete a blocking operation and send queued requests
+*
+* @description
+*      Called by the owner of the request queue when its blocking operation
+*      completes, usually from the response handler. Sends the queued
+*      requests in submission order. If one of them is a partial packet,
+*      ownership passes to it and sending stops; otherwise ownership is
+*      given up once the queue is empty.
+*
+* @param[in] pSessionDesc  Pointer to the session descriptor
+*
+* @retval CPA_STATUS_SUCCESS        Success
+* @retval CPA_STATUS_RETRY          A queued request could not be put on the
+*                                   ring. It stays queued and the queue stays
+*                                   owned.
+*
+*****************************************************************************/
+CpaStatus LacSymQueue_Release(lac_session_desc_t *pSessionDesc);
+
 #endif /* LAC_SYM_QUEUE_H */
@@ -0,0 +1,722 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file lac_sym_key_schedule.c
+ *
+ * @ingroup LacSymKey
+ *
+ * @description
+ *      Implementation of the TLS 1.3 key schedule, which chains the HKDF
+ *      requests of a handshake from their completions, and of batches of
+ *      independent TLS key derivations.
+ *
+ *****************************************************************************/
+
+/*
+*******************************************************************************
+* Include public/global header files
+*******************************************************************************
+*/
+#include "cpa.h"
+#include "cpa_cy_key.h"
+#include "icp_sal_key_schedule.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "Osal.h"
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_log.h"
+#include "lac_sal_types_crypto.h"
+#include "lac_sym_hash_defs.h"
+#include "sal_service_state.h"
+
+/* Steps of the key schedule, one HKDF request each */
+#define LAC_KEY_SCHEDULE_STEP_EARLY (0)
+#define LAC_KEY_SCHEDULE_STEP_HANDSHAKE (1)
+#define LAC_KEY_SCHEDULE_STEP_MASTER (2)
+#define LAC_KEY_SCHEDULE_NUM_STEPS (3)
+
+/* Prefix of every TLS 1.3 label */
+#define LAC_KEY_SCHEDULE_LABEL_PREFIX "tls13 "
+#define LAC_KEY_SCHEDULE_LABEL_PREFIX_LEN (6)
+
+/* Largest output of a step: the extracted secret and four labels with
+ * every sublabel */
+#define LAC_KEY_SCHEDULE_OUTPUT_SZ                                             \
+    (ICP_SAL_TLS3_MAX_HASH_SZ +                                                \
+     CPA_CY_HKDF_KEY_MAX_LABEL_COUNT *                                         \
+         (3 * ICP_SAL_TLS3_MAX_HASH_SZ + ICP_SAL_TLS3_MAX_KEY_SZ +             \
+          ICP_SAL_TLS3_IV_SZ))
+
+/* Transcript hash of an empty message, the context of "derived" and of
+ * the binder keys */
+STATIC const Cpa8U emptyHashSha256[] = {
+    0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4,
+    0xc8, 0x99, 0x6f, 0xb9, 0x24, 0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b,
+    0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55};
+STATIC const Cpa8U emptyHashSha384[] = {
+    0x38, 0xb0, 0x60, 0xa7, 0x51, 0xac, 0x96, 0x38, 0x4c, 0xd9, 0x32, 0x7e,
+    0xb1, 0xb1, 0xe3, 0x6a, 0x21, 0xfd, 0xb7, 0x11, 0x14, 0xbe, 0x07, 0x43,
+    0x4c, 0x0c, 0xc7, 0xbf, 0x63, 0xf6, 0xe1, 0xda, 0x27, 0x4e, 0xde, 0xbf,
+    0xe7, 0x6f, 0x65, 0xfb, 0xd5, 0x1a, 0xd2, 0xf1, 0x48, 0x98, 0xb9, 0x5b};
+
+/**
+ *****************************************************************************
+ * @ingroup LacSymKey
+ *      Where the outputs of a label of the current step go
+ *****************************************************************************/
+typedef struct lac_key_schedule_label_s
+{
+    Cpa8U *pSecret;
+    /* Expanded secret */
+    icp_sal_tls3_secret_t *pKeys;
+    /* Keys expanded from it with the sublabels, NULL without sublabels */
+} lac_key_schedule_label_t;
+
+/**
+ *****************************************************************************
+ * @ingroup LacSymKey
+ *      Key schedule context
+ *
+ * @description
+ *      Lives in the DMA-able memory given by the application, as the HKDF
+ *      operation data and the output of the request in flight are read and
+ *      written by the accelerator. A context runs either a key schedule or
+ *      a batch.
+ *****************************************************************************/
+typedef struct lac_key_schedule_ctx_s
+{
+    CpaCyKeyGenHKDFOpData opData;
+    /* Request of the current step */
+    Cpa8U output[LAC_KEY_SCHEDULE_OUTPUT_SZ];
+    /* Output of the current step */
+    CpaFlatBuffer outputBuffer;
+    /* Describes output */
+    Cpa8U derived[ICP_SAL_TLS3_MAX_HASH_SZ];
+    /* "derived" secret, the salt of the next step */
+    Cpa8U *pPrk;
+    /* Where the secret extracted by the current step goes */
+    lac_key_schedule_label_t labels[CPA_CY_HKDF_KEY_MAX_LABEL_COUNT];
+    /* Where the outputs of the labels of the current step go */
+    CpaInstanceHandle instanceHandle;
+    icp_sal_key_cb_func_t pCb;
+    void *pCallbackTag;
+    const icp_sal_tls3_schedule_op_data_t *pOpData;
+    icp_sal_tls3_schedule_t *pSchedule;
+    Cpa32U step;
+    /* Current step of the key schedule */
+    icp_sal_key_gen_op_t *pOps;
+    Cpa32U numOps;
+    /* Derivations of the batch */
+    OsalAtomic next;
+    /* Next derivation of the batch to send */
+    OsalAtomic remaining;
+    /* Derivations not completed, plus one while the batch is started */
+    OsalAtomic status;
+    /* First failure of the batch */
+} lac_key_schedule_ctx_t;
+
+/* Hash and traffic key lengths of a cipher suite, 0 when not supported */
+STATIC void LacKeySchedule_Lengths(CpaCyKeyHKDFCipherSuite cipherSuite,
+                                   Cpa32U *pHashLen,
+                                   Cpa32U *pKeyLen)
+{
+    *pHashLen = LAC_HASH_SHA256_DIGEST_SIZE;
+    switch (cipherSuite)
+    {
+        case CPA_CY_HKDF_TLS_AES_128_GCM_SHA256:
+        case CPA_CY_HKDF_TLS_AES_128_CCM_SHA256:
+        case CPA_CY_HKDF_TLS_AES_128_CCM_8_SHA256:
+            *pKeyLen = 16;
+            break;
+        case CPA_CY_HKDF_TLS_CHACHA20_POLY1305_SHA256:
+            *pKeyLen = 32;
+            break;
+        case CPA_CY_HKDF_TLS_AES_256_GCM_SHA384:
+            *pHashLen = LAC_HASH_SHA384_DIGEST_SIZE;
+            *pKeyLen = 32;
+            break;
+        default:
+            *pHashLen = 0;
+            *pKeyLen = 0;
+            break;
+    }
+}
+
+/* Append an HkdfLabel of RFC8446 section 7.1 to the request */
+STATIC void LacKeySchedule_LabelAdd(lac_key_schedule_ctx_t *pCtx,
+                                    const char *pName,
+                                    const Cpa8U *pContext,
+                                    Cpa8U sublabels,
+                                    Cpa8U *pSecret,
+                                    icp_sal_tls3_secret_t *pKeys)
+{
+    CpaCyKeyGenHKDFOpData *pOpData = &pCtx->opData;
+    CpaCyKeyGenHKDFExpandLabel *pLabel = &pOpData->label[pOpData->numLabels];
+    Cpa32U hashLen = pCtx->pSchedule->hashLenInBytes;
+    Cpa32U nameLen = LAC_KEY_SCHEDULE_LABEL_PREFIX_LEN + strlen(pName);
+    Cpa8U *pOut = pLabel->label;
+
+    *pOut++ = 0;
+    *pOut++ = (Cpa8U)hashLen;
+    *pOut++ = (Cpa8U)nameLen;
+    memcpy(pOut,
+           LAC_KEY_SCHEDULE_LABEL_PREFIX,
+           LAC_KEY_SCHEDULE_LABEL_PREFIX_LEN);
+    memcpy(pOut + LAC_KEY_SCHEDULE_LABEL_PREFIX_LEN,
+           pName,
+           nameLen - LAC_KEY_SCHEDULE_LABEL_PREFIX_LEN);
+    pOut += nameLen;
+    *pOut++ = (Cpa8U)hashLen;
+    memcpy(pOut, pContext, hashLen);
+    pOut += hashLen;
+    pLabel->labelLen = (Cpa8U)(pOut - pLabel->label);
+    pLabel->sublabelFlag = sublabels;
+
+    pCtx->labels[pOpData->numLabels].pSecret = pSecret;
+    pCtx->labels[pOpData->numLabels].pKeys = pKeys;
+    pOpData->numLabels++;
+}
+
+/* Set the secret of the request, all zeros when there is none */
+STATIC void LacKeySchedule_SecretSet(lac_key_schedule_ctx_t *pCtx,
+                                     const CpaFlatBuffer *pSecret)
+{
+    if (NULL != pSecret && 0 != pSecret->dataLenInBytes)
+    {
+        memcpy(pCtx->opData.secret, pSecret->pData, pSecret->dataLenInBytes);
+        pCtx->opData.secretLen = (Cpa8U)pSecret->dataLenInBytes;
+    }
+    else
+    {
+        pCtx->opData.secretLen = (Cpa8U)pCtx->pSchedule->hashLenInBytes;
+    }
+}
+
+/* Build the request of the current step and send it */
+STATIC CpaStatus LacKeySchedule_Tls3Send(lac_key_schedule_ctx_t *pCtx);
+
+STATIC void LacKeySchedule_Tls3Callback(void *pCallbackTag,
+                                        CpaStatus status,
+                                        void *pOpData,
+                                        CpaFlatBuffer *pOut)
+{
+    lac_key_schedule_ctx_t *pCtx = (lac_key_schedule_ctx_t *)pCallbackTag;
+    icp_sal_tls3_schedule_t *pSchedule = pCtx->pSchedule;
+    lac_key_schedule_label_t *pLabel = NULL;
+    Cpa32U hashLen = pSchedule->hashLenInBytes;
+    Cpa8U *pOutput = pCtx->output;
+    Cpa8U sublabels = 0;
+    Cpa32U i = 0;
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        /* The extracted secret comes first, then each label followed by
+         * its sublabels in flag order */
+        memcpy(pCtx->pPrk, pOutput, hashLen);
+        pOutput += hashLen;
+        for (i = 0; i < pCtx->opData.numLabels; i++)
+        {
+            pLabel = &pCtx->labels[i];
+            sublabels = pCtx->opData.label[i].sublabelFlag;
+            memcpy(pLabel->pSecret, pOutput, hashLen);
+            pOutput += hashLen;
+            if (sublabels & CPA_CY_HKDF_SUBLABEL_KEY)
+            {
+                memcpy(pLabel->pKeys->key, pOutput, pSchedule->keyLenInBytes);
+                pOutput += pSchedule->keyLenInBytes;
+            }
+            if (sublabels & CPA_CY_HKDF_SUBLABEL_IV)
+            {
+                memcpy(pLabel->pKeys->iv, pOutput, ICP_SAL_TLS3_IV_SZ);
+                pOutput += ICP_SAL_TLS3_IV_SZ;
+            }
+            if (sublabels & CPA_CY_HKDF_SUBLABEL_FINISHED)
+            {
+                memcpy(pLabel->pKeys->finishedKey, pOutput, hashLen);
+                pOutput += hashLen;
+            }
+        }
+
+        pCtx->step++;
+        if (pCtx->step < LAC_KEY_SCHEDULE_NUM_STEPS)
+        {
+            status = LacKeySchedule_Tls3Send(pCtx);
+            if (CPA_STATUS_SUCCESS == status)
+            {
+                return;
+            }
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        /* Do not hand out the secrets of a schedule that did not finish */
+        osalMemZeroExplicit(pSchedule, sizeof(*pSchedule));
+    }
+    /* The context holds secrets until it is reused */
+    osalMemZeroExplicit(&pCtx->opData, sizeof(pCtx->opData));
+    osalMemZeroExplicit(pCtx->output, sizeof(pCtx->output));
+    osalMemZeroExplicit(pCtx->derived, sizeof(pCtx->derived));
+    pCtx->pCb(pCtx->pCallbackTag, status);
+}
+
+STATIC CpaStatus LacKeySchedule_Tls3Send(lac_key_schedule_ctx_t *pCtx)
+{
+    const icp_sal_tls3_schedule_op_data_t *pOpData = pCtx->pOpData;
+    icp_sal_tls3_schedule_t *pSchedule = pCtx->pSchedule;
+    const Cpa8U *pEmptyHash = (LAC_HASH_SHA384_DIGEST_SIZE ==
+                               pSchedule->hashLenInBytes)
+                                  ? emptyHashSha384
+                                  : emptyHashSha256;
+
+    osalMemSet(&pCtx->opData, 0, sizeof(pCtx->opData));
+    pCtx->opData.hkdfKeyOp = CPA_CY_HKDF_KEY_EXTRACT_EXPAND_LABEL;
+    pCtx->opData.seedLen = (Cpa16U)pSchedule->hashLenInBytes;
+
+    switch (pCtx->step)
+    {
+        case LAC_KEY_SCHEDULE_STEP_EARLY:
+            /* Zero salt */
+            LacKeySchedule_SecretSet(pCtx, &pOpData->psk);
+            pCtx->pPrk = pSchedule->earlySecret;
+            if (0 != pOpData->psk.dataLenInBytes)
+            {
+                LacKeySchedule_LabelAdd(pCtx,
+                                        (CPA_TRUE == pOpData->externalPsk)
+                                            ? "ext binder"
+                                            : "res binder",
+                                        pEmptyHash,
+                                        CPA_CY_HKDF_SUBLABEL_FINISHED,
+                                        pSchedule->binder.secret,
+                                        &pSchedule->binder);
+                if (CPA_TRUE == pOpData->deriveEarlyTraffic)
+                {
+                    LacKeySchedule_LabelAdd(
+                        pCtx,
+                        "c e traffic",
+                        pOpData->clientHelloHash,
+                        CPA_CY_HKDF_SUBLABEL_KEY | CPA_CY_HKDF_SUBLABEL_IV,
+                        pSchedule->clientEarlyTraffic.secret,
+                        &pSchedule->clientEarlyTraffic);
+                }
+            }
+            break;
+        case LAC_KEY_SCHEDULE_STEP_HANDSHAKE:
+            memcpy(pCtx->opData.seed,
+                   pCtx->derived,
+                   pSchedule->hashLenInBytes);
+            LacKeySchedule_SecretSet(pCtx, &pOpData->sharedSecret);
+            pCtx->pPrk = pSchedule->handshakeSecret;
+            LacKeySchedule_LabelAdd(pCtx,
+                                    "c hs traffic",
+                                    pOpData->serverHelloHash,
+                                    CPA_CY_HKDF_SUBLABEL_KEY |
+                                        CPA_CY_HKDF_SUBLABEL_IV |
+                                        CPA_CY_HKDF_SUBLABEL_FINISHED,
+                                    pSchedule->clientHandshakeTraffic.secret,
+                                    &pSchedule->clientHandshakeTraffic);
+            LacKeySchedule_LabelAdd(pCtx,
+                                    "s hs traffic",
+                                    pOpData->serverHelloHash,
+                                    CPA_CY_HKDF_SUBLABEL_KEY |
+                                        CPA_CY_HKDF_SUBLABEL_IV |
+                                        CPA_CY_HKDF_SUBLABEL_FINISHED,
+                                    pSchedule->serverHandshakeTraffic.secret,
+                                    &pSchedule->serverHandshakeTraffic);
+            break;
+        default:
+            memcpy(pCtx->opData.seed,
+                   pCtx->derived,
+                   pSchedule->hashLenInBytes);
+            LacKeySchedule_SecretSet(pCtx, NULL);
+            pCtx->pPrk = pSchedule->masterSecret;
+            LacKeySchedule_LabelAdd(
+                pCtx,
+                "c ap traffic",
+                pOpData->serverFinishedHash,
+                CPA_CY_HKDF_SUBLABEL_KEY | CPA_CY_HKDF_SUBLABEL_IV,
+                pSchedule->clientApplicationTraffic.secret,
+                &pSchedule->clientApplicationTraffic);
+            LacKeySchedule_LabelAdd(
+                pCtx,
+                "s ap traffic",
+                pOpData->serverFinishedHash,
+                CPA_CY_HKDF_SUBLABEL_KEY | CPA_CY_HKDF_SUBLABEL_IV,
+                pSchedule->serverApplicationTraffic.secret,
+                &pSchedule->serverApplicationTraffic);
+            LacKeySchedule_LabelAdd(pCtx,
+                                    "exp master",
+                                    pOpData->serverFinishedHash,
+                                    0,
+                                    pSchedule->exporterMasterSecret,
+                                    NULL);
+            if (CPA_TRUE == pOpData->deriveResumption)
+            {
+                LacKeySchedule_LabelAdd(pCtx,
+                                        "res master",
+                                        pOpData->clientFinishedHash,
+                                        0,
+                                        pSchedule->resumptionMasterSecret,
+                                        NULL);
+            }
+            break;
+    }
+    if (LAC_KEY_SCHEDULE_STEP_MASTER != pCtx->step)
+    {
+        /* Salt of the next step */
+        LacKeySchedule_LabelAdd(
+            pCtx, "derived", pEmptyHash, 0, pCtx->derived, NULL);
+    }
+
+    pCtx->outputBuffer.pData = pCtx->output;
+    pCtx->outputBuffer.dataLenInBytes = sizeof(pCtx->output);
+    return cpaCyKeyGenTls3(pCtx->instanceHandle,
+                           LacKeySchedule_Tls3Callback,
+                           pCtx,
+                           &pCtx->opData,
+                           pOpData->cipherSuite,
+                           &pCtx->outputBuffer);
+}
+
+/* Get the instance of a call, checking it as the key generation API
+ * does */
+STATIC CpaStatus LacKeySchedule_InstanceGet(
+    const CpaInstanceHandle instanceHandle_in,
+    CpaInstanceHandle *pInstanceHandle)
+{
+    CpaInstanceHandle instanceHandle = NULL;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
+    {
+        instanceHandle = Lac_GetFirstHandle(SAL_SERVICE_TYPE_CRYPTO_SYM);
+    }
+    else
+    {
+        instanceHandle = instanceHandle_in;
+    }
+
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_ADDR_TRANS_SETUP(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+#endif
+    SAL_RUNNING_CHECK(instanceHandle);
+
+    *pInstanceHandle = instanceHandle;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_CyKeyScheduleCtxGetSize(
+    const CpaInstanceHandle instanceHandle,
+    Cpa32U *pCtxSize)
+{
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pCtxSize);
+#endif
+    *pCtxSize = sizeof(lac_key_schedule_ctx_t);
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_CyKeyGenTls3Schedule(
+    const CpaInstanceHandle instanceHandle_in,
+    const icp_sal_key_cb_func_t pCb,
+    void *pCallbackTag,
+    const icp_sal_tls3_schedule_op_data_t *pOpData,
+    void *pCtxIn,
+    icp_sal_tls3_schedule_t *pSchedule)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaInstanceHandle instanceHandle = NULL;
+    lac_key_schedule_ctx_t *pCtx = (lac_key_schedule_ctx_t *)pCtxIn;
+    Cpa32U hashLen = 0;
+    Cpa32U keyLen = 0;
+
+    status = LacKeySchedule_InstanceGet(instanceHandle_in, &instanceHandle);
+    LAC_CHECK_STATUS(status);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pCb);
+    LAC_CHECK_NULL_PARAM(pOpData);
+    LAC_CHECK_NULL_PARAM(pCtx);
+    LAC_CHECK_NULL_PARAM(pSchedule);
+    if (pOpData->psk.dataLenInBytes > CPA_CY_HKDF_KEY_MAX_SECRET_SZ ||
+        (0 != pOpData->psk.dataLenInBytes && NULL == pOpData->psk.pData))
+    {
+        LAC_INVALID_PARAM_LOG("pOpData->psk");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (pOpData->sharedSecret.dataLenInBytes > CPA_CY_HKDF_KEY_MAX_SECRET_SZ ||
+        (0 != pOpData->sharedSecret.dataLenInBytes &&
+         NULL == pOpData->sharedSecret.pData))
+    {
+        LAC_INVALID_PARAM_LOG("pOpData->sharedSecret");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (CPA_TRUE == pOpData->deriveEarlyTraffic &&
+        0 == pOpData->psk.dataLenInBytes)
+    {
+        LAC_INVALID_PARAM_LOG("Early traffic secret without a PSK");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#endif
+    LacKeySchedule_Lengths(pOpData->cipherSuite, &hashLen, &keyLen);
+    if (0 == hashLen)
+    {
+        LAC_INVALID_PARAM_LOG("pOpData->cipherSuite");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    osalMemSet(pSchedule, 0, sizeof(*pSchedule));
+    pSchedule->hashLenInBytes = hashLen;
+    pSchedule->keyLenInBytes = keyLen;
+    pCtx->instanceHandle = instanceHandle;
+    pCtx->pCb = pCb;
+    pCtx->pCallbackTag = pCallbackTag;
+    pCtx->pOpData = pOpData;
+    pCtx->pSchedule = pSchedule;
+    pCtx->step = LAC_KEY_SCHEDULE_STEP_EARLY;
+
+    status = LacKeySchedule_Tls3Send(pCtx);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        osalMemZeroExplicit(&pCtx->opData, sizeof(pCtx->opData));
+    }
+    return status;
+}
+
+/* Drop a reference to the batch, invoking the callback with the last */
+STATIC void LacKeyBatch_Release(lac_key_schedule_ctx_t *pCtx)
+{
+    if (0 == osalAtomicDec(&pCtx->remaining))
+    {
+        pCtx->pCb(pCtx->pCallbackTag,
+                  (CpaStatus)osalAtomicGet(&pCtx->status));
+    }
+}
+
+/* Record the status of a derivation and drop its reference */
+STATIC void LacKeyBatch_Done(lac_key_schedule_ctx_t *pCtx,
+                             icp_sal_key_gen_op_t *pOp,
+                             CpaStatus status)
+{
+    pOp->status = status;
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        /* Only the first failure is reported in the callback */
+        (void)osalAtomicCmpXchg(CPA_STATUS_SUCCESS, status, &pCtx->status);
+    }
+    LacKeyBatch_Release(pCtx);
+}
+
+STATIC void LacKeyBatch_Callback(void *pCallbackTag,
+                                 CpaStatus status,
+                                 void *pOpData,
+                                 CpaFlatBuffer *pOut);
+
+STATIC CpaStatus LacKeyBatch_Send(lac_key_schedule_ctx_t *pCtx,
+                                  icp_sal_key_gen_op_t *pOp)
+{
+    pOp->pPrivate = pCtx;
+    if (ICP_SAL_KEY_GEN_TLS3 == pOp->type)
+    {
+        return cpaCyKeyGenTls3(pCtx->instanceHandle,
+                               LacKeyBatch_Callback,
+                               pOp,
+                               pOp->u.tls3.pOpData,
+                               pOp->u.tls3.cipherSuite,
+                               pOp->pGeneratedKeyBuffer);
+    }
+    return cpaCyKeyGenTls2(pCtx->instanceHandle,
+                           LacKeyBatch_Callback,
+                           pOp,
+                           pOp->u.tls2.pOpData,
+                           pOp->u.tls2.hashAlgorithm,
+                           pOp->pGeneratedKeyBuffer);
+}
+
+/* Send the next derivation not yet claimed. The ones that cannot be sent
+ * are completed with their status, so every derivation is either in
+ * flight or done when this returns. */
+STATIC void LacKeyBatch_SendNext(lac_key_schedule_ctx_t *pCtx)
+{
+    icp_sal_key_gen_op_t *pOp = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    INT64 index = 0;
+
+    do
+    {
+        index = osalAtomicInc(&pCtx->next) - 1;
+        if (index >= pCtx->numOps)
+        {
+            return;
+        }
+        pOp = &pCtx->pOps[index];
+        status = LacKeyBatch_Send(pCtx, pOp);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            LacKeyBatch_Done(pCtx, pOp, status);
+        }
+    } while (CPA_STATUS_SUCCESS != status);
+}
+
+STATIC void LacKeyBatch_Callback(void *pCallbackTag,
+                                 CpaStatus status,
+                                 void *pOpData,
+                                 CpaFlatBuffer *pOut)
+{
+    icp_sal_key_gen_op_t *pOp = (icp_sal_key_gen_op_t *)pCallbackTag;
+    lac_key_schedule_ctx_t *pCtx = (lac_key_schedule_ctx_t *)pOp->pPrivate;
+
+    pOp->status = status;
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        (void)osalAtomicCmpXchg(CPA_STATUS_SUCCESS, status, &pCtx->status);
+    }
+    /* Keep the reference of this derivation until the next is in flight,
+     * so the batch cannot complete under it */
+    LacKeyBatch_SendNext(pCtx);
+    LacKeyBatch_Release(pCtx);
+}
+
+CpaStatus icp_sal_CyKeyGenBatch(const CpaInstanceHandle instanceHandle_in,
+                                const icp_sal_key_cb_func_t pCb,
+                                void *pCallbackTag,
+                                icp_sal_key_gen_op_t *pOps,
+                                Cpa32U numOps,
+                                Cpa32U maxInflight,
+                                void *pCtxIn)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaInstanceHandle instanceHandle = NULL;
+    lac_key_schedule_ctx_t *pCtx = (lac_key_schedule_ctx_t *)pCtxIn;
+    Cpa32U window = 0;
+    Cpa32U i = 0;
+
+    status = LacKeySchedule_InstanceGet(instanceHandle_in, &instanceHandle);
+    LAC_CHECK_STATUS(status);
+#ifdef ICP_PARAM_CHECK
+    LAC_CHECK_NULL_PARAM(pCb);
+    LAC_CHECK_NULL_PARAM(pOps);
+    LAC_CHECK_NULL_PARAM(pCtx);
+    if (0 == numOps)
+    {
+        LAC_INVALID_PARAM_LOG("numOps");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    for (i = 0; i < numOps; i++)
+    {
+        if (ICP_SAL_KEY_GEN_TLS2 != pOps[i].type &&
+            ICP_SAL_KEY_GEN_TLS3 != pOps[i].type)
+        {
+            LAC_INVALID_PARAM_LOG1("pOps[%u].type", i);
+            return CPA_STATUS_INVALID_PARAM;
+        }
+    }
+#endif
+
+    window = (0 == maxInflight || maxInflight > numOps) ? numOps : maxInflight;
+    for (i = 0; i < numOps; i++)
+    {
+        pOps[i].status = CPA_STATUS_SUCCESS;
+    }
+    pCtx->instanceHandle = instanceHandle;
+    pCtx->pCb = pCb;
+    pCtx->pCallbackTag = pCallbackTag;
+    pCtx->pOps = pOps;
+    pCtx->numOps = numOps;
+    osalAtomicSet(CPA_STATUS_SUCCESS, &pCtx->status);
+    /* The completions send the derivations beyond the window */
+    osalAtomicSet(window, &pCtx->next);
+    osalAtomicSet((INT64)numOps + 1, &pCtx->remaining);
+
+    for (i = 0; i < window; i++)
+    {
+        status = LacKeyBatch_Send(pCtx, &pOps[i]);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            continue;
+        }
+        if (0 == i)
+        {
+            /* Nothing is in flight, so the batch has not started */
+            return status;
+        }
+        /* The derivations in flight carry the batch on. The rest of the
+         * window is not sent, the completions move past it. */
+        for (; i < window; i++)
+        {
+            LacKeyBatch_Done(pCtx, &pOps[i], status);
+        }
+        break;
+    }
+
+    LacKeyBatch_Release(pCtx);
+    return CPA_STATUS_SUCCESS;
+}
@@ -133,33 +133,46 @@
 
 #define MAX_HASH_PARTIALS_SIZE (4ULL * 1024 * 1024 * 1024)
 
+/*
+ * Session access in the TRAD API. A perform holds a reference in the
+ * pending request count from the moment it starts reading the session
+ * until its response is processed, so the updater only needs to see the
+ * count at 0 after announcing itself in updateInProgress. Both sides use
+ * full barrier atomics (increment, then read the other variable), so
+ * either the reader sees the update or the updater sees the reference.
+ * The reference is taken on the counter of the reader's CPU, so readers
+ * on different CPUs write no shared cache line.
+ */
 static inline void LacAlgChain_LockSessionReader(
     lac_session_desc_t *pSessionDesc)
 {
-    /* Session lock in TRAD API */
+    OsalAtomic *pPendingCb = NULL;
+
     if (!pSessionDesc->isDPSession)
     {
-        while (osalAtomicTestAndSet(1, &pSessionDesc->accessLock))
-            ;
-
-        pSessionDesc->accessReaders++;
-
-        osalAtomicRelease(&pSessionDesc->accessLock);
+        pPendingCb = LacSymSession_PendingCbCounter(pSessionDesc);
+        osalAtomicInc(pPendingCb);
+        while (osalAtomicGet(&pSessionDesc->updateInProgress))
+        {
+            /* Back off so that the updater can see the count drop. The
+             * reference is dropped on the counter it was taken on, or the
+             * updater could sum the drop without the reference. */
+            osalAtomicDec(pPendingCb);
+            while (osalAtomicGet(&pSessionDesc->updateInProgress))
+                ;
+            pPendingCb = LacSymSession_PendingCbCounter(pSessionDesc);
+            osalAtomicInc(pPendingCb);
+        }
     }
 }
 
+/* Drop the reference of a perform which does not send a request */
 static inline void LacAlgChain_UnlockSessionReader(
     lac_session_desc_t *pSessionDesc)
 {
-    /* Session lock in TRAD API */
     if (!pSessionDesc->isDPSession)
     {
-        while (osalAtomicTestAndSet(1, &pSessionDesc->accessLock))
-            ;
-
-        pSessionDesc->accessReaders--;
-
-        osalAtomicRelease(&pSessionDesc->accessLock);
+        osalAtomicDec(LacSymSession_PendingCbCounter(pSessionDesc));
     }
 }
 
@@ -170,14 +183,12 @@ static inline CpaStatus LacAlgChain_LockSessionWriter(
 
     if (!pSessionDesc->isDPSession)
     {
-        while (osalAtomicTestAndSet(1, &pSessionDesc->accessLock))
-            ;
-
-        if (pSessionDesc->accessReaders ||
-            osalAtomicGet(&(pSessionDesc->u.pendingCbCount)) > 0)
+        if (1 != osalAtomicInc(&pSessionDesc->updateInProgress) ||
+            LacSymSession_PendingCbGet(pSessionDesc) > 0)
         {
+            /* Another update or requests in flight */
             status = CPA_STATUS_RETRY;
-            osalAtomicRelease(&pSessionDesc->accessLock);
+            osalAtomicDec(&pSessionDesc->updateInProgress);
         }
     }
     else
@@ -195,10 +206,9 @@ static inline CpaStatus LacAlgChain_LockSessionWriter(
 static inline void LacAlgChain_UnlockSessionWriter(
     lac_session_desc_t *pSessionDesc)
 {
-    /* Session lock in TRAD API */
     if (!pSessionDesc->isDPSession)
     {
-        osalAtomicRelease(&pSessionDesc->accessLock);
+        osalAtomicDec(&pSessionDesc->updateInProgress);
     }
 }
 
@@ -217,7 +227,7 @@ static inline void LacAlgChain_UnlockSessionWriter(
  */
 STATIC void LacSymAlgChain_HashPrecomputeDoneCb(void *callbackTag)
 {
-    LacSymCb_PendingReqsDequeue((lac_session_desc_t *)callbackTag);
+    (void)LacSymQueue_Release((lac_session_desc_t *)callbackTag);
 }
 
 /**
@@ -789,7 +799,7 @@ LacAlgChain_SessionAuthKeyUpdate(lac_session_desc_t *pSessionDesc,
         }
 
         /* Block messages until precompute is completed */
-        pSessionDesc->nonBlockingOpsInProgress = CPA_FALSE;
+        LacSymQueue_Block(pSessionDesc);
 
         status = LacHash_PrecomputeDataCreate(
             pSessionDesc->pInstance,
@@ -1491,7 +1501,7 @@ CpaStatus LacAlgChain_SessionInit(
     const CpaCySymSessionSetupData *pSessionSetupData,
     lac_session_desc_t *pSessionDesc)
 {
-    CpaStatus stat, status = CPA_STATUS_SUCCESS;
+    CpaStatus status = CPA_STATUS_SUCCESS;
     sal_qat_content_desc_info_t *pCdInfo = NULL;
     sal_qat_content_desc_info_t *pCdInfoOptimised = NULL;
     sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
@@ -1533,27 +1543,18 @@ CpaStatus LacAlgChain_SessionInit(
      * Populate session data
      *-----------------------------------------------------------------------*/
 
+    /* No session update in progress */
+    osalAtomicSet(0, &pSessionDesc->updateInProgress);
     /* Initialise Request Queue */
-    stat = LAC_SPINLOCK_INIT(&pSessionDesc->requestQueueLock);
-    if (CPA_STATUS_SUCCESS != stat)
-    {
-        LAC_LOG_ERROR("Spinlock init failed for sessionLock");
-        return CPA_STATUS_RESOURCE;
-    }
-
-    /* Initialise session readers writers */
-    osalAtomicSet(0, &pSessionDesc->accessLock);
     pSessionDesc->pRequestQueueHead = NULL;
-    pSessionDesc->pRequestQueueTail = NULL;
-    pSessionDesc->nonBlockingOpsInProgress = CPA_TRUE;
+    osalAtomicSet(0, &pSessionDesc->requestQueueIn);
     pSessionDesc->pInstance = instanceHandle;
     pSessionDesc->digestIsAppended = pSessionSetupData->digestIsAppended;
     pSessionDesc->digestVerify = pSessionSetupData->verifyDigest;
 
     /* Reset the pending callback counter */
-    osalAtomicSet(0, &pSessionDesc->u.pendingCbCount);
+    LacSymSession_PendingCbReset(pSessionDesc);
     pSessionDesc->u.pendingDpCbCount = 0;
-    pSessionDesc->accessReaders = 0;
 
     /* Partial state must be set to full, to indicate that next packet
      * expected on the session is a full packet or the start of a
@@ -1760,6 +1761,11 @@ CpaStatus LacAlgChain_SessionInit(
                 LacSymQat_UseSymConstantsTable(pSessionDesc,
                                                &cipherOffsetInConstantsTable,
                                                &hashOffsetInConstantsTable);
+#ifdef ICP_EMULATED_DEVICE
+        /* The emulated device has no SHRAM constants table, the content
+         * descriptor must always be fetched from host memory */
+        pSessionDesc->useSymConstantsTable = CPA_FALSE;
+#endif
 
         /* for a certain combination of Algorithm Chaining we want to
            use an optimised cd block */
@@ -1999,7 +2005,7 @@ CpaStatus LacAlgChain_SessionInit(
 #endif
 
                 /* Block messages until precompute is completed */
-                pSessionDesc->nonBlockingOpsInProgress = CPA_FALSE;
+                LacSymQueue_Block(pSessionDesc);
                 status = LacHash_PrecomputeDataCreate(
                     instanceHandle,
                     (CpaCySymSessionSetupData *)pSessionSetupData,
@@ -2909,18 +2915,13 @@ CpaStatus LacAlgChain_Perform(const CpaInstanceHandle instanceHandle,
         }
     }
 
-    /* DC Chaining has its own callback count so skip */
-    if (CPA_FALSE == isDcChaining)
+    /* The reference taken on entry becomes the pending callback of the
+     * request. DC Chaining has its own callback count so drop it. */
+    if (CPA_TRUE == isDcChaining || CPA_STATUS_SUCCESS != status)
     {
-        /* Increase pending callbacks before unlocking session */
-        if (CPA_STATUS_SUCCESS == status)
-        {
-            osalAtomicInc(&(pSessionDesc->u.pendingCbCount));
-        }
+        LacAlgChain_UnlockSessionReader(pSessionDesc);
     }
 
-    LacAlgChain_UnlockSessionReader(pSessionDesc);
-
     /* Send message now if this is not a DC Chaining operation */
     if (CPA_FALSE == isDcChaining)
     {
@@ -2935,7 +2936,7 @@ CpaStatus LacAlgChain_Perform(const CpaInstanceHandle instanceHandle,
             if (CPA_STATUS_SUCCESS != status)
             {
                 /* Decrease pending callback counter on send fail. */
-                osalAtomicDec(&(pSessionDesc->u.pendingCbCount));
+                osalAtomicDec(LacSymSession_PendingCbCounter(pSessionDesc));
             }
         }
     }
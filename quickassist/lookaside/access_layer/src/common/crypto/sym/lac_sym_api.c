@@ -77,6 +77,7 @@
 #include "cpa.h"
 #include "cpa_cy_sym.h"
 #include "cpa_cy_im.h"
+#include "icp_sal_priority.h"
 
 #include "Osal.h"
 
@@ -85,6 +86,7 @@
 #include "icp_adf_transport_dp.h"
 #include "icp_accel_devices.h"
 #include "icp_adf_debug.h"
+#include "icp_adf_trace.h"
 #include "icp_qat_fw_la.h"
 
 /*
@@ -697,7 +699,7 @@ CpaStatus cpaCySymSessionInUse(CpaCySymSessionCtx pSessionCtx,
     }
     else
     {
-        if (osalAtomicGet(&(pSessionDesc->u.pendingCbCount)))
+        if (LacSymSession_PendingCbGet(pSessionDesc))
             *pSessionInUse = CPA_TRUE;
     }
 
@@ -903,7 +905,7 @@ CpaStatus cpaCySymRemoveSession(const CpaInstanceHandle instanceHandle_in,
     }
     else
     {
-        numPendingRequests = osalAtomicGet(&(pSessionDesc->u.pendingCbCount));
+        numPendingRequests = LacSymSession_PendingCbGet(pSessionDesc);
     }
 
     /* If there are pending requests */
@@ -932,8 +934,7 @@ CpaStatus cpaCySymRemoveSession(const CpaInstanceHandle instanceHandle_in,
     }
     if (CPA_STATUS_SUCCESS == status)
     {
-        LAC_SPINLOCK_DESTROY(&pSessionDesc->requestQueueLock);
-        osalAtomicSet(0, &pSessionDesc->accessLock);
+        osalAtomicSet(0, &pSessionDesc->updateInProgress);
         if (CPA_FALSE == pSessionDesc->isDPSession)
         {
             LAC_SYM_STAT_INC(numSessionsRemoved, instanceHandle);
@@ -946,6 +947,55 @@ CpaStatus cpaCySymRemoveSession(const CpaInstanceHandle instanceHandle_in,
     return status;
 }
 
+/** @ingroup LacSym */
+CpaStatus icp_sal_CySymSessionSetPriority(CpaInstanceHandle instanceHandle_in,
+                                          CpaCySymSessionCtx pSessionCtx,
+                                          icp_sal_priority_t priority)
+{
+    CpaInstanceHandle instanceHandle = NULL;
+    lac_session_desc_t *pSessionDesc = NULL;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
+    {
+        instanceHandle = Lac_GetFirstHandle(SAL_SERVICE_TYPE_CRYPTO_SYM);
+    }
+    else
+    {
+        instanceHandle = instanceHandle_in;
+    }
+
+    LAC_CHECK_INSTANCE_HANDLE(instanceHandle);
+    SAL_CHECK_INSTANCE_TYPE(
+        instanceHandle,
+        (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    LAC_CHECK_NULL_PARAM(pSessionCtx);
+    pSessionDesc = LAC_SYM_SESSION_DESC_FROM_CTX_GET(pSessionCtx);
+    LAC_CHECK_NULL_PARAM(pSessionDesc);
+    if ((ICP_SAL_PRIORITY_NORMAL != priority) &&
+        (ICP_SAL_PRIORITY_HIGH != priority))
+    {
+        LAC_INVALID_PARAM_LOG("Invalid priority");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* Data plane requests are sent on the ring of the instance given to
+     * the data plane calls */
+    if (CPA_TRUE == pSessionDesc->isDPSession)
+    {
+        LAC_UNSUPPORTED_PARAM_LOG("Data plane sessions are not supported");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    if (0 != LacSymSession_PendingCbGet(pSessionDesc))
+    {
+        return CPA_STATUS_RETRY;
+    }
+
+    pSessionDesc->isHighPriority =
+        (ICP_SAL_PRIORITY_HIGH == priority) ? CPA_TRUE : CPA_FALSE;
+    return CPA_STATUS_SUCCESS;
+}
+
 CpaStatus cpaCySymUpdateSession(
     CpaCySymSessionCtx pSessionCtx,
     const CpaCySymSessionUpdateData *pSessionUpdateData)
@@ -980,6 +1030,7 @@ STATIC CpaStatus LacSym_Perform(const CpaInstanceHandle instanceHandle,
                                 CpaBoolean isAsyncMode)
 {
     lac_session_desc_t *pSessionDesc = NULL;
+    CpaInstanceHandle ringHandle = instanceHandle;
     CpaStatus status = CPA_STATUS_SUCCESS;
 
 #ifdef ICP_PARAM_CHECK
@@ -1093,7 +1144,17 @@ STATIC CpaStatus LacSym_Perform(const CpaInstanceHandle instanceHandle,
     }
 
 #endif /*ICP_PARAM_CHECK*/
-    status = LacAlgChain_Perform(instanceHandle,
+    /* High priority requests go to the ring pair paired with the instance,
+     * which then owns the cookie and completes the request */
+    if (unlikely(pSessionDesc->isHighPriority))
+    {
+        ringHandle = SalCtrl_PriorityRoute((sal_service_t *)instanceHandle);
+    }
+
+    ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_ENQUEUE,
+                  (LAC_ARCH_UINT)pOpData,
+                  ICP_SAL_TRACE_SERVICE_SYM);
+    status = LacAlgChain_Perform(ringHandle,
                                  pSessionDesc,
                                  callbackTag,
                                  pOpData,
@@ -1111,13 +1172,13 @@ STATIC CpaStatus LacSym_Perform(const CpaInstanceHandle instanceHandle,
                                             &pSessionDesc->partialState);
         }
         /* increment #requests stat */
-        LAC_SYM_STAT_INC(numSymOpRequests, instanceHandle);
+        LAC_SYM_STAT_INC(numSymOpRequests, ringHandle);
     }
     /* Retry also results in the errors stat been incremented */
     else
     {
         /* increment #errors stat */
-        LAC_SYM_STAT_INC(numSymOpRequestErrors, instanceHandle);
+        LAC_SYM_STAT_INC(numSymOpRequestErrors, ringHandle);
     }
     return status;
 }
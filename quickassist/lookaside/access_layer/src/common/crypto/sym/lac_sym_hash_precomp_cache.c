@@ -0,0 +1,630 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/**
+ ***************************************************************************
+ * @file lac_sym_hash_precomp_cache.c
+ *
+ * @ingroup LacHashPrecompCache
+ *
+ * Per-instance LRU cache of software hash precompute results
+ ***************************************************************************/
+
+/*
+******************************************************************************
+* Include public/global header files
+******************************************************************************
+*/
+
+#include "cpa.h"
+#include "cpa_cy_sym.h"
+#include "icp_sal_sym_precomp_cache.h"
+
+#include "Osal.h"
+#include "icp_accel_devices.h"
+#include "icp_adf_debug.h"
+
+/*
+*******************************************************************************
+* Include private header files
+*******************************************************************************
+*/
+#include "lac_common.h"
+#include "lac_mem.h"
+#include "lac_log.h"
+#include "lac_sal_types_crypto.h"
+#include "lac_sym_hash_precomp_cache.h"
+
+/**< Largest cached state: HMAC-SHA512 inner plus outer state */
+#define LAC_SYM_HASH_PRECOMP_CACHE_STATE_MAX (2 * 64)
+
+/**< Size of the SipHash key drawn for every cache generation */
+#define LAC_SYM_HASH_PRECOMP_CACHE_SECRET_SZ (16)
+
+typedef struct lac_sym_hash_precomp_cache_entry_s
+{
+    struct lac_sym_hash_precomp_cache_entry_s *pHashNext;
+    /**< Next entry in the same hash bucket */
+    struct lac_sym_hash_precomp_cache_entry_s *pLruPrev;
+    struct lac_sym_hash_precomp_cache_entry_s *pLruNext;
+    /**< LRU list, most recently used at the head */
+    Cpa64U digest[2];
+    CpaCySymHashAlgorithm hashAlgorithm;
+    Cpa32U authKeyLenInBytes;
+    Cpa32U stateSize;
+    /**< Size of each of the (up to two) states stored in state[] */
+    Cpa8U state[LAC_SYM_HASH_PRECOMP_CACHE_STATE_MAX];
+} lac_sym_hash_precomp_cache_entry_t;
+
+typedef struct lac_sym_hash_precomp_cache_s
+{
+    lac_lock_t lock;
+    /**< Serialises everything below */
+    volatile Cpa32U maxEntries;
+    /**< Capacity, 0 when disabled. Read unlocked as a fast-path hint */
+    Cpa32U numEntries;
+    Cpa32U bucketMask;
+    Cpa32U generation;
+    /**< Bumped on every (re)configuration */
+    Cpa8U secret[LAC_SYM_HASH_PRECOMP_CACHE_SECRET_SZ];
+    lac_sym_hash_precomp_cache_entry_t *pEntries;
+    lac_sym_hash_precomp_cache_entry_t **ppBuckets;
+    lac_sym_hash_precomp_cache_entry_t *pLruHead;
+    lac_sym_hash_precomp_cache_entry_t *pLruTail;
+    Cpa64U hits;
+    Cpa64U misses;
+    Cpa64U evictions;
+} lac_sym_hash_precomp_cache_t;
+
+/*
+ * SipHash-2-4 with 128-bit output (Aumasson, Bernstein). A keyed PRF lets
+ * entries be matched without storing the key or an unkeyed digest of it.
+ */
+#define SIP_ROTL(x, b) (((x) << (b)) | ((x) >> (64 - (b))))
+#define SIP_ROUND(v0, v1, v2, v3)                                              \
+    do                                                                         \
+    {                                                                          \
+        v0 += v1;                                                              \
+        v1 = SIP_ROTL(v1, 13);                                                 \
+        v1 ^= v0;                                                              \
+        v0 = SIP_ROTL(v0, 32);                                                 \
+        v2 += v3;                                                              \
+        v3 = SIP_ROTL(v3, 16);                                                 \
+        v3 ^= v2;                                                              \
+        v0 += v3;                                                              \
+        v3 = SIP_ROTL(v3, 21);                                                 \
+        v3 ^= v0;                                                              \
+        v2 += v1;                                                              \
+        v1 = SIP_ROTL(v1, 17);                                                 \
+        v1 ^= v2;                                                              \
+        v2 = SIP_ROTL(v2, 32);                                                 \
+    } while (0)
+
+STATIC Cpa64U LacSymHash_Load64Le(const Cpa8U *p, Cpa32U len)
+{
+    Cpa64U v = 0;
+
+    while (len--)
+    {
+        v = (v << 8) | p[len];
+    }
+    return v;
+}
+
+STATIC void LacSymHash_SipHash128(const Cpa8U *pSecret,
+                                  const Cpa8U *pIn,
+                                  Cpa32U len,
+                                  Cpa64U out[2])
+{
+    Cpa64U k0 = LacSymHash_Load64Le(pSecret, 8);
+    Cpa64U k1 = LacSymHash_Load64Le(pSecret + 8, 8);
+    Cpa64U v0 = 0x736f6d6570736575ULL ^ k0;
+    Cpa64U v1 = 0x646f72616e646f6dULL ^ k1 ^ 0xee;
+    Cpa64U v2 = 0x6c7967656e657261ULL ^ k0;
+    Cpa64U v3 = 0x7465646279746573ULL ^ k1;
+    Cpa64U m = 0;
+    Cpa32U left = len;
+    Cpa32U i = 0;
+
+    for (; left >= 8; left -= 8, pIn += 8)
+    {
+        m = LacSymHash_Load64Le(pIn, 8);
+        v3 ^= m;
+        SIP_ROUND(v0, v1, v2, v3);
+        SIP_ROUND(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+    m = ((Cpa64U)len << 56) | LacSymHash_Load64Le(pIn, left);
+    v3 ^= m;
+    SIP_ROUND(v0, v1, v2, v3);
+    SIP_ROUND(v0, v1, v2, v3);
+    v0 ^= m;
+
+    v2 ^= 0xee;
+    for (i = 0; i < 4; i++)
+    {
+        SIP_ROUND(v0, v1, v2, v3);
+    }
+    out[0] = v0 ^ v1 ^ v2 ^ v3;
+    v1 ^= 0xdd;
+    for (i = 0; i < 4; i++)
+    {
+        SIP_ROUND(v0, v1, v2, v3);
+    }
+    out[1] = v0 ^ v1 ^ v2 ^ v3;
+}
+
+STATIC CpaBoolean LacSymHash_PrecompCacheable(
+    CpaCySymHashAlgorithm hashAlgorithm)
+{
+    switch (hashAlgorithm)
+    {
+        case CPA_CY_SYM_HASH_MD5:
+        case CPA_CY_SYM_HASH_SHA1:
+        case CPA_CY_SYM_HASH_SHA224:
+        case CPA_CY_SYM_HASH_SHA256:
+        case CPA_CY_SYM_HASH_SHA384:
+        case CPA_CY_SYM_HASH_SHA512:
+        case CPA_CY_SYM_HASH_AES_XCBC:
+        case CPA_CY_SYM_HASH_AES_CMAC:
+            return CPA_TRUE;
+        default:
+            return CPA_FALSE;
+    }
+}
+
+STATIC lac_sym_hash_precomp_cache_t *LacSymHash_PrecompCacheGet(
+    CpaInstanceHandle instanceHandle)
+{
+    return (lac_sym_hash_precomp_cache_t *)((sal_crypto_service_t *)
+                                                instanceHandle)
+        ->pHashPrecompCache;
+}
+
+STATIC void LacSymHash_PrecompCacheLruUnlink(
+    lac_sym_hash_precomp_cache_t *pCache,
+    lac_sym_hash_precomp_cache_entry_t *pEntry)
+{
+    if (NULL != pEntry->pLruPrev)
+    {
+        pEntry->pLruPrev->pLruNext = pEntry->pLruNext;
+    }
+    else
+    {
+        pCache->pLruHead = pEntry->pLruNext;
+    }
+    if (NULL != pEntry->pLruNext)
+    {
+        pEntry->pLruNext->pLruPrev = pEntry->pLruPrev;
+    }
+    else
+    {
+        pCache->pLruTail = pEntry->pLruPrev;
+    }
+    pEntry->pLruPrev = NULL;
+    pEntry->pLruNext = NULL;
+}
+
+STATIC void LacSymHash_PrecompCacheLruPushHead(
+    lac_sym_hash_precomp_cache_t *pCache,
+    lac_sym_hash_precomp_cache_entry_t *pEntry)
+{
+    pEntry->pLruPrev = NULL;
+    pEntry->pLruNext = pCache->pLruHead;
+    if (NULL != pCache->pLruHead)
+    {
+        pCache->pLruHead->pLruPrev = pEntry;
+    }
+    else
+    {
+        pCache->pLruTail = pEntry;
+    }
+    pCache->pLruHead = pEntry;
+}
+
+STATIC void LacSymHash_PrecompCacheBucketUnlink(
+    lac_sym_hash_precomp_cache_t *pCache,
+    lac_sym_hash_precomp_cache_entry_t *pEntry)
+{
+    lac_sym_hash_precomp_cache_entry_t **ppLink =
+        &pCache->ppBuckets[pEntry->digest[0] & pCache->bucketMask];
+
+    while (NULL != *ppLink)
+    {
+        if (*ppLink == pEntry)
+        {
+            *ppLink = pEntry->pHashNext;
+            break;
+        }
+        ppLink = &(*ppLink)->pHashNext;
+    }
+    pEntry->pHashNext = NULL;
+}
+
+/* Zeroize and free all entries. Called with the lock held. */
+STATIC void LacSymHash_PrecompCacheRelease(lac_sym_hash_precomp_cache_t *pCache)
+{
+    if (NULL != pCache->pEntries)
+    {
+        osalMemZeroExplicit(
+            pCache->pEntries,
+            pCache->maxEntries * sizeof(lac_sym_hash_precomp_cache_entry_t));
+        LAC_OS_FREE(pCache->pEntries);
+    }
+    if (NULL != pCache->ppBuckets)
+    {
+        LAC_OS_FREE(pCache->ppBuckets);
+    }
+    osalMemZeroExplicit(pCache->secret, sizeof(pCache->secret));
+    pCache->maxEntries = 0;
+    pCache->numEntries = 0;
+    pCache->bucketMask = 0;
+    pCache->pLruHead = NULL;
+    pCache->pLruTail = NULL;
+}
+
+CpaStatus LacSymHash_PrecompCacheCreate(CpaInstanceHandle instanceHandle)
+{
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+    lac_sym_hash_precomp_cache_t *pCache = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = LAC_OS_MALLOC(&pCache, sizeof(lac_sym_hash_precomp_cache_t));
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    LAC_OS_BZERO(pCache, sizeof(lac_sym_hash_precomp_cache_t));
+
+    status = LAC_SPINLOCK_INIT(&pCache->lock);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_OS_FREE(pCache);
+        return CPA_STATUS_RESOURCE;
+    }
+    pService->pHashPrecompCache = pCache;
+    return CPA_STATUS_SUCCESS;
+}
+
+void LacSymHash_PrecompCacheDestroy(CpaInstanceHandle instanceHandle)
+{
+    sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
+    lac_sym_hash_precomp_cache_t *pCache =
+        (lac_sym_hash_precomp_cache_t *)pService->pHashPrecompCache;
+
+    if (NULL == pCache)
+    {
+        return;
+    }
+    LAC_SPINLOCK(&pCache->lock);
+    LacSymHash_PrecompCacheRelease(pCache);
+    LAC_SPINUNLOCK(&pCache->lock);
+    LAC_SPINLOCK_DESTROY(&pCache->lock);
+    pService->pHashPrecompCache = NULL;
+    LAC_OS_FREE(pCache);
+}
+
+CpaBoolean LacSymHash_PrecompCacheLookup(CpaInstanceHandle instanceHandle,
+                                         CpaCySymHashAlgorithm hashAlgorithm,
+                                         Cpa32U authKeyLenInBytes,
+                                         const Cpa8U *pAuthKey,
+                                         lac_sym_hash_precomp_cache_tag_t *pTag,
+                                         Cpa8U *pState1,
+                                         Cpa8U *pState2,
+                                         Cpa32U stateSize)
+{
+    lac_sym_hash_precomp_cache_t *pCache =
+        LacSymHash_PrecompCacheGet(instanceHandle);
+    lac_sym_hash_precomp_cache_entry_t *pEntry = NULL;
+    Cpa8U secret[LAC_SYM_HASH_PRECOMP_CACHE_SECRET_SZ];
+    Cpa32U generation = 0;
+    Cpa32U numStates = (NULL != pState2) ? 2 : 1;
+
+    pTag->valid = CPA_FALSE;
+
+    if (NULL == pCache || 0 == pCache->maxEntries ||
+        numStates * stateSize > LAC_SYM_HASH_PRECOMP_CACHE_STATE_MAX ||
+        CPA_TRUE != LacSymHash_PrecompCacheable(hashAlgorithm))
+    {
+        return CPA_FALSE;
+    }
+
+    /* Take a copy of the secret so the digest is computed unlocked */
+    LAC_SPINLOCK(&pCache->lock);
+    if (0 == pCache->maxEntries)
+    {
+        LAC_SPINUNLOCK(&pCache->lock);
+        return CPA_FALSE;
+    }
+    memcpy(secret, pCache->secret, sizeof(secret));
+    generation = pCache->generation;
+    LAC_SPINUNLOCK(&pCache->lock);
+
+    LacSymHash_SipHash128(secret, pAuthKey, authKeyLenInBytes, pTag->digest);
+    osalMemZeroExplicit(secret, sizeof(secret));
+    pTag->generation = generation;
+    pTag->hashAlgorithm = hashAlgorithm;
+    pTag->authKeyLenInBytes = authKeyLenInBytes;
+    pTag->valid = CPA_TRUE;
+
+    LAC_SPINLOCK(&pCache->lock);
+    if (generation == pCache->generation && 0 != pCache->maxEntries)
+    {
+        pEntry = pCache->ppBuckets[pTag->digest[0] & pCache->bucketMask];
+        while (NULL != pEntry)
+        {
+            if (pEntry->digest[0] == pTag->digest[0] &&
+                pEntry->digest[1] == pTag->digest[1] &&
+                pEntry->hashAlgorithm == hashAlgorithm &&
+                pEntry->authKeyLenInBytes == authKeyLenInBytes &&
+                pEntry->stateSize == stateSize)
+            {
+                break;
+            }
+            pEntry = pEntry->pHashNext;
+        }
+        if (NULL != pEntry)
+        {
+            memcpy(pState1, pEntry->state, stateSize);
+            if (NULL != pState2)
+            {
+                memcpy(pState2, pEntry->state + stateSize, stateSize);
+            }
+            LacSymHash_PrecompCacheLruUnlink(pCache, pEntry);
+            LacSymHash_PrecompCacheLruPushHead(pCache, pEntry);
+            pCache->hits++;
+        }
+        else
+        {
+            pCache->misses++;
+        }
+    }
+    LAC_SPINUNLOCK(&pCache->lock);
+
+    return (NULL != pEntry) ? CPA_TRUE : CPA_FALSE;
+}
+
+void LacSymHash_PrecompCacheInsert(CpaInstanceHandle instanceHandle,
+                                   const lac_sym_hash_precomp_cache_tag_t *pTag,
+                                   const Cpa8U *pState1,
+                                   const Cpa8U *pState2,
+                                   Cpa32U stateSize)
+{
+    lac_sym_hash_precomp_cache_t *pCache =
+        LacSymHash_PrecompCacheGet(instanceHandle);
+    lac_sym_hash_precomp_cache_entry_t *pEntry = NULL;
+    Cpa32U bucket = 0;
+
+    if (CPA_TRUE != pTag->valid || NULL == pCache)
+    {
+        return;
+    }
+
+    LAC_SPINLOCK(&pCache->lock);
+    if (pTag->generation != pCache->generation || 0 == pCache->maxEntries)
+    {
+        LAC_SPINUNLOCK(&pCache->lock);
+        return;
+    }
+
+    /* A concurrent setup with the same key may have got here first */
+    bucket = pTag->digest[0] & pCache->bucketMask;
+    for (pEntry = pCache->ppBuckets[bucket]; NULL != pEntry;
+         pEntry = pEntry->pHashNext)
+    {
+        if (pEntry->digest[0] == pTag->digest[0] &&
+            pEntry->digest[1] == pTag->digest[1] &&
+            pEntry->hashAlgorithm == pTag->hashAlgorithm &&
+            pEntry->authKeyLenInBytes == pTag->authKeyLenInBytes &&
+            pEntry->stateSize == stateSize)
+        {
+            LAC_SPINUNLOCK(&pCache->lock);
+            return;
+        }
+    }
+
+    if (pCache->numEntries < pCache->maxEntries)
+    {
+        pEntry = &pCache->pEntries[pCache->numEntries++];
+    }
+    else
+    {
+        pEntry = pCache->pLruTail;
+        LacSymHash_PrecompCacheLruUnlink(pCache, pEntry);
+        LacSymHash_PrecompCacheBucketUnlink(pCache, pEntry);
+        osalMemZeroExplicit(pEntry->state, sizeof(pEntry->state));
+        pCache->evictions++;
+    }
+
+    pEntry->digest[0] = pTag->digest[0];
+    pEntry->digest[1] = pTag->digest[1];
+    pEntry->hashAlgorithm = pTag->hashAlgorithm;
+    pEntry->authKeyLenInBytes = pTag->authKeyLenInBytes;
+    pEntry->stateSize = stateSize;
+    memcpy(pEntry->state, pState1, stateSize);
+    if (NULL != pState2)
+    {
+        memcpy(pEntry->state + stateSize, pState2, stateSize);
+    }
+    pEntry->pHashNext = pCache->ppBuckets[bucket];
+    pCache->ppBuckets[bucket] = pEntry;
+    LacSymHash_PrecompCacheLruPushHead(pCache, pEntry);
+    LAC_SPINUNLOCK(&pCache->lock);
+}
+
+STATIC sal_crypto_service_t *LacSymHash_PrecompCacheService(
+    CpaInstanceHandle instanceHandle_in)
+{
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
+    {
+        return (sal_crypto_service_t *)Lac_GetFirstHandle(
+            SAL_SERVICE_TYPE_CRYPTO_SYM);
+    }
+    return (sal_crypto_service_t *)instanceHandle_in;
+}
+
+CpaStatus icp_sal_SymPrecompCacheConfig(CpaInstanceHandle instanceHandle_in,
+                                        Cpa32U maxEntries)
+{
+    sal_crypto_service_t *pService =
+        LacSymHash_PrecompCacheService(instanceHandle_in);
+    lac_sym_hash_precomp_cache_t *pCache = NULL;
+    lac_sym_hash_precomp_cache_entry_t *pEntries = NULL;
+    lac_sym_hash_precomp_cache_entry_t **ppBuckets = NULL;
+    Cpa8U secret[LAC_SYM_HASH_PRECOMP_CACHE_SECRET_SZ];
+    Cpa32U numBuckets = 1;
+
+    LAC_CHECK_NULL_PARAM(pService);
+    SAL_CHECK_INSTANCE_TYPE(
+        pService, (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    if (maxEntries > ICP_SAL_SYM_PRECOMP_CACHE_MAX_ENTRIES)
+    {
+        LAC_INVALID_PARAM_LOG("maxEntries");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    pCache = (lac_sym_hash_precomp_cache_t *)pService->pHashPrecompCache;
+    if (NULL == pCache)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    if (0 != maxEntries)
+    {
+        if (OSAL_SUCCESS != osalGetRandomBytes(secret, sizeof(secret)))
+        {
+            LAC_LOG_ERROR("Failed to obtain precompute cache secret");
+            return CPA_STATUS_FAIL;
+        }
+        /* Power of two buckets, load factor at most one */
+        while (numBuckets < maxEntries)
+        {
+            numBuckets <<= 1;
+        }
+        if (CPA_STATUS_SUCCESS !=
+            LAC_OS_MALLOC(&pEntries,
+                          maxEntries *
+                              sizeof(lac_sym_hash_precomp_cache_entry_t)))
+        {
+            osalMemZeroExplicit(secret, sizeof(secret));
+            return CPA_STATUS_RESOURCE;
+        }
+        if (CPA_STATUS_SUCCESS !=
+            LAC_OS_MALLOC(&ppBuckets, numBuckets * sizeof(*ppBuckets)))
+        {
+            LAC_OS_FREE(pEntries);
+            osalMemZeroExplicit(secret, sizeof(secret));
+            return CPA_STATUS_RESOURCE;
+        }
+        LAC_OS_BZERO(pEntries,
+                     maxEntries * sizeof(lac_sym_hash_precomp_cache_entry_t));
+        LAC_OS_BZERO(ppBuckets, numBuckets * sizeof(*ppBuckets));
+    }
+
+    LAC_SPINLOCK(&pCache->lock);
+    LacSymHash_PrecompCacheRelease(pCache);
+    pCache->generation++;
+    pCache->hits = 0;
+    pCache->misses = 0;
+    pCache->evictions = 0;
+    if (0 != maxEntries)
+    {
+        memcpy(pCache->secret, secret, sizeof(secret));
+        pCache->pEntries = pEntries;
+        pCache->ppBuckets = ppBuckets;
+        pCache->bucketMask = numBuckets - 1;
+        pCache->maxEntries = maxEntries;
+    }
+    LAC_SPINUNLOCK(&pCache->lock);
+
+    osalMemZeroExplicit(secret, sizeof(secret));
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_SymPrecompCacheGetStats(
+    CpaInstanceHandle instanceHandle_in,
+    icp_sal_sym_precomp_cache_stats_t *pStats)
+{
+    sal_crypto_service_t *pService =
+        LacSymHash_PrecompCacheService(instanceHandle_in);
+    lac_sym_hash_precomp_cache_t *pCache = NULL;
+
+    LAC_CHECK_NULL_PARAM(pService);
+    LAC_CHECK_NULL_PARAM(pStats);
+    SAL_CHECK_INSTANCE_TYPE(
+        pService, (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
+    pCache = (lac_sym_hash_precomp_cache_t *)pService->pHashPrecompCache;
+    if (NULL == pCache)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    LAC_SPINLOCK(&pCache->lock);
+    pStats->hits = pCache->hits;
+    pStats->misses = pCache->misses;
+    pStats->evictions = pCache->evictions;
+    pStats->numEntries = pCache->numEntries;
+    pStats->maxEntries = pCache->maxEntries;
+    LAC_SPINUNLOCK(&pCache->lock);
+
+    return CPA_STATUS_SUCCESS;
+}
@@ -100,6 +100,11 @@
 #include "lac_sal.h"
 #include "lac_session.h"
 #include "lac_sym_hash_precomputes.h"
+#include "lac_sym_hash_precomp_cache.h"
+
+/**< XCBC (K1, K2, K3) and CMAC (K, K1, K2) precomputes are three blocks */
+#define LAC_SYM_HASH_AES_ECB_PRECOMP_SZ                                        \
+    (LAC_HASH_XCBC_PRECOMP_KEY_NUM * LAC_HASH_XCBC_MAC_BLOCK_SIZE)
 
 STATIC
 CpaStatus LacSymHash_Compute(CpaCySymHashAlgorithm hashAlgorithm,
@@ -221,6 +226,7 @@ CpaStatus LacSymHash_HmacPreComputes(CpaInstanceHandle instanceHandle,
         &pHmacOpadOpData->u.hmacQatData;
 
     lac_sym_qat_hash_alg_info_t *pHashAlgInfo = NULL;
+    lac_sym_hash_precomp_cache_tag_t cacheTag;
     Cpa32U i = 0;
     Cpa32U padLenBytes = 0;
 
@@ -232,6 +238,19 @@ CpaStatus LacSymHash_HmacPreComputes(CpaInstanceHandle instanceHandle,
     pHmacIpadOpData->stateSize = pHashAlgInfo->stateSize;
     pHmacOpadOpData->stateSize = pHashAlgInfo->stateSize;
 
+    if (CPA_TRUE == LacSymHash_PrecompCacheLookup(instanceHandle,
+                                                  hashAlgorithm,
+                                                  authKeyLenInBytes,
+                                                  pAuthKey,
+                                                  &cacheTag,
+                                                  pState1,
+                                                  pState2,
+                                                  pHashAlgInfo->stateSize))
+    {
+        callbackFn(pCallbackTag);
+        return CPA_STATUS_SUCCESS;
+    }
+
     /* Copy HMAC key into buffers */
     if (authKeyLenInBytes > 0)
     {
@@ -271,6 +290,11 @@ CpaStatus LacSymHash_HmacPreComputes(CpaInstanceHandle instanceHandle,
 
     if (CPA_STATUS_SUCCESS == status)
     {
+        LacSymHash_PrecompCacheInsert(instanceHandle,
+                                      &cacheTag,
+                                      pState1,
+                                      pState2,
+                                      pHashAlgInfo->stateSize);
         callbackFn(pCallbackTag);
     }
     return status;
@@ -288,6 +312,26 @@ CpaStatus LacSymHash_AesECBPreCompute(CpaInstanceHandle instanceHandle,
     CpaStatus status = CPA_STATUS_FAIL;
     Cpa32U stateSize = 0, x = 0;
     lac_sym_qat_hash_alg_info_t *pHashAlgInfo = NULL;
+    lac_sym_hash_precomp_cache_tag_t cacheTag;
+
+    cacheTag.valid = CPA_FALSE;
+    if (CPA_CY_SYM_HASH_AES_XCBC == hashAlgorithm ||
+        CPA_CY_SYM_HASH_AES_CMAC == hashAlgorithm)
+    {
+        if (CPA_TRUE ==
+            LacSymHash_PrecompCacheLookup(instanceHandle,
+                                          hashAlgorithm,
+                                          authKeyLenInBytes,
+                                          pAuthKey,
+                                          &cacheTag,
+                                          pState,
+                                          NULL,
+                                          LAC_SYM_HASH_AES_ECB_PRECOMP_SZ))
+        {
+            callbackFn(pCallbackTag);
+            return CPA_STATUS_SUCCESS;
+        }
+    }
 
     if (CPA_CY_SYM_HASH_AES_XCBC == hashAlgorithm)
     {
@@ -414,6 +458,11 @@ CpaStatus LacSymHash_AesECBPreCompute(CpaInstanceHandle instanceHandle,
     {
         return CPA_STATUS_INVALID_PARAM;
     }
+    LacSymHash_PrecompCacheInsert(instanceHandle,
+                                  &cacheTag,
+                                  pState,
+                                  NULL,
+                                  LAC_SYM_HASH_AES_ECB_PRECOMP_SZ);
     callbackFn(pCallbackTag);
     return status;
 }
@@ -421,10 +470,12 @@ CpaStatus LacSymHash_AesECBPreCompute(CpaInstanceHandle instanceHandle,
 CpaStatus LacSymHash_HmacPrecompInit(CpaInstanceHandle instanceHandle)
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
+    status = LacSymHash_PrecompCacheCreate(instanceHandle);
     return status;
 }
 
 void LacSymHash_HmacPrecompShutdown(CpaInstanceHandle instanceHandle)
 {
+    LacSymHash_PrecompCacheDestroy(instanceHandle);
     return;
 }
@@ -92,9 +92,47 @@
 #include "lac_log.h"
 #include "icp_qat_fw_la.h"
 #include "lac_sal_types_crypto.h"
+#include "lac_sal_ctrl.h"
 
 #define GetSingleBitFromByte(byte, bit) ((byte) & (1 << (bit)))
 
+#define DEQUEUE_MSGPUT_MAX_RETRIES 10000
+
+#define LAC_SYM_QUEUE_PTR(word)                                                \
+    ((lac_sym_bulk_cookie_t *)(LAC_ARCH_UINT)((word) & ~LAC_SYM_QUEUE_OWNED))
+
+/*
+*******************************************************************************
+* Define static function definitions
+*******************************************************************************
+*/
+
+/* Called by the owner of the queue when it is clear to send the request */
+STATIC void LacSymQueue_SessionIvUpdate(lac_session_desc_t *pSessionDesc,
+                                        lac_sym_bulk_cookie_t *pRequest)
+{
+    /* For cipher requests, we need to check if the session IV needs to be
+     * updated.  This can only be done when no other partials are in flight
+     * for this session, to ensure the cipherPartialOpState buffer in the
+     * session descriptor is not currently in use
+     */
+    if (CPA_TRUE == pRequest->updateSessionIvOnSend)
+    {
+        if (LAC_CIPHER_IS_ARC4(pSessionDesc->cipherAlgorithm))
+        {
+            memcpy(pSessionDesc->cipherPartialOpState,
+                   pSessionDesc->cipherARC4InitialState,
+                   LAC_CIPHER_ARC4_STATE_LEN_BYTES);
+        }
+        else
+        {
+            memcpy(pSessionDesc->cipherPartialOpState,
+                   pRequest->pOpData->pIv,
+                   pRequest->pOpData->ivLenInBytes);
+        }
+    }
+}
+
 /*
 *******************************************************************************
 * Define public/global function definitions
@@ -106,104 +144,183 @@ CpaStatus LacSymQueue_RequestSend(const CpaInstanceHandle instanceHandle,
                                   lac_session_desc_t *pSessionDesc)
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
-    CpaBoolean enqueued = CPA_FALSE;
     sal_crypto_service_t *pService = (sal_crypto_service_t *)instanceHandle;
-    /* Enqueue the message instead of sending directly if:
-     * (i) a blocking operation is in progress
-     * (ii) there are previous requests already in the queue
+    CpaBoolean isPartial =
+        (CPA_CY_SYM_PACKET_TYPE_FULL != pRequest->pOpData->packetType);
+    INT64 queue = 0;
+
+    /* Enqueue the message instead of sending directly if the queue has an
+     * owner, i.e. a blocking operation is in progress. A partial packet
+     * sent directly takes ownership, so subsequent requests are queued
+     * until it completes. Full packets on a session without a blocking
+     * operation are sent without writing to the queue.
      */
-    if ((CPA_FALSE == pSessionDesc->nonBlockingOpsInProgress) ||
-        (NULL != pSessionDesc->pRequestQueueTail))
+    queue = osalAtomicGet(&pSessionDesc->requestQueueIn);
+    for (;;)
     {
-        LAC_SPINLOCK(&pSessionDesc->requestQueueLock);
-
-        /* Re-check blockingOpsInProgress and pRequestQueueTail in case either
-         * changed before the lock was acquired.  The lock is shared with
-         * the callback context which drains this queue
-         */
-        if ((CPA_FALSE == pSessionDesc->nonBlockingOpsInProgress) ||
-            (NULL != pSessionDesc->pRequestQueueTail))
+        if (0 == queue)
         {
-            /* Enqueue the message and exit */
-            /* The FIFO queue is made up of a head and tail pointer.
-             * The head pointer points to the first/oldest, entry
-             * in the queue, and the tail pointer points to the last/newest
-             * entry in the queue
-             */
-
-            if (NULL != pSessionDesc->pRequestQueueTail)
+            if (!isPartial)
+            {
+                break;
+            }
+            queue = osalAtomicCmpXchg(
+                0, LAC_SYM_QUEUE_OWNED, &pSessionDesc->requestQueueIn);
+            if (0 == queue)
             {
-                /* Queue is non-empty. Add this request to the list */
-                pSessionDesc->pRequestQueueTail->pNext = pRequest;
+                break;
             }
-            else
+        }
+        else
+        {
+            /* Push on the list, the owner restores submission order */
+            pRequest->pNext = LAC_SYM_QUEUE_PTR(queue);
+            if (queue == osalAtomicCmpXchg(
+                             queue,
+                             (INT64)(LAC_ARCH_UINT)pRequest |
+                                 LAC_SYM_QUEUE_OWNED,
+                             &pSessionDesc->requestQueueIn))
             {
-                /* Queue is empty. Initialise the head pointer as well */
-                pSessionDesc->pRequestQueueHead = pRequest;
+                /* request is queued, don't send to QAT here */
+                return CPA_STATUS_SUCCESS;
             }
+            queue = osalAtomicGet(&pSessionDesc->requestQueueIn);
+        }
+    }
 
-            pSessionDesc->pRequestQueueTail = pRequest;
+    if (isPartial)
+    {
+        /* We own the queue, so no other partial is in flight */
+        LacSymQueue_SessionIvUpdate(pSessionDesc, pRequest);
+    }
 
-            /* request is queued, don't send to QAT here */
-            enqueued = CPA_TRUE;
-        }
-        LAC_SPINUNLOCK(&pSessionDesc->requestQueueLock);
+    /* Send to QAT */
+    status = SalQatMsg_transPutMsg(pService->trans_handle_sym_tx,
+                                   (void *)&(pRequest->qatMsg),
+                                   LAC_QAT_SYM_REQ_SZ_LW,
+                                   LAC_LOG_MSG_SYMCYBULK,
+                                   NULL);
+    /* if fail to send request, give up ownership, sending any requests
+     * queued in the meantime
+     */
+    if ((CPA_STATUS_SUCCESS != status) && isPartial)
+    {
+        (void)LacSymQueue_Release(pSessionDesc);
+    }
+    return status;
+}
+
+void LacSymQueue_Block(lac_session_desc_t *pSessionDesc)
+{
+    /* Nothing is in flight, so the queue is free unless an earlier
+     * precompute still holds it */
+    (void)osalAtomicCmpXchg(
+        0, LAC_SYM_QUEUE_OWNED, &pSessionDesc->requestQueueIn);
+}
+
+CpaStatus LacSymQueue_Release(lac_session_desc_t *pSessionDesc)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    sal_crypto_service_t *pService =
+        (sal_crypto_service_t *)pSessionDesc->pInstance;
+    lac_sym_bulk_cookie_t *pRequest = NULL;
+    lac_sym_bulk_cookie_t *pList = NULL;
+    lac_sym_bulk_cookie_t *pNext = NULL;
+    Cpa32U retries = 0;
+    INT64 queue = 0;
+
+    /* Queued requests follow the ring pair their session is sent on */
+    if (unlikely(pSessionDesc->isHighPriority))
+    {
+        pService = (sal_crypto_service_t *)SalCtrl_PriorityRoute(
+            &pService->generic_service_info);
     }
 
-    if (CPA_FALSE == enqueued)
+    for (;;)
     {
-        /* If we send a partial packet request, set the blockingOpsInProgress
-         * flag for the session to indicate that subsequent requests must be
-         * queued up until this request completes
-         *
-         * @assumption
-         * If we have got here it means that there were no previous blocking
-         * operations in progress and, since multiple partial packet requests
-         * on a given session cannot be issued concurrently, there should be
-         * no need for a critical section around the following code
-         */
+        if (NULL == pSessionDesc->pRequestQueueHead)
+        {
+            queue = osalAtomicGet(&pSessionDesc->requestQueueIn);
+            if (0 == queue)
+            {
+                /* Not owned, nothing to release */
+                return CPA_STATUS_SUCCESS;
+            }
+            if (LAC_SYM_QUEUE_OWNED == queue)
+            {
+                /* Queue is empty, give up ownership unless a request was
+                 * pushed meanwhile */
+                if (LAC_SYM_QUEUE_OWNED ==
+                    osalAtomicCmpXchg(LAC_SYM_QUEUE_OWNED,
+                                      0,
+                                      &pSessionDesc->requestQueueIn))
+                {
+                    return CPA_STATUS_SUCCESS;
+                }
+                continue;
+            }
+
+            /* Take every queued request at once and reverse the list into
+             * submission order */
+            queue = osalAtomicTestAndSet(LAC_SYM_QUEUE_OWNED,
+                                         &pSessionDesc->requestQueueIn);
+            pList = LAC_SYM_QUEUE_PTR(queue);
+            while (NULL != pList)
+            {
+                pNext = pList->pNext;
+                pList->pNext = pSessionDesc->pRequestQueueHead;
+                pSessionDesc->pRequestQueueHead = pList;
+                pList = pNext;
+            }
+            continue;
+        }
+
+        pRequest = pSessionDesc->pRequestQueueHead;
         if (CPA_CY_SYM_PACKET_TYPE_FULL != pRequest->pOpData->packetType)
         {
-            /* Select blocking operations which this request will complete */
-            pSessionDesc->nonBlockingOpsInProgress = CPA_FALSE;
+            LacSymQueue_SessionIvUpdate(pSessionDesc, pRequest);
         }
 
-        /* At this point, we're clear to send the request.  For cipher requests,
-         * we need to check if the session IV needs to be updated.  This can
-         * only be done when no other partials are in flight for this session,
-         * to ensure the cipherPartialOpState buffer in the session descriptor
-         * is not currently in use
+        /*
+         * Now we'll attempt to send the message directly to QAT. We'll keep
+         * looking until it succeeds (or at least a very high number of
+         * retries), as the failure only happens when the ring is full,
+         * and this is only a temporary situation. After a few retries,
+         * space will become available, allowing the putMsg to succeed.
          */
-        if (CPA_TRUE == pRequest->updateSessionIvOnSend)
+        retries = 0;
+        do
         {
-            if (LAC_CIPHER_IS_ARC4(pSessionDesc->cipherAlgorithm))
-            {
-                memcpy(pSessionDesc->cipherPartialOpState,
-                       pSessionDesc->cipherARC4InitialState,
-                       LAC_CIPHER_ARC4_STATE_LEN_BYTES);
-            }
-            else
+            /* Send directly to QAT */
+            status = icp_adf_transPutMsg(pService->trans_handle_sym_tx,
+                                         (void *)&(pRequest->qatMsg),
+                                         LAC_QAT_SYM_REQ_SZ_LW,
+                                         NULL);
+
+            retries++;
+            /*
+             * Yield to allow other threads that may be on this session to poll
+             * and make some space on the ring
+             */
+            if (CPA_STATUS_SUCCESS != status)
             {
-                memcpy(pSessionDesc->cipherPartialOpState,
-                       pRequest->pOpData->pIv,
-                       pRequest->pOpData->ivLenInBytes);
+                osalYield();
             }
+        } while ((CPA_STATUS_SUCCESS != status) &&
+                 (retries < DEQUEUE_MSGPUT_MAX_RETRIES));
+
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            LAC_LOG_ERROR(
+                "Failed to icp_adf_transPutMsg, maximum retries exceeded.");
+            return status;
         }
 
-        /* Send to QAT */
-        status = SalQatMsg_transPutMsg(pService->trans_handle_sym_tx,
-                                       (void *)&(pRequest->qatMsg),
-                                       LAC_QAT_SYM_REQ_SZ_LW,
-                                       LAC_LOG_MSG_SYMCYBULK,
-                                       NULL);
-        /* if fail to send request, we need to change nonBlockingOpsInProgress
-         * to CPA_TRUE
-         */
-        if ((CPA_STATUS_SUCCESS != status) &&
-            (CPA_CY_SYM_PACKET_TYPE_FULL != pRequest->pOpData->packetType))
+        pSessionDesc->pRequestQueueHead = pRequest->pNext;
+        if (CPA_CY_SYM_PACKET_TYPE_FULL != pRequest->pOpData->packetType)
         {
-            pSessionDesc->nonBlockingOpsInProgress = CPA_TRUE;
+            /* Ownership passes to the partial packet */
+            return CPA_STATUS_SUCCESS;
         }
     }
-    return status;
 }
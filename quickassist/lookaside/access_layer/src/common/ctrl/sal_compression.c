@@ -109,6 +109,7 @@
 #include "icp_qat_hw_20_comp_defs.h"
 #include "icp_sal_versions.h"
 #include "lac_sw_responses.h"
+#include "dc_sw_fallback.h"
 
 #ifndef ICP_DC_ONLY
 #include "dc_chain.h"
@@ -1054,7 +1055,18 @@ CpaStatus SalCtrl_CompressionShutdown(icp_accel_dev_t *device,
         return CPA_STATUS_FAIL;
     }
 
+#ifdef ICP_DC_SW_FALLBACK
+    /* Requests queued on the host complete before the instance goes */
+    dcSwFallbackShutdown(pCompressionService);
+#endif
 
+    /* Requests held for a restart which never came complete now */
+    if (LAC_MEM_POOL_INIT_POOL_ID !=
+        pCompressionService->compression_mem_pool)
+    {
+        (void)LacSwResp_ReplayFlush(pCompressionService->compression_mem_pool,
+                                    SAL_SERVICE_TYPE_COMPRESSION);
+    }
     Lac_MemPoolDestroy(pCompressionService->compression_mem_pool);
 
     status = icp_adf_transReleaseHandle(
@@ -1304,6 +1316,11 @@ CpaStatus SalCtrl_CompressionRestarted(icp_accel_dev_t *device,
     /* Initialize Data Compression Cookies */
     Lac_MemPoolInitDcCookies(pCompressionService->compression_mem_pool);
 
+    /* Resubmit the requests held when the device failed */
+    (void)LacSwResp_Replay(pCompressionService->compression_mem_pool,
+                           SAL_SERVICE_TYPE_COMPRESSION,
+                           pCompressionService->trans_handle_compression_tx);
+
     return status;
 
 cleanup:
@@ -1712,6 +1729,7 @@ CpaStatus cpaDcStopInstance(CpaInstanceHandle instanceHandle)
     CpaInstanceHandle insHandle = NULL;
     icp_accel_dev_t *dev = NULL;
     sal_compression_service_t *pService = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
 
 #ifdef ICP_TRACE
     LAC_LOG1("Called with params (0x%lx)\n", (LAC_ARCH_UINT)instanceHandle);
@@ -1729,6 +1747,17 @@ CpaStatus cpaDcStopInstance(CpaInstanceHandle instanceHandle)
     LAC_CHECK_NULL_PARAM(insHandle);
     pService = (sal_compression_service_t *)insHandle;
 
+    status = SalCtrl_PriorityPairStop(&pService->generic_service_info);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_LOG_ERROR("There are remaining messages on the high priority ring");
+        return status;
+    }
+
+#ifdef ICP_DC_SW_FALLBACK
+    dcSwFallbackShutdown(pService);
+#endif
+
     /* Free Intermediate Buffer Pointers Array */
     if (pService->pInterBuffPtrsArray != NULL)
     {
@@ -2223,6 +2252,44 @@ CpaStatus cpaDcSetAddressTranslation(const CpaInstanceHandle instanceHandle,
     return CPA_STATUS_SUCCESS;
 }
 
+/**
+ ******************************************************************************
+ * @ingroup cpaDcCommon
+ * Polls the response ring of a DC instance, or generates the responses of
+ * its requests in flight when its device is in error.
+ *****************************************************************************/
+STATIC CpaStatus SalCtrl_DcPollRings(sal_compression_service_t *dc_handle,
+                                     Cpa32U response_quota)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    icp_comms_trans_handle trans_hndTable[DC_NUM_RX_RINGS];
+
+    if ((Sal_ServiceIsInError(dc_handle)))
+    {
+        LAC_LOG_DEBUG("PollDcInstance: generate dummy responses\n");
+        status = SalCtrl_DcGenResponses(dc_handle);
+        if ((CPA_STATUS_SUCCESS != status) && (CPA_STATUS_RETRY != status))
+        {
+            LAC_LOG_ERROR("Failed to generate SW responses for DC\n");
+        }
+        return status;
+    }
+
+    SAL_RUNNING_CHECK(dc_handle);
+
+    /*
+     * From the instanceHandle we must get the trans_handle and send
+     * down to adf for polling.
+     * Populate our trans handle table with the appropriate handles.
+     */
+    trans_hndTable[0] = dc_handle->trans_handle_compression_rx;
+
+    /* Call adf to do the polling. */
+    status =
+        icp_adf_pollInstance(trans_hndTable, DC_NUM_RX_RINGS, response_quota);
+    return status;
+}
+
 /**
  ******************************************************************************
  * @ingroup cpaDcCommon
@@ -2233,9 +2300,11 @@ CpaStatus icp_sal_DcPollInstance(CpaInstanceHandle instanceHandle_in,
                                  Cpa32U response_quota)
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaStatus highStatus = CPA_STATUS_RETRY;
     sal_compression_service_t *dc_handle = NULL;
     sal_service_t *gen_handle = NULL;
-    icp_comms_trans_handle trans_hndTable[DC_NUM_RX_RINGS];
+    sal_service_t *pHigh = NULL;
+    Cpa32U highQuota = 0;
 
     if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
     {
@@ -2255,29 +2324,22 @@ CpaStatus icp_sal_DcPollInstance(CpaInstanceHandle instanceHandle_in,
         return CPA_STATUS_FAIL;
     }
 
-    if ((Sal_ServiceIsInError(dc_handle)))
+    /* The ring of the high priority requests is polled first, the quota
+     * keeps a share for the instance's own ring */
+    pHigh = __atomic_load_n(&gen_handle->pPriorityHigh, __ATOMIC_ACQUIRE);
+    if (unlikely(NULL != pHigh))
     {
-        LAC_LOG_DEBUG("PollDcInstance: generate dummy responses\n");
-        status = SalCtrl_DcGenResponses(dc_handle);
-        if ((CPA_STATUS_SUCCESS != status) && (CPA_STATUS_RETRY != status))
-        {
-            LAC_LOG_ERROR("Failed to generate SW responses for DC\n");
-        }
-        return status;
+        SalCtrl_PriorityQuota(
+            gen_handle, response_quota, &highQuota, &response_quota);
+        highStatus =
+            SalCtrl_DcPollRings((sal_compression_service_t *)pHigh, highQuota);
     }
 
-    SAL_RUNNING_CHECK(dc_handle);
-
-    /*
-     * From the instanceHandle we must get the trans_handle and send
-     * down to adf for polling.
-     * Populate our trans handle table with the appropriate handles.
-     */
-    trans_hndTable[0] = dc_handle->trans_handle_compression_rx;
-
-    /* Call adf to do the polling. */
-    status =
-        icp_adf_pollInstance(trans_hndTable, DC_NUM_RX_RINGS, response_quota);
+    status = SalCtrl_DcPollRings(dc_handle, response_quota);
+    if ((CPA_STATUS_RETRY == status) && (CPA_STATUS_SUCCESS == highStatus))
+    {
+        status = CPA_STATUS_SUCCESS;
+    }
     return status;
 }
 
@@ -118,6 +118,7 @@
 #include "lac_sym_hash.h"
 #include "lac_sym_cb.h"
 #include "lac_sym_stats.h"
+#include "lac_sym_drbg.h"
 #include "lac_pke_utils.h"
 #include "lac_pke_qat_comms.h"
 #include "lac_ec.h"
@@ -519,6 +520,13 @@ STATIC CpaStatus SalCtrl_AsymFreeResources(sal_crypto_service_t *pCryptoService)
 
     CpaStatus status = CPA_STATUS_SUCCESS;
 
+    /* Requests held for a restart which never came complete now */
+    if (LAC_MEM_POOL_INIT_POOL_ID != pCryptoService->lac_pke_req_pool)
+    {
+        (void)LacSwResp_ReplayFlush(pCryptoService->lac_pke_req_pool,
+                                    SAL_SERVICE_TYPE_CRYPTO_ASYM);
+    }
+
     /* Free memory pools if not NULL */
     Lac_MemPoolDestroy(pCryptoService->lac_pke_align_pool);
     Lac_MemPoolDestroy(pCryptoService->lac_pke_req_pool);
@@ -594,6 +602,7 @@ STATIC CpaStatus SalCtrl_SymFreeResources(sal_crypto_service_t *pCryptoService)
 
     /* Free statistics */
     LacSym_StatsFree(pCryptoService);
+    LacDrbg_StatsFree(pCryptoService);
 
     /* Free transport handles */
     status = SalCtrl_SymReleaseTransHandle((sal_service_t *)pCryptoService);
@@ -611,6 +620,7 @@ STATIC CpaStatus SalCtrl_SymFreeResources(sal_crypto_service_t *pCryptoService)
 STATIC CpaStatus SalCtrl_SymResetResources(sal_crypto_service_t *pCryptoService)
 {
     LacSymKey_StatsReset(pCryptoService);
+    LacDrbg_StatsReset(pCryptoService);
 
     /* Reset transport handles */
     return SalCtrl_SymResetTransHandle((sal_service_t *)pCryptoService);
@@ -1829,6 +1839,11 @@ STATIC CpaStatus SalCtrl_AsymReinit(icp_accel_dev_t *device,
     Lac_MemPoolInitAsymCookies(pCryptoService->lac_pke_req_pool,
                                pCryptoService);
 
+    /* Resubmit the requests held when the device failed */
+    (void)LacSwResp_Replay(pCryptoService->lac_pke_req_pool,
+                           SAL_SERVICE_TYPE_CRYPTO_ASYM,
+                           pCryptoService->trans_handle_asym_tx);
+
     return status;
 }
 #endif
@@ -1918,6 +1933,10 @@ STATIC CpaStatus SalCtrl_SymInit(icp_accel_dev_t *device,
     status = LacSym_StatsInit(pCryptoService);
     LAC_CHECK_STATUS_SYM_INIT(status);
 
+    /* Runs the DRBG known answer tests and allocates the DRBG stats */
+    status = LacDrbg_Init(pCryptoService);
+    LAC_CHECK_STATUS_SYM_INIT(status);
+
     return status;
 }
 
@@ -2652,7 +2671,16 @@ void SalCtrl_CyQueryCapabilities(sal_service_t *pGenericService,
         }
 #endif
     }
-    pCapInfo->drbgSupported = CPA_FALSE;
+    /* The DRBG is implemented in software on symmetric instances */
+    if (SAL_SERVICE_TYPE_CRYPTO == pGenericService->type ||
+        SAL_SERVICE_TYPE_CRYPTO_SYM == pGenericService->type)
+    {
+        pCapInfo->drbgSupported = CPA_TRUE;
+    }
+    else
+    {
+        pCapInfo->drbgSupported = CPA_FALSE;
+    }
     pCapInfo->nrbgSupported = CPA_FALSE;
     pCapInfo->randSupported = CPA_FALSE;
 }
@@ -2883,6 +2911,7 @@ CpaStatus cpaCyStopInstance(CpaInstanceHandle instanceHandle_in)
     CpaInstanceHandle instanceHandle = NULL;
     icp_accel_dev_t *dev = NULL;
     sal_crypto_service_t *pService = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
 
 #ifdef ICP_TRACE
     LAC_LOG1("Called with params (0x%lx)\n", (LAC_ARCH_UINT)instanceHandle_in);
@@ -2904,6 +2933,13 @@ CpaStatus cpaCyStopInstance(CpaInstanceHandle instanceHandle_in)
 
     pService = (sal_crypto_service_t *)instanceHandle;
 
+    status = SalCtrl_PriorityPairStop(&pService->generic_service_info);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        LAC_LOG_ERROR("There are remaining messages on the high priority ring");
+        return status;
+    }
+
     dev = icp_adf_getAccelDevByAccelId(pService->acceleratorNum);
     if (NULL == dev)
     {
@@ -3276,33 +3312,17 @@ CpaStatus cpaCySetAddressTranslation(const CpaInstanceHandle instanceHandle_in,
 /**
  ******************************************************************************
  * @ingroup cpaCyCommon
- * Crypto specific polling function which polls a crypto instance.
+ * Polls the response rings of a crypto instance, or generates the responses
+ * of its requests in flight when its device is in error.
  *****************************************************************************/
-CpaStatus icp_sal_CyPollInstance(CpaInstanceHandle instanceHandle_in,
-                                 Cpa32U response_quota)
+STATIC CpaStatus SalCtrl_CyPollRings(sal_crypto_service_t *crypto_handle,
+                                     Cpa32U response_quota)
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
-    sal_crypto_service_t *crypto_handle = NULL;
-    sal_service_t *gen_handle = NULL;
+    sal_service_t *gen_handle = &(crypto_handle->generic_service_info);
     icp_comms_trans_handle trans_hndTable[MAX_CY_RX_RINGS];
     Cpa32U num_rx_rings = 0;
 
-    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
-    {
-        crypto_handle = (sal_crypto_service_t *)Lac_CryptoGetFirstHandle();
-    }
-    else
-    {
-        crypto_handle = (sal_crypto_service_t *)instanceHandle_in;
-    }
-    LAC_CHECK_NULL_PARAM(crypto_handle);
-    SAL_CHECK_INSTANCE_TYPE(crypto_handle,
-                            (SAL_SERVICE_TYPE_CRYPTO |
-                             SAL_SERVICE_TYPE_CRYPTO_ASYM |
-                             SAL_SERVICE_TYPE_CRYPTO_SYM));
-
-    gen_handle = &(crypto_handle->generic_service_info);
-
     if ((Sal_ServiceIsInError(crypto_handle)))
     {
 
@@ -3347,6 +3367,78 @@ CpaStatus icp_sal_CyPollInstance(CpaInstanceHandle instanceHandle_in,
     return status;
 }
 
+/**
+ ******************************************************************************
+ * @ingroup cpaCyCommon
+ * Polls the symmetric response ring of a crypto instance.
+ *****************************************************************************/
+STATIC CpaStatus SalCtrl_CyPollSymRings(sal_crypto_service_t *crypto_handle,
+                                        Cpa32U response_quota)
+{
+    icp_comms_trans_handle trans_hndTable[NUM_CRYPTO_SYM_RX_RINGS] = {0};
+
+    SAL_RUNNING_CHECK(crypto_handle);
+    /*
+     * From the instanceHandle we must get the trans_handle and send
+     * down to adf for polling.
+     * Populate trans handle table with the appropriate handle.
+     */
+    trans_hndTable[TH_CY_RX_0] = crypto_handle->trans_handle_sym_rx;
+    /* Call adf to do the polling. */
+    return icp_adf_pollInstance(
+        trans_hndTable, NUM_CRYPTO_SYM_RX_RINGS, response_quota);
+}
+
+/**
+ ******************************************************************************
+ * @ingroup cpaCyCommon
+ * Crypto specific polling function which polls a crypto instance.
+ *****************************************************************************/
+CpaStatus icp_sal_CyPollInstance(CpaInstanceHandle instanceHandle_in,
+                                 Cpa32U response_quota)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaStatus highStatus = CPA_STATUS_RETRY;
+    sal_crypto_service_t *crypto_handle = NULL;
+    sal_service_t *pHigh = NULL;
+    Cpa32U highQuota = 0;
+
+    if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
+    {
+        crypto_handle = (sal_crypto_service_t *)Lac_CryptoGetFirstHandle();
+    }
+    else
+    {
+        crypto_handle = (sal_crypto_service_t *)instanceHandle_in;
+    }
+    LAC_CHECK_NULL_PARAM(crypto_handle);
+    SAL_CHECK_INSTANCE_TYPE(crypto_handle,
+                            (SAL_SERVICE_TYPE_CRYPTO |
+                             SAL_SERVICE_TYPE_CRYPTO_ASYM |
+                             SAL_SERVICE_TYPE_CRYPTO_SYM));
+
+    /* The rings of the high priority requests are polled first, the quota
+     * keeps a share for the instance's own rings */
+    pHigh = __atomic_load_n(&crypto_handle->generic_service_info.pPriorityHigh,
+                            __ATOMIC_ACQUIRE);
+    if (unlikely(NULL != pHigh))
+    {
+        SalCtrl_PriorityQuota(&crypto_handle->generic_service_info,
+                              response_quota,
+                              &highQuota,
+                              &response_quota);
+        highStatus =
+            SalCtrl_CyPollRings((sal_crypto_service_t *)pHigh, highQuota);
+    }
+
+    status = SalCtrl_CyPollRings(crypto_handle, response_quota);
+    if ((CPA_STATUS_RETRY == status) && (CPA_STATUS_SUCCESS == highStatus))
+    {
+        status = CPA_STATUS_SUCCESS;
+    }
+    return status;
+}
+
 /*
  ******************************************************************************
  * @ingroup cpaCyCommon
@@ -3356,8 +3448,10 @@ CpaStatus icp_sal_CyPollSymRing(CpaInstanceHandle instanceHandle_in,
                                 Cpa32U response_quota)
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaStatus highStatus = CPA_STATUS_RETRY;
     sal_crypto_service_t *crypto_handle = NULL;
-    icp_comms_trans_handle trans_hndTable[NUM_CRYPTO_SYM_RX_RINGS] = {0};
+    sal_service_t *pHigh = NULL;
+    Cpa32U highQuota = 0;
 
     if (CPA_INSTANCE_HANDLE_SINGLE == instanceHandle_in)
     {
@@ -3371,16 +3465,24 @@ CpaStatus icp_sal_CyPollSymRing(CpaInstanceHandle instanceHandle_in,
     LAC_CHECK_NULL_PARAM(crypto_handle);
     SAL_CHECK_INSTANCE_TYPE(
         crypto_handle, (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM));
-    SAL_RUNNING_CHECK(crypto_handle);
-    /*
-     * From the instanceHandle we must get the trans_handle and send
-     * down to adf for polling.
-     * Populate trans handle table with the appropriate handle.
-     */
-    trans_hndTable[TH_CY_RX_0] = crypto_handle->trans_handle_sym_rx;
-    /* Call adf to do the polling. */
-    status = icp_adf_pollInstance(
-        trans_hndTable, NUM_CRYPTO_SYM_RX_RINGS, response_quota);
+
+    pHigh = __atomic_load_n(&crypto_handle->generic_service_info.pPriorityHigh,
+                            __ATOMIC_ACQUIRE);
+    if (unlikely(NULL != pHigh))
+    {
+        SalCtrl_PriorityQuota(&crypto_handle->generic_service_info,
+                              response_quota,
+                              &highQuota,
+                              &response_quota);
+        highStatus =
+            SalCtrl_CyPollSymRings((sal_crypto_service_t *)pHigh, highQuota);
+    }
+
+    status = SalCtrl_CyPollSymRings(crypto_handle, response_quota);
+    if ((CPA_STATUS_RETRY == status) && (CPA_STATUS_SUCCESS == highStatus))
+    {
+        status = CPA_STATUS_SUCCESS;
+    }
     return status;
 }
 
@@ -517,9 +517,20 @@ STATIC CpaStatus SalCtrl_ServiceShutdown(icp_accel_dev_t *device,
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
     sal_service_t *inst = (sal_service_t *)SalList_getObject(*services);
+    sal_list_t *curr_element = *services;
 #ifndef KERNEL_SPACE
     Sal_CleanMiscErrStats(inst);
+    SalCtrl_TelemetryLock();
 #endif
+    /* The pairs are removed whatever the requests in flight, which the
+     * shutdown completes */
+    while (NULL != curr_element)
+    {
+        SalCtrl_PriorityPairRemove(
+            (sal_service_t *)SalList_getObject(curr_element));
+        curr_element = SalList_next(curr_element);
+    }
+
     /* Call Shutdown function for each service instance */
     SAL_FOR_EACH(*services, sal_service_t, device, shutdown, status);
 
@@ -529,8 +540,14 @@ STATIC CpaStatus SalCtrl_ServiceShutdown(icp_accel_dev_t *device,
         *debug_dir = NULL;
     }
 
+    /* Drop the dispatcher's per-thread choices before the instances go */
+    SalCtrl_DispatchInvalidate();
+
     /* Free Sal services controller memory */
     SalList_free(services);
+#ifndef KERNEL_SPACE
+    SalCtrl_TelemetryUnlock();
+#endif
     return status;
 }
 
@@ -1864,17 +1881,42 @@ STATIC CpaStatus SalCtrl_ServiceEventHandler(icp_accel_dev_t *device,
 
 CpaStatus SalCtrl_AdfServicesRegister(void)
 {
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    /* The services create their memory pools when they are started */
+    status = Lac_MemPoolsInit();
+    LAC_CHECK_STATUS(status);
+    status = SalCtrl_PriorityInit();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        Lac_MemPoolsExit();
+        return status;
+    }
+
     /* Fill out the global sal_service_reg_handle structure */
     sal_service_reg_handle.subserviceEventHandler = SalCtrl_ServiceEventHandler;
     /* Set subsystem name to globally defined name */
     sal_service_reg_handle.subsystem_name = subsystem_name;
 
-    return icp_adf_subsystemRegister(&sal_service_reg_handle);
+    status = icp_adf_subsystemRegister(&sal_service_reg_handle);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        SalCtrl_PriorityExit();
+        Lac_MemPoolsExit();
+    }
+    return status;
 }
 
 CpaStatus SalCtrl_AdfServicesUnregister(void)
 {
-    return icp_adf_subsystemUnregister(&sal_service_reg_handle);
+    CpaStatus status = icp_adf_subsystemUnregister(&sal_service_reg_handle);
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        SalCtrl_PriorityExit();
+        Lac_MemPoolsExit();
+    }
+    return status;
 }
 
 CpaStatus SalCtrl_AdfServicesStartedCheck(void)
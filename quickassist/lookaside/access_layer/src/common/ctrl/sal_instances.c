@@ -95,11 +95,33 @@
 /* ADF includes */
 #include "icp_accel_devices.h"
 #include "icp_adf_accel_mgr.h"
+#include "icp_adf_transport.h"
 
 /* SAL includes */
+#include "icp_sal_congestion_mgmt.h"
+#include "icp_sal_priority.h"
 #include "lac_mem.h"
 #include "lac_list.h"
 #include "lac_sal_types.h"
+#include "lac_sal_ctrl.h"
+#ifndef ICP_DC_ONLY
+#include "lac_sal_types_crypto.h"
+#endif
+#include "sal_types_compression.h"
+#include "sal_service_state.h"
+
+/* Score added to an instance on another NUMA node than the thread */
+#define SAL_DISPATCH_REMOTE_PENALTY (SAL_DISPATCH_LOAD_SCALE / 4)
+
+/* Score margin by which another instance must beat the current one */
+#define SAL_DISPATCH_HYSTERESIS (SAL_DISPATCH_LOAD_SCALE / 16)
+
+/* Bumped whenever instances are freed, so that no thread keeps a handle to
+ * a freed instance. It starts at 1 so that zeroed choices are stale. */
+STATIC OsalAtomic salDispatchGeneration = 1;
+
+/* Serialises the setting and removal of priority pairs */
+STATIC lac_lock_t salPriorityLock;
 
 #ifndef ICP_DC_ONLY
 /**
@@ -503,3 +525,403 @@ CpaStatus cpaFreeInstance(CpaInstanceHandle instanceHandle)
 {
     return CPA_STATUS_UNSUPPORTED;
 }
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+void SalCtrl_DispatchInvalidate(void)
+{
+    osalAtomicInc(&salDispatchGeneration);
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+Cpa64U SalCtrl_DispatchGeneration(void)
+{
+    return (Cpa64U)osalAtomicGet(&salDispatchGeneration);
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+CpaStatus SalCtrl_DispatchScore(CpaInstanceHandle instanceHandle,
+                                CpaAccelerationServiceType serviceType,
+                                Cpa32U node,
+                                Cpa32U *pScore)
+{
+    sal_service_t *pService = (sal_service_t *)instanceHandle;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U maxInflight = 0;
+    Cpa32U numInflight = 0;
+    Cpa32U maxTotal = 0;
+    Cpa32U numTotal = 0;
+    Cpa32U instanceNode = 0;
+
+    /* The ring pair of an instance taking high priority requests is kept
+     * for them */
+    if ((CPA_TRUE != pService->isInstanceStarted) ||
+        (CPA_TRUE != Sal_ServiceIsRunning(instanceHandle)) ||
+        (NULL != pService->pPriorityOwner))
+    {
+        return CPA_STATUS_FAIL;
+    }
+
+    if (SAL_SERVICE_TYPE_COMPRESSION == pService->type)
+    {
+        instanceNode =
+            ((sal_compression_service_t *)instanceHandle)->nodeAffinity;
+        status = icp_sal_DcGetInflightRequests(
+            instanceHandle, &maxTotal, &numTotal);
+    }
+#ifndef ICP_DC_ONLY
+    else
+    {
+        instanceNode = ((sal_crypto_service_t *)instanceHandle)->nodeAffinity;
+        if ((CPA_ACC_SVC_TYPE_CRYPTO_ASYM != serviceType) &&
+            (pService->type &
+             (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_SYM)))
+        {
+            status = icp_sal_SymGetInflightRequests(
+                instanceHandle, &maxInflight, &numInflight);
+            maxTotal += maxInflight;
+            numTotal += numInflight;
+        }
+        if ((CPA_STATUS_SUCCESS == status) &&
+            (CPA_ACC_SVC_TYPE_CRYPTO_SYM != serviceType) &&
+            (pService->type &
+             (SAL_SERVICE_TYPE_CRYPTO | SAL_SERVICE_TYPE_CRYPTO_ASYM)))
+        {
+            status = icp_sal_AsymGetInflightRequests(
+                instanceHandle, &maxInflight, &numInflight);
+            maxTotal += maxInflight;
+            numTotal += numInflight;
+        }
+    }
+#endif
+    /* No ring of the service type was queried when maxTotal is 0 */
+    if ((CPA_STATUS_SUCCESS != status) || (0 == maxTotal))
+    {
+        return CPA_STATUS_FAIL;
+    }
+
+    *pScore = (Cpa32U)(((Cpa64U)numTotal * SAL_DISPATCH_LOAD_SCALE) / maxTotal);
+    if (instanceNode != node)
+    {
+        *pScore += SAL_DISPATCH_REMOTE_PENALTY;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+CpaStatus SalCtrl_DispatchScan(CpaAccelerationServiceType serviceType,
+                               Cpa32U node,
+                               CpaInstanceHandle current,
+                               CpaInstanceHandle *pBest)
+{
+    CpaInstanceHandle *pInstances = NULL;
+    CpaInstanceHandle best = NULL;
+    Cpa32U bestScore = 0;
+    Cpa32U currentScore = 0;
+    Cpa32U score = 0;
+    Cpa16U numInstances = 0;
+    Cpa16U i = 0;
+    CpaBoolean currentFound = CPA_FALSE;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = cpaGetNumInstances(serviceType, &numInstances);
+    LAC_CHECK_STATUS(status);
+    if (0 == numInstances)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+
+    pInstances = osalMemAlloc(numInstances * sizeof(CpaInstanceHandle));
+    if (NULL == pInstances)
+    {
+        LAC_LOG_ERROR("Failed to allocate instance handles");
+        return CPA_STATUS_RESOURCE;
+    }
+    status = cpaGetInstances(serviceType, numInstances, pInstances);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        osalMemFree(pInstances);
+        return status;
+    }
+
+    for (i = 0; i < numInstances; i++)
+    {
+        if (CPA_STATUS_SUCCESS !=
+            SalCtrl_DispatchScore(pInstances[i], serviceType, node, &score))
+        {
+            continue;
+        }
+        if (pInstances[i] == current)
+        {
+            currentFound = CPA_TRUE;
+            currentScore = score;
+        }
+        if ((NULL == best) || (score < bestScore))
+        {
+            best = pInstances[i];
+            bestScore = score;
+        }
+    }
+    osalMemFree(pInstances);
+
+    if (NULL == best)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    if ((CPA_TRUE == currentFound) &&
+        (currentScore <= bestScore + SAL_DISPATCH_HYSTERESIS))
+    {
+        best = current;
+    }
+
+    *pBest = best;
+    return CPA_STATUS_SUCCESS;
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+CpaStatus SalCtrl_PriorityInit(void)
+{
+    return LAC_SPINLOCK_INIT(&salPriorityLock);
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+void SalCtrl_PriorityExit(void)
+{
+    LAC_SPINLOCK_DESTROY(&salPriorityLock);
+}
+
+/* Accel device of an instance */
+STATIC Cpa16U SalCtrl_PriorityAccelId(const sal_service_t *pService)
+{
+#ifndef ICP_DC_ONLY
+    if (SAL_SERVICE_TYPE_COMPRESSION != pService->type)
+    {
+        return ((const sal_crypto_service_t *)pService)->acceleratorNum;
+    }
+#endif
+    return ((const sal_compression_service_t *)pService)->acceleratorNum;
+}
+
+/* Requests in flight on the ring the high priority requests are sent on */
+STATIC Cpa32U SalCtrl_PriorityInflight(sal_service_t *pHigh)
+{
+    icp_comms_trans_handle ring = NULL;
+    Cpa32U maxInflight = 0;
+    Cpa32U numInflight = 0;
+
+    if (SAL_SERVICE_TYPE_COMPRESSION == pHigh->type)
+    {
+        ring =
+            ((sal_compression_service_t *)pHigh)->trans_handle_compression_tx;
+    }
+#ifndef ICP_DC_ONLY
+    else
+    {
+        ring = ((sal_crypto_service_t *)pHigh)->trans_handle_sym_tx;
+    }
+#endif
+    if ((NULL == ring) ||
+        (CPA_STATUS_SUCCESS !=
+         icp_adf_getInflightRequests(ring, &maxInflight, &numInflight)))
+    {
+        return 0;
+    }
+    return numInflight;
+}
+
+/* Unpair the pair pService is part of, with salPriorityLock held */
+STATIC void SalCtrl_PriorityPairUnlink(sal_service_t *pService)
+{
+    sal_service_t *pOwner = NULL;
+
+    pOwner = (NULL != pService->pPriorityOwner) ? pService->pPriorityOwner
+                                                : pService;
+    if (NULL != pOwner->pPriorityHigh)
+    {
+        pOwner->pPriorityHigh->pPriorityOwner = NULL;
+        __atomic_store_n(&pOwner->pPriorityHigh, NULL, __ATOMIC_RELEASE);
+    }
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+CpaStatus icp_sal_PriorityPairSet(CpaInstanceHandle instanceHandle,
+                                  CpaInstanceHandle highInstanceHandle,
+                                  Cpa32U normalPollShare)
+{
+    sal_service_t *pService = (sal_service_t *)instanceHandle;
+    sal_service_t *pHigh = (sal_service_t *)highInstanceHandle;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    LAC_CHECK_NULL_PARAM(pService);
+    LAC_CHECK_NULL_PARAM(pHigh);
+    if (pService == pHigh)
+    {
+        LAC_INVALID_PARAM_LOG("An instance cannot be paired with itself");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if ((pService->type != pHigh->type) ||
+        (pService->capabilitiesMask != pHigh->capabilitiesMask) ||
+        (pService->isGen4 != pHigh->isGen4))
+    {
+        LAC_INVALID_PARAM_LOG("Instances do not offer the same service");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (SalCtrl_PriorityAccelId(pService) != SalCtrl_PriorityAccelId(pHigh))
+    {
+        LAC_INVALID_PARAM_LOG("Instances are not on the same device");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (normalPollShare >= 100)
+    {
+        LAC_INVALID_PARAM_LOG("Invalid normalPollShare");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 == normalPollShare)
+    {
+        normalPollShare = ICP_SAL_PRIORITY_DEFAULT_NORMAL_SHARE;
+    }
+
+    LAC_SPINLOCK(&salPriorityLock);
+    if ((CPA_TRUE != pService->isInstanceStarted) ||
+        (CPA_TRUE != pHigh->isInstanceStarted) ||
+        (CPA_TRUE != Sal_ServiceIsRunning(pService)) ||
+        (CPA_TRUE != Sal_ServiceIsRunning(pHigh)))
+    {
+        status = CPA_STATUS_RESTARTING;
+    }
+    else if ((NULL != pService->pPriorityHigh) ||
+             (NULL != pService->pPriorityOwner) ||
+             (NULL != pHigh->pPriorityHigh) || (NULL != pHigh->pPriorityOwner))
+    {
+        LAC_INVALID_PARAM_LOG("Instance already part of a priority pair");
+        status = CPA_STATUS_INVALID_PARAM;
+    }
+    else
+    {
+        pService->priorityNormalShare = normalPollShare;
+        pHigh->pPriorityOwner = pService;
+        /* Publishes the share to the datapath */
+        __atomic_store_n(&pService->pPriorityHigh, pHigh, __ATOMIC_RELEASE);
+    }
+    LAC_SPINUNLOCK(&salPriorityLock);
+
+    return status;
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+CpaStatus icp_sal_PriorityPairClear(CpaInstanceHandle instanceHandle)
+{
+    LAC_CHECK_NULL_PARAM(instanceHandle);
+
+    SalCtrl_PriorityPairRemove((sal_service_t *)instanceHandle);
+    return CPA_STATUS_SUCCESS;
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+void SalCtrl_PriorityPairRemove(sal_service_t *pService)
+{
+    LAC_SPINLOCK(&salPriorityLock);
+    SalCtrl_PriorityPairUnlink(pService);
+    LAC_SPINUNLOCK(&salPriorityLock);
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+CpaStatus SalCtrl_PriorityPairStop(sal_service_t *pService)
+{
+    sal_service_t *pOwner = NULL;
+    sal_service_t *pHigh = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    LAC_SPINLOCK(&salPriorityLock);
+    pOwner = (NULL != pService->pPriorityOwner) ? pService->pPriorityOwner
+                                                : pService;
+    pHigh = pOwner->pPriorityHigh;
+    /* Only polling the owner reaps the high priority ring, so its requests
+     * would be stranded once the pair is gone. A device that is not
+     * running has its requests completed by the error handling. */
+    if ((NULL != pHigh) && (CPA_TRUE == Sal_ServiceIsRunning(pHigh)) &&
+        (0 != SalCtrl_PriorityInflight(pHigh)))
+    {
+        status = CPA_STATUS_RETRY;
+    }
+    else
+    {
+        SalCtrl_PriorityPairUnlink(pService);
+    }
+    LAC_SPINUNLOCK(&salPriorityLock);
+
+    return status;
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+sal_service_t *SalCtrl_PriorityRoute(sal_service_t *pService)
+{
+    sal_service_t *pHigh =
+        __atomic_load_n(&pService->pPriorityHigh, __ATOMIC_ACQUIRE);
+
+    if ((NULL != pHigh) && (CPA_TRUE == Sal_ServiceIsRunning(pHigh)))
+    {
+        return pHigh;
+    }
+    return pService;
+}
+
+/**
+ ******************************************************************************
+ * @ingroup SalCtrl
+ *****************************************************************************/
+void SalCtrl_PriorityQuota(const sal_service_t *pService,
+                           Cpa32U quota,
+                           Cpa32U *pHighQuota,
+                           Cpa32U *pNormalQuota)
+{
+    Cpa32U normal = 0;
+
+    if (0 == quota)
+    {
+        *pHighQuota = 0;
+        *pNormalQuota = 0;
+        return;
+    }
+
+    normal = (Cpa32U)(((Cpa64U)quota * pService->priorityNormalShare + 99) /
+                      100);
+    if (0 == normal)
+    {
+        normal = 1;
+    }
+    *pNormalQuota = normal;
+    *pHighQuota = (quota > normal) ? quota - normal : 1;
+}
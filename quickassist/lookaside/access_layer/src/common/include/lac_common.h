@@ -1112,6 +1112,84 @@ typedef enum lac_expected_size_s
     ((OSAL_SUCCESS != osalSemaphoreDestroy(&sid)) ? CPA_STATUS_RESOURCE        \
                                                   : CPA_STATUS_SUCCESS)
 
+/*
+*******************************************************************************
+* Completion Macros
+*******************************************************************************
+*/
+
+/**
+ *******************************************************************************
+ * @ingroup LacCommon
+ *      This macro initialises a completion and returns the status
+ *
+ * @param[in] cid               The completion
+ *
+ * @retval CPA_STATUS_SUCCESS   Function executed successfully.
+ * @retval CPA_STATUS_RESOURCE  Error with completion
+ ******************************************************************************/
+#define LAC_INIT_COMPLETION(cid)                                               \
+    ((OSAL_SUCCESS != osalCompletionInit(&cid)) ? CPA_STATUS_RESOURCE          \
+                                                : CPA_STATUS_SUCCESS)
+
+/**
+ *******************************************************************************
+ * @ingroup LacCommon
+ *      This macro waits on a completion and returns the status
+ *
+ * @param[in] cid               The completion
+ * @param[in] timeout           Timeout
+ *
+ * @retval CPA_STATUS_SUCCESS   Function executed successfully.
+ * @retval CPA_STATUS_RESOURCE  Error with completion
+ ******************************************************************************/
+#define LAC_WAIT_COMPLETION(cid, timeout)                                      \
+    ((OSAL_SUCCESS != osalCompletionWait(&cid, (timeout)))                     \
+         ? CPA_STATUS_RESOURCE                                                 \
+         : CPA_STATUS_SUCCESS)
+
+/**
+ *******************************************************************************
+ * @ingroup LacCommon
+ *      This macro checks a completion and returns the status
+ *
+ * @param[in] cid               The completion
+ *
+ * @retval CPA_STATUS_SUCCESS   Completion has been signalled.
+ * @retval CPA_STATUS_RETRY     Completion is still pending
+ ******************************************************************************/
+#define LAC_CHECK_COMPLETION(cid)                                              \
+    ((OSAL_SUCCESS != osalCompletionTryWait(&cid)) ? CPA_STATUS_RETRY          \
+                                                   : CPA_STATUS_SUCCESS)
+
+/**
+ *******************************************************************************
+ * @ingroup LacCommon
+ *      This macro signals a completion and returns the status
+ *
+ * @param[in] cid               The completion
+ *
+ * @retval CPA_STATUS_SUCCESS   Function executed successfully.
+ * @retval CPA_STATUS_RESOURCE  Error with completion
+ ******************************************************************************/
+#define LAC_SIGNAL_COMPLETION(cid)                                             \
+    ((OSAL_SUCCESS != osalCompletionSignal(&cid)) ? CPA_STATUS_RESOURCE        \
+                                                  : CPA_STATUS_SUCCESS)
+
+/**
+ *******************************************************************************
+ * @ingroup LacCommon
+ *      This macro destroys a completion and returns the status
+ *
+ * @param[in] cid               The completion
+ *
+ * @retval CPA_STATUS_SUCCESS   Function executed successfully.
+ * @retval CPA_STATUS_RESOURCE  Error with completion
+ ******************************************************************************/
+#define LAC_DESTROY_COMPLETION(cid)                                            \
+    ((OSAL_SUCCESS != osalCompletionDestroy(&cid)) ? CPA_STATUS_RESOURCE       \
+                                                   : CPA_STATUS_SUCCESS)
+
 /*
 *******************************************************************************
 * Spinlock Macros
@@ -112,6 +112,7 @@
 
 #include "cpa.h"
 #include "lac_common.h"
+#include "icp_sal_telemetry.h"
 
 #ifdef __LP64__
 typedef unsigned int atomic_int __attribute__((mode(TI)));
@@ -192,12 +193,33 @@ typedef struct lac_mem_pool_hdr_s
     /* An array of mem block pointers to track the allocated entries in pool */
     volatile size_t availBlks;
     /* Number of blocks available for allocation in this pool */
+    volatile size_t minAvailBlks;
+    /* Lowest value of availBlks since the pool was created */
+    volatile Cpa64U numAllocFails;
+    /* Number of allocations refused because the pool was empty */
     CpaBoolean active;
     /* Indicate the pool is available for allocation */
     OsalAtomic sync;
     /* Prevent concurrent access to the pool */
+    lac_mem_blk_t **replayBlks;
+    /* In-flight blocks held across a restart for replay, oldest first */
+    Cpa32U replayWindow;
+    /* Capacity of replayBlks, 0 when replay is disabled */
+    volatile Cpa32U numReplayBlks;
+    /* Number of blocks currently held in replayBlks */
+    Cpa64U numReplayHeld;
+    /* Number of blocks held since replay was configured */
+    Cpa64U numReplayed;
+    /* Number of held blocks resubmitted after a restart */
+    Cpa64U numReplayFailed;
+    /* Number of in-flight blocks failed while replay was enabled */
 } lac_mem_pool_hdr_t;
 
+#define LAC_MEM_POOL_BLK_REPLAY_SEQ ((Cpa64U)~1)
+/**< @ingroup LacMemPool
+ *   Opaque value of a block held for replay. It is never a valid send
+ *   sequence number, so cookie reinitialisation recognises held blocks. */
+
 #define LAC_MEM_POOL_BLK_GET_OPAQUE(entry)                                     \
     (((lac_mem_blk_t *)((LAC_ARCH_UINT)entry - sizeof(lac_mem_blk_t)))->opaque)
 
@@ -251,6 +273,41 @@ CpaStatus Lac_MemPoolCreate(lac_memory_pool_id_t *poolID,
                             CpaBoolean trackMemory,
                             Cpa32U node);
 
+/**
+ *******************************************************************************
+ * @ingroup LacMemPool
+ * This function initialises the lock guarding the table of memory pools. It
+ * must be called before the first pool is created.
+ *
+ * @blocking
+ *      No
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @retval CPA_STATUS_RESOURCE       error in initialising the lock
+ * @retval CPA_STATUS_SUCCESS        function executed successfully
+ *
+ ******************************************************************************/
+CpaStatus Lac_MemPoolsInit(void);
+
+/**
+ *******************************************************************************
+ * @ingroup LacMemPool
+ * This function destroys the lock initialised by Lac_MemPoolsInit(). It must
+ * be called after the last pool is destroyed.
+ *
+ * @blocking
+ *      No
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ ******************************************************************************/
+void Lac_MemPoolsExit(void);
+
 /**
  *******************************************************************************
  * @ingroup LacMemPool
@@ -378,6 +435,26 @@ unsigned int Lac_MemPoolAvailableEntries(lac_memory_pool_id_t poolID);
  ******************************************************************************/
 void Lac_MemPoolStatsShow(void);
 
+/**
+ *******************************************************************************
+ * @ingroup LacMemPool
+ * This function copies the telemetry of up to maxPools memory pools
+ *
+ * @blocking
+ *      No
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ * @param[out] pPools    array of at least maxPools entries
+ * @param[in] maxPools   number of entries in pPools
+ *
+ * @retval number of entries written to pPools
+ *
+ ******************************************************************************/
+Cpa32U Lac_MemPoolTelemetryGet(icp_sal_telemetry_pool_t *pPools,
+                               Cpa32U maxPools);
+
 /**
  *******************************************************************************
  * @ingroup LacMemPool
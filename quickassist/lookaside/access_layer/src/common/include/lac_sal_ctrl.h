@@ -156,4 +156,295 @@ CpaStatus SalCtrl_AdfServicesRegister(void);
  ******************************************************************/
 CpaStatus SalCtrl_AdfServicesUnregister(void);
 
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function invalidates the instance choices cached per thread
+ *    by icp_sal_DispatchGetInstance(). It must be called before any
+ *    service instance memory is freed.
+ *
+ * @context
+ *      This function is called from SalCtrl_ServiceShutdown()
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ ******************************************************************/
+void SalCtrl_DispatchInvalidate(void);
+
+/* Instance load is expressed in 1/SAL_DISPATCH_LOAD_SCALE of its ring */
+#define SAL_DISPATCH_LOAD_SCALE (1024)
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function returns the count of SalCtrl_DispatchInvalidate()
+ *    calls, starting at 1. An instance choice is only valid while the
+ *    count is the one read when the choice was made.
+ *
+ * @context
+ *      This function is called from icp_sal_DispatchGetInstance()
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ ******************************************************************/
+Cpa64U SalCtrl_DispatchGeneration(void);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function scores an instance for the dispatcher, lower is
+ *    better: the in-flight fraction of its rings of the service type
+ *    in 1/SAL_DISPATCH_LOAD_SCALE, plus a penalty when the instance is
+ *    on another NUMA node than node. It fails when the instance is not
+ *    started, does not serve the service type or takes the high
+ *    priority requests of another instance.
+ *
+ * @context
+ *      This function is called from icp_sal_DispatchGetInstance()
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  instanceHandle    Instance to score
+ * @param[in]  serviceType       Service type the instance is wanted for
+ * @param[in]  node              NUMA node of the calling thread
+ * @param[out] pScore            Score of the instance
+ *
+ ******************************************************************/
+CpaStatus SalCtrl_DispatchScore(CpaInstanceHandle instanceHandle,
+                                CpaAccelerationServiceType serviceType,
+                                Cpa32U node,
+                                Cpa32U *pScore);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function finds the best scoring instance of the service
+ *    type. The current choice, if any, is kept unless the best one
+ *    beats it by a clear margin.
+ *
+ * @context
+ *      This function is called from icp_sal_DispatchGetInstance()
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  serviceType       Service type to find an instance of
+ * @param[in]  node              NUMA node of the calling thread
+ * @param[in]  current           Current choice of the thread or NULL
+ * @param[out] pBest             Chosen instance
+ *
+ * @retval CPA_STATUS_RESOURCE   No instance of the type can be chosen
+ *
+ ******************************************************************/
+CpaStatus SalCtrl_DispatchScan(CpaAccelerationServiceType serviceType,
+                               Cpa32U node,
+                               CpaInstanceHandle current,
+                               CpaInstanceHandle *pBest);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    These functions keep the telemetry publisher from reading service
+ *    instances while they are shut down. The publisher holds the lock
+ *    while it reads the instances.
+ *
+ * @context
+ *      These functions are called from SalCtrl_ServiceShutdown()
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      Yes
+ *
+ ******************************************************************/
+void SalCtrl_TelemetryLock(void);
+void SalCtrl_TelemetryUnlock(void);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function initialises the lock serialising the setting and
+ *    removal of priority pairs.
+ *
+ * @context
+ *      This function is called when the services are registered
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ * @retval CPA_STATUS_SUCCESS    Function executed successfully
+ * @retval CPA_STATUS_RESOURCE   Error initialising the lock
+ *
+ ******************************************************************/
+CpaStatus SalCtrl_PriorityInit(void);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function destroys the lock initialised by
+ *    SalCtrl_PriorityInit().
+ *
+ * @context
+ *      This function is called when the services are unregistered
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ *
+ ******************************************************************/
+void SalCtrl_PriorityExit(void);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function removes the priority pairing, set with
+ *    icp_sal_PriorityPairSet(), the instance is part of, whether it
+ *    owns the pair or takes its high priority requests.
+ *
+ * @context
+ *      This function is called when the pair is cleared or the
+ *      instance is shut down
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] pService       Instance to unpair
+ *
+ ******************************************************************/
+void SalCtrl_PriorityPairRemove(sal_service_t *pService);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function removes the priority pairing the instance is part
+ *    of, like SalCtrl_PriorityPairRemove(), unless the high priority
+ *    ring still has requests in flight: only polling the owner of the
+ *    pair reaps them.
+ *
+ * @context
+ *      This function is called when an instance is stopped
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] pService       Instance to unpair
+ *
+ * @retval CPA_STATUS_SUCCESS    The instance is not part of a pair
+ * @retval CPA_STATUS_RETRY      The high priority ring has requests
+ *                               in flight, the pair is kept
+ *
+ ******************************************************************/
+CpaStatus SalCtrl_PriorityPairStop(sal_service_t *pService);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function returns the instance the requests of a high
+ *    priority session submitted on pService are sent on: the instance
+ *    paired with it while that one is running, pService otherwise.
+ *
+ * @context
+ *      This function is called from the datapath
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in] pService       Instance the request was submitted on
+ *
+ ******************************************************************/
+sal_service_t *SalCtrl_PriorityRoute(sal_service_t *pService);
+
+/*******************************************************************
+ * @ingroup SalCtrl
+ * @description
+ *    This function splits the response quota of a poll of a paired
+ *    instance between the rings of its high priority requests, polled
+ *    first, and its own rings. The latter keep their share of the
+ *    quota, and at least one response, so that a busy high priority
+ *    ring pair cannot starve them. A quota of 0, all the responses
+ *    available, applies to both.
+ *
+ * @context
+ *      This function is called from the polling functions
+ *
+ * @assumptions
+ *      None
+ * @sideEffects
+ *      None
+ * @reentrant
+ *      Yes
+ * @threadSafe
+ *      Yes
+ *
+ * @param[in]  pService          Instance polled
+ * @param[in]  quota             Response quota of the poll
+ * @param[out] pHighQuota        Quota of the high priority rings
+ * @param[out] pNormalQuota      Quota of the instance's own rings
+ *
+ ******************************************************************/
+void SalCtrl_PriorityQuota(const sal_service_t *pService,
+                           Cpa32U quota,
+                           Cpa32U *pHighQuota,
+                           Cpa32U *pNormalQuota);
+
 #endif
@@ -199,6 +199,20 @@ typedef struct sal_service_s
     CpaBoolean integrityCrcCheck;
     /** < True if the device supports end to end data integrity checks */
 
+    void *pollEngine;
+    /**< Adaptive polling engine, see icp_sal_PollEngineStart */
+
+    struct sal_service_s *pPriorityHigh;
+    /**< Instance whose ring pair takes the high priority requests of this
+     * one, see icp_sal_PriorityPairSet */
+
+    struct sal_service_s *pPriorityOwner;
+    /**< Instance whose high priority requests this one takes */
+
+    Cpa32U priorityNormalShare;
+    /**< Percentage of a poll quota kept for this instance's own rings
+     * while pPriorityHigh is set */
+
     CpaBoolean isGen4;
     /* True if the device is qat_4xxx or qat_4xxxvf */
 
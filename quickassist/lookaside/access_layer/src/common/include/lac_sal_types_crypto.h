@@ -188,6 +188,9 @@ typedef struct sal_crypto_service_s
     Cpa8U **ppHmacContentDesc;
     /**< table of pointers to CD for Hmac precomputes - used at session init */
 
+    void *pHashPrecompCache;
+    /**< opt-in cache of software hash precomputes - used at session init */
+
     Cpa8U *pSslLabel;
     /**< pointer to memory holding the standard SSL label ABBCCC.. */
 
@@ -100,6 +100,7 @@
 #ifndef LAC_SW_RESPONSES_H
 #define LAC_SW_RESPONSES_H
 
+#include "icp_adf_transport.h"
 #include "lac_mem_pools.h"
 #include "lac_sal_types.h"
 
@@ -181,4 +182,56 @@ Cpa16U LacSwResp_GetNumPoolsBusy(void);
  ******************************************************************************/
 CpaStatus LacSwResp_GenResp(lac_memory_pool_id_t lac_mem_pool,
                             sal_service_type_t type);
+
+/**
+ *******************************************************************************
+ * @ingroup LacSwResponses
+ * This function resubmits the requests of the DC / PKE request memory pool
+ * which LacSwResp_GenResp held for replay, oldest first, once the device has
+ * restarted. Requests which cannot be resubmitted are failed through their
+ * callbacks as LacSwResp_GenResp would have done.
+ *
+ * @blocking
+ *      Yes
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ * @param[in] lac_mem_pool           The ID of the specific pool
+ * @param[in] type                   SAL_SERVICE Type
+ * @param[in] trans_handle           Request ring of the restarted instance
+ *
+ * @retval CPA_STATUS_SUCCESS        All held requests were resubmitted
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter passed in.
+ * @retval CPA_STATUS_RETRY          The ring filled up, the remaining
+ *                                   requests were failed.
+ * @retval CPA_STATUS_FAIL           A request could not be sent, the
+ *                                   remaining requests were failed.
+ *
+ ******************************************************************************/
+CpaStatus LacSwResp_Replay(lac_memory_pool_id_t lac_mem_pool,
+                           sal_service_type_t type,
+                           icp_comms_trans_handle trans_handle);
+
+/**
+ *******************************************************************************
+ * @ingroup LacSwResponses
+ * This function fails the requests held for replay through their callbacks.
+ * It is used when the instance goes away without the device restarting.
+ *
+ * @blocking
+ *      Yes
+ * @reentrant
+ *      No
+ * @threadSafe
+ *      No
+ * @param[in] lac_mem_pool           The ID of the specific pool
+ * @param[in] type                   SAL_SERVICE Type
+ *
+ * @retval CPA_STATUS_SUCCESS        function executed successfully
+ * @retval CPA_STATUS_INVALID_PARAM  Invalid parameter passed in.
+ *
+ ******************************************************************************/
+CpaStatus LacSwResp_ReplayFlush(lac_memory_pool_id_t lac_mem_pool,
+                                sal_service_type_t type);
 #endif /* LAC_SW_RESPONSES_H */
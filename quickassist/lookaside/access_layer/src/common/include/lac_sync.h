@@ -89,8 +89,9 @@
  *****************************************************************************/
 typedef struct lac_sync_op_data_s
 {
-    OsalSemaphore sid;
-    /**< Semaphore to signal */
+    OsalCompletion completion;
+    /**< Completion to signal; held by value so that a synchronous request
+     * needs no allocation besides the cookie itself */
     CpaStatus status;
     /**< Output - Status of the QAT response */
     CpaBoolean opResult;
@@ -122,15 +123,11 @@ typedef struct lac_sync_op_data_s
 /**< @ingroup LacSyn
  * Timeout for wait for compression response in msecs */
 
-#define LAC_SYN_INITIAL_SEM_VALUE (0)
-/**< @ingroup LacSyn
- * Initial value of the sync waiting semaphore */
-
 /**
  *******************************************************************************
  * @ingroup LacSync
  *      This function allocates a sync op data cookie
- *      and creates and initialises the OSAL semaphore
+ *      and initialises its OSAL completion
  *
  * @param[in] ppSyncCallbackCookie  Pointer to synch op data
  *
@@ -146,8 +143,7 @@ static __inline CpaStatus LacSync_CreateSyncCookie(
 
     if (CPA_STATUS_SUCCESS == status)
     {
-        status = LAC_INIT_SEMAPHORE((*ppSyncCallbackCookie)->sid,
-                                    LAC_SYN_INITIAL_SEM_VALUE);
+        status = LAC_INIT_COMPLETION((*ppSyncCallbackCookie)->completion);
         (*ppSyncCallbackCookie)->complete = CPA_FALSE;
         (*ppSyncCallbackCookie)->canceled = CPA_FALSE;
     }
@@ -163,7 +159,8 @@ static __inline CpaStatus LacSync_CreateSyncCookie(
 /**
  *******************************************************************************
  * @ingroup LacSync
- *      This macro frees a sync op data cookie and destroys the OSAL semaphore
+ *      This macro frees a sync op data cookie and destroys the OSAL
+ *      completion
  *
  * @param[in] ppSyncCallbackCookie      Pointer to sync op data
  *
@@ -186,7 +183,7 @@ static __inline CpaStatus LacSync_DestroySyncCookie(
         return CPA_STATUS_FAIL;
     }
 
-    status = LAC_DESTROY_SEMAPHORE((*ppSyncCallbackCookie)->sid);
+    status = LAC_DESTROY_COMPLETION((*ppSyncCallbackCookie)->completion);
     LAC_OS_FREE(*ppSyncCallbackCookie);
     return status;
 }
@@ -213,7 +210,7 @@ static __inline CpaStatus LacSync_WaitForCallback(
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
 
-    status = LAC_WAIT_SEMAPHORE(pSyncCallbackCookie->sid, timeOut);
+    status = LAC_WAIT_COMPLETION(pSyncCallbackCookie->completion, timeOut);
 
     if (CPA_STATUS_SUCCESS == status)
     {
@@ -250,7 +247,7 @@ static __inline CpaStatus LacSync_CheckForCallback(
 {
     CpaStatus status = CPA_STATUS_SUCCESS;
 
-    status = LAC_CHECK_SEMAPHORE(pSyncCallbackCookie->sid);
+    status = LAC_CHECK_COMPLETION(pSyncCallbackCookie->completion);
 
     if (CPA_STATUS_SUCCESS == status)
     {
@@ -298,7 +295,7 @@ static __inline CpaStatus LacSync_SetSyncCookieComplete(
  *      This function is used when the API is called in synchronous mode.
  *      It's assumed the callbackTag holds a lac_sync_op_data_t type
  *      and when the callback is received, this callback shall set the
- *      status element of that cookie structure and kick the sid.
+ *      status element of that cookie structure and signal the completion.
  *      This function may be used directly as a callback function.
  *
  * @param[in]  callbackTag       Callback Tag
@@ -321,7 +318,7 @@ void LacSync_GenVerifyCb(void *callbackTag,
  *      This function is used when the API is called in synchronous mode.
  *      It's assumed the callbackTag holds a lac_sync_op_data_t type
  *      and when the callback is received, this callback shall set the
- *      status element of that cookie structure and kick the sid.
+ *      status element of that cookie structure and signal the completion.
  *      This function may be used directly as a callback function.
  *
  * @param[in]  callbackTag       Callback Tag
@@ -345,7 +342,7 @@ void LacSync_GenFlatBufCb(void *callbackTag,
  *      It's assumed the callbackTag holds a lac_sync_op_data_t type
  *      and when the callback is received, this callback shall set the
  *      status and opResult element of that cookie structure and
- *      kick the sid.
+ *      signal the completion.
  *      This function may be used directly as a callback function.
  *
  * @param[in]  callbackTag       Callback Tag
@@ -371,7 +368,7 @@ void LacSync_GenFlatBufVerifyCb(void *callbackTag,
  *      It's assumed the callbackTag holds a lac_sync_op_data_t type
  *      and when the callback is received, this callback shall set the
  *      status and opResult element of that cookie structure and
- *      kick the sid.
+ *      signal the completion.
  *      This function may be used directly as a callback function.
  *
  * @param[in]  callbackTag       Callback Tag
@@ -400,7 +397,7 @@ void LacSync_GenDualFlatBufVerifyCb(void *callbackTag,
  *      It's assumed the callbackTag holds a lac_sync_op_data_t type
  *      and when the callback is received, this callback shall set
  *      the status element of that cookie structure and kick the
- *      sid.
+ *      completion.
  *      This function maybe called from an async callback.
  *
  * @param[in] callbackTag       Callback Tag
@@ -420,7 +417,7 @@ void LacSync_GenWakeupSyncCaller(void *callbackTag, CpaStatus status);
  *      It's assumed the callbackTag holds a lac_sync_op_data_t type
  *      and when the callback is received, this callback shall set
  *      the status element and the opResult of that cookie structure
- *      and kick the sid.
+ *      and signal the completion.
  *      This function maybe called from an async callback.
  *
  * @param[in]  callbackTag       Callback Tag
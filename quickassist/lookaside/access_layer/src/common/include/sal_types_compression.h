@@ -250,6 +250,12 @@ typedef struct sal_compression_service_s
 
     /* Chaining service */
     sal_dc_chain_service_t *pDcChainService;
+
+#ifdef ICP_DC_SW_FALLBACK
+    /* Host compression of the requests the device cannot take, NULL
+     * while disabled */
+    struct dc_sw_fallback_s *pDcSwFallback;
+#endif
 } sal_compression_service_t;
 
 /*************************************************************************
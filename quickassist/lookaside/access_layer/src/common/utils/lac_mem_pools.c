@@ -104,6 +104,12 @@ static lac_mem_pool_hdr_t *lac_mem_pools[LAC_MEM_POOLS_NUM_SUPPORTED] = {NULL};
  * Array of pointers to the mem pool header structure
  */
 
+static lac_lock_t lac_mem_pools_lock;
+/**< @ingroup LacMemPool
+ * Guards changes to lac_mem_pools against concurrent creators and against
+ * readers of the pool headers, such as Lac_MemPoolTelemetryGet
+ */
+
 LAC_DECLARE_HIGHEST_BIT_OF(lac_mem_blk_t);
 /**< @ingroup LacMemPool
  * local constant for quickening computation of additional space allocated
@@ -132,6 +138,16 @@ CpaBoolean Lac_MemPoolTestAndGet(lac_memory_pool_id_t poolID)
     return osalAtomicDecAndTest(&(pPoolID->sync));
 }
 
+CpaStatus Lac_MemPoolsInit(void)
+{
+    return LAC_SPINLOCK_INIT(&lac_mem_pools_lock);
+}
+
+void Lac_MemPoolsExit(void)
+{
+    LAC_SPINLOCK_DESTROY(&lac_mem_pools_lock);
+}
+
 CpaStatus Lac_MemPoolCreate(
     lac_memory_pool_id_t *pPoolID,
     char *poolName,
@@ -143,6 +159,7 @@ CpaStatus Lac_MemPoolCreate(
 {
     unsigned int poolSearch = 0;
     unsigned int counter = 0;
+    lac_mem_pool_hdr_t *pPool = NULL;
     lac_mem_blk_t *pMemBlkCurrent = NULL;
 
     void *pMemBlk = NULL;
@@ -153,38 +170,22 @@ CpaStatus Lac_MemPoolCreate(
         return CPA_STATUS_INVALID_PARAM; /*Error*/
     }
 
-    /* Find First available Pool return error otherwise */
-    while (lac_mem_pools[poolSearch] != NULL)
-    {
-        poolSearch++;
-        if (LAC_MEM_POOLS_NUM_SUPPORTED == poolSearch)
-        {
-            LAC_LOG_ERROR("No more memory pools available for allocation");
-            return CPA_STATUS_FAIL;
-        }
-    }
-
     /* Allocate a Pool header */
-    if (CPA_STATUS_SUCCESS !=
-        LAC_OS_MALLOC(&lac_mem_pools[poolSearch], sizeof(lac_mem_pool_hdr_t)))
+    if (CPA_STATUS_SUCCESS != LAC_OS_MALLOC(&pPool, sizeof(lac_mem_pool_hdr_t)))
     {
         LAC_LOG_ERROR("Unable to allocate memory for creation of the pool");
         return CPA_STATUS_RESOURCE; /*Error*/
     }
-    osalMemSet(lac_mem_pools[poolSearch], 0, sizeof(lac_mem_pool_hdr_t));
+    osalMemSet(pPool, 0, sizeof(lac_mem_pool_hdr_t));
 
     /* Copy in Pool Name */
     if (poolName != NULL)
     {
-        snprintf(lac_mem_pools[poolSearch]->poolName,
-                 LAC_MEM_POOLS_NAME_SIZE,
-                 "%s",
-                 poolName);
+        snprintf(pPool->poolName, LAC_MEM_POOLS_NAME_SIZE, "%s", poolName);
     }
     else
     {
-        LAC_OS_FREE(lac_mem_pools[poolSearch]);
-        lac_mem_pools[poolSearch] = NULL;
+        LAC_OS_FREE(pPool);
         LAC_LOG_ERROR("Invalid Pool Name pointer");
         return CPA_STATUS_INVALID_PARAM; /*Error*/
     }
@@ -193,11 +194,10 @@ CpaStatus Lac_MemPoolCreate(
     if (CPA_TRUE == trackMemory)
     {
         if (CPA_STATUS_SUCCESS !=
-            LAC_OS_MALLOC(&(lac_mem_pools[poolSearch]->trackBlks),
+            LAC_OS_MALLOC(&(pPool->trackBlks),
                           (sizeof(lac_mem_blk_t *) * numElementsInPool)))
         {
-            LAC_OS_FREE(lac_mem_pools[poolSearch]);
-            lac_mem_pools[poolSearch] = NULL;
+            LAC_OS_FREE(pPool);
             LAC_LOG_ERROR(
                 "Unable to allocate memory for tracking memory blocks");
             return CPA_STATUS_RESOURCE; /*Error*/
@@ -205,11 +205,11 @@ CpaStatus Lac_MemPoolCreate(
     }
     else
     {
-        lac_mem_pools[poolSearch]->trackBlks = NULL;
+        pPool->trackBlks = NULL;
     }
 
-    lac_mem_pools[poolSearch]->availBlks = 0;
-    lac_mem_pools[poolSearch]->stack = _init_stack();
+    pPool->availBlks = 0;
+    pPool->stack = _init_stack();
 
     /* Calculate alignment needed for allocation   */
     for (counter = 0; counter < numElementsInPool; counter++)
@@ -229,8 +229,7 @@ CpaStatus Lac_MemPoolCreate(
         if (CPA_STATUS_SUCCESS !=
             LAC_OS_CAMALLOC(&pMemBlk, realSize, blkAlignmentInBytes, node))
         {
-            Lac_MemPoolCleanUpInternal(lac_mem_pools[poolSearch]);
-            lac_mem_pools[poolSearch] = NULL;
+            Lac_MemPoolCleanUpInternal(pPool);
             LAC_LOG_ERROR("Unable to allocate contiguous chunk of memory");
             return CPA_STATUS_RESOURCE;
         }
@@ -249,29 +248,46 @@ CpaStatus Lac_MemPoolCreate(
 
         pMemBlkCurrent->physDataPtr = physAddr;
         pMemBlkCurrent->pMemAllocPtr = pMemBlk;
-        pMemBlkCurrent->pPoolID = lac_mem_pools[poolSearch];
+        pMemBlkCurrent->pPoolID = pPool;
         pMemBlkCurrent->isInUse = CPA_FALSE;
         pMemBlkCurrent->pNext = NULL;
 
-        push(&lac_mem_pools[poolSearch]->stack, pMemBlkCurrent);
+        push(&pPool->stack, pMemBlkCurrent);
 
         /* Store allocated memory pointer */
-        if (lac_mem_pools[poolSearch]->trackBlks != NULL)
+        if (pPool->trackBlks != NULL)
         {
-            (lac_mem_pools[poolSearch]->trackBlks[counter]) =
-                (lac_mem_blk_t *)pMemBlkCurrent;
+            (pPool->trackBlks[counter]) = (lac_mem_blk_t *)pMemBlkCurrent;
         }
-        __sync_add_and_fetch(&lac_mem_pools[poolSearch]->availBlks, 1);
-        (lac_mem_pools[poolSearch])->numElementsInPool = counter + 1;
+        __sync_add_and_fetch(&pPool->availBlks, 1);
+        pPool->numElementsInPool = counter + 1;
     }
 
     /* Set Pool details in the header */
-    (lac_mem_pools[poolSearch])->blkSizeInBytes = blkSizeInBytes;
-    (lac_mem_pools[poolSearch])->blkAlignmentInBytes = blkAlignmentInBytes;
-    (lac_mem_pools[poolSearch])->active = CPA_TRUE;
-    osalAtomicSet(1, (OsalAtomic *)&((lac_mem_pools[poolSearch])->sync));
+    pPool->blkSizeInBytes = blkSizeInBytes;
+    pPool->blkAlignmentInBytes = blkAlignmentInBytes;
+    pPool->active = CPA_TRUE;
+    osalAtomicSet(1, (OsalAtomic *)&(pPool->sync));
+    pPool->minAvailBlks = pPool->availBlks;
+
+    /* Find First available Pool return error otherwise */
+    LAC_SPINLOCK(&lac_mem_pools_lock);
+    while (lac_mem_pools[poolSearch] != NULL)
+    {
+        poolSearch++;
+        if (LAC_MEM_POOLS_NUM_SUPPORTED == poolSearch)
+        {
+            LAC_SPINUNLOCK(&lac_mem_pools_lock);
+            Lac_MemPoolCleanUpInternal(pPool);
+            LAC_LOG_ERROR("No more memory pools available for allocation");
+            return CPA_STATUS_FAIL;
+        }
+    }
+    lac_mem_pools[poolSearch] = pPool;
+    LAC_SPINUNLOCK(&lac_mem_pools_lock);
+
     /* Set the Pool ID output parameter */
-    *pPoolID = (LAC_ARCH_UINT)(lac_mem_pools[poolSearch]);
+    *pPoolID = (LAC_ARCH_UINT)pPool;
     /* Success */
     return CPA_STATUS_SUCCESS;
 }
@@ -309,6 +325,7 @@ void *Lac_MemPoolEntryAlloc(lac_memory_pool_id_t poolID)
 {
     lac_mem_pool_hdr_t *pPoolID = (lac_mem_pool_hdr_t *)poolID;
     lac_mem_blk_t *pMemBlkCurrent = NULL;
+    size_t availBlks = 0;
 
 #ifdef ICP_DEBUG
     /* Explicitly removing NULL PoolID check for speed */
@@ -326,9 +343,15 @@ void *Lac_MemPoolEntryAlloc(lac_memory_pool_id_t poolID)
     pMemBlkCurrent = pop(&pPoolID->stack);
     if (NULL == pMemBlkCurrent)
     {
+        __sync_add_and_fetch(&pPoolID->numAllocFails, 1);
         return (void *)CPA_STATUS_RETRY;
     }
-    __sync_sub_and_fetch(&pPoolID->availBlks, 1);
+    availBlks = __sync_sub_and_fetch(&pPoolID->availBlks, 1);
+    /* Low-water mark for telemetry; a lost race only delays the update */
+    if (unlikely(availBlks < pPoolID->minAvailBlks))
+    {
+        pPoolID->minAvailBlks = availBlks;
+    }
     pMemBlkCurrent->isInUse = CPA_TRUE;
     return (void *)((LAC_ARCH_UINT)(pMemBlkCurrent) + sizeof(lac_mem_blk_t));
 }
@@ -372,7 +395,9 @@ void Lac_MemPoolDestroy(lac_memory_pool_id_t poolID)
             }
         }
 
+        LAC_SPINLOCK(&lac_mem_pools_lock);
         lac_mem_pools[poolSearch] = NULL; /*Remove handle from pool*/
+        LAC_SPINUNLOCK(&lac_mem_pools_lock);
 
         Lac_MemPoolCleanUpInternal(pPoolID);
     }
@@ -405,6 +430,10 @@ void Lac_MemPoolCleanUpInternal(lac_mem_pool_hdr_t *pPoolID)
         }
         LAC_OS_FREE(pPoolID->trackBlks);
     }
+    if (NULL != pPoolID->replayBlks)
+    {
+        LAC_OS_FREE(pPoolID->replayBlks);
+    }
     LAC_OS_FREE(pPoolID);
 }
 
@@ -437,18 +466,55 @@ void Lac_MemPoolStatsShow(void)
                            " No. Elements in Pool:  %10u \n" BORDER
                            " Element Size in Bytes: %10u \n" BORDER
                            " Alignment in Bytes:    %10u \n" BORDER
-                           " No. Available Blocks:  %10zu \n" SEPARATOR,
+                           " No. Available Blocks:  %10zu \n" BORDER
+                           " Min. Available Blocks: %10zu \n" BORDER
+                           " No. Alloc Failures:    %10llu \n" SEPARATOR,
                     lac_mem_pools[index]->poolName,
                     lac_mem_pools[index]->active ? "TRUE" : "FALSE",
                     lac_mem_pools[index]->numElementsInPool,
                     lac_mem_pools[index]->blkSizeInBytes,
                     lac_mem_pools[index]->blkAlignmentInBytes,
-                    lac_mem_pools[index]->availBlks);
+                    lac_mem_pools[index]->availBlks,
+                    lac_mem_pools[index]->minAvailBlks,
+                    (unsigned long long)lac_mem_pools[index]->numAllocFails);
         }
         index++;
     }
 }
 
+Cpa32U Lac_MemPoolTelemetryGet(icp_sal_telemetry_pool_t *pPools,
+                               Cpa32U maxPools)
+{
+    lac_mem_pool_hdr_t *pPool = NULL;
+    unsigned int index = 0;
+    Cpa32U numPools = 0;
+
+    LAC_SPINLOCK(&lac_mem_pools_lock);
+    for (index = 0;
+         (index < LAC_MEM_POOLS_NUM_SUPPORTED) && (numPools < maxPools);
+         index++)
+    {
+        pPool = lac_mem_pools[index];
+        if (NULL == pPool)
+        {
+            continue;
+        }
+        osalMemCopy(pPools[numPools].name,
+                    pPool->poolName,
+                    ICP_SAL_TELEMETRY_POOL_NAME_LEN);
+        pPools[numPools].name[ICP_SAL_TELEMETRY_POOL_NAME_LEN - 1] = '\0';
+        pPools[numPools].numBlks = pPool->numElementsInPool;
+        pPools[numPools].blkSizeInBytes = pPool->blkSizeInBytes;
+        pPools[numPools].availBlks = (Cpa32U)pPool->availBlks;
+        pPools[numPools].minAvailBlks = (Cpa32U)pPool->minAvailBlks;
+        pPools[numPools].numAllocFails = pPool->numAllocFails;
+        numPools++;
+    }
+    LAC_SPINUNLOCK(&lac_mem_pools_lock);
+
+    return numPools;
+}
+
 CpaStatus Lac_MemPoolInitDcCookies(lac_memory_pool_id_t poolID)
 {
     lac_mem_pool_hdr_t *pPoolID = (lac_mem_pool_hdr_t *)poolID;
@@ -466,6 +532,11 @@ CpaStatus Lac_MemPoolInitDcCookies(lac_memory_pool_id_t poolID)
         for (count = 0; count < pPoolID->numElementsInPool; count++)
         {
             pCurrentBlk = pPoolID->trackBlks[count];
+            /* Held requests are resubmitted as built */
+            if (LAC_MEM_POOL_BLK_REPLAY_SEQ == pCurrentBlk->opaque)
+            {
+                continue;
+            }
             pCurrentBlk->opaque = ICP_ADF_INVALID_SEND_SEQ;
         }
     }
@@ -557,6 +628,11 @@ CpaStatus Lac_MemPoolInitAsymCookies(lac_memory_pool_id_t poolID,
         for (count = 0; count < pPoolID->numElementsInPool; count++)
         {
             pCurrentBlk = pPoolID->trackBlks[count];
+            /* Held requests are resubmitted as built */
+            if (LAC_MEM_POOL_BLK_REPLAY_SEQ == pCurrentBlk->opaque)
+            {
+                continue;
+            }
             pCurrentBlk->opaque = ICP_ADF_INVALID_SEND_SEQ;
             pAsymReq =
                 (Cpa8U *)((LAC_ARCH_UINT)(pCurrentBlk) + sizeof(lac_mem_blk_t));
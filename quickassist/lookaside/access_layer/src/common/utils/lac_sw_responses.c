@@ -79,10 +79,18 @@
 #include "lac_mem_pools.h"
 #include "lac_mem.h"
 #include "lac_common.h"
+#include "lac_log.h"
+#include "lac_sal_types.h"
+#include "sal_qat_cmn_msg.h"
+#include "sal_service_state.h"
+#include "sal_types_compression.h"
+#include "icp_sal_replay.h"
 #include "Osal.h"
 
 #ifndef ICP_DC_ONLY
 #include "lac_pke_qat_comms.h"
+#include "lac_pke_utils.h"
+#include "lac_sal_types_crypto.h"
 #endif
 
 #ifdef KERNEL_SPACE
@@ -99,7 +107,9 @@ static OsalAtomic lac_sw_resp_num_pools_busy = ATOMIC_INIT(0);
 void LacSwResp_IncNumPoolsBusy(lac_memory_pool_id_t poolID)
 {
     lac_mem_pool_hdr_t *pPoolID = (lac_mem_pool_hdr_t *)poolID;
-    if (pPoolID->availBlks != pPoolID->numElementsInPool)
+    /* Blocks held for replay stay in use until the device restarts */
+    if (pPoolID->availBlks + pPoolID->numReplayBlks !=
+        pPoolID->numElementsInPool)
     {
         osalAtomicInc(&lac_sw_resp_num_pools_busy);
     }
@@ -230,6 +240,134 @@ CpaStatus LacSwResp_GenRespMsgCallback(lac_memblk_bucket_t *pBucket,
     return status;
 }
 
+/**
+ *******************************************************************************
+ * @ingroup LacSwResponses
+ * This function checks whether an in-flight request may be replayed. Only
+ * requests whose result depends on nothing but the request itself qualify,
+ * as the failed device may already have written part of their output.
+ ******************************************************************************/
+STATIC
+CpaBoolean LacSwResp_IsReplayable(lac_mem_blk_t *pBlk, sal_service_type_t type)
+{
+    void *pData = (void *)((LAC_ARCH_UINT)pBlk + sizeof(lac_mem_blk_t));
+    dc_compression_cookie_t *pCookie = NULL;
+    lac_pke_qat_req_data_t *pReqData = NULL;
+
+    if (SAL_SERVICE_TYPE_COMPRESSION == type)
+    {
+        pCookie = (dc_compression_cookie_t *)pData;
+        /* Requests without a session are not replayed */
+        if (NULL == pCookie->pSessionDesc)
+        {
+            return CPA_FALSE;
+        }
+        return (CPA_DC_STATELESS == pCookie->pSessionDesc->sessState)
+                   ? CPA_TRUE
+                   : CPA_FALSE;
+    }
+
+    /* Requests of a chain are only sent through their head */
+    pReqData = (lac_pke_qat_req_data_t *)pData;
+    return ((NULL == pReqData->pNextReqData) &&
+            (pReqData == pReqData->pHeadReqData))
+               ? CPA_TRUE
+               : CPA_FALSE;
+}
+
+/**
+ *******************************************************************************
+ * @ingroup LacSwResponses
+ * This function moves the oldest replayable blocks of the bucket, up to the
+ * replay window, to the pool's replay list. The bucket is left holding the
+ * blocks to fail, in order.
+ ******************************************************************************/
+STATIC
+void LacSwResp_ReplayHold(lac_mem_pool_hdr_t *pPoolID,
+                          lac_memblk_bucket_t *pBucket,
+                          sal_service_type_t type)
+{
+    lac_mem_blk_t **pRemaining = NULL;
+    lac_mem_blk_t *pCurrentBlk = NULL;
+    Cpa32U numHeld = pPoolID->numReplayBlks;
+    Cpa32U numRemaining = 0;
+    Cpa32U iter = 0;
+
+    if (0 == pBucket->numBlksInRing)
+    {
+        return;
+    }
+
+    pRemaining = (lac_mem_blk_t **)osalMemAlloc(sizeof(lac_mem_blk_t *) *
+                                                pBucket->numBlksInRing);
+    if (NULL == pRemaining)
+    {
+        LAC_LOG_ERROR("Failed to allocate memory for replay.");
+        return;
+    }
+
+    for (iter = 0; iter < pBucket->numBlksInRing; iter++)
+    {
+        pCurrentBlk = pBucket->mem_blk[(pBucket->startIndex + iter) %
+                                       pBucket->numBucketBlks];
+        if ((numHeld < pPoolID->replayWindow) &&
+            LacSwResp_IsReplayable(pCurrentBlk, type))
+        {
+            pCurrentBlk->opaque = LAC_MEM_POOL_BLK_REPLAY_SEQ;
+            pPoolID->replayBlks[numHeld++] = pCurrentBlk;
+        }
+        else
+        {
+            pRemaining[numRemaining++] = pCurrentBlk;
+        }
+    }
+
+    pPoolID->numReplayHeld += numHeld - pPoolID->numReplayBlks;
+    pPoolID->numReplayFailed += numRemaining;
+    pPoolID->numReplayBlks = numHeld;
+
+    osalMemFree(pBucket->mem_blk);
+    pBucket->mem_blk = pRemaining;
+    pBucket->startIndex = 0;
+    pBucket->numBucketBlks = numRemaining;
+    pBucket->numBlksInRing = numRemaining;
+}
+
+/**
+ *******************************************************************************
+ * @ingroup LacSwResponses
+ * This function generates dummy responses for the held blocks from index
+ * first onwards and empties the replay list.
+ ******************************************************************************/
+STATIC
+CpaStatus LacSwResp_ReplayFail(lac_mem_pool_hdr_t *pPoolID,
+                               Cpa32U first,
+                               sal_service_type_t type)
+{
+    lac_memblk_bucket_t bucket = { 0 };
+    Cpa32U numHeld = pPoolID->numReplayBlks;
+    Cpa32U iter = 0;
+
+    pPoolID->numReplayBlks = 0;
+    if (first >= numHeld)
+    {
+        return CPA_STATUS_SUCCESS;
+    }
+
+    for (iter = first; iter < numHeld; iter++)
+    {
+        pPoolID->replayBlks[iter]->opaque = ICP_ADF_INVALID_SEND_SEQ;
+    }
+    pPoolID->numReplayFailed += numHeld - first;
+
+    bucket.mem_blk = &pPoolID->replayBlks[first];
+    bucket.startIndex = 0;
+    bucket.numBucketBlks = numHeld - first;
+    bucket.numBlksInRing = numHeld - first;
+
+    return LacSwResp_GenRespMsgCallback(&bucket, type);
+}
+
 CpaStatus LacSwResp_GenResp(lac_memory_pool_id_t lac_mem_pool,
                             sal_service_type_t type)
 {
@@ -269,6 +407,11 @@ CpaStatus LacSwResp_GenResp(lac_memory_pool_id_t lac_mem_pool,
             return CPA_STATUS_RESOURCE;
         }
 
+        if (0 != pPoolID->replayWindow)
+        {
+            LacSwResp_ReplayHold(pPoolID, pBucket, type);
+        }
+
         status = LacSwResp_GenRespMsgCallback(pBucket, type);
         if ((CPA_STATUS_SUCCESS != status) && (CPA_STATUS_RETRY != status))
         {
@@ -278,5 +421,177 @@ CpaStatus LacSwResp_GenResp(lac_memory_pool_id_t lac_mem_pool,
     }
     return status;
 }
+
+CpaStatus LacSwResp_Replay(lac_memory_pool_id_t lac_mem_pool,
+                           sal_service_type_t type,
+                           icp_comms_trans_handle trans_handle)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    lac_mem_pool_hdr_t *pPoolID = (lac_mem_pool_hdr_t *)lac_mem_pool;
+    lac_mem_blk_t *pCurrentBlk = NULL;
+    dc_compression_cookie_t *pCookie = NULL;
+    lac_pke_qat_req_data_t *pReqData = NULL;
+    Cpa64U seq_num = ICP_ADF_INVALID_SEND_SEQ;
+    Cpa32U numHeld = 0;
+    Cpa32U iter = 0;
+
+    LAC_CHECK_NULL_PARAM(pPoolID);
+
+    numHeld = pPoolID->numReplayBlks;
+    for (iter = 0; iter < numHeld; iter++)
+    {
+        pCurrentBlk = pPoolID->replayBlks[iter];
+        seq_num = ICP_ADF_INVALID_SEND_SEQ;
+
+        /* The held ring message is sent unchanged: it still points at the
+         * cookie, the session and the client buffers */
+        if (SAL_SERVICE_TYPE_COMPRESSION == type)
+        {
+            pCookie = (dc_compression_cookie_t *)((LAC_ARCH_UINT)pCurrentBlk +
+                                                  sizeof(lac_mem_blk_t));
+            status = SalQatMsg_transPutMsg(trans_handle,
+                                           (void *)&(pCookie->request),
+                                           LAC_QAT_DC_REQ_SZ_LW,
+                                           LAC_LOG_MSG_DC,
+                                           &seq_num);
+        }
+        else
+        {
+            pReqData = (lac_pke_qat_req_data_t *)((LAC_ARCH_UINT)pCurrentBlk +
+                                                  sizeof(lac_mem_blk_t));
+            status = SalQatMsg_transPutMsg(trans_handle,
+                                           (void *)&(pReqData->u1.request),
+                                           LAC_QAT_ASYM_REQ_SZ_LW,
+                                           LAC_LOG_MSG_PKE,
+                                           &seq_num);
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            break;
+        }
+        pCurrentBlk->opaque = seq_num;
+    }
+    pPoolID->numReplayed += iter;
+
+    if (iter < numHeld)
+    {
+        LAC_LOG_ERROR1("Failed to replay %u requests", numHeld - iter);
+    }
+    /* Whatever could not be resubmitted completes as it would have without
+     * replay */
+    (void)LacSwResp_ReplayFail(pPoolID, iter, type);
+
+    return status;
+}
+
+CpaStatus LacSwResp_ReplayFlush(lac_memory_pool_id_t lac_mem_pool,
+                                sal_service_type_t type)
+{
+    lac_mem_pool_hdr_t *pPoolID = (lac_mem_pool_hdr_t *)lac_mem_pool;
+
+    LAC_CHECK_NULL_PARAM(pPoolID);
+
+    return LacSwResp_ReplayFail(pPoolID, 0, type);
+}
 #endif
 #endif
+
+/**
+ *******************************************************************************
+ * @ingroup LacSwResponses
+ * This function returns the memory pool holding the requests of an instance
+ * which can be replayed, or NULL if it has none.
+ ******************************************************************************/
+STATIC
+lac_mem_pool_hdr_t *LacSwResp_ReplayPoolGet(CpaInstanceHandle instanceHandle)
+{
+#if !defined(ICP_DC_ONLY) && !defined(ASYM_NOT_SUPPORTED)
+    sal_service_t *pService = (sal_service_t *)instanceHandle;
+
+    switch (pService->type)
+    {
+        case SAL_SERVICE_TYPE_COMPRESSION:
+            return (lac_mem_pool_hdr_t *)((sal_compression_service_t *)pService)
+                ->compression_mem_pool;
+        case SAL_SERVICE_TYPE_CRYPTO:
+        case SAL_SERVICE_TYPE_CRYPTO_ASYM:
+            return (lac_mem_pool_hdr_t *)((sal_crypto_service_t *)pService)
+                ->lac_pke_req_pool;
+        default:
+            break;
+    }
+#endif
+    return NULL;
+}
+
+CpaStatus icp_sal_ReplayConfig(CpaInstanceHandle instanceHandle,
+                               Cpa32U replayWindow)
+{
+    lac_mem_pool_hdr_t *pPoolID = NULL;
+    lac_mem_blk_t **pReplayBlks = NULL;
+
+    LAC_CHECK_NULL_PARAM(instanceHandle);
+
+    pPoolID = LacSwResp_ReplayPoolGet(instanceHandle);
+    if (NULL == pPoolID)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+    if (!Sal_ServiceIsRunning(instanceHandle))
+    {
+        return CPA_STATUS_RESTARTING;
+    }
+    if (0 != pPoolID->numReplayBlks)
+    {
+        return CPA_STATUS_RETRY;
+    }
+
+    if (replayWindow > pPoolID->numElementsInPool)
+    {
+        replayWindow = pPoolID->numElementsInPool;
+    }
+    if (0 != replayWindow)
+    {
+        if (CPA_STATUS_SUCCESS !=
+            LAC_OS_MALLOC(&pReplayBlks, sizeof(lac_mem_blk_t *) * replayWindow))
+        {
+            LAC_LOG_ERROR("Failed to allocate memory for replay");
+            return CPA_STATUS_RESOURCE;
+        }
+    }
+
+    if (NULL != pPoolID->replayBlks)
+    {
+        LAC_OS_FREE(pPoolID->replayBlks);
+    }
+    pPoolID->replayBlks = pReplayBlks;
+    pPoolID->replayWindow = replayWindow;
+    pPoolID->numReplayHeld = 0;
+    pPoolID->numReplayed = 0;
+    pPoolID->numReplayFailed = 0;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_ReplayGetStats(CpaInstanceHandle instanceHandle,
+                                 icp_sal_replay_stats_t *pStats)
+{
+    lac_mem_pool_hdr_t *pPoolID = NULL;
+
+    LAC_CHECK_NULL_PARAM(instanceHandle);
+    LAC_CHECK_NULL_PARAM(pStats);
+
+    pPoolID = LacSwResp_ReplayPoolGet(instanceHandle);
+    if (NULL == pPoolID)
+    {
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    pStats->numHeld = pPoolID->numReplayHeld;
+    pStats->numReplayed = pPoolID->numReplayed;
+    pStats->numFailed = pPoolID->numReplayFailed;
+    pStats->numPending = pPoolID->numReplayBlks;
+    pStats->replayWindow = pPoolID->replayWindow;
+
+    return CPA_STATUS_SUCCESS;
+}
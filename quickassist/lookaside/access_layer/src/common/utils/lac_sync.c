@@ -98,7 +98,7 @@ void LacSync_GenWakeupSyncCaller(void *pCallbackTag, CpaStatus status)
             return;
         }
         pSc->status = status;
-        LAC_POST_SEMAPHORE(pSc->sid);
+        LAC_SIGNAL_COMPLETION(pSc->completion);
     }
 }
 
@@ -120,7 +120,7 @@ void LacSync_GenVerifyWakeupSyncCaller(void *pCallbackTag,
         }
         pSc->status = status;
         pSc->opResult = opResult;
-        LAC_POST_SEMAPHORE(pSc->sid);
+        LAC_SIGNAL_COMPLETION(pSc->completion);
     }
 }
 
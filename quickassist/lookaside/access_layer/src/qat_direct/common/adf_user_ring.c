@@ -35,6 +35,7 @@
  ***************************************************************************/
 #include <string.h>
 #include <errno.h>
+#include <unistd.h>
 #include "adf_user_ring.h"
 #include "adf_user_cfg.h"
 #include <qae_mem.h>
@@ -43,6 +44,11 @@
 #include <adf_platform_acceldev_gen4.h>
 #include <icp_platform.h>
 #include "adf_io_ring.h"
+#include "icp_adf_trace.h"
+
+#define ADF_TRACE_RING_ID(ring)                                                \
+    ICP_SAL_TRACE_RING(                                                        \
+        (ring)->accel_dev->accelId, (ring)->bank_num, (ring)->ring_num)
 
 static uint32_t validateRingSize(uint32_t num_msgs_on_ring,
                                  uint32_t msg_size_in_bytes,
@@ -161,6 +167,9 @@ CpaStatus adf_user_put_msg(adf_dev_ring_handle_t *ring,
         status = CPA_STATUS_RETRY;
         goto adf_user_put_msg_exit;
     }
+    ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_RING_PUT,
+                  ICP_ADF_TRACE_ID_CURRENT,
+                  ADF_TRACE_RING_ID(ring));
 
     targetAddr = (uint32_t *)(((UARCH_INT)ring->ring_virt_addr) + ring->tail);
     if (ring->message_size == ADF_MSG_SIZE_64_BYTES)
@@ -182,6 +191,9 @@ CpaStatus adf_user_put_msg(adf_dev_ring_handle_t *ring,
     /* and the config space of the device */
     WRITE_CSR_RING_TAIL(
         ring->csr_addr, ring->bank_offset, ring->ring_num, ring->tail);
+    ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_TAIL_WRITE,
+                  ICP_ADF_TRACE_ID_CURRENT,
+                  ADF_TRACE_RING_ID(ring));
 
     ring->csrTailOffset = ring->tail;
 
@@ -192,9 +204,102 @@ CpaStatus adf_user_put_msg(adf_dev_ring_handle_t *ring,
 
 adf_user_put_msg_exit:
     ICP_MUTEX_UNLOCK(ring->user_lock);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        adf_user_notify_wakeup(ring);
+    }
     return status;
 }
 
+CpaStatus adf_user_put_msgs(adf_dev_ring_handle_t *ring,
+                            uint32_t **inBufs,
+                            uint32_t numMsgs,
+                            uint32_t *numPut)
+{
+    CpaStatus status;
+    uint32_t *targetAddr;
+    int64_t flight;
+    uint32_t i;
+    ICP_CHECK_FOR_NULL_PARAM(ring);
+    ICP_CHECK_FOR_NULL_PARAM(inBufs);
+    ICP_CHECK_FOR_NULL_PARAM(numPut);
+    ICP_CHECK_FOR_NULL_PARAM(ring->accel_dev);
+
+    *numPut = 0;
+    if (ring->message_size != ADF_MSG_SIZE_64_BYTES &&
+        ring->message_size != ADF_MSG_SIZE_128_BYTES)
+        return CPA_STATUS_FAIL;
+
+    status = ICP_MUTEX_LOCK(ring->user_lock);
+    if (status)
+    {
+        ADF_ERROR("Failed to lock bank with error %d\n", status);
+        return CPA_STATUS_FAIL;
+    }
+
+    /* Reserve as many slots as the ring has room for */
+    flight = __sync_add_and_fetch(ring->in_flight, numMsgs);
+    if (flight > ring->max_requests_inflight)
+    {
+        i = (uint32_t)(flight - ring->max_requests_inflight);
+        if (i > numMsgs)
+            i = numMsgs;
+        __sync_sub_and_fetch(ring->in_flight, i);
+        numMsgs -= i;
+    }
+    if (0 == numMsgs)
+    {
+        ICP_MUTEX_UNLOCK(ring->user_lock);
+        return CPA_STATUS_RETRY;
+    }
+
+    for (i = 0; i < numMsgs; i++)
+    {
+        ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_RING_PUT,
+                      ICP_ADF_TRACE_ID_CURRENT,
+                      ADF_TRACE_RING_ID(ring));
+        targetAddr =
+            (uint32_t *)(((UARCH_INT)ring->ring_virt_addr) + ring->tail);
+        if (ring->message_size == ADF_MSG_SIZE_64_BYTES)
+        {
+            adf_memcpy64(targetAddr, inBufs[i]);
+        }
+        else
+        {
+            adf_memcpy128(targetAddr, inBufs[i]);
+        }
+        ring->tail = modulo((ring->tail + ring->message_size), ring->modulo);
+    }
+
+    /* One tail write makes the whole burst visible to the device */
+    WRITE_CSR_RING_TAIL(
+        ring->csr_addr, ring->bank_offset, ring->ring_num, ring->tail);
+    ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_TAIL_WRITE,
+                  ICP_ADF_TRACE_ID_CURRENT,
+                  ADF_TRACE_RING_ID(ring));
+
+    ring->csrTailOffset = ring->tail;
+    ring->send_seq += numMsgs;
+    *numPut = numMsgs;
+
+    ICP_MUTEX_UNLOCK(ring->user_lock);
+    adf_user_notify_wakeup(ring);
+    return CPA_STATUS_SUCCESS;
+}
+
+void adf_user_wakeup_poller(icp_adf_wakeup_t *wakeup)
+{
+    uint64_t one = 1;
+
+    if (__sync_bool_compare_and_swap(&wakeup->armed, 1, 0))
+    {
+        if (write(wakeup->fd, &one, sizeof(one)) != sizeof(one))
+        {
+            ADF_DEBUG("Failed to signal poller wakeup fd %d\n", wakeup->fd);
+        }
+    }
+}
+
 int32_t adf_user_check_ring_error(adf_dev_ring_handle_t *ring)
 {
     uint8_t *csr_base_addr = NULL;
@@ -267,6 +372,8 @@ CpaStatus adf_user_notify_msgs_poll(adf_dev_ring_handle_t *ring)
     /* If there are valid messages then process them */
     while ((*msg != EMPTY_RING_SIG_WORD) && (msg_counter < response_quota))
     {
+        ICP_ADF_TRACE(
+            ICP_SAL_TRACE_EVENT_DEQUEUE, 0, ADF_TRACE_RING_ID(ring));
         /* Invoke the callback for the message */
         ring->callback((uint32_t *)msg);
 
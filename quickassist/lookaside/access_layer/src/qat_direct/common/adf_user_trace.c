@@ -0,0 +1,326 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+
+/*****************************************************************************
+ * @file adf_user_trace.c
+ *
+ * @description
+ *      Request lifecycle trace. Every thread records into its own ring, so
+ *      recording needs neither locks nor atomics; the mutex only guards the
+ *      list of rings, which changes once per thread.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include "cpa.h"
+#include "icp_platform.h"
+#include "icp_adf_trace.h"
+
+typedef struct adf_trace_ring_s
+{
+    struct adf_trace_ring_s *next;
+    /* Number of records ever written, the next one goes at head & mask */
+    volatile Cpa64U head;
+    Cpa32U mask;
+    Cpa32U threadId;
+    icp_sal_trace_record_t records[];
+} adf_trace_ring_t;
+
+volatile Cpa32U icp_adf_traceEnabled = 0;
+
+static pthread_mutex_t adf_trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static adf_trace_ring_t *adf_trace_rings = NULL;
+static Cpa32U adf_trace_num_entries = 0;
+/* Bumped by icp_adf_traceFree so that threads drop their freed ring */
+static volatile Cpa64U adf_trace_generation = 1;
+
+static __thread adf_trace_ring_t *adf_trace_ring = NULL;
+static __thread Cpa64U adf_trace_ring_generation = 0;
+static __thread Cpa64U adf_trace_current_id = 0;
+
+static Cpa64U adf_trace_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Cpa64U)ts.tv_sec * 1000000000ULL + (Cpa64U)ts.tv_nsec;
+}
+
+static adf_trace_ring_t *adf_trace_ring_alloc(void)
+{
+    adf_trace_ring_t *ring = NULL;
+    Cpa32U num_entries = 0;
+
+    pthread_mutex_lock(&adf_trace_lock);
+    num_entries = adf_trace_num_entries;
+    ring = ICP_ZALLOC_GEN(sizeof(*ring) +
+                          num_entries * sizeof(icp_sal_trace_record_t));
+    if (NULL != ring)
+    {
+        ring->mask = num_entries - 1;
+        ring->threadId = (Cpa32U)syscall(SYS_gettid);
+        ring->next = adf_trace_rings;
+        adf_trace_rings = ring;
+    }
+    pthread_mutex_unlock(&adf_trace_lock);
+
+    adf_trace_ring = ring;
+    adf_trace_ring_generation = adf_trace_generation;
+    return ring;
+}
+
+void icp_adf_traceRecord(Cpa16U event, Cpa64U id, Cpa32U arg)
+{
+    adf_trace_ring_t *ring = adf_trace_ring;
+    icp_sal_trace_record_t *record = NULL;
+    Cpa64U head = 0;
+
+    if (NULL == ring || adf_trace_ring_generation != adf_trace_generation)
+    {
+        ring = adf_trace_ring_alloc();
+        if (NULL == ring)
+        {
+            return;
+        }
+    }
+
+    if (ICP_ADF_TRACE_ID_CURRENT == id)
+    {
+        id = adf_trace_current_id;
+    }
+    else if (ICP_SAL_TRACE_EVENT_ENQUEUE == event)
+    {
+        adf_trace_current_id = id;
+    }
+
+    head = ring->head;
+    record = &ring->records[head & ring->mask];
+    record->timestampNs = adf_trace_now_ns();
+    record->id = id;
+    record->arg = arg;
+    record->event = event;
+    record->threadId = ring->threadId;
+    /* Publish the record before the head that covers it */
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+CpaStatus icp_adf_traceEnable(Cpa32U numEntries)
+{
+    Cpa32U num_entries = ICP_SAL_TRACE_MIN_ENTRIES;
+
+    if (0 == numEntries)
+    {
+        numEntries = ICP_SAL_TRACE_DEFAULT_ENTRIES;
+    }
+    if (numEntries > ICP_SAL_TRACE_MAX_ENTRIES)
+    {
+        ADF_ERROR("Invalid number of trace entries %u\n", numEntries);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    while (num_entries < numEntries)
+    {
+        num_entries <<= 1;
+    }
+
+    pthread_mutex_lock(&adf_trace_lock);
+    if (NULL == adf_trace_rings)
+    {
+        adf_trace_num_entries = num_entries;
+    }
+    icp_adf_traceEnabled = 1;
+    pthread_mutex_unlock(&adf_trace_lock);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_adf_traceDisable(void)
+{
+    icp_adf_traceEnabled = 0;
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ * Write the records still held by one ring, oldest first
+ */
+static CpaStatus adf_trace_ring_dump(adf_trace_ring_t *ring,
+                                     FILE *file,
+                                     Cpa64U *num_records)
+{
+    Cpa64U head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    Cpa64U size = (Cpa64U)ring->mask + 1;
+    Cpa64U first = (head > size) ? head - size : 0;
+    Cpa64U i = 0;
+
+    for (i = first; i < head; i++)
+    {
+        if (1 != fwrite(&ring->records[i & ring->mask],
+                        sizeof(icp_sal_trace_record_t),
+                        1,
+                        file))
+        {
+            return CPA_STATUS_FAIL;
+        }
+    }
+    *num_records += head - first;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_adf_traceDump(const char *fileName)
+{
+    icp_sal_trace_file_header_t header = { 0 };
+    adf_trace_ring_t *ring = NULL;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    FILE *file = NULL;
+
+    ICP_CHECK_FOR_NULL_PARAM(fileName);
+
+    file = fopen(fileName, "w");
+    if (NULL == file)
+    {
+        ADF_ERROR("Failed to open trace file %s\n", fileName);
+        return CPA_STATUS_FAIL;
+    }
+
+    header.magic = ICP_SAL_TRACE_FILE_MAGIC;
+    header.version = ICP_SAL_TRACE_FILE_VERSION;
+    header.recordSize = sizeof(icp_sal_trace_record_t);
+
+    /* The header is rewritten once the number of records is known */
+    if (1 != fwrite(&header, sizeof(header), 1, file))
+    {
+        status = CPA_STATUS_FAIL;
+    }
+
+    pthread_mutex_lock(&adf_trace_lock);
+    for (ring = adf_trace_rings;
+         (NULL != ring) && (CPA_STATUS_SUCCESS == status);
+         ring = ring->next)
+    {
+        status = adf_trace_ring_dump(ring, file, &header.numRecords);
+    }
+    pthread_mutex_unlock(&adf_trace_lock);
+
+    if ((CPA_STATUS_SUCCESS == status) &&
+        ((0 != fseek(file, 0, SEEK_SET)) ||
+         (1 != fwrite(&header, sizeof(header), 1, file))))
+    {
+        status = CPA_STATUS_FAIL;
+    }
+    if ((0 != fclose(file)) || (CPA_STATUS_SUCCESS != status))
+    {
+        ADF_ERROR("Failed to write trace file %s\n", fileName);
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_adf_traceFree(void)
+{
+    adf_trace_ring_t *ring = NULL;
+
+    if (icp_adf_traceEnabled)
+    {
+        ADF_ERROR("Tracing must be disabled to free the trace rings\n");
+        return CPA_STATUS_FAIL;
+    }
+
+    pthread_mutex_lock(&adf_trace_lock);
+    adf_trace_generation++;
+    while (NULL != adf_trace_rings)
+    {
+        ring = adf_trace_rings;
+        adf_trace_rings = ring->next;
+        ICP_FREE(ring);
+    }
+    pthread_mutex_unlock(&adf_trace_lock);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_adf_traceMeasureOverhead(Cpa32U numEvents,
+                                       Cpa64U *pDisabledNs,
+                                       Cpa64U *pEnabledNs)
+{
+    Cpa32U enabled = icp_adf_traceEnabled;
+    Cpa64U start = 0;
+    Cpa32U i = 0;
+
+    ICP_CHECK_FOR_NULL_PARAM(pDisabledNs);
+    ICP_CHECK_FOR_NULL_PARAM(pEnabledNs);
+    if (0 == numEvents)
+    {
+        ADF_ERROR("Invalid number of events\n");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    if (0 == adf_trace_num_entries)
+    {
+        icp_adf_traceEnable(0);
+    }
+    if (NULL == adf_trace_ring ||
+        adf_trace_ring_generation != adf_trace_generation)
+    {
+        if (NULL == adf_trace_ring_alloc())
+        {
+            icp_adf_traceEnabled = enabled;
+            return CPA_STATUS_RESOURCE;
+        }
+    }
+
+    icp_adf_traceEnabled = 0;
+    start = adf_trace_now_ns();
+    for (i = 0; i < numEvents; i++)
+    {
+        ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_CALIBRATE, i, 0);
+    }
+    *pDisabledNs = (adf_trace_now_ns() - start) / numEvents;
+
+    icp_adf_traceEnabled = 1;
+    start = adf_trace_now_ns();
+    for (i = 0; i < numEvents; i++)
+    {
+        ICP_ADF_TRACE(ICP_SAL_TRACE_EVENT_CALIBRATE, i, 0);
+    }
+    *pEnabledNs = (adf_trace_now_ns() - start) / numEvents;
+
+    icp_adf_traceEnabled = enabled;
+    return CPA_STATUS_SUCCESS;
+}
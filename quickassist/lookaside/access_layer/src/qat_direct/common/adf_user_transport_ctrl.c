@@ -979,6 +979,24 @@ CpaStatus icp_adf_transPutMsg(icp_comms_trans_handle trans_handle,
     return adf_user_put_msg(pRingHandle, inBuf, seq_num);
 }
 
+/*
+ * Put a burst of messages on the transport handle with one tail write
+ */
+CpaStatus icp_adf_transPutMsgs(icp_comms_trans_handle trans_handle,
+                               Cpa32U **inBufs,
+                               Cpa32U bufLen,
+                               Cpa32U numMsgs,
+                               Cpa32U *numPut)
+{
+    adf_dev_ring_handle_t *pRingHandle = (adf_dev_ring_handle_t *)trans_handle;
+
+    ICP_CHECK_FOR_NULL_PARAM(trans_handle);
+    ICP_CHECK_PARAM_RANGE(bufLen * ICP_ADF_BYTES_PER_WORD,
+                          pRingHandle->message_size,
+                          pRingHandle->message_size);
+    return adf_user_put_msgs(pRingHandle, inBufs, numMsgs, numPut);
+}
+
 /*
  * icp_adf_getInflightRequests
  * Function to fetch in-flight and max in-flight request counts for the
@@ -1004,6 +1022,22 @@ CpaStatus icp_adf_getInflightRequests(icp_comms_trans_handle trans_handle,
     return status;
 }
 
+/*
+ * icp_adf_transSetWakeup
+ * Attach or detach the notifier used to wake a blocked polling thread
+ */
+CpaStatus icp_adf_transSetWakeup(icp_comms_trans_handle trans_handle,
+                                 icp_adf_wakeup_t *wakeup)
+{
+    adf_dev_ring_handle_t *pRingHandle = (adf_dev_ring_handle_t *)trans_handle;
+
+    ICP_CHECK_FOR_NULL_PARAM(trans_handle);
+
+    pRingHandle->wakeup = wakeup;
+    __sync_synchronize();
+    return CPA_STATUS_SUCCESS;
+}
+
 /*
  * adf_user_unmap_rings
  * Device is going down - unmap all rings allocated for this device
@@ -110,6 +110,8 @@ typedef struct adf_dev_ring_handle_s
     uint32_t csrTailOffset;
 
     uint32_t *csr_addr;
+    /* notifier for a blocked polling thread, may be NULL */
+    icp_adf_wakeup_t *wakeup;
 } adf_dev_ring_handle_t;
 
 
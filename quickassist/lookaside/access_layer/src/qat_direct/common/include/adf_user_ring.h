@@ -70,6 +70,43 @@ CpaStatus adf_user_put_msg(adf_dev_ring_handle_t *ring,
                            uint32_t *inBuf,
                            uint64_t *seq_num);
 
+/*
+ * adf_user_put_msgs
+ *
+ * Description
+ * Copy up to numMsgs messages onto the ring and write the tail once.
+ * numPut returns how many fitted; CPA_STATUS_RETRY when none did.
+ */
+CpaStatus adf_user_put_msgs(adf_dev_ring_handle_t *ring,
+                            uint32_t **inBufs,
+                            uint32_t numMsgs,
+                            uint32_t *numPut);
+
+/*
+ * adf_user_wakeup_poller
+ *
+ * Description
+ * Disarm the wakeup notifier and signal its eventfd. Only the caller that
+ * disarms it writes, so a burst of messages costs a single write.
+ */
+void adf_user_wakeup_poller(icp_adf_wakeup_t *wakeup);
+
+/*
+ * adf_user_notify_wakeup
+ *
+ * Description
+ * Called after a request was made visible to the device. Must follow
+ * the in-flight counter update so that a poller which armed the notifier
+ * either sees the request in flight or gets woken up.
+ */
+static inline void adf_user_notify_wakeup(adf_dev_ring_handle_t *ring)
+{
+    if (NULL != ring->wakeup && ring->wakeup->armed)
+    {
+        adf_user_wakeup_poller(ring->wakeup);
+    }
+}
+
 /*
  * adf_user_check_ring_error
  *
@@ -0,0 +1,136 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+/*****************************************************************************
+ * @file adf_emul.h
+ *
+ * @description
+ *      Internal definitions shared by the emulated ADF device. The emulated
+ *      device implements the adf_io interface on top of anonymous memory:
+ *      bundle CSRs live in a heap allocation and a firmware stand-in thread
+ *      consumes requests from the tx rings and writes responses to the
+ *      matching rx rings.
+ *
+ *****************************************************************************/
+#ifndef ADF_EMUL_H
+#define ADF_EMUL_H
+
+#include <pthread.h>
+#include "cpa.h"
+#include "icp_accel_devices.h"
+#include "icp_qat_fw.h"
+
+#define ADF_EMUL_NUM_DEVICES 1
+#define ADF_EMUL_NUM_BANKS 4
+#define ADF_EMUL_RINGS_PER_BANK 2
+#define ADF_EMUL_BANK_SIZE 8192
+#define ADF_EMUL_ARB_MASK 0x1
+#define ADF_EMUL_NUM_CY_INSTANCES 2
+#define ADF_EMUL_NUM_DC_INSTANCES 2
+#define ADF_EMUL_NUM_CONCURRENT_REQUESTS 512
+#define ADF_EMUL_DEVICE_NAME "4xxxvf"
+#define ADF_EMUL_PCI_DEVICE_ID 0x4941
+#define ADF_EMUL_CAPABILITIES                                                  \
+    (ICP_ACCEL_CAPABILITIES_CRYPTO_SYMMETRIC | ICP_ACCEL_CAPABILITIES_CIPHER | \
+     ICP_ACCEL_CAPABILITIES_AUTHENTICATION |                                   \
+     ICP_ACCEL_CAPABILITIES_COMPRESSION)
+/* Compress-and-verify (0x01) and its recovery variant (0x100) */
+#define ADF_EMUL_DC_EXTENDED_FEATURES 0x101
+/* Largest request or response handled by the firmware stand-in */
+#define ADF_EMUL_MAX_MSG_SIZE 128
+
+/* Emulated state of a single ring as seen from the device side */
+typedef struct adf_emul_ring_s
+{
+    Cpa8U *virt;
+    /**< Ring memory, as registered by adf_io_enable_ring */
+    Cpa32U size;
+    /**< Ring size in bytes */
+    Cpa32U msg_size;
+    /**< Message size in bytes */
+    Cpa32U offset;
+    /**< Device side offset: consumer for tx rings, producer for rx rings */
+} adf_emul_ring_t;
+
+typedef struct adf_emul_dev_s
+{
+    Cpa32U accel_id;
+    Cpa8U *csr;
+    /**< Emulated BAR holding ADF_EMUL_NUM_BANKS bundles of CSRs */
+    pthread_t fw_thread;
+    pthread_mutex_t lock;
+    /**< Protects the ring table against enable/disable from the host */
+    volatile int running;
+    volatile int hung;
+    /**< Set by a simulated heartbeat failure until the device restarts */
+    adf_emul_ring_t rings[ADF_EMUL_NUM_BANKS][ADF_EMUL_RINGS_PER_BANK];
+} adf_emul_dev_t;
+
+/* Linearised view of the source or destination data of a request */
+typedef struct adf_emul_buf_s
+{
+    Cpa8U *data;
+    Cpa32U len;
+} adf_emul_buf_t;
+
+/* Firmware stand-in lifecycle, see adf_emul_fw.c */
+int adf_emul_fw_start(adf_emul_dev_t *dev);
+void adf_emul_fw_stop(adf_emul_dev_t *dev);
+
+#ifdef ICP_HB_FAIL_SIM
+/* Heartbeat failure simulation, see adf_emul_user_proxy.c */
+CpaStatus adf_emul_hb_fail(Cpa32U accel_id);
+#endif
+
+/* Data helpers shared by the service handlers */
+void *adf_emul_phys_to_virt(Cpa64U phys);
+CpaStatus adf_emul_gather(Cpa64U addr,
+                          CpaBoolean sgl,
+                          Cpa32U flat_len,
+                          adf_emul_buf_t *buf);
+CpaStatus adf_emul_scatter(Cpa64U addr,
+                           CpaBoolean sgl,
+                           Cpa32U flat_len,
+                           const Cpa8U *data,
+                           Cpa32U len);
+void adf_emul_resp_hdr_build(const icp_qat_fw_comn_req_hdr_t *req_hdr,
+                             icp_qat_fw_comn_resp_hdr_t *resp_hdr,
+                             Cpa8U comn_status);
+
+/* Service handlers: build the response for a request message */
+void adf_emul_la_process(const Cpa8U *req, Cpa8U *resp);
+void adf_emul_dc_process(const Cpa8U *req, Cpa8U *resp);
+
+#endif /* ADF_EMUL_H */
@@ -0,0 +1,396 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "adf_kernel_types.h"
+
+#include "adf_io_cfg.h"
+#include "cpa.h"
+#include "icp_accel_devices.h"
+#include "icp_platform.h"
+#include "qat_log.h"
+#include "adf_emul.h"
+
+/*
+ * The emulated device mirrors the default configuration qatmgr hands out
+ * for a 4xxx VF running sym and dc: Cy instances own the first banks and
+ * Dc instances the following ones, each using ring 0 for requests and
+ * ring 1 for responses.
+ */
+#define EMUL_RING_TX 0
+#define EMUL_RING_RX 1
+
+CpaStatus adf_io_getNumDevices(unsigned int *num_devices)
+{
+    ICP_CHECK_FOR_NULL_PARAM(num_devices);
+
+    *num_devices = ADF_EMUL_NUM_DEVICES;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus cfg_getValueFromDeviceInfo(const Cpa32U accelId,
+                                            const char *pParamName,
+                                            char *pParamValue)
+{
+    ICP_CHECK_FOR_NULL_PARAM(pParamName);
+    ICP_CHECK_FOR_NULL_PARAM(pParamValue);
+
+    if (!ICP_STRNCMP_CONST(pParamName, "Device_Max_Banks"))
+    {
+        snprintf(pParamValue,
+                 ADF_CFG_MAX_VAL_LEN_IN_BYTES,
+                 "%u",
+                 ADF_EMUL_NUM_BANKS);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "Device_Capabilities_Mask"))
+    {
+        snprintf(pParamValue,
+                 ADF_CFG_MAX_VAL_LEN_IN_BYTES,
+                 "0x%x",
+                 ADF_EMUL_CAPABILITIES);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "Device_DcExtendedFeatures"))
+    {
+        snprintf(pParamValue,
+                 ADF_CFG_MAX_VAL_LEN_IN_BYTES,
+                 "0x%x",
+                 ADF_EMUL_DC_EXTENDED_FEATURES);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "ServicesEnabled"))
+    {
+        sprintf(pParamValue, "dc;sym");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "statsGeneral"))
+    {
+        sprintf(pParamValue, "1");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "Device_PkgId"))
+    {
+        snprintf(pParamValue, ADF_CFG_MAX_VAL_LEN_IN_BYTES, "%u", accelId);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "Device_NodeId"))
+    {
+        sprintf(pParamValue, "0");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "HW_RevId") ||
+        !ICP_STRNCMP_CONST(pParamName, "Firmware_UofVer") ||
+        !ICP_STRNCMP_CONST(pParamName, "Firmware_MmpVer"))
+    {
+        sprintf(pParamValue, "N/A");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "NumberCyInstances"))
+    {
+        snprintf(pParamValue,
+                 ADF_CFG_MAX_VAL_LEN_IN_BYTES,
+                 "%u",
+                 ADF_EMUL_NUM_CY_INSTANCES);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(pParamName, "NumberDcInstances"))
+    {
+        snprintf(pParamValue,
+                 ADF_CFG_MAX_VAL_LEN_IN_BYTES,
+                 "%u",
+                 ADF_EMUL_NUM_DC_INSTANCES);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    ADF_ERROR("Unsupported config parameter %s\n", pParamName);
+    return CPA_STATUS_FAIL;
+}
+
+static CpaStatus cfg_getDcInstanceValue(const unsigned serv_num,
+                                        const char *pParamName,
+                                        char *pParamValue)
+{
+    const char *name;
+
+    ICP_CHECK_FOR_NULL_PARAM(pParamName);
+    ICP_CHECK_FOR_NULL_PARAM(pParamValue);
+
+    if (serv_num >= ADF_EMUL_NUM_DC_INSTANCES)
+    {
+        ADF_ERROR("Unknown dc instance %u\n", serv_num);
+        return CPA_STATUS_FAIL;
+    }
+
+    /* Skip past the Dc<n> part of the parameter name */
+    name = pParamName + 2;
+    while (*name >= '0' && *name <= '9')
+        name++;
+
+    if (!ICP_STRNCMP_CONST(name, "BankNumber"))
+    {
+        snprintf(pParamValue,
+                 ADF_CFG_MAX_VAL_LEN_IN_BYTES,
+                 "%u",
+                 ADF_EMUL_NUM_CY_INSTANCES + serv_num);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "IsPolled"))
+    {
+        sprintf(pParamValue, "1");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "CoreAffinity"))
+    {
+        sprintf(pParamValue, "0");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "NumConcurrentRequests"))
+    {
+        snprintf(pParamValue,
+                 ADF_CFG_MAX_VAL_LEN_IN_BYTES,
+                 "%u",
+                 ADF_EMUL_NUM_CONCURRENT_REQUESTS);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "RingTx"))
+    {
+        snprintf(
+            pParamValue, ADF_CFG_MAX_VAL_LEN_IN_BYTES, "%u", EMUL_RING_TX);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "RingRx"))
+    {
+        snprintf(
+            pParamValue, ADF_CFG_MAX_VAL_LEN_IN_BYTES, "%u", EMUL_RING_RX);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "Name"))
+    {
+        snprintf(pParamValue, ADF_CFG_MAX_VAL_LEN_IN_BYTES, "dc%u", serv_num);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    ADF_ERROR("Unsupported config parameter %s\n", pParamName);
+    return CPA_STATUS_FAIL;
+}
+
+static CpaStatus cfg_getCyInstanceValue(const unsigned serv_num,
+                                        const char *pParamName,
+                                        char *pParamValue)
+{
+    const char *name;
+
+    ICP_CHECK_FOR_NULL_PARAM(pParamName);
+    ICP_CHECK_FOR_NULL_PARAM(pParamValue);
+
+    if (serv_num >= ADF_EMUL_NUM_CY_INSTANCES)
+    {
+        ADF_ERROR("Unknown cy instance %u\n", serv_num);
+        return CPA_STATUS_FAIL;
+    }
+
+    /* Skip past the Cy<n> part of the parameter name */
+    name = pParamName + 2;
+    while (*name >= '0' && *name <= '9')
+        name++;
+
+    /* Asym is not emulated, its parameters alias the sym ring pair */
+    if (!ICP_STRNCMP_CONST(name, "BankNumber") ||
+        !ICP_STRNCMP_CONST(name, "BankNumberAsym") ||
+        !ICP_STRNCMP_CONST(name, "BankNumberSym"))
+    {
+        snprintf(pParamValue, ADF_CFG_MAX_VAL_LEN_IN_BYTES, "%u", serv_num);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "IsPolled"))
+    {
+        sprintf(pParamValue, "1");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "CoreAffinity"))
+    {
+        sprintf(pParamValue, "0");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "NumConcurrentAsymRequests"))
+    {
+        sprintf(pParamValue, "0");
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "NumConcurrentSymRequests"))
+    {
+        snprintf(pParamValue,
+                 ADF_CFG_MAX_VAL_LEN_IN_BYTES,
+                 "%u",
+                 ADF_EMUL_NUM_CONCURRENT_REQUESTS);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "RingSymTx") ||
+        !ICP_STRNCMP_CONST(name, "RingAsymTx"))
+    {
+        snprintf(
+            pParamValue, ADF_CFG_MAX_VAL_LEN_IN_BYTES, "%u", EMUL_RING_TX);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "RingSymRx") ||
+        !ICP_STRNCMP_CONST(name, "RingAsymRx"))
+    {
+        snprintf(
+            pParamValue, ADF_CFG_MAX_VAL_LEN_IN_BYTES, "%u", EMUL_RING_RX);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    if (!ICP_STRNCMP_CONST(name, "Name"))
+    {
+        snprintf(pParamValue, ADF_CFG_MAX_VAL_LEN_IN_BYTES, "sym%u", serv_num);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    ADF_ERROR("Unsupported config parameter %s\n", pParamName);
+    return CPA_STATUS_FAIL;
+}
+
+CpaStatus adf_io_cfgGetParamValue(icp_accel_dev_t *accel_dev,
+                                  const char *pSection,
+                                  const char *pParamName,
+                                  char *pParamValue)
+{
+    unsigned serv_num;
+
+    ICP_CHECK_FOR_NULL_PARAM(accel_dev);
+    ICP_CHECK_FOR_NULL_PARAM(pSection);
+    ICP_CHECK_FOR_NULL_PARAM(pParamName);
+    ICP_CHECK_FOR_NULL_PARAM(pParamValue);
+
+    if (ICP_STRNCMP_CONST(pSection, "GENERAL") == 0 ||
+        !ICP_STRNCMP_CONST_NO_NULL(pParamName, "Number"))
+    {
+        return cfg_getValueFromDeviceInfo(
+            accel_dev->accelId, pParamName, pParamValue);
+    }
+
+    if (sscanf(pParamName, "Dc%u", &serv_num) == 1)
+        return cfg_getDcInstanceValue(serv_num, pParamName, pParamValue);
+
+    if (sscanf(pParamName, "Cy%u", &serv_num) == 1)
+        return cfg_getCyInstanceValue(serv_num, pParamName, pParamValue);
+
+    ADF_ERROR("Unsupported config parameter %s\n", pParamName);
+    return CPA_STATUS_FAIL;
+}
+
+Cpa32S adf_io_cfgGetDomainAddress(Cpa16U accelId)
+{
+    if (accelId >= ADF_EMUL_NUM_DEVICES)
+        return ADF_IO_OPERATION_FAIL_CPA32S;
+
+    return 0;
+}
+
+Cpa16U adf_io_cfgGetBusAddress(Cpa16U accelId)
+{
+    if (accelId >= ADF_EMUL_NUM_DEVICES)
+        return ADF_IO_OPERATION_FAIL_CPA16U;
+
+    /* Report the device as function <accelId> of bus 0, device 0 */
+    return accelId & 0x7;
+}
+
+CpaStatus adf_io_reset_device(Cpa32U accelId)
+{
+    return CPA_STATUS_UNSUPPORTED;
+}
+
+int adf_io_cfgCheckUserSection(int dev_id, uint8_t *pSectionPresent)
+{
+    *pSectionPresent = 1;
+    return 0;
+}
+
+CpaBoolean adf_io_isDeviceAvailable(void)
+{
+    return CPA_TRUE;
+}
+
+Cpa16U adf_io_getNumPfs(void)
+{
+    return ADF_IO_OPERATION_FAIL_CPA16U;
+}
+
+CpaStatus adf_io_getPfInfo(icp_accel_pf_info_t *pPfInfo)
+{
+    ICP_CHECK_FOR_NULL_PARAM(pPfInfo);
+
+    ADF_ERROR("No PFs found, assuming running inside VM!\n");
+    return CPA_STATUS_RESOURCE;
+}
+
+CpaStatus adf_io_getHeartBeatStatus(Cpa32U packageId)
+{
+    return CPA_STATUS_UNSUPPORTED;
+}
+
+#ifdef ICP_HB_FAIL_SIM
+CpaStatus adf_io_heartbeatSimulateFailure(Cpa32U packageId)
+{
+    return adf_emul_hb_fail(packageId);
+}
+#endif
@@ -0,0 +1,356 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "cpa.h"
+#include "icp_platform.h"
+#include "adf_platform_common.h"
+#include "adf_platform_acceldev_common.h"
+#include "adf_dev_ring_ctl.h"
+#include "icp_qat_fw.h"
+#include "icp_buffer_desc.h"
+#include "qae_mem.h"
+#include "qat_log.h"
+#include "adf_emul.h"
+
+/* Requests serviced on a ring pair before moving on to the next one */
+#define EMUL_FW_RING_BUDGET 32
+/* Idle passes spent yielding before the thread starts sleeping */
+#define EMUL_FW_IDLE_SPINS 1024
+#define EMUL_FW_IDLE_SLEEP_US 50
+
+void *adf_emul_phys_to_virt(Cpa64U phys)
+{
+    if (!phys)
+        return NULL;
+
+    return qaePhysToVirtNUMA(phys);
+}
+
+CpaStatus adf_emul_gather(Cpa64U addr,
+                          CpaBoolean sgl,
+                          Cpa32U flat_len,
+                          adf_emul_buf_t *buf)
+{
+    icp_buffer_list_desc_t *desc;
+    Cpa8U *src;
+    Cpa32U i, len = 0;
+
+    buf->data = NULL;
+    buf->len = 0;
+
+    if (!sgl)
+    {
+        src = adf_emul_phys_to_virt(addr);
+        if (!src && flat_len)
+            return CPA_STATUS_FAIL;
+
+        buf->data = malloc(flat_len ? flat_len : 1);
+        if (!buf->data)
+            return CPA_STATUS_RESOURCE;
+        if (flat_len)
+            memcpy(buf->data, src, flat_len);
+        buf->len = flat_len;
+        return CPA_STATUS_SUCCESS;
+    }
+
+    desc = adf_emul_phys_to_virt(addr);
+    if (!desc)
+        return CPA_STATUS_FAIL;
+
+    for (i = 0; i < desc->numBuffers; i++)
+        len += desc->phyBuffers[i].dataLenInBytes;
+
+    buf->data = malloc(len ? len : 1);
+    if (!buf->data)
+        return CPA_STATUS_RESOURCE;
+
+    for (i = 0; i < desc->numBuffers; i++)
+    {
+        Cpa32U seg_len = desc->phyBuffers[i].dataLenInBytes;
+
+        if (!seg_len)
+            continue;
+
+        src = adf_emul_phys_to_virt(desc->phyBuffers[i].phyBuffer);
+        if (!src)
+        {
+            free(buf->data);
+            buf->data = NULL;
+            return CPA_STATUS_FAIL;
+        }
+        memcpy(buf->data + buf->len, src, seg_len);
+        buf->len += seg_len;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus adf_emul_scatter(Cpa64U addr,
+                           CpaBoolean sgl,
+                           Cpa32U flat_len,
+                           const Cpa8U *data,
+                           Cpa32U len)
+{
+    icp_buffer_list_desc_t *desc;
+    Cpa8U *dst;
+    Cpa32U i, done = 0;
+
+    if (!sgl)
+    {
+        if (len > flat_len)
+            return CPA_STATUS_FAIL;
+        dst = adf_emul_phys_to_virt(addr);
+        if (!dst && len)
+            return CPA_STATUS_FAIL;
+        if (len)
+            memcpy(dst, data, len);
+        return CPA_STATUS_SUCCESS;
+    }
+
+    desc = adf_emul_phys_to_virt(addr);
+    if (!desc)
+        return CPA_STATUS_FAIL;
+
+    for (i = 0; i < desc->numBuffers && done < len; i++)
+    {
+        Cpa32U seg_len = desc->phyBuffers[i].dataLenInBytes;
+
+        if (seg_len > len - done)
+            seg_len = len - done;
+        if (!seg_len)
+            continue;
+
+        dst = adf_emul_phys_to_virt(desc->phyBuffers[i].phyBuffer);
+        if (!dst)
+            return CPA_STATUS_FAIL;
+        memcpy(dst, data + done, seg_len);
+        done += seg_len;
+    }
+
+    return (done == len) ? CPA_STATUS_SUCCESS : CPA_STATUS_FAIL;
+}
+
+void adf_emul_resp_hdr_build(const icp_qat_fw_comn_req_hdr_t *req_hdr,
+                             icp_qat_fw_comn_resp_hdr_t *resp_hdr,
+                             Cpa8U comn_status)
+{
+    resp_hdr->service_id = req_hdr->service_type;
+    resp_hdr->hdr_flags =
+        ICP_QAT_FW_COMN_HDR_FLAGS_BUILD(ICP_QAT_FW_COMN_REQ_FLAG_SET);
+    resp_hdr->comn_status = comn_status;
+    resp_hdr->cmd_id = req_hdr->service_cmd_id;
+}
+
+/*
+ * Every common response carries the request opaque data in LW2-3, right
+ * after the response header, which is all the host needs to find the
+ * callback for a request type the emulator does not implement.
+ */
+static void emul_unsupported_process(const Cpa8U *req, Cpa8U *resp)
+{
+    const icp_qat_fw_comn_req_t *pReq = (const icp_qat_fw_comn_req_t *)req;
+
+    adf_emul_resp_hdr_build(
+        &pReq->comn_hdr,
+        (icp_qat_fw_comn_resp_hdr_t *)resp,
+        ICP_QAT_FW_COMN_RESP_STATUS_BUILD(ICP_QAT_FW_COMN_STATUS_FLAG_ERROR,
+                                          ICP_QAT_FW_COMN_STATUS_FLAG_ERROR,
+                                          ICP_QAT_FW_COMN_STATUS_FLAG_ERROR,
+                                          ICP_QAT_FW_COMN_STATUS_FLAG_OK,
+                                          0,
+                                          1,
+                                          0));
+    memcpy(resp + sizeof(icp_qat_fw_comn_resp_hdr_t),
+           &pReq->comn_mid.opaque_data,
+           sizeof(pReq->comn_mid.opaque_data));
+}
+
+static void emul_fw_dispatch(const Cpa8U *req, Cpa8U *resp)
+{
+    const icp_qat_fw_comn_req_hdr_t *hdr =
+        (const icp_qat_fw_comn_req_hdr_t *)req;
+
+    switch (hdr->service_type)
+    {
+        case ICP_QAT_FW_COMN_REQ_CPM_FW_LA:
+            adf_emul_la_process(req, resp);
+            break;
+        case ICP_QAT_FW_COMN_REQ_CPM_FW_COMP:
+            adf_emul_dc_process(req, resp);
+            break;
+        default:
+            emul_unsupported_process(req, resp);
+            break;
+    }
+}
+
+/*
+ * Service one request/response ring pair. Requests are consumed from the
+ * device side head up to the tail CSR written by the host. Each response
+ * is written with its first word last, since a word different from
+ * EMPTY_RING_SIG_WORD is what tells the host poller that a response is
+ * complete. Returns the number of requests serviced.
+ */
+static Cpa32U emul_fw_service_ring_pair(adf_emul_dev_t *dev,
+                                        Cpa32U bank,
+                                        Cpa32U tx_nr,
+                                        Cpa32U rx_nr)
+{
+    adf_emul_ring_t *tx = &dev->rings[bank][tx_nr];
+    adf_emul_ring_t *rx = &dev->rings[bank][rx_nr];
+    Cpa8U *csr = dev->csr + (ADF_EMUL_BANK_SIZE * bank);
+    Cpa32U req[ADF_EMUL_MAX_MSG_SIZE / sizeof(Cpa32U)];
+    Cpa32U resp[ADF_EMUL_MAX_MSG_SIZE / sizeof(Cpa32U)];
+    Cpa32U *tail_csr;
+    Cpa32U *slot;
+    Cpa32U tail;
+    Cpa32U done = 0;
+
+    if (!tx->virt || !rx->virt || tx->msg_size > ADF_EMUL_MAX_MSG_SIZE ||
+        rx->msg_size > ADF_EMUL_MAX_MSG_SIZE)
+        return 0;
+
+    tail_csr = (Cpa32U *)(csr + ICP_RING_CSR_RING_TAIL_OFFSET + (tx_nr << 2));
+    tail = __atomic_load_n(tail_csr, __ATOMIC_ACQUIRE);
+
+    while (tx->offset != tail && done < EMUL_FW_RING_BUDGET)
+    {
+        slot = (Cpa32U *)(rx->virt + rx->offset);
+        /* The response ring is full until the host polls it */
+        if (__atomic_load_n(slot, __ATOMIC_ACQUIRE) != EMPTY_RING_SIG_WORD)
+            break;
+
+        memcpy(req, tx->virt + tx->offset, tx->msg_size);
+        memset(resp, 0, sizeof(resp));
+        emul_fw_dispatch((Cpa8U *)req, (Cpa8U *)resp);
+
+        memcpy(slot + 1, resp + 1, rx->msg_size - sizeof(Cpa32U));
+        __atomic_store_n(slot, resp[0], __ATOMIC_RELEASE);
+
+        tx->offset = (tx->offset + tx->msg_size) % tx->size;
+        rx->offset = (rx->offset + rx->msg_size) % rx->size;
+        done++;
+    }
+
+    if (done)
+    {
+        ICP_ADF_CSR_WR(
+            csr, ICP_RING_CSR_RING_HEAD_OFFSET + (tx_nr << 2), tx->offset);
+        ICP_ADF_CSR_WR(
+            csr, ICP_RING_CSR_RING_TAIL_OFFSET + (rx_nr << 2), rx->offset);
+    }
+
+    return done;
+}
+
+static void *emul_fw_thread(void *arg)
+{
+    adf_emul_dev_t *dev = arg;
+    Cpa32U shift = __builtin_popcount(ADF_EMUL_ARB_MASK);
+    Cpa32U idle = 0;
+    Cpa32U bank, tx_nr, done;
+
+    while (dev->running)
+    {
+        done = 0;
+
+        /* A hung device neither consumes requests nor answers them */
+        if (dev->hung)
+        {
+            usleep(EMUL_FW_IDLE_SLEEP_US);
+            continue;
+        }
+
+        pthread_mutex_lock(&dev->lock);
+        for (bank = 0; bank < ADF_EMUL_NUM_BANKS; bank++)
+        {
+            for (tx_nr = 0; tx_nr + shift < ADF_EMUL_RINGS_PER_BANK; tx_nr++)
+            {
+                if (!(ADF_EMUL_ARB_MASK & (1 << tx_nr)))
+                    continue;
+                done +=
+                    emul_fw_service_ring_pair(dev, bank, tx_nr, tx_nr + shift);
+            }
+        }
+        pthread_mutex_unlock(&dev->lock);
+
+        if (done)
+        {
+            idle = 0;
+        }
+        else if (idle < EMUL_FW_IDLE_SPINS)
+        {
+            idle++;
+            sched_yield();
+        }
+        else
+        {
+            usleep(EMUL_FW_IDLE_SLEEP_US);
+        }
+    }
+
+    return NULL;
+}
+
+int adf_emul_fw_start(adf_emul_dev_t *dev)
+{
+    ICP_CHECK_FOR_NULL_PARAM_RET_CODE(dev, -1);
+
+    dev->running = 1;
+    if (pthread_create(&dev->fw_thread, NULL, emul_fw_thread, dev))
+    {
+        dev->running = 0;
+        return -1;
+    }
+
+    return 0;
+}
+
+void adf_emul_fw_stop(adf_emul_dev_t *dev)
+{
+    ICP_CHECK_FOR_NULL_PARAM_VOID(dev);
+
+    if (!dev->running)
+        return;
+
+    dev->running = 0;
+    pthread_join(dev->fw_thread, NULL);
+}
@@ -0,0 +1,239 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+/*****************************************************************************
+ * @file adf_emul_fw_dc.c
+ *
+ * @description
+ *      Compression requests for the emulated device. Stateless deflate
+ *      compression (static and dynamic Huffman) and decompression are
+ *      implemented with zlib on raw deflate streams, and the legacy
+ *      CRC32/Adler32 fields of the response are computed over the
+ *      uncompressed data.
+ *
+ *****************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#include "cpa.h"
+#include "icp_qat_fw.h"
+#include "icp_qat_fw_comp.h"
+#include "adf_emul.h"
+
+#define EMUL_DC_WINDOW_BITS (-15)
+#define EMUL_DC_MEM_LEVEL 8
+
+/* Result of a request, reported through the response */
+typedef struct emul_dc_result_s
+{
+    Cpa8S err_code;
+    CpaBoolean unsupported;
+    CpaBoolean end_of_last_block;
+    Cpa32U consumed;
+    Cpa32U produced;
+} emul_dc_result_t;
+
+static int emul_dc_deflate(const icp_qat_fw_comp_req_t *pReq,
+                           adf_emul_buf_t *src,
+                           Cpa8U *dst,
+                           emul_dc_result_t *result)
+{
+    Cpa32U flags = pReq->comp_pars.req_par_flags;
+    int strategy = (ICP_QAT_FW_COMP_CMD_STATIC ==
+                    pReq->comn_hdr.service_cmd_id)
+                       ? Z_FIXED
+                       : Z_DEFAULT_STRATEGY;
+    z_stream strm;
+    int ret;
+
+    memset(&strm, 0, sizeof(strm));
+    ret = deflateInit2(&strm,
+                       Z_BEST_SPEED,
+                       Z_DEFLATED,
+                       EMUL_DC_WINDOW_BITS,
+                       EMUL_DC_MEM_LEVEL,
+                       strategy);
+    if (Z_OK != ret)
+        return ret;
+
+    strm.next_in = src->data;
+    strm.avail_in = src->len;
+    strm.next_out = dst;
+    strm.avail_out = pReq->comp_pars.out_buffer_sz;
+
+    ret = deflate(&strm,
+                  ICP_QAT_FW_COMP_BFINAL_GET(flags) ? Z_FINISH
+                                                    : Z_FULL_FLUSH);
+    /* Any input or pending output left over means the output overflowed */
+    if ((Z_STREAM_END != ret && Z_OK != ret) || strm.avail_in ||
+        (Z_OK == ret && !strm.avail_out))
+    {
+        result->err_code = ERR_CODE_OVERFLOW_ERROR;
+    }
+    else
+    {
+        result->consumed = strm.total_in;
+        result->produced = strm.total_out;
+    }
+
+    deflateEnd(&strm);
+    return Z_OK;
+}
+
+static int emul_dc_inflate(const icp_qat_fw_comp_req_t *pReq,
+                           adf_emul_buf_t *src,
+                           Cpa8U *dst,
+                           emul_dc_result_t *result)
+{
+    z_stream strm;
+    int ret;
+
+    memset(&strm, 0, sizeof(strm));
+    ret = inflateInit2(&strm, EMUL_DC_WINDOW_BITS);
+    if (Z_OK != ret)
+        return ret;
+
+    strm.next_in = src->data;
+    strm.avail_in = src->len;
+    strm.next_out = dst;
+    strm.avail_out = pReq->comp_pars.out_buffer_sz;
+
+    ret = inflate(&strm, Z_SYNC_FLUSH);
+    if (Z_STREAM_END == ret)
+    {
+        result->end_of_last_block = CPA_TRUE;
+    }
+    else if (Z_OK != ret && Z_BUF_ERROR != ret)
+    {
+        result->err_code = ERR_CODE_INV_LIT_LEN_DIS_IN_BLK;
+    }
+    else if (!strm.avail_out && strm.avail_in)
+    {
+        result->err_code = ERR_CODE_OVERFLOW_ERROR;
+    }
+
+    result->consumed = strm.total_in;
+    result->produced = strm.total_out;
+
+    inflateEnd(&strm);
+    return Z_OK;
+}
+
+void adf_emul_dc_process(const Cpa8U *req, Cpa8U *resp)
+{
+    const icp_qat_fw_comp_req_t *pReq = (const icp_qat_fw_comp_req_t *)req;
+    icp_qat_fw_comp_resp_t *pResp = (icp_qat_fw_comp_resp_t *)resp;
+    Cpa8U cmd = pReq->comn_hdr.service_cmd_id;
+    CpaBoolean sgl = (QAT_COMN_PTR_TYPE_SGL ==
+                      ICP_QAT_FW_COMN_PTR_TYPE_GET(
+                          pReq->comn_hdr.comn_req_flags))
+                         ? CPA_TRUE
+                         : CPA_FALSE;
+    emul_dc_result_t result = {0};
+    adf_emul_buf_t src = {0};
+    Cpa8U *dst = NULL;
+    const Cpa8U *plain;
+    Cpa32U plain_len;
+    int ret;
+
+    if (cmd > ICP_QAT_FW_COMP_CMD_DECOMPRESS)
+    {
+        result.unsupported = CPA_TRUE;
+        result.err_code = ERR_CODE_MISC_ERROR;
+        goto build_resp;
+    }
+
+    dst = malloc(pReq->comp_pars.out_buffer_sz ? pReq->comp_pars.out_buffer_sz
+                                               : 1);
+    if (!dst || CPA_STATUS_SUCCESS !=
+                    adf_emul_gather(pReq->comn_mid.src_data_addr,
+                                    sgl,
+                                    pReq->comn_mid.src_length,
+                                    &src))
+    {
+        result.err_code = ERR_CODE_FATAL_ERROR;
+        goto build_resp;
+    }
+    if (src.len > pReq->comp_pars.comp_len)
+        src.len = pReq->comp_pars.comp_len;
+
+    if (ICP_QAT_FW_COMP_CMD_DECOMPRESS == cmd)
+        ret = emul_dc_inflate(pReq, &src, dst, &result);
+    else
+        ret = emul_dc_deflate(pReq, &src, dst, &result);
+    if (Z_OK != ret)
+        result.err_code = ERR_CODE_FATAL_ERROR;
+
+    if (!result.err_code &&
+        CPA_STATUS_SUCCESS != adf_emul_scatter(pReq->comn_mid.dest_data_addr,
+                                               sgl,
+                                               pReq->comn_mid.dst_length,
+                                               dst,
+                                               result.produced))
+        result.err_code = ERR_CODE_FATAL_ERROR;
+
+    if (!result.err_code)
+    {
+        plain = (ICP_QAT_FW_COMP_CMD_DECOMPRESS == cmd) ? dst : src.data;
+        plain_len = (ICP_QAT_FW_COMP_CMD_DECOMPRESS == cmd) ? result.produced
+                                                            : result.consumed;
+        pResp->comp_resp_pars.crc.legacy.curr_crc32 =
+            crc32(pReq->comp_pars.crc.legacy.initial_crc32, plain, plain_len);
+        pResp->comp_resp_pars.crc.legacy.curr_adler_32 = adler32(
+            pReq->comp_pars.crc.legacy.initial_adler, plain, plain_len);
+        pResp->comp_resp_pars.input_byte_counter = result.consumed;
+        pResp->comp_resp_pars.output_byte_counter = result.produced;
+    }
+
+build_resp:
+    adf_emul_resp_hdr_build(
+        &pReq->comn_hdr,
+        &pResp->comn_resp,
+        ICP_QAT_FW_COMN_RESP_STATUS_BUILD(
+            ICP_QAT_FW_COMN_STATUS_FLAG_OK,
+            ICP_QAT_FW_COMN_STATUS_FLAG_OK,
+            result.err_code ? ICP_QAT_FW_COMN_STATUS_FLAG_ERROR
+                            : ICP_QAT_FW_COMN_STATUS_FLAG_OK,
+            ICP_QAT_FW_COMN_STATUS_FLAG_OK,
+            result.end_of_last_block ? 1 : 0,
+            result.unsupported ? 1 : 0,
+            0));
+    pResp->comn_resp.comn_error.s1.cmp_err_code = (Cpa8U)result.err_code;
+    pResp->opaque_data = pReq->comn_mid.opaque_data;
+
+    free(src.data);
+    free(dst);
+}
@@ -0,0 +1,775 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+/*****************************************************************************
+ * @file adf_emul_fw_la.c
+ *
+ * @description
+ *      Lookaside (symmetric crypto) requests for the emulated device.
+ *      Supports AES-ECB/CBC/CTR ciphers, SHA-1/SHA-2 plain and HMAC (mode 1)
+ *      hashes, their chained combinations and two-pass AES-GCM. Anything
+ *      else is answered with the unsupported request status.
+ *
+ *****************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <endian.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include "cpa.h"
+#include "icp_qat_fw.h"
+#include "icp_qat_fw_la.h"
+#include "icp_qat_hw.h"
+#include "adf_emul.h"
+
+#define EMUL_LA_AES_BLOCK_SZ 16
+#define EMUL_LA_MAX_DIGEST_SZ 64
+
+/* Outcome of a request, mapped to the response status flags */
+typedef enum emul_la_status_e
+{
+    EMUL_LA_OK = 0,
+    EMUL_LA_ERROR,
+    EMUL_LA_UNSUPPORTED
+} emul_la_status_t;
+
+/* Cipher parameters decoded from the content descriptor and request */
+typedef struct emul_la_cipher_s
+{
+    const EVP_CIPHER *evp;
+    const Cpa8U *key;
+    Cpa32U mode;
+    CpaBoolean decrypt;
+    Cpa8U iv[EMUL_LA_AES_BLOCK_SZ];
+    Cpa8U *iv_ptr;
+    /**< Host copy of the IV, NULL when it was passed inline */
+    Cpa32U offset;
+    Cpa32U len;
+} emul_la_cipher_t;
+
+/* Hash parameters decoded from the content descriptor and request */
+typedef struct emul_la_hash_s
+{
+    Cpa32U algo;
+    Cpa32U mode;
+    Cpa32U counter;
+    const Cpa8U *state1;
+    const Cpa8U *state2;
+    Cpa32U inner_res_sz;
+    Cpa32U final_sz;
+    Cpa32U offset;
+    Cpa32U len;
+} emul_la_hash_t;
+
+static const icp_qat_fw_la_cipher_req_params_t *emul_la_cipher_params(
+    const icp_qat_fw_la_bulk_req_t *pReq)
+{
+    const Cpa8U *rqpars = (const Cpa8U *)&pReq->serv_specif_rqpars;
+
+    return (const icp_qat_fw_la_cipher_req_params_t *)(
+        rqpars + ICP_QAT_FW_CIPHER_REQUEST_PARAMETERS_OFFSET);
+}
+
+static const icp_qat_fw_la_auth_req_params_t *emul_la_auth_params(
+    const icp_qat_fw_la_bulk_req_t *pReq)
+{
+    const Cpa8U *rqpars = (const Cpa8U *)&pReq->serv_specif_rqpars;
+
+    return (const icp_qat_fw_la_auth_req_params_t *)(
+        rqpars + ICP_QAT_FW_HASH_REQUEST_PARAMETERS_OFFSET);
+}
+
+static const EVP_CIPHER *emul_la_evp_get(Cpa32U algo, Cpa32U mode)
+{
+    switch (mode)
+    {
+        case ICP_QAT_HW_CIPHER_ECB_MODE:
+            if (ICP_QAT_HW_CIPHER_ALGO_AES128 == algo)
+                return EVP_aes_128_ecb();
+            if (ICP_QAT_HW_CIPHER_ALGO_AES192 == algo)
+                return EVP_aes_192_ecb();
+            if (ICP_QAT_HW_CIPHER_ALGO_AES256 == algo)
+                return EVP_aes_256_ecb();
+            break;
+        case ICP_QAT_HW_CIPHER_CBC_MODE:
+            if (ICP_QAT_HW_CIPHER_ALGO_AES128 == algo)
+                return EVP_aes_128_cbc();
+            if (ICP_QAT_HW_CIPHER_ALGO_AES192 == algo)
+                return EVP_aes_192_cbc();
+            if (ICP_QAT_HW_CIPHER_ALGO_AES256 == algo)
+                return EVP_aes_256_cbc();
+            break;
+        case ICP_QAT_HW_CIPHER_CTR_MODE:
+            if (ICP_QAT_HW_CIPHER_ALGO_AES128 == algo)
+                return EVP_aes_128_ctr();
+            if (ICP_QAT_HW_CIPHER_ALGO_AES192 == algo)
+                return EVP_aes_192_ctr();
+            if (ICP_QAT_HW_CIPHER_ALGO_AES256 == algo)
+                return EVP_aes_256_ctr();
+            break;
+        default:
+            break;
+    }
+
+    return NULL;
+}
+
+static emul_la_status_t emul_la_cipher_init(
+    const icp_qat_fw_la_bulk_req_t *pReq,
+    const Cpa8U *cd,
+    emul_la_cipher_t *cipher)
+{
+    const icp_qat_fw_cipher_cd_ctrl_hdr_t *cd_ctrl =
+        (const icp_qat_fw_cipher_cd_ctrl_hdr_t *)&pReq->cd_ctrl;
+    const icp_qat_fw_la_cipher_req_params_t *params =
+        emul_la_cipher_params(pReq);
+    Cpa16U flags = pReq->comn_hdr.serv_specif_flags;
+    const Cpa8U *cfg = cd + (cd_ctrl->cipher_cfg_offset << 3);
+    Cpa32U val = ((const icp_qat_hw_cipher_config_t *)cfg)->val;
+    Cpa32U algo = QAT_FIELD_GET(val, QAT_CIPHER_ALGO_BITPOS,
+                                QAT_CIPHER_ALGO_MASK);
+
+    cipher->mode =
+        QAT_FIELD_GET(val, QAT_CIPHER_MODE_BITPOS, QAT_CIPHER_MODE_MASK);
+    cipher->decrypt =
+        (ICP_QAT_HW_CIPHER_DECRYPT ==
+         QAT_FIELD_GET(val, QAT_CIPHER_DIR_BITPOS, QAT_CIPHER_DIR_MASK))
+            ? CPA_TRUE
+            : CPA_FALSE;
+    cipher->evp = emul_la_evp_get(algo, cipher->mode);
+    if (!cipher->evp)
+        return EMUL_LA_UNSUPPORTED;
+
+    /* The key follows the legacy or the UCS flavour of the config word */
+    if (ICP_QAT_FW_LA_USE_UCS_SLICE_TYPE ==
+        ICP_QAT_FW_LA_SLICE_TYPE_GET(flags))
+        cipher->key = cfg + sizeof(icp_qat_hw_ucs_cipher_config_t);
+    else
+        cipher->key = cfg + sizeof(icp_qat_hw_cipher_config_t);
+
+    cipher->iv_ptr = NULL;
+    if (ICP_QAT_FW_CIPH_IV_16BYTE_DATA ==
+        ICP_QAT_FW_LA_CIPH_IV_FLD_FLAG_GET(flags))
+    {
+        memcpy(cipher->iv, params->u.cipher_IV_array, sizeof(cipher->iv));
+    }
+    else
+    {
+        cipher->iv_ptr = adf_emul_phys_to_virt(params->u.s.cipher_IV_ptr);
+        if (!cipher->iv_ptr)
+            return EMUL_LA_ERROR;
+        memcpy(cipher->iv, cipher->iv_ptr, sizeof(cipher->iv));
+    }
+
+    cipher->offset = params->cipher_offset;
+    cipher->len = params->cipher_length;
+
+    return EMUL_LA_OK;
+}
+
+static emul_la_status_t emul_la_hash_init(
+    const icp_qat_fw_la_bulk_req_t *pReq,
+    const Cpa8U *cd,
+    emul_la_hash_t *hash)
+{
+    const icp_qat_fw_auth_cd_ctrl_hdr_t *cd_ctrl =
+        (const icp_qat_fw_auth_cd_ctrl_hdr_t *)&pReq->cd_ctrl;
+    const icp_qat_fw_la_auth_req_params_t *params = emul_la_auth_params(pReq);
+    const icp_qat_hw_auth_setup_t *setup =
+        (const icp_qat_hw_auth_setup_t *)(cd +
+                                          (cd_ctrl->hash_cfg_offset << 3));
+    Cpa32U config = setup->auth_config.config;
+
+    hash->algo =
+        QAT_FIELD_GET(config, QAT_AUTH_ALGO_BITPOS, QAT_AUTH_ALGO_MASK);
+    hash->mode =
+        QAT_FIELD_GET(config, QAT_AUTH_MODE_BITPOS, QAT_AUTH_MODE_MASK);
+    hash->counter = be32toh(setup->auth_counter.counter);
+    hash->state1 = (const Cpa8U *)setup + sizeof(icp_qat_hw_auth_setup_t);
+    hash->state2 = hash->state1 + cd_ctrl->inner_state1_sz;
+    hash->inner_res_sz = cd_ctrl->inner_res_sz;
+    hash->final_sz = cd_ctrl->final_sz;
+    hash->offset = params->auth_off;
+    hash->len = params->auth_len;
+
+    if (ICP_QAT_FW_LA_PARTIAL_NONE !=
+        ICP_QAT_FW_LA_PARTIAL_GET(pReq->comn_hdr.serv_specif_flags))
+        return EMUL_LA_UNSUPPORTED;
+    if (hash->final_sz > EMUL_LA_MAX_DIGEST_SZ)
+        return EMUL_LA_UNSUPPORTED;
+
+    switch (hash->algo)
+    {
+        case ICP_QAT_HW_AUTH_ALGO_SHA1:
+        case ICP_QAT_HW_AUTH_ALGO_SHA224:
+        case ICP_QAT_HW_AUTH_ALGO_SHA256:
+        case ICP_QAT_HW_AUTH_ALGO_SHA384:
+        case ICP_QAT_HW_AUTH_ALGO_SHA512:
+            if (ICP_QAT_HW_AUTH_MODE0 != hash->mode &&
+                ICP_QAT_HW_AUTH_MODE1 != hash->mode)
+                return EMUL_LA_UNSUPPORTED;
+            break;
+        case ICP_QAT_HW_AUTH_ALGO_GALOIS_128:
+            break;
+        default:
+            return EMUL_LA_UNSUPPORTED;
+    }
+
+    return EMUL_LA_OK;
+}
+
+static void emul_la_be32_load(Cpa32U *dst, const Cpa8U *src, Cpa32U words)
+{
+    Cpa32U i, word;
+
+    for (i = 0; i < words; i++)
+    {
+        memcpy(&word, src + i * sizeof(word), sizeof(word));
+        dst[i] = be32toh(word);
+    }
+}
+
+static void emul_la_be64_load(Cpa64U *dst, const Cpa8U *src, Cpa32U words)
+{
+    Cpa32U i;
+    Cpa64U word;
+
+    for (i = 0; i < words; i++)
+    {
+        memcpy(&word, src + i * sizeof(word), sizeof(word));
+        dst[i] = be64toh(word);
+    }
+}
+
+/*
+ * Resume a SHA computation from an intermediate state, the way the auth
+ * slice does: the state words are big-endian and the counter holds the
+ * number of bytes already absorbed into them. Returns the digest length.
+ */
+static Cpa32U emul_la_sha_resume(Cpa32U algo,
+                                 const Cpa8U *state,
+                                 Cpa32U counter,
+                                 const Cpa8U *data,
+                                 Cpa32U len,
+                                 Cpa8U *digest)
+{
+    Cpa64U bits = (Cpa64U)counter << 3;
+
+    switch (algo)
+    {
+        case ICP_QAT_HW_AUTH_ALGO_SHA1:
+        {
+            SHA_CTX ctx;
+            Cpa32U h[5];
+
+            SHA1_Init(&ctx);
+            emul_la_be32_load(h, state, 5);
+            ctx.h0 = h[0];
+            ctx.h1 = h[1];
+            ctx.h2 = h[2];
+            ctx.h3 = h[3];
+            ctx.h4 = h[4];
+            ctx.Nl = (Cpa32U)bits;
+            ctx.Nh = (Cpa32U)(bits >> 32);
+            SHA1_Update(&ctx, data, len);
+            SHA1_Final(digest, &ctx);
+            return SHA_DIGEST_LENGTH;
+        }
+        case ICP_QAT_HW_AUTH_ALGO_SHA224:
+        case ICP_QAT_HW_AUTH_ALGO_SHA256:
+        {
+            SHA256_CTX ctx;
+
+            if (ICP_QAT_HW_AUTH_ALGO_SHA224 == algo)
+                SHA224_Init(&ctx);
+            else
+                SHA256_Init(&ctx);
+            emul_la_be32_load(ctx.h, state, 8);
+            ctx.Nl = (Cpa32U)bits;
+            ctx.Nh = (Cpa32U)(bits >> 32);
+            SHA256_Update(&ctx, data, len);
+            SHA256_Final(digest, &ctx);
+            return ctx.md_len;
+        }
+        case ICP_QAT_HW_AUTH_ALGO_SHA384:
+        case ICP_QAT_HW_AUTH_ALGO_SHA512:
+        {
+            SHA512_CTX ctx;
+            Cpa64U h[8];
+            Cpa32U i;
+
+            if (ICP_QAT_HW_AUTH_ALGO_SHA384 == algo)
+                SHA384_Init(&ctx);
+            else
+                SHA512_Init(&ctx);
+            emul_la_be64_load(h, state, 8);
+            for (i = 0; i < 8; i++)
+                ctx.h[i] = h[i];
+            ctx.Nl = bits;
+            ctx.Nh = 0;
+            SHA512_Update(&ctx, data, len);
+            SHA512_Final(digest, &ctx);
+            return ctx.md_len;
+        }
+        default:
+            return 0;
+    }
+}
+
+static void emul_la_sha_digest(const emul_la_hash_t *hash,
+                               const Cpa8U *data,
+                               Cpa8U *digest)
+{
+    Cpa8U inner[EMUL_LA_MAX_DIGEST_SZ];
+    Cpa32U inner_len;
+
+    inner_len = emul_la_sha_resume(hash->algo,
+                                   hash->state1,
+                                   hash->counter,
+                                   data + hash->offset,
+                                   hash->len,
+                                   inner);
+
+    if (ICP_QAT_HW_AUTH_MODE1 == hash->mode)
+    {
+        /* HMAC: the outer hash resumes from the precomputed opad state */
+        if (hash->inner_res_sz && hash->inner_res_sz < inner_len)
+            inner_len = hash->inner_res_sz;
+        emul_la_sha_resume(hash->algo,
+                           hash->state2,
+                           hash->counter,
+                           inner,
+                           inner_len,
+                           digest);
+    }
+    else
+    {
+        memcpy(digest, inner, inner_len);
+    }
+}
+
+static emul_la_status_t emul_la_cipher_do(emul_la_cipher_t *cipher,
+                                          Cpa8U *data)
+{
+    EVP_CIPHER_CTX *ctx;
+    Cpa8U *region = data + cipher->offset;
+    Cpa8U last[EMUL_LA_AES_BLOCK_SZ];
+    Cpa32U blocks, carry, i;
+    int out_len = 0;
+    int ok;
+
+    if (!cipher->len)
+        return EMUL_LA_OK;
+    if (ICP_QAT_HW_CIPHER_CTR_MODE != cipher->mode &&
+        (cipher->len % EMUL_LA_AES_BLOCK_SZ))
+        return EMUL_LA_ERROR;
+
+    /* For CBC decrypt the next IV is the last ciphertext block */
+    if (cipher->len >= EMUL_LA_AES_BLOCK_SZ)
+        memcpy(last,
+               region + cipher->len - EMUL_LA_AES_BLOCK_SZ,
+               sizeof(last));
+
+    ctx = EVP_CIPHER_CTX_new();
+    if (!ctx)
+        return EMUL_LA_ERROR;
+    ok = EVP_CipherInit_ex(ctx,
+                           cipher->evp,
+                           NULL,
+                           cipher->key,
+                           cipher->iv,
+                           cipher->decrypt ? 0 : 1);
+    if (ok)
+        ok = EVP_CIPHER_CTX_set_padding(ctx, 0);
+    if (ok)
+        ok = EVP_CipherUpdate(ctx, region, &out_len, region, cipher->len);
+    EVP_CIPHER_CTX_free(ctx);
+    if (!ok)
+        return EMUL_LA_ERROR;
+
+    /* Chaining state for the next request of a partial packet sequence */
+    if (ICP_QAT_HW_CIPHER_CBC_MODE == cipher->mode)
+    {
+        if (cipher->decrypt)
+            memcpy(cipher->iv, last, sizeof(last));
+        else
+            memcpy(cipher->iv,
+                   region + cipher->len - EMUL_LA_AES_BLOCK_SZ,
+                   sizeof(cipher->iv));
+    }
+    else if (ICP_QAT_HW_CIPHER_CTR_MODE == cipher->mode)
+    {
+        blocks = (cipher->len + EMUL_LA_AES_BLOCK_SZ - 1) /
+                 EMUL_LA_AES_BLOCK_SZ;
+        carry = 0;
+        for (i = EMUL_LA_AES_BLOCK_SZ; i-- > 0;)
+        {
+            carry += cipher->iv[i] + (blocks & 0xff);
+            cipher->iv[i] = (Cpa8U)carry;
+            carry >>= 8;
+            blocks >>= 8;
+        }
+    }
+
+    return EMUL_LA_OK;
+}
+
+/* Multiply x by h in GF(2^128) using the GCM bit ordering, result in x */
+static void emul_la_gf128_mul(Cpa8U *x, const Cpa8U *h)
+{
+    Cpa8U z[EMUL_LA_AES_BLOCK_SZ] = {0};
+    Cpa8U v[EMUL_LA_AES_BLOCK_SZ];
+    Cpa32U i, j;
+    Cpa8U lsb;
+
+    memcpy(v, h, sizeof(v));
+    for (i = 0; i < 128; i++)
+    {
+        if (x[i >> 3] & (0x80 >> (i & 7)))
+        {
+            for (j = 0; j < EMUL_LA_AES_BLOCK_SZ; j++)
+                z[j] ^= v[j];
+        }
+        lsb = v[EMUL_LA_AES_BLOCK_SZ - 1] & 1;
+        for (j = EMUL_LA_AES_BLOCK_SZ - 1; j > 0; j--)
+            v[j] = (v[j] >> 1) | (v[j - 1] << 7);
+        v[0] >>= 1;
+        if (lsb)
+            v[0] ^= 0xe1;
+    }
+    memcpy(x, z, sizeof(z));
+}
+
+static void emul_la_ghash_update(Cpa8U *acc,
+                                 const Cpa8U *h,
+                                 const Cpa8U *data,
+                                 Cpa32U len)
+{
+    Cpa32U chunk, i;
+
+    while (len)
+    {
+        chunk = (len < EMUL_LA_AES_BLOCK_SZ) ? len : EMUL_LA_AES_BLOCK_SZ;
+        for (i = 0; i < chunk; i++)
+            acc[i] ^= data[i];
+        emul_la_gf128_mul(acc, h);
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+static void emul_la_inc32(Cpa8U *ctr)
+{
+    Cpa32U word;
+
+    memcpy(&word, ctr + 12, sizeof(word));
+    word = htobe32(be32toh(word) + 1);
+    memcpy(ctr + 12, &word, sizeof(word));
+}
+
+/*
+ * Two-pass AES-GCM as split by LAC into a CTR mode cipher and a Galois
+ * hash. State2 holds H followed by len(A), the AAD comes from the auth
+ * request parameters and the tag is produced or checked over the cipher
+ * region. The counter mode cipher always runs in the encrypt direction,
+ * so decryption is told apart by the hash coming first.
+ */
+static emul_la_status_t emul_la_gcm_do(const icp_qat_fw_la_bulk_req_t *pReq,
+                                       const emul_la_cipher_t *cipher,
+                                       const emul_la_hash_t *hash,
+                                       Cpa8U *data,
+                                       Cpa8U *tag)
+{
+    const icp_qat_fw_la_auth_req_params_t *params = emul_la_auth_params(pReq);
+    Cpa8U j0[EMUL_LA_AES_BLOCK_SZ];
+    Cpa8U ctr[EMUL_LA_AES_BLOCK_SZ];
+    Cpa8U ks[EMUL_LA_AES_BLOCK_SZ];
+    Cpa8U acc[EMUL_LA_AES_BLOCK_SZ] = {0};
+    Cpa8U lens[EMUL_LA_AES_BLOCK_SZ];
+    const Cpa8U *h = hash->state2;
+    const Cpa8U *aad = NULL;
+    Cpa8U *region = data + cipher->offset;
+    EVP_CIPHER_CTX *ctx;
+    const EVP_CIPHER *ecb;
+    Cpa32U aad_len, word, i, done, chunk;
+    Cpa64U bits;
+    CpaBoolean decrypt = (ICP_QAT_FW_LA_CMD_HASH_CIPHER ==
+                          pReq->comn_hdr.service_cmd_id)
+                             ? CPA_TRUE
+                             : CPA_FALSE;
+    int out_len = 0;
+    int ok;
+
+    if (ICP_QAT_HW_CIPHER_CTR_MODE != cipher->mode)
+        return EMUL_LA_UNSUPPORTED;
+
+    memcpy(&word, hash->state2 + ICP_QAT_HW_GALOIS_H_SZ, sizeof(word));
+    aad_len = be32toh(word);
+    if (aad_len)
+    {
+        aad = adf_emul_phys_to_virt(params->u1.aad_adr);
+        if (!aad)
+            return EMUL_LA_ERROR;
+    }
+
+    if (ICP_QAT_FW_LA_GCM_IV_LEN_12_OCTETS ==
+        ICP_QAT_FW_LA_GCM_IV_LEN_FLAG_GET(pReq->comn_hdr.serv_specif_flags))
+    {
+        memcpy(j0, cipher->iv, 12);
+        word = htobe32(1);
+        memcpy(j0 + 12, &word, sizeof(word));
+    }
+    else
+    {
+        memcpy(j0, cipher->iv, sizeof(j0));
+    }
+
+    if (cipher->evp == EVP_aes_128_ctr())
+        ecb = EVP_aes_128_ecb();
+    else if (cipher->evp == EVP_aes_192_ctr())
+        ecb = EVP_aes_192_ecb();
+    else
+        ecb = EVP_aes_256_ecb();
+
+    ctx = EVP_CIPHER_CTX_new();
+    if (!ctx)
+        return EMUL_LA_ERROR;
+    ok = EVP_EncryptInit_ex(ctx, ecb, NULL, cipher->key, NULL);
+    if (ok)
+        ok = EVP_CIPHER_CTX_set_padding(ctx, 0);
+
+    emul_la_ghash_update(acc, h, aad, aad_len);
+    if (decrypt)
+        emul_la_ghash_update(acc, h, region, cipher->len);
+
+    memcpy(ctr, j0, sizeof(ctr));
+    for (done = 0; ok && done < cipher->len; done += chunk)
+    {
+        emul_la_inc32(ctr);
+        ok = EVP_EncryptUpdate(ctx, ks, &out_len, ctr, sizeof(ctr));
+        chunk = cipher->len - done;
+        if (chunk > EMUL_LA_AES_BLOCK_SZ)
+            chunk = EMUL_LA_AES_BLOCK_SZ;
+        for (i = 0; i < chunk; i++)
+            region[done + i] ^= ks[i];
+    }
+
+    if (!decrypt)
+        emul_la_ghash_update(acc, h, region, cipher->len);
+
+    bits = htobe64((Cpa64U)aad_len << 3);
+    memcpy(lens, &bits, sizeof(bits));
+    bits = htobe64((Cpa64U)cipher->len << 3);
+    memcpy(lens + sizeof(bits), &bits, sizeof(bits));
+    emul_la_ghash_update(acc, h, lens, sizeof(lens));
+
+    if (ok)
+        ok = EVP_EncryptUpdate(ctx, ks, &out_len, j0, sizeof(j0));
+    EVP_CIPHER_CTX_free(ctx);
+    if (!ok)
+        return EMUL_LA_ERROR;
+
+    for (i = 0; i < EMUL_LA_AES_BLOCK_SZ; i++)
+        tag[i] = acc[i] ^ ks[i];
+
+    return EMUL_LA_OK;
+}
+
+/* Either write the computed digest or compare it against the expected one */
+static emul_la_status_t emul_la_digest_handle(
+    const icp_qat_fw_la_bulk_req_t *pReq,
+    const emul_la_hash_t *hash,
+    Cpa8U *result,
+    const Cpa8U *digest)
+{
+    if (!result)
+        return EMUL_LA_ERROR;
+
+    if (ICP_QAT_FW_LA_CMP_AUTH_GET(pReq->comn_hdr.serv_specif_flags))
+        return memcmp(result, digest, hash->final_sz) ? EMUL_LA_ERROR
+                                                      : EMUL_LA_OK;
+
+    memcpy(result, digest, hash->final_sz);
+    return EMUL_LA_OK;
+}
+
+static emul_la_status_t emul_la_bulk_do(const icp_qat_fw_la_bulk_req_t *pReq)
+{
+    Cpa16U comn_flags = pReq->comn_hdr.comn_req_flags;
+    Cpa16U flags = pReq->comn_hdr.serv_specif_flags;
+    Cpa8U cmd = pReq->comn_hdr.service_cmd_id;
+    CpaBoolean sgl = (QAT_COMN_PTR_TYPE_SGL ==
+                      ICP_QAT_FW_COMN_PTR_TYPE_GET(comn_flags))
+                         ? CPA_TRUE
+                         : CPA_FALSE;
+    CpaBoolean do_cipher = (ICP_QAT_FW_LA_CMD_AUTH != cmd);
+    CpaBoolean do_hash = (ICP_QAT_FW_LA_CMD_CIPHER != cmd);
+    emul_la_cipher_t cipher = {0};
+    emul_la_hash_t hash = {0};
+    adf_emul_buf_t buf = {0};
+    Cpa8U digest[EMUL_LA_MAX_DIGEST_SZ];
+    emul_la_status_t status = EMUL_LA_OK;
+    CpaBoolean in_buffer;
+    const Cpa8U *cd;
+
+    if (cmd > ICP_QAT_FW_LA_CMD_HASH_CIPHER)
+        return EMUL_LA_UNSUPPORTED;
+    if (QAT_COMN_CD_FLD_TYPE_64BIT_ADR !=
+            ICP_QAT_FW_COMN_CD_FLD_TYPE_GET(comn_flags) ||
+        ICP_QAT_FW_CIPH_AUTH_CFG_OFFSET_IN_SHRAM_CP ==
+            ICP_QAT_FW_LA_CIPH_AUTH_CFG_OFFSET_FLAG_GET(flags))
+        return EMUL_LA_UNSUPPORTED;
+
+    cd = adf_emul_phys_to_virt(pReq->cd_pars.s.content_desc_addr);
+    if (!cd)
+        return EMUL_LA_ERROR;
+
+    if (do_cipher)
+        status = emul_la_cipher_init(pReq, cd, &cipher);
+    if (EMUL_LA_OK == status && do_hash)
+        status = emul_la_hash_init(pReq, cd, &hash);
+    if (EMUL_LA_OK != status)
+        return status;
+    if (ICP_QAT_HW_AUTH_ALGO_GALOIS_128 == hash.algo &&
+        (!do_cipher ||
+         ICP_QAT_FW_LA_GCM_PROTO != ICP_QAT_FW_LA_PROTO_GET(flags)))
+        return EMUL_LA_UNSUPPORTED;
+
+    if (CPA_STATUS_SUCCESS != adf_emul_gather(pReq->comn_mid.src_data_addr,
+                                              sgl,
+                                              pReq->comn_mid.src_length,
+                                              &buf))
+        return EMUL_LA_ERROR;
+
+    if ((do_cipher &&
+         (Cpa64U)cipher.offset + cipher.len > buf.len) ||
+        (do_hash && (Cpa64U)hash.offset + hash.len > buf.len))
+    {
+        free(buf.data);
+        return EMUL_LA_ERROR;
+    }
+
+    /*
+     * A digest in the buffer follows the authenticated region and goes out
+     * with the data; for hash-then-cipher it is produced before the cipher
+     * runs so that it gets encrypted too. One at a separate address may
+     * itself sit inside the destination buffer, so it is only handled once
+     * the data is written.
+     */
+    in_buffer = ICP_QAT_FW_LA_DIGEST_IN_BUFFER_GET(flags) ? CPA_TRUE
+                                                          : CPA_FALSE;
+    if (do_hash && in_buffer &&
+        (Cpa64U)hash.offset + hash.len + hash.final_sz > buf.len)
+    {
+        free(buf.data);
+        return EMUL_LA_ERROR;
+    }
+
+    if (ICP_QAT_HW_AUTH_ALGO_GALOIS_128 == hash.algo)
+    {
+        status = emul_la_gcm_do(pReq, &cipher, &hash, buf.data, digest);
+        if (EMUL_LA_OK == status && in_buffer)
+            status = emul_la_digest_handle(
+                pReq, &hash, buf.data + hash.offset + hash.len, digest);
+    }
+    else
+    {
+        if (do_hash && ICP_QAT_FW_LA_CMD_HASH_CIPHER == cmd)
+        {
+            emul_la_sha_digest(&hash, buf.data, digest);
+            if (in_buffer)
+                status = emul_la_digest_handle(
+                    pReq, &hash, buf.data + hash.offset + hash.len, digest);
+        }
+        if (EMUL_LA_OK == status && do_cipher)
+            status = emul_la_cipher_do(&cipher, buf.data);
+        if (EMUL_LA_OK == status && do_hash &&
+            ICP_QAT_FW_LA_CMD_HASH_CIPHER != cmd)
+        {
+            emul_la_sha_digest(&hash, buf.data, digest);
+            if (in_buffer)
+                status = emul_la_digest_handle(
+                    pReq, &hash, buf.data + hash.offset + hash.len, digest);
+        }
+    }
+
+    if (EMUL_LA_OK == status && do_cipher && cipher.iv_ptr &&
+        (ICP_QAT_FW_LA_UPDATE_STATE_GET(flags) ||
+         ICP_QAT_FW_LA_PARTIAL_NONE != ICP_QAT_FW_LA_PARTIAL_GET(flags)))
+        memcpy(cipher.iv_ptr, cipher.iv, sizeof(cipher.iv));
+
+    /* A failed digest compare still delivers the processed data */
+    if ((do_cipher || in_buffer) &&
+        CPA_STATUS_SUCCESS != adf_emul_scatter(pReq->comn_mid.dest_data_addr,
+                                               sgl,
+                                               pReq->comn_mid.dst_length,
+                                               buf.data,
+                                               buf.len))
+        status = EMUL_LA_ERROR;
+
+    if (EMUL_LA_OK == status && do_hash && !in_buffer)
+        status = emul_la_digest_handle(
+            pReq,
+            &hash,
+            adf_emul_phys_to_virt(emul_la_auth_params(pReq)->auth_res_addr),
+            digest);
+
+    free(buf.data);
+    return status;
+}
+
+void adf_emul_la_process(const Cpa8U *req, Cpa8U *resp)
+{
+    const icp_qat_fw_la_bulk_req_t *pReq =
+        (const icp_qat_fw_la_bulk_req_t *)req;
+    icp_qat_fw_la_resp_t *pResp = (icp_qat_fw_la_resp_t *)resp;
+    emul_la_status_t status = emul_la_bulk_do(pReq);
+    Cpa8U crypto = (EMUL_LA_OK == status) ? ICP_QAT_FW_COMN_STATUS_FLAG_OK
+                                          : ICP_QAT_FW_COMN_STATUS_FLAG_ERROR;
+
+    adf_emul_resp_hdr_build(
+        &pReq->comn_hdr,
+        &pResp->comn_resp,
+        ICP_QAT_FW_COMN_RESP_STATUS_BUILD(
+            crypto,
+            ICP_QAT_FW_COMN_STATUS_FLAG_OK,
+            ICP_QAT_FW_COMN_STATUS_FLAG_OK,
+            ICP_QAT_FW_COMN_STATUS_FLAG_OK,
+            0,
+            (EMUL_LA_UNSUPPORTED == status) ? 1 : 0,
+            0));
+    pResp->opaque_data = pReq->comn_mid.opaque_data;
+}
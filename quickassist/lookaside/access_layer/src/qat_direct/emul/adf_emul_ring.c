@@ -0,0 +1,165 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+#include <pthread.h>
+
+#include "cpa.h"
+#include "adf_platform_common.h"
+#include "adf_platform_acceldev_common.h"
+#include "adf_dev_ring_ctl.h"
+#include "adf_io_ring.h"
+#include "icp_platform.h"
+#include "adf_emul.h"
+
+static inline void update_ring(Cpa32U *csr_base_addr,
+                               Cpa32U bank_offset,
+                               Cpa32U bank_ring_mask,
+                               Cpa32U arb_mask)
+{
+    Cpa32U arben, arben_tx, arben_rx;
+    Cpa32U shift;
+
+    ICP_CHECK_FOR_NULL_PARAM_VOID(csr_base_addr);
+
+    shift = __builtin_popcount(arb_mask);
+    arben_tx = bank_ring_mask & arb_mask;
+    arben_rx = (bank_ring_mask >> shift) & arb_mask;
+    arben = arben_tx & arben_rx;
+
+    ICP_ADF_CSR_WR(
+        csr_base_addr, bank_offset + ICP_RING_CSR_RING_SRV_ARB_EN, arben);
+}
+
+/*
+ * Look up the device side state of a ring. The firmware stand-in walks
+ * the same table, so callers must hold the device lock while they update
+ * the returned entry.
+ */
+static adf_emul_ring_t *emul_ring_get(adf_dev_ring_handle_t *ring,
+                                      adf_emul_dev_t **emul_dev)
+{
+    *emul_dev = ring->accel_dev->ioPriv;
+    if (!*emul_dev || ring->bank_num >= ADF_EMUL_NUM_BANKS ||
+        ring->ring_num >= ADF_EMUL_RINGS_PER_BANK)
+        return NULL;
+
+    return &(*emul_dev)->rings[ring->bank_num][ring->ring_num];
+}
+
+CpaStatus adf_io_reserve_ring(Cpa16U accel_id, Cpa16U bank_nr, Cpa16U ring_nr)
+{
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus adf_io_release_ring(Cpa16U accel_id, Cpa16U bank_nr, Cpa16U ring_nr)
+{
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus adf_io_enable_ring(adf_dev_ring_handle_t *ring)
+{
+    Cpa32U bank_ring_mask;
+    adf_emul_dev_t *emul_dev;
+    adf_emul_ring_t *emul_ring;
+
+    ICP_CHECK_FOR_NULL_PARAM(ring);
+
+    if (!ring->csr_addr || !ring->bank_data || !ring->accel_dev)
+        return CPA_STATUS_FAIL;
+
+    emul_ring = emul_ring_get(ring, &emul_dev);
+    if (!emul_ring)
+        return CPA_STATUS_FAIL;
+
+    /* A freshly configured ring starts empty, as it would after the
+     * hardware latches a new ring base */
+    pthread_mutex_lock(&emul_dev->lock);
+    ICP_ADF_CSR_WR(ring->csr_addr,
+                   ring->bank_offset + ICP_RING_CSR_RING_HEAD_OFFSET +
+                       (ring->ring_num << 2),
+                   0);
+    ICP_ADF_CSR_WR(ring->csr_addr,
+                   ring->bank_offset + ICP_RING_CSR_RING_TAIL_OFFSET +
+                       (ring->ring_num << 2),
+                   0);
+    emul_ring->virt = ring->ring_virt_addr;
+    emul_ring->size = ring->ring_size;
+    emul_ring->msg_size = ring->message_size;
+    emul_ring->offset = 0;
+    pthread_mutex_unlock(&emul_dev->lock);
+
+    bank_ring_mask = ring->bank_data->ring_mask;
+    bank_ring_mask |= 1 << ring->ring_num;
+    update_ring(ring->csr_addr,
+                ring->bank_offset,
+                bank_ring_mask,
+                ring->accel_dev->arb_mask);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus adf_io_disable_ring(adf_dev_ring_handle_t *ring)
+{
+    Cpa32U bank_ring_mask;
+    adf_emul_dev_t *emul_dev;
+    adf_emul_ring_t *emul_ring;
+
+    ICP_CHECK_FOR_NULL_PARAM(ring);
+
+    if (!ring->csr_addr || !ring->bank_data || !ring->accel_dev)
+        return CPA_STATUS_FAIL;
+
+    bank_ring_mask = ring->bank_data->ring_mask;
+    bank_ring_mask &= ~(1 << ring->ring_num);
+    update_ring(ring->csr_addr,
+                ring->bank_offset,
+                bank_ring_mask,
+                ring->accel_dev->arb_mask);
+
+    emul_ring = emul_ring_get(ring, &emul_dev);
+    if (!emul_ring)
+        return CPA_STATUS_FAIL;
+
+    /* Once this returns the firmware stand-in no longer touches the ring
+     * memory, so the caller is free to release it */
+    pthread_mutex_lock(&emul_dev->lock);
+    emul_ring->virt = NULL;
+    emul_ring->size = 0;
+    emul_ring->msg_size = 0;
+    emul_ring->offset = 0;
+    pthread_mutex_unlock(&emul_dev->lock);
+
+    return CPA_STATUS_SUCCESS;
+}
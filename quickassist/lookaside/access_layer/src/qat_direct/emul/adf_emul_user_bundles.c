@@ -0,0 +1,234 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "cpa.h"
+#include "icp_platform.h"
+#include "adf_user.h"
+#include "adf_kernel_types.h"
+#include "adf_io_bundles.h"
+#include "adf_io_cfg.h"
+#include "qat_log.h"
+#include "adf_emul.h"
+
+void adf_io_free_bundle(struct adf_io_user_bundle *bundle)
+{
+    if (bundle)
+        ICP_FREE(bundle);
+}
+
+struct adf_io_user_bundle *adf_io_get_bundle_from_accelid(int accelid,
+                                                          int bundle_nr)
+{
+    struct adf_io_user_bundle *bundle = NULL;
+
+    bundle = ICP_ZALLOC_GEN(sizeof(*bundle));
+    if (!bundle)
+    {
+        ADF_ERROR("failed to allocate bundle structure\n");
+        return NULL;
+    }
+    bundle->number = bundle_nr;
+    bundle->fd = -1;
+
+    return bundle;
+}
+
+int adf_io_populate_bundle(icp_accel_dev_t *accel_dev,
+                           struct adf_io_user_bundle *bundle)
+{
+    adf_emul_dev_t *emul_dev;
+
+    ICP_CHECK_FOR_NULL_PARAM_RET_CODE(accel_dev, -EINVAL);
+    ICP_CHECK_FOR_NULL_PARAM_RET_CODE(bundle, -EINVAL);
+
+    emul_dev = accel_dev->ioPriv;
+    if (!emul_dev || !emul_dev->csr)
+        return -EINVAL;
+
+    if (bundle->number < 0 || bundle->number >= ADF_EMUL_NUM_BANKS)
+        return -EINVAL;
+
+    bundle->ptr = emul_dev->csr + (ADF_EMUL_BANK_SIZE * bundle->number);
+
+    return 0;
+}
+
+static void adf_emul_populate_accel_dev(int dev_id, icp_accel_dev_t *accel_dev)
+{
+    memset(accel_dev, '\0', sizeof(*accel_dev));
+
+    accel_dev->accelId = dev_id;
+    accel_dev->maxNumBanks = ADF_EMUL_NUM_BANKS;
+    accel_dev->accelCapabilitiesMask = ADF_EMUL_CAPABILITIES;
+    accel_dev->cipherCapabilitiesMask = 0U;
+    accel_dev->hashCapabilitiesMask = 0U;
+    accel_dev->asymCapabilitiesMask = 0U;
+    accel_dev->dcExtendedFeatures = ADF_EMUL_DC_EXTENDED_FEATURES;
+    accel_dev->numa_node = 0;
+    accel_dev->deviceType = DEVICE_4XXXVF;
+    accel_dev->arb_mask = ADF_EMUL_ARB_MASK;
+    accel_dev->maxNumRingsPerBank = ADF_EMUL_RINGS_PER_BANK;
+    accel_dev->pciDevId = ADF_EMUL_PCI_DEVICE_ID;
+    accel_dev->isVf = CPA_TRUE;
+    accel_dev->sku = 0;
+    accel_dev->deviceMemAvail = 0;
+    ICP_STRLCPY(accel_dev->deviceName,
+                ADF_EMUL_DEVICE_NAME,
+                sizeof(accel_dev->deviceName));
+}
+
+int adf_io_accel_dev_exist(int dev_id)
+{
+    if (adf_io_cfgGetBusAddress(dev_id) == ADF_IO_OPERATION_FAIL_CPA16U)
+        return 0;
+    else
+        return 1;
+}
+
+int adf_io_create_accel(icp_accel_dev_t **accel_dev, int dev_id)
+{
+    adf_emul_dev_t *emul_dev;
+
+    ICP_CHECK_FOR_NULL_PARAM(accel_dev);
+
+    if (dev_id < 0 || dev_id >= ADF_EMUL_NUM_DEVICES)
+        return -EINVAL;
+
+    *accel_dev = ICP_MALLOC_GEN(sizeof(**accel_dev));
+    if (!*accel_dev)
+        return -ENOMEM;
+
+    emul_dev = ICP_ZALLOC_GEN(sizeof(*emul_dev));
+    if (!emul_dev)
+        goto accel_fail;
+
+    emul_dev->csr = ICP_ZALLOC_GEN(ADF_EMUL_NUM_BANKS * ADF_EMUL_BANK_SIZE);
+    if (!emul_dev->csr)
+        goto accel_fail;
+
+    emul_dev->accel_id = dev_id;
+    if (pthread_mutex_init(&emul_dev->lock, NULL))
+        goto accel_fail;
+
+    if (adf_emul_fw_start(emul_dev))
+    {
+        ADF_ERROR("Failed to start emulated firmware for device %d\n", dev_id);
+        pthread_mutex_destroy(&emul_dev->lock);
+        goto accel_fail;
+    }
+
+    adf_emul_populate_accel_dev(dev_id, *accel_dev);
+    (*accel_dev)->ioPriv = emul_dev;
+
+    return 0;
+
+accel_fail:
+    if (emul_dev)
+    {
+        ICP_FREE(emul_dev->csr);
+        ICP_FREE(emul_dev);
+    }
+    ICP_FREE(*accel_dev);
+    *accel_dev = NULL;
+    return -ENOMEM;
+}
+
+int adf_io_reinit_accel(icp_accel_dev_t **accel_dev, int dev_id)
+{
+    void *pSalHandle = NULL;
+    void *pQatStats = NULL;
+    void *banks = NULL;
+    adf_emul_dev_t *emul_dev = NULL;
+
+    if (!accel_dev)
+        return -ENOMEM;
+
+    if (!*accel_dev)
+        return -ENOMEM;
+
+    if (!(*accel_dev)->ioPriv)
+        return -ENOMEM;
+
+    if (dev_id < 0 || dev_id >= ADF_EMUL_NUM_DEVICES)
+        return -EINVAL;
+
+    pSalHandle = (*accel_dev)->pSalHandle;
+    pQatStats = (*accel_dev)->pQatStats;
+    banks = (*accel_dev)->banks;
+    emul_dev = (adf_emul_dev_t *)(*accel_dev)->ioPriv;
+    /* The restarted device serves its rings again */
+    emul_dev->hung = 0;
+
+    adf_emul_populate_accel_dev(dev_id, *accel_dev);
+
+    (*accel_dev)->pSalHandle = pSalHandle;
+    (*accel_dev)->pQatStats = pQatStats;
+    (*accel_dev)->banks = banks;
+    (*accel_dev)->ioPriv = emul_dev;
+
+    return 0;
+}
+
+void adf_io_destroy_accel(icp_accel_dev_t *accel_dev)
+{
+    adf_emul_dev_t *emul_dev;
+
+    ICP_CHECK_FOR_NULL_PARAM_VOID(accel_dev);
+
+    if (!accel_dev->ioPriv)
+        goto free_accel;
+
+    emul_dev = accel_dev->ioPriv;
+
+    adf_emul_fw_stop(emul_dev);
+    pthread_mutex_destroy(&emul_dev->lock);
+
+    ICP_FREE(emul_dev->csr);
+    ICP_FREE(emul_dev);
+
+free_accel:
+    ICP_FREE(accel_dev);
+}
+
+/* The emulated device never restarts, so there is nothing to notify */
+void adf_io_vf2pf_notify_restarting_complete(icp_accel_dev_t *accel_dev)
+{
+}
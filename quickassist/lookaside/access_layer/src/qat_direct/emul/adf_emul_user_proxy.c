@@ -0,0 +1,173 @@
+/***************************************************************************
+ *
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ *
+ ***************************************************************************/
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include "cpa.h"
+#include "adf_io_user_proxy.h"
+#include "icp_platform.h"
+#include "adf_kernel_types.h"
+#include "icp_accel_devices.h"
+#include "icp_adf_accel_mgr.h"
+#include "adf_emul.h"
+
+#define EMUL_MAX_STRLEN 256
+
+static char currentProcess[EMUL_MAX_STRLEN];
+
+#ifdef ICP_HB_FAIL_SIM
+/* Events a failed device raises, in order, as the kernel driver would
+ * deliver them around a reset */
+static const enum adf_event emul_hb_fail_events[] = { ADF_EVENT_ERROR,
+                                                      ADF_EVENT_RESTARTING,
+                                                      ADF_EVENT_RESTARTED };
+#define EMUL_HB_FAIL_NUM_EVENTS                                                \
+    (sizeof(emul_hb_fail_events) / sizeof(emul_hb_fail_events[0]))
+
+/* Per device index of the next event to raise, 0 when none is pending */
+static Cpa32U emul_hb_fail_next[ADF_EMUL_NUM_DEVICES];
+#endif
+
+/*
+ * The emulated device has a single section per process, so the section
+ * qatmgr would normally hand out is derived directly from the requested
+ * process name.
+ */
+CpaStatus adf_io_userProcessToStart(char const *const name_in,
+                                    size_t name_tml_len,
+                                    char *name,
+                                    size_t name_len)
+{
+    int ret;
+
+    ICP_CHECK_FOR_NULL_PARAM(name_in);
+    ICP_CHECK_FOR_NULL_PARAM(name);
+
+    ret = snprintf(name, name_len, "%s_INT_0", name_in);
+    if (ret < 0 || (size_t)ret >= name_len)
+        return CPA_STATUS_FAIL;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus adf_io_userProxyInit(char const *const name)
+{
+    ICP_CHECK_FOR_NULL_PARAM(name);
+
+    if (strnlen(name, EMUL_MAX_STRLEN) >= EMUL_MAX_STRLEN)
+    {
+        return CPA_STATUS_FAIL;
+    }
+
+    ICP_STRLCPY(currentProcess, name, EMUL_MAX_STRLEN);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+void adf_io_userProcessStop(void)
+{
+    memset(currentProcess, 0, EMUL_MAX_STRLEN);
+}
+
+void adf_io_userProxyShutdown(void)
+{
+}
+
+CpaStatus adf_io_resetUserProxy(void)
+{
+    return CPA_STATUS_SUCCESS;
+}
+
+#ifdef ICP_HB_FAIL_SIM
+/*
+ * Simulate a heartbeat failure: the device stops serving its rings, so
+ * requests in flight are never answered, and raises the error, restarting
+ * and restarted events. adf_io_reinit_accel brings it back.
+ */
+CpaStatus adf_emul_hb_fail(Cpa32U accel_id)
+{
+    icp_accel_dev_t *accel_dev;
+    adf_emul_dev_t *emul_dev;
+
+    if (accel_id >= ADF_EMUL_NUM_DEVICES)
+        return CPA_STATUS_INVALID_PARAM;
+
+    accel_dev = icp_adf_getAccelDevByAccelId(accel_id);
+    if (!accel_dev || !accel_dev->ioPriv)
+        return CPA_STATUS_FAIL;
+
+    emul_dev = accel_dev->ioPriv;
+    if (emul_dev->hung)
+        return CPA_STATUS_RETRY;
+
+    emul_dev->hung = 1;
+    __atomic_store_n(&emul_hb_fail_next[accel_id], 1, __ATOMIC_RELEASE);
+
+    return CPA_STATUS_SUCCESS;
+}
+#endif
+
+/* The emulated device only raises events for a simulated heartbeat
+ * failure */
+CpaBoolean adf_io_pollProxyEvent(Cpa32U *dev_id, enum adf_event *event)
+{
+#ifdef ICP_HB_FAIL_SIM
+    Cpa32U i, next;
+#endif
+
+    ICP_CHECK_FOR_NULL_PARAM_RET_CODE(dev_id, CPA_FALSE);
+    ICP_CHECK_FOR_NULL_PARAM_RET_CODE(event, CPA_FALSE);
+
+#ifdef ICP_HB_FAIL_SIM
+    for (i = 0; i < ADF_EMUL_NUM_DEVICES; i++)
+    {
+        next = __atomic_load_n(&emul_hb_fail_next[i], __ATOMIC_ACQUIRE);
+        if (!next)
+            continue;
+
+        *dev_id = i;
+        *event = emul_hb_fail_events[next - 1];
+        if (next == EMUL_HB_FAIL_NUM_EVENTS)
+            next = 0;
+        else
+            next++;
+        __atomic_store_n(&emul_hb_fail_next[i], next, __ATOMIC_RELEASE);
+        return CPA_TRUE;
+    }
+#endif
+
+    return CPA_FALSE;
+}
@@ -0,0 +1,626 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/*
+ * This is sample code that compares static instance assignment with the
+ * instance dispatcher, icp_sal_DispatchGetInstance(), under skewed load.
+ *
+ * A "hog" thread keeps the first symmetric instance busy with large hash
+ * requests. Worker threads then issue small hash requests one at a time and
+ * time each of them, first with every worker bound to a fixed instance in
+ * round-robin order, then with the instance picked by the dispatcher before
+ * every request. The latency percentiles of both runs are printed; the
+ * workers sharing the hogged instance dominate the tail of the first run.
+ * Before that, the dispatcher is asked for an asymmetric instance once.
+ */
+
+#include <sched.h>
+
+#include "cpa.h"
+#include "cpa_cy_im.h"
+#include "cpa_cy_sym.h"
+
+#include "cpa_sample_utils.h"
+#include "icp_sal_dispatch.h"
+#include "icp_sal_poll.h"
+
+extern int gDebugParam;
+
+#define DISPATCH_MAX_INSTANCES 16
+#define DISPATCH_NUM_WORKERS 4
+#define DISPATCH_REQS_PER_WORKER 20000
+#define DISPATCH_WORKER_DATA_SIZE 256
+#define DISPATCH_HOG_DATA_SIZE (16 * 1024)
+#define DISPATCH_HOG_INFLIGHT 48
+#define DISPATCH_DIGEST_LENGTH 32
+
+/* Waiting threads give up the CPU so that they do not starve the pollers */
+#define DISPATCH_WAIT(cond)                                                    \
+    while (!(cond))                                                            \
+    {                                                                          \
+        sched_yield();                                                         \
+    }
+
+/* One request with its buffers, reused for every submission */
+typedef struct dispatch_request_s
+{
+    CpaCySymOpData opData;
+    CpaBufferList bufferList;
+    CpaFlatBuffer flatBuffer;
+    Cpa8U *pBufferMeta;
+    Cpa8U *pData;
+    volatile Cpa32U done;
+} dispatch_request_t;
+
+typedef struct dispatch_worker_s
+{
+    sampleThread thread;
+    Cpa32U id;
+    CpaBoolean useDispatcher;
+    dispatch_request_t request;
+    Cpa64U *pLatencies;
+    CpaStatus status;
+} dispatch_worker_t;
+
+static CpaInstanceHandle instances[DISPATCH_MAX_INSTANCES];
+static CpaCySymSessionCtx sessions[DISPATCH_MAX_INSTANCES];
+static CpaCySymSessionCtx hogSession = NULL;
+static Cpa16U numInstances = 0;
+static volatile Cpa32U stopPolling = 0;
+static volatile Cpa32U stopHog = 0;
+
+/* Forward declaration */
+CpaStatus dispatchSample(void);
+
+/*
+ * Callback function
+ *
+ * Marks the request passed as callback tag as done.
+ */
+static void symCallback(void *pCallbackTag,
+                        CpaStatus status,
+                        const CpaCySymOp operationType,
+                        void *pOpData,
+                        CpaBufferList *pDstBuffer,
+                        CpaBoolean verifyResult)
+{
+    dispatch_request_t *pRequest = (dispatch_request_t *)pCallbackTag;
+
+    __sync_synchronize();
+    pRequest->done = 1;
+}
+
+static CpaStatus dispatchRequestInit(dispatch_request_t *pRequest,
+                                     Cpa32U dataSize)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U bufferMetaSize = 0;
+
+    status = cpaCyBufferListGetMetaSize(instances[0], 1, &bufferMetaSize);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = PHYS_CONTIG_ALLOC(&pRequest->pBufferMeta, bufferMetaSize);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = PHYS_CONTIG_ALLOC(&pRequest->pData,
+                                   dataSize + DISPATCH_DIGEST_LENGTH);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        memset(pRequest->pData, 0xA5, dataSize);
+
+        pRequest->flatBuffer.dataLenInBytes = dataSize + DISPATCH_DIGEST_LENGTH;
+        pRequest->flatBuffer.pData = pRequest->pData;
+        pRequest->bufferList.pBuffers = &pRequest->flatBuffer;
+        pRequest->bufferList.numBuffers = 1;
+        pRequest->bufferList.pPrivateMetaData = pRequest->pBufferMeta;
+
+        pRequest->opData.packetType = CPA_CY_SYM_PACKET_TYPE_FULL;
+        pRequest->opData.hashStartSrcOffsetInBytes = 0;
+        pRequest->opData.messageLenToHashInBytes = dataSize;
+        pRequest->opData.pDigestResult = pRequest->pData + dataSize;
+        pRequest->done = 1;
+    }
+    return status;
+}
+
+static void dispatchRequestFree(dispatch_request_t *pRequest)
+{
+    PHYS_CONTIG_FREE(pRequest->pData);
+    PHYS_CONTIG_FREE(pRequest->pBufferMeta);
+}
+
+/*
+ * Submit a request, retrying while the instance's ring is full
+ */
+static CpaStatus dispatchSubmit(CpaInstanceHandle instanceHandle,
+                                CpaCySymSessionCtx sessionCtx,
+                                dispatch_request_t *pRequest)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pRequest->opData.sessionCtx = sessionCtx;
+    pRequest->done = 0;
+    do
+    {
+        status = cpaCySymPerformOp(instanceHandle,
+                                   pRequest,
+                                   &pRequest->opData,
+                                   &pRequest->bufferList,
+                                   &pRequest->bufferList,
+                                   NULL);
+        if (CPA_STATUS_RETRY == status)
+        {
+            sched_yield();
+        }
+    } while ((CPA_STATUS_RETRY == status) && !stopHog);
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        pRequest->done = 1;
+    }
+    return status;
+}
+
+/*
+ * Poll every instance until told to stop
+ */
+static void dispatchPoll(void *pArg)
+{
+    Cpa16U i = 0;
+
+    while (!stopPolling)
+    {
+        for (i = 0; i < numInstances; i++)
+        {
+            icp_sal_CyPollInstance(instances[i], 0);
+        }
+        sched_yield();
+    }
+    sampleThreadExit();
+}
+
+/*
+ * Keep the first instance loaded with large requests until told to stop
+ */
+static void dispatchHog(void *pArg)
+{
+    dispatch_request_t *pRequests = (dispatch_request_t *)pArg;
+    Cpa32U i = 0;
+
+    while (!stopHog)
+    {
+        DISPATCH_WAIT(pRequests[i].done);
+        dispatchSubmit(instances[0], hogSession, &pRequests[i]);
+        i = (i + 1) % DISPATCH_HOG_INFLIGHT;
+    }
+    for (i = 0; i < DISPATCH_HOG_INFLIGHT; i++)
+    {
+        DISPATCH_WAIT(pRequests[i].done);
+    }
+    sampleThreadExit();
+}
+
+/*
+ * Issue small requests one at a time and record the latency of each
+ */
+static void dispatchWork(void *pArg)
+{
+    dispatch_worker_t *pWorker = (dispatch_worker_t *)pArg;
+    CpaInstanceHandle instanceHandle = instances[pWorker->id % numInstances];
+    Cpa32U index = pWorker->id % numInstances;
+    Cpa64U start = 0;
+    Cpa32U i = 0;
+
+    for (i = 0; i < DISPATCH_REQS_PER_WORKER; i++)
+    {
+        if (CPA_TRUE == pWorker->useDispatcher)
+        {
+            pWorker->status = icp_sal_DispatchGetInstance(
+                CPA_ACC_SVC_TYPE_CRYPTO_SYM, &instanceHandle);
+            if (CPA_STATUS_SUCCESS != pWorker->status)
+            {
+                break;
+            }
+            for (index = 0; index < numInstances; index++)
+            {
+                if (instances[index] == instanceHandle)
+                {
+                    break;
+                }
+            }
+        }
+
+        start = sampleCoderdtsc();
+        pWorker->status = dispatchSubmit(
+            instanceHandle, sessions[index], &pWorker->request);
+        if (CPA_STATUS_SUCCESS != pWorker->status)
+        {
+            break;
+        }
+        DISPATCH_WAIT(pWorker->request.done);
+        pWorker->pLatencies[i] = sampleCoderdtsc() - start;
+    }
+    sampleThreadExit();
+}
+
+static int dispatchCompare(const void *pA, const void *pB)
+{
+    Cpa64U a = *(const Cpa64U *)pA;
+    Cpa64U b = *(const Cpa64U *)pB;
+
+    return (a > b) - (a < b);
+}
+
+/*
+ * Run all workers once, with or without the dispatcher, and print the
+ * latency percentiles in cycles
+ */
+static CpaStatus dispatchRun(CpaBoolean useDispatcher,
+                             dispatch_worker_t *pWorkers,
+                             Cpa64U *pLatencies)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U total = DISPATCH_NUM_WORKERS * DISPATCH_REQS_PER_WORKER;
+    Cpa32U i = 0;
+
+    for (i = 0; i < DISPATCH_NUM_WORKERS; i++)
+    {
+        pWorkers[i].useDispatcher = useDispatcher;
+        pWorkers[i].pLatencies = pLatencies + i * DISPATCH_REQS_PER_WORKER;
+        pWorkers[i].status = CPA_STATUS_SUCCESS;
+        sampleThreadCreate(
+            &pWorkers[i].thread, dispatchWork, &pWorkers[i], CPA_FALSE);
+    }
+    for (i = 0; i < DISPATCH_NUM_WORKERS; i++)
+    {
+        sampleThreadJoin(&pWorkers[i].thread);
+        if (CPA_STATUS_SUCCESS != pWorkers[i].status)
+        {
+            status = pWorkers[i].status;
+        }
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Worker failed, status = %d\n", status);
+        return status;
+    }
+
+    qsort(pLatencies, total, sizeof(Cpa64U), dispatchCompare);
+    PRINT("%-12s p50 %10llu  p99 %10llu  p99.9 %10llu  max %10llu cycles\n",
+          useDispatcher ? "dispatcher" : "round-robin",
+          (unsigned long long)pLatencies[total / 2],
+          (unsigned long long)pLatencies[(Cpa64U)total * 99 / 100],
+          (unsigned long long)pLatencies[(Cpa64U)total * 999 / 1000],
+          (unsigned long long)pLatencies[total - 1]);
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus dispatchSessionInit(CpaInstanceHandle instanceHandle,
+                                     CpaCySymSessionCtx *pSessionCtx)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaCySymSessionSetupData sessionSetupData = {0};
+    Cpa32U sessionCtxSize = 0;
+
+    sessionSetupData.sessionPriority = CPA_CY_PRIORITY_NORMAL;
+    sessionSetupData.symOperation = CPA_CY_SYM_OP_HASH;
+    sessionSetupData.hashSetupData.hashAlgorithm = CPA_CY_SYM_HASH_SHA256;
+    sessionSetupData.hashSetupData.hashMode = CPA_CY_SYM_HASH_MODE_PLAIN;
+    sessionSetupData.hashSetupData.digestResultLenInBytes =
+        DISPATCH_DIGEST_LENGTH;
+    sessionSetupData.digestIsAppended = CPA_FALSE;
+    sessionSetupData.verifyDigest = CPA_FALSE;
+
+    status = cpaCySymSessionCtxGetSize(
+        instanceHandle, &sessionSetupData, &sessionCtxSize);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = PHYS_CONTIG_ALLOC(pSessionCtx, sessionCtxSize);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaCySymInitSession(
+            instanceHandle, symCallback, &sessionSetupData, *pSessionCtx);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PHYS_CONTIG_FREE(*pSessionCtx);
+        }
+    }
+    return status;
+}
+
+static void dispatchSessionRemove(CpaInstanceHandle instanceHandle,
+                                  CpaCySymSessionCtx *pSessionCtx)
+{
+    if (NULL != *pSessionCtx)
+    {
+        symSessionWaitForInflightReq(*pSessionCtx);
+        cpaCySymRemoveSession(instanceHandle, *pSessionCtx);
+        PHYS_CONTIG_FREE(*pSessionCtx);
+    }
+}
+
+/*
+ * Check that the dispatcher picks an asymmetric instance when asked for one.
+ * Skipped when there are no asymmetric instances.
+ */
+static CpaStatus dispatchAsymCheck(void)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaInstanceHandle asymInstances[DISPATCH_MAX_INSTANCES];
+    CpaInstanceHandle instanceHandle = NULL;
+    Cpa16U numAsym = 0;
+    Cpa16U numStarted = 0;
+    Cpa16U i = 0;
+
+    status = cpaGetNumInstances(CPA_ACC_SVC_TYPE_CRYPTO_ASYM, &numAsym);
+    if ((CPA_STATUS_SUCCESS != status) || (0 == numAsym))
+    {
+        PRINT("No asymmetric instances, asymmetric dispatch not checked\n");
+        return CPA_STATUS_SUCCESS;
+    }
+    if (numAsym > DISPATCH_MAX_INSTANCES)
+    {
+        numAsym = DISPATCH_MAX_INSTANCES;
+    }
+    status =
+        cpaGetInstances(CPA_ACC_SVC_TYPE_CRYPTO_ASYM, numAsym, asymInstances);
+
+    for (i = 0; (CPA_STATUS_SUCCESS == status) && (i < numAsym); i++)
+    {
+        status = cpaCyStartInstance(asymInstances[i]);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            numStarted++;
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_DispatchGetInstance(CPA_ACC_SVC_TYPE_CRYPTO_ASYM,
+                                             &instanceHandle);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        for (i = 0; i < numAsym; i++)
+        {
+            if (asymInstances[i] == instanceHandle)
+            {
+                break;
+            }
+        }
+        if (i == numAsym)
+        {
+            PRINT_ERR("Dispatcher returned a non asymmetric instance\n");
+            status = CPA_STATUS_FAIL;
+        }
+        else
+        {
+            PRINT("Asymmetric dispatch picked instance %u of %u\n",
+                  i,
+                  numAsym);
+        }
+    }
+    else
+    {
+        PRINT_ERR("Asymmetric dispatch failed, status = %d\n", status);
+    }
+
+    for (i = 0; i < numStarted; i++)
+    {
+        cpaCyStopInstance(asymInstances[i]);
+    }
+    return status;
+}
+
+/*
+ * This is the main entry point for the dispatcher sample code. It starts
+ * all symmetric instances, loads the first one and compares the latency
+ * seen by the workers with and without the dispatcher.
+ */
+CpaStatus dispatchSample(void)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    dispatch_worker_t *pWorkers = NULL;
+    dispatch_request_t *pHogRequests = NULL;
+    Cpa64U *pLatencies = NULL;
+    sampleThread pollThread;
+    sampleThread hogThread;
+    Cpa16U numStarted = 0;
+    Cpa32U i = 0;
+
+    status = dispatchAsymCheck();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    status = cpaGetNumInstances(CPA_ACC_SVC_TYPE_CRYPTO_SYM, &numInstances);
+    if ((CPA_STATUS_SUCCESS != status) || (numInstances < 2))
+    {
+        PRINT_ERR("At least two symmetric instances are needed\n");
+        return CPA_STATUS_FAIL;
+    }
+    if (numInstances > DISPATCH_MAX_INSTANCES)
+    {
+        numInstances = DISPATCH_MAX_INSTANCES;
+    }
+    status = cpaGetInstances(
+        CPA_ACC_SVC_TYPE_CRYPTO_SYM, numInstances, instances);
+
+    for (i = 0; (CPA_STATUS_SUCCESS == status) && (i < numInstances); i++)
+    {
+        status = cpaCyStartInstance(instances[i]);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            numStarted++;
+            status =
+                cpaCySetAddressTranslation(instances[i], sampleVirtToPhys);
+        }
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = dispatchSessionInit(instances[i], &sessions[i]);
+        }
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = dispatchSessionInit(instances[0], &hogSession);
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = OS_MALLOC(&pWorkers,
+                           DISPATCH_NUM_WORKERS * sizeof(dispatch_worker_t));
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = OS_MALLOC(&pHogRequests,
+                           DISPATCH_HOG_INFLIGHT * sizeof(dispatch_request_t));
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = OS_MALLOC(&pLatencies,
+                           DISPATCH_NUM_WORKERS * DISPATCH_REQS_PER_WORKER *
+                               sizeof(Cpa64U));
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        memset(pWorkers, 0, DISPATCH_NUM_WORKERS * sizeof(dispatch_worker_t));
+        memset(pHogRequests,
+               0,
+               DISPATCH_HOG_INFLIGHT * sizeof(dispatch_request_t));
+    }
+    for (i = 0; (CPA_STATUS_SUCCESS == status) && (i < DISPATCH_NUM_WORKERS);
+         i++)
+    {
+        pWorkers[i].id = i;
+        status = dispatchRequestInit(&pWorkers[i].request,
+                                     DISPATCH_WORKER_DATA_SIZE);
+    }
+    for (i = 0; (CPA_STATUS_SUCCESS == status) && (i < DISPATCH_HOG_INFLIGHT);
+         i++)
+    {
+        status =
+            dispatchRequestInit(&pHogRequests[i], DISPATCH_HOG_DATA_SIZE);
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        PRINT("%u workers, %u instances, instance 0 loaded\n",
+              DISPATCH_NUM_WORKERS,
+              numInstances);
+
+        stopPolling = 0;
+        stopHog = 0;
+        sampleThreadCreate(&pollThread, dispatchPoll, NULL, CPA_FALSE);
+        sampleThreadCreate(&hogThread, dispatchHog, pHogRequests, CPA_FALSE);
+
+        status = dispatchRun(CPA_FALSE, pWorkers, pLatencies);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            status = dispatchRun(CPA_TRUE, pWorkers, pLatencies);
+        }
+
+        stopHog = 1;
+        sampleThreadJoin(&hogThread);
+        stopPolling = 1;
+        sampleThreadJoin(&pollThread);
+    }
+
+    /* Clean up */
+    if (NULL != pHogRequests)
+    {
+        for (i = 0; i < DISPATCH_HOG_INFLIGHT; i++)
+        {
+            dispatchRequestFree(&pHogRequests[i]);
+        }
+        OS_FREE(pHogRequests);
+    }
+    if (NULL != pWorkers)
+    {
+        for (i = 0; i < DISPATCH_NUM_WORKERS; i++)
+        {
+            dispatchRequestFree(&pWorkers[i].request);
+        }
+        OS_FREE(pWorkers);
+    }
+    OS_FREE(pLatencies);
+
+    dispatchSessionRemove(instances[0], &hogSession);
+    for (i = 0; i < numStarted; i++)
+    {
+        dispatchSessionRemove(instances[i], &sessions[i]);
+        cpaCyStopInstance(instances[i]);
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        PRINT_DBG("Sample code ran successfully\n");
+    }
+    else
+    {
+        PRINT_DBG("Sample code failed with status of %d\n", status);
+    }
+
+    return status;
+}
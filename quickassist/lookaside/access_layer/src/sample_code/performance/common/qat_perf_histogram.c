@@ -0,0 +1,478 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Log-linear latency histogram and the percentile reporting built on
+ *      top of it. See qat_perf_histogram.h for the bucket layout.
+ *
+ *****************************************************************************/
+#include "cpa_sample_code_framework.h"
+#include "qat_perf_histogram.h"
+#include "qat_perf_utils.h"
+
+#define NUM_NANOSEC_IN_KHZ_CYCLE (1000000ULL)
+
+/* Percentiles reported for every test, in parts per million */
+static const Cpa32U latencyPercentiles_g[QAT_PERF_HIST_NUM_PERCENTILES] = {
+    500000, 900000, 990000, 999000, 999900};
+static const char *latencyPercentileNames_g[QAT_PERF_HIST_NUM_PERCENTILES] = {
+    "p50", "p90", "p99", "p99.9", "p99.99"};
+
+static int latencyHistogramDump_g = QAT_PERF_HIST_DUMP_NONE;
+/* Incremented for every reported test so that dumped records of
+ * consecutive tests can be told apart */
+static Cpa32U latencyHistogramTestId_g = 0;
+
+CpaStatus setLatencyHistogramDump(int value)
+{
+    if (value < QAT_PERF_HIST_DUMP_NONE || value > QAT_PERF_HIST_DUMP_JSON)
+    {
+        PRINT_ERR("Invalid latency histogram dump format %d\n", value);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#ifndef USER_SPACE
+    if (QAT_PERF_HIST_DUMP_NONE != value)
+    {
+        PRINT_ERR("Latency histogram dump is only supported in user space\n");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+#endif
+    latencyHistogramDump_g = value;
+    return CPA_STATUS_SUCCESS;
+}
+EXPORT_SYMBOL(setLatencyHistogramDump);
+
+static inline Cpa32U histBucketIndex(perf_cycles_t value)
+{
+    Cpa32U shift = 0;
+
+    if (value < QAT_PERF_HIST_SUB_BUCKET_COUNT)
+    {
+        return (Cpa32U)value;
+    }
+    /* shift is at least 1 here, so (value >> shift) always lands in the
+     * upper half of the sub-bucket range */
+    shift = (63 - __builtin_clzll(value)) - QAT_PERF_HIST_SUB_BUCKET_BITS + 1;
+    return shift * QAT_PERF_HIST_SUB_BUCKET_HALF + (Cpa32U)(value >> shift);
+}
+
+static perf_cycles_t histBucketHighValue(Cpa32U index)
+{
+    Cpa32U shift = 0;
+    perf_cycles_t subBucket = 0;
+
+    if (index < QAT_PERF_HIST_SUB_BUCKET_COUNT)
+    {
+        return index;
+    }
+    shift = index / QAT_PERF_HIST_SUB_BUCKET_HALF - 1;
+    subBucket = index - shift * QAT_PERF_HIST_SUB_BUCKET_HALF;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void qatPerfHistogramReset(qat_perf_histogram_t *pHist)
+{
+    memset(pHist, 0, sizeof(qat_perf_histogram_t));
+    pHist->minValue = MAX_LATENCY_LIMIT;
+}
+
+void qatPerfHistogramRecord(qat_perf_histogram_t *pHist, perf_cycles_t value)
+{
+    pHist->counts[histBucketIndex(value)]++;
+    pHist->totalCount++;
+    pHist->sumValue += value;
+    if (value < pHist->minValue)
+        pHist->minValue = value;
+    if (value > pHist->maxValue)
+        pHist->maxValue = value;
+}
+
+void qatPerfHistogramMerge(qat_perf_histogram_t *pDst,
+                           const qat_perf_histogram_t *pSrc)
+{
+    Cpa32U i = 0;
+
+    if (0 == pSrc->totalCount)
+    {
+        return;
+    }
+    for (i = 0; i < QAT_PERF_HIST_BUCKET_COUNT; i++)
+    {
+        pDst->counts[i] += pSrc->counts[i];
+    }
+    pDst->totalCount += pSrc->totalCount;
+    pDst->sumValue += pSrc->sumValue;
+    if (pSrc->minValue < pDst->minValue)
+        pDst->minValue = pSrc->minValue;
+    if (pSrc->maxValue > pDst->maxValue)
+        pDst->maxValue = pSrc->maxValue;
+}
+
+perf_cycles_t qatPerfHistogramValueAtPercentile(
+    const qat_perf_histogram_t *pHist,
+    Cpa32U ppm)
+{
+    Cpa64U target = 0;
+    Cpa64U seen = 0;
+    Cpa32U i = 0;
+    perf_cycles_t value = 0;
+
+    if (0 == pHist->totalCount)
+    {
+        return 0;
+    }
+    target = pHist->totalCount * ppm + QAT_PERF_HIST_PPM - 1;
+    do_div(target, QAT_PERF_HIST_PPM);
+    if (0 == target)
+    {
+        target = 1;
+    }
+    for (i = 0; i < QAT_PERF_HIST_BUCKET_COUNT; i++)
+    {
+        seen += pHist->counts[i];
+        if (seen >= target)
+        {
+            value = histBucketHighValue(i);
+            break;
+        }
+    }
+    return (value > pHist->maxValue) ? pHist->maxValue : value;
+}
+
+void qatLatencyHistogramRecord(perf_data_t *performanceStats,
+                               perf_cycles_t latency)
+{
+    if (NULL == performanceStats->latencyHistogram)
+    {
+        performanceStats->latencyHistogram =
+            qaeMemAlloc(sizeof(qat_perf_histogram_t));
+        if (NULL == performanceStats->latencyHistogram)
+        {
+            PRINT_ERR("Could not allocate latency histogram\n");
+            return;
+        }
+        qatPerfHistogramReset(performanceStats->latencyHistogram);
+    }
+    qatPerfHistogramRecord(performanceStats->latencyHistogram, latency);
+}
+
+perf_cycles_t qatPerfCyclesToNsecs(perf_cycles_t cycles, Cpa32U cpuFreqKHz)
+{
+    perf_cycles_t nsecs = cycles * NUM_NANOSEC_IN_KHZ_CYCLE;
+
+    if (0 == cpuFreqKHz)
+    {
+        return 0;
+    }
+    do_div(nsecs, cpuFreqKHz);
+    return nsecs;
+}
+
+void qatPerfPrintUsecs(perf_cycles_t nsecs)
+{
+    perf_cycles_t usecs = nsecs;
+
+    do_div(usecs, SAMPLE_CODE_THOUSAND);
+    PRINT(" %8llu.%03llu",
+          usecs,
+          (unsigned long long)(nsecs - usecs * SAMPLE_CODE_THOUSAND));
+}
+
+static void printLatencyRow(const char *name,
+                            Cpa32U index,
+                            const qat_perf_histogram_t *pHist,
+                            Cpa32U cpuFreqKHz)
+{
+    Cpa32U i = 0;
+
+    if (NULL != name)
+    {
+        PRINT("%-10s", name);
+    }
+    else
+    {
+        PRINT("Thread %-3u", index);
+    }
+    PRINT(" %9llu", (unsigned long long)pHist->totalCount);
+    for (i = 0; i < QAT_PERF_HIST_NUM_PERCENTILES; i++)
+    {
+        qatPerfPrintUsecs(qatPerfCyclesToNsecs(
+            qatPerfHistogramValueAtPercentile(pHist, latencyPercentiles_g[i]),
+            cpuFreqKHz));
+    }
+    qatPerfPrintUsecs(qatPerfCyclesToNsecs(pHist->maxValue, cpuFreqKHz));
+    PRINT("\n");
+}
+
+#ifdef USER_SPACE
+static FILE *openLatencyDumpFile(void)
+{
+    FILE *fp = NULL;
+    const char *fileName = (QAT_PERF_HIST_DUMP_CSV == latencyHistogramDump_g)
+                               ? QAT_PERF_HIST_DUMP_FILE_CSV
+                               : QAT_PERF_HIST_DUMP_FILE_JSON;
+    Cpa32U i = 0;
+
+    fp = fopen(fileName, "a");
+    if (NULL == fp)
+    {
+        PRINT_ERR("Could not open %s\n", fileName);
+        return NULL;
+    }
+    /* Write the CSV header only once, into an empty file */
+    fseek(fp, 0, SEEK_END);
+    if (QAT_PERF_HIST_DUMP_CSV == latencyHistogramDump_g && 0 == ftell(fp))
+    {
+        fprintf(fp, "test,thread,core,samples,min_ns,mean_ns");
+        for (i = 0; i < QAT_PERF_HIST_NUM_PERCENTILES; i++)
+        {
+            fprintf(fp, ",%s_ns", latencyPercentileNames_g[i]);
+        }
+        fprintf(fp, ",max_ns\n");
+    }
+    return fp;
+}
+
+/* Write one record. thread is -1 for the aggregate of all threads. */
+static void dumpLatencyRecord(FILE *fp,
+                              Cpa32S thread,
+                              Cpa32S core,
+                              const qat_perf_histogram_t *pHist,
+                              Cpa32U cpuFreqKHz)
+{
+    Cpa32U i = 0;
+    CpaBoolean first = CPA_TRUE;
+    perf_cycles_t mean = pHist->sumValue;
+
+    do_div(mean, pHist->totalCount);
+    if (QAT_PERF_HIST_DUMP_CSV == latencyHistogramDump_g)
+    {
+        fprintf(fp, "%u,", latencyHistogramTestId_g);
+        if (thread < 0)
+            fprintf(fp, "all,,");
+        else
+            fprintf(fp, "%d,%d,", thread, core);
+        fprintf(fp,
+                "%llu,%llu,%llu",
+                (unsigned long long)pHist->totalCount,
+                qatPerfCyclesToNsecs(pHist->minValue, cpuFreqKHz),
+                qatPerfCyclesToNsecs(mean, cpuFreqKHz));
+        for (i = 0; i < QAT_PERF_HIST_NUM_PERCENTILES; i++)
+        {
+            fprintf(fp,
+                    ",%llu",
+                    qatPerfCyclesToNsecs(qatPerfHistogramValueAtPercentile(
+                                      pHist, latencyPercentiles_g[i]),
+                                  cpuFreqKHz));
+        }
+        fprintf(fp,
+                ",%llu\n",
+                qatPerfCyclesToNsecs(pHist->maxValue, cpuFreqKHz));
+        return;
+    }
+
+    /* One JSON object per line, including the non-empty buckets as
+     * [highest equivalent value in ns, count] pairs */
+    fprintf(fp, "{\"test\":%u,", latencyHistogramTestId_g);
+    if (thread < 0)
+        fprintf(fp, "\"thread\":\"all\",");
+    else
+        fprintf(fp, "\"thread\":%d,\"core\":%d,", thread, core);
+    fprintf(fp,
+            "\"cpu_khz\":%u,\"samples\":%llu,\"min_ns\":%llu,\"mean_ns\":%llu",
+            cpuFreqKHz,
+            (unsigned long long)pHist->totalCount,
+            qatPerfCyclesToNsecs(pHist->minValue, cpuFreqKHz),
+            qatPerfCyclesToNsecs(mean, cpuFreqKHz));
+    for (i = 0; i < QAT_PERF_HIST_NUM_PERCENTILES; i++)
+    {
+        fprintf(fp,
+                ",\"%s_ns\":%llu",
+                latencyPercentileNames_g[i],
+                qatPerfCyclesToNsecs(qatPerfHistogramValueAtPercentile(
+                                  pHist, latencyPercentiles_g[i]),
+                              cpuFreqKHz));
+    }
+    fprintf(fp,
+            ",\"max_ns\":%llu,\"buckets\":[",
+            qatPerfCyclesToNsecs(pHist->maxValue, cpuFreqKHz));
+    for (i = 0; i < QAT_PERF_HIST_BUCKET_COUNT; i++)
+    {
+        if (0 == pHist->counts[i])
+            continue;
+        fprintf(fp,
+                "%s[%llu,%llu]",
+                first ? "" : ",",
+                qatPerfCyclesToNsecs(histBucketHighValue(i), cpuFreqKHz),
+                (unsigned long long)pHist->counts[i]);
+        first = CPA_FALSE;
+    }
+    fprintf(fp, "]}\n");
+}
+#endif
+
+void qatLatencyHistogramsReport(thread_creation_data_t *data)
+{
+    qat_perf_histogram_t *pTotal = NULL;
+    qat_perf_histogram_t *pHist = NULL;
+    Cpa32U cpuFreqKHz = sampleCodeGetCpuFreq();
+    Cpa32U i = 0;
+#ifdef USER_SPACE
+    FILE *fp = NULL;
+#endif
+
+    if (!latency_enable || NULL == data)
+    {
+        return;
+    }
+    pTotal = qaeMemAlloc(sizeof(qat_perf_histogram_t));
+    if (NULL == pTotal)
+    {
+        PRINT_ERR("Could not allocate latency histogram\n");
+        return;
+    }
+    qatPerfHistogramReset(pTotal);
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        if (NULL != data->performanceStats[i] &&
+            NULL != data->performanceStats[i]->latencyHistogram)
+        {
+            qatPerfHistogramMerge(
+                pTotal, data->performanceStats[i]->latencyHistogram);
+        }
+    }
+    if (0 == pTotal->totalCount)
+    {
+        qaeMemFree((void **)&pTotal);
+        return;
+    }
+
+    PRINT("Latency percentiles (uSecs)\n");
+    PRINT("%-10s %9s", "", "samples");
+    for (i = 0; i < QAT_PERF_HIST_NUM_PERCENTILES; i++)
+    {
+        PRINT(" %12s", latencyPercentileNames_g[i]);
+    }
+    PRINT(" %12s\n", "max");
+#ifdef USER_SPACE
+    if (QAT_PERF_HIST_DUMP_NONE != latencyHistogramDump_g)
+    {
+        fp = openLatencyDumpFile();
+    }
+#endif
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        if (NULL == data->performanceStats[i])
+            continue;
+        pHist = data->performanceStats[i]->latencyHistogram;
+        if (NULL == pHist || 0 == pHist->totalCount)
+            continue;
+        if (data->numberOfThreads > 1)
+        {
+            printLatencyRow(NULL, i, pHist, cpuFreqKHz);
+        }
+#ifdef USER_SPACE
+        if (NULL != fp)
+        {
+            dumpLatencyRecord(fp,
+                              i,
+                              data->performanceStats[i]->logicalCoreAffinity,
+                              pHist,
+                              cpuFreqKHz);
+        }
+#endif
+    }
+    printLatencyRow("All", 0, pTotal, cpuFreqKHz);
+#ifdef USER_SPACE
+    if (NULL != fp)
+    {
+        dumpLatencyRecord(fp, -1, -1, pTotal, cpuFreqKHz);
+        fclose(fp);
+    }
+#endif
+    latencyHistogramTestId_g++;
+    qaeMemFree((void **)&pTotal);
+}
+
+void qatLatencyHistogramsFree(thread_creation_data_t *data)
+{
+    Cpa32U i = 0;
+
+    if (NULL == data)
+    {
+        return;
+    }
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        if (NULL != data->performanceStats[i] &&
+            NULL != data->performanceStats[i]->latencyHistogram)
+        {
+            qaeMemFree((void **)&data->performanceStats[i]->latencyHistogram);
+        }
+    }
+}
@@ -0,0 +1,238 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Log-linear (HDR style) latency histogram used by the performance
+ *      sample code. Values are recorded in CPU cycles. Each power of two
+ *      range is split into QAT_PERF_HIST_SUB_BUCKET_HALF linear sub-buckets,
+ *      so the relative error of a reported value is bounded by
+ *      1/QAT_PERF_HIST_SUB_BUCKET_HALF, while the memory footprint is
+ *      constant regardless of how many samples are recorded.
+ *
+ *****************************************************************************/
+#ifndef QAT_PERF_HISTOGRAM_H_
+#define QAT_PERF_HISTOGRAM_H_
+
+#include "cpa.h"
+#include "cpa_sample_code_framework.h"
+
+/* Number of bits used to index the linear sub-buckets of each power of two
+ * range. 7 bits gives a worst case relative error below 1.6% */
+#define QAT_PERF_HIST_SUB_BUCKET_BITS (7)
+#define QAT_PERF_HIST_SUB_BUCKET_COUNT (1ULL << QAT_PERF_HIST_SUB_BUCKET_BITS)
+#define QAT_PERF_HIST_SUB_BUCKET_HALF (QAT_PERF_HIST_SUB_BUCKET_COUNT >> 1)
+/* Values below QAT_PERF_HIST_SUB_BUCKET_COUNT get one bucket each, every
+ * following power of two range up to 2^64 adds another half set */
+#define QAT_PERF_HIST_BUCKET_COUNT                                             \
+    ((64 - QAT_PERF_HIST_SUB_BUCKET_BITS + 2) * QAT_PERF_HIST_SUB_BUCKET_HALF)
+
+/* Percentiles are expressed in parts per million to avoid floating point */
+#define QAT_PERF_HIST_PPM (1000000)
+#define QAT_PERF_HIST_NUM_PERCENTILES (5)
+
+/* Dump formats selectable with setLatencyHistogramDump() */
+#define QAT_PERF_HIST_DUMP_NONE (0)
+#define QAT_PERF_HIST_DUMP_CSV (1)
+#define QAT_PERF_HIST_DUMP_JSON (2)
+
+#define QAT_PERF_HIST_DUMP_FILE_CSV "cpa_sample_code_latency.csv"
+#define QAT_PERF_HIST_DUMP_FILE_JSON "cpa_sample_code_latency.json"
+
+typedef struct qat_perf_histogram_s
+{
+    Cpa64U counts[QAT_PERF_HIST_BUCKET_COUNT];
+    Cpa64U totalCount;
+    perf_cycles_t minValue;
+    perf_cycles_t maxValue;
+    perf_cycles_t sumValue;
+} qat_perf_histogram_t;
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Clear all counters of a histogram.
+ *
+ * @param[in]   pHist       histogram to reset
+ *
+ *****************************************************************************/
+void qatPerfHistogramReset(qat_perf_histogram_t *pHist);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Record a single value (in cycles) into a histogram.
+ *
+ * @param[in]   pHist       histogram to record into
+ * @param[in]   value       value to record
+ *
+ *****************************************************************************/
+void qatPerfHistogramRecord(qat_perf_histogram_t *pHist, perf_cycles_t value);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Add all counts of pSrc into pDst.
+ *
+ * @param[in,out]   pDst    histogram to accumulate into
+ * @param[in]       pSrc    histogram to accumulate from
+ *
+ *****************************************************************************/
+void qatPerfHistogramMerge(qat_perf_histogram_t *pDst,
+                           const qat_perf_histogram_t *pSrc);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Return the highest value equivalent to the requested percentile,
+ *      i.e. the upper bound of the bucket in which the percentile falls,
+ *      clamped to the largest recorded value.
+ *
+ * @param[in]   pHist       histogram to query
+ * @param[in]   ppm         percentile in parts per million (e.g. 990000
+ *                          for p99)
+ *
+ * @retval value in cycles, 0 if the histogram is empty
+ *****************************************************************************/
+perf_cycles_t qatPerfHistogramValueAtPercentile(
+    const qat_perf_histogram_t *pHist,
+    Cpa32U ppm);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Record a latency sample for a thread. The histogram is allocated on
+ *      first use and stays attached to the perf_data_t until
+ *      qatLatencyHistogramsFree() is called.
+ *
+ * @param[in]   performanceStats    per thread stats
+ * @param[in]   latency             latency in cycles
+ *
+ *****************************************************************************/
+void qatLatencyHistogramRecord(perf_data_t *performanceStats,
+                               perf_cycles_t latency);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Print the latency percentiles of every thread of a test and of all
+ *      threads aggregated, and optionally dump them to a CSV or JSON file.
+ *      Called by the framework once the test statistics have been printed.
+ *
+ * @param[in]   data        test data holding the per thread stats
+ *
+ *****************************************************************************/
+void qatLatencyHistogramsReport(thread_creation_data_t *data);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_histogram.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Release the latency histograms attached to the threads of a test.
+ *
+ * @param[in]   data        test data holding the per thread stats
+ *
+ *****************************************************************************/
+void qatLatencyHistogramsFree(thread_creation_data_t *data);
+
+/* Convert a number of cycles to nanoseconds */
+perf_cycles_t qatPerfCyclesToNsecs(perf_cycles_t cycles, Cpa32U cpuFreqKHz);
+
+/* Print a duration given in nanoseconds as microseconds with three decimals */
+void qatPerfPrintUsecs(perf_cycles_t nsecs);
+
+/* Select the machine readable dump format, one of QAT_PERF_HIST_DUMP_* */
+CpaStatus setLatencyHistogramDump(int value);
+
+#endif
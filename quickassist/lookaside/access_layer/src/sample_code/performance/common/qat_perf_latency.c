@@ -66,6 +66,8 @@
 #include "icp_sal_poll.h"
 #include "qat_perf_latency.h"
 #include "qat_perf_utils.h"
+#include "qat_perf_histogram.h"
+#include "qat_perf_openloop.h"
 
 #define MAX_LATENCY_COUNT (100)
 #define READ_ALL_RESPONSES (0)
@@ -239,7 +241,8 @@ CpaStatus qatStartLatencyMeasurement(perf_data_t *performanceStats,
             if ((submissions + 1 == performanceStats->nextCount) &&
                 (i < MAX_LATENCY_COUNT))
             {
-                performanceStats->start_times[i] = sampleCodeTimestamp();
+                performanceStats->start_times[i] =
+                    qatOpenLoopRequestTimestamp(performanceStats);
             }
         }
     }
@@ -332,6 +335,7 @@ CpaStatus qatSummariseLatencyMeasurements(perf_data_t *performanceStats)
                 perf_cycles_t latency = performanceStats->response_times[i] -
                                         performanceStats->start_times[i];
                 performanceStats->aveLatency += latency;
+                qatLatencyHistogramRecord(performanceStats, latency);
 
                 if (latency < performanceStats->minLatency)
                     performanceStats->minLatency = latency;
@@ -0,0 +1,439 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_perf_openloop.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Open-loop load generation, see qat_perf_openloop.h.
+ *
+ *****************************************************************************/
+#include "cpa_sample_code_framework.h"
+#include "qat_perf_openloop.h"
+#include "qat_perf_utils.h"
+
+/* ln(2) in 16.16 fixed point */
+#define QAT_PERF_OPENLOOP_LN2_Q16 (45426ULL)
+#define QAT_PERF_OPENLOOP_FRACTION_BITS (16)
+#define QAT_PERF_OPENLOOP_SEED (0x9E3779B97F4A7C15ULL)
+
+static Cpa32U offeredLoad_g = 0;
+static Cpa32U offeredLoadSteps_g = 1;
+static Cpa32U offeredLoadDistribution_g = QAT_PERF_OPENLOOP_CONSTANT;
+
+CpaStatus setOfferedLoad(Cpa32U opsPerSec, Cpa32U steps, Cpa32U distribution)
+{
+    if (0 == steps || steps > QAT_PERF_OPENLOOP_MAX_STEPS)
+    {
+        PRINT_ERR("Number of offered load steps must be 1 to %d\n",
+                  QAT_PERF_OPENLOOP_MAX_STEPS);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (QAT_PERF_OPENLOOP_CONSTANT != distribution &&
+        QAT_PERF_OPENLOOP_POISSON != distribution)
+    {
+        PRINT_ERR("Invalid inter-arrival distribution %u\n", distribution);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    if (0 != opsPerSec && opsPerSec / steps == 0)
+    {
+        PRINT_ERR("Offered load %u is too low for %u steps\n",
+                  opsPerSec,
+                  steps);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    offeredLoad_g = opsPerSec;
+    offeredLoadSteps_g = steps;
+    offeredLoadDistribution_g = distribution;
+    return CPA_STATUS_SUCCESS;
+}
+EXPORT_SYMBOL(setOfferedLoad);
+
+CpaBoolean isOpenLoopEnabled(void)
+{
+    return (0 != offeredLoad_g) ? CPA_TRUE : CPA_FALSE;
+}
+EXPORT_SYMBOL(isOpenLoopEnabled);
+
+/* xorshift64* generator, good enough to draw inter-arrival times */
+static inline Cpa32U openLoopRandom(Cpa64U *pSeed)
+{
+    Cpa64U x = *pSeed;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *pSeed = x;
+    return (Cpa32U)((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/* Returns -ln(r / 2^32) in 16.16 fixed point, i.e. an exponentially
+ * distributed variate with mean 1 when r is uniform. Integer only so that
+ * it can also be used in kernel space. */
+static Cpa64U openLoopNegLog(Cpa32U r)
+{
+    Cpa32U msb = 0;
+    Cpa32U i = 0;
+    Cpa64U x = 0;
+    Cpa64U log2Q16 = 0;
+
+    if (0 == r)
+    {
+        r = 1;
+    }
+    msb = 31 - __builtin_clz(r);
+    /* normalise r to [1, 2) in 1.31 fixed point */
+    x = (Cpa64U)r << (31 - msb);
+    /* fractional bits of log2 by repeated squaring */
+    for (i = 0; i < QAT_PERF_OPENLOOP_FRACTION_BITS; i++)
+    {
+        x = (x * x) >> 31;
+        log2Q16 <<= 1;
+        if (x >= (1ULL << 32))
+        {
+            x >>= 1;
+            log2Q16 |= 1;
+        }
+    }
+    log2Q16 |= (Cpa64U)msb << QAT_PERF_OPENLOOP_FRACTION_BITS;
+    /* -log2(r / 2^32) = 32 - log2(r), then scale by ln(2) */
+    return (((32ULL << QAT_PERF_OPENLOOP_FRACTION_BITS) - log2Q16) *
+            QAT_PERF_OPENLOOP_LN2_Q16) >>
+           QAT_PERF_OPENLOOP_FRACTION_BITS;
+}
+
+static inline Cpa32U openLoopStep(const qat_perf_openloop_t *pOpenLoop,
+                                  Cpa64U index)
+{
+    Cpa64U step = index * pOpenLoop->numSteps;
+
+    if (index >= pOpenLoop->numRequests)
+    {
+        return pOpenLoop->numSteps - 1;
+    }
+    do_div(step, pOpenLoop->numRequests);
+    return (Cpa32U)step;
+}
+
+/* Interval between the intended send times of request index and index + 1.
+ * Both the submission and the completion side call this with their own
+ * copy of the seed, so they see the same sequence. */
+static perf_cycles_t openLoopInterval(const qat_perf_openloop_t *pOpenLoop,
+                                      Cpa64U index,
+                                      Cpa64U *pSeed)
+{
+    perf_cycles_t interval = pOpenLoop->cyclesPerSec;
+
+    do_div(interval,
+           pOpenLoop->steps[openLoopStep(pOpenLoop, index)].offeredRate);
+    if (QAT_PERF_OPENLOOP_POISSON == offeredLoadDistribution_g)
+    {
+        interval = (interval * openLoopNegLog(openLoopRandom(pSeed))) >>
+                   QAT_PERF_OPENLOOP_FRACTION_BITS;
+    }
+    return interval;
+}
+
+static void openLoopStart(perf_data_t *performanceStats)
+{
+    qat_perf_openloop_t *pOpenLoop = performanceStats->openLoop;
+    Cpa32U i = 0;
+
+    pOpenLoop->numRequests = performanceStats->numOperations;
+    if (0 == pOpenLoop->numRequests)
+    {
+        pOpenLoop->numRequests = 1;
+    }
+    pOpenLoop->numSteps = offeredLoadSteps_g;
+    pOpenLoop->cyclesPerSec =
+        (Cpa64U)sampleCodeGetCpuFreq() * SAMPLE_CODE_THOUSAND;
+    for (i = 0; i < pOpenLoop->numSteps; i++)
+    {
+        pOpenLoop->steps[i].offeredRate =
+            offeredLoad_g / pOpenLoop->numSteps * (i + 1);
+    }
+    pOpenLoop->sendIndex = 0;
+    pOpenLoop->responseIndex = 0;
+    pOpenLoop->sendSeed =
+        QAT_PERF_OPENLOOP_SEED ^ (performanceStats->logicalCoreAffinity + 1);
+    pOpenLoop->responseSeed = pOpenLoop->sendSeed;
+    pOpenLoop->nextIntended = sampleCodeTimestamp();
+    pOpenLoop->nextResponseIntended = pOpenLoop->nextIntended;
+    pOpenLoop->started = CPA_TRUE;
+}
+
+void qatOpenLoopPace(perf_data_t *performanceStats)
+{
+    qat_perf_openloop_t *pOpenLoop = NULL;
+    qat_perf_openloop_step_t *pStep = NULL;
+    perf_cycles_t intended = 0;
+    perf_cycles_t now = 0;
+    perf_cycles_t interval = 0;
+    Cpa32U i = 0;
+
+    if (0 == offeredLoad_g)
+    {
+        return;
+    }
+    if (NULL == performanceStats->openLoop)
+    {
+        performanceStats->openLoop = qaeMemAlloc(sizeof(qat_perf_openloop_t));
+        if (NULL == performanceStats->openLoop)
+        {
+            PRINT_ERR("Could not allocate open-loop state\n");
+            return;
+        }
+        memset(performanceStats->openLoop, 0, sizeof(qat_perf_openloop_t));
+        for (i = 0; i < QAT_PERF_OPENLOOP_MAX_STEPS; i++)
+        {
+            qatPerfHistogramReset(
+                &performanceStats->openLoop->steps[i].latency);
+        }
+    }
+    pOpenLoop = performanceStats->openLoop;
+    if (CPA_FALSE == pOpenLoop->started)
+    {
+        openLoopStart(performanceStats);
+    }
+
+    intended = pOpenLoop->nextIntended;
+    interval = openLoopInterval(
+        pOpenLoop, pOpenLoop->sendIndex, &pOpenLoop->sendSeed);
+    pStep = &pOpenLoop->steps[openLoopStep(pOpenLoop, pOpenLoop->sendIndex)];
+    if (0 == pStep->firstIntended)
+    {
+        pStep->firstIntended = intended;
+    }
+
+    now = sampleCodeTimestamp();
+    if (now < intended)
+    {
+        /* busy wait: sleeping is far too coarse for the intervals used at
+         * the rates the accelerator runs at */
+        while (sampleCodeTimestamp() < intended)
+        {
+        }
+    }
+    else if (now - intended > interval)
+    {
+        pStep->lateSends++;
+    }
+
+    pOpenLoop->currentIntended = intended;
+    pOpenLoop->nextIntended = intended + interval;
+    pOpenLoop->sendIndex++;
+}
+
+perf_cycles_t qatOpenLoopRequestTimestamp(perf_data_t *performanceStats)
+{
+    if (NULL != performanceStats->openLoop &&
+        CPA_TRUE == performanceStats->openLoop->started)
+    {
+        return performanceStats->openLoop->currentIntended;
+    }
+    return sampleCodeTimestamp();
+}
+
+void qatOpenLoopResponse(perf_data_t *performanceStats)
+{
+    qat_perf_openloop_t *pOpenLoop = performanceStats->openLoop;
+    qat_perf_openloop_step_t *pStep = NULL;
+    perf_cycles_t now = 0;
+
+    if (NULL == pOpenLoop || CPA_FALSE == pOpenLoop->started)
+    {
+        return;
+    }
+    now = sampleCodeTimestamp();
+    pStep =
+        &pOpenLoop->steps[openLoopStep(pOpenLoop, pOpenLoop->responseIndex)];
+    qatPerfHistogramRecord(&pStep->latency,
+                           now - pOpenLoop->nextResponseIntended);
+    pStep->responses++;
+    pStep->lastResponse = now;
+    pOpenLoop->nextResponseIntended += openLoopInterval(
+        pOpenLoop, pOpenLoop->responseIndex, &pOpenLoop->responseSeed);
+    pOpenLoop->responseIndex++;
+}
+
+void qatOpenLoopReset(perf_data_t *performanceStats)
+{
+    if (NULL != performanceStats->openLoop)
+    {
+        performanceStats->openLoop->started = CPA_FALSE;
+    }
+}
+
+void qatOpenLoopReport(thread_creation_data_t *data)
+{
+    qat_perf_histogram_t *pLatency = NULL;
+    qat_perf_openloop_t *pOpenLoop = NULL;
+    qat_perf_openloop_step_t *pStep = NULL;
+    Cpa32U cpuFreqKHz = sampleCodeGetCpuFreq();
+    Cpa32U numSteps = 0;
+    Cpa32U step = 0;
+    Cpa32U i = 0;
+    Cpa64U offered = 0;
+    Cpa64U achieved = 0;
+    Cpa64U lateSends = 0;
+    Cpa64U rate = 0;
+
+    if (0 == offeredLoad_g || NULL == data)
+    {
+        return;
+    }
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        if (NULL != data->performanceStats[i] &&
+            NULL != data->performanceStats[i]->openLoop)
+        {
+            numSteps = data->performanceStats[i]->openLoop->numSteps;
+            break;
+        }
+    }
+    if (0 == numSteps)
+    {
+        return;
+    }
+    pLatency = qaeMemAlloc(sizeof(qat_perf_histogram_t));
+    if (NULL == pLatency)
+    {
+        PRINT_ERR("Could not allocate latency histogram\n");
+        return;
+    }
+
+    PRINT("Open-loop load, %s arrivals, latency from intended send time"
+          " (uSecs)\n",
+          (QAT_PERF_OPENLOOP_POISSON == offeredLoadDistribution_g)
+              ? "Poisson"
+              : "constant rate");
+    PRINT("%-4s %14s %14s %10s %12s %12s %12s %12s\n",
+          "Step",
+          "Offered ops/s",
+          "Achieved ops/s",
+          "Late sends",
+          "p50",
+          "p99",
+          "p99.9",
+          "max");
+    for (step = 0; step < numSteps; step++)
+    {
+        qatPerfHistogramReset(pLatency);
+        offered = 0;
+        achieved = 0;
+        lateSends = 0;
+        for (i = 0; i < data->numberOfThreads; i++)
+        {
+            if (NULL == data->performanceStats[i])
+                continue;
+            pOpenLoop = data->performanceStats[i]->openLoop;
+            if (NULL == pOpenLoop || step >= pOpenLoop->numSteps)
+                continue;
+            pStep = &pOpenLoop->steps[step];
+            offered += pStep->offeredRate;
+            lateSends += pStep->lateSends;
+            qatPerfHistogramMerge(pLatency, &pStep->latency);
+            if (pStep->lastResponse > pStep->firstIntended)
+            {
+                rate = pStep->responses * pOpenLoop->cyclesPerSec;
+                do_div(rate, pStep->lastResponse - pStep->firstIntended);
+                achieved += rate;
+            }
+        }
+        PRINT("%-4u %14llu %14llu %10llu",
+              step + 1,
+              (unsigned long long)offered,
+              (unsigned long long)achieved,
+              (unsigned long long)lateSends);
+        qatPerfPrintUsecs(qatPerfCyclesToNsecs(
+            qatPerfHistogramValueAtPercentile(pLatency, 500000), cpuFreqKHz));
+        qatPerfPrintUsecs(qatPerfCyclesToNsecs(
+            qatPerfHistogramValueAtPercentile(pLatency, 990000), cpuFreqKHz));
+        qatPerfPrintUsecs(qatPerfCyclesToNsecs(
+            qatPerfHistogramValueAtPercentile(pLatency, 999000), cpuFreqKHz));
+        qatPerfPrintUsecs(
+            qatPerfCyclesToNsecs(pLatency->maxValue, cpuFreqKHz));
+        PRINT("\n");
+    }
+    qaeMemFree((void **)&pLatency);
+}
+
+void qatOpenLoopFree(thread_creation_data_t *data)
+{
+    Cpa32U i = 0;
+
+    if (NULL == data)
+    {
+        return;
+    }
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        if (NULL != data->performanceStats[i] &&
+            NULL != data->performanceStats[i]->openLoop)
+        {
+            qaeMemFree((void **)&data->performanceStats[i]->openLoop);
+        }
+    }
+}
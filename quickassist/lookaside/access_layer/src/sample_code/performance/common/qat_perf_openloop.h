@@ -0,0 +1,201 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_perf_openloop.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Open-loop load generation for the performance sample code.
+ *
+ *      By default every thread submits as fast as the rings allow (closed
+ *      loop), which hides queueing delay. When an offered load is set,
+ *      each thread instead releases requests according to a schedule of
+ *      intended send times, with a constant or exponential (Poisson
+ *      arrivals) inter-arrival time. Latency is measured from the intended
+ *      send time rather than from the actual submission, so time spent
+ *      behind schedule or retrying on a full ring is accounted for
+ *      (no coordinated omission).
+ *
+ *      The completion side replays the same schedule from the same seed
+ *      instead of storing a timestamp per request, which keeps memory
+ *      constant. This relies on responses for a thread being delivered in
+ *      submission order, as is the case for a single instance ring.
+ *
+ *      The run of every thread can be split into a number of steps of
+ *      increasing offered load (offered / steps, 2 * offered / steps, ...,
+ *      offered) to obtain a throughput versus latency curve in one run.
+ *
+ *****************************************************************************/
+#ifndef QAT_PERF_OPENLOOP_H_
+#define QAT_PERF_OPENLOOP_H_
+
+#include "cpa.h"
+#include "cpa_sample_code_framework.h"
+#include "qat_perf_histogram.h"
+
+#define QAT_PERF_OPENLOOP_MAX_STEPS (10)
+
+#define QAT_PERF_OPENLOOP_CONSTANT (0)
+#define QAT_PERF_OPENLOOP_POISSON (1)
+
+typedef struct qat_perf_openloop_step_s
+{
+    qat_perf_histogram_t latency;
+    /* requests per second offered by this thread during the step */
+    Cpa32U offeredRate;
+    Cpa64U responses;
+    /* requests which could only be sent more than one mean interval after
+     * their intended send time, i.e. the thread could not keep up */
+    Cpa64U lateSends;
+    perf_cycles_t firstIntended;
+    perf_cycles_t lastResponse;
+} qat_perf_openloop_step_t;
+
+typedef struct qat_perf_openloop_s
+{
+    CpaBoolean started;
+    Cpa64U numRequests;
+    Cpa32U numSteps;
+    Cpa64U cyclesPerSec;
+    /* submission side */
+    Cpa64U sendIndex;
+    Cpa64U sendSeed;
+    perf_cycles_t nextIntended;
+    perf_cycles_t currentIntended;
+    /* completion side, replays the submission schedule */
+    Cpa64U responseIndex;
+    Cpa64U responseSeed;
+    perf_cycles_t nextResponseIntended;
+    qat_perf_openloop_step_t steps[QAT_PERF_OPENLOOP_MAX_STEPS];
+} qat_perf_openloop_t;
+
+/**
+ *****************************************************************************
+ * @file qat_perf_openloop.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Configure the open-loop mode. A rate of 0 selects the default
+ *      closed-loop behaviour.
+ *
+ * @param[in]   opsPerSec       offered requests per second per thread
+ * @param[in]   steps           number of load steps, 1 for a fixed load
+ * @param[in]   distribution    QAT_PERF_OPENLOOP_CONSTANT or
+ *                              QAT_PERF_OPENLOOP_POISSON
+ *
+ * @retval CPA_STATUS_SUCCESS, CPA_STATUS_INVALID_PARAM
+ *****************************************************************************/
+CpaStatus setOfferedLoad(Cpa32U opsPerSec, Cpa32U steps, Cpa32U distribution);
+
+/* Returns CPA_TRUE when a target request rate has been configured */
+CpaBoolean isOpenLoopEnabled(void);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_openloop.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Wait until the intended send time of the next request of this
+ *      thread. Must be called once per request, before the first
+ *      submission attempt (not on retries). Does nothing in closed-loop
+ *      mode.
+ *
+ * @param[in]   performanceStats    per thread stats, numOperations must be
+ *                                  set
+ *
+ *****************************************************************************/
+void qatOpenLoopPace(perf_data_t *performanceStats);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_openloop.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Timestamp to use as the start of a latency measurement: the intended
+ *      send time of the current request in open-loop mode, the current time
+ *      otherwise.
+ *
+ *****************************************************************************/
+perf_cycles_t qatOpenLoopRequestTimestamp(perf_data_t *performanceStats);
+
+/* Account for a response, called from the request callbacks */
+void qatOpenLoopResponse(perf_data_t *performanceStats);
+
+/* Restart the schedule, keeping the collected step statistics */
+void qatOpenLoopReset(perf_data_t *performanceStats);
+
+/* Print the offered versus achieved throughput and latency per step for
+ * all threads of a test */
+void qatOpenLoopReport(thread_creation_data_t *data);
+
+/* Release the open-loop state attached to the threads of a test */
+void qatOpenLoopFree(thread_creation_data_t *data);
+
+#endif
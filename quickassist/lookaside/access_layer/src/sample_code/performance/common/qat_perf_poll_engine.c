@@ -0,0 +1,211 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_perf_poll_engine.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Adaptive polling engine support, see qat_perf_poll_engine.h.
+ *
+ *****************************************************************************/
+#include "cpa_sample_code_framework.h"
+#include "qat_perf_poll_engine.h"
+#include "qat_perf_utils.h"
+#ifdef USER_SPACE
+#include "icp_sal_poll.h"
+#endif
+
+/* How often the polling thread checks whether the service was stopped */
+#define QAT_PERF_POLL_ENGINE_CHECK_MSEC (1)
+#define QAT_PERF_POLL_ENGINE_PERMILLE (1000)
+
+static int pollEngine_g = 0;
+
+#ifdef USER_SPACE
+/* Counters of the engines which stopped since the last report */
+static Cpa32U pollEngineCount_g = 0;
+static icp_sal_poll_engine_stats_t pollEngineTotals_g;
+#endif
+
+CpaStatus setPollEngine(int value)
+{
+#ifdef USER_SPACE
+    if (0 != value && 1 != value)
+    {
+        PRINT_ERR("pollEngine must be 0 or 1\n");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    pollEngine_g = value;
+    return CPA_STATUS_SUCCESS;
+#else
+    if (0 != value)
+    {
+        PRINT_ERR("The polling engine is only available in user space\n");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+    return CPA_STATUS_SUCCESS;
+#endif
+}
+EXPORT_SYMBOL(setPollEngine);
+
+CpaBoolean isPollEngineEnabled(void)
+{
+    return (0 != pollEngine_g) ? CPA_TRUE : CPA_FALSE;
+}
+EXPORT_SYMBOL(isPollEngineEnabled);
+
+void qatPerfPollEngineRun(CpaInstanceHandle instanceHandle,
+                          volatile CpaBoolean *pServiceStarted)
+{
+#ifdef USER_SPACE
+    icp_sal_poll_engine_stats_t stats = {0};
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = icp_sal_PollEngineStart(instanceHandle, NULL);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("icp_sal_PollEngineStart returned status %d\n", status);
+        return;
+    }
+    while (CPA_TRUE == *pServiceStarted)
+    {
+        sampleCodeSleepMilliSec(QAT_PERF_POLL_ENGINE_CHECK_MSEC);
+    }
+    if (CPA_STATUS_SUCCESS ==
+        icp_sal_PollEngineGetStats(instanceHandle, &stats))
+    {
+        __sync_fetch_and_add(&pollEngineTotals_g.busyPolls, stats.busyPolls);
+        __sync_fetch_and_add(&pollEngineTotals_g.idlePolls, stats.idlePolls);
+        __sync_fetch_and_add(&pollEngineTotals_g.busyNs, stats.busyNs);
+        __sync_fetch_and_add(&pollEngineTotals_g.spinNs, stats.spinNs);
+        __sync_fetch_and_add(&pollEngineTotals_g.sleepNs, stats.sleepNs);
+        __sync_fetch_and_add(&pollEngineTotals_g.sleeps, stats.sleeps);
+        __sync_fetch_and_add(&pollEngineTotals_g.blocks, stats.blocks);
+        __sync_fetch_and_add(&pollEngineTotals_g.wakeups, stats.wakeups);
+        __sync_fetch_and_add(&pollEngineTotals_g.fdWakeups,
+                             stats.fdWakeups);
+        __sync_fetch_and_add(&pollEngineCount_g, 1);
+    }
+    icp_sal_PollEngineStop(instanceHandle);
+#endif
+}
+
+CpaBoolean qatPerfPollEngineGetUsage(qat_perf_poll_engine_usage_t *pUsage)
+{
+#ifdef USER_SPACE
+    icp_sal_poll_engine_stats_t *pTotals = &pollEngineTotals_g;
+    Cpa64U wallNs = pTotals->busyNs + pTotals->spinNs + pTotals->sleepNs;
+
+    if (0 == pollEngineCount_g || 0 == wallNs)
+    {
+        return CPA_FALSE;
+    }
+    pUsage->numEngines = pollEngineCount_g;
+    pUsage->busyPermille =
+        (Cpa32U)(pTotals->busyNs * QAT_PERF_POLL_ENGINE_PERMILLE / wallNs);
+    pUsage->spinPermille =
+        (Cpa32U)(pTotals->spinNs * QAT_PERF_POLL_ENGINE_PERMILLE / wallNs);
+    pUsage->sleepPermille = QAT_PERF_POLL_ENGINE_PERMILLE -
+                            pUsage->busyPermille - pUsage->spinPermille;
+    pUsage->sleeps = pTotals->sleeps;
+    pUsage->blocks = pTotals->blocks;
+    pUsage->wakeups = pTotals->wakeups + pTotals->fdWakeups;
+    return CPA_TRUE;
+#else
+    return CPA_FALSE;
+#endif
+}
+
+void qatPerfPollEngineReport(thread_creation_data_t *data)
+{
+#ifdef USER_SPACE
+    qat_perf_poll_engine_usage_t usage = {0};
+
+    if (CPA_TRUE != isPollEngineEnabled())
+    {
+        return;
+    }
+    if (CPA_TRUE == qatPerfPollEngineGetUsage(&usage))
+    {
+        PRINT("Poll engine CPU (%u instances)  %u.%u%% "
+              "(busy %u.%u%%, spin %u.%u%%), sleeping %u.%u%%\n",
+              usage.numEngines,
+              (usage.busyPermille + usage.spinPermille) / 10,
+              (usage.busyPermille + usage.spinPermille) % 10,
+              usage.busyPermille / 10,
+              usage.busyPermille % 10,
+              usage.spinPermille / 10,
+              usage.spinPermille % 10,
+              usage.sleepPermille / 10,
+              usage.sleepPermille % 10);
+        PRINT("Poll engine waits  timed %llu, blocking %llu, woken %llu\n",
+              (unsigned long long)usage.sleeps,
+              (unsigned long long)usage.blocks,
+              (unsigned long long)usage.wakeups);
+    }
+    memset(&pollEngineTotals_g, 0, sizeof(pollEngineTotals_g));
+    pollEngineCount_g = 0;
+#endif
+}
@@ -0,0 +1,142 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_perf_poll_engine.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Use the library adaptive polling engine (icp_sal_PollEngineStart)
+ *      instead of the sample code polling loops.
+ *
+ *      The sample code polling threads spin (or sleep for a fixed interval)
+ *      for the whole test. With the engine, each polled instance is served
+ *      by a library thread which busy-polls only while responses arrive
+ *      and otherwise backs off or blocks until the next submission. The
+ *      engine counters are accumulated over the instances and reported as
+ *      the share of time the polling threads kept a core busy, which can
+ *      be set against the latency percentiles of the same test.
+ *
+ *****************************************************************************/
+#ifndef QAT_PERF_POLL_ENGINE_H_
+#define QAT_PERF_POLL_ENGINE_H_
+
+#include "cpa.h"
+#include "cpa_sample_code_framework.h"
+
+/* CPU usage of the polling engines during the last test, in permille of
+ * the engine wall time summed over instances */
+typedef struct qat_perf_poll_engine_usage_s
+{
+    Cpa32U numEngines;
+    Cpa32U busyPermille;
+    Cpa32U spinPermille;
+    Cpa32U sleepPermille;
+    Cpa64U sleeps;
+    Cpa64U blocks;
+    Cpa64U wakeups;
+} qat_perf_poll_engine_usage_t;
+
+/**
+ *****************************************************************************
+ * @file qat_perf_poll_engine.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Select the polling engine (1) or the sample code polling loops (0)
+ *      for instances in polled mode.
+ *
+ * @retval CPA_STATUS_SUCCESS, CPA_STATUS_INVALID_PARAM,
+ *         CPA_STATUS_UNSUPPORTED outside user space
+ *****************************************************************************/
+CpaStatus setPollEngine(int value);
+
+/* Returns CPA_TRUE when the polling engine has been selected */
+CpaBoolean isPollEngineEnabled(void);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_poll_engine.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Body of a polling thread: runs the engine on the instance for as long
+ *      as *pServiceStarted is true, then stops it and accumulates its
+ *      counters for the report.
+ *
+ *****************************************************************************/
+void qatPerfPollEngineRun(CpaInstanceHandle instanceHandle,
+                          volatile CpaBoolean *pServiceStarted);
+
+/* Usage of the engines which stopped since the last report. Returns
+ * CPA_FALSE when no engine ran. */
+CpaBoolean qatPerfPollEngineGetUsage(qat_perf_poll_engine_usage_t *pUsage);
+
+/* Print the CPU usage of the polling engines of the last test and reset
+ * the counters */
+void qatPerfPollEngineReport(thread_creation_data_t *data);
+
+#endif /* QAT_PERF_POLL_ENGINE_H_ */
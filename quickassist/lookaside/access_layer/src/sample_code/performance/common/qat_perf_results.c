@@ -0,0 +1,378 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_perf_results.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Structured results sink, see qat_perf_results.h.
+ *
+ *****************************************************************************/
+#include "cpa_sample_code_framework.h"
+#include "qat_perf_histogram.h"
+#include "qat_perf_poll_engine.h"
+#include "qat_perf_results.h"
+#include "qat_perf_utils.h"
+
+#define QAT_PERF_RESULTS_NUM_PERCENTILES (3)
+
+typedef struct qat_perf_results_config_s
+{
+    char key[QAT_PERF_RESULTS_NAME_LEN];
+    Cpa32U value;
+} qat_perf_results_config_t;
+
+/* Record of the test currently being reported */
+typedef struct qat_perf_results_record_s
+{
+    CpaBoolean active;
+    char service[QAT_PERF_RESULTS_NAME_LEN];
+    qat_perf_results_config_t config[QAT_PERF_RESULTS_MAX_CONFIG];
+    Cpa32U numConfig;
+    Cpa32U threadsRan;
+    Cpa64U submissions;
+    Cpa64U responses;
+    Cpa64U retries;
+    perf_cycles_t startCycles;
+    perf_cycles_t endCycles;
+    /* averages over the threads which ran */
+    perf_cycles_t offloadCycles;
+    perf_cycles_t minLatency;
+    perf_cycles_t aveLatency;
+    perf_cycles_t maxLatency;
+    CpaBoolean hasThroughput;
+    Cpa32U throughputMbps;
+    CpaBoolean hasOpsPerSec;
+    Cpa32U opsPerSec;
+} qat_perf_results_record_t;
+
+static int perfResultsDump_g = QAT_PERF_RESULTS_DUMP_NONE;
+static qat_perf_results_record_t perfResultsRecord_g;
+/* Identifies the records of one invocation of the sample code (start time
+ * of the first test) and the test within the invocation */
+static Cpa64U perfResultsRunId_g = 0;
+static Cpa32U perfResultsTestId_g = 0;
+
+static const Cpa32U perfResultsPercentiles_g[QAT_PERF_RESULTS_NUM_PERCENTILES] =
+    {500000, 990000, 999000};
+static const char *perfResultsPercentileNames_g
+    [QAT_PERF_RESULTS_NUM_PERCENTILES] = {"p50", "p99", "p99.9"};
+
+CpaStatus setPerfResultsDump(int value)
+{
+    if (value < QAT_PERF_RESULTS_DUMP_NONE ||
+        value > QAT_PERF_RESULTS_DUMP_JSON)
+    {
+        PRINT_ERR("Invalid results dump format %d\n", value);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+#ifndef USER_SPACE
+    if (QAT_PERF_RESULTS_DUMP_NONE != value)
+    {
+        PRINT_ERR("Results dump is only supported in user space\n");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+#endif
+    perfResultsDump_g = value;
+    return CPA_STATUS_SUCCESS;
+}
+EXPORT_SYMBOL(setPerfResultsDump);
+
+void qatPerfResultsBegin(thread_creation_data_t *data)
+{
+    qat_perf_results_record_t *pRec = &perfResultsRecord_g;
+    perf_data_t *pStats = NULL;
+    Cpa32U i = 0;
+
+    memset(pRec, 0, sizeof(qat_perf_results_record_t));
+    if (QAT_PERF_RESULTS_DUMP_NONE == perfResultsDump_g || NULL == data)
+    {
+        return;
+    }
+    pRec->active = CPA_TRUE;
+    for (i = 0; i < data->numberOfThreads; i++)
+    {
+        pStats = data->performanceStats[i];
+        if (NULL == pStats ||
+            CPA_STATUS_UNSUPPORTED == pStats->threadReturnStatus)
+        {
+            continue;
+        }
+        if (0 == pRec->threadsRan ||
+            pStats->startCyclesTimestamp < pRec->startCycles)
+        {
+            pRec->startCycles = pStats->startCyclesTimestamp;
+        }
+        if (pStats->endCyclesTimestamp > pRec->endCycles)
+        {
+            pRec->endCycles = pStats->endCyclesTimestamp;
+        }
+        pRec->threadsRan++;
+        pRec->submissions += pStats->numOperations;
+        pRec->responses += pStats->responses;
+        pRec->retries += pStats->retries;
+        pRec->offloadCycles += pStats->offloadCycles;
+        pRec->minLatency += pStats->minLatency;
+        pRec->aveLatency += pStats->aveLatency;
+        pRec->maxLatency += pStats->maxLatency;
+    }
+    if (0 != pRec->threadsRan)
+    {
+        do_div(pRec->offloadCycles, pRec->threadsRan);
+        do_div(pRec->minLatency, pRec->threadsRan);
+        do_div(pRec->aveLatency, pRec->threadsRan);
+        do_div(pRec->maxLatency, pRec->threadsRan);
+    }
+}
+
+void qatPerfResultsSetService(const char *service)
+{
+    if (CPA_TRUE != perfResultsRecord_g.active || NULL == service)
+    {
+        return;
+    }
+    snprintf(perfResultsRecord_g.service,
+             QAT_PERF_RESULTS_NAME_LEN,
+             "%s",
+             service);
+}
+EXPORT_SYMBOL(qatPerfResultsSetService);
+
+void qatPerfResultsAddConfig(const char *key, Cpa32U value)
+{
+    qat_perf_results_record_t *pRec = &perfResultsRecord_g;
+
+    if (CPA_TRUE != pRec->active || NULL == key)
+    {
+        return;
+    }
+    if (pRec->numConfig >= QAT_PERF_RESULTS_MAX_CONFIG)
+    {
+        PRINT_ERR("Too many results parameters, %s not recorded\n", key);
+        return;
+    }
+    snprintf(pRec->config[pRec->numConfig].key,
+             QAT_PERF_RESULTS_NAME_LEN,
+             "%s",
+             key);
+    pRec->config[pRec->numConfig].value = value;
+    pRec->numConfig++;
+}
+EXPORT_SYMBOL(qatPerfResultsAddConfig);
+
+void qatPerfResultsSetThroughput(Cpa32U throughputMbps)
+{
+    perfResultsRecord_g.hasThroughput = CPA_TRUE;
+    perfResultsRecord_g.throughputMbps = throughputMbps;
+}
+EXPORT_SYMBOL(qatPerfResultsSetThroughput);
+
+void qatPerfResultsSetOpsPerSec(Cpa32U opsPerSec)
+{
+    perfResultsRecord_g.hasOpsPerSec = CPA_TRUE;
+    perfResultsRecord_g.opsPerSec = opsPerSec;
+}
+EXPORT_SYMBOL(qatPerfResultsSetOpsPerSec);
+
+#ifdef USER_SPACE
+static void dumpResultsLatency(FILE *fp,
+                               thread_creation_data_t *data,
+                               Cpa32U cpuFreqKHz)
+{
+    qat_perf_results_record_t *pRec = &perfResultsRecord_g;
+    qat_perf_histogram_t *pTotal = NULL;
+    Cpa32U i = 0;
+
+    fprintf(fp,
+            ",\"latency_ns\":{\"min\":%llu,\"mean\":%llu,\"max\":%llu",
+            qatPerfCyclesToNsecs(pRec->minLatency, cpuFreqKHz),
+            qatPerfCyclesToNsecs(pRec->aveLatency, cpuFreqKHz),
+            qatPerfCyclesToNsecs(pRec->maxLatency, cpuFreqKHz));
+    pTotal = qaeMemAlloc(sizeof(qat_perf_histogram_t));
+    if (NULL != pTotal)
+    {
+        qatPerfHistogramReset(pTotal);
+        for (i = 0; i < data->numberOfThreads; i++)
+        {
+            if (NULL != data->performanceStats[i] &&
+                NULL != data->performanceStats[i]->latencyHistogram)
+            {
+                qatPerfHistogramMerge(
+                    pTotal, data->performanceStats[i]->latencyHistogram);
+            }
+        }
+        for (i = 0; i < QAT_PERF_RESULTS_NUM_PERCENTILES &&
+                    0 != pTotal->totalCount;
+             i++)
+        {
+            fprintf(fp,
+                    ",\"%s\":%llu",
+                    perfResultsPercentileNames_g[i],
+                    qatPerfCyclesToNsecs(
+                        qatPerfHistogramValueAtPercentile(
+                            pTotal, perfResultsPercentiles_g[i]),
+                        cpuFreqKHz));
+        }
+        qaeMemFree((void **)&pTotal);
+    }
+    fprintf(fp, "}");
+}
+
+static void dumpResultsRecord(FILE *fp,
+                              thread_creation_data_t *data,
+                              CpaStatus status)
+{
+    qat_perf_results_record_t *pRec = &perfResultsRecord_g;
+    Cpa32U cpuFreqKHz = sampleCodeGetCpuFreq();
+    perf_cycles_t numOfCycles = pRec->endCycles - pRec->startCycles;
+    Cpa64U opsPerSec = pRec->opsPerSec;
+    qat_perf_poll_engine_usage_t pollUsage = {0};
+    Cpa32U i = 0;
+
+    if (CPA_TRUE != pRec->hasOpsPerSec && 0 != numOfCycles)
+    {
+        /* cpuFreqKHz * 1000 cycles per second */
+        opsPerSec = (Cpa64U)((double)pRec->responses * cpuFreqKHz * 1000 /
+                             numOfCycles);
+    }
+    fprintf(fp,
+            "{\"run\":%llu,\"test\":%u,\"service\":\"%s\",\"status\":\"%s\"",
+            (unsigned long long)perfResultsRunId_g,
+            perfResultsTestId_g,
+            ('\0' != pRec->service[0]) ? pRec->service : "unknown",
+            (CPA_STATUS_SUCCESS == status) ? "pass" : "fail");
+    fprintf(fp,
+            ",\"threads\":%u,\"packet_size\":%u,\"cpu_khz\":%u,\"config\":{",
+            pRec->threadsRan,
+            data->packetSize,
+            cpuFreqKHz);
+    for (i = 0; i < pRec->numConfig; i++)
+    {
+        fprintf(fp,
+                "%s\"%s\":%u",
+                (0 == i) ? "" : ",",
+                pRec->config[i].key,
+                pRec->config[i].value);
+    }
+    fprintf(fp,
+            "},\"submissions\":%llu,\"responses\":%llu,\"retries\":%llu"
+            ",\"cycles\":%llu",
+            (unsigned long long)pRec->submissions,
+            (unsigned long long)pRec->responses,
+            (unsigned long long)pRec->retries,
+            (unsigned long long)numOfCycles);
+    if (CPA_TRUE == pRec->hasThroughput)
+    {
+        fprintf(fp, ",\"throughput_mbps\":%u", pRec->throughputMbps);
+    }
+    fprintf(fp, ",\"ops_per_sec\":%llu", (unsigned long long)opsPerSec);
+    if (iaCycleCount_g)
+    {
+        fprintf(fp,
+                ",\"cycles_per_op\":%llu",
+                (unsigned long long)pRec->offloadCycles);
+    }
+    if (latency_enable)
+    {
+        dumpResultsLatency(fp, data, cpuFreqKHz);
+    }
+    if (CPA_TRUE == qatPerfPollEngineGetUsage(&pollUsage))
+    {
+        fprintf(fp,
+                ",\"poll_cpu_permille\":{\"busy\":%u,\"spin\":%u"
+                ",\"sleep\":%u}",
+                pollUsage.busyPermille,
+                pollUsage.spinPermille,
+                pollUsage.sleepPermille);
+    }
+    fprintf(fp, "}\n");
+}
+#endif
+
+void qatPerfResultsReport(thread_creation_data_t *data, CpaStatus status)
+{
+#ifdef USER_SPACE
+    FILE *fp = NULL;
+
+    if (CPA_TRUE != perfResultsRecord_g.active || NULL == data)
+    {
+        return;
+    }
+    perfResultsRecord_g.active = CPA_FALSE;
+    if (0 == perfResultsRunId_g)
+    {
+        perfResultsRunId_g = (Cpa64U)time(NULL);
+    }
+    fp = fopen(QAT_PERF_RESULTS_FILE, "a");
+    if (NULL == fp)
+    {
+        PRINT_ERR("Could not open %s\n", QAT_PERF_RESULTS_FILE);
+        return;
+    }
+    dumpResultsRecord(fp, data, status);
+    fclose(fp);
+    perfResultsTestId_g++;
+#endif
+}
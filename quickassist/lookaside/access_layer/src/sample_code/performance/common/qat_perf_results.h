@@ -0,0 +1,168 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_perf_results.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Structured results sink for the performance sample code.
+ *
+ *      When enabled, one JSON object per test is appended to
+ *      QAT_PERF_RESULTS_FILE in the current directory (JSON lines). A record
+ *      holds the test configuration, the thread count and packet size, the
+ *      submissions, responses and retries, throughput, operations per
+ *      second, the average cost of offload in cycles per operation (see
+ *      qat_perf_cycles.h) and the latency statistics and percentiles.
+ *
+ *      The generic counters are captured by the framework before the test
+ *      specific print function runs, as the print functions clear the per
+ *      thread stats. The print functions add what only they know: the
+ *      service name, the algorithm parameters and the throughput computed
+ *      the way the test defines it.
+ *
+ *      Records of two runs can be compared with cpa_sample_code_compare.
+ *
+ *****************************************************************************/
+#ifndef QAT_PERF_RESULTS_H_
+#define QAT_PERF_RESULTS_H_
+
+#include "cpa.h"
+#include "cpa_sample_code_framework.h"
+
+/* Formats selectable with setPerfResultsDump() */
+#define QAT_PERF_RESULTS_DUMP_NONE (0)
+#define QAT_PERF_RESULTS_DUMP_JSON (1)
+
+#define QAT_PERF_RESULTS_FILE "cpa_sample_code_results.json"
+
+/* Maximum number of configuration parameters recorded for one test */
+#define QAT_PERF_RESULTS_MAX_CONFIG (12)
+#define QAT_PERF_RESULTS_NAME_LEN (32)
+
+/**
+ *****************************************************************************
+ * @file qat_perf_results.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Select the results dump format.
+ *
+ * @param[in]   value       QAT_PERF_RESULTS_DUMP_NONE or
+ *                          QAT_PERF_RESULTS_DUMP_JSON
+ *
+ * @retval CPA_STATUS_SUCCESS, CPA_STATUS_INVALID_PARAM,
+ *         CPA_STATUS_UNSUPPORTED (file output outside of user space)
+ *****************************************************************************/
+CpaStatus setPerfResultsDump(int value);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_results.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Start the record of a test and capture the counters of all threads
+ *      which ran. Called by the framework before the stats print function.
+ *
+ * @param[in]   data        test data holding the per thread stats
+ *
+ *****************************************************************************/
+void qatPerfResultsBegin(thread_creation_data_t *data);
+
+/* Name the test of the current record, e.g. "cipher" or "dc" */
+void qatPerfResultsSetService(const char *service);
+
+/* Add a numeric configuration parameter to the current record. Parameters
+ * together with the service, packet size and thread count identify a test
+ * when results are compared */
+void qatPerfResultsAddConfig(const char *key, Cpa32U value);
+
+/* Throughput in Mbps as computed and printed by the test */
+void qatPerfResultsSetThroughput(Cpa32U throughputMbps);
+
+/* Operations per second as computed and printed by the test, overrides the
+ * value derived from the responses and the test duration */
+void qatPerfResultsSetOpsPerSec(Cpa32U opsPerSec);
+
+/**
+ *****************************************************************************
+ * @file qat_perf_results.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Complete the current record and append it to the results file.
+ *      Called by the framework once the test statistics have been printed
+ *      and before the latency histograms are released.
+ *
+ * @param[in]   data        test data holding the per thread stats
+ * @param[in]   status      status returned by the stats print function
+ *
+ *****************************************************************************/
+void qatPerfResultsReport(thread_creation_data_t *data, CpaStatus status);
+
+#endif /* QAT_PERF_RESULTS_H_ */
@@ -65,6 +65,7 @@
 #include "cpa_sample_code_crypto_utils.h"
 #include "cpa_sample_code_dc_utils.h"
 #include "qat_perf_latency.h"
+#include "qat_perf_openloop.h"
 
 void qatPerfInitStats(perf_data_t *performanceStats,
                       Cpa32U numLists,
@@ -101,6 +102,7 @@ void qatPerfInitStats(perf_data_t *performanceStats,
     performanceStats->isIACycleCountProfiled = 0;
     performanceStats->response_process_time = 0;
     qatFreeLatency(performanceStats);
+    qatOpenLoopReset(performanceStats);
 
     performanceStats->numLoops = numLoops;
     performanceStats->numOperations = (Cpa64U)numLists * (Cpa64U)numLoops;
@@ -90,6 +90,7 @@
 #include "busy_loop.h"
 #include "qat_perf_cycles.h"
 #include "qat_perf_buffer_utils.h"
+#include "qat_perf_histogram.h"
 extern int
     latency_single_buffer_mode; /* set to 1 for single buffer processing */
 extern char *cpaStatusToString(CpaStatus status); /* for more readable debug */
@@ -1031,6 +1032,7 @@ static CpaStatus performDcDpEnqueueOp(compression_test_params_t *setup,
             perf_cycles_t latency =
                 perfData->response_times[i] - request_submit_start[i];
             perfData->aveLatency += latency;
+            qatLatencyHistogramRecord(perfData, latency);
 
             if (latency < perfData->minLatency)
                 perfData->minLatency = latency;
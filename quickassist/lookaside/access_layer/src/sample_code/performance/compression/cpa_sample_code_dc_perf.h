@@ -79,6 +79,7 @@
 
 #include "cpa.h"
 #include "cpa_dc.h"
+#include "icp_sal_dc_ns_prepared.h"
 #ifdef SC_CHAINING_ENABLED
 #include "cpa_dc_chain.h"
 #endif
@@ -321,6 +322,9 @@ typedef struct compression_test_params_s
     Cpa32U symIvLength;
     Cpa8U numSessions;
     CpaBoolean keyDerive;
+    /* Requests kept in flight with icp_sal_DcChainPerformOpBatch,
+     * 0 to submit every list with cpaDcChainPerformOp */
+    Cpa32U chainDepth;
 #endif
     /*the logicalQaInstance for the cipher to use*/
     Cpa32U logicalQaInstance;
@@ -335,6 +339,10 @@ typedef struct compression_test_params_s
 #if DC_API_VERSION_AT_LEAST(3, 2)
     /*flag to set (NS)Sessionless compression/decompression Request*/
     CpaBoolean setNsRequest;
+    /*flag to submit NS requests with setups prepared once per thread*/
+    CpaBoolean setNsPrepared;
+    icp_sal_dc_ns_prepared_t nsCompPrepared;
+    icp_sal_dc_ns_prepared_t nsDecompPrepared;
 #endif
     CpaDcSessionHandle *pSessionHandle;
     /* the Destination Buffer size obtained using
@@ -82,6 +82,9 @@
 #include "qat_perf_latency.h"
 #include "qat_perf_utils.h"
 #include "qat_perf_cycles.h"
+#include "qat_perf_openloop.h"
+#include "qat_perf_poll_engine.h"
+#include "qat_perf_results.h"
 #include "icp_sal_poll.h"
 
 #define MAX_SESSION_REMOVE_RETRIES (15)
@@ -195,6 +198,7 @@ void dcPerformCallback(void *pCallbackTag, CpaStatus status)
         return;
     }
     pPerfData->responses++;
+    qatOpenLoopResponse(pPerfData);
     /*check status */
     if (CPA_STATUS_SUCCESS != status)
     {
@@ -1003,6 +1007,12 @@ CpaStatus calculateRequireBuffers(compression_test_params_t *dcSetup)
 }
 EXPORT_SYMBOL(calculateRequireBuffers);
 
+static void sampleCodeDcEnginePoll(CpaInstanceHandle instanceHandle_in)
+{
+    qatPerfPollEngineRun(instanceHandle_in, &dc_service_started_g);
+    sampleCodeThreadExit();
+}
+
 CpaStatus dcCreatePollingThreadsIfPollingIsEnabled(void)
 {
     CpaInstanceInfo2 *instanceInfo2 = NULL;
@@ -1052,6 +1062,11 @@ CpaStatus dcCreatePollingThreadsIfPollingIsEnabled(void)
             if (CPA_TRUE == instanceInfo2[i].isPolled)
             {
                 numDcPolledInstances_g++;
+                if (CPA_TRUE == isPollEngineEnabled())
+                {
+                    pollFnArr[i] = sampleCodeDcEnginePoll;
+                    continue;
+                }
 #if defined(USER_SPACE) && !defined(SC_EPOLL_DISABLED)
                 status = icp_sal_DcGetFileDescriptor(dcInstances_g[i], &fd);
                 if (CPA_STATUS_SUCCESS == status)
@@ -1428,6 +1443,14 @@ CpaStatus dcPrintStats(thread_creation_data_t *data)
     }
     /* Print Statistics */
     dcPrintTestData(dcSetup);
+    qatPerfResultsSetService("dc");
+    qatPerfResultsAddConfig("direction", dcSetup->dcSessDir);
+    qatPerfResultsAddConfig("sessState", dcSetup->setupData.sessState);
+    qatPerfResultsAddConfig("compType", dcSetup->setupData.compType);
+    qatPerfResultsAddConfig("huffType", dcSetup->setupData.huffType);
+    qatPerfResultsAddConfig("compLevel", dcSetup->setupData.compLevel);
+    qatPerfResultsAddConfig("corpus", dcSetup->corpus);
+    qatPerfResultsAddConfig("dpApi", dcSetup->isDpApi);
     PRINT("Number of threads      %d\n", data->numberOfThreads);
     PRINT("Total Responses        %llu\n", (unsigned long long)stats.responses);
     PRINT("Total Retries          %llu\n", (unsigned long long)stats.retries);
@@ -1441,6 +1464,7 @@ CpaStatus dcPrintStats(thread_creation_data_t *data)
             getDcThroughput(bytesConsumed, numOfCycles, dcSetup->numLoops);
         {
             PRINT("Throughput(Mbps)       %u\n", throughput);
+            qatPerfResultsSetThroughput(throughput);
         }
 
         dcCalculateAndPrintCompressionRatio(bytesConsumed, bytesProduced);
@@ -1593,6 +1617,15 @@ CpaStatus dcChainPrintStats(thread_creation_data_t *data)
         }
 
         dcCalculateAndPrintCompressionRatio(bytesConsumed, bytesProduced);
+        if (0 != dcSetup->chainDepth && 0 != numOfCycles)
+        {
+            Cpa64U opsPerSec =
+                stats.responses * sampleCodeGetCpuFreq() * 1000ULL;
+
+            do_div(opsPerSec, numOfCycles);
+            PRINT("Operations per second  %llu\n",
+                  (unsigned long long)opsPerSec);
+        }
         if (latency_enable && (data->numberOfThreads != 0))
         {
             perf_cycles_t statsLatency = 0;
@@ -1626,6 +1659,14 @@ void dcPrintTestData(compression_test_params_t *dcSetup)
     {
         PRINT("Data_Plane\n");
     }
+    else if (dcSetup->setNsPrepared)
+    {
+        PRINT("Traditional_NS_Prepared\n");
+    }
+    else if (dcSetup->setNsRequest)
+    {
+        PRINT("Traditional_NS\n");
+    }
     else
     {
         PRINT("Traditional\n");
@@ -1769,6 +1810,11 @@ void dcChainPrintTestData(compression_test_params_t *chainSetup)
     {
         PRINT("Data_Plane\n");
     }
+    else if (0 != chainSetup->chainDepth)
+    {
+        PRINT("Traditional_Batch\n");
+        PRINT("Queue Depth            %u\n", chainSetup->chainDepth);
+    }
     else
     {
         PRINT("Traditional\n");
@@ -103,6 +103,8 @@
 #endif
 
 #include "icp_sal_poll.h"
+#include "qat_perf_openloop.h"
+#include "icp_sal_dc_chain_batch.h"
 
 static CpaStatus qatDcChainInduceOverflow(compression_test_params_t *setup,
                                           CpaDcSessionHandle pSessionHandle,
@@ -256,6 +258,7 @@ CpaStatus qatDcChainSubmitRequest(compression_test_params_t *setup,
         setup->requestOps.flushFlag = setup->flushFlag;
     }
 
+    qatOpenLoopPace(setup->performanceStats);
     do
     {
         /*To use reliability code, I set CpaBoolean reliability_g = CPA_TRUE
@@ -303,6 +306,94 @@ CpaStatus qatDcChainSubmitRequest(compression_test_params_t *setup,
 }
 EXPORT_SYMBOL(qatDcChainSubmitRequest);
 
+/* Submit the lists of a file keeping setup->chainDepth requests in flight,
+ * topping the window up with one batch, and so one doorbell, per pass */
+static CpaStatus qatDcChainSubmitWindow(compression_test_params_t *setup,
+                                        CpaInstanceInfo2 *pInstanceInfo2,
+                                        CpaDcSessionHandle pSessionHandle,
+                                        CpaBufferList *arrayOfSrcBufferLists,
+                                        CpaBufferList *arrayOfDestBufferLists,
+                                        CpaDcChainRqResults *arrayOfResults,
+                                        CpaDcChainOpData *arrayOfChainOpData)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    perf_data_t *stats = setup->performanceStats;
+    icp_sal_dc_chain_request_t requests[ICP_SAL_DC_CHAIN_MAX_BATCH];
+    Cpa32U numSubmitted = 0;
+    Cpa32U numRequests = 0;
+    Cpa32U listNum = 0;
+    Cpa64U inflight = 0;
+    Cpa32U i = 0;
+
+    while (listNum < setup->numLists && CPA_STATUS_SUCCESS == status)
+    {
+        inflight = stats->submissions - stats->responses;
+        if (inflight >= setup->chainDepth)
+        {
+            if (poll_inline_g && pInstanceInfo2->isPolled)
+            {
+                qatDcPollAndSetNextPollCounter(setup);
+            }
+            else
+            {
+                AVOID_SOFTLOCKUP;
+            }
+            continue;
+        }
+
+        numRequests = setup->chainDepth - (Cpa32U)inflight;
+        if (numRequests > setup->numLists - listNum)
+        {
+            numRequests = setup->numLists - listNum;
+        }
+        for (i = 0; i < numRequests; i++)
+        {
+            requests[i].pSrcBuff = &arrayOfSrcBufferLists[listNum + i];
+            requests[i].pDestBuff = &arrayOfDestBufferLists[listNum + i];
+            requests[i].pChainOpData =
+                &arrayOfChainOpData[(listNum + i) * setup->numSessions];
+            requests[i].pResults = &arrayOfResults[listNum + i];
+            requests[i].callbackTag = (void *)setup;
+            qatStartLatencyMeasurement(stats, stats->submissions + i);
+        }
+
+        qatOpenLoopPace(stats);
+        coo_req_start(stats);
+        status = icp_sal_DcChainPerformOpBatch(setup->dcInstanceHandle,
+                                               pSessionHandle,
+                                               setup->chainOperation,
+                                               setup->numSessions,
+                                               requests,
+                                               numRequests,
+                                               &numSubmitted);
+        coo_req_stop(stats, status);
+        if (CPA_STATUS_RETRY == status)
+        {
+            qatDcRetryHandler(setup, pInstanceInfo2);
+            AVOID_SOFTLOCKUP;
+            status = CPA_STATUS_SUCCESS;
+            continue;
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("icp_sal_DcChainPerformOpBatch returned %d\n", status);
+            break;
+        }
+
+        stats->submissions += numSubmitted;
+        for (i = 0; i < numSubmitted && CPA_STATUS_SUCCESS == status; i++)
+        {
+            status = qatDcChainE2EVerify(setup,
+                                         &arrayOfSrcBufferLists[listNum + i],
+                                         &arrayOfDestBufferLists[listNum + i],
+                                         &arrayOfResults[listNum + i]);
+        }
+        listNum += numSubmitted;
+    }
+
+    return status;
+}
+
 /* chaining performance measurement function to compress a file for 'n' number
  * of loops
  * */
@@ -391,8 +482,25 @@ CpaStatus qatDcChainCompressData(compression_test_params_t *setup,
         /*loop over compressing a file numLoop times*/
         for (numLoops = 0; numLoops < setup->numLoops; numLoops++)
         {
-            /*loop over lists that store the file*/
-            for (listNum = 0; listNum < setup->numLists; listNum++)
+            if (0 != setup->chainDepth)
+            {
+                checkStopTestExitFlag(setup->performanceStats,
+                                      &setup->numLoops,
+                                      &setup->numLists,
+                                      numLoops);
+                status = qatDcChainSubmitWindow(setup,
+                                                &instanceInfo2,
+                                                pSessionHandle,
+                                                arrayOfSrcBufferLists,
+                                                arrayOfDestBufferLists,
+                                                arrayOfResults,
+                                                arrayOfChainOpData);
+            }
+            /*loop over lists that store the file, unless they were submitted
+             * with a bounded window above*/
+            for (listNum = 0;
+                 0 == setup->chainDepth && listNum < setup->numLists;
+                 listNum++)
             {
                 /*exit loop mechanism to leave early if numLoops is large
                  * note that this might not work if the we get stuck in the
@@ -1255,6 +1363,7 @@ void dcChainPerformance(single_thread_test_data_t *testSetup)
     dcSetup.appendCRC = tmpSetup->appendCRC;
     dcSetup.testIntegrity = tmpSetup->testIntegrity;
     dcSetup.keyDerive = tmpSetup->keyDerive;
+    dcSetup.chainDepth = tmpSetup->chainDepth;
 
     status = calculateRequireBuffers(&dcSetup);
     if (CPA_STATUS_SUCCESS != status)
@@ -1622,6 +1731,7 @@ CpaStatus setupDcChainTest(CpaDcChainOperations chainOperation,
     dcSetup->syncFlag = syncFlag;
     dcSetup->numLoops = numLoops;
     dcSetup->isDpApi = CPA_FALSE;
+    dcSetup->chainDepth = (ASYNC == syncFlag) ? dcChainDepth_g : 0;
 
     dcSetup->setupData.autoSelectBestHuffmanTree = gAutoSelectBestMode;
     dcSetup->setupData.checksum = gChecksum;
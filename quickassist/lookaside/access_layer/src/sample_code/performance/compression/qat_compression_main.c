@@ -71,6 +71,7 @@
 #include "busy_loop.h"
 #include "icp_sal_user.h"
 #include "qat_perf_utils.h"
+#include "qat_perf_openloop.h"
 
 extern void dcPerformCallback(void *pCallbackTag, CpaStatus status);
 
@@ -304,6 +305,8 @@ static CpaStatus setupDcCommonTest(compression_test_params_t *dcSetup,
      * tests, set it accordingly.
      */
     dcSetup->setNsRequest = isNsRequest_g;
+    dcSetup->setNsPrepared =
+        (isNsRequest_g && isNsPrepared_g) ? CPA_TRUE : CPA_FALSE;
     if (direction == CPA_DC_DIR_COMPRESS)
     {
         dcSetup->useE2E = dataIntegrity_g;
@@ -382,6 +385,7 @@ void dcPerformance(single_thread_test_data_t *testSetup)
     dcSetup.numLoops = tmpSetup->numLoops;
     dcSetup.setupData.checksum = tmpSetup->setupData.checksum;
     dcSetup.setNsRequest = tmpSetup->setNsRequest;
+    dcSetup.setNsPrepared = tmpSetup->setNsPrepared;
     dcSetup.useE2E = tmpSetup->useE2E;
     dcSetup.useE2EVerify = tmpSetup->useE2EVerify;
 
@@ -621,6 +625,43 @@ err:
 }
 EXPORT_SYMBOL(dcPerformance);
 
+/*prepares the NS setup of the test once in each direction, so that
+ * qatDcSubmitRequest can submit through icp_sal_DcNs*DataPrepared*/
+static CpaStatus qatDcNsPrepare(compression_test_params_t *setup)
+{
+    CpaDcNsSetupData nsSetupData = setup->setupData;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    nsSetupData.sessDirection = CPA_DC_DIR_COMPRESS;
+    status = icp_sal_DcNsPrepare(
+        setup->dcInstanceHandle, &nsSetupData, &setup->nsCompPrepared);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        nsSetupData.sessDirection = CPA_DC_DIR_DECOMPRESS;
+        status = icp_sal_DcNsPrepare(
+            setup->dcInstanceHandle, &nsSetupData, &setup->nsDecompPrepared);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("icp_sal_DcNsPrepare returned status %d\n", status);
+    }
+    return status;
+}
+
+static void qatDcNsFreePrepared(compression_test_params_t *setup)
+{
+    if (NULL != setup->nsCompPrepared)
+    {
+        icp_sal_DcNsFreePrepared(setup->nsCompPrepared);
+        setup->nsCompPrepared = NULL;
+    }
+    if (NULL != setup->nsDecompPrepared)
+    {
+        icp_sal_DcNsFreePrepared(setup->nsDecompPrepared);
+        setup->nsDecompPrepared = NULL;
+    }
+}
+
 /*allocates buffers store a file for compression. The buffers are sent to
  * hardware, performance is recorded and stored in the setup parameter
  * the sample code framework prints out results after the thread completes*/
@@ -713,6 +754,13 @@ CpaStatus qatDcPerform(compression_test_params_t *setup)
             }
         }
     }
+    else if (CPA_TRUE == setup->setNsPrepared &&
+             CPA_STATUS_SUCCESS == status)
+    {
+        /* Decompression tests compress their input first, so prepare
+         * both directions */
+        status = qatDcNsPrepare(setup);
+    }
 /*CNV Error Injection*/
     /* compress the data */
     if (CPA_STATUS_SUCCESS == status)
@@ -977,6 +1025,7 @@ CpaStatus qatDcPerform(compression_test_params_t *setup)
             }
         }
     }
+    qatDcNsFreePrepared(setup);
     /*free CpaFlatBuffers and privateMetaData in CpaBufferLists*/
     if ((CPA_STATUS_SUCCESS !=
          qatFreeCompressionFlatBuffers(setup,
@@ -1025,6 +1074,7 @@ CpaStatus qatDcSubmitRequest(compression_test_params_t *setup,
         setup->requestOps.flushFlag = setup->flushFlag;
     }
 
+    qatOpenLoopPace(setup->performanceStats);
     do
     {
         /*To use reliability code, I set CpaBoolean reliability_g = CPA_TRUE
@@ -1045,15 +1095,29 @@ CpaStatus qatDcSubmitRequest(compression_test_params_t *setup,
                         dcCbFn = dcPerformCallback;
                     }
 
-                    status =
-                        cpaDcNsCompressData(setup->dcInstanceHandle,
-                                            &(setup->setupData),
-                                            &arrayOfSrcBufferLists[listNum],
-                                            &arrayOfDestBufferLists[listNum],
-                                            &(setup->requestOps),
-                                            &arrayOfResults[listNum],
-                                            dcCbFn,
-                                            (void *)setup);
+                    if (CPA_TRUE == setup->setNsPrepared)
+                    {
+                        status = icp_sal_DcNsCompressDataPrepared(
+                            setup->nsCompPrepared,
+                            &arrayOfSrcBufferLists[listNum],
+                            &arrayOfDestBufferLists[listNum],
+                            &(setup->requestOps),
+                            &arrayOfResults[listNum],
+                            dcCbFn,
+                            (void *)setup);
+                    }
+                    else
+                    {
+                        status = cpaDcNsCompressData(
+                            setup->dcInstanceHandle,
+                            &(setup->setupData),
+                            &arrayOfSrcBufferLists[listNum],
+                            &arrayOfDestBufferLists[listNum],
+                            &(setup->requestOps),
+                            &arrayOfResults[listNum],
+                            dcCbFn,
+                            (void *)setup);
+                    }
                 }
                 else
                 {
@@ -1085,14 +1149,29 @@ CpaStatus qatDcSubmitRequest(compression_test_params_t *setup,
                     dcCbFn = dcPerformCallback;
                 }
 
-                status = cpaDcNsDecompressData(setup->dcInstanceHandle,
-                                               &(setup->setupData),
-                                               &arrayOfDestBufferLists[listNum],
-                                               &arrayOfCmpBufferLists[listNum],
-                                               &(setup->requestOps),
-                                               &arrayOfResults[listNum],
-                                               dcCbFn,
-                                               (void *)setup);
+                if (CPA_TRUE == setup->setNsPrepared)
+                {
+                    status = icp_sal_DcNsDecompressDataPrepared(
+                        setup->nsDecompPrepared,
+                        &arrayOfDestBufferLists[listNum],
+                        &arrayOfCmpBufferLists[listNum],
+                        &(setup->requestOps),
+                        &arrayOfResults[listNum],
+                        dcCbFn,
+                        (void *)setup);
+                }
+                else
+                {
+                    status = cpaDcNsDecompressData(
+                        setup->dcInstanceHandle,
+                        &(setup->setupData),
+                        &arrayOfDestBufferLists[listNum],
+                        &arrayOfCmpBufferLists[listNum],
+                        &(setup->requestOps),
+                        &arrayOfResults[listNum],
+                        dcCbFn,
+                        (void *)setup);
+                }
             }
             else
             {
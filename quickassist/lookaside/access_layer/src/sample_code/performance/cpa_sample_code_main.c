@@ -85,6 +85,14 @@
 #include "qat_compression_main.h"
 #endif
 #include "cpa_sample_code_sym_perf_dp.h"
+#include "cpa_sample_code_drbg_perf.h"
+#include "qat_perf_histogram.h"
+#include "qat_perf_openloop.h"
+#include "qat_perf_poll_engine.h"
+#include "qat_perf_results.h"
+#ifdef USER_SPACE
+#include "icp_sal_trace.h"
+#endif
 
 #ifndef INCLUDE_COMPRESSION
 /*define this just so that sample code will build without compression code*/
@@ -162,7 +170,20 @@ option_t optArray[MAX_NUMOPT] = {
     {"getOffloadCost", 0},
     {"includeLZ4", DEFAULT_INCLUDE_LZ4},
     {"compOnly", 0},
-    {"verboseOutput", 1}};
+    {"verboseOutput", 1},
+    {"latencyHistDump", 0},
+    {"offeredLoad", 0},
+    {"offeredLoadSteps", 1},
+    {"offeredLoadPoisson", 0},
+    {"resultsDump", 0},
+    {"pollEngine", 0},
+    {"sessionSetupRate", 0},
+    {"traceEntries", 0},
+    {"ecdsaPreparedKey", 0},
+    {"rsaKeyGen", 0},
+    {"dcNsPrepared", 0},
+    {"dcChainDepth", 0},
+    {"tls3ScheduleRate", 0}};
 
 #define SIGN_OF_LIFE_OPT_ARRAY_POS (0)
 #define RUN_TEST_OPT_ARRAY_POS (1)
@@ -177,6 +198,22 @@ option_t optArray[MAX_NUMOPT] = {
 #define GET_LATENCY_POS (10)
 #define GET_OFFLOAD_COST_POS (11)
 #define RUN_LZ4_TEST_POS (12)
+#define LATENCY_HIST_DUMP_POS (15)
+#define OFFERED_LOAD_POS (16)
+#define OFFERED_LOAD_STEPS_POS (17)
+#define OFFERED_LOAD_POISSON_POS (18)
+#define RESULTS_DUMP_POS (19)
+#define POLL_ENGINE_POS (20)
+#define SESSION_SETUP_RATE_POS (21)
+#define TRACE_ENTRIES_POS (22)
+#define ECDSA_PREPARED_KEY_POS (23)
+#define RSA_KEYGEN_POS (24)
+#define DC_NS_PREPARED_POS (25)
+#define DC_CHAIN_DEPTH_POS (26)
+#define TLS3_SCHEDULE_RATE_POS (27)
+
+/* File written when traceEntries is set */
+#define SAMPLE_CODE_TRACE_FILE "cpa_sample_code_trace.bin"
 
 #else /* #ifdef USER_SPACE */
 
@@ -292,6 +329,7 @@ CpaStatus checkSingleInstance()
 #define DH_CODE (16)
 #define COMPRESSION_CODE (32)
 #define CHAINING_CODE (128)
+#define DRBG_CODE (4096)
 #if CY_API_VERSION_AT_LEAST(3, 0)
 #define SMx_CODE (2048)
 #ifdef SC_KPT2_ENABLED
@@ -310,6 +348,11 @@ CpaStatus checkSingleInstance()
 #define NUMBER_SIMILTANEOUS_THREADS (16)
 #define NUMBER_OF_CORES_TO_USE (8)
 
+/***************************************************************************
+ * number of DRBG sessions per thread for the DRBG test
+ **************************************************************************/
+#define DRBG_NUM_SESSIONS (4)
+
 #define KASUMI_40_BYTE_BUFFER (40)
 
 /*add for SM2*/
@@ -340,6 +383,8 @@ int main(int argc, char *argv[])
 #ifdef USER_SPACE
 #ifdef SC_CHAINING_ENABLED
     Cpa32U prevCnVRequestFlag = 0;
+    Cpa32U chainDepth = 0;
+    int prevLatencyEnable = 0;
 #endif
 #endif
     CpaInstanceInfo2 *info = NULL;
@@ -424,6 +469,50 @@ int main(int argc, char *argv[])
     }
 
     enableLatencyMeasurements(computeLatency != 0 ? 1 : 0);
+    if (CPA_STATUS_SUCCESS !=
+        setLatencyHistogramDump(optArray[LATENCY_HIST_DUMP_POS].optValue))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    if (optArray[OFFERED_LOAD_POS].optValue < 0 ||
+        optArray[OFFERED_LOAD_STEPS_POS].optValue < 0 ||
+        CPA_STATUS_SUCCESS !=
+            setOfferedLoad(optArray[OFFERED_LOAD_POS].optValue,
+                           optArray[OFFERED_LOAD_STEPS_POS].optValue,
+                           optArray[OFFERED_LOAD_POISSON_POS].optValue != 0
+                               ? QAT_PERF_OPENLOOP_POISSON
+                               : QAT_PERF_OPENLOOP_CONSTANT))
+    {
+        PRINT_ERR("Invalid offeredLoad parameters\n");
+        return CPA_STATUS_FAIL;
+    }
+    if (CPA_STATUS_SUCCESS !=
+        setPerfResultsDump(optArray[RESULTS_DUMP_POS].optValue))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    if (CPA_STATUS_SUCCESS !=
+        setPollEngine(optArray[POLL_ENGINE_POS].optValue))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    if (optArray[TRACE_ENTRIES_POS].optValue < 0 ||
+        (optArray[TRACE_ENTRIES_POS].optValue > 0 &&
+         CPA_STATUS_SUCCESS !=
+             icp_sal_TraceEnable(optArray[TRACE_ENTRIES_POS].optValue)))
+    {
+        PRINT_ERR("Invalid traceEntries parameter\n");
+        return CPA_STATUS_FAIL;
+    }
+#ifdef SC_CHAINING_ENABLED
+    if (optArray[DC_CHAIN_DEPTH_POS].optValue < 0 ||
+        optArray[DC_CHAIN_DEPTH_POS].optValue > DC_CHAIN_MAX_DEPTH)
+    {
+        PRINT_ERR("Invalid dcChainDepth parameter, maximum is %d\n",
+                  DC_CHAIN_MAX_DEPTH);
+        return CPA_STATUS_FAIL;
+    }
+#endif
 
     if (computeOffloadCost != 0)
     {
@@ -561,7 +650,7 @@ int main(int argc, char *argv[])
         }
         qaeMemFree((void **)&info);
 
-        if (runTests & SYMMETRIC_CODE)
+        if (runTests & (SYMMETRIC_CODE | DRBG_CODE))
         {
             status = getCryptoInstanceCapabilities(&symCap, SYM);
         }
@@ -585,6 +674,13 @@ int main(int argc, char *argv[])
             runTests ^= 1 << 0;
             PRINT("runTests=%d\n", runTests);
         }
+        if (symCap.drbgSupported == CPA_FALSE && runTests & DRBG_CODE)
+        {
+            PRINT("Warning! Skipping DRBG tests as they are not supported on "
+                  "Instance\n");
+            runTests ^= DRBG_CODE;
+            PRINT("runTests=%d\n", runTests);
+        }
 
         if (asymCap.rsaSupported == CPA_FALSE && runTests & RSA_CODE)
         {
@@ -798,6 +894,26 @@ int main(int argc, char *argv[])
      **************************************************************************/
     if ((SYMMETRIC_CODE & runTests) == SYMMETRIC_CODE)
     {
+#ifdef USER_SPACE
+        if (optArray[SESSION_SETUP_RATE_POS].optValue > 0)
+        {
+            status = symSessionSetupRateTest(
+                optArray[SESSION_SETUP_RATE_POS].optValue);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                retStatus = CPA_STATUS_FAIL;
+            }
+        }
+        if (optArray[TLS3_SCHEDULE_RATE_POS].optValue > 0)
+        {
+            status = tls3ScheduleRateTest(
+                optArray[TLS3_SCHEDULE_RATE_POS].optValue);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                retStatus = CPA_STATUS_FAIL;
+            }
+        }
+#endif
         /*AES128-CBC TEST*/
         for (lv_count = 0; lv_count < numPacketSizes; lv_count++)
         {
@@ -1216,6 +1332,29 @@ int main(int argc, char *argv[])
                 retStatus = CPA_STATUS_FAIL;
             }
         }
+#ifdef USER_SPACE
+        if (optArray[RSA_KEYGEN_POS].optValue)
+        {
+            /* generate keys without, then with the host prime sieve */
+            for (lv_count = 0; lv_count < 2; lv_count++)
+            {
+                status = setupRsaKeyGenTest(MODULUS_2048_BIT,
+                                            (lv_count) ? CPA_TRUE : CPA_FALSE,
+                                            optArray[RSA_KEYGEN_POS].optValue);
+                if (CPA_STATUS_SUCCESS != status)
+                {
+                    PRINT_ERR("Error calling setupRsaKeyGenTest\n");
+                    return CPA_STATUS_FAIL;
+                }
+                testsExecuted++;
+                status = createStartandWaitForCompletionCrypto(ASYM);
+                if (CPA_STATUS_SUCCESS != status)
+                {
+                    retStatus = CPA_STATUS_FAIL;
+                }
+            }
+        }
+#endif
     }
 #if CY_API_VERSION_AT_LEAST(3, 0)
 #ifdef USER_SPACE
@@ -1322,6 +1461,43 @@ int main(int argc, char *argv[])
     }
 #endif /*DO_CRYPTO*/
 
+#ifdef DO_CRYPTO
+    /***************************************************************************
+     * DRBG PERFORMANCE
+     **************************************************************************/
+    if (((DRBG_CODE & runTests) == DRBG_CODE) && (computeLatency == 0))
+    {
+        for (lv_count = 0; lv_count < numPacketSizes; lv_count++)
+        {
+            /* A DRBG request has a single length */
+            if (PACKET_IMIX == packetSizes[lv_count])
+            {
+                continue;
+            }
+            status = setupDrbgTest(CPA_TRUE,
+                                   CPA_CY_RBG_SEC_STRENGTH_256,
+                                   CPA_FALSE,
+                                   packetSizes[lv_count],
+                                   DRBG_NUM_SESSIONS,
+                                   cySymLoops);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                PRINT_ERR("Error calling setupDrbgTest\n");
+                return CPA_STATUS_FAIL;
+            }
+            else
+            {
+                testsExecuted++;
+            }
+            status = createStartandWaitForCompletionCrypto(SYM);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                retStatus = CPA_STATUS_FAIL;
+            }
+        }
+    }
+#endif /*DO_CRYPTO*/
+
 #ifdef DO_CRYPTO
 
     /***************************************************************************
@@ -1377,6 +1553,45 @@ int main(int argc, char *argv[])
         {
             retStatus = CPA_STATUS_FAIL;
         }
+#ifdef USER_SPACE
+        if (optArray[ECDSA_PREPARED_KEY_POS].optValue)
+        {
+            /* sign with cpaCyEcdsaSignRS, then with a prepared key */
+            status = setupEcdsaTest(GFP_P384_SIZE_IN_BITS,
+                                    CPA_CY_EC_FIELD_TYPE_PRIME,
+                                    ASYNC,
+                                    ECDSA_STEP_SIGNRS,
+                                    cyNumBuffers,
+                                    cyAsymLoops);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                PRINT_ERR("Error calling setupEcdsaTest\n");
+                return CPA_STATUS_FAIL;
+            }
+            testsExecuted++;
+            status = createStartandWaitForCompletionCrypto(ASYM);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                retStatus = CPA_STATUS_FAIL;
+            }
+            status = setupEcdsaPreparedKeyTest(GFP_P384_SIZE_IN_BITS,
+                                               CPA_CY_EC_FIELD_TYPE_PRIME,
+                                               ASYNC,
+                                               cyNumBuffers,
+                                               cyAsymLoops);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                PRINT_ERR("Error calling setupEcdsaPreparedKeyTest\n");
+                return CPA_STATUS_FAIL;
+            }
+            testsExecuted++;
+            status = createStartandWaitForCompletionCrypto(ASYM);
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                retStatus = CPA_STATUS_FAIL;
+            }
+        }
+#endif
     }
 #endif /*DO_CRYPTO*/
 
@@ -1708,6 +1923,43 @@ int main(int argc, char *argv[])
             }
             useAccelCompression();
 
+#ifdef USER_SPACE
+            if (optArray[DC_NS_PREPARED_POS].optValue)
+            {
+                /* small requests with a session, without one, and without
+                 * one but with the setup prepared once per thread */
+                for (lv_count = 0; lv_count < 3; lv_count++)
+                {
+                    setDcNsFlag((lv_count > 0) ? CPA_TRUE : CPA_FALSE);
+                    setDcNsPreparedFlag((lv_count > 1) ? CPA_TRUE
+                                                       : CPA_FALSE);
+                    status = setupDcTest(CPA_DC_DEFLATE,
+                                         CPA_DC_DIR_COMPRESS,
+                                         SAMPLE_CODE_CPA_DC_L1,
+                                         CPA_DC_HT_STATIC,
+                                         CPA_DC_STATELESS,
+                                         DEFAULT_COMPRESSION_WINDOW_SIZE,
+                                         BUFFER_SIZE_1024,
+                                         sampleCorpus,
+                                         ASYNC,
+                                         dcLoops);
+                    setDcNsFlag(CPA_FALSE);
+                    setDcNsPreparedFlag(CPA_FALSE);
+                    if (CPA_STATUS_SUCCESS != status)
+                    {
+                        PRINT_ERR("Error calling setupDcTest\n");
+                        return CPA_STATUS_FAIL;
+                    }
+                    testsExecuted++;
+                    status = createStartandWaitForCompletion(COMPRESSION);
+                    if (CPA_STATUS_SUCCESS != status)
+                    {
+                        retStatus = CPA_STATUS_FAIL;
+                    }
+                }
+            }
+#endif
+
             if (runStateful && dynamicEnabled)
             {
                 /*STATEFUL COMPRESSION TEST*/
@@ -2476,6 +2728,67 @@ int main(int argc, char *argv[])
                 retStatus = CPA_STATUS_FAIL;
             }
 
+            /* sha256 + stateless static compress chaining with a bounded
+             * number of requests in flight, doubling up to dcChainDepth.
+             * Latency is recorded at every depth so that the percentiles
+             * are reported next to the operations per second */
+            chainDepth = optArray[DC_CHAIN_DEPTH_POS].optValue;
+            prevLatencyEnable = isLatencyEnabled();
+            if (0 != chainDepth && 0 == prevLatencyEnable)
+            {
+                enableLatencyMeasurements(1);
+            }
+            for (lv_count = 1; lv_count <= chainDepth; lv_count *= 2)
+            {
+                /* Always finish on the requested depth itself */
+                if ((lv_count * 2) > chainDepth)
+                {
+                    lv_count = chainDepth;
+                }
+                status = setDcChainDepth(lv_count);
+                if (CPA_STATUS_SUCCESS == status)
+                {
+                    status = setupDcChainTest(
+                        CPA_DC_CHAIN_HASH_THEN_COMPRESS,
+                        2,
+                        CPA_DC_DEFLATE,
+                        CPA_DC_DIR_COMPRESS,
+                        SAMPLE_CODE_CPA_DC_L1,
+                        CPA_DC_HT_STATIC,
+                        CPA_DC_STATELESS,
+                        DEFAULT_COMPRESSION_WINDOW_SIZE,
+                        dcBufferSize,
+                        sampleCorpus,
+                        ASYNC,
+                        CPA_CY_SYM_OP_HASH,
+                        CPA_CY_SYM_CIPHER_NULL,
+                        0,
+                        CPA_CY_SYM_CIPHER_DIRECTION_ENCRYPT,
+                        CPA_CY_PRIORITY_NORMAL,
+                        CPA_CY_SYM_HASH_SHA256,
+                        CPA_CY_SYM_HASH_MODE_PLAIN,
+                        SHA256_DIGEST_LENGTH_IN_BYTES,
+                        dcLoops);
+                }
+                setDcChainDepth(0);
+                if (CPA_STATUS_SUCCESS != status)
+                {
+                    PRINT_ERR("Error calling setupDcChainTest\n");
+                    enableLatencyMeasurements(prevLatencyEnable);
+                    return CPA_STATUS_FAIL;
+                }
+                testsExecuted++;
+                status = createStartandWaitForCompletion(COMPRESSION);
+                if (CPA_STATUS_SUCCESS != status)
+                {
+                    retStatus = CPA_STATUS_FAIL;
+                }
+            }
+            if (0 != chainDepth && 0 == prevLatencyEnable)
+            {
+                enableLatencyMeasurements(0);
+            }
+
             setSetupCnVRequestFlag(prevCnVRequestFlag);
             useAccelCompression();
         }
@@ -2485,6 +2798,19 @@ int main(int argc, char *argv[])
 
 #endif
 #ifdef USER_SPACE
+    if (optArray[TRACE_ENTRIES_POS].optValue > 0)
+    {
+        icp_sal_TraceDisable();
+        if (CPA_STATUS_SUCCESS != icp_sal_TraceDump(SAMPLE_CODE_TRACE_FILE))
+        {
+            PRINT_ERR("Could not write %s\n", SAMPLE_CODE_TRACE_FILE);
+            retStatus = CPA_STATUS_FAIL;
+        }
+        else
+        {
+            PRINT("Request trace written to %s\n", SAMPLE_CODE_TRACE_FILE);
+        }
+    }
     if (CPA_STATUS_SUCCESS != icp_sal_userStop())
     {
         PRINT_ERR("Could not stop sal for user space\n");
@@ -77,11 +77,15 @@
 #include "cpa_cy_prime.h"
 #include "cpa_cy_sym.h"
 #include "icp_sal_poll.h"
+#include "icp_sal_prime_sieve.h"
 
 #define POLL_AND_SLEEP 1
 
 #include "qat_perf_cycles.h"
 #include "qat_perf_buffer_utils.h"
+#include "qat_perf_openloop.h"
+#include "qat_perf_poll_engine.h"
+#include "qat_perf_results.h"
 
 #ifdef USER_SPACE
 Cpa32U poll_type_g = 0;
@@ -800,6 +804,7 @@ CpaStatus printAsymStatsAndStopServices(thread_creation_data_t *data)
     {
         PRINT("CPU Frequency(kHz)    %u\n", sampleCodeGetCpuFreq());
         PRINT("Operations per second %8u\n", opsPerSec);
+        qatPerfResultsSetOpsPerSec(opsPerSec);
         if (iaCycleCount_g)
         {
             do_div(stats.offloadCycles, data->numberOfThreads);
@@ -939,6 +944,12 @@ static void sampleCodePoll(CpaInstanceHandle instanceHandle_in)
     sampleCodeThreadExit();
 }
 
+static void sampleCodeCyEnginePoll(CpaInstanceHandle instanceHandle_in)
+{
+    qatPerfPollEngineRun(instanceHandle_in, &cy_service_started_g);
+    sampleCodeThreadExit();
+}
+
 /*start crypto acceleration service if its not already started*/
 CpaStatus startCyServices(void)
 {
@@ -1922,6 +1933,108 @@ static void generatePrimeCandidates(CpaFlatBuffer *primeCandidate,
         qaeMemFreeNUMA((void **)&primeCandidates);                             \
     } while (0)
 
+/*****************************************************************************
+ * generates a prime with icp_sal_CyPrimeSearch, which tests a run of
+ * consecutive odd numbers with several requests in flight and, if
+ * setup->usePrimeSieve is set, drops the ones with a small factor on the host
+ *****************************************************************************/
+static CpaStatus generatePrimeSearch(CpaFlatBuffer *primeCandidate,
+                                     CpaInstanceHandle cyInstanceHandle,
+                                     asym_test_params_t *setup)
+{
+    Cpa32U i = 0;
+    Cpa32U attempt = 0;
+    Cpa32U node = 0;
+    Cpa32U lenInBytes = primeCandidate->dataLenInBytes;
+    Cpa32U millerRabinDataLen = lenInBytes;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaFlatBuffer startCandidate = {0};
+    Cpa8U *pMillerRabinData = NULL;
+    icp_sal_prime_search_op_data_t opData = {0};
+    icp_sal_prime_search_results_t results = {0};
+
+    MR_PRIME_LEN(millerRabinDataLen);
+    status = sampleCodeCyGetNode(cyInstanceHandle, &node);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("sampleCodeCyGetNode failed with status %u\n", status);
+        return CPA_STATUS_FAIL;
+    }
+    status = bufferDataMemAlloc(
+        cyInstanceHandle, &startCandidate, lenInBytes, NULL, 0);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Could not allocate buffer\n");
+        return CPA_STATUS_FAIL;
+    }
+    pMillerRabinData = qaeMemAllocNUMA(
+        millerRabinDataLen * NB_MR_ROUNDS, node, BYTE_ALIGNMENT_64);
+    if (NULL == pMillerRabinData)
+    {
+        PRINT_ERR("Could not allocate memory for pMillerRabinData\n");
+        qaeMemFreeNUMA((void **)&startCandidate.pData);
+        return CPA_STATUS_FAIL;
+    }
+
+    opData.startCandidate = startCandidate;
+    opData.useSieve = setup->usePrimeSieve;
+    opData.maxCandidates = NUM_PRIME_SEARCH_CANDIDATES;
+    opData.performGcdTest = CPA_TRUE;
+    opData.performFermatTest = CPA_TRUE;
+    opData.numMillerRabinRounds = NB_MR_ROUNDS;
+    opData.millerRabinRandomInput.pData = pMillerRabinData;
+    opData.millerRabinRandomInput.dataLenInBytes =
+        millerRabinDataLen * NB_MR_ROUNDS;
+    opData.performLucasTest = CPA_TRUE;
+
+    for (attempt = 0; attempt < NUM_PRIME_GENERATION_RETRY_ATTEMPTS; attempt++)
+    {
+        /*random odd start with the MSB set*/
+        generateRandomData(startCandidate.pData, lenInBytes);
+        setCpaFlatBufferMSB(&startCandidate);
+        startCandidate.pData[lenInBytes - 1] |= 1;
+
+        /*every candidate is above the start, so Miller Rabin numbers in
+         * (1, start - 1) suit all of them*/
+        generateRandomData(pMillerRabinData,
+                           millerRabinDataLen * NB_MR_ROUNDS);
+        for (i = 0; i < NB_MR_ROUNDS; i++)
+        {
+            /*make sure the number is greater than 1*/
+            pMillerRabinData[(i + 1) * millerRabinDataLen - 1] |= INC_BY_TWO;
+        }
+        startCandidate.pData[lenInBytes - 1] &= ~1;
+        conformMillerRabinData(
+            &opData.millerRabinRandomInput, &startCandidate, NB_MR_ROUNDS);
+        startCandidate.pData[lenInBytes - 1] |= 1;
+
+        do
+        {
+            status = icp_sal_CyPrimeSearch(
+                cyInstanceHandle, &opData, primeCandidate, &results);
+            AVOID_SOFTLOCKUP;
+        } while (CPA_STATUS_RETRY == status);
+        if (CPA_STATUS_SUCCESS != status || CPA_TRUE == results.found)
+        {
+            break;
+        }
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT("Error Generating Prime\n");
+        status = CPA_STATUS_FAIL;
+    }
+    else if (CPA_FALSE == results.found)
+    {
+        PRINT_ERR("\nPRIME NUMBER NOT FOUND\n");
+        status = CPA_STATUS_FAIL;
+    }
+
+    qaeMemFreeNUMA((void **)&pMillerRabinData);
+    qaeMemFreeNUMA((void **)&startCandidate.pData);
+    return status;
+}
+
 CpaStatus generatePrime(CpaFlatBuffer *primeCandidate,
                         CpaInstanceHandle cyInstanceHandle,
                         asym_test_params_t *setup)
@@ -1948,6 +2061,10 @@ CpaStatus generatePrime(CpaFlatBuffer *primeCandidate,
     CpaInstanceInfo2 *instanceInfo2 = NULL;
     CpaBoolean isPolled = CPA_FALSE;
 #endif
+    if (CPA_TRUE == setup->rsaKeyGen)
+    {
+        return generatePrimeSearch(primeCandidate, cyInstanceHandle, setup);
+    }
     millerRabinDataLen = primeCandidate->dataLenInBytes;
     /* The QA API has a a limit on the minimum size( 64 bytes) of the buffer
      * used to contain the Miller Rabin Round data.
@@ -2838,6 +2955,7 @@ void processCallback(void *pCallbackTag)
     }
     /* response has been received */
     pPerfData->responses++;
+    qatOpenLoopResponse(pPerfData);
     if (latency_enable && pPerfData->response_times != NULL)
     {
         /* Have we sampled too many buffer operations? */
@@ -3025,6 +3143,11 @@ CpaStatus cyCreatePollingThreadsIfPollingIsEnabled(void)
             if (CPA_TRUE == instanceInfo2[i].isPolled)
             {
                 numPolledInstances_g++;
+                if (CPA_TRUE == isPollEngineEnabled())
+                {
+                    pollFnArr[i] = sampleCodeCyEnginePoll;
+                    continue;
+                }
 #if defined(USER_SPACE) && !defined(SC_EPOLL_DISABLED)
                 status = icp_sal_CyGetFileDescriptor(cyInstances_g[i], &fd);
                 if (CPA_STATUS_SUCCESS == status)
@@ -3519,6 +3642,43 @@ void printSymTestType(symmetric_test_params_t *setup)
 
 }
 
+/* Identify the test in the structured results, see qat_perf_results.h */
+static void recordSymTestConfig(symmetric_test_params_t *setup)
+{
+    CpaCySymSessionSetupData *pSetupData = &setup->setupData;
+
+    if (CPA_CY_SYM_OP_CIPHER == pSetupData->symOperation)
+    {
+        qatPerfResultsSetService("cipher");
+    }
+    else if (CPA_CY_SYM_OP_HASH == pSetupData->symOperation)
+    {
+        qatPerfResultsSetService("hash");
+    }
+    else
+    {
+        qatPerfResultsSetService("alg_chain");
+    }
+    if (CPA_CY_SYM_OP_HASH != pSetupData->symOperation)
+    {
+        qatPerfResultsAddConfig("cipherAlg",
+                                pSetupData->cipherSetupData.cipherAlgorithm);
+        qatPerfResultsAddConfig(
+            "cipherKeyLen", pSetupData->cipherSetupData.cipherKeyLenInBytes);
+        qatPerfResultsAddConfig("direction",
+                                pSetupData->cipherSetupData.cipherDirection);
+    }
+    if (CPA_CY_SYM_OP_CIPHER != pSetupData->symOperation)
+    {
+        qatPerfResultsAddConfig("hashAlg",
+                                pSetupData->hashSetupData.hashAlgorithm);
+        qatPerfResultsAddConfig("hashMode", pSetupData->hashSetupData.hashMode);
+        qatPerfResultsAddConfig(
+            "digestLen", pSetupData->hashSetupData.digestResultLenInBytes);
+    }
+    qatPerfResultsAddConfig("dpApi", setup->isDpApi);
+}
+
 static void accumulateSymPerfData(Cpa32U numberOfThreads,
                                   perf_data_t *performanceStats[],
                                   perf_data_t *stats,
@@ -3751,6 +3911,7 @@ CpaStatus printSymmetricPerfDataAndStopCyService(thread_creation_data_t *data)
     }
 
     printSymTestType(setup);
+    recordSymTestConfig(setup);
     if (data->packetSize == PACKET_IMIX)
     {
         PRINT("Packet Mix\
@@ -3782,6 +3943,7 @@ CpaStatus printSymmetricPerfDataAndStopCyService(thread_creation_data_t *data)
         else
         {
             PRINT("Throughput(Mbps)      %u\n", throughput);
+            qatPerfResultsSetThroughput(throughput);
         }
 
 
@@ -642,6 +642,8 @@ CpaStatus setCyPollInterval(Cpa32U interval);
 #define NB_MR_ROUNDS (2)
 #define NUM_PRIME_GENERATION_RETRY_ATTEMPTS (1000)
 #define NUM_PRIME_GENERATION_ATTEMPTS (100)
+/*odd numbers examined by one icp_sal_CyPrimeSearch call*/
+#define NUM_PRIME_SEARCH_CANDIDATES (8192)
 
 /**
  *****************************************************************************
@@ -813,6 +815,10 @@ typedef struct asym_test_params_s
     CpaBoolean enableKPT;
     CpaCyKptHandle kptKeyHandle;
 #endif
+    /*measure RSA key generation, primes come from icp_sal_CyPrimeSearch*/
+    CpaBoolean rsaKeyGen;
+    /*sieve the prime candidates on the host before testing them*/
+    CpaBoolean usePrimeSieve;
 } asym_test_params_t;
 
 /**
@@ -902,6 +908,8 @@ typedef struct ecdsa_test_params_s
     ecdsa_step_t step;
     ec_curves_t *pCurve;
     Cpa32U threadID;
+    /* sign with a key prepared by icp_sal_EcdsaSignRSPrepareKey */
+    CpaBoolean usePreparedKey;
 #if CY_API_VERSION_AT_LEAST(3, 0)
     CpaBoolean enableKPT;
     CpaCyKptHandle kptKeyHandle;
@@ -1034,6 +1042,31 @@ CpaStatus sessionUpdateTest(Cpa32U numLoops, Cpa32U numBuffers);
  *****************************************************************************/
 CpaStatus sessionUpdateTestDp(Cpa32U numLoops, Cpa32U numBuffers);
 
+/**
+ *****************************************************************************
+ * @ingroup cryptoThreads
+ *      symSessionSetupRateTest
+ *
+ * @description
+ *      Measure the HMAC/XCBC/CMAC session setup rate on the first crypto
+ *      instance with the driver precompute cache disabled and enabled.
+ *      Starts and stops the crypto services itself.
+ *****************************************************************************/
+CpaStatus symSessionSetupRateTest(Cpa32U numSessions);
+
+/**
+ *****************************************************************************
+ * @ingroup cryptoThreads
+ *      tls3ScheduleRateTest
+ *
+ * @description
+ *      Measure TLS 1.3 handshakes per second on the first crypto instance,
+ *      deriving the key schedule with one cpaCyKeyGenTls3 request per
+ *      derivation and with icp_sal_CyKeyGenTls3Schedule. Starts and stops
+ *      the crypto services itself.
+ *****************************************************************************/
+CpaStatus tls3ScheduleRateTest(Cpa32U numHandshakes);
+
 #if CY_API_VERSION_AT_LEAST(2, 3)
 /**
  *****************************************************************************
@@ -1284,6 +1317,21 @@ CpaStatus setupEcdsaTest(Cpa32U nLenInBits,
                          ecdsa_step_t step,
                          Cpa32U numBuffers,
                          Cpa32U numLoops);
+
+/**
+ *****************************************************************************
+ * @ingroup cryptoThreads
+ *      setupEcdsaPreparedKeyTest
+ *
+ * @description
+ *      setup a test to run ECDSA SignRS with a prepared key
+ *      - should be called before createTheads framework function
+ *****************************************************************************/
+CpaStatus setupEcdsaPreparedKeyTest(Cpa32U nLenInBits,
+                                    CpaCyEcFieldType fieldType,
+                                    sync_mode_t syncMode,
+                                    Cpa32U numBuffers,
+                                    Cpa32U numLoops);
 #if CY_API_VERSION_AT_LEAST(3, 0)
 /**
  *****************************************************************************
@@ -1434,6 +1482,20 @@ CpaStatus setupRsaTest(Cpa32U modulusSize,
                        Cpa32U numBuffs,
                        Cpa32U numLoops);
 
+/**
+ *****************************************************************************
+ * @ingroup cryptoThreads
+ *      setupRsaKeyGenTest
+ *
+ * @description
+ *      setup a test to measure RSA key generation, with the primes searched
+ *      by icp_sal_CyPrimeSearch with or without the host prime sieve
+ *      - should be called before createTheads framework function
+ *****************************************************************************/
+CpaStatus setupRsaKeyGenTest(Cpa32U modulusSize,
+                             CpaBoolean usePrimeSieve,
+                             Cpa32U numLoops);
+
 /**
  *****************************************************************************
  * @ingroup cryptoThreads
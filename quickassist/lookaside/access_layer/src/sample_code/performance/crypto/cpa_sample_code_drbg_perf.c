@@ -349,6 +349,24 @@ static CpaBoolean nrbgNotDFRequired(void)
     return CPA_FALSE;
 }
 
+/*
+ * The NRBG backed entropy and nonce functions are only registered when the
+ * first crypto instance supports NRBG; otherwise the library defaults are
+ * kept.
+ */
+static CpaBoolean nrbgIsSupported(void)
+{
+    CpaCyCapabilitiesInfo cyCap = {0};
+    CpaInstanceHandle instanceHandle = NULL;
+
+    if ((CPA_STATUS_SUCCESS != cpaCyGetInstances(1, &instanceHandle)) ||
+        (CPA_STATUS_SUCCESS != cpaCyQueryCapabilities(instanceHandle, &cyCap)))
+    {
+        return CPA_FALSE;
+    }
+    return cyCap.nrbgSupported;
+}
+
 static void nrbgRegisterDrbgImplFunctions(CpaBoolean dFReq)
 {
     CpaStatus status;
@@ -359,10 +377,14 @@ static void nrbgRegisterDrbgImplFunctions(CpaBoolean dFReq)
     {
         if (0 == drbgImplFunctionsRegistered)
         {
-            pPrevGetEntropyInputFunc =
-                icp_sal_drbgGetEntropyInputFuncRegister(nrbgGetEntropy);
+            if (CPA_TRUE == nrbgIsSupported())
+            {
+                pPrevGetEntropyInputFunc =
+                    icp_sal_drbgGetEntropyInputFuncRegister(nrbgGetEntropy);
 
-            pPrevGetNonceFunc = icp_sal_drbgGetNonceFuncRegister(nrbgGetNonce);
+                pPrevGetNonceFunc =
+                    icp_sal_drbgGetNonceFuncRegister(nrbgGetNonce);
+            }
 
             if (CPA_TRUE == dFReq)
             {
@@ -77,6 +77,7 @@
 
 #include "cpa_cy_ec.h"
 #include "cpa_cy_ecdsa.h"
+#include "icp_sal_ecdsa_prepared.h"
 #include "cpa_sample_code_crypto_utils.h"
 #include "cpa_sample_code_ec_curves.h"
 #include "cpa_cy_im.h"
@@ -129,6 +130,7 @@ CpaStatus ecdsaSignRSOpDataSetup(ecdsa_test_params_t *setup,
                                  perf_data_t *pEcdsaData,
                                  CpaCyEcdsaSignRSOpData *pSignRSOpData);
 CpaStatus ecdsaPerform(ecdsa_test_params_t *setup);
+CpaStatus ecdsaSignRSPerform(ecdsa_test_params_t *setup);
 void ecdsaPerformance(single_thread_test_data_t *testSetup);
 void ecdsaPerformRsOnlyMemFree(
     ecdsa_test_params_t *setup,
@@ -1702,6 +1704,337 @@ barrier:
 }
 EXPORT_SYMBOL(ecdsaPerform);
 
+/***************************************************************************
+ * @ingroup cryptoThreads
+ *
+ * @description
+ *      sign a number of random messages repeatedly with one private key,
+ *      either through cpaCyEcdsaSignRS or with a key prepared once by
+ *      icp_sal_EcdsaSignRSPrepareKey
+ ***************************************************************************/
+CpaStatus ecdsaSignRSPerform(ecdsa_test_params_t *setup)
+{
+    Cpa32U i = 0;
+    Cpa32U numLoops = 0;
+    CpaBoolean multiplyStatus = CPA_FALSE;
+    CpaStatus status = CPA_STATUS_FAIL;
+    /*unused by the sign test, released by the common free function*/
+    CpaFlatBuffer *pX = NULL;
+    CpaFlatBuffer *pY = NULL;
+    /*array of signature R & S of the messages below*/
+    CpaFlatBuffer *pR = NULL;
+    CpaFlatBuffer *pS = NULL;
+    /*array of messages to be signed and their digests*/
+    CpaFlatBuffer *msg = NULL;
+    CpaFlatBuffer *pZ = NULL;
+    CpaFlatBuffer **ppDigests = NULL;
+    /*private key used for all messages*/
+    CpaFlatBuffer privateKey = {.dataLenInBytes = 0, .pData = NULL};
+    CpaCyEcdsaSignRSOpData **ppSignRSOpData = NULL;
+    icp_sal_ecdsa_prepared_key_t preparedKey = NULL;
+    Cpa32U node = 0;
+    perf_data_t *pEcdsaData = NULL;
+    CpaInstanceInfo2 *instanceInfo = NULL;
+    CpaCyEcdsaSignRSCbFunc cbFunc = NULL;
+#ifdef POLL_INLINE
+    CpaStatus pollStatus = CPA_STATUS_FAIL;
+    perf_data_t *pPerfData = setup->performanceStats;
+    Cpa64U numOps = 0;
+    Cpa64U nextPoll = asymPollingInterval_g;
+#endif
+    DECLARE_IA_CYCLE_COUNT_VARIABLES();
+
+    instanceInfo = qaeMemAlloc(sizeof(CpaInstanceInfo2));
+    if (instanceInfo == NULL)
+    {
+        PRINT_ERR("Failed to allocate memory for instanceInfo");
+        goto barrier;
+    }
+    memset(instanceInfo, 0, sizeof(CpaInstanceInfo2));
+
+    status = cpaCyInstanceGetInfo2(setup->cyInstanceHandle, instanceInfo);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("cpaCyInstanceGetInfo2 error, status: %d\n", status);
+        goto barrier;
+    }
+    status = sampleCodeCyGetNode(setup->cyInstanceHandle, &node);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("sampleCodeCyGetNode error, status: %d\n", status);
+        goto barrier;
+    }
+    status = getCurveData(setup);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        goto barrier;
+    }
+
+    pEcdsaData = setup->performanceStats;
+    pEcdsaData->numOperations = (Cpa64U)setup->numBuffers * setup->numLoops;
+    pEcdsaData->responses = 0;
+    coo_init(pEcdsaData, pEcdsaData->numOperations);
+    sampleCodeSemaphoreInit(&pEcdsaData->comp, 0);
+
+    privateKey.pData =
+        qaeMemAllocNUMA(setup->nLenInBytes, node, BYTE_ALIGNMENT_64);
+    if (NULL == privateKey.pData)
+    {
+        PRINT_ERR("privateKey pData  mem allocation error\n");
+        status = CPA_STATUS_FAIL;
+        goto barrier;
+    }
+    privateKey.dataLenInBytes = setup->nLenInBytes;
+    generateRandomData(privateKey.pData, privateKey.dataLenInBytes);
+    makeParam1SmallerThanParam2(
+        privateKey.pData, setup->pCurve->r, setup->nLenInBytes, CPA_FALSE);
+
+    pR = qaeMemAlloc(sizeof(CpaFlatBuffer) * setup->numBuffers);
+    pS = qaeMemAlloc(sizeof(CpaFlatBuffer) * setup->numBuffers);
+    msg = qaeMemAlloc(sizeof(CpaFlatBuffer) * setup->numBuffers);
+    pZ = qaeMemAlloc(sizeof(CpaFlatBuffer) * setup->numBuffers);
+    if ((NULL == pR) || (NULL == pS) || (NULL == msg) || (NULL == pZ))
+    {
+        PRINT_ERR("signature or message mem allocation error\n");
+        ECDSA_PERFORM_RS_ONLY_MEM_FREE();
+        status = CPA_STATUS_FAIL;
+        goto barrier;
+    }
+    memset(pR, 0, sizeof(CpaFlatBuffer) * setup->numBuffers);
+    memset(pS, 0, sizeof(CpaFlatBuffer) * setup->numBuffers);
+    memset(msg, 0, sizeof(CpaFlatBuffer) * setup->numBuffers);
+    memset(pZ, 0, sizeof(CpaFlatBuffer) * setup->numBuffers);
+
+    status = allocArrayOfVirtPointers((void **)&ppDigests, setup->numBuffers);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = allocArrayOfVirtPointers((void **)&ppSignRSOpData,
+                                          setup->numBuffers);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("opData mem allocation error\n");
+        ECDSA_PERFORM_RS_ONLY_MEM_FREE();
+        goto barrier;
+    }
+
+    /*build the sign opData of each message: digest of a random message,
+     * random k and the curve data*/
+    for (i = 0; i < setup->numBuffers; i++)
+    {
+        ALLOC_FLAT_BUFF_DATA(setup->cyInstanceHandle,
+                             &pR[i],
+                             setup->nLenInBytes,
+                             NULL,
+                             0,
+                             ECDSA_PERFORM_RS_ONLY_MEM_FREE());
+        ALLOC_FLAT_BUFF_DATA(setup->cyInstanceHandle,
+                             &pS[i],
+                             setup->nLenInBytes,
+                             NULL,
+                             0,
+                             ECDSA_PERFORM_RS_ONLY_MEM_FREE());
+        ALLOC_FLAT_BUFF_DATA(setup->cyInstanceHandle,
+                             &msg[i],
+                             setup->nLenInBytes,
+                             NULL,
+                             0,
+                             ECDSA_PERFORM_RS_ONLY_MEM_FREE());
+        ALLOC_FLAT_BUFF_DATA(setup->cyInstanceHandle,
+                             &pZ[i],
+                             setup->nLenInBytes,
+                             NULL,
+                             0,
+                             ECDSA_PERFORM_RS_ONLY_MEM_FREE());
+        ppDigests[i] = qaeMemAlloc(sizeof(CpaFlatBuffer));
+        ppSignRSOpData[i] = qaeMemAlloc(sizeof(CpaCyEcdsaSignRSOpData));
+        if ((NULL == ppDigests[i]) || (NULL == ppSignRSOpData[i]))
+        {
+            PRINT_ERR("opData[%u] memory allocation error\n", i);
+            ECDSA_PERFORM_RS_ONLY_MEM_FREE();
+            status = CPA_STATUS_FAIL;
+            goto barrier;
+        }
+        memset(ppDigests[i], 0, sizeof(CpaFlatBuffer));
+        memset(ppSignRSOpData[i], 0, sizeof(CpaCyEcdsaSignRSOpData));
+        status = ecdsaSignRSOpDataSetup(setup,
+                                        &privateKey,
+                                        &pR[i],
+                                        &pS[i],
+                                        &msg[i],
+                                        &pZ[i],
+                                        ppDigests[i],
+                                        pEcdsaData,
+                                        ppSignRSOpData[i]);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("ecdsaSignRSOpDataSetup error %d\n", status);
+            ECDSA_PERFORM_RS_ONLY_MEM_FREE();
+            goto barrier;
+        }
+    }
+
+    if (CPA_TRUE == setup->usePreparedKey)
+    {
+        /*the curve and private key are the same for all messages*/
+        status = icp_sal_EcdsaSignRSPrepareKey(
+            setup->cyInstanceHandle, ppSignRSOpData[0], &preparedKey);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("icp_sal_EcdsaSignRSPrepareKey error %d\n", status);
+            ECDSA_PERFORM_RS_ONLY_MEM_FREE();
+            goto barrier;
+        }
+    }
+    if (ASYNC == setup->syncMode)
+    {
+        cbFunc = ecdsaSignOnlyPerformCallback;
+    }
+
+barrier:
+    sampleCodeBarrier();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        setup->performanceStats->threadReturnStatus = CPA_STATUS_FAIL;
+        qaeMemFree((void **)&instanceInfo);
+        return status;
+    }
+
+    pEcdsaData->startCyclesTimestamp = sampleCodeTimestamp();
+    for (numLoops = 0; numLoops < setup->numLoops; numLoops++)
+    {
+        for (i = 0; i < setup->numBuffers; i++)
+        {
+            do
+            {
+                coo_req_start(pEcdsaData);
+                if (NULL != preparedKey)
+                {
+                    status =
+                        icp_sal_EcdsaSignRSPrepared(setup->cyInstanceHandle,
+                                                    cbFunc,
+                                                    pEcdsaData,
+                                                    preparedKey,
+                                                    ppSignRSOpData[i],
+                                                    &multiplyStatus,
+                                                    &pR[i],
+                                                    &pS[i]);
+                }
+                else
+                {
+                    status = cpaCyEcdsaSignRS(setup->cyInstanceHandle,
+                                              cbFunc,
+                                              pEcdsaData,
+                                              ppSignRSOpData[i],
+                                              &multiplyStatus,
+                                              &pR[i],
+                                              &pS[i]);
+                }
+                coo_req_stop(pEcdsaData, status);
+                if (CPA_STATUS_RETRY == status)
+                {
+#ifdef POLL_INLINE
+                    if (poll_inline_g)
+                    {
+                        if (instanceInfo->isPolled)
+                        {
+                            sampleCodeAsymPollInstance(setup->cyInstanceHandle,
+                                                       0);
+                            nextPoll = numOps + asymPollingInterval_g;
+                        }
+                    }
+#endif
+                    pEcdsaData->retries++;
+                    if (RETRY_LIMIT ==
+                        (pEcdsaData->retries % (RETRY_LIMIT + 1)))
+                    {
+                        AVOID_SOFTLOCKUP;
+                    }
+                }
+            } while (CPA_STATUS_RETRY == status);
+            if (CPA_CC_BUSY_LOOPS == iaCycleCount_g)
+            {
+                BUSY_LOOP();
+            }
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                PRINT_ERR("ECDSA SignRS function failed with status:%d\n",
+                          status);
+                break;
+            }
+#ifdef POLL_INLINE
+            if (poll_inline_g)
+            {
+                if (instanceInfo->isPolled)
+                {
+                    ++numOps;
+                    if (numOps == nextPoll)
+                    {
+                        coo_poll_trad_cy(
+                            pEcdsaData, setup->cyInstanceHandle, &pollStatus);
+                        nextPoll = numOps + asymPollingInterval_g;
+                    }
+                }
+            }
+#endif
+            if ((ASYNC != setup->syncMode) && (CPA_TRUE != multiplyStatus))
+            {
+                PRINT_ERR("ECDSA SignRS multiply output failed\n");
+                status = CPA_STATUS_FAIL;
+            }
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            break;
+        }
+    }
+#ifdef POLL_INLINE
+    if (poll_inline_g)
+    {
+        if ((instanceInfo->isPolled) && (CPA_STATUS_SUCCESS == status))
+        {
+            status = cyPollNumOperations(
+                pEcdsaData, setup->cyInstanceHandle, pEcdsaData->numOperations);
+        }
+    }
+#endif
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = waitForResponses(
+            pEcdsaData, setup->syncMode, setup->numBuffers, setup->numLoops);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("Thread %u timeout. ", setup->threadID);
+        }
+    }
+    if (CPA_CC_BUSY_LOOPS == iaCycleCount_g)
+    {
+        IA_CYCLE_COUNT_CALCULATION();
+    }
+    coo_average(pEcdsaData);
+    coo_deinit(pEcdsaData);
+
+    sampleCodeSemaphoreDestroy(&pEcdsaData->comp);
+    /*requests still in flight after an error reference the key and the
+     * buffers, so only free them once all responses are in*/
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        if (NULL != preparedKey)
+        {
+            icp_sal_EcdsaSignRSFreePreparedKey(setup->cyInstanceHandle,
+                                               preparedKey);
+        }
+        ECDSA_PERFORM_RS_ONLY_MEM_FREE();
+    }
+    qaeMemFree((void **)&instanceInfo);
+    if (CPA_STATUS_SUCCESS != setup->performanceStats->threadReturnStatus)
+    {
+        status = CPA_STATUS_FAIL;
+    }
+    return status;
+}
+EXPORT_SYMBOL(ecdsaSignRSPerform);
+
 
 /***************************************************************************
  * @ingroup cryptoThreads
@@ -1730,6 +2063,10 @@ static CpaStatus ecdsaPrintStats(thread_creation_data_t *data)
 #else
         PRINT("ECDSA SIGNRS\n");
 #endif
+        if (CPA_TRUE == params->usePreparedKey)
+        {
+            PRINT("Key                   Prepared\n");
+        }
     }
     else if (ECDSA_STEP_VERIFY == params->step)
     {
@@ -1880,6 +2217,7 @@ void ecdsaPerformance(single_thread_test_data_t *testSetup)
     ecdsaSetup.numBuffers = params->numBuffers;
     ecdsaSetup.numLoops = params->numLoops;
     ecdsaSetup.syncMode = params->syncMode;
+    ecdsaSetup.usePreparedKey = params->usePreparedKey;
 #if CY_API_VERSION_AT_LEAST(3, 0)
 #ifdef SC_KPT2_ENABLED
     ecdsaSetup.enableKPT = params->enableKPT;
@@ -1889,6 +2227,9 @@ void ecdsaPerformance(single_thread_test_data_t *testSetup)
 
     switch (params->step)
     {
+        case (ECDSA_STEP_SIGNRS):
+            status = ecdsaSignRSPerform(&ecdsaSetup);
+            break;
         case (ECDSA_STEP_VERIFY):
             status = ecdsaPerform(&ecdsaSetup);
             break;
@@ -1992,5 +2333,37 @@ CpaStatus setupEcdsaTest(Cpa32U nLenInBits,
     ecdsaSetup->numBuffers = numBuffers;
     ecdsaSetup->numLoops = numLoops;
     ecdsaSetup->step = step;
+    ecdsaSetup->usePreparedKey = CPA_FALSE;
     return CPA_STATUS_SUCCESS;
 }
+
+/***************************************************************************
+ * @ingroup cryptoThreads
+ *
+ * @description
+ *      Set up an ECDSA SignRS test which signs with a key prepared once by
+ *      icp_sal_EcdsaSignRSPrepareKey instead of cpaCyEcdsaSignRS
+ ***************************************************************************/
+CpaStatus setupEcdsaPreparedKeyTest(Cpa32U nLenInBits,
+                                    CpaCyEcFieldType fieldType,
+                                    sync_mode_t syncMode,
+                                    Cpa32U numBuffers,
+                                    Cpa32U numLoops)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    ecdsa_test_params_t *ecdsaSetup = NULL;
+
+    status = setupEcdsaTest(nLenInBits,
+                            fieldType,
+                            syncMode,
+                            ECDSA_STEP_SIGNRS,
+                            numBuffers,
+                            numLoops);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        ecdsaSetup =
+            (ecdsa_test_params_t *)&thread_setup_g[testTypeCount_g][0];
+        ecdsaSetup->usePreparedKey = CPA_TRUE;
+    }
+    return status;
+}
@@ -111,6 +111,9 @@
 #endif
 #include "qat_perf_cycles.h"
 #include "cpa_sample_code_framework.h"
+#include "qat_perf_histogram.h"
+#include "qat_perf_openloop.h"
+#include "qat_perf_results.h"
 #ifdef USER_SPACE
 #if CY_API_VERSION_AT_LEAST(3, 0)
 #ifdef SC_KPT2_ENABLED
@@ -148,6 +151,7 @@ extern Cpa32U packageIdCount_g;
 
 void sampleRsaThreadSetup(single_thread_test_data_t *testSetup);
 CpaStatus setupRsaBackpressureTest(Cpa32U numLoops);
+CpaStatus printRsaKeyGenPerfData(thread_creation_data_t *data);
 CpaStatus setAsymPollingInterval(Cpa64U pollingInterval);
 #if CY_API_VERSION_AT_LEAST(3, 0)
 #ifdef SC_KPT2_ENABLED
@@ -290,6 +294,8 @@ CpaStatus generateRSAKey(CpaInstanceHandle instanceHandle,
     Cpa32U retry = 0;
     perf_data_t *pPerfData = setup->performanceStats;
     CpaCyRsaKeyGenCbFunc rsaKeyGenCb = NULL;
+    /*the key generation test always generates its primes*/
+    int staticPrime = (CPA_TRUE == setup->rsaKeyGen) ? 0 : useStaticPrime;
 #ifdef POLL_INLINE
     CpaInstanceInfo2 *instanceInfo2 = NULL;
 #endif
@@ -382,7 +388,7 @@ CpaStatus generateRSAKey(CpaInstanceHandle instanceHandle,
                          0,
                          FREE_GENERATE_RSA_KEY_MEM());
 
-    if (useStaticPrime == 1)
+    if (staticPrime == 1)
     {
         status = generateHardCodedPrime1P(
             &(pPrivateKey->privateKeyRep2.prime1P), setup);
@@ -407,7 +413,7 @@ CpaStatus generateRSAKey(CpaInstanceHandle instanceHandle,
                          NULL,
                          0,
                          FREE_GENERATE_RSA_KEY_MEM());
-    if (useStaticPrime == 1)
+    if (staticPrime == 1)
     {
         status = generateHardCodedPrime2Q(
             &(pPrivateKey->privateKeyRep2.prime2Q), setup);
@@ -475,7 +481,7 @@ CpaStatus generateRSAKey(CpaInstanceHandle instanceHandle,
             {
                 break;
             }
-            if (!useStaticPrime)
+            if (!staticPrime)
             {
                 /*could fail due to invalid e,p,q combination, so re-generate
                  * p,q and try again*/
@@ -1357,6 +1363,7 @@ CpaStatus sampleRsaDecrypt(asym_test_params_t *setup,
         setup->modulusSizeInBytes;
     setup->performanceStats->numOperations = (Cpa64U)numLoops * numBuffers;
     setup->performanceStats->responses = 0;
+    qatOpenLoopReset(setup->performanceStats);
     coo_init(pPerfData, pPerfData->numOperations);
     if (CPA_CC_BUSY_LOOPS == iaCycleCount_g)
     {
@@ -1491,6 +1498,7 @@ CpaStatus sampleRsaDecrypt(asym_test_params_t *setup,
         for (insideLoopCount = 0; insideLoopCount < numBuffers;
              insideLoopCount++)
         {
+            qatOpenLoopPace(setup->performanceStats);
             do
             {
                 if (latency_enable)
@@ -1500,7 +1508,8 @@ CpaStatus sampleRsaDecrypt(asym_test_params_t *setup,
                     {
                         request_submit_start[setup->performanceStats
                                                  ->latencyCount] =
-                            sampleCodeTimestamp();
+                            qatOpenLoopRequestTimestamp(
+                                setup->performanceStats);
                     }
                 }
                 coo_req_start(pPerfData);
@@ -1670,6 +1679,7 @@ CpaStatus sampleRsaDecrypt(asym_test_params_t *setup,
             perf_cycles_t latency = setup->performanceStats->response_times[i] -
                                     request_submit_start[i];
             setup->performanceStats->aveLatency += latency;
+            qatLatencyHistogramRecord(setup->performanceStats, latency);
 
             if (latency < setup->performanceStats->minLatency)
                 setup->performanceStats->minLatency = latency;
@@ -1948,6 +1958,61 @@ static CpaStatus sampleRsaEncryptPerform(asym_test_params_t *setup)
     return status;
 }
 
+/******************************************************************************
+ * @ingroup sampleRSACode
+ *
+ * @description
+ *      Generate setup->numLoops RSA keys one after the other and measure the
+ *      keys generated per second. Each key takes two prime searches and one
+ *      cpaCyRsaGenKey, so the rate mostly reflects the prime tests spent on
+ *      composite candidates, which setup->usePrimeSieve cuts down.
+ *
+ *****************************************************************************/
+static CpaStatus sampleRsaKeyGenPerform(asym_test_params_t *setup)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    perf_data_t *pPerfData = setup->performanceStats;
+    /*generateRSAKey uses the perf data of its setup for its own request*/
+    perf_data_t keyGenPerfData = {0};
+    asym_test_params_t keyGenSetup = *setup;
+    CpaCyRsaPrivateKey privateKey;
+    CpaCyRsaPublicKey publicKey;
+    CpaCyRsaPrivateKey *pPrivateKey = &privateKey;
+    CpaCyRsaPublicKey *pPublicKey = &publicKey;
+    Cpa32U i = 0;
+
+    keyGenSetup.performanceStats = &keyGenPerfData;
+    keyGenSetup.syncMode = SYNC;
+    pPerfData->averagePacketSizeInBytes = setup->modulusSizeInBytes;
+    pPerfData->numOperations = setup->numLoops;
+    pPerfData->responses = 0;
+
+    sampleCodeBarrier();
+    pPerfData->startCyclesTimestamp = sampleCodeTimestamp();
+    for (i = 0; i < setup->numLoops; i++)
+    {
+        memset(pPrivateKey, 0, sizeof(CpaCyRsaPrivateKey));
+        memset(pPublicKey, 0, sizeof(CpaCyRsaPublicKey));
+        pPrivateKey->version = CPA_CY_RSA_VERSION_TWO_PRIME;
+        pPrivateKey->privateKeyRepType = setup->rsaKeyRepType;
+        status = generateRSAKey(setup->cyInstanceHandle,
+                                setup->modulusSizeInBytes,
+                                pPrivateKey,
+                                pPublicKey,
+                                &keyGenSetup);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("RSAKey gen error %d on %u\n", status, i);
+            break;
+        }
+        FREE_GENERATE_RSA_KEY_MEM();
+        pPerfData->responses++;
+    }
+    pPerfData->endCyclesTimestamp = sampleCodeTimestamp();
+
+    return status;
+}
+
 /******************************************************************************
  * @ingroup sampleRSACode
  *
@@ -1978,7 +2043,11 @@ void sampleRsaThreadSetup(single_thread_test_data_t *testSetup)
      * In case of error scenario, the thread will exit early.
      * register the print function here itself to properly exit with statistics.
      */
-    if (params->rsaKeyRepType == CPA_CY_RSA_PRIVATE_KEY_REP_TYPE_2)
+    if (CPA_TRUE == params->rsaKeyGen)
+    {
+        testSetup->statsPrintFunc = (stats_print_func_t)printRsaKeyGenPerfData;
+    }
+    else if (params->rsaKeyRepType == CPA_CY_RSA_PRIVATE_KEY_REP_TYPE_2)
     {
         testSetup->statsPrintFunc = (stats_print_func_t)printRsaCrtPerfData;
     }
@@ -2065,6 +2134,8 @@ void sampleRsaThreadSetup(single_thread_test_data_t *testSetup)
     rsaTestSetup.numLoops = params->numLoops;
     rsaTestSetup.syncMode = params->syncMode;
     rsaTestSetup.performEncrypt = params->performEncrypt;
+    rsaTestSetup.rsaKeyGen = params->rsaKeyGen;
+    rsaTestSetup.usePrimeSieve = params->usePrimeSieve;
 #if CY_API_VERSION_AT_LEAST(3, 0)
 #ifdef SC_KPT2_ENABLED
     rsaTestSetup.enableKPT = params->enableKPT;
@@ -2073,7 +2144,11 @@ void sampleRsaThreadSetup(single_thread_test_data_t *testSetup)
 
 
     /*launch function that does all the work*/
-    if (params->performEncrypt)
+    if (CPA_TRUE == params->rsaKeyGen)
+    {
+        status = sampleRsaKeyGenPerform(&rsaTestSetup);
+    }
+    else if (params->performEncrypt)
     {
         status = sampleRsaEncryptPerform(&rsaTestSetup);
     }
@@ -2149,6 +2224,9 @@ CpaStatus printRsaCrtPerfData(thread_creation_data_t *data)
 #endif
     }
     PRINT("Modulus Size %19u\n", data->packetSize * NUM_BITS_IN_BYTE);
+    qatPerfResultsSetService(params->performEncrypt ? "rsa_crt_encrypt"
+                                                    : "rsa_crt_decrypt");
+    qatPerfResultsAddConfig("modulusBits", data->packetSize * NUM_BITS_IN_BYTE);
     return (printAsymStatsAndStopServices(data));
 }
 
@@ -2180,6 +2258,29 @@ CpaStatus printRsaPerfData(thread_creation_data_t *data)
     PRINT("RSA DECRYPT\n");
 #endif
     PRINT("Modulus Size %19u\n", data->packetSize * NUM_BITS_IN_BYTE);
+    qatPerfResultsSetService("rsa_decrypt");
+    qatPerfResultsAddConfig("modulusBits", data->packetSize * NUM_BITS_IN_BYTE);
+    return (printAsymStatsAndStopServices(data));
+}
+
+/**
+ *****************************************************************************
+ * @ingroup sampleRSACode
+ *
+ * @description
+ *     function to print out RSA key generation performance data
+ *
+ *****************************************************************************/
+CpaStatus printRsaKeyGenPerfData(thread_creation_data_t *data)
+{
+    asym_test_params_t *params = (asym_test_params_t *)data->setupPtr;
+
+    PRINT("RSA KEY GENERATION\n");
+    PRINT("Modulus Size %19u\n", data->packetSize * NUM_BITS_IN_BYTE);
+    PRINT("Prime Sieve %20s\n", params->usePrimeSieve ? "On" : "Off");
+    qatPerfResultsSetService("rsa_keygen");
+    qatPerfResultsAddConfig("modulusBits", data->packetSize * NUM_BITS_IN_BYTE);
+    qatPerfResultsAddConfig("primeSieve", params->usePrimeSieve ? 1 : 0);
     return (printAsymStatsAndStopServices(data));
 }
 
@@ -2248,5 +2349,37 @@ CpaStatus setupRsaTest(Cpa32U modulusSize,
     rsaSetup->syncMode = syncMode;
     rsaSetup->numBuffers = numBuffs;
     rsaSetup->numLoops = numLoops;
+    rsaSetup->rsaKeyGen = CPA_FALSE;
+    rsaSetup->usePrimeSieve = CPA_FALSE;
     return CPA_STATUS_SUCCESS;
 }
+
+/**
+ *****************************************************************************
+ * @ingroup sampleRSACode
+ *
+ * @description
+ *      Set up an RSA key generation test, generating numLoops keys per
+ *      thread with or without the host prime sieve
+ *
+ *****************************************************************************/
+CpaStatus setupRsaKeyGenTest(Cpa32U modulusSize,
+                             CpaBoolean usePrimeSieve,
+                             Cpa32U numLoops)
+{
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    asym_test_params_t *rsaSetup = NULL;
+
+    status = setupRsaTest(modulusSize,
+                          CPA_CY_RSA_PRIVATE_KEY_REP_TYPE_2,
+                          SYNC,
+                          1,
+                          numLoops);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        rsaSetup = (asym_test_params_t *)&thread_setup_g[testTypeCount_g][0];
+        rsaSetup->rsaKeyGen = CPA_TRUE;
+        rsaSetup->usePrimeSieve = usePrimeSieve;
+    }
+    return status;
+}
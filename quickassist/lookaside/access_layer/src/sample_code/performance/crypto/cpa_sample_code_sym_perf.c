@@ -97,6 +97,7 @@ extern int verboseOutput;
 extern Cpa32U symPollingInterval_g;
 #include "busy_loop.h"
 #include "qat_perf_cycles.h"
+#include "qat_perf_histogram.h"
 
 
 #define ADF_MAX_DEVICES 32
@@ -905,6 +906,7 @@ static CpaStatus symPerform(symmetric_test_params_t *setup,
             perf_cycles_t latency =
                 pSymData->response_times[i] - request_submit_start[i];
             pSymData->aveLatency += latency;
+            qatLatencyHistogramRecord(pSymData, latency);
 
             if (latency < pSymData->minLatency)
                 pSymData->minLatency = latency;
@@ -91,6 +91,7 @@
 #include "qat_perf_cycles.h"
 #include "qat_perf_sleeptime.h"
 #include "qat_perf_buffer_utils.h"
+#include "qat_perf_histogram.h"
 
 #define REL_LOOP_MULTIPLIER (2)
 #define SYM_OPERATIONS_DEFAULT_POLLING_INTERVAL (16)
@@ -1444,6 +1445,7 @@ static CpaStatus symDpPerformEnqueueOp(symmetric_test_params_t *setup,
             perf_cycles_t latency =
                 pSymData->response_times[i] - request_submit_start[i];
             pSymData->aveLatency += latency;
+            qatLatencyHistogramRecord(pSymData, latency);
 
             if (latency < pSymData->minLatency)
                 pSymData->minLatency = latency;
@@ -0,0 +1,309 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file cpa_sample_code_sym_session_setup.c
+ *
+ * @ingroup sampleSymmetricPerf
+ *
+ * @description
+ *      Measures the symmetric session setup rate for hash algorithms whose
+ *      key-dependent state is derived in software (HMAC, AES-XCBC,
+ *      AES-CMAC), with the driver's precompute cache disabled and enabled.
+ *      Sessions are set up round-robin over a small set of keys, which is
+ *      the pattern (many sessions, few keys) the cache is meant for.
+ *
+ *****************************************************************************/
+
+#include "cpa.h"
+#include "cpa_cy_sym.h"
+#include "icp_sal_sym_precomp_cache.h"
+#include "cpa_sample_code_crypto_utils.h"
+#include "cpa_sample_code_framework.h"
+#include "cpa_sample_code_utils_common.h"
+
+extern CpaInstanceHandle *cyInstances_g;
+extern Cpa32U getCPUSpeed(void);
+
+/* Distinct authentication keys cycled through by the setups */
+#define SESSION_SETUP_NUM_KEYS (16)
+#define SESSION_SETUP_MAX_KEY_LEN (64)
+
+typedef struct session_setup_alg_s
+{
+    const char *name;
+    CpaCySymHashAlgorithm hashAlgorithm;
+    Cpa32U authKeyLen;
+    Cpa32U digestLen;
+} session_setup_alg_t;
+
+static const session_setup_alg_t sessionSetupAlgs[] = {
+    {"HMAC-SHA1", CPA_CY_SYM_HASH_SHA1, 20, 20},
+    {"HMAC-SHA256", CPA_CY_SYM_HASH_SHA256, 32, 32},
+    {"HMAC-SHA512", CPA_CY_SYM_HASH_SHA512, 64, 64},
+    {"AES-XCBC", CPA_CY_SYM_HASH_AES_XCBC, 16, 16},
+    {"AES-CMAC", CPA_CY_SYM_HASH_AES_CMAC, 16, 16}};
+
+/* Set up and tear down numSessions sessions, returning the elapsed cycles */
+static CpaStatus sessionSetupLoop(CpaInstanceHandle instanceHandle,
+                                  CpaCySymSessionSetupData *pSetupData,
+                                  CpaCySymSessionCtx pSessionCtx,
+                                  Cpa8U *pKeys,
+                                  Cpa32U numSessions,
+                                  perf_cycles_t *pCycles)
+{
+    CpaCySymHashAuthModeSetupData *pAuth =
+        &pSetupData->hashSetupData.authModeSetupData;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    perf_cycles_t start = 0;
+    Cpa32U i = 0;
+
+    start = sampleCodeTimestamp();
+    for (i = 0; i < numSessions; i++)
+    {
+        pAuth->authKey =
+            pKeys + (i % SESSION_SETUP_NUM_KEYS) * pAuth->authKeyLenInBytes;
+        status = cpaCySymInitSession(
+            instanceHandle, NULL, pSetupData, pSessionCtx);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("cpaCySymInitSession error, status: %d\n", status);
+            return status;
+        }
+        status = cpaCySymRemoveSession(instanceHandle, pSessionCtx);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            PRINT_ERR("cpaCySymRemoveSession error, status: %d\n", status);
+            return status;
+        }
+    }
+    *pCycles = sampleCodeTimestamp() - start;
+    return CPA_STATUS_SUCCESS;
+}
+
+static Cpa64U sessionSetupRate(Cpa32U numSessions, perf_cycles_t cycles)
+{
+    if (0 == cycles)
+    {
+        return 0;
+    }
+    return (Cpa64U)numSessions * sampleCodeGetCpuFreq() * SAMPLE_CODE_THOUSAND /
+           cycles;
+}
+
+static CpaStatus sessionSetupRunAlg(CpaInstanceHandle instanceHandle,
+                                    const session_setup_alg_t *pAlg,
+                                    Cpa32U numSessions)
+{
+    CpaCySymSessionSetupData setupData = {0};
+    CpaCySymSessionCtx pSessionCtx = NULL;
+    icp_sal_sym_precomp_cache_stats_t stats = {0};
+    Cpa8U keys[SESSION_SETUP_NUM_KEYS * SESSION_SETUP_MAX_KEY_LEN];
+    Cpa32U sessionCtxSize = 0;
+    Cpa32U node = 0;
+    perf_cycles_t cyclesOff = 0;
+    perf_cycles_t cyclesOn = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    setupData.sessionPriority = CPA_CY_PRIORITY_NORMAL;
+    setupData.symOperation = CPA_CY_SYM_OP_HASH;
+    setupData.hashSetupData.hashAlgorithm = pAlg->hashAlgorithm;
+    setupData.hashSetupData.hashMode = CPA_CY_SYM_HASH_MODE_AUTH;
+    setupData.hashSetupData.digestResultLenInBytes = pAlg->digestLen;
+    setupData.hashSetupData.authModeSetupData.authKeyLenInBytes =
+        pAlg->authKeyLen;
+    setupData.digestIsAppended = CPA_FALSE;
+    setupData.verifyDigest = CPA_FALSE;
+    generateRandomData(keys, sizeof(keys));
+    setupData.hashSetupData.authModeSetupData.authKey = keys;
+
+    status = sampleCodeCyGetNode(instanceHandle, &node);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    status = cpaCySymSessionCtxGetSize(
+        instanceHandle, &setupData, &sessionCtxSize);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("cpaCySymSessionCtxGetSize error, status: %d\n", status);
+        return status;
+    }
+    pSessionCtx = qaeMemAllocNUMA(sessionCtxSize, node, BYTE_ALIGNMENT_64);
+    if (NULL == pSessionCtx)
+    {
+        PRINT_ERR("Could not allocate session memory\n");
+        return CPA_STATUS_FAIL;
+    }
+
+    status = icp_sal_SymPrecompCacheConfig(instanceHandle, 0);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = sessionSetupLoop(instanceHandle,
+                                  &setupData,
+                                  pSessionCtx,
+                                  keys,
+                                  numSessions,
+                                  &cyclesOff);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_SymPrecompCacheConfig(instanceHandle,
+                                               SESSION_SETUP_NUM_KEYS);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = sessionSetupLoop(instanceHandle,
+                                  &setupData,
+                                  pSessionCtx,
+                                  keys,
+                                  numSessions,
+                                  &cyclesOn);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_SymPrecompCacheGetStats(instanceHandle, &stats);
+    }
+    icp_sal_SymPrecompCacheConfig(instanceHandle, 0);
+    memset(keys, 0, sizeof(keys));
+    qaeMemFreeNUMA((void **)&pSessionCtx);
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        PRINT("%-12s %12llu %12llu %10llu %10llu\n",
+              pAlg->name,
+              (unsigned long long)sessionSetupRate(numSessions, cyclesOff),
+              (unsigned long long)sessionSetupRate(numSessions, cyclesOn),
+              (unsigned long long)stats.hits,
+              (unsigned long long)stats.misses);
+    }
+    else
+    {
+        PRINT_ERR("%s session setup test failed, status: %d\n",
+                  pAlg->name,
+                  status);
+    }
+    return status;
+}
+
+CpaStatus symSessionSetupRateTest(Cpa32U numSessions)
+{
+    CpaCySymCapabilitiesInfo capInfo = {{0}};
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaStatus retStatus = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+    /* Calibrates the cycle counter used to turn cycles into rates */
+    getCPUSpeed();
+
+    status = startCyServices();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Error starting crypto services\n");
+        return status;
+    }
+    status = cpaCySymQueryCapabilities(cyInstances_g[0], &capInfo);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("cpaCySymQueryCapabilities error, status: %d\n", status);
+        stopCyServices();
+        return status;
+    }
+
+    PRINT("\nSession setup rate, %u setups over %u keys, instance 0\n",
+          numSessions,
+          SESSION_SETUP_NUM_KEYS);
+    PRINT("%-12s %12s %12s %10s %10s\n",
+          "Algorithm",
+          "NoCache/s",
+          "Cache/s",
+          "Hits",
+          "Misses");
+    for (i = 0; i < sizeof(sessionSetupAlgs) / sizeof(sessionSetupAlgs[0]);
+         i++)
+    {
+        if (!CPA_BITMAP_BIT_TEST(capInfo.hashes,
+                                 sessionSetupAlgs[i].hashAlgorithm))
+        {
+            continue;
+        }
+        status = sessionSetupRunAlg(
+            cyInstances_g[0], &sessionSetupAlgs[i], numSessions);
+        if (CPA_STATUS_UNSUPPORTED == status)
+        {
+            PRINT("Precompute cache not supported, skipping\n");
+            break;
+        }
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            retStatus = CPA_STATUS_FAIL;
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS != stopCyServices())
+    {
+        retStatus = CPA_STATUS_FAIL;
+    }
+    return retStatus;
+}
+EXPORT_SYMBOL(symSessionSetupRateTest);
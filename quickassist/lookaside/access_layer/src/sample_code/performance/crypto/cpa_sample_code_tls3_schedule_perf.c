@@ -0,0 +1,860 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file cpa_sample_code_tls3_schedule_perf.c
+ *
+ * @ingroup sampleSymmetricPerf
+ *
+ * @description
+ *      Measures TLS 1.3 handshakes per second of the key schedule API
+ *      (icp_sal_CyKeyGenTls3Schedule) against one cpaCyKeyGenTls3 call per
+ *      derivation.
+ *
+ *      Each handshake derives the early, handshake and master secrets, the
+ *      handshake and application traffic secrets with their keys and IVs,
+ *      the handshake finished keys and the exporter master secret. The
+ *      first run sends one HKDF Extract or Expand Label request per
+ *      derivation, ten per handshake, each from the completion of the one
+ *      it depends on. The second run derives the same secrets with one key
+ *      schedule per handshake. Both keep TLS3_PERF_INFLIGHT handshakes in
+ *      flight, and every result is checked against HKDF computed with
+ *      OpenSSL.
+ *
+ *****************************************************************************/
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include "cpa.h"
+#include "cpa_cy_im.h"
+#include "cpa_cy_key.h"
+#include "icp_sal_key_schedule.h"
+#include "icp_sal_poll.h"
+#include "cpa_sample_code_crypto_utils.h"
+#include "cpa_sample_code_framework.h"
+#include "cpa_sample_code_utils_common.h"
+
+extern CpaInstanceHandle *cyInstances_g;
+extern Cpa32U getCPUSpeed(void);
+
+/* Handshakes kept in flight */
+#define TLS3_PERF_INFLIGHT (64)
+#define TLS3_PERF_SHARED_SECRET_SZ (32)
+#define TLS3_PERF_OUTPUT_SZ (512)
+/* Requests of a handshake sent one derivation at a time */
+#define TLS3_PERF_DERIVATIONS (10)
+/* Seconds without a completion after which a run fails */
+#define TLS3_PERF_TIMEOUT_SEC (10)
+
+struct tls3_perf_s;
+
+typedef struct tls3_perf_slot_s
+{
+    struct tls3_perf_s *pPerf;
+    CpaCyKeyGenHKDFOpData *pOpData;
+    /* Request of the current derivation of the first run */
+    CpaFlatBuffer output;
+    /* Its output */
+    void *pCtx;
+    /* Key schedule context of the second run */
+    icp_sal_tls3_schedule_op_data_t scheduleOpData;
+    icp_sal_tls3_schedule_t schedule;
+    Cpa8U derived[ICP_SAL_TLS3_MAX_HASH_SZ];
+    Cpa32U step;
+    /* Next derivation of the first run */
+    CpaBoolean busy;
+    CpaBoolean resend;
+    /* The next derivation was refused with a full ring */
+    volatile CpaBoolean ready;
+    volatile CpaStatus status;
+} tls3_perf_slot_t;
+
+typedef struct tls3_perf_suite_s
+{
+    const char *name;
+    CpaCyKeyHKDFCipherSuite cipherSuite;
+    Cpa32U hashLen;
+    Cpa32U keyLen;
+} tls3_perf_suite_t;
+
+typedef struct tls3_perf_s
+{
+    CpaInstanceHandle instanceHandle;
+    const tls3_perf_suite_t *pSuite;
+    const EVP_MD *pMd;
+    Cpa32U numHandshakes;
+    tls3_perf_slot_t slots[TLS3_PERF_INFLIGHT];
+    icp_sal_tls3_schedule_t expected;
+    /* Secrets computed on the host from the inputs shared by all slots */
+} tls3_perf_t;
+
+static const tls3_perf_suite_t tls3PerfSuites[] = {
+    {"TLS_AES_128_GCM_SHA256", CPA_CY_HKDF_TLS_AES_128_GCM_SHA256, 32, 16},
+    {"TLS_AES_256_GCM_SHA384", CPA_CY_HKDF_TLS_AES_256_GCM_SHA384, 48, 32}};
+
+static const char *tls3PerfLabels[TLS3_PERF_DERIVATIONS] = {NULL,
+                                                            "derived",
+                                                            NULL,
+                                                            "c hs traffic",
+                                                            "s hs traffic",
+                                                            "derived",
+                                                            NULL,
+                                                            "c ap traffic",
+                                                            "s ap traffic",
+                                                            "exp master"};
+
+/* HkdfLabel of RFC8446 section 7.1, returns its length */
+static Cpa32U tls3PerfLabel(Cpa8U *pOut,
+                            Cpa32U outLen,
+                            const char *pName,
+                            const Cpa8U *pContext,
+                            Cpa32U contextLen)
+{
+    Cpa32U nameLen = strlen(pName);
+    Cpa32U len = 0;
+
+    pOut[len++] = (Cpa8U)(outLen >> 8);
+    pOut[len++] = (Cpa8U)outLen;
+    pOut[len++] = (Cpa8U)(6 + nameLen);
+    memcpy(pOut + len, "tls13 ", 6);
+    len += 6;
+    memcpy(pOut + len, pName, nameLen);
+    len += nameLen;
+    pOut[len++] = (Cpa8U)contextLen;
+    if (0 != contextLen)
+    {
+        memcpy(pOut + len, pContext, contextLen);
+    }
+    return len + contextLen;
+}
+
+/* HKDF-Expand-Label on the host, for outputs of at most one hash */
+static void tls3PerfHostExpandLabel(const tls3_perf_t *pPerf,
+                                    const Cpa8U *pSecret,
+                                    Cpa32U outLen,
+                                    const char *pName,
+                                    const Cpa8U *pContext,
+                                    Cpa32U contextLen,
+                                    Cpa8U *pOut)
+{
+    Cpa8U info[CPA_CY_HKDF_KEY_MAX_LABEL_SZ + 1];
+    Cpa8U block[EVP_MAX_MD_SIZE];
+    Cpa32U len = tls3PerfLabel(info, outLen, pName, pContext, contextLen);
+
+    info[len++] = 1;
+    HMAC(pPerf->pMd,
+         pSecret,
+         pPerf->pSuite->hashLen,
+         info,
+         len,
+         block,
+         NULL);
+    memcpy(pOut, block, outLen);
+}
+
+static void tls3PerfHostExtract(const tls3_perf_t *pPerf,
+                                const Cpa8U *pSalt,
+                                const Cpa8U *pIkm,
+                                Cpa32U ikmLen,
+                                Cpa8U *pOut)
+{
+    HMAC(pPerf->pMd, pSalt, pPerf->pSuite->hashLen, pIkm, ikmLen, pOut, NULL);
+}
+
+static void tls3PerfHostTraffic(const tls3_perf_t *pPerf,
+                                const Cpa8U *pSecret,
+                                const char *pName,
+                                const Cpa8U *pContext,
+                                icp_sal_tls3_secret_t *pTraffic,
+                                CpaBoolean finished)
+{
+    Cpa32U hashLen = pPerf->pSuite->hashLen;
+
+    tls3PerfHostExpandLabel(
+        pPerf, pSecret, hashLen, pName, pContext, hashLen, pTraffic->secret);
+    tls3PerfHostExpandLabel(pPerf,
+                            pTraffic->secret,
+                            pPerf->pSuite->keyLen,
+                            "key",
+                            NULL,
+                            0,
+                            pTraffic->key);
+    tls3PerfHostExpandLabel(pPerf,
+                            pTraffic->secret,
+                            ICP_SAL_TLS3_IV_SZ,
+                            "iv",
+                            NULL,
+                            0,
+                            pTraffic->iv);
+    if (CPA_TRUE == finished)
+    {
+        tls3PerfHostExpandLabel(pPerf,
+                                pTraffic->secret,
+                                hashLen,
+                                "finished",
+                                NULL,
+                                0,
+                                pTraffic->finishedKey);
+    }
+}
+
+/* The key schedule of the inputs of the slots, computed on the host */
+static void tls3PerfHostSchedule(tls3_perf_t *pPerf,
+                                 const icp_sal_tls3_schedule_op_data_t *pIn)
+{
+    icp_sal_tls3_schedule_t *pOut = &pPerf->expected;
+    Cpa8U zeros[ICP_SAL_TLS3_MAX_HASH_SZ] = {0};
+    Cpa8U emptyHash[EVP_MAX_MD_SIZE];
+    Cpa8U derived[ICP_SAL_TLS3_MAX_HASH_SZ];
+    Cpa32U hashLen = pPerf->pSuite->hashLen;
+
+    memset(pOut, 0, sizeof(*pOut));
+    pOut->hashLenInBytes = hashLen;
+    pOut->keyLenInBytes = pPerf->pSuite->keyLen;
+    EVP_Digest(NULL, 0, emptyHash, NULL, pPerf->pMd, NULL);
+
+    tls3PerfHostExtract(pPerf, zeros, zeros, hashLen, pOut->earlySecret);
+    tls3PerfHostExpandLabel(pPerf,
+                            pOut->earlySecret,
+                            hashLen,
+                            "derived",
+                            emptyHash,
+                            hashLen,
+                            derived);
+    tls3PerfHostExtract(pPerf,
+                        derived,
+                        pIn->sharedSecret.pData,
+                        pIn->sharedSecret.dataLenInBytes,
+                        pOut->handshakeSecret);
+    tls3PerfHostTraffic(pPerf,
+                        pOut->handshakeSecret,
+                        "c hs traffic",
+                        pIn->serverHelloHash,
+                        &pOut->clientHandshakeTraffic,
+                        CPA_TRUE);
+    tls3PerfHostTraffic(pPerf,
+                        pOut->handshakeSecret,
+                        "s hs traffic",
+                        pIn->serverHelloHash,
+                        &pOut->serverHandshakeTraffic,
+                        CPA_TRUE);
+    tls3PerfHostExpandLabel(pPerf,
+                            pOut->handshakeSecret,
+                            hashLen,
+                            "derived",
+                            emptyHash,
+                            hashLen,
+                            derived);
+    tls3PerfHostExtract(pPerf, derived, zeros, hashLen, pOut->masterSecret);
+    tls3PerfHostTraffic(pPerf,
+                        pOut->masterSecret,
+                        "c ap traffic",
+                        pIn->serverFinishedHash,
+                        &pOut->clientApplicationTraffic,
+                        CPA_FALSE);
+    tls3PerfHostTraffic(pPerf,
+                        pOut->masterSecret,
+                        "s ap traffic",
+                        pIn->serverFinishedHash,
+                        &pOut->serverApplicationTraffic,
+                        CPA_FALSE);
+    tls3PerfHostExpandLabel(pPerf,
+                            pOut->masterSecret,
+                            hashLen,
+                            "exp master",
+                            pIn->serverFinishedHash,
+                            hashLen,
+                            pOut->exporterMasterSecret);
+}
+
+/* Build the request of the current derivation of the first run */
+static void tls3PerfDerivationBuild(tls3_perf_slot_t *pSlot)
+{
+    tls3_perf_t *pPerf = pSlot->pPerf;
+    CpaCyKeyGenHKDFOpData *pOpData = pSlot->pOpData;
+    icp_sal_tls3_schedule_op_data_t *pIn = &pSlot->scheduleOpData;
+    icp_sal_tls3_schedule_t *pOut = &pSlot->schedule;
+    Cpa32U hashLen = pPerf->pSuite->hashLen;
+    Cpa8U emptyHash[EVP_MAX_MD_SIZE];
+    const Cpa8U *pSecret = NULL;
+    const Cpa8U *pContext = emptyHash;
+
+    memset(pOpData, 0, sizeof(*pOpData));
+    switch (pSlot->step)
+    {
+        case 0:
+        case 2:
+        case 6:
+            pOpData->hkdfKeyOp = CPA_CY_HKDF_KEY_EXTRACT;
+            pOpData->seedLen = hashLen;
+            if (0 != pSlot->step)
+            {
+                memcpy(pOpData->seed, pSlot->derived, hashLen);
+            }
+            pOpData->secretLen = hashLen;
+            if (2 == pSlot->step)
+            {
+                memcpy(pOpData->secret,
+                       pIn->sharedSecret.pData,
+                       pIn->sharedSecret.dataLenInBytes);
+                pOpData->secretLen = pIn->sharedSecret.dataLenInBytes;
+            }
+            return;
+        case 1:
+            pSecret = pOut->earlySecret;
+            break;
+        case 3:
+        case 4:
+            pSecret = pOut->handshakeSecret;
+            pContext = pIn->serverHelloHash;
+            pOpData->label[0].sublabelFlag = CPA_CY_HKDF_SUBLABEL_KEY |
+                                             CPA_CY_HKDF_SUBLABEL_IV |
+                                             CPA_CY_HKDF_SUBLABEL_FINISHED;
+            break;
+        case 5:
+            pSecret = pOut->handshakeSecret;
+            break;
+        default:
+            pSecret = pOut->masterSecret;
+            pContext = pIn->serverFinishedHash;
+            if (9 != pSlot->step)
+            {
+                pOpData->label[0].sublabelFlag =
+                    CPA_CY_HKDF_SUBLABEL_KEY | CPA_CY_HKDF_SUBLABEL_IV;
+            }
+            break;
+    }
+    if (pContext == emptyHash)
+    {
+        EVP_Digest(NULL, 0, emptyHash, NULL, pPerf->pMd, NULL);
+    }
+    pOpData->hkdfKeyOp = CPA_CY_HKDF_KEY_EXPAND_LABEL;
+    memcpy(pOpData->secret, pSecret, hashLen);
+    pOpData->secretLen = hashLen;
+    pOpData->numLabels = 1;
+    pOpData->label[0].labelLen = tls3PerfLabel(pOpData->label[0].label,
+                                               hashLen,
+                                               tls3PerfLabels[pSlot->step],
+                                               pContext,
+                                               hashLen);
+}
+
+/* Store the output of the current derivation of the first run */
+static void tls3PerfDerivationStore(tls3_perf_slot_t *pSlot)
+{
+    icp_sal_tls3_schedule_t *pOut = &pSlot->schedule;
+    icp_sal_tls3_secret_t *pTraffic = NULL;
+    Cpa8U *pData = pSlot->output.pData;
+    Cpa32U hashLen = pSlot->pPerf->pSuite->hashLen;
+    Cpa32U keyLen = pSlot->pPerf->pSuite->keyLen;
+
+    switch (pSlot->step)
+    {
+        case 0:
+            memcpy(pOut->earlySecret, pData, hashLen);
+            return;
+        case 2:
+            memcpy(pOut->handshakeSecret, pData, hashLen);
+            return;
+        case 6:
+            memcpy(pOut->masterSecret, pData, hashLen);
+            return;
+        case 1:
+        case 5:
+            memcpy(pSlot->derived, pData, hashLen);
+            return;
+        case 9:
+            memcpy(pOut->exporterMasterSecret, pData, hashLen);
+            return;
+        case 3:
+            pTraffic = &pOut->clientHandshakeTraffic;
+            break;
+        case 4:
+            pTraffic = &pOut->serverHandshakeTraffic;
+            break;
+        case 7:
+            pTraffic = &pOut->clientApplicationTraffic;
+            break;
+        default:
+            pTraffic = &pOut->serverApplicationTraffic;
+            break;
+    }
+    memcpy(pTraffic->secret, pData, hashLen);
+    pData += hashLen;
+    memcpy(pTraffic->key, pData, keyLen);
+    pData += keyLen;
+    memcpy(pTraffic->iv, pData, ICP_SAL_TLS3_IV_SZ);
+    pData += ICP_SAL_TLS3_IV_SZ;
+    if (pSlot->step < 7)
+    {
+        memcpy(pTraffic->finishedKey, pData, hashLen);
+    }
+}
+
+static void tls3PerfDerivationCallback(void *pCallbackTag,
+                                       CpaStatus status,
+                                       void *pOpData,
+                                       CpaFlatBuffer *pOut)
+{
+    tls3_perf_slot_t *pSlot = (tls3_perf_slot_t *)pCallbackTag;
+
+    pSlot->status = status;
+    pSlot->ready = CPA_TRUE;
+}
+
+static void tls3PerfScheduleCallback(void *pCallbackTag, CpaStatus status)
+{
+    tls3_perf_slot_t *pSlot = (tls3_perf_slot_t *)pCallbackTag;
+
+    pSlot->status = status;
+    pSlot->ready = CPA_TRUE;
+}
+
+/* Send the next request of a slot, which starts a handshake when the slot
+ * is idle */
+static CpaStatus tls3PerfSlotSend(tls3_perf_slot_t *pSlot,
+                                  CpaBoolean useSchedule)
+{
+    tls3_perf_t *pPerf = pSlot->pPerf;
+
+    if (CPA_TRUE == useSchedule)
+    {
+        return icp_sal_CyKeyGenTls3Schedule(pPerf->instanceHandle,
+                                            tls3PerfScheduleCallback,
+                                            pSlot,
+                                            &pSlot->scheduleOpData,
+                                            pSlot->pCtx,
+                                            &pSlot->schedule);
+    }
+
+    tls3PerfDerivationBuild(pSlot);
+    pSlot->output.dataLenInBytes = TLS3_PERF_OUTPUT_SZ;
+    return cpaCyKeyGenTls3(pPerf->instanceHandle,
+                           tls3PerfDerivationCallback,
+                           pSlot,
+                           pSlot->pOpData,
+                           pPerf->pSuite->cipherSuite,
+                           &pSlot->output);
+}
+
+static CpaStatus tls3PerfSlotCheck(const tls3_perf_slot_t *pSlot)
+{
+    const icp_sal_tls3_schedule_t *pGot = &pSlot->schedule;
+    const icp_sal_tls3_schedule_t *pWant = &pSlot->pPerf->expected;
+    Cpa32U hashLen = pSlot->pPerf->pSuite->hashLen;
+
+    if (memcmp(pGot->earlySecret, pWant->earlySecret, hashLen) ||
+        memcmp(pGot->handshakeSecret, pWant->handshakeSecret, hashLen) ||
+        memcmp(pGot->masterSecret, pWant->masterSecret, hashLen) ||
+        memcmp(pGot->exporterMasterSecret,
+               pWant->exporterMasterSecret,
+               hashLen) ||
+        memcmp(&pGot->clientHandshakeTraffic,
+               &pWant->clientHandshakeTraffic,
+               sizeof(icp_sal_tls3_secret_t)) ||
+        memcmp(&pGot->serverHandshakeTraffic,
+               &pWant->serverHandshakeTraffic,
+               sizeof(icp_sal_tls3_secret_t)) ||
+        memcmp(&pGot->clientApplicationTraffic,
+               &pWant->clientApplicationTraffic,
+               sizeof(icp_sal_tls3_secret_t)) ||
+        memcmp(&pGot->serverApplicationTraffic,
+               &pWant->serverApplicationTraffic,
+               sizeof(icp_sal_tls3_secret_t)))
+    {
+        return CPA_STATUS_FAIL;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Run numHandshakes handshakes, returning the elapsed cycles */
+static CpaStatus tls3PerfRun(tls3_perf_t *pPerf,
+                             CpaBoolean useSchedule,
+                             perf_cycles_t *pCycles)
+{
+    tls3_perf_slot_t *pSlot = NULL;
+    perf_cycles_t timeout =
+        (perf_cycles_t)sampleCodeGetCpuFreq() * SAMPLE_CODE_THOUSAND *
+        TLS3_PERF_TIMEOUT_SEC;
+    perf_cycles_t start = 0;
+    perf_cycles_t lastProgress = 0;
+    Cpa32U started = 0;
+    Cpa32U completed = 0;
+    Cpa32U numBusy = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaStatus sendStatus = CPA_STATUS_SUCCESS;
+
+    for (i = 0; i < TLS3_PERF_INFLIGHT; i++)
+    {
+        pPerf->slots[i].busy = CPA_FALSE;
+        pPerf->slots[i].resend = CPA_FALSE;
+        pPerf->slots[i].ready = CPA_FALSE;
+    }
+
+    start = sampleCodeTimestamp();
+    lastProgress = start;
+    while (completed < pPerf->numHandshakes && CPA_STATUS_SUCCESS == status)
+    {
+        for (i = 0; i < TLS3_PERF_INFLIGHT && CPA_STATUS_SUCCESS == status;
+             i++)
+        {
+            pSlot = &pPerf->slots[i];
+            if (CPA_TRUE == pSlot->busy && CPA_TRUE != pSlot->ready &&
+                CPA_TRUE != pSlot->resend)
+            {
+                continue;
+            }
+            if (CPA_TRUE == pSlot->busy && CPA_TRUE == pSlot->ready)
+            {
+                /* A derivation or a whole schedule completed */
+                pSlot->ready = CPA_FALSE;
+                lastProgress = sampleCodeTimestamp();
+                if (CPA_STATUS_SUCCESS != pSlot->status)
+                {
+                    PRINT_ERR("Derivation failed, status: %d\n",
+                              pSlot->status);
+                    status = CPA_STATUS_FAIL;
+                    pSlot->busy = CPA_FALSE;
+                    numBusy--;
+                    break;
+                }
+                if (CPA_TRUE != useSchedule)
+                {
+                    tls3PerfDerivationStore(pSlot);
+                }
+                if (CPA_TRUE == useSchedule ||
+                    TLS3_PERF_DERIVATIONS == ++pSlot->step)
+                {
+                    pSlot->busy = CPA_FALSE;
+                    numBusy--;
+                    completed++;
+                    status = tls3PerfSlotCheck(pSlot);
+                    if (CPA_STATUS_SUCCESS != status)
+                    {
+                        PRINT_ERR("Wrong secrets derived\n");
+                        break;
+                    }
+                }
+            }
+            if (CPA_TRUE != pSlot->busy)
+            {
+                if (started == pPerf->numHandshakes)
+                {
+                    continue;
+                }
+                memset(&pSlot->schedule, 0, sizeof(pSlot->schedule));
+                pSlot->step = 0;
+            }
+            pSlot->resend = CPA_FALSE;
+            sendStatus = tls3PerfSlotSend(pSlot, useSchedule);
+            if (CPA_STATUS_RETRY == sendStatus)
+            {
+                /* Ring full, the slot is picked up again after polling */
+                pSlot->resend = pSlot->busy;
+                break;
+            }
+            if (CPA_STATUS_SUCCESS != sendStatus)
+            {
+                PRINT_ERR("Failed to send, status: %d\n", sendStatus);
+                status = sendStatus;
+                break;
+            }
+            if (CPA_TRUE != pSlot->busy)
+            {
+                pSlot->busy = CPA_TRUE;
+                numBusy++;
+                started++;
+            }
+        }
+        icp_sal_CyPollInstance(pPerf->instanceHandle, 0);
+        if (sampleCodeTimestamp() - lastProgress > timeout)
+        {
+            PRINT_ERR("Timed out waiting for derivations\n");
+            status = CPA_STATUS_FAIL;
+        }
+    }
+    *pCycles = sampleCodeTimestamp() - start;
+
+    /* Requests in flight after a failure reference the slots */
+    lastProgress = sampleCodeTimestamp();
+    while (numBusy > 0 && sampleCodeTimestamp() - lastProgress < timeout)
+    {
+        icp_sal_CyPollInstance(pPerf->instanceHandle, 0);
+        for (i = 0; i < TLS3_PERF_INFLIGHT; i++)
+        {
+            pSlot = &pPerf->slots[i];
+            if (CPA_TRUE == pSlot->busy &&
+                (CPA_TRUE == pSlot->ready || CPA_TRUE == pSlot->resend))
+            {
+                pSlot->busy = CPA_FALSE;
+                numBusy--;
+            }
+        }
+    }
+
+    return (0 == numBusy) ? status : CPA_STATUS_FAIL;
+}
+
+static void tls3PerfFree(tls3_perf_t *pPerf)
+{
+    tls3_perf_slot_t *pSlot = NULL;
+    Cpa32U i = 0;
+
+    for (i = 0; i < TLS3_PERF_INFLIGHT; i++)
+    {
+        pSlot = &pPerf->slots[i];
+        if (NULL != pSlot->pOpData)
+        {
+            qaeMemFreeNUMA((void **)&pSlot->pOpData);
+        }
+        if (NULL != pSlot->output.pData)
+        {
+            qaeMemFreeNUMA((void **)&pSlot->output.pData);
+        }
+        if (NULL != pSlot->pCtx)
+        {
+            qaeMemFreeNUMA(&pSlot->pCtx);
+        }
+    }
+}
+
+static CpaStatus tls3PerfPrepare(tls3_perf_t *pPerf)
+{
+    static Cpa8U sharedSecret[TLS3_PERF_SHARED_SECRET_SZ];
+    icp_sal_tls3_schedule_op_data_t inputs;
+    tls3_perf_slot_t *pSlot = NULL;
+    Cpa32U ctxSize = 0;
+    Cpa32U node = 0;
+    Cpa32U i = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    status = sampleCodeCyGetNode(pPerf->instanceHandle, &node);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    status = icp_sal_CyKeyScheduleCtxGetSize(pPerf->instanceHandle, &ctxSize);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("icp_sal_CyKeyScheduleCtxGetSize error, status: %d\n",
+                  status);
+        return status;
+    }
+
+    /* Every handshake has the same inputs, so one host computation checks
+     * all of them */
+    memset(&inputs, 0, sizeof(inputs));
+    inputs.cipherSuite = pPerf->pSuite->cipherSuite;
+    generateRandomData(sharedSecret, sizeof(sharedSecret));
+    generateRandomData(inputs.serverHelloHash, ICP_SAL_TLS3_MAX_HASH_SZ);
+    generateRandomData(inputs.serverFinishedHash, ICP_SAL_TLS3_MAX_HASH_SZ);
+    inputs.sharedSecret.pData = sharedSecret;
+    inputs.sharedSecret.dataLenInBytes = TLS3_PERF_SHARED_SECRET_SZ;
+    tls3PerfHostSchedule(pPerf, &inputs);
+
+    for (i = 0; i < TLS3_PERF_INFLIGHT; i++)
+    {
+        pSlot = &pPerf->slots[i];
+        pSlot->pPerf = pPerf;
+        pSlot->scheduleOpData = inputs;
+        pSlot->pOpData = qaeMemAllocNUMA(
+            sizeof(CpaCyKeyGenHKDFOpData), node, BYTE_ALIGNMENT_64);
+        pSlot->output.pData =
+            qaeMemAllocNUMA(TLS3_PERF_OUTPUT_SZ, node, BYTE_ALIGNMENT_64);
+        pSlot->pCtx = qaeMemAllocNUMA(ctxSize, node, BYTE_ALIGNMENT_64);
+        if (NULL == pSlot->pOpData || NULL == pSlot->output.pData ||
+            NULL == pSlot->pCtx)
+        {
+            PRINT_ERR("Could not allocate handshake memory\n");
+            return CPA_STATUS_FAIL;
+        }
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static Cpa64U tls3PerfRate(Cpa32U count, perf_cycles_t cycles)
+{
+    if (0 == cycles)
+    {
+        return 0;
+    }
+    return (Cpa64U)count * sampleCodeGetCpuFreq() * SAMPLE_CODE_THOUSAND /
+           cycles;
+}
+
+static CpaStatus tls3PerfRunSuite(CpaInstanceHandle instanceHandle,
+                                  const tls3_perf_suite_t *pSuite,
+                                  Cpa32U numHandshakes)
+{
+    tls3_perf_t *pPerf = NULL;
+    perf_cycles_t cyclesDerivation = 0;
+    perf_cycles_t cyclesSchedule = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pPerf = qaeMemAlloc(sizeof(tls3_perf_t));
+    if (NULL == pPerf)
+    {
+        PRINT_ERR("Could not allocate test memory\n");
+        return CPA_STATUS_FAIL;
+    }
+    memset(pPerf, 0, sizeof(tls3_perf_t));
+    pPerf->instanceHandle = instanceHandle;
+    pPerf->pSuite = pSuite;
+    pPerf->pMd = (48 == pSuite->hashLen) ? EVP_sha384() : EVP_sha256();
+    pPerf->numHandshakes = numHandshakes;
+
+    status = tls3PerfPrepare(pPerf);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = tls3PerfRun(pPerf, CPA_FALSE, &cyclesDerivation);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = tls3PerfRun(pPerf, CPA_TRUE, &cyclesSchedule);
+    }
+    tls3PerfFree(pPerf);
+    qaeMemFree((void **)&pPerf);
+
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        PRINT("%-24s %14llu %14llu\n",
+              pSuite->name,
+              (unsigned long long)tls3PerfRate(numHandshakes,
+                                               cyclesDerivation),
+              (unsigned long long)tls3PerfRate(numHandshakes,
+                                               cyclesSchedule));
+    }
+    else
+    {
+        PRINT_ERR("%s key schedule test failed, status: %d\n",
+                  pSuite->name,
+                  status);
+    }
+    return status;
+}
+
+CpaStatus tls3ScheduleRateTest(Cpa32U numHandshakes)
+{
+    CpaCyCapabilitiesInfo capInfo = {0};
+    CpaInstanceInfo2 instanceInfo = {0};
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    CpaStatus retStatus = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+    /* Calibrates the cycle counter used to turn cycles into rates */
+    getCPUSpeed();
+
+    status = startCyServices();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Error starting crypto services\n");
+        return status;
+    }
+    status = cpaCyQueryCapabilities(cyInstances_g[0], &capInfo);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = cpaCyInstanceGetInfo2(cyInstances_g[0], &instanceInfo);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        PRINT_ERR("Could not query crypto instance 0, status: %d\n", status);
+        stopCyServices();
+        return status;
+    }
+    if (CPA_TRUE != capInfo.hkdfSupported ||
+        CPA_TRUE != instanceInfo.isPolled)
+    {
+        /* The runs poll the instance themselves */
+        PRINT("TLS 1.3 key schedule test needs a polled instance with "
+              "HKDF, skipping\n");
+        return stopCyServices();
+    }
+
+    PRINT("\nTLS 1.3 handshakes per second, %u handshakes, %u in flight, "
+          "instance 0\n",
+          numHandshakes,
+          TLS3_PERF_INFLIGHT);
+    PRINT("%-24s %14s %14s\n",
+          "Cipher suite",
+          "Per derivation",
+          "Key schedule");
+    for (i = 0; i < sizeof(tls3PerfSuites) / sizeof(tls3PerfSuites[0]); i++)
+    {
+        status = tls3PerfRunSuite(
+            cyInstances_g[0], &tls3PerfSuites[i], numHandshakes);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            retStatus = CPA_STATUS_FAIL;
+        }
+    }
+
+    if (CPA_STATUS_SUCCESS != stopCyServices())
+    {
+        retStatus = CPA_STATUS_FAIL;
+    }
+    return retStatus;
+}
+EXPORT_SYMBOL(tls3ScheduleRateTest);
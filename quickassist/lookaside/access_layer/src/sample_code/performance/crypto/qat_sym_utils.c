@@ -63,6 +63,7 @@
 #include "cpa_dc.h"
 #include "../common/qat_perf_buffer_utils.h"
 #include "qat_compression_main.h"
+#include "qat_perf_openloop.h"
 
 #define EVEN_NUMBER (2)
 
@@ -740,6 +741,7 @@ CpaStatus qatSymPerform(symmetric_test_params_t *setup,
 
     /*preset the number of ops we plan to submit*/
     pSymData->numOperations = (Cpa64U)setup->numBuffLists * setup->numLoops;
+    qatOpenLoopReset(pSymData);
 
     /* Init the semaphore used in the callback */
     sampleCodeSemaphoreInit(&pSymData->comp, 0);
@@ -772,6 +774,7 @@ CpaStatus qatSymPerform(symmetric_test_params_t *setup,
             /* When the callback returns it will increment the responses
              * counter and test if its equal to NUM_OPERATIONS, in that
              * case all responses have been successfully received. */
+            qatOpenLoopPace(setup->performanceStats);
             do
             {
                 qatStartLatencyMeasurement(setup->performanceStats,
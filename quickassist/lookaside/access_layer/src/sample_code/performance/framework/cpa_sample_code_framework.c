@@ -97,6 +97,10 @@
 
 #include "cpa_sample_code_framework.h"
 #include "cpa_sample_code_crypto_utils.h"
+#include "qat_perf_histogram.h"
+#include "qat_perf_openloop.h"
+#include "qat_perf_poll_engine.h"
+#include "qat_perf_results.h"
 
 /******************************************************************************
  * GLOBAL VARIABLES
@@ -239,6 +243,7 @@ volatile CpaBoolean swWrite_g = CPA_FALSE;
 
 
 volatile CpaBoolean isNsRequest_g = CPA_FALSE;
+volatile CpaBoolean isNsPrepared_g = CPA_FALSE;
 int verboseOutput = 1;
 
 CpaStatus setHwVerify(CpaBoolean val);
@@ -260,6 +265,40 @@ CpaStatus setDcNsFlag(CpaBoolean val)
 }
 EXPORT_SYMBOL(isNsRequest_g);
 EXPORT_SYMBOL(setDcNsFlag);
+
+CpaStatus setDcNsPreparedFlag(CpaBoolean val)
+{
+    if (val != 0)
+    {
+        isNsPrepared_g = CPA_TRUE;
+    }
+    else
+    {
+        isNsPrepared_g = CPA_FALSE;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+EXPORT_SYMBOL(isNsPrepared_g);
+EXPORT_SYMBOL(setDcNsPreparedFlag);
+
+/* Chaining requests kept in flight with batched submission, 0 to submit
+ * them one at a time */
+volatile Cpa32U dcChainDepth_g = 0;
+
+CpaStatus setDcChainDepth(Cpa32U depth)
+{
+    if (depth > DC_CHAIN_MAX_DEPTH)
+    {
+        PRINT_ERR("Chaining depth %u is above the maximum %u\n",
+                  depth,
+                  DC_CHAIN_MAX_DEPTH);
+        return CPA_STATUS_INVALID_PARAM;
+    }
+    dcChainDepth_g = depth;
+    return CPA_STATUS_SUCCESS;
+}
+EXPORT_SYMBOL(dcChainDepth_g);
+EXPORT_SYMBOL(setDcChainDepth);
 CpaStatus setDataIntegrity(CpaBoolean val)
 {
     dataIntegrity_g = val;
@@ -547,9 +586,13 @@ volatile CpaBoolean stopTestsIsEnabled_g = CPA_FALSE;
  */
 void saveClearRestorePerfStats(perf_data_t *perf)
 {
+    struct qat_perf_histogram_s *latencyHistogram = perf->latencyHistogram;
+    struct qat_perf_openloop_s *openLoop = perf->openLoop;
 
     memset(perf, 0, sizeof(perf_data_t));
 
+    perf->latencyHistogram = latencyHistogram;
+    perf->openLoop = openLoop;
 }
 
 sample_code_thread_t stress_test_threads_g;
@@ -770,6 +813,8 @@ CpaStatus startThreads(void)
             {
                 if (NULL != perfStats_g[i])
                 {
+                    qatLatencyHistogramsFree(&testSetupData_g[i]);
+                    qatOpenLoopFree(&testSetupData_g[i]);
                     qaeMemFree((void **)&perfStats_g[i]);
                 }
             }
@@ -852,7 +897,12 @@ CpaStatus waitForThreadCompletion(void)
             statsPrintFunc = *(testSetupData_g[i].statsPrintFunc);
             if (statsPrintFunc != NULL)
             {
+                qatPerfResultsBegin(&testSetupData_g[i]);
                 statusPrintFunc = statsPrintFunc(&testSetupData_g[i]);
+                qatPerfResultsReport(&testSetupData_g[i], statusPrintFunc);
+                qatLatencyHistogramsReport(&testSetupData_g[i]);
+                qatOpenLoopReport(&testSetupData_g[i]);
+                qatPerfPollEngineReport(&testSetupData_g[i]);
             }
             else
             {
@@ -861,6 +911,8 @@ CpaStatus waitForThreadCompletion(void)
             }
             if (NULL != perfStats_g[i])
             {
+                qatLatencyHistogramsFree(&testSetupData_g[i]);
+                qatOpenLoopFree(&testSetupData_g[i]);
                 qaeMemFree((void **)&perfStats_g[i]);
             }
             if (i < testTypeCount_g - 1)
@@ -903,6 +955,8 @@ void threadExitCleanup(void)
     {
         if (NULL != perfStats_g[i])
         {
+            qatLatencyHistogramsFree(&testSetupData_g[i]);
+            qatOpenLoopFree(&testSetupData_g[i]);
             qaeMemFree((void **)&perfStats_g[i]);
         }
     }
@@ -958,6 +1012,12 @@ CpaStatus initPerfStats(Cpa32U testTypeIndex, Cpa32U numberOfThreads)
                   testTypeIndex);
         status = CPA_STATUS_FAIL;
     }
+    else
+    {
+        memset(perfStats_g[testTypeIndex],
+               0,
+               sizeof(perf_data_t) * numberOfThreads);
+    }
     return status;
 }
 
@@ -1243,7 +1303,14 @@ void killCreatedThreads(Cpa32U numThreadsToKill)
 
 void clearPerfStats(perf_data_t *stats)
 {
+    /* the latency histogram and open-loop state are reported and released
+     * by the framework once the stats of the test have been printed */
+    struct qat_perf_histogram_s *latencyHistogram = stats->latencyHistogram;
+    struct qat_perf_openloop_s *openLoop = stats->openLoop;
+
     memset(stats, 0, sizeof(perf_data_t));
+    stats->latencyHistogram = latencyHistogram;
+    stats->openLoop = openLoop;
 }
 
 void getLongestCycleCount(perf_data_t *dest, perf_data_t *src[], Cpa32U count)
@@ -234,6 +234,13 @@ CpaStatus setUseStaticPrime(int val);
 
 CpaStatus setDcNsFlag(CpaBoolean val);
 extern volatile CpaBoolean isNsRequest_g;
+/* With the NS flag set, submit through icp_sal_DcNsPrepare handles */
+CpaStatus setDcNsPreparedFlag(CpaBoolean val);
+extern volatile CpaBoolean isNsPrepared_g;
+/* Keep up to depth chaining requests in flight, submitted in batches */
+#define DC_CHAIN_MAX_DEPTH (256)
+CpaStatus setDcChainDepth(Cpa32U depth);
+extern volatile Cpa32U dcChainDepth_g;
 CpaStatus setDataIntegrity(CpaBoolean val);
 CpaStatus setDataIntegrityVerify(CpaBoolean val);
 CpaStatus printReliability(void);
@@ -224,6 +224,12 @@ typedef struct perf_data_s
     perf_cycles_t minLatency;
     perf_cycles_t aveLatency;
     perf_cycles_t maxLatency;
+    /* log-linear histogram of the sampled latencies, allocated on first
+     * use, see qat_perf_histogram.h */
+    struct qat_perf_histogram_s *latencyHistogram;
+    /* offered-load schedule and per step statistics, allocated on first
+     * use, see qat_perf_openloop.h */
+    struct qat_perf_openloop_s *openLoop;
     CpaFlatBuffer *expectedResults;
     Cpa64U preTestRecoveryCount;
     Cpa64U postTestRecoveryCount;
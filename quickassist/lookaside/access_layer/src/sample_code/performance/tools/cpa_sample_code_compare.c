@@ -0,0 +1,559 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file cpa_sample_code_compare.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Compare two result files written by cpa_sample_code resultsDump=1
+ *      and report the tests whose throughput dropped or whose latency rose
+ *      by more than a threshold.
+ *
+ *      Tests are matched on service, configuration, packet size and number
+ *      of threads. When a file holds several records of the same test (for
+ *      example the results of several runs appended to the same file) the
+ *      last one is used.
+ *
+ *      Usage: cpa_sample_code_compare [-t pct] [-l pct] baseline current
+ *          -t  allowed throughput drop in percent (default 5)
+ *          -l  allowed latency increase in percent (default: as -t)
+ *
+ *      Exits with 0 when no regression is found, 1 when at least one test
+ *      regressed, failed or is missing from the current results and 2 on
+ *      error.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define COMPARE_LINE_LEN (8192)
+#define COMPARE_KEY_LEN (512)
+#define COMPARE_NAME_LEN (64)
+#define COMPARE_DEFAULT_THRESHOLD (5.0)
+
+#define COMPARE_EXIT_OK (0)
+#define COMPARE_EXIT_REGRESSION (1)
+#define COMPARE_EXIT_ERROR (2)
+
+/* Metrics compared between the two files. For throughput like metrics a
+ * lower value is worse, for latency and cost a higher one */
+typedef struct compare_metric_s
+{
+    const char *name;
+    int higherIsBetter;
+} compare_metric_t;
+
+static const compare_metric_t compareMetrics_g[] = {
+    {"throughput_mbps", 1},
+    {"ops_per_sec", 1},
+    {"cycles_per_op", 0},
+    {"latency_ns.mean", 0},
+    {"latency_ns.p50", 0},
+    {"latency_ns.p99", 0},
+    {"latency_ns.p99.9", 0}};
+
+#define COMPARE_NUM_METRICS                                                    \
+    (sizeof(compareMetrics_g) / sizeof(compareMetrics_g[0]))
+
+typedef struct compare_record_s
+{
+    char key[COMPARE_KEY_LEN];
+    int passed;
+    int hasMetric[COMPARE_NUM_METRICS];
+    double metric[COMPARE_NUM_METRICS];
+} compare_record_t;
+
+typedef struct compare_file_s
+{
+    compare_record_t *records;
+    size_t count;
+    size_t size;
+} compare_file_t;
+
+/* State of the parser of one record. The records are flat JSON objects
+ * apart from the config and latency_ns members, nested members are
+ * reported as "parent.member" */
+typedef struct compare_parser_s
+{
+    const char *pos;
+    char service[COMPARE_NAME_LEN];
+    char config[COMPARE_KEY_LEN];
+    char packetSize[COMPARE_NAME_LEN];
+    char threads[COMPARE_NAME_LEN];
+    compare_record_t *pRec;
+} compare_parser_t;
+
+static void skipSpaces(compare_parser_t *pParser)
+{
+    while (' ' == *pParser->pos || '\t' == *pParser->pos ||
+           '\r' == *pParser->pos || '\n' == *pParser->pos)
+    {
+        pParser->pos++;
+    }
+}
+
+static int parseString(compare_parser_t *pParser, char *pOut, size_t len)
+{
+    size_t i = 0;
+
+    if ('"' != *pParser->pos)
+    {
+        return -1;
+    }
+    pParser->pos++;
+    while ('"' != *pParser->pos)
+    {
+        if ('\0' == *pParser->pos)
+        {
+            return -1;
+        }
+        if ('\\' == *pParser->pos && '\0' != pParser->pos[1])
+        {
+            pParser->pos++;
+        }
+        if (i + 1 < len)
+        {
+            pOut[i++] = *pParser->pos;
+        }
+        pParser->pos++;
+    }
+    pOut[i] = '\0';
+    pParser->pos++;
+    return 0;
+}
+
+/* Copy a number token, keeping its text for the test key */
+static int parseNumber(compare_parser_t *pParser, char *pOut, size_t len)
+{
+    size_t i = 0;
+
+    while (('0' <= *pParser->pos && *pParser->pos <= '9') ||
+           '-' == *pParser->pos || '+' == *pParser->pos ||
+           '.' == *pParser->pos || 'e' == *pParser->pos ||
+           'E' == *pParser->pos)
+    {
+        if (i + 1 < len)
+        {
+            pOut[i++] = *pParser->pos;
+        }
+        pParser->pos++;
+    }
+    pOut[i] = '\0';
+    return (0 == i) ? -1 : 0;
+}
+
+static void appendKey(char *pKey, const char *name, const char *value)
+{
+    size_t used = strlen(pKey);
+
+    snprintf(pKey + used,
+             COMPARE_KEY_LEN - used,
+             "%s%s=%s",
+             (0 == used) ? "" : ",",
+             name,
+             value);
+}
+
+static void storeMember(compare_parser_t *pParser,
+                        const char *parent,
+                        const char *name,
+                        const char *value,
+                        int isString)
+{
+    compare_record_t *pRec = pParser->pRec;
+    char fullName[COMPARE_NAME_LEN * 2];
+    size_t i = 0;
+
+    if (NULL != parent)
+    {
+        snprintf(fullName, sizeof(fullName), "%s.%s", parent, name);
+        if (0 == strcmp(parent, "config"))
+        {
+            appendKey(pParser->config, name, value);
+            return;
+        }
+    }
+    else
+    {
+        snprintf(fullName, sizeof(fullName), "%s", name);
+    }
+
+    if (0 == strcmp(fullName, "service"))
+    {
+        snprintf(pParser->service, COMPARE_NAME_LEN, "%s", value);
+    }
+    else if (0 == strcmp(fullName, "packet_size"))
+    {
+        snprintf(pParser->packetSize, COMPARE_NAME_LEN, "%s", value);
+    }
+    else if (0 == strcmp(fullName, "threads"))
+    {
+        snprintf(pParser->threads, COMPARE_NAME_LEN, "%s", value);
+    }
+    else if (0 == strcmp(fullName, "status"))
+    {
+        pRec->passed = (0 == strcmp(value, "pass"));
+    }
+    else if (!isString)
+    {
+        for (i = 0; i < COMPARE_NUM_METRICS; i++)
+        {
+            if (0 == strcmp(fullName, compareMetrics_g[i].name))
+            {
+                pRec->hasMetric[i] = 1;
+                pRec->metric[i] = strtod(value, NULL);
+            }
+        }
+    }
+}
+
+static int parseObject(compare_parser_t *pParser, const char *parent)
+{
+    char name[COMPARE_NAME_LEN];
+    char value[COMPARE_NAME_LEN];
+
+    skipSpaces(pParser);
+    if ('{' != *pParser->pos)
+    {
+        return -1;
+    }
+    pParser->pos++;
+    skipSpaces(pParser);
+    if ('}' == *pParser->pos)
+    {
+        pParser->pos++;
+        return 0;
+    }
+    for (;;)
+    {
+        skipSpaces(pParser);
+        if (0 != parseString(pParser, name, sizeof(name)))
+        {
+            return -1;
+        }
+        skipSpaces(pParser);
+        if (':' != *pParser->pos)
+        {
+            return -1;
+        }
+        pParser->pos++;
+        skipSpaces(pParser);
+        if ('{' == *pParser->pos)
+        {
+            /* Only one level of nesting is written by the sample code */
+            if (NULL != parent || 0 != parseObject(pParser, name))
+            {
+                return -1;
+            }
+        }
+        else if ('"' == *pParser->pos)
+        {
+            if (0 != parseString(pParser, value, sizeof(value)))
+            {
+                return -1;
+            }
+            storeMember(pParser, parent, name, value, 1);
+        }
+        else
+        {
+            if (0 != parseNumber(pParser, value, sizeof(value)))
+            {
+                return -1;
+            }
+            storeMember(pParser, parent, name, value, 0);
+        }
+        skipSpaces(pParser);
+        if (',' == *pParser->pos)
+        {
+            pParser->pos++;
+            continue;
+        }
+        if ('}' == *pParser->pos)
+        {
+            pParser->pos++;
+            return 0;
+        }
+        return -1;
+    }
+}
+
+static compare_record_t *findRecord(compare_file_t *pFile, const char *key)
+{
+    size_t i = 0;
+
+    for (i = 0; i < pFile->count; i++)
+    {
+        if (0 == strcmp(pFile->records[i].key, key))
+        {
+            return &pFile->records[i];
+        }
+    }
+    return NULL;
+}
+
+static int addRecord(compare_file_t *pFile, const compare_record_t *pNew)
+{
+    compare_record_t *pRec = findRecord(pFile, pNew->key);
+
+    if (NULL == pRec)
+    {
+        if (pFile->count == pFile->size)
+        {
+            size_t newSize = (0 == pFile->size) ? 64 : pFile->size * 2;
+            compare_record_t *pRecords =
+                realloc(pFile->records, newSize * sizeof(compare_record_t));
+
+            if (NULL == pRecords)
+            {
+                return -1;
+            }
+            pFile->records = pRecords;
+            pFile->size = newSize;
+        }
+        pRec = &pFile->records[pFile->count++];
+    }
+    *pRec = *pNew;
+    return 0;
+}
+
+static int loadResults(const char *fileName, compare_file_t *pFile)
+{
+    FILE *fp = fopen(fileName, "r");
+    char *line = NULL;
+    compare_record_t rec;
+    compare_parser_t parser;
+    unsigned int lineNumber = 0;
+    int ret = 0;
+
+    if (NULL == fp)
+    {
+        fprintf(stderr, "Could not open %s\n", fileName);
+        return -1;
+    }
+    line = malloc(COMPARE_LINE_LEN);
+    if (NULL == line)
+    {
+        fclose(fp);
+        return -1;
+    }
+    while (NULL != fgets(line, COMPARE_LINE_LEN, fp))
+    {
+        lineNumber++;
+        memset(&rec, 0, sizeof(rec));
+        memset(&parser, 0, sizeof(parser));
+        parser.pos = line;
+        parser.pRec = &rec;
+        skipSpaces(&parser);
+        if ('\0' == *parser.pos)
+        {
+            continue;
+        }
+        if (0 != parseObject(&parser, NULL))
+        {
+            fprintf(stderr,
+                    "%s:%u: skipping malformed record\n",
+                    fileName,
+                    lineNumber);
+            continue;
+        }
+        snprintf(rec.key, COMPARE_KEY_LEN, "%s", parser.service);
+        appendKey(rec.key, "size", parser.packetSize);
+        appendKey(rec.key, "threads", parser.threads);
+        if ('\0' != parser.config[0])
+        {
+            appendKey(rec.key, "config", parser.config);
+        }
+        if (0 != addRecord(pFile, &rec))
+        {
+            fprintf(stderr, "Out of memory reading %s\n", fileName);
+            ret = -1;
+            break;
+        }
+    }
+    free(line);
+    fclose(fp);
+    return ret;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [-t pct] [-l pct] baseline current\n"
+            "  -t  allowed throughput drop in percent (default %.0f)\n"
+            "  -l  allowed latency increase in percent (default: as -t)\n",
+            program,
+            COMPARE_DEFAULT_THRESHOLD);
+}
+
+int main(int argc, char *argv[])
+{
+    compare_file_t baseline = {0};
+    compare_file_t current = {0};
+    compare_record_t *pBase = NULL;
+    compare_record_t *pCur = NULL;
+    double throughputThreshold = COMPARE_DEFAULT_THRESHOLD;
+    double latencyThreshold = -1.0;
+    double threshold = 0;
+    double change = 0;
+    unsigned int regressions = 0;
+    unsigned int missing = 0;
+    unsigned int compared = 0;
+    size_t i = 0;
+    size_t m = 0;
+    int opt = 0;
+    int worse = 0;
+
+    while (-1 != (opt = getopt(argc, argv, "t:l:h")))
+    {
+        switch (opt)
+        {
+            case 't':
+                throughputThreshold = strtod(optarg, NULL);
+                break;
+            case 'l':
+                latencyThreshold = strtod(optarg, NULL);
+                break;
+            default:
+                usage(argv[0]);
+                return COMPARE_EXIT_ERROR;
+        }
+    }
+    if (argc - optind != 2 || throughputThreshold < 0)
+    {
+        usage(argv[0]);
+        return COMPARE_EXIT_ERROR;
+    }
+    if (latencyThreshold < 0)
+    {
+        latencyThreshold = throughputThreshold;
+    }
+    if (0 != loadResults(argv[optind], &baseline) ||
+        0 != loadResults(argv[optind + 1], &current))
+    {
+        free(baseline.records);
+        free(current.records);
+        return COMPARE_EXIT_ERROR;
+    }
+
+    for (i = 0; i < baseline.count; i++)
+    {
+        pBase = &baseline.records[i];
+        pCur = findRecord(&current, pBase->key);
+        if (NULL == pCur)
+        {
+            printf("MISSING    %s\n", pBase->key);
+            missing++;
+            continue;
+        }
+        compared++;
+        if (!pCur->passed)
+        {
+            printf("FAILED     %s\n", pCur->key);
+            regressions++;
+            continue;
+        }
+        for (m = 0; m < COMPARE_NUM_METRICS; m++)
+        {
+            if (!pBase->hasMetric[m] || !pCur->hasMetric[m] ||
+                0 == pBase->metric[m])
+            {
+                continue;
+            }
+            change = (pCur->metric[m] - pBase->metric[m]) * 100.0 /
+                     pBase->metric[m];
+            if (compareMetrics_g[m].higherIsBetter)
+            {
+                threshold = throughputThreshold;
+                worse = (-change > threshold);
+            }
+            else
+            {
+                threshold = latencyThreshold;
+                worse = (change > threshold);
+            }
+            if (worse)
+            {
+                printf("REGRESSION %s: %s %.0f -> %.0f (%+.1f%%)\n",
+                       pCur->key,
+                       compareMetrics_g[m].name,
+                       pBase->metric[m],
+                       pCur->metric[m],
+                       change);
+                regressions++;
+            }
+        }
+    }
+    printf("%u tests compared, %u regressions, %u missing, %u new\n",
+           compared,
+           regressions,
+           missing,
+           (unsigned int)(current.count - compared));
+    free(baseline.records);
+    free(current.records);
+    return (0 != regressions || 0 != missing) ? COMPARE_EXIT_REGRESSION
+                                              : COMPARE_EXIT_OK;
+}
@@ -0,0 +1,373 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file osal_sync_bench.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Measure the latency of the OSAL synchronisation primitives used on
+ *      the synchronous request path, without a device. Build once with the
+ *      default POSIX OSAL and once with --enable-futex-osal to compare the
+ *      two backends.
+ *
+ *      The tests are:
+ *          completion    create, signal, wait and destroy a completion in
+ *                        one thread, as a sync request whose response is
+ *                        already there when the caller waits
+ *          handoff       as above, but signalled by a second thread that
+ *                        polls for new completions, as the response
+ *                        handler of a sync request does
+ *          sem-pingpong  two threads alternately posting and waiting on a
+ *                        pair of semaphores
+ *          mutex         lock and unlock of an uncontended mutex
+ *          mutex-N       lock and unlock by N threads sharing one mutex
+ *
+ *      Usage: osal_sync_bench [iterations] [threads]
+ *          iterations  operations per test (default 1000000)
+ *          threads     threads for the contended mutex test (default 4)
+ *
+ *****************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Osal.h"
+
+#define BENCH_DEFAULT_ITERATIONS (1000000)
+#define BENCH_DEFAULT_THREADS (4)
+#define BENCH_MAX_THREADS (64)
+
+typedef struct bench_handoff_s
+{
+    OsalCompletion *volatile pending;
+    volatile int stop;
+} bench_handoff_t;
+
+typedef struct bench_pingpong_s
+{
+    OsalSemaphore ping;
+    OsalSemaphore pong;
+    unsigned long iterations;
+} bench_pingpong_t;
+
+typedef struct bench_mutex_s
+{
+    OsalMutex mutex;
+    unsigned long iterations;
+    volatile unsigned long counter;
+} bench_mutex_t;
+
+static void benchReport(const char *name,
+                        unsigned long ops,
+                        UINT64 startNs,
+                        UINT64 endNs)
+{
+    printf("%-16s %12lu ops %10.1f ns/op\n",
+           name,
+           ops,
+           (double)(endNs - startNs) / (double)ops);
+}
+
+static int benchCompletion(unsigned long iterations)
+{
+    OsalCompletion comp;
+    unsigned long i;
+    UINT64 start;
+
+    start = osalTimestampGetNs();
+    for (i = 0; i < iterations; i++)
+    {
+        if ((OSAL_SUCCESS != osalCompletionInit(&comp)) ||
+            (OSAL_SUCCESS != osalCompletionSignal(&comp)) ||
+            (OSAL_SUCCESS != osalCompletionWait(&comp, OSAL_WAIT_FOREVER)) ||
+            (OSAL_SUCCESS != osalCompletionDestroy(&comp)))
+        {
+            printf("completion: operation failed\n");
+            return 1;
+        }
+    }
+    benchReport("completion", iterations, start, osalTimestampGetNs());
+    return 0;
+}
+
+/* Responder: signals each completion published by the waiter */
+static void *benchHandoffThread(void *arg)
+{
+    bench_handoff_t *pHandoff = arg;
+    OsalCompletion *pComp;
+
+    while (!__atomic_load_n(&pHandoff->stop, __ATOMIC_ACQUIRE))
+    {
+        pComp = __atomic_exchange_n(&pHandoff->pending, NULL, __ATOMIC_ACQUIRE);
+        if (NULL != pComp)
+        {
+            osalCompletionSignal(pComp);
+        }
+    }
+    return NULL;
+}
+
+static int benchHandoff(unsigned long iterations)
+{
+    bench_handoff_t handoff = { NULL, 0 };
+    OsalCompletion comp;
+    pthread_t responder;
+    unsigned long i;
+    UINT64 start;
+    int rc = 0;
+
+    if (pthread_create(&responder, NULL, benchHandoffThread, &handoff))
+    {
+        printf("handoff: failed to create thread\n");
+        return 1;
+    }
+
+    start = osalTimestampGetNs();
+    for (i = 0; i < iterations; i++)
+    {
+        osalCompletionInit(&comp);
+        __atomic_store_n(&handoff.pending, &comp, __ATOMIC_RELEASE);
+        if (OSAL_SUCCESS != osalCompletionWait(&comp, OSAL_WAIT_FOREVER))
+        {
+            printf("handoff: wait failed\n");
+            rc = 1;
+            break;
+        }
+        osalCompletionDestroy(&comp);
+    }
+    if (0 == rc)
+    {
+        benchReport("handoff", iterations, start, osalTimestampGetNs());
+    }
+
+    __atomic_store_n(&handoff.stop, 1, __ATOMIC_RELEASE);
+    pthread_join(responder, NULL);
+    return rc;
+}
+
+static void *benchPongThread(void *arg)
+{
+    bench_pingpong_t *pPingPong = arg;
+    unsigned long i;
+
+    for (i = 0; i < pPingPong->iterations; i++)
+    {
+        osalSemaphoreWait(&pPingPong->ping, OSAL_WAIT_FOREVER);
+        osalSemaphorePost(&pPingPong->pong);
+    }
+    return NULL;
+}
+
+static int benchSemPingPong(unsigned long iterations)
+{
+    bench_pingpong_t pingPong;
+    pthread_t ponger;
+    unsigned long i;
+    UINT64 start;
+    int rc = 0;
+
+    pingPong.iterations = iterations;
+    if (OSAL_SUCCESS != osalSemaphoreInit(&pingPong.ping, 0))
+    {
+        return 1;
+    }
+    if (OSAL_SUCCESS != osalSemaphoreInit(&pingPong.pong, 0))
+    {
+        osalSemaphoreDestroy(&pingPong.ping);
+        return 1;
+    }
+
+    if (pthread_create(&ponger, NULL, benchPongThread, &pingPong))
+    {
+        printf("sem-pingpong: failed to create thread\n");
+        rc = 1;
+    }
+    else
+    {
+        start = osalTimestampGetNs();
+        for (i = 0; i < iterations; i++)
+        {
+            osalSemaphorePost(&pingPong.ping);
+            osalSemaphoreWait(&pingPong.pong, OSAL_WAIT_FOREVER);
+        }
+        benchReport("sem-pingpong", iterations, start, osalTimestampGetNs());
+        pthread_join(ponger, NULL);
+    }
+
+    osalSemaphoreDestroy(&pingPong.pong);
+    osalSemaphoreDestroy(&pingPong.ping);
+    return rc;
+}
+
+static void *benchMutexThread(void *arg)
+{
+    bench_mutex_t *pBench = arg;
+    unsigned long i;
+
+    for (i = 0; i < pBench->iterations; i++)
+    {
+        osalMutexLock(&pBench->mutex, OSAL_WAIT_FOREVER);
+        pBench->counter++;
+        osalMutexUnlock(&pBench->mutex);
+    }
+    return NULL;
+}
+
+/* numThreads of 0 runs the uncontended test in the calling thread */
+static int benchMutex(unsigned long iterations, unsigned int numThreads)
+{
+    pthread_t threads[BENCH_MAX_THREADS];
+    bench_mutex_t bench;
+    unsigned long expected;
+    unsigned int i, created = 0;
+    char name[32];
+    UINT64 start;
+    int rc = 0;
+
+    if (OSAL_SUCCESS != osalMutexInit(&bench.mutex))
+    {
+        return 1;
+    }
+    bench.counter = 0;
+
+    start = osalTimestampGetNs();
+    if (0 == numThreads)
+    {
+        bench.iterations = iterations;
+        benchMutexThread(&bench);
+        expected = iterations;
+        snprintf(name, sizeof(name), "mutex");
+    }
+    else
+    {
+        bench.iterations = iterations / numThreads;
+        for (i = 0; i < numThreads; i++)
+        {
+            if (pthread_create(&threads[i], NULL, benchMutexThread, &bench))
+            {
+                printf("mutex: failed to create thread\n");
+                rc = 1;
+                break;
+            }
+            created++;
+        }
+        for (i = 0; i < created; i++)
+        {
+            pthread_join(threads[i], NULL);
+        }
+        expected = bench.iterations * created;
+        snprintf(name, sizeof(name), "mutex-%u", numThreads);
+    }
+
+    if (bench.counter != expected)
+    {
+        printf("%s: lost updates, %lu of %lu\n", name, bench.counter, expected);
+        rc = 1;
+    }
+    else if (0 == rc)
+    {
+        benchReport(name, expected, start, osalTimestampGetNs());
+    }
+
+    osalMutexDestroy(&bench.mutex);
+    return rc;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long iterations = BENCH_DEFAULT_ITERATIONS;
+    unsigned long numThreads = BENCH_DEFAULT_THREADS;
+    int rc = 0;
+
+    if (argc > 1)
+    {
+        iterations = strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2)
+    {
+        numThreads = strtoul(argv[2], NULL, 0);
+    }
+    if ((0 == iterations) || (0 == numThreads) ||
+        (numThreads > BENCH_MAX_THREADS))
+    {
+        printf("Usage: %s [iterations] [threads (1-%d)]\n",
+               argv[0],
+               BENCH_MAX_THREADS);
+        return 1;
+    }
+
+#ifdef OSAL_FUTEX
+    printf("OSAL backend: futex\n");
+#else
+    printf("OSAL backend: posix\n");
+#endif
+    rc |= benchCompletion(iterations);
+    rc |= benchHandoff(iterations);
+    rc |= benchSemPingPong(iterations);
+    rc |= benchMutex(iterations, 0);
+    rc |= benchMutex(iterations, (unsigned int)numThreads);
+
+    return rc;
+}
@@ -0,0 +1,245 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_bench_common.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Set up shared by the benchmark tools. The compression and crypto
+ *      instance calls only differ in name, so the service picks which
+ *      ones are used.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "cpa_cy_im.h"
+#include "icp_sal_user.h"
+#include "qae_mem.h"
+#include "qat_bench_common.h"
+
+extern CpaStatus qaeMemInit(void);
+extern void qaeMemDestroy(void);
+
+Cpa64U qatBenchTimeNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Cpa64U)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+Cpa8U *qatBenchLoadFile(const char *pName, Cpa32U *pLen)
+{
+    Cpa8U *pData = NULL;
+    FILE *pFile;
+    long len;
+
+    pFile = fopen(pName, "rb");
+    if (NULL == pFile)
+        return NULL;
+    if (0 == fseek(pFile, 0, SEEK_END) && (len = ftell(pFile)) > 0 &&
+        0 == fseek(pFile, 0, SEEK_SET))
+    {
+        pData = malloc(len);
+        if (NULL != pData && fread(pData, 1, len, pFile) != (size_t)len)
+        {
+            free(pData);
+            pData = NULL;
+        }
+        *pLen = (Cpa32U)len;
+    }
+    fclose(pFile);
+
+    return pData;
+}
+
+CpaStatus qatBenchProcessStart(void)
+{
+    if (CPA_STATUS_SUCCESS != qaeMemInit())
+    {
+        fprintf(stderr, "Failed to initialise the memory driver\n");
+        return CPA_STATUS_FAIL;
+    }
+    if (CPA_STATUS_SUCCESS != icp_sal_userStartMultiProcess("SSL", CPA_FALSE))
+    {
+        fprintf(stderr, "Failed to start user process SSL\n");
+        qaeMemDestroy();
+        return CPA_STATUS_FAIL;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+void qatBenchProcessStop(void)
+{
+    icp_sal_userStop();
+    qaeMemDestroy();
+}
+
+static void benchInstanceStop(qat_bench_service_t service,
+                              CpaInstanceHandle instance)
+{
+    if (QAT_BENCH_SERVICE_DC == service)
+        cpaDcStopInstance(instance);
+    else
+        cpaCyStopInstance(instance);
+}
+
+static CpaStatus benchInstanceStart(qat_bench_service_t service,
+                                    CpaInstanceHandle instance)
+{
+    CpaInstanceInfo2 info;
+    CpaStatus status;
+
+    if (QAT_BENCH_SERVICE_DC == service)
+    {
+        status = cpaDcInstanceGetInfo2(instance, &info);
+        if (CPA_STATUS_SUCCESS == status)
+            status = cpaDcSetAddressTranslation(instance, qaeVirtToPhysNUMA);
+        if (CPA_STATUS_SUCCESS == status)
+            status = cpaDcStartInstance(instance, 0, NULL);
+    }
+    else
+    {
+        status = cpaCyInstanceGetInfo2(instance, &info);
+        if (CPA_STATUS_SUCCESS == status)
+            status = cpaCySetAddressTranslation(instance, qaeVirtToPhysNUMA);
+        if (CPA_STATUS_SUCCESS == status)
+            status = cpaCyStartInstance(instance);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr, "Failed to start an instance (%d)\n", status);
+        return status;
+    }
+    if (!info.isPolled)
+    {
+        fprintf(stderr, "The instances must be polled\n");
+        benchInstanceStop(service, instance);
+        return CPA_STATUS_FAIL;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus qatBenchInstancesStart(qat_bench_service_t service,
+                                 Cpa32U numInstances,
+                                 CpaInstanceHandle *pInstances)
+{
+    const char *pName =
+        (QAT_BENCH_SERVICE_DC == service) ? "compression" : "crypto";
+    Cpa16U numAvailable = 0;
+    Cpa32U i;
+    CpaStatus status;
+
+    if (0 == numInstances)
+        return CPA_STATUS_INVALID_PARAM;
+
+    if (QAT_BENCH_SERVICE_DC == service)
+        status = cpaDcGetNumInstances(&numAvailable);
+    else
+        status = cpaCyGetNumInstances(&numAvailable);
+    if (CPA_STATUS_SUCCESS != status || numAvailable < numInstances)
+    {
+        if (1 == numInstances)
+            fprintf(stderr, "No %s instance\n", pName);
+        else
+            fprintf(
+                stderr, "%u %s instances are needed\n", numInstances, pName);
+        return CPA_STATUS_FAIL;
+    }
+    if (QAT_BENCH_SERVICE_DC == service)
+        status = cpaDcGetInstances((Cpa16U)numInstances, pInstances);
+    else
+        status = cpaCyGetInstances((Cpa16U)numInstances, pInstances);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    for (i = 0; i < numInstances; i++)
+    {
+        status = benchInstanceStart(service, pInstances[i]);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            qatBenchInstancesStop(service, i, pInstances);
+            return status;
+        }
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+void qatBenchInstancesStop(qat_bench_service_t service,
+                           Cpa32U numInstances,
+                           CpaInstanceHandle *pInstances)
+{
+    Cpa32U i;
+
+    for (i = numInstances; i > 0; i--)
+        benchInstanceStop(service, pInstances[i - 1]);
+}
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_bench_common.h
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Set up shared by the benchmark tools: the user process, polled
+ *      instances of either service, test files and timing.
+ *
+ *****************************************************************************/
+#ifndef QAT_BENCH_COMMON_H
+#define QAT_BENCH_COMMON_H
+
+#include "cpa.h"
+
+#ifndef SAMPLE_CODE_CORPUS_PATH
+#define SAMPLE_CODE_CORPUS_PATH "/usr/local/share/qat/"
+#endif
+
+typedef enum qat_bench_service_e
+{
+    QAT_BENCH_SERVICE_DC = 0,
+    QAT_BENCH_SERVICE_CY
+} qat_bench_service_t;
+
+/* Monotonic time in nanoseconds */
+Cpa64U qatBenchTimeNs(void);
+
+/* Read a whole file into malloc'd memory, NULL on failure */
+Cpa8U *qatBenchLoadFile(const char *pName, Cpa32U *pLen);
+
+/* Initialise the memory driver and start the SSL user process */
+CpaStatus qatBenchProcessStart(void);
+
+void qatBenchProcessStop(void);
+
+/* Start the first numInstances instances of the service, which must all
+ * be polled. Either all of them are started or none. */
+CpaStatus qatBenchInstancesStart(qat_bench_service_t service,
+                                 Cpa32U numInstances,
+                                 CpaInstanceHandle *pInstances);
+
+void qatBenchInstancesStop(qat_bench_service_t service,
+                           Cpa32U numInstances,
+                           CpaInstanceHandle *pInstances);
+
+#endif /* QAT_BENCH_COMMON_H */
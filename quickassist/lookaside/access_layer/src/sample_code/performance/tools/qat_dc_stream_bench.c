@@ -0,0 +1,466 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_dc_stream_bench.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Measure pipelined stream compression (icp_sal_DcStreamCompress())
+ *      against a stream compressed one chunk at a time.
+ *
+ *      Each file is compressed loops times as one gzip stream cut into
+ *      chunks of chunk_size bytes, first with a single chunk in flight,
+ *      which is how a stateful session serialises a stream, then with
+ *      depth chunks in flight. The stream throughput and compression
+ *      ratio of both runs are printed, and the output of each run is
+ *      inflated with zlib and compared to the file.
+ *
+ *      Usage: qat_dc_stream_bench [-c chunk_size] [-d depth] [-l loops]
+ *                                 [file ...]
+ *          -c  bytes per chunk (default 65536)
+ *          -d  chunks in flight of the pipelined run (default 8)
+ *          -l  times each file is compressed (default 10)
+ *
+ *      Without files the calgary and canterbury corpora are used.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_dc_stream.h"
+#include "icp_sal_poll.h"
+#include "qae_mem.h"
+#include "qat_bench_common.h"
+
+#define STREAM_DEFAULT_CHUNK (64 * 1024)
+#define STREAM_DEFAULT_DEPTH (8)
+#define STREAM_DEFAULT_LOOPS (10)
+#define STREAM_TIMEOUT_NS (10ULL * 1000 * 1000 * 1000)
+
+typedef struct stream_chunk_s
+{
+    CpaFlatBuffer src;
+    CpaFlatBuffer dst;
+    CpaDcRqResults results;
+} stream_chunk_t;
+
+typedef struct stream_bench_s
+{
+    CpaInstanceHandle instance;
+    Cpa8U *pData;
+    /* The file, copied to DMA-able memory chunk by chunk */
+    Cpa32U dataLen;
+    Cpa32U numChunks;
+    stream_chunk_t *pChunks;
+    volatile Cpa32U numCompleted;
+    volatile Cpa32U numErrors;
+} stream_bench_t;
+
+static stream_bench_t *gBench = NULL;
+
+static void streamCallback(void *pCallbackTag, CpaStatus status)
+{
+    stream_chunk_t *pChunk = pCallbackTag;
+
+    /* Chunks must complete in submission order */
+    if (CPA_STATUS_SUCCESS != status ||
+        CPA_DC_OK != pChunk->results.status ||
+        pChunk != &gBench->pChunks[gBench->numCompleted])
+        gBench->numErrors++;
+    gBench->numCompleted++;
+}
+
+/* Compress the file once as a stream, returns the stream length */
+static CpaStatus streamOnce(stream_bench_t *pBench,
+                            icp_sal_dc_stream_t stream,
+                            Cpa64U *pStreamLen)
+{
+    stream_chunk_t *pChunk;
+    Cpa32U next = 0;
+    Cpa32U i;
+    Cpa64U start;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pBench->numCompleted = 0;
+    pBench->numErrors = 0;
+    start = qatBenchTimeNs();
+    while (pBench->numCompleted < pBench->numChunks)
+    {
+        while (next < pBench->numChunks)
+        {
+            pChunk = &pBench->pChunks[next];
+            status = icp_sal_DcStreamCompress(
+                stream,
+                &pChunk->src,
+                &pChunk->dst,
+                &pChunk->results,
+                (next == pBench->numChunks - 1) ? CPA_TRUE : CPA_FALSE,
+                pChunk);
+            if (CPA_STATUS_RETRY == status)
+                break;
+            if (CPA_STATUS_SUCCESS != status)
+                return status;
+            next++;
+        }
+        icp_sal_DcPollInstance(pBench->instance, 0);
+        if (qatBenchTimeNs() - start > STREAM_TIMEOUT_NS)
+        {
+            fprintf(stderr, "Timed out waiting for chunks\n");
+            return CPA_STATUS_FAIL;
+        }
+    }
+    if (pBench->numErrors)
+        return CPA_STATUS_FAIL;
+
+    *pStreamLen = 0;
+    for (i = 0; i < pBench->numChunks; i++)
+        *pStreamLen += pBench->pChunks[i].results.produced;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Inflate the chunk outputs of the last run as one gzip stream */
+static CpaStatus streamVerify(stream_bench_t *pBench)
+{
+    Cpa8U *pOut;
+    z_stream strm;
+    Cpa32U i;
+    int ret = Z_OK;
+
+    pOut = malloc(pBench->dataLen);
+    if (NULL == pOut)
+        return CPA_STATUS_RESOURCE;
+    memset(&strm, 0, sizeof(strm));
+    if (Z_OK != inflateInit2(&strm, 16 + MAX_WBITS))
+    {
+        free(pOut);
+        return CPA_STATUS_FAIL;
+    }
+
+    strm.next_out = pOut;
+    strm.avail_out = pBench->dataLen;
+    for (i = 0; i < pBench->numChunks && Z_OK == ret; i++)
+    {
+        strm.next_in = pBench->pChunks[i].dst.pData;
+        strm.avail_in = pBench->pChunks[i].results.produced;
+        ret = inflate(&strm, Z_NO_FLUSH);
+    }
+    /* Z_STREAM_END also checks the CRC-32 and length in the footer */
+    if (Z_STREAM_END != ret || i != pBench->numChunks ||
+        strm.total_out != pBench->dataLen ||
+        memcmp(pOut, pBench->pData, pBench->dataLen))
+        ret = Z_DATA_ERROR;
+    inflateEnd(&strm);
+    free(pOut);
+
+    return (Z_DATA_ERROR == ret) ? CPA_STATUS_FAIL : CPA_STATUS_SUCCESS;
+}
+
+/* Create a dynamic Huffman stream, or a static one where dynamic is not
+ * supported */
+static CpaStatus streamCreate(stream_bench_t *pBench,
+                              Cpa32U depth,
+                              icp_sal_dc_stream_t *pStream)
+{
+    icp_sal_dc_stream_setup_t setup;
+    CpaStatus status;
+
+    memset(&setup, 0, sizeof(setup));
+    setup.compLevel = CPA_DC_L1;
+    setup.huffType = CPA_DC_HT_FULL_DYNAMIC;
+    setup.checksum = CPA_DC_CRC32;
+    setup.maxInflight = depth;
+    status = icp_sal_DcStreamCreate(
+        pBench->instance, &setup, streamCallback, pStream);
+    if (CPA_STATUS_UNSUPPORTED == status)
+    {
+        setup.huffType = CPA_DC_HT_STATIC;
+        status = icp_sal_DcStreamCreate(
+            pBench->instance, &setup, streamCallback, pStream);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+        fprintf(stderr, "Failed to create the stream (%d)\n", status);
+
+    return status;
+}
+
+static CpaStatus streamRun(stream_bench_t *pBench,
+                           const char *pName,
+                           Cpa32U depth,
+                           Cpa32U loops)
+{
+    icp_sal_dc_stream_t stream = NULL;
+    Cpa64U streamLen = 0;
+    Cpa64U start;
+    Cpa64U elapsed;
+    Cpa32U i;
+    CpaStatus status;
+
+    status = streamCreate(pBench, depth, &stream);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    start = qatBenchTimeNs();
+    for (i = 0; i < loops && CPA_STATUS_SUCCESS == status; i++)
+        status = streamOnce(pBench, stream, &streamLen);
+    elapsed = qatBenchTimeNs() - start;
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr,
+                "Compression failed (%d), %u chunk errors\n",
+                status,
+                pBench->numErrors);
+    }
+    else
+    {
+        status = streamVerify(pBench);
+        if (CPA_STATUS_SUCCESS != status)
+            fprintf(stderr, "The stream does not inflate to the input\n");
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+        printf("%-12s %6u %10.1f %8.3f %s\n",
+               pName,
+               depth,
+               (double)pBench->dataLen * loops * 8 * 1000.0 /
+                   (elapsed ? elapsed : 1),
+               (double)pBench->dataLen / (streamLen ? streamLen : 1),
+               "verified");
+    else
+        printf("%-12s %6u %10s %8s %s\n", pName, depth, "-", "-", "FAILED");
+
+    /* Chunks are left in flight only on a timeout */
+    if (CPA_STATUS_SUCCESS != icp_sal_DcStreamRemove(stream))
+        fprintf(stderr, "Stream left with chunks in flight\n");
+
+    return status;
+}
+
+static void benchFree(stream_bench_t *pBench)
+{
+    stream_chunk_t *pChunk;
+    Cpa32U i;
+
+    for (i = 0; NULL != pBench->pChunks && i < pBench->numChunks; i++)
+    {
+        pChunk = &pBench->pChunks[i];
+        if (NULL != pChunk->src.pData)
+            qaeMemFreeNUMA((void **)&pChunk->src.pData);
+        if (NULL != pChunk->dst.pData)
+            qaeMemFreeNUMA((void **)&pChunk->dst.pData);
+    }
+    free(pBench->pChunks);
+    pBench->pChunks = NULL;
+    free(pBench->pData);
+    pBench->pData = NULL;
+}
+
+/* Cut the file into chunks, each with a destination of bound bytes */
+static CpaStatus benchPrepare(stream_bench_t *pBench,
+                              const char *pFile,
+                              Cpa32U chunkSize)
+{
+    icp_sal_dc_stream_t stream = NULL;
+    stream_chunk_t *pChunk;
+    Cpa32U bound = 0;
+    Cpa32U offset;
+    Cpa32U i;
+    CpaStatus status;
+
+    pBench->pData = qatBenchLoadFile(pFile, &pBench->dataLen);
+    if (NULL == pBench->pData)
+    {
+        fprintf(stderr, "Failed to load %s\n", pFile);
+        return CPA_STATUS_FAIL;
+    }
+
+    status = streamCreate(pBench, 1, &stream);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_DcStreamCompressBound(stream, chunkSize, &bound);
+        icp_sal_DcStreamRemove(stream);
+    }
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    pBench->numChunks = (pBench->dataLen + chunkSize - 1) / chunkSize;
+    pBench->pChunks = calloc(pBench->numChunks, sizeof(stream_chunk_t));
+    if (NULL == pBench->pChunks)
+        return CPA_STATUS_RESOURCE;
+
+    for (i = 0; i < pBench->numChunks; i++)
+    {
+        pChunk = &pBench->pChunks[i];
+        offset = i * chunkSize;
+        pChunk->src.dataLenInBytes = (pBench->dataLen - offset < chunkSize)
+                                         ? pBench->dataLen - offset
+                                         : chunkSize;
+        pChunk->src.pData =
+            qaeMemAllocNUMA(pChunk->src.dataLenInBytes, 0, 64);
+        pChunk->dst.dataLenInBytes = bound;
+        pChunk->dst.pData = qaeMemAllocNUMA(bound, 0, 64);
+        if (NULL == pChunk->src.pData || NULL == pChunk->dst.pData)
+            return CPA_STATUS_RESOURCE;
+        memcpy(pChunk->src.pData,
+               pBench->pData + offset,
+               pChunk->src.dataLenInBytes);
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *defaultFiles[] = {SAMPLE_CODE_CORPUS_PATH "calgary",
+                                         SAMPLE_CODE_CORPUS_PATH
+                                         "canterbury"};
+    stream_bench_t bench;
+    const char **ppFiles = defaultFiles;
+    const char *pName;
+    Cpa32U numFiles = sizeof(defaultFiles) / sizeof(defaultFiles[0]);
+    Cpa32U chunkSize = STREAM_DEFAULT_CHUNK;
+    Cpa32U depth = STREAM_DEFAULT_DEPTH;
+    Cpa32U loops = STREAM_DEFAULT_LOOPS;
+    Cpa32U numErrors = 0;
+    Cpa32U i;
+    CpaStatus status;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:d:l:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'c':
+                chunkSize = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                depth = strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                loops = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr,
+                        "Usage: %s [-c chunk_size] [-d depth] [-l loops] "
+                        "[file ...]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (0 == chunkSize || 0 == loops || depth < 1 ||
+        depth > ICP_SAL_DC_STREAM_MAX_INFLIGHT)
+    {
+        fprintf(stderr,
+                "chunk_size and loops must be non zero, depth between 1 "
+                "and %u\n",
+                ICP_SAL_DC_STREAM_MAX_INFLIGHT);
+        return EXIT_FAILURE;
+    }
+    if (optind < argc)
+    {
+        ppFiles = (const char **)&argv[optind];
+        numFiles = argc - optind;
+    }
+
+    if (CPA_STATUS_SUCCESS != qatBenchProcessStart())
+        return EXIT_FAILURE;
+
+    memset(&bench, 0, sizeof(bench));
+    gBench = &bench;
+    status = qatBenchInstancesStart(QAT_BENCH_SERVICE_DC, 1, &bench.instance);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        printf("Chunk size %u bytes, %u loops\n", chunkSize, loops);
+        printf("%-12s %6s %10s %8s\n", "File", "Depth", "Mbps", "Ratio");
+        for (i = 0; i < numFiles; i++)
+        {
+            pName = strrchr(ppFiles[i], '/');
+            pName = (NULL != pName) ? pName + 1 : ppFiles[i];
+            status = benchPrepare(&bench, ppFiles[i], chunkSize);
+            if (CPA_STATUS_SUCCESS == status)
+                status = streamRun(&bench, pName, 1, loops);
+            if (CPA_STATUS_SUCCESS == status && depth > 1)
+                status = streamRun(&bench, pName, depth, loops);
+            if (CPA_STATUS_SUCCESS != status)
+                numErrors++;
+            benchFree(&bench);
+        }
+        qatBenchInstancesStop(QAT_BENCH_SERVICE_DC, 1, &bench.instance);
+    }
+    else
+    {
+        numErrors++;
+    }
+
+    qatBenchProcessStop();
+
+    printf("%s\n", numErrors ? "FAIL" : "PASS");
+    return numErrors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,715 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_dc_sw_fallback.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Check and measure the software compression fallback
+ *      (icp_sal_dc_sw_fallback.h) against the device.
+ *
+ *      Each file is cut into chunks that are compressed as independent
+ *      stateless DEFLATE requests with a CRC32 checksum, on the device
+ *      first and then with the fallback taking every request. The
+ *      checksums of both runs must match, the fallback output must
+ *      decompress on the device and the device output must decompress
+ *      with the fallback. When the library is built with error
+ *      simulation, a run where the ring rejects half of the requests
+ *      checks that the fallback completes them instead.
+ *
+ *      Usage: qat_dc_sw_fallback [-b chunk_kib] [-d] [-w workers]
+ *                                [file ...]
+ *          -b  chunk size in KiB (default 64)
+ *          -d  dynamic Huffman trees, static otherwise
+ *          -w  fallback threads (default 2)
+ *
+ *      Without files the calgary and canterbury corpora are used.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal.h"
+#include "icp_sal_dc_sw_fallback.h"
+#include "icp_sal_poll.h"
+#include "qae_mem.h"
+#include "qat_bench_common.h"
+
+#define FALLBACK_DEFAULT_CHUNK_KIB (64)
+#define FALLBACK_TIMEOUT_NS (30ULL * 1000 * 1000 * 1000)
+
+typedef struct fallback_chunk_s
+{
+    CpaFlatBuffer srcFlat;
+    CpaFlatBuffer dstFlat;
+    CpaFlatBuffer outFlat;
+    CpaBufferList src;
+    CpaBufferList dst;
+    CpaBufferList out;
+    CpaDcRqResults results;
+    CpaCrcData crcData;
+    Cpa8U *pHwData;
+    /* Device output of the chunk */
+    Cpa32U hwLen;
+    Cpa32U hwChecksum;
+    Cpa32U hwCrc;
+    /* Integrity CRC of the input reported by the device */
+} fallback_chunk_t;
+
+typedef struct fallback_bench_s
+{
+    CpaInstanceHandle instance;
+    CpaDcSessionHandle session;
+    CpaBoolean integrity;
+    Cpa32U numWorkers;
+    Cpa8U *pData;
+    Cpa32U dataLen;
+    Cpa32U numChunks;
+    Cpa32U bound;
+    /* Size of the compression destinations */
+    fallback_chunk_t *pChunks;
+    volatile Cpa32U numCompleted;
+    volatile Cpa32U numErrors;
+} fallback_bench_t;
+
+static fallback_bench_t *gBench = NULL;
+
+/* Completions come from the polling thread and the fallback threads */
+static void fallbackCallback(void *pCallbackTag, CpaStatus status)
+{
+    fallback_chunk_t *pChunk = pCallbackTag;
+
+    if (CPA_STATUS_SUCCESS != status || CPA_DC_OK != pChunk->results.status)
+        __sync_fetch_and_add(&gBench->numErrors, 1);
+    __sync_fetch_and_add(&gBench->numCompleted, 1);
+}
+
+/*
+ * Submit every chunk in one direction and wait for them, returns the
+ * total output length in *pProduced and the time taken in *pElapsed.
+ */
+static CpaStatus fallbackOnce(fallback_bench_t *pBench,
+                              CpaBoolean compress,
+                              Cpa64U *pProduced,
+                              Cpa64U *pElapsed)
+{
+    fallback_chunk_t *pChunk;
+    CpaDcOpData opData;
+    Cpa32U numChunks = pBench->numChunks;
+    Cpa32U next = 0;
+    Cpa32U i;
+    Cpa64U start;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    memset(&opData, 0, sizeof(opData));
+    opData.flushFlag = CPA_DC_FLUSH_FINAL;
+    opData.compressAndVerify = CPA_TRUE;
+    opData.integrityCrcCheck = pBench->integrity;
+
+    pBench->numCompleted = 0;
+    pBench->numErrors = 0;
+    start = qatBenchTimeNs();
+    while (pBench->numCompleted < numChunks)
+    {
+        while (next < numChunks)
+        {
+            pChunk = &pBench->pChunks[next];
+            opData.pCrcData = &pChunk->crcData;
+            memset(&pChunk->results, 0, sizeof(pChunk->results));
+            if (compress)
+            {
+                pChunk->dstFlat.dataLenInBytes = pBench->bound;
+                status = cpaDcCompressData2(pBench->instance,
+                                            pBench->session,
+                                            &pChunk->src,
+                                            &pChunk->dst,
+                                            &opData,
+                                            &pChunk->results,
+                                            pChunk);
+            }
+            else
+            {
+                status = cpaDcDecompressData2(pBench->instance,
+                                              pBench->session,
+                                              &pChunk->dst,
+                                              &pChunk->out,
+                                              &opData,
+                                              &pChunk->results,
+                                              pChunk);
+            }
+            if (CPA_STATUS_RETRY == status)
+                break;
+            if (CPA_STATUS_SUCCESS != status)
+            {
+                fprintf(stderr, "Submission failed (%d)\n", status);
+                /* Let the submitted chunks complete before returning */
+                numChunks = next;
+                break;
+            }
+            next++;
+        }
+        icp_sal_DcPollInstance(pBench->instance, 0);
+        if (qatBenchTimeNs() - start > FALLBACK_TIMEOUT_NS)
+        {
+            fprintf(stderr, "Timed out waiting for chunks\n");
+            return CPA_STATUS_FAIL;
+        }
+    }
+    *pElapsed = qatBenchTimeNs() - start;
+    if (CPA_STATUS_SUCCESS != status || pBench->numErrors)
+        return CPA_STATUS_FAIL;
+
+    *pProduced = 0;
+    for (i = 0; i < pBench->numChunks; i++)
+        *pProduced += pBench->pChunks[i].results.produced;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Compress, checking each chunk against the device run if there was one */
+static CpaStatus fallbackCompress(fallback_bench_t *pBench,
+                                  CpaBoolean device,
+                                  Cpa64U *pProduced,
+                                  Cpa64U *pElapsed)
+{
+    fallback_chunk_t *pChunk;
+    Cpa32U i;
+    CpaStatus status;
+
+    status = fallbackOnce(pBench, CPA_TRUE, pProduced, pElapsed);
+    for (i = 0; i < pBench->numChunks && CPA_STATUS_SUCCESS == status; i++)
+    {
+        pChunk = &pBench->pChunks[i];
+        /* The destination is read back as the source of decompression */
+        pChunk->dstFlat.dataLenInBytes = pChunk->results.produced;
+        if (pChunk->results.consumed != pChunk->srcFlat.dataLenInBytes)
+        {
+            fprintf(stderr, "Chunk %u not fully consumed\n", i);
+            status = CPA_STATUS_FAIL;
+        }
+        else if (device)
+        {
+            memcpy(pChunk->pHwData,
+                   pChunk->dstFlat.pData,
+                   pChunk->results.produced);
+            pChunk->hwLen = pChunk->results.produced;
+            pChunk->hwChecksum = pChunk->results.checksum;
+            pChunk->hwCrc = pChunk->crcData.integrityCrc.iCrc;
+        }
+        else if (pChunk->results.checksum != pChunk->hwChecksum ||
+                 (pBench->integrity &&
+                  pChunk->crcData.integrityCrc.iCrc != pChunk->hwCrc))
+        {
+            fprintf(stderr, "Chunk %u checksums differ from the device\n", i);
+            status = CPA_STATUS_FAIL;
+        }
+    }
+
+    return status;
+}
+
+static CpaStatus fallbackDecompress(fallback_bench_t *pBench)
+{
+    fallback_chunk_t *pChunk;
+    Cpa64U produced = 0;
+    Cpa64U elapsed = 0;
+    Cpa32U i;
+    CpaStatus status;
+
+    status = fallbackOnce(pBench, CPA_FALSE, &produced, &elapsed);
+    for (i = 0; i < pBench->numChunks && CPA_STATUS_SUCCESS == status; i++)
+    {
+        pChunk = &pBench->pChunks[i];
+        if (pChunk->results.produced != pChunk->srcFlat.dataLenInBytes ||
+            memcmp(pChunk->outFlat.pData,
+                   pChunk->srcFlat.pData,
+                   pChunk->srcFlat.dataLenInBytes) ||
+            pChunk->results.checksum != pChunk->hwChecksum)
+        {
+            fprintf(stderr, "Chunk %u does not decompress to the input\n", i);
+            status = CPA_STATUS_FAIL;
+        }
+    }
+
+    return status;
+}
+
+/* Restore the device output of every chunk as the source to decompress */
+static void fallbackRestoreDevice(fallback_bench_t *pBench)
+{
+    fallback_chunk_t *pChunk;
+    Cpa32U i;
+
+    for (i = 0; i < pBench->numChunks; i++)
+    {
+        pChunk = &pBench->pChunks[i];
+        memcpy(pChunk->dstFlat.pData, pChunk->pHwData, pChunk->hwLen);
+        pChunk->dstFlat.dataLenInBytes = pChunk->hwLen;
+    }
+}
+
+static CpaStatus fallbackEnable(fallback_bench_t *pBench,
+                                Cpa32U ringFullPercent,
+                                Cpa32U smallRequestBytes)
+{
+    icp_sal_dc_sw_fallback_policy_t policy;
+    CpaStatus status;
+
+    memset(&policy, 0, sizeof(policy));
+    policy.ringFullPercent = ringFullPercent;
+    policy.smallRequestBytes = smallRequestBytes;
+    policy.numWorkers = pBench->numWorkers;
+    /* Small requests go to the device while the queue is full */
+    policy.queueDepth = ICP_SAL_DC_SW_FALLBACK_MAX_QUEUE_DEPTH;
+    status = icp_sal_DcSwFallbackEnable(pBench->instance, &policy);
+    if (CPA_STATUS_SUCCESS != status)
+        fprintf(stderr, "Failed to enable the fallback (%d)\n", status);
+
+    return status;
+}
+
+/*
+ * Disable the fallback of a run that ended with status, checking that it
+ * took at least minTaken requests and completed all of them.
+ */
+static CpaStatus fallbackDisable(fallback_bench_t *pBench,
+                                 CpaStatus status,
+                                 Cpa64U minTaken,
+                                 Cpa64U *pTaken)
+{
+    icp_sal_dc_sw_fallback_stats_t stats;
+    Cpa64U taken;
+
+    if (CPA_STATUS_SUCCESS == status)
+        status = icp_sal_DcSwFallbackQueryStats(pBench->instance, &stats);
+    icp_sal_DcSwFallbackDisable(pBench->instance);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    taken = stats.numRingFull + stats.numDeviceError + stats.numSmallRequest;
+    if (taken < minTaken || stats.numCompleted != taken)
+    {
+        fprintf(stderr,
+                "The fallback took %llu requests, completed %llu, expected "
+                "%llu\n",
+                (unsigned long long)taken,
+                (unsigned long long)stats.numCompleted,
+                (unsigned long long)minTaken);
+        return CPA_STATUS_FAIL;
+    }
+    if (NULL != pTaken)
+        *pTaken = taken;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static void fallbackPrint(const char *pName,
+                          const char *pRun,
+                          fallback_bench_t *pBench,
+                          Cpa64U produced,
+                          Cpa64U elapsed,
+                          Cpa64U numFallback,
+                          CpaStatus status)
+{
+    if (CPA_STATUS_SUCCESS == status)
+        printf("%-12s %-8s %10.1f %8.3f %8llu %s\n",
+               pName,
+               pRun,
+               (double)pBench->dataLen * 8 * 1000.0 / (elapsed ? elapsed : 1),
+               (double)pBench->dataLen / (produced ? produced : 1),
+               (unsigned long long)numFallback,
+               "verified");
+    else
+        printf("%-12s %-8s %10s %8s %8s %s\n",
+               pName,
+               pRun,
+               "-",
+               "-",
+               "-",
+               "FAILED");
+}
+
+static CpaStatus fallbackRun(fallback_bench_t *pBench, const char *pName)
+{
+    Cpa64U produced = 0;
+    Cpa64U elapsed = 0;
+    Cpa64U taken = 0;
+    Cpa64U minTaken = pBench->numChunks;
+#ifdef ICP_DC_ERROR_SIMULATION
+    Cpa8U numRetries;
+#endif
+    CpaStatus status;
+
+    /* Device only */
+    status = fallbackCompress(pBench, CPA_TRUE, &produced, &elapsed);
+    if (CPA_STATUS_SUCCESS == status)
+        status = fallbackDecompress(pBench);
+    fallbackPrint(pName, "device", pBench, produced, elapsed, 0, status);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    /* Every request below the cutoff, that is all of them, on the host
+     * until the queue is full */
+    if (minTaken > ICP_SAL_DC_SW_FALLBACK_MAX_QUEUE_DEPTH)
+        minTaken = ICP_SAL_DC_SW_FALLBACK_MAX_QUEUE_DEPTH;
+    status = fallbackEnable(pBench, 0, 0xFFFFFFFF);
+    if (CPA_STATUS_UNSUPPORTED == status)
+    {
+        printf("%-12s %-8s the library is built without the fallback\n",
+               pName,
+               "host");
+        return CPA_STATUS_SUCCESS;
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = fallbackCompress(pBench, CPA_FALSE, &produced, &elapsed);
+        status = fallbackDisable(pBench, status, minTaken, &taken);
+    }
+    /* The host output decompresses on the device */
+    if (CPA_STATUS_SUCCESS == status)
+        status = fallbackDecompress(pBench);
+    /* And the device output with the fallback */
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        fallbackRestoreDevice(pBench);
+        status = fallbackEnable(pBench, 0, 0xFFFFFFFF);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = fallbackDecompress(pBench);
+        status = fallbackDisable(pBench, status, minTaken, NULL);
+    }
+    fallbackPrint(pName, "host", pBench, produced, elapsed, taken, status);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+#ifdef ICP_DC_ERROR_SIMULATION
+    /* The ring rejects half of the requests, the fallback takes them */
+    numRetries = (pBench->numChunks / 2 > 0xFE) ? 0xFE : pBench->numChunks / 2;
+    status = fallbackEnable(pBench, 100, 0);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_dc_simulate_retry(numRetries);
+        if (CPA_STATUS_SUCCESS == status)
+            status = fallbackCompress(pBench, CPA_FALSE, &produced, &elapsed);
+        icp_sal_dc_simulate_retry(0);
+        status = fallbackDisable(pBench, status, numRetries, &taken);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+        status = fallbackDecompress(pBench);
+    fallbackPrint(pName, "ringfull", pBench, produced, elapsed, taken, status);
+#endif
+
+    return status;
+}
+
+static void benchFree(fallback_bench_t *pBench)
+{
+    fallback_chunk_t *pChunk;
+    Cpa32U i;
+
+    for (i = 0; NULL != pBench->pChunks && i < pBench->numChunks; i++)
+    {
+        pChunk = &pBench->pChunks[i];
+        if (NULL != pChunk->srcFlat.pData)
+            qaeMemFreeNUMA((void **)&pChunk->srcFlat.pData);
+        if (NULL != pChunk->dstFlat.pData)
+            qaeMemFreeNUMA((void **)&pChunk->dstFlat.pData);
+        if (NULL != pChunk->outFlat.pData)
+            qaeMemFreeNUMA((void **)&pChunk->outFlat.pData);
+        if (NULL != pChunk->src.pPrivateMetaData)
+            qaeMemFreeNUMA(&pChunk->src.pPrivateMetaData);
+        if (NULL != pChunk->dst.pPrivateMetaData)
+            qaeMemFreeNUMA(&pChunk->dst.pPrivateMetaData);
+        if (NULL != pChunk->out.pPrivateMetaData)
+            qaeMemFreeNUMA(&pChunk->out.pPrivateMetaData);
+        free(pChunk->pHwData);
+    }
+    free(pBench->pChunks);
+    pBench->pChunks = NULL;
+    free(pBench->pData);
+    pBench->pData = NULL;
+}
+
+static CpaStatus benchList(CpaBufferList *pList,
+                           CpaFlatBuffer *pFlat,
+                           Cpa32U len,
+                           Cpa32U metaSize)
+{
+    pFlat->dataLenInBytes = len;
+    pFlat->pData = qaeMemAllocNUMA(len, 0, 64);
+    pList->numBuffers = 1;
+    pList->pBuffers = pFlat;
+    pList->pPrivateMetaData = qaeMemAllocNUMA(metaSize, 0, 64);
+
+    return (NULL == pFlat->pData || NULL == pList->pPrivateMetaData)
+               ? CPA_STATUS_RESOURCE
+               : CPA_STATUS_SUCCESS;
+}
+
+/* Cut the file into chunks, each with a destination of bound bytes */
+static CpaStatus benchPrepare(fallback_bench_t *pBench,
+                              const char *pFile,
+                              Cpa32U chunkSize,
+                              CpaDcHuffType huffType)
+{
+    fallback_chunk_t *pChunk;
+    Cpa32U metaSize = 0;
+    Cpa32U bound = 0;
+    Cpa32U offset;
+    Cpa32U len;
+    Cpa32U i;
+    CpaStatus status;
+
+    pBench->pData = qatBenchLoadFile(pFile, &pBench->dataLen);
+    if (NULL == pBench->pData)
+    {
+        fprintf(stderr, "Failed to load %s\n", pFile);
+        return CPA_STATUS_FAIL;
+    }
+
+    status = cpaDcDeflateCompressBound(
+        pBench->instance, huffType, chunkSize, &pBench->bound);
+    bound = pBench->bound;
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcBufferListGetMetaSize(pBench->instance, 1, &metaSize);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    pBench->numChunks = (pBench->dataLen + chunkSize - 1) / chunkSize;
+    pBench->pChunks = calloc(pBench->numChunks, sizeof(fallback_chunk_t));
+    if (NULL == pBench->pChunks)
+        return CPA_STATUS_RESOURCE;
+
+    for (i = 0; i < pBench->numChunks && CPA_STATUS_SUCCESS == status; i++)
+    {
+        pChunk = &pBench->pChunks[i];
+        offset = i * chunkSize;
+        len = (pBench->dataLen - offset < chunkSize) ? pBench->dataLen - offset
+                                                     : chunkSize;
+        status = benchList(&pChunk->src, &pChunk->srcFlat, len, metaSize);
+        if (CPA_STATUS_SUCCESS == status)
+            status = benchList(&pChunk->dst, &pChunk->dstFlat, bound, metaSize);
+        if (CPA_STATUS_SUCCESS == status)
+            status = benchList(&pChunk->out, &pChunk->outFlat, len, metaSize);
+        pChunk->pHwData = malloc(bound);
+        if (NULL == pChunk->pHwData)
+            status = CPA_STATUS_RESOURCE;
+        if (CPA_STATUS_SUCCESS == status)
+            memcpy(pChunk->srcFlat.pData, pBench->pData + offset, len);
+    }
+
+    return status;
+}
+
+static CpaStatus benchSession(fallback_bench_t *pBench, CpaDcHuffType huffType)
+{
+    CpaDcInstanceCapabilities caps;
+    CpaDcSessionSetupData setup;
+    Cpa32U sessionSize = 0;
+    Cpa32U contextSize = 0;
+    CpaStatus status;
+
+    memset(&caps, 0, sizeof(caps));
+    status = cpaDcQueryCapabilities(pBench->instance, &caps);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+    pBench->integrity = caps.integrityCrcs;
+
+    memset(&setup, 0, sizeof(setup));
+    setup.compLevel = CPA_DC_L1;
+    setup.compType = CPA_DC_DEFLATE;
+    setup.huffType = huffType;
+    setup.autoSelectBestHuffmanTree = CPA_DC_ASB_DISABLED;
+    setup.sessDirection = CPA_DC_DIR_COMBINED;
+    setup.sessState = CPA_DC_STATELESS;
+    setup.checksum = CPA_DC_CRC32;
+    status = cpaDcGetSessionSize(
+        pBench->instance, &setup, &sessionSize, &contextSize);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pBench->session = qaeMemAllocNUMA(sessionSize, 0, 64);
+        if (NULL == pBench->session)
+            status = CPA_STATUS_RESOURCE;
+    }
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcInitSession(
+            pBench->instance, pBench->session, &setup, NULL, fallbackCallback);
+    if (CPA_STATUS_SUCCESS != status)
+        fprintf(stderr, "Failed to set up the session (%d)\n", status);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *defaultFiles[] = {SAMPLE_CODE_CORPUS_PATH "calgary",
+                                         SAMPLE_CODE_CORPUS_PATH
+                                         "canterbury"};
+    fallback_bench_t bench;
+    const char **ppFiles = defaultFiles;
+    const char *pName;
+    CpaDcHuffType huffType = CPA_DC_HT_STATIC;
+    Cpa32U numFiles = sizeof(defaultFiles) / sizeof(defaultFiles[0]);
+    Cpa32U chunkKib = FALLBACK_DEFAULT_CHUNK_KIB;
+    Cpa32U numErrors = 0;
+    Cpa32U i;
+    CpaStatus status;
+    int opt;
+
+    memset(&bench, 0, sizeof(bench));
+    bench.numWorkers = ICP_SAL_DC_SW_FALLBACK_DEFAULT_WORKERS;
+    while ((opt = getopt(argc, argv, "b:dw:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                chunkKib = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                huffType = CPA_DC_HT_FULL_DYNAMIC;
+                break;
+            case 'w':
+                bench.numWorkers = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr,
+                        "Usage: %s [-b chunk_kib] [-d] [-w workers] "
+                        "[file ...]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (chunkKib < 1 || chunkKib > 1024 || bench.numWorkers < 1 ||
+        bench.numWorkers > ICP_SAL_DC_SW_FALLBACK_MAX_WORKERS)
+    {
+        fprintf(stderr,
+                "chunk_kib must be between 1 and 1024, workers between 1 "
+                "and %u\n",
+                ICP_SAL_DC_SW_FALLBACK_MAX_WORKERS);
+        return EXIT_FAILURE;
+    }
+    if (optind < argc)
+    {
+        ppFiles = (const char **)&argv[optind];
+        numFiles = argc - optind;
+    }
+
+    if (CPA_STATUS_SUCCESS != qatBenchProcessStart())
+        return EXIT_FAILURE;
+
+    gBench = &bench;
+    status = qatBenchInstancesStart(QAT_BENCH_SERVICE_DC, 1, &bench.instance);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = benchSession(&bench, huffType);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            printf("Chunk size %u KiB, %s Huffman trees, %u threads\n",
+                   chunkKib,
+                   (CPA_DC_HT_STATIC == huffType) ? "static" : "dynamic",
+                   bench.numWorkers);
+            printf("%-12s %-8s %10s %8s %8s\n",
+                   "File",
+                   "Run",
+                   "Mbps",
+                   "Ratio",
+                   "Host");
+        }
+        for (i = 0; i < numFiles && CPA_STATUS_SUCCESS == status; i++)
+        {
+            pName = strrchr(ppFiles[i], '/');
+            pName = (NULL != pName) ? pName + 1 : ppFiles[i];
+            if (CPA_STATUS_SUCCESS != benchPrepare(&bench,
+                                                   ppFiles[i],
+                                                   chunkKib * 1024,
+                                                   huffType) ||
+                CPA_STATUS_SUCCESS != fallbackRun(&bench, pName))
+                numErrors++;
+            benchFree(&bench);
+        }
+        if (CPA_STATUS_SUCCESS != status)
+            numErrors++;
+        if (NULL != bench.session)
+        {
+            cpaDcRemoveSession(bench.instance, bench.session);
+            qaeMemFreeNUMA((void **)&bench.session);
+        }
+        qatBenchInstancesStop(QAT_BENCH_SERVICE_DC, 1, &bench.instance);
+    }
+    else
+    {
+        numErrors++;
+    }
+
+    qatBenchProcessStop();
+
+    printf("%s\n", numErrors ? "FAIL" : "PASS");
+    return numErrors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
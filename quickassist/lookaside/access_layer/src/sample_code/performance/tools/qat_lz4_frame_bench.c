@@ -0,0 +1,746 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_lz4_frame_bench.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Measure LZ4 frame compression (icp_sal_DcLz4FrameCompress()) of
+ *      files with one block in flight and with depth blocks in flight.
+ *
+ *      Each file is compressed loops times as one LZ4 frame of blocks of
+ *      the block maximum size, with block and content checksums. The
+ *      throughput and compression ratio of both runs are printed, and the
+ *      frame of each run is decoded, checksums included, and compared to
+ *      the file. With -o the frames are also written to dir/<file>.lz4 so
+ *      that they can be checked with the reference lz4 tool (lz4 -t).
+ *
+ *      Usage: qat_lz4_frame_bench [-b block_kib] [-d depth] [-l loops]
+ *                                 [-o dir] [file ...]
+ *          -b  block maximum size in KiB: 64, 256, 1024 or 4096
+ *              (default 64)
+ *          -d  blocks in flight of the pipelined run (default 8)
+ *          -l  times each file is compressed (default 10)
+ *          -o  directory to write the frames to
+ *
+ *      Without files the calgary and canterbury corpora are used.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_dc_lz4_frame.h"
+#include "icp_sal_poll.h"
+#include "qae_mem.h"
+#include "qat_bench_common.h"
+
+#define FRAME_DEFAULT_BLOCK_KIB (64)
+#define FRAME_DEFAULT_DEPTH (8)
+#define FRAME_DEFAULT_LOOPS (10)
+#define FRAME_TIMEOUT_NS (10ULL * 1000 * 1000 * 1000)
+
+#define LZ4_FRAME_MAGIC (0x184D2204U)
+#define LZ4_HEADER_SIZE (7)
+
+#define XXH_PRIME32_1 (0x9E3779B1U)
+#define XXH_PRIME32_2 (0x85EBCA77U)
+#define XXH_PRIME32_3 (0xC2B2AE3DU)
+#define XXH_PRIME32_4 (0x27D4EB2FU)
+#define XXH_PRIME32_5 (0x165667B1U)
+#define XXH_ROTL32(x, r) (((x) << (r)) | ((x) >> (32 - (r))))
+
+typedef struct frame_block_s
+{
+    CpaFlatBuffer srcFlat;
+    CpaFlatBuffer dstFlat;
+    CpaBufferList src;
+    CpaBufferList dst;
+    CpaDcRqResults results;
+} frame_block_t;
+
+typedef struct frame_bench_s
+{
+    CpaInstanceHandle instance;
+    Cpa8U *pData;
+    /* The file, copied to DMA-able memory block by block */
+    Cpa32U dataLen;
+    CpaDcCompLZ4BlockMaxSize blockMaxSize;
+    Cpa32U numBlocks;
+    frame_block_t *pBlocks;
+    volatile Cpa32U numCompleted;
+    volatile Cpa32U numErrors;
+} frame_bench_t;
+
+static frame_bench_t *gBench = NULL;
+
+static Cpa32U read32(const Cpa8U *p)
+{
+    return (Cpa32U)p[0] | ((Cpa32U)p[1] << 8) | ((Cpa32U)p[2] << 16) |
+           ((Cpa32U)p[3] << 24);
+}
+
+static Cpa32U xxhRound(Cpa32U acc, Cpa32U input)
+{
+    acc += input * XXH_PRIME32_2;
+    acc = XXH_ROTL32(acc, 13);
+    return acc * XXH_PRIME32_1;
+}
+
+/* XXH32 with seed 0, independent of the one in the library */
+static Cpa32U xxh32(const Cpa8U *p, Cpa64U len)
+{
+    const Cpa8U *pEnd = p + len;
+    Cpa32U v1 = XXH_PRIME32_1 + XXH_PRIME32_2;
+    Cpa32U v2 = XXH_PRIME32_2;
+    Cpa32U v3 = 0;
+    Cpa32U v4 = 0 - XXH_PRIME32_1;
+    Cpa32U h;
+
+    if (len >= 16)
+    {
+        while (pEnd - p >= 16)
+        {
+            v1 = xxhRound(v1, read32(p));
+            v2 = xxhRound(v2, read32(p + 4));
+            v3 = xxhRound(v3, read32(p + 8));
+            v4 = xxhRound(v4, read32(p + 12));
+            p += 16;
+        }
+        h = XXH_ROTL32(v1, 1) + XXH_ROTL32(v2, 7) + XXH_ROTL32(v3, 12) +
+            XXH_ROTL32(v4, 18);
+    }
+    else
+    {
+        h = XXH_PRIME32_5;
+    }
+    h += (Cpa32U)len;
+    while (pEnd - p >= 4)
+    {
+        h += read32(p) * XXH_PRIME32_3;
+        h = XXH_ROTL32(h, 17) * XXH_PRIME32_4;
+        p += 4;
+    }
+    while (p < pEnd)
+    {
+        h += (*p++) * XXH_PRIME32_5;
+        h = XXH_ROTL32(h, 11) * XXH_PRIME32_1;
+    }
+    h ^= h >> 15;
+    h *= XXH_PRIME32_2;
+    h ^= h >> 13;
+    h *= XXH_PRIME32_3;
+    h ^= h >> 16;
+
+    return h;
+}
+
+/* Read an LZ4 length extension, -1 if the input ends first */
+static int lz4ReadLength(const Cpa8U **pp, const Cpa8U *pEnd, Cpa32U *pLen)
+{
+    Cpa8U byte;
+
+    do
+    {
+        if (*pp >= pEnd)
+            return -1;
+        byte = *(*pp)++;
+        *pLen += byte;
+    } while (255 == byte);
+
+    return 0;
+}
+
+/* Decode one independent LZ4 block, returns the decoded length or -1 */
+static long lz4DecodeBlock(const Cpa8U *pIn,
+                           Cpa32U inLen,
+                           Cpa8U *pOut,
+                           Cpa32U outSize)
+{
+    const Cpa8U *p = pIn;
+    const Cpa8U *pEnd = pIn + inLen;
+    Cpa32U out = 0;
+    Cpa32U len;
+    Cpa32U offset;
+    Cpa8U token;
+
+    while (p < pEnd)
+    {
+        token = *p++;
+        len = token >> 4;
+        if (15 == len && lz4ReadLength(&p, pEnd, &len))
+            return -1;
+        if (len > (Cpa32U)(pEnd - p) || len > outSize - out)
+            return -1;
+        memcpy(pOut + out, p, len);
+        p += len;
+        out += len;
+        /* The last sequence has literals only */
+        if (p == pEnd)
+            break;
+
+        if (pEnd - p < 2)
+            return -1;
+        offset = (Cpa32U)p[0] | ((Cpa32U)p[1] << 8);
+        p += 2;
+        if (0 == offset || offset > out)
+            return -1;
+        len = token & 15;
+        if (15 == len && lz4ReadLength(&p, pEnd, &len))
+            return -1;
+        len += 4;
+        if (len > outSize - out)
+            return -1;
+        /* Byte by byte, the match may overlap its own output */
+        for (; len > 0; len--, out++)
+            pOut[out] = pOut[out - offset];
+    }
+
+    return (long)out;
+}
+
+/*
+ * Decode a single LZ4 frame with independent blocks into pOut, checking
+ * the header, block and content checksums. Returns the decoded length or
+ * -1.
+ */
+static long lz4DecodeFrame(const Cpa8U *pIn,
+                           Cpa64U inLen,
+                           Cpa8U *pOut,
+                           Cpa64U outSize)
+{
+    Cpa64U pos = LZ4_HEADER_SIZE;
+    Cpa64U out = 0;
+    Cpa32U blockMax;
+    Cpa32U word;
+    Cpa32U size;
+    Cpa8U flg;
+    int blockCksum;
+    int contentCksum;
+    long n;
+
+    if (inLen < LZ4_HEADER_SIZE || LZ4_FRAME_MAGIC != read32(pIn))
+        return -1;
+    flg = pIn[4];
+    /* Version 01, independent blocks, no content size nor dictionary */
+    if (0x40 != (flg & 0xC0) || !(flg & 0x20) || (flg & 0x09))
+        return -1;
+    blockCksum = (flg >> 4) & 1;
+    contentCksum = (flg >> 2) & 1;
+    blockMax = 1U << (8 + 2 * ((pIn[5] >> 4) & 7));
+    if (pIn[6] != (Cpa8U)(xxh32(pIn + 4, 2) >> 8))
+        return -1;
+
+    for (;;)
+    {
+        if (inLen - pos < 4)
+            return -1;
+        word = read32(pIn + pos);
+        pos += 4;
+        if (0 == word)
+            break;
+        size = word & 0x7FFFFFFF;
+        if (size > blockMax || inLen - pos < size + 4 * blockCksum)
+            return -1;
+        if (blockCksum && read32(pIn + pos + size) != xxh32(pIn + pos, size))
+            return -1;
+        if (word & 0x80000000)
+        {
+            if (size > outSize - out)
+                return -1;
+            memcpy(pOut + out, pIn + pos, size);
+            n = size;
+        }
+        else
+        {
+            n = lz4DecodeBlock(pIn + pos,
+                               size,
+                               pOut + out,
+                               (outSize - out < blockMax) ? outSize - out
+                                                          : blockMax);
+            if (n < 0)
+                return -1;
+        }
+        out += n;
+        pos += size + 4 * blockCksum;
+    }
+
+    if (contentCksum)
+    {
+        if (inLen - pos < 4 || read32(pIn + pos) != xxh32(pOut, out))
+            return -1;
+        pos += 4;
+    }
+
+    return (pos == inLen) ? (long)out : -1;
+}
+
+static void frameCallback(void *pCallbackTag, CpaStatus status)
+{
+    frame_block_t *pBlock = pCallbackTag;
+
+    /* Blocks must complete in submission order */
+    if (CPA_STATUS_SUCCESS != status ||
+        CPA_DC_OK != pBlock->results.status ||
+        pBlock != &gBench->pBlocks[gBench->numCompleted])
+        gBench->numErrors++;
+    gBench->numCompleted++;
+}
+
+/* Compress the file once as a frame, returns the frame length */
+static CpaStatus frameOnce(frame_bench_t *pBench,
+                           icp_sal_dc_lz4_frame_t frame,
+                           Cpa64U *pFrameLen)
+{
+    frame_block_t *pBlock;
+    Cpa32U next = 0;
+    Cpa32U i;
+    Cpa64U start;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pBench->numCompleted = 0;
+    pBench->numErrors = 0;
+    start = qatBenchTimeNs();
+    while (pBench->numCompleted < pBench->numBlocks)
+    {
+        while (next < pBench->numBlocks)
+        {
+            pBlock = &pBench->pBlocks[next];
+            status = icp_sal_DcLz4FrameCompress(
+                frame,
+                &pBlock->src,
+                &pBlock->dst,
+                &pBlock->results,
+                (next == pBench->numBlocks - 1) ? CPA_TRUE : CPA_FALSE,
+                pBlock);
+            if (CPA_STATUS_RETRY == status)
+                break;
+            if (CPA_STATUS_SUCCESS != status)
+                return status;
+            next++;
+        }
+        icp_sal_DcPollInstance(pBench->instance, 0);
+        if (qatBenchTimeNs() - start > FRAME_TIMEOUT_NS)
+        {
+            fprintf(stderr, "Timed out waiting for blocks\n");
+            return CPA_STATUS_FAIL;
+        }
+    }
+    if (pBench->numErrors)
+        return CPA_STATUS_FAIL;
+
+    *pFrameLen = 0;
+    for (i = 0; i < pBench->numBlocks; i++)
+        *pFrameLen += pBench->pBlocks[i].results.produced;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Gather the block outputs of the last run into one frame */
+static Cpa8U *frameGather(frame_bench_t *pBench, Cpa64U frameLen)
+{
+    frame_block_t *pBlock;
+    Cpa8U *pFrame;
+    Cpa64U pos = 0;
+    Cpa32U i;
+
+    pFrame = malloc(frameLen);
+    if (NULL == pFrame)
+        return NULL;
+    for (i = 0; i < pBench->numBlocks; i++)
+    {
+        pBlock = &pBench->pBlocks[i];
+        memcpy(pFrame + pos, pBlock->dstFlat.pData, pBlock->results.produced);
+        pos += pBlock->results.produced;
+    }
+
+    return pFrame;
+}
+
+static CpaStatus frameVerify(frame_bench_t *pBench,
+                             const Cpa8U *pFrame,
+                             Cpa64U frameLen)
+{
+    Cpa8U *pOut;
+    long outLen;
+
+    pOut = malloc(pBench->dataLen);
+    if (NULL == pOut)
+        return CPA_STATUS_RESOURCE;
+    outLen = lz4DecodeFrame(pFrame, frameLen, pOut, pBench->dataLen);
+    if (outLen != (long)pBench->dataLen ||
+        memcmp(pOut, pBench->pData, pBench->dataLen))
+        outLen = -1;
+    free(pOut);
+
+    return (outLen < 0) ? CPA_STATUS_FAIL : CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus frameWrite(const char *pDir,
+                            const char *pName,
+                            const Cpa8U *pFrame,
+                            Cpa64U frameLen)
+{
+    char path[4096];
+    FILE *pFile;
+    size_t written = 0;
+
+    snprintf(path, sizeof(path), "%s/%s.lz4", pDir, pName);
+    pFile = fopen(path, "wb");
+    if (NULL != pFile)
+    {
+        written = fwrite(pFrame, 1, frameLen, pFile);
+        if (0 != fclose(pFile))
+            written = 0;
+    }
+    if (written != frameLen)
+    {
+        fprintf(stderr, "Failed to write %s\n", path);
+        return CPA_STATUS_FAIL;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus frameCreate(frame_bench_t *pBench,
+                             Cpa32U depth,
+                             icp_sal_dc_lz4_frame_t *pFrame)
+{
+    icp_sal_dc_lz4_frame_setup_t setup;
+    CpaStatus status;
+
+    memset(&setup, 0, sizeof(setup));
+    setup.compLevel = CPA_DC_L1;
+    setup.blockMaxSize = pBench->blockMaxSize;
+    setup.blockChecksum = CPA_TRUE;
+    setup.contentChecksum = CPA_TRUE;
+    setup.maxInflight = depth;
+    status = icp_sal_DcLz4FrameCreate(
+        pBench->instance, &setup, frameCallback, pFrame);
+    if (CPA_STATUS_SUCCESS != status)
+        fprintf(stderr, "Failed to create the frame stream (%d)\n", status);
+
+    return status;
+}
+
+static CpaStatus frameRun(frame_bench_t *pBench,
+                          const char *pName,
+                          Cpa32U depth,
+                          Cpa32U loops,
+                          const char *pOutDir)
+{
+    icp_sal_dc_lz4_frame_t frame = NULL;
+    Cpa8U *pFrame = NULL;
+    Cpa64U frameLen = 0;
+    Cpa64U start;
+    Cpa64U elapsed;
+    Cpa32U i;
+    CpaStatus status;
+
+    status = frameCreate(pBench, depth, &frame);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    start = qatBenchTimeNs();
+    for (i = 0; i < loops && CPA_STATUS_SUCCESS == status; i++)
+        status = frameOnce(pBench, frame, &frameLen);
+    elapsed = qatBenchTimeNs() - start;
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr,
+                "Compression failed (%d), %u block errors\n",
+                status,
+                pBench->numErrors);
+    }
+    else
+    {
+        pFrame = frameGather(pBench, frameLen);
+        status = (NULL != pFrame) ? frameVerify(pBench, pFrame, frameLen)
+                                  : CPA_STATUS_RESOURCE;
+        if (CPA_STATUS_SUCCESS != status)
+            fprintf(stderr, "The frame does not decode to the input\n");
+        else if (NULL != pOutDir)
+            status = frameWrite(pOutDir, pName, pFrame, frameLen);
+        free(pFrame);
+    }
+
+    if (CPA_STATUS_SUCCESS == status)
+        printf("%-12s %6u %10.1f %8.3f %s\n",
+               pName,
+               depth,
+               (double)pBench->dataLen * loops * 8 * 1000.0 /
+                   (elapsed ? elapsed : 1),
+               (double)pBench->dataLen / (frameLen ? frameLen : 1),
+               "verified");
+    else
+        printf("%-12s %6u %10s %8s %s\n", pName, depth, "-", "-", "FAILED");
+
+    /* Blocks are left in flight only on a timeout */
+    if (CPA_STATUS_SUCCESS != icp_sal_DcLz4FrameRemove(frame))
+        fprintf(stderr, "Frame stream left with blocks in flight\n");
+
+    return status;
+}
+
+static void benchFree(frame_bench_t *pBench)
+{
+    frame_block_t *pBlock;
+    Cpa32U i;
+
+    for (i = 0; NULL != pBench->pBlocks && i < pBench->numBlocks; i++)
+    {
+        pBlock = &pBench->pBlocks[i];
+        if (NULL != pBlock->srcFlat.pData)
+            qaeMemFreeNUMA((void **)&pBlock->srcFlat.pData);
+        if (NULL != pBlock->dstFlat.pData)
+            qaeMemFreeNUMA((void **)&pBlock->dstFlat.pData);
+        if (NULL != pBlock->src.pPrivateMetaData)
+            qaeMemFreeNUMA(&pBlock->src.pPrivateMetaData);
+        if (NULL != pBlock->dst.pPrivateMetaData)
+            qaeMemFreeNUMA(&pBlock->dst.pPrivateMetaData);
+    }
+    free(pBench->pBlocks);
+    pBench->pBlocks = NULL;
+    free(pBench->pData);
+    pBench->pData = NULL;
+}
+
+/* Cut the file into blocks, each with a destination of bound bytes */
+static CpaStatus benchPrepare(frame_bench_t *pBench,
+                              const char *pFile,
+                              Cpa32U blockSize)
+{
+    icp_sal_dc_lz4_frame_t frame = NULL;
+    frame_block_t *pBlock;
+    Cpa32U metaSize = 0;
+    Cpa32U bound = 0;
+    Cpa32U offset;
+    Cpa32U i;
+    CpaStatus status;
+
+    pBench->pData = qatBenchLoadFile(pFile, &pBench->dataLen);
+    if (NULL == pBench->pData)
+    {
+        fprintf(stderr, "Failed to load %s\n", pFile);
+        return CPA_STATUS_FAIL;
+    }
+
+    status = frameCreate(pBench, 1, &frame);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = icp_sal_DcLz4FrameCompressBound(frame, blockSize, &bound);
+        icp_sal_DcLz4FrameRemove(frame);
+    }
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcBufferListGetMetaSize(pBench->instance, 1, &metaSize);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    pBench->numBlocks = (pBench->dataLen + blockSize - 1) / blockSize;
+    pBench->pBlocks = calloc(pBench->numBlocks, sizeof(frame_block_t));
+    if (NULL == pBench->pBlocks)
+        return CPA_STATUS_RESOURCE;
+
+    for (i = 0; i < pBench->numBlocks; i++)
+    {
+        pBlock = &pBench->pBlocks[i];
+        offset = i * blockSize;
+        pBlock->srcFlat.dataLenInBytes = (pBench->dataLen - offset < blockSize)
+                                             ? pBench->dataLen - offset
+                                             : blockSize;
+        pBlock->srcFlat.pData =
+            qaeMemAllocNUMA(pBlock->srcFlat.dataLenInBytes, 0, 64);
+        pBlock->dstFlat.dataLenInBytes = bound;
+        pBlock->dstFlat.pData = qaeMemAllocNUMA(bound, 0, 64);
+        pBlock->src.numBuffers = 1;
+        pBlock->src.pBuffers = &pBlock->srcFlat;
+        pBlock->src.pPrivateMetaData = qaeMemAllocNUMA(metaSize, 0, 64);
+        pBlock->dst.numBuffers = 1;
+        pBlock->dst.pBuffers = &pBlock->dstFlat;
+        pBlock->dst.pPrivateMetaData = qaeMemAllocNUMA(metaSize, 0, 64);
+        if (NULL == pBlock->srcFlat.pData || NULL == pBlock->dstFlat.pData ||
+            NULL == pBlock->src.pPrivateMetaData ||
+            NULL == pBlock->dst.pPrivateMetaData)
+            return CPA_STATUS_RESOURCE;
+        memcpy(pBlock->srcFlat.pData,
+               pBench->pData + offset,
+               pBlock->srcFlat.dataLenInBytes);
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *defaultFiles[] = {SAMPLE_CODE_CORPUS_PATH "calgary",
+                                         SAMPLE_CODE_CORPUS_PATH
+                                         "canterbury"};
+    frame_bench_t bench;
+    const char **ppFiles = defaultFiles;
+    const char *pOutDir = NULL;
+    const char *pName;
+    Cpa32U numFiles = sizeof(defaultFiles) / sizeof(defaultFiles[0]);
+    Cpa32U blockKib = FRAME_DEFAULT_BLOCK_KIB;
+    Cpa32U depth = FRAME_DEFAULT_DEPTH;
+    Cpa32U loops = FRAME_DEFAULT_LOOPS;
+    Cpa32U numErrors = 0;
+    Cpa32U i;
+    CpaStatus status;
+    int opt;
+
+    memset(&bench, 0, sizeof(bench));
+    while ((opt = getopt(argc, argv, "b:d:l:o:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                blockKib = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                depth = strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                loops = strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                pOutDir = optarg;
+                break;
+            default:
+                fprintf(stderr,
+                        "Usage: %s [-b block_kib] [-d depth] [-l loops] "
+                        "[-o dir] [file ...]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    switch (blockKib)
+    {
+        case 64:
+            bench.blockMaxSize = CPA_DC_LZ4_MAX_BLOCK_SIZE_64K;
+            break;
+        case 256:
+            bench.blockMaxSize = CPA_DC_LZ4_MAX_BLOCK_SIZE_256K;
+            break;
+        case 1024:
+            bench.blockMaxSize = CPA_DC_LZ4_MAX_BLOCK_SIZE_1M;
+            break;
+        case 4096:
+            bench.blockMaxSize = CPA_DC_LZ4_MAX_BLOCK_SIZE_4M;
+            break;
+        default:
+            fprintf(stderr, "block_kib must be 64, 256, 1024 or 4096\n");
+            return EXIT_FAILURE;
+    }
+    if (0 == loops || depth < 1 || depth > ICP_SAL_DC_LZ4_FRAME_MAX_INFLIGHT)
+    {
+        fprintf(stderr,
+                "loops must be non zero, depth between 1 and %u\n",
+                ICP_SAL_DC_LZ4_FRAME_MAX_INFLIGHT);
+        return EXIT_FAILURE;
+    }
+    if (optind < argc)
+    {
+        ppFiles = (const char **)&argv[optind];
+        numFiles = argc - optind;
+    }
+
+    if (CPA_STATUS_SUCCESS != qatBenchProcessStart())
+        return EXIT_FAILURE;
+
+    gBench = &bench;
+    status = qatBenchInstancesStart(QAT_BENCH_SERVICE_DC, 1, &bench.instance);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        printf("Block size %u KiB, %u loops\n", blockKib, loops);
+        printf("%-12s %6s %10s %8s\n", "File", "Depth", "Mbps", "Ratio");
+        for (i = 0; i < numFiles; i++)
+        {
+            pName = strrchr(ppFiles[i], '/');
+            pName = (NULL != pName) ? pName + 1 : ppFiles[i];
+            status = benchPrepare(&bench, ppFiles[i], blockKib * 1024);
+            if (CPA_STATUS_SUCCESS == status)
+                status = frameRun(
+                    &bench, pName, 1, loops, (depth > 1) ? NULL : pOutDir);
+            if (CPA_STATUS_SUCCESS == status && depth > 1)
+                status = frameRun(&bench, pName, depth, loops, pOutDir);
+            if (CPA_STATUS_SUCCESS != status)
+                numErrors++;
+            benchFree(&bench);
+        }
+        qatBenchInstancesStop(QAT_BENCH_SERVICE_DC, 1, &bench.instance);
+    }
+    else
+    {
+        numErrors++;
+    }
+
+    qatBenchProcessStop();
+
+    printf("%s\n", numErrors ? "FAIL" : "PASS");
+    return numErrors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
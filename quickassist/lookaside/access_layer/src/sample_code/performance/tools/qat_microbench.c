@@ -0,0 +1,767 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_microbench.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Measure the cost of the library internals on the request path,
+ *      without a device, from 1 up to -t threads.
+ *
+ *      The tool is linked against the library objects rather than the
+ *      shared library, so that functions which are not exported can be
+ *      called. Memory comes from USDM with no device registered, and the
+ *      rings are host memory rings with a heap page standing in for the
+ *      ring CSRs, so the numbers are those of the software alone.
+ *
+ *      The benchmarks are:
+ *          mempool       Lac_MemPoolEntryAlloc() and Lac_MemPoolEntryFree()
+ *                        of one entry of a pool shared by all threads
+ *          ring-put      adf_user_put_msg() of a 64 byte message
+ *          ring-poll     adf_user_notify_msgs_poll() of a batch of
+ *                        messages, per message
+ *          virt2phys     qaeVirtToPhysNUMA() of an address in a USDM block
+ *          crc32         dcCalculateCrc32() of a -s byte buffer
+ *          crc64         dcCalculateCrc64() of a -s byte buffer
+ *          bufdesc       LacBuffDesc_BufferListDescWrite() of a list of
+ *                        four buffers
+ *          dc-session    cpaDcInitSession() and cpaDcRemoveSession() of a
+ *                        stateless deflate session
+ *
+ *      Each thread has its own ring, buffers and session; the pool and the
+ *      compression instance are shared. For each thread count the time per
+ *      operation of one thread, the throughput of all threads and the
+ *      throughput relative to one thread are printed.
+ *
+ *      Usage: qat_microbench [-b benchmark] [-i iterations] [-s size]
+ *                            [-t threads]
+ *          -b  run only this benchmark (default all)
+ *          -i  operations per thread (default 1000000)
+ *          -s  CRC and buffer list size in bytes (default 4096)
+ *          -t  highest thread count (default the online CPUs, up to 64)
+ *
+ *****************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_accel_devices.h"
+#include "icp_platform.h"
+#include "adf_platform_common.h"
+#include "adf_user_ring.h"
+#include "qae_mem.h"
+
+#include "dc_crc32.h"
+#include "dc_crc64.h"
+#include "lac_buffer_desc.h"
+#include "lac_mem_pools.h"
+#include "lac_sal_types.h"
+#include "sal_types_compression.h"
+
+extern CpaStatus qaeMemInit(void);
+extern void qaeMemDestroy(void);
+
+#define MB_DEFAULT_ITERATIONS (1000000)
+#define MB_DEFAULT_SIZE (4096)
+#define MB_MAX_THREADS (64)
+
+#define MB_POOL_ENTRIES (1024)
+#define MB_POOL_ENTRY_SIZE (256)
+
+#define MB_RING_MSG_SIZE (ADF_MSG_SIZE_64_BYTES)
+#define MB_RING_NUM_MSGS (256)
+/* log2(MB_RING_NUM_MSGS * MB_RING_MSG_SIZE) */
+#define MB_RING_MODULO (14)
+#define MB_RING_BATCH (32)
+#define MB_CSR_SIZE (64 * 1024)
+
+#define MB_V2P_BLOCK_SIZE (128 * 1024)
+#define MB_V2P_STRIDE (4096 + 64)
+
+#define MB_DESC_BUFFERS (4)
+#define MB_META_SIZE (512)
+
+typedef struct mb_thread_s mb_thread_t;
+
+typedef struct mb_bench_s
+{
+    const char *name;
+    CpaStatus (*setup)(mb_thread_t *pThread);
+    CpaStatus (*run)(mb_thread_t *pThread);
+    void (*teardown)(mb_thread_t *pThread);
+} mb_bench_t;
+
+struct mb_thread_s
+{
+    pthread_t thread;
+    const mb_bench_t *pBench;
+    Cpa64U iterations;
+    Cpa64U elapsedNs;
+    CpaStatus status;
+    Cpa64U sink;
+
+    Cpa8U *pData;
+    Cpa8U *pMeta;
+    CpaFlatBuffer flatBuffers[MB_DESC_BUFFERS];
+    CpaBufferList bufferList;
+
+    adf_dev_ring_handle_t ring;
+    OsalMutex ringLock;
+    Cpa32U inFlight;
+    void *pCsr;
+
+    CpaDcSessionHandle session;
+};
+
+static lac_memory_pool_id_t gPool = LAC_MEM_POOL_INIT_POOL_ID;
+static sal_compression_service_t gDcService;
+static icp_accel_dev_t gAccelDev;
+static CpaDcSessionSetupData gSessionSetup;
+static Cpa32U gSessionSize = 0;
+static Cpa32U gSize = MB_DEFAULT_SIZE;
+static pthread_barrier_t gBarrier;
+
+/* Responses seen by the ring callback of the polling thread */
+static __thread Cpa32U gRingResponses = 0;
+
+static Cpa64U timeNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Cpa64U)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static CpaPhysicalAddr mbVirtToPhys(void *pVirtAddr)
+{
+    return (CpaPhysicalAddr)qaeVirtToPhysNUMA(pVirtAddr);
+}
+
+static CpaStatus mbDataAlloc(mb_thread_t *pThread, Cpa32U size)
+{
+    Cpa32U i;
+
+    pThread->pData = qaeMemAllocNUMA(size, 0, 64);
+    if (NULL == pThread->pData)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    for (i = 0; i < size; i++)
+    {
+        pThread->pData[i] = (Cpa8U)(i * 31 + (i >> 8));
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static void mbDataFree(mb_thread_t *pThread)
+{
+    if (NULL != pThread->pMeta)
+    {
+        qaeMemFreeNUMA((void **)&pThread->pMeta);
+    }
+    if (NULL != pThread->pData)
+    {
+        qaeMemFreeNUMA((void **)&pThread->pData);
+    }
+}
+
+static CpaStatus mbMemPoolRun(mb_thread_t *pThread)
+{
+    Cpa64U i;
+    void *pEntry;
+
+    for (i = 0; i < pThread->iterations; i++)
+    {
+        pEntry = Lac_MemPoolEntryAlloc(gPool);
+        if ((NULL == pEntry) || ((void *)CPA_STATUS_RETRY == pEntry))
+        {
+            return CPA_STATUS_FAIL;
+        }
+        Lac_MemPoolEntryFree(pEntry);
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static void mbRingCallback(void *pMsg)
+{
+    (void)pMsg;
+    gRingResponses++;
+}
+
+static CpaStatus mbRingSetup(mb_thread_t *pThread)
+{
+    adf_dev_ring_handle_t *pRing = &pThread->ring;
+    Cpa32U ringBytes = MB_RING_NUM_MSGS * MB_RING_MSG_SIZE;
+
+    pRing->ring_virt_addr = qaeMemAllocNUMA(ringBytes, 0, ringBytes);
+    pThread->pCsr = calloc(1, MB_CSR_SIZE);
+    if ((NULL == pRing->ring_virt_addr) || (NULL == pThread->pCsr))
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    if (OSAL_SUCCESS != ICP_MUTEX_INIT(&pThread->ringLock))
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    memset(pRing->ring_virt_addr, EMPTY_RING_SIG_BYTE, ringBytes);
+
+    pRing->accel_dev = &gAccelDev;
+    pRing->ring_size = ringBytes;
+    pRing->message_size = MB_RING_MSG_SIZE;
+    pRing->modulo = MB_RING_MODULO;
+    pRing->callback = mbRingCallback;
+    pRing->resp = ICP_RESP_TYPE_POLL;
+    pRing->user_lock = &pThread->ringLock;
+    pRing->in_flight = &pThread->inFlight;
+    pRing->max_requests_inflight = MB_RING_NUM_MSGS;
+    pRing->min_resps_per_head_write = MB_RING_BATCH;
+    pRing->coal_write_count = MB_RING_BATCH;
+    pRing->csr_addr = pThread->pCsr;
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Put a batch of messages and poll them back from the same ring, timing
+ * either the puts or the poll */
+static CpaStatus mbRingRun(mb_thread_t *pThread, CpaBoolean timePut)
+{
+    Cpa32U msg[MB_RING_MSG_SIZE / sizeof(Cpa32U)] = {0};
+    Cpa64U done = 0, start, putNs = 0, pollNs = 0;
+    Cpa32U i;
+
+    while (done < pThread->iterations)
+    {
+        start = timeNs();
+        for (i = 0; i < MB_RING_BATCH; i++)
+        {
+            msg[0] = (Cpa32U)(done + i);
+            if (CPA_STATUS_SUCCESS !=
+                adf_user_put_msg(&pThread->ring, msg, NULL))
+            {
+                return CPA_STATUS_FAIL;
+            }
+        }
+        putNs += timeNs() - start;
+
+        gRingResponses = 0;
+        start = timeNs();
+        if (CPA_STATUS_SUCCESS != adf_user_notify_msgs_poll(&pThread->ring))
+        {
+            return CPA_STATUS_FAIL;
+        }
+        pollNs += timeNs() - start;
+        if (MB_RING_BATCH != gRingResponses)
+        {
+            return CPA_STATUS_FAIL;
+        }
+        done += MB_RING_BATCH;
+    }
+    pThread->iterations = done;
+    pThread->elapsedNs = timePut ? putNs : pollNs;
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus mbRingPutRun(mb_thread_t *pThread)
+{
+    return mbRingRun(pThread, CPA_TRUE);
+}
+
+static CpaStatus mbRingPollRun(mb_thread_t *pThread)
+{
+    return mbRingRun(pThread, CPA_FALSE);
+}
+
+static void mbRingTeardown(mb_thread_t *pThread)
+{
+    if (NULL != pThread->ring.user_lock)
+    {
+        ICP_MUTEX_UNINIT(&pThread->ringLock);
+    }
+    if (NULL != pThread->ring.ring_virt_addr)
+    {
+        qaeMemFreeNUMA(&pThread->ring.ring_virt_addr);
+    }
+    free(pThread->pCsr);
+}
+
+static CpaStatus mbVirtToPhysSetup(mb_thread_t *pThread)
+{
+    return mbDataAlloc(pThread, MB_V2P_BLOCK_SIZE);
+}
+
+static CpaStatus mbVirtToPhysRun(mb_thread_t *pThread)
+{
+    Cpa64U i, offset = 0, phys;
+
+    for (i = 0; i < pThread->iterations; i++)
+    {
+        phys = qaeVirtToPhysNUMA(pThread->pData + offset);
+        if (0 == phys)
+        {
+            return CPA_STATUS_FAIL;
+        }
+        pThread->sink += phys;
+        offset += MB_V2P_STRIDE;
+        if (offset >= MB_V2P_BLOCK_SIZE)
+        {
+            offset -= MB_V2P_BLOCK_SIZE;
+        }
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+/* One list of gSize bytes in MB_DESC_BUFFERS buffers, with its metadata */
+static CpaStatus mbBufferListSetup(mb_thread_t *pThread)
+{
+    Cpa32U i, chunk = gSize / MB_DESC_BUFFERS;
+
+    if (CPA_STATUS_SUCCESS != mbDataAlloc(pThread, gSize))
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    pThread->pMeta = qaeMemAllocNUMA(MB_META_SIZE, 0, 64);
+    if (NULL == pThread->pMeta)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    for (i = 0; i < MB_DESC_BUFFERS; i++)
+    {
+        pThread->flatBuffers[i].pData = pThread->pData + i * chunk;
+        pThread->flatBuffers[i].dataLenInBytes =
+            (MB_DESC_BUFFERS - 1 == i) ? gSize - i * chunk : chunk;
+    }
+    pThread->bufferList.numBuffers = MB_DESC_BUFFERS;
+    pThread->bufferList.pBuffers = pThread->flatBuffers;
+    pThread->bufferList.pPrivateMetaData = pThread->pMeta;
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus mbCrc32Run(mb_thread_t *pThread)
+{
+    Cpa32U crc = 0;
+    Cpa64U i;
+
+    for (i = 0; i < pThread->iterations; i++)
+    {
+        crc = dcCalculateCrc32(&pThread->bufferList, gSize, crc);
+    }
+    pThread->sink += crc;
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus mbCrc64Run(mb_thread_t *pThread)
+{
+    Cpa64U crc = 0;
+    Cpa64U i;
+
+    for (i = 0; i < pThread->iterations; i++)
+    {
+        crc = dcCalculateCrc64(&pThread->bufferList, gSize, crc);
+    }
+    pThread->sink += crc;
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus mbBufDescRun(mb_thread_t *pThread)
+{
+    Cpa64U i, phys = 0;
+
+    for (i = 0; i < pThread->iterations; i++)
+    {
+        if (CPA_STATUS_SUCCESS !=
+            LacBuffDesc_BufferListDescWrite(
+                &pThread->bufferList,
+                &phys,
+                CPA_FALSE,
+                &gDcService.generic_service_info))
+        {
+            return CPA_STATUS_FAIL;
+        }
+    }
+    pThread->sink += phys;
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus mbSessionSetup(mb_thread_t *pThread)
+{
+    pThread->session = qaeMemAllocNUMA(gSessionSize, 0, 64);
+    if (NULL == pThread->session)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus mbSessionRun(mb_thread_t *pThread)
+{
+    CpaDcSessionSetupData setup;
+    Cpa64U i;
+
+    for (i = 0; i < pThread->iterations; i++)
+    {
+        /* cpaDcInitSession() may update the setup data */
+        setup = gSessionSetup;
+        if ((CPA_STATUS_SUCCESS != cpaDcInitSession(&gDcService,
+                                                    pThread->session,
+                                                    &setup,
+                                                    NULL,
+                                                    NULL)) ||
+            (CPA_STATUS_SUCCESS !=
+             cpaDcRemoveSession(&gDcService, pThread->session)))
+        {
+            return CPA_STATUS_FAIL;
+        }
+    }
+    return CPA_STATUS_SUCCESS;
+}
+
+static void mbSessionTeardown(mb_thread_t *pThread)
+{
+    if (NULL != pThread->session)
+    {
+        qaeMemFreeNUMA(&pThread->session);
+    }
+}
+
+static const mb_bench_t gBenches[] = {
+    { "mempool", NULL, mbMemPoolRun, NULL },
+    { "ring-put", mbRingSetup, mbRingPutRun, mbRingTeardown },
+    { "ring-poll", mbRingSetup, mbRingPollRun, mbRingTeardown },
+    { "virt2phys", mbVirtToPhysSetup, mbVirtToPhysRun, mbDataFree },
+    { "crc32", mbBufferListSetup, mbCrc32Run, mbDataFree },
+    { "crc64", mbBufferListSetup, mbCrc64Run, mbDataFree },
+    { "bufdesc", mbBufferListSetup, mbBufDescRun, mbDataFree },
+    { "dc-session", mbSessionSetup, mbSessionRun, mbSessionTeardown },
+};
+
+#define MB_NUM_BENCHES (sizeof(gBenches) / sizeof(gBenches[0]))
+
+static void *mbThread(void *arg)
+{
+    mb_thread_t *pThread = arg;
+    const mb_bench_t *pBench = pThread->pBench;
+    Cpa64U start;
+
+    if (NULL != pBench->setup)
+    {
+        pThread->status = pBench->setup(pThread);
+    }
+
+    /* Start all threads together, even if one of them failed */
+    pthread_barrier_wait(&gBarrier);
+    if (CPA_STATUS_SUCCESS == pThread->status)
+    {
+        start = timeNs();
+        pThread->status = pBench->run(pThread);
+        /* The ring benchmarks time their own phases */
+        if (0 == pThread->elapsedNs)
+        {
+            pThread->elapsedNs = timeNs() - start;
+        }
+    }
+    pthread_barrier_wait(&gBarrier);
+
+    if (NULL != pBench->teardown)
+    {
+        pBench->teardown(pThread);
+    }
+    return NULL;
+}
+
+/* Run one benchmark in numThreads threads; pKops returns the throughput */
+static CpaStatus mbRun(const mb_bench_t *pBench,
+                       Cpa32U numThreads,
+                       Cpa64U iterations,
+                       double *pNsPerOp,
+                       double *pKops)
+{
+    mb_thread_t *pThreads;
+    Cpa64U totalOps = 0, totalNs = 0, maxNs = 0;
+    Cpa32U i, created = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pThreads = calloc(numThreads, sizeof(mb_thread_t));
+    if (NULL == pThreads)
+    {
+        return CPA_STATUS_RESOURCE;
+    }
+    if (pthread_barrier_init(&gBarrier, NULL, numThreads))
+    {
+        free(pThreads);
+        return CPA_STATUS_RESOURCE;
+    }
+
+    for (i = 0; i < numThreads; i++)
+    {
+        pThreads[i].pBench = pBench;
+        pThreads[i].iterations = iterations;
+        pThreads[i].status = CPA_STATUS_SUCCESS;
+        if (pthread_create(&pThreads[i].thread, NULL, mbThread, &pThreads[i]))
+        {
+            break;
+        }
+        created++;
+    }
+    if (created != numThreads)
+    {
+        /* The barrier can not be reached any more; give up on the run */
+        printf("%s: failed to create thread %u\n", pBench->name, created);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < numThreads; i++)
+    {
+        pthread_join(pThreads[i].thread, NULL);
+        if (CPA_STATUS_SUCCESS != pThreads[i].status)
+        {
+            status = pThreads[i].status;
+            continue;
+        }
+        totalOps += pThreads[i].iterations;
+        totalNs += pThreads[i].elapsedNs;
+        if (pThreads[i].elapsedNs > maxNs)
+        {
+            maxNs = pThreads[i].elapsedNs;
+        }
+    }
+    pthread_barrier_destroy(&gBarrier);
+    free(pThreads);
+
+    if ((CPA_STATUS_SUCCESS == status) && (0 != totalOps) && (0 != maxNs))
+    {
+        *pNsPerOp = (double)totalNs / (double)totalOps;
+        *pKops = (double)totalOps * 1000000.0 / (double)maxNs;
+    }
+    return status;
+}
+
+/* 1, 2, 4 ... threads, ending on maxThreads */
+static Cpa32U mbNextThreads(Cpa32U numThreads, Cpa32U maxThreads)
+{
+    if ((numThreads < maxThreads) && (numThreads * 2 > maxThreads))
+    {
+        return maxThreads;
+    }
+    return numThreads * 2;
+}
+
+static CpaStatus mbServiceInit(void)
+{
+    CpaStatus status;
+    Cpa32U contextSize = 0;
+
+    /* A running compression instance without rings, enough for the
+     * session and buffer list code */
+    gDcService.generic_service_info.type = SAL_SERVICE_TYPE_COMPRESSION;
+    gDcService.generic_service_info.state = SAL_SERVICE_STATE_RUNNING;
+    gDcService.generic_service_info.virt2PhysClient = mbVirtToPhys;
+    gDcService.generic_service_info.capabilitiesMask =
+        ICP_ACCEL_CAPABILITIES_COMPRESSION;
+    gDcService.generic_service_info.isGen4 = CPA_TRUE;
+
+    gSessionSetup.compLevel = CPA_DC_L1;
+    gSessionSetup.compType = CPA_DC_DEFLATE;
+    gSessionSetup.huffType = CPA_DC_HT_STATIC;
+    gSessionSetup.autoSelectBestHuffmanTree = CPA_DC_ASB_DISABLED;
+    gSessionSetup.sessDirection = CPA_DC_DIR_COMBINED;
+    gSessionSetup.sessState = CPA_DC_STATELESS;
+    gSessionSetup.checksum = CPA_DC_CRC32;
+
+    status = cpaDcGetSessionSize(
+        &gDcService, &gSessionSetup, &gSessionSize, &contextSize);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    status = Lac_MemPoolsInit();
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    return Lac_MemPoolCreate(&gPool,
+                             "microbench",
+                             MB_POOL_ENTRIES,
+                             MB_POOL_ENTRY_SIZE,
+                             LAC_64BYTE_ALIGNMENT,
+                             CPA_FALSE,
+                             0);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *pOnly = NULL;
+    Cpa64U iterations = MB_DEFAULT_ITERATIONS;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    Cpa32U maxThreads, numThreads, b;
+    double nsPerOp = 0, kops = 0, baseKops = 0;
+    int opt, ran = 0, failed = 0;
+
+    maxThreads = (online < 1) ? 1 : (Cpa32U)online;
+    if (maxThreads > MB_MAX_THREADS)
+    {
+        maxThreads = MB_MAX_THREADS;
+    }
+
+    while ((opt = getopt(argc, argv, "b:i:s:t:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                pOnly = optarg;
+                break;
+            case 'i':
+                iterations = strtoull(optarg, NULL, 0);
+                break;
+            case 's':
+                gSize = (Cpa32U)strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                maxThreads = (Cpa32U)strtoul(optarg, NULL, 0);
+                break;
+            default:
+                printf("Usage: %s [-b benchmark] [-i iterations] [-s size] "
+                       "[-t threads]\n",
+                       argv[0]);
+                return 1;
+        }
+    }
+    if ((0 == iterations) || (gSize < MB_DESC_BUFFERS) || (0 == maxThreads) ||
+        (maxThreads > MB_MAX_THREADS))
+    {
+        printf("Invalid parameters: iterations must be non zero, size at "
+               "least %d and threads 1 to %d\n",
+               MB_DESC_BUFFERS,
+               MB_MAX_THREADS);
+        return 1;
+    }
+
+    if (CPA_STATUS_SUCCESS != qaeMemInit())
+    {
+        printf("Failed to initialise USDM\n");
+        return 1;
+    }
+    if (CPA_STATUS_SUCCESS != mbServiceInit())
+    {
+        printf("Failed to set up the compression instance and pool\n");
+        qaeMemDestroy();
+        return 1;
+    }
+
+    printf("%llu operations per thread, %u byte buffers\n",
+           (unsigned long long)iterations,
+           gSize);
+    printf("%-12s %7s %10s %10s %8s\n",
+           "benchmark",
+           "threads",
+           "ns/op",
+           "Kops/s",
+           "scaling");
+    for (b = 0; b < MB_NUM_BENCHES; b++)
+    {
+        if ((NULL != pOnly) && strcmp(pOnly, gBenches[b].name))
+        {
+            continue;
+        }
+        ran++;
+        for (numThreads = 1; numThreads <= maxThreads;
+             numThreads = mbNextThreads(numThreads, maxThreads))
+        {
+            if (CPA_STATUS_SUCCESS !=
+                mbRun(&gBenches[b], numThreads, iterations, &nsPerOp, &kops))
+            {
+                printf("%-12s %7u %10s\n", gBenches[b].name, numThreads, "n/a");
+                failed++;
+                break;
+            }
+            if (1 == numThreads)
+            {
+                baseKops = kops;
+            }
+            printf("%-12s %7u %10.1f %10.1f %8.2f\n",
+                   gBenches[b].name,
+                   numThreads,
+                   nsPerOp,
+                   kops,
+                   kops / baseKops);
+        }
+    }
+
+    Lac_MemPoolDestroy(gPool);
+    Lac_MemPoolsExit();
+    qaeMemDestroy();
+
+    if (0 == ran)
+    {
+        printf("Unknown benchmark %s\n", pOnly);
+        return 1;
+    }
+    printf("%s\n", failed ? "FAIL" : "PASS");
+    return failed ? 1 : 0;
+}
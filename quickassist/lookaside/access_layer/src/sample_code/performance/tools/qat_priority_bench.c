@@ -0,0 +1,601 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_priority_bench.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Measure the latency of small compression requests submitted behind
+ *      a backlog of large ones, without and with a high priority ring pair
+ *      (icp_sal_priority.h).
+ *
+ *      One instance is kept busy with depth large requests in flight.
+ *      Small requests are submitted one at a time on the same instance
+ *      and the time to their completion is recorded. The run is done
+ *      first with both sessions at normal priority, then with the ring
+ *      pair of a second instance paired as the high priority one and the
+ *      small session set to high priority. The p50 and p99 latencies of
+ *      the small requests and the throughput of the large ones are
+ *      printed for both runs. The second run checks that the small
+ *      requests were completed by the second instance.
+ *
+ *      Usage: qat_priority_bench [-b bulk_kib] [-d depth] [-n requests]
+ *                                [-s small_bytes] [-q share] [file]
+ *          -b  size of the large requests in KiB (default 64)
+ *          -d  large requests in flight (default 32)
+ *          -n  small requests per run (default 2000)
+ *          -s  size of the small requests in bytes (default 1024)
+ *          -q  percentage of a poll quota kept for the normal
+ *              priority ring (default ICP_SAL_PRIORITY_DEFAULT_NORMAL_SHARE)
+ *
+ *      Without a file the calgary corpus is used.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_poll.h"
+#include "icp_sal_priority.h"
+#include "qae_mem.h"
+#include "qat_bench_common.h"
+
+#define PRIORITY_DEFAULT_BULK_KIB (64)
+#define PRIORITY_DEFAULT_DEPTH (32)
+#define PRIORITY_DEFAULT_REQUESTS (2000)
+#define PRIORITY_DEFAULT_SMALL (1024)
+#define PRIORITY_MAX_DEPTH (256)
+#define PRIORITY_TIMEOUT_NS (10ULL * 1000 * 1000 * 1000)
+
+typedef struct priority_req_s
+{
+    CpaFlatBuffer srcFlat;
+    CpaFlatBuffer dstFlat;
+    CpaBufferList src;
+    CpaBufferList dst;
+    CpaDcRqResults results;
+    volatile CpaBoolean inflight;
+    CpaBoolean isBulk;
+} priority_req_t;
+
+typedef struct priority_bench_s
+{
+    CpaInstanceHandle instances[2];
+    CpaInstanceHandle instance;
+    CpaInstanceHandle highInstance;
+    CpaDcSessionHandle bulkSession;
+    CpaDcSessionHandle smallSession;
+    Cpa8U *pData;
+    Cpa32U dataLen;
+    Cpa32U metaSize;
+    Cpa32U depth;
+    priority_req_t bulk[PRIORITY_MAX_DEPTH];
+    priority_req_t small;
+    Cpa64U *pLatencies;
+    Cpa64U bulkBytes;
+    volatile Cpa32U numErrors;
+} priority_bench_t;
+
+static priority_bench_t *gBench = NULL;
+
+static void priorityCallback(void *pCallbackTag, CpaStatus status)
+{
+    priority_req_t *pReq = pCallbackTag;
+
+    if (CPA_STATUS_SUCCESS != status || CPA_DC_OK != pReq->results.status ||
+        pReq->results.consumed != pReq->srcFlat.dataLenInBytes)
+        gBench->numErrors++;
+    else if (pReq->isBulk)
+        gBench->bulkBytes += pReq->results.consumed;
+    pReq->inflight = CPA_FALSE;
+}
+
+static int latencyCompare(const void *pA, const void *pB)
+{
+    Cpa64U a = *(const Cpa64U *)pA;
+    Cpa64U b = *(const Cpa64U *)pB;
+
+    return (a > b) - (a < b);
+}
+
+/* Allocate a request compressing len bytes of the file from offset */
+static CpaStatus reqPrepare(priority_bench_t *pBench,
+                            priority_req_t *pReq,
+                            Cpa32U offset,
+                            Cpa32U len,
+                            CpaBoolean isBulk)
+{
+    Cpa32U bound = 0;
+    Cpa32U copied;
+    Cpa32U chunk;
+    CpaStatus status;
+
+    status = cpaDcDeflateCompressBound(
+        pBench->instance, CPA_DC_HT_STATIC, len, &bound);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    pReq->isBulk = isBulk;
+    pReq->srcFlat.dataLenInBytes = len;
+    pReq->srcFlat.pData = qaeMemAllocNUMA(len, 0, 64);
+    pReq->dstFlat.dataLenInBytes = bound;
+    pReq->dstFlat.pData = qaeMemAllocNUMA(bound, 0, 64);
+    pReq->src.numBuffers = 1;
+    pReq->src.pBuffers = &pReq->srcFlat;
+    pReq->src.pPrivateMetaData = qaeMemAllocNUMA(pBench->metaSize, 0, 64);
+    pReq->dst.numBuffers = 1;
+    pReq->dst.pBuffers = &pReq->dstFlat;
+    pReq->dst.pPrivateMetaData = qaeMemAllocNUMA(pBench->metaSize, 0, 64);
+    if (NULL == pReq->srcFlat.pData || NULL == pReq->dstFlat.pData ||
+        NULL == pReq->src.pPrivateMetaData ||
+        NULL == pReq->dst.pPrivateMetaData)
+        return CPA_STATUS_RESOURCE;
+
+    /* Files shorter than the request are repeated */
+    for (copied = 0; copied < len; copied += chunk)
+    {
+        offset %= pBench->dataLen;
+        chunk = (len - copied < pBench->dataLen - offset)
+                    ? len - copied
+                    : pBench->dataLen - offset;
+        memcpy(pReq->srcFlat.pData + copied, pBench->pData + offset, chunk);
+        offset += chunk;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static void reqFree(priority_req_t *pReq)
+{
+    if (NULL != pReq->srcFlat.pData)
+        qaeMemFreeNUMA((void **)&pReq->srcFlat.pData);
+    if (NULL != pReq->dstFlat.pData)
+        qaeMemFreeNUMA((void **)&pReq->dstFlat.pData);
+    if (NULL != pReq->src.pPrivateMetaData)
+        qaeMemFreeNUMA(&pReq->src.pPrivateMetaData);
+    if (NULL != pReq->dst.pPrivateMetaData)
+        qaeMemFreeNUMA(&pReq->dst.pPrivateMetaData);
+}
+
+static CpaStatus reqSubmit(priority_bench_t *pBench,
+                           CpaDcSessionHandle session,
+                           priority_req_t *pReq)
+{
+    CpaDcOpData opData;
+    CpaStatus status;
+
+    memset(&opData, 0, sizeof(opData));
+    opData.flushFlag = CPA_DC_FLUSH_FINAL;
+    opData.compressAndVerify = CPA_TRUE;
+    pReq->inflight = CPA_TRUE;
+    status = cpaDcCompressData2(pBench->instance,
+                                session,
+                                &pReq->src,
+                                &pReq->dst,
+                                &opData,
+                                &pReq->results,
+                                pReq);
+    if (CPA_STATUS_SUCCESS != status)
+        pReq->inflight = CPA_FALSE;
+
+    return status;
+}
+
+/* Resubmit the large requests that completed, the ring may be full */
+static CpaStatus bulkRefill(priority_bench_t *pBench)
+{
+    CpaStatus status;
+    Cpa32U i;
+
+    for (i = 0; i < pBench->depth; i++)
+    {
+        if (pBench->bulk[i].inflight)
+            continue;
+        status = reqSubmit(pBench, pBench->bulkSession, &pBench->bulk[i]);
+        if (CPA_STATUS_RETRY == status)
+            break;
+        if (CPA_STATUS_SUCCESS != status)
+            return status;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus benchDrain(priority_bench_t *pBench)
+{
+    Cpa64U start = qatBenchTimeNs();
+    Cpa32U i;
+
+    for (i = 0; i < pBench->depth; i++)
+    {
+        while (pBench->bulk[i].inflight)
+        {
+            icp_sal_DcPollInstance(pBench->instance, 0);
+            if (qatBenchTimeNs() - start > PRIORITY_TIMEOUT_NS)
+                return CPA_STATUS_FAIL;
+        }
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/*
+ * Submit numRequests small requests one at a time behind the backlog and
+ * record their latencies. Polling the instance polls the high priority
+ * ring pair first when one is paired with it.
+ */
+static CpaStatus benchRun(priority_bench_t *pBench,
+                          const char *pLabel,
+                          Cpa32U numRequests)
+{
+    Cpa64U runStart;
+    Cpa64U elapsed;
+    Cpa64U start;
+    Cpa32U i;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pBench->bulkBytes = 0;
+    pBench->numErrors = 0;
+    runStart = qatBenchTimeNs();
+    for (i = 0; i < numRequests && CPA_STATUS_SUCCESS == status; i++)
+    {
+        status = bulkRefill(pBench);
+        if (CPA_STATUS_SUCCESS != status)
+            break;
+
+        start = qatBenchTimeNs();
+        do
+        {
+            status = reqSubmit(pBench, pBench->smallSession, &pBench->small);
+            if (CPA_STATUS_RETRY == status)
+                icp_sal_DcPollInstance(pBench->instance, 0);
+        } while (CPA_STATUS_RETRY == status &&
+                 qatBenchTimeNs() - start < PRIORITY_TIMEOUT_NS);
+        if (CPA_STATUS_SUCCESS != status)
+            break;
+
+        while (pBench->small.inflight)
+        {
+            icp_sal_DcPollInstance(pBench->instance, 0);
+            if (qatBenchTimeNs() - start > PRIORITY_TIMEOUT_NS)
+            {
+                fprintf(stderr, "Timed out waiting for a small request\n");
+                status = CPA_STATUS_FAIL;
+                break;
+            }
+        }
+        pBench->pLatencies[i] = qatBenchTimeNs() - start;
+    }
+    elapsed = qatBenchTimeNs() - runStart;
+
+    if (CPA_STATUS_SUCCESS != benchDrain(pBench))
+    {
+        fprintf(stderr, "Timed out waiting for the large requests\n");
+        status = CPA_STATUS_FAIL;
+    }
+    if (CPA_STATUS_SUCCESS != status || pBench->numErrors)
+    {
+        fprintf(stderr,
+                "%s run failed (%d), %u request errors\n",
+                pLabel,
+                status,
+                pBench->numErrors);
+        printf("%-8s %10s %10s %10s %s\n", pLabel, "-", "-", "-", "FAILED");
+        return CPA_STATUS_FAIL;
+    }
+
+    qsort(pBench->pLatencies, numRequests, sizeof(Cpa64U), latencyCompare);
+    printf("%-8s %10.1f %10.1f %10.1f\n",
+           pLabel,
+           pBench->pLatencies[numRequests / 2] / 1000.0,
+           pBench->pLatencies[(numRequests * 99) / 100] / 1000.0,
+           (double)pBench->bulkBytes * 8 * 1000.0 / (elapsed ? elapsed : 1));
+
+    return CPA_STATUS_SUCCESS;
+}
+
+/* Completed compression requests of an instance */
+static Cpa64U benchCompleted(CpaInstanceHandle instance)
+{
+    CpaDcStats stats;
+
+    memset(&stats, 0, sizeof(stats));
+    if (CPA_STATUS_SUCCESS != cpaDcGetStats(instance, &stats))
+        return 0;
+
+    return stats.numCompCompleted;
+}
+
+static CpaStatus benchPairedRun(priority_bench_t *pBench,
+                                Cpa32U numRequests,
+                                Cpa32U share)
+{
+    Cpa64U before;
+    Cpa64U taken;
+    CpaStatus status;
+
+    status = icp_sal_PriorityPairSet(
+        pBench->instance, pBench->highInstance, share);
+    if (CPA_STATUS_SUCCESS == status)
+        status = icp_sal_DcSessionSetPriority(
+            pBench->instance, pBench->smallSession, ICP_SAL_PRIORITY_HIGH);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr, "Failed to set the high priority pair (%d)\n", status);
+        icp_sal_PriorityPairClear(pBench->instance);
+        return status;
+    }
+
+    before = benchCompleted(pBench->highInstance);
+    status = benchRun(pBench, "Paired", numRequests);
+    taken = benchCompleted(pBench->highInstance) - before;
+    if (CPA_STATUS_SUCCESS == status && taken != numRequests)
+    {
+        fprintf(stderr,
+                "The high priority instance completed %llu requests, "
+                "%u expected\n",
+                (unsigned long long)taken,
+                numRequests);
+        status = CPA_STATUS_FAIL;
+    }
+
+    icp_sal_DcSessionSetPriority(
+        pBench->instance, pBench->smallSession, ICP_SAL_PRIORITY_NORMAL);
+    icp_sal_PriorityPairClear(pBench->instance);
+
+    return status;
+}
+
+static CpaStatus benchSession(priority_bench_t *pBench,
+                              CpaDcSessionHandle *pSession)
+{
+    CpaDcSessionSetupData setup;
+    Cpa32U sessionSize = 0;
+    Cpa32U contextSize = 0;
+    CpaStatus status;
+
+    memset(&setup, 0, sizeof(setup));
+    setup.compLevel = CPA_DC_L1;
+    setup.compType = CPA_DC_DEFLATE;
+    setup.huffType = CPA_DC_HT_STATIC;
+    setup.autoSelectBestHuffmanTree = CPA_DC_ASB_DISABLED;
+    setup.sessDirection = CPA_DC_DIR_COMPRESS;
+    setup.sessState = CPA_DC_STATELESS;
+    setup.checksum = CPA_DC_CRC32;
+    status = cpaDcGetSessionSize(
+        pBench->instance, &setup, &sessionSize, &contextSize);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        *pSession = qaeMemAllocNUMA(sessionSize, 0, 64);
+        if (NULL == *pSession)
+            status = CPA_STATUS_RESOURCE;
+    }
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcInitSession(
+            pBench->instance, *pSession, &setup, NULL, priorityCallback);
+    if (CPA_STATUS_SUCCESS != status)
+        fprintf(stderr, "Failed to set up a session (%d)\n", status);
+
+    return status;
+}
+
+static void benchStop(priority_bench_t *pBench)
+{
+    Cpa32U i;
+
+    for (i = 0; i < pBench->depth; i++)
+        reqFree(&pBench->bulk[i]);
+    reqFree(&pBench->small);
+    if (NULL != pBench->bulkSession)
+    {
+        cpaDcRemoveSession(pBench->instance, pBench->bulkSession);
+        qaeMemFreeNUMA((void **)&pBench->bulkSession);
+    }
+    if (NULL != pBench->smallSession)
+    {
+        cpaDcRemoveSession(pBench->instance, pBench->smallSession);
+        qaeMemFreeNUMA((void **)&pBench->smallSession);
+    }
+    qatBenchInstancesStop(QAT_BENCH_SERVICE_DC, 2, pBench->instances);
+}
+
+static CpaStatus benchPrepare(priority_bench_t *pBench,
+                              Cpa32U bulkSize,
+                              Cpa32U smallSize,
+                              Cpa32U numRequests)
+{
+    CpaStatus status;
+    Cpa32U i;
+
+    pBench->pLatencies = calloc(numRequests, sizeof(Cpa64U));
+    if (NULL == pBench->pLatencies)
+        return CPA_STATUS_RESOURCE;
+
+    status = cpaDcBufferListGetMetaSize(pBench->instance, 1, &pBench->metaSize);
+    if (CPA_STATUS_SUCCESS == status)
+        status = benchSession(pBench, &pBench->bulkSession);
+    if (CPA_STATUS_SUCCESS == status)
+        status = benchSession(pBench, &pBench->smallSession);
+    for (i = 0; i < pBench->depth && CPA_STATUS_SUCCESS == status; i++)
+        status = reqPrepare(
+            pBench, &pBench->bulk[i], i * bulkSize, bulkSize, CPA_TRUE);
+    if (CPA_STATUS_SUCCESS == status)
+        status = reqPrepare(pBench, &pBench->small, 0, smallSize, CPA_FALSE);
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    priority_bench_t bench;
+    const char *pFile = SAMPLE_CODE_CORPUS_PATH "calgary";
+    Cpa32U bulkKib = PRIORITY_DEFAULT_BULK_KIB;
+    Cpa32U smallSize = PRIORITY_DEFAULT_SMALL;
+    Cpa32U numRequests = PRIORITY_DEFAULT_REQUESTS;
+    Cpa32U share = 0;
+    Cpa32U numErrors = 0;
+    CpaStatus status;
+    int opt;
+
+    memset(&bench, 0, sizeof(bench));
+    bench.depth = PRIORITY_DEFAULT_DEPTH;
+    while ((opt = getopt(argc, argv, "b:d:n:s:q:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'b':
+                bulkKib = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                bench.depth = strtoul(optarg, NULL, 0);
+                break;
+            case 'n':
+                numRequests = strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                smallSize = strtoul(optarg, NULL, 0);
+                break;
+            case 'q':
+                share = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr,
+                        "Usage: %s [-b bulk_kib] [-d depth] [-n requests] "
+                        "[-s small_bytes] [-q share] [file]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (0 == bulkKib || 0 == smallSize || 0 == numRequests ||
+        bench.depth < 1 || bench.depth > PRIORITY_MAX_DEPTH || share >= 100)
+    {
+        fprintf(stderr,
+                "Sizes and requests must be non zero, depth between 1 and "
+                "%u, share below 100\n",
+                PRIORITY_MAX_DEPTH);
+        return EXIT_FAILURE;
+    }
+    if (optind < argc)
+        pFile = argv[optind];
+
+    bench.pData = qatBenchLoadFile(pFile, &bench.dataLen);
+    if (NULL == bench.pData)
+    {
+        fprintf(stderr, "Failed to load %s\n", pFile);
+        return EXIT_FAILURE;
+    }
+    if (CPA_STATUS_SUCCESS != qatBenchProcessStart())
+    {
+        free(bench.pData);
+        return EXIT_FAILURE;
+    }
+
+    gBench = &bench;
+    status = qatBenchInstancesStart(QAT_BENCH_SERVICE_DC, 2, bench.instances);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        bench.instance = bench.instances[0];
+        bench.highInstance = bench.instances[1];
+        status = benchPrepare(&bench, bulkKib * 1024, smallSize, numRequests);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            printf("%u KiB requests %u deep, %u requests of %u bytes\n",
+                   bulkKib,
+                   bench.depth,
+                   numRequests,
+                   smallSize);
+            printf("%-8s %10s %10s %10s\n",
+                   "Run",
+                   "p50 us",
+                   "p99 us",
+                   "Bulk Mbps");
+            if (CPA_STATUS_SUCCESS != benchRun(&bench, "Normal", numRequests))
+                numErrors++;
+            if (CPA_STATUS_SUCCESS !=
+                benchPairedRun(&bench, numRequests, share))
+                numErrors++;
+        }
+        else
+        {
+            fprintf(stderr, "Failed to prepare the requests (%d)\n", status);
+            numErrors++;
+        }
+        benchStop(&bench);
+    }
+    else
+    {
+        numErrors++;
+    }
+
+    qatBenchProcessStop();
+    free(bench.pLatencies);
+    free(bench.pData);
+
+    printf("%s\n", numErrors ? "FAIL" : "PASS");
+    return numErrors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
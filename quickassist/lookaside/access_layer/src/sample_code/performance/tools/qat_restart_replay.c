@@ -0,0 +1,530 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_restart_replay.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Exercise in-flight request replay (icp_sal_ReplayConfig()) across a
+ *      device restart driven by the heartbeat failure simulation.
+ *
+ *      The heartbeat failure is simulated on the device of the first
+ *      compression instance before num_requests stateless compression
+ *      requests are submitted, so that none of them is answered before
+ *      the device restarts. The instance and the device events are then
+ *      polled until every request has completed. The test passes when
+ *      each callback ran exactly once, the oldest min(window, requests)
+ *      requests completed successfully with the output of a reference
+ *      request made before the failure, the others failed, and the
+ *      instance serves new requests after the restart.
+ *
+ *      Usage: qat_restart_replay [-n num_requests] [-w window]
+ *          -n  requests in flight at the failure (default 64)
+ *          -w  replay window (default 32, 0 disables replay)
+ *
+ *      The library must be configured with --enable-hb-error-simulation.
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cpa.h"
+#include "cpa_dc.h"
+#include "icp_sal_poll.h"
+#include "icp_sal_replay.h"
+#include "icp_sal_user.h"
+#include "qae_mem.h"
+
+extern CpaStatus qaeMemInit(void);
+extern void qaeMemDestroy(void);
+
+#define REPLAY_DEFAULT_REQUESTS (64)
+#define REPLAY_DEFAULT_WINDOW (32)
+#define REPLAY_MAX_REQUESTS (256)
+#define REPLAY_SRC_SIZE (4096)
+/* Room for stored blocks when the input does not compress */
+#define REPLAY_DST_SIZE (2 * REPLAY_SRC_SIZE)
+#define REPLAY_TIMEOUT_US (10 * 1000 * 1000)
+#define REPLAY_POLL_US (100)
+/* Time left after the last completion for a duplicate to show up */
+#define REPLAY_SETTLE_US (200 * 1000)
+
+#ifdef ICP_HB_FAIL_SIM
+typedef struct replay_req_s
+{
+    CpaBufferList *pDst;
+    CpaDcRqResults results;
+    volatile Cpa32U numCallbacks;
+    volatile CpaStatus status;
+} replay_req_t;
+
+typedef struct replay_ctx_s
+{
+    CpaInstanceHandle instance;
+    CpaDcSessionHandle session;
+    CpaBufferList *pSrc;
+    Cpa32U metaSize;
+    replay_req_t reqs[REPLAY_MAX_REQUESTS + 1];
+    volatile Cpa32U numCompleted;
+} replay_ctx_t;
+
+static replay_ctx_t *gCtx = NULL;
+
+static void replayCallback(void *pCallbackTag, CpaStatus status)
+{
+    replay_req_t *pReq = pCallbackTag;
+
+    pReq->status = status;
+    __sync_fetch_and_add(&pReq->numCallbacks, 1);
+    __sync_fetch_and_add(&gCtx->numCompleted, 1);
+}
+
+static void bufferListFree(CpaBufferList **ppList)
+{
+    CpaBufferList *pList = *ppList;
+
+    if (NULL == pList)
+        return;
+    if (NULL != pList->pBuffers)
+        qaeMemFreeNUMA((void **)&pList->pBuffers->pData);
+    qaeMemFreeNUMA((void **)&pList->pPrivateMetaData);
+    free(pList);
+    *ppList = NULL;
+}
+
+static CpaBufferList *bufferListAlloc(Cpa32U metaSize, Cpa32U size)
+{
+    CpaBufferList *pList;
+
+    pList = calloc(1, sizeof(CpaBufferList) + sizeof(CpaFlatBuffer));
+    if (NULL == pList)
+        return NULL;
+
+    pList->numBuffers = 1;
+    pList->pBuffers = (CpaFlatBuffer *)(pList + 1);
+    pList->pBuffers->dataLenInBytes = size;
+    pList->pBuffers->pData = qaeMemAllocNUMA(size, 0, 64);
+    pList->pPrivateMetaData = qaeMemAllocNUMA(metaSize, 0, 64);
+    if (NULL == pList->pBuffers->pData || NULL == pList->pPrivateMetaData)
+        bufferListFree(&pList);
+
+    return pList;
+}
+
+static CpaStatus replaySubmit(replay_ctx_t *pCtx, Cpa32U index)
+{
+    replay_req_t *pReq = &pCtx->reqs[index];
+    CpaDcOpData opData;
+
+    memset(&opData, 0, sizeof(opData));
+    opData.flushFlag = CPA_DC_FLUSH_FINAL;
+    opData.compressAndVerify = CPA_TRUE;
+
+    return cpaDcCompressData2(pCtx->instance,
+                              pCtx->session,
+                              pCtx->pSrc,
+                              pReq->pDst,
+                              &opData,
+                              &pReq->results,
+                              pReq);
+}
+
+/* Poll the instance and the device events until target requests have
+ * completed, then a little longer to catch duplicate completions */
+static CpaStatus replayPollUntil(replay_ctx_t *pCtx, Cpa32U target)
+{
+    Cpa32U waited = 0;
+
+    while (pCtx->numCompleted < target)
+    {
+        if (waited >= REPLAY_TIMEOUT_US)
+            return CPA_STATUS_FAIL;
+        icp_sal_poll_device_events();
+        icp_sal_DcPollInstance(pCtx->instance, 0);
+        usleep(REPLAY_POLL_US);
+        waited += REPLAY_POLL_US;
+    }
+
+    for (waited = 0; waited < REPLAY_SETTLE_US; waited += REPLAY_POLL_US)
+    {
+        icp_sal_poll_device_events();
+        icp_sal_DcPollInstance(pCtx->instance, 0);
+        usleep(REPLAY_POLL_US);
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus replaySetup(replay_ctx_t *pCtx)
+{
+    CpaDcSessionSetupData sd;
+    CpaInstanceInfo2 info;
+    Cpa32U sessionSize = 0;
+    Cpa32U ctxSize = 0;
+    Cpa16U numInstances = 0;
+    Cpa32U i;
+    CpaStatus status;
+
+    status = cpaDcGetNumInstances(&numInstances);
+    if (CPA_STATUS_SUCCESS != status || 0 == numInstances)
+    {
+        fprintf(stderr, "No compression instance\n");
+        return CPA_STATUS_FAIL;
+    }
+    numInstances = 1;
+    status = cpaDcGetInstances(numInstances, &pCtx->instance);
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcInstanceGetInfo2(pCtx->instance, &info);
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcSetAddressTranslation(pCtx->instance,
+                                            qaeVirtToPhysNUMA);
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcStartInstance(pCtx->instance, 0, NULL);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr, "Failed to start the instance (%d)\n", status);
+        return status;
+    }
+    if (!info.isPolled)
+    {
+        fprintf(stderr, "The instance must be polled\n");
+        return CPA_STATUS_FAIL;
+    }
+
+    memset(&sd, 0, sizeof(sd));
+    sd.compLevel = CPA_DC_L1;
+    sd.compType = CPA_DC_DEFLATE;
+    sd.huffType = CPA_DC_HT_STATIC;
+    sd.autoSelectBestHuffmanTree = CPA_DC_ASB_DISABLED;
+    sd.sessDirection = CPA_DC_DIR_COMPRESS;
+    sd.sessState = CPA_DC_STATELESS;
+    sd.checksum = CPA_DC_CRC32;
+
+    status = cpaDcGetSessionSize(pCtx->instance, &sd, &sessionSize, &ctxSize);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        pCtx->session = qaeMemAllocNUMA(sessionSize, 0, 64);
+        if (NULL == pCtx->session)
+            status = CPA_STATUS_RESOURCE;
+    }
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcInitSession(
+            pCtx->instance, pCtx->session, &sd, NULL, replayCallback);
+    if (CPA_STATUS_SUCCESS == status)
+        status =
+            cpaDcBufferListGetMetaSize(pCtx->instance, 1, &pCtx->metaSize);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr, "Failed to set up the session (%d)\n", status);
+        return status;
+    }
+
+    pCtx->pSrc = bufferListAlloc(pCtx->metaSize, REPLAY_SRC_SIZE);
+    if (NULL == pCtx->pSrc)
+        return CPA_STATUS_RESOURCE;
+    /* Compressible but not trivial input */
+    for (i = 0; i < REPLAY_SRC_SIZE; i++)
+        pCtx->pSrc->pBuffers->pData[i] = (Cpa8U)((i * 7) ^ (i >> 5));
+
+    for (i = 0; i <= REPLAY_MAX_REQUESTS; i++)
+    {
+        pCtx->reqs[i].pDst = bufferListAlloc(pCtx->metaSize, REPLAY_DST_SIZE);
+        if (NULL == pCtx->reqs[i].pDst)
+            return CPA_STATUS_RESOURCE;
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static void replayTeardown(replay_ctx_t *pCtx)
+{
+    Cpa32U i;
+
+    if (NULL != pCtx->session)
+    {
+        cpaDcRemoveSession(pCtx->instance, pCtx->session);
+        qaeMemFreeNUMA((void **)&pCtx->session);
+    }
+    if (NULL != pCtx->instance)
+        cpaDcStopInstance(pCtx->instance);
+    for (i = 0; i <= REPLAY_MAX_REQUESTS; i++)
+        bufferListFree(&pCtx->reqs[i].pDst);
+    bufferListFree(&pCtx->pSrc);
+}
+
+/* Run one request and wait for it, the reference for the replayed ones */
+static CpaStatus replayRunOne(replay_ctx_t *pCtx, Cpa32U index)
+{
+    replay_req_t *pReq = &pCtx->reqs[index];
+    Cpa32U target = pCtx->numCompleted + 1;
+    CpaStatus status;
+
+    status = replaySubmit(pCtx, index);
+    if (CPA_STATUS_SUCCESS == status)
+        status = replayPollUntil(pCtx, target);
+    if (CPA_STATUS_SUCCESS == status)
+        status = pReq->status;
+    if (CPA_STATUS_SUCCESS == status && CPA_DC_OK != pReq->results.status)
+        status = CPA_STATUS_FAIL;
+
+    return status;
+}
+
+static CpaStatus replayRun(replay_ctx_t *pCtx,
+                           Cpa32U numRequests,
+                           Cpa32U window)
+{
+    replay_req_t *pRef = &pCtx->reqs[REPLAY_MAX_REQUESTS];
+    icp_sal_replay_stats_t stats;
+    CpaInstanceInfo2 info;
+    Cpa32U expectOk = (window < numRequests) ? window : numRequests;
+    Cpa32U numOk = 0;
+    Cpa32U numErrors = 0;
+    Cpa32U i;
+    CpaStatus status;
+
+    status = replayRunOne(pCtx, REPLAY_MAX_REQUESTS);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr, "Reference request failed (%d)\n", status);
+        return status;
+    }
+
+    status = icp_sal_ReplayConfig(pCtx->instance, window);
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaDcInstanceGetInfo2(pCtx->instance, &info);
+    if (CPA_STATUS_SUCCESS == status)
+        status = icp_sal_heartbeat_simulate_failure(info.physInstId.packageId);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr, "Failed to simulate the failure (%d)\n", status);
+        return status;
+    }
+
+    pCtx->numCompleted = 0;
+    for (i = 0; i < numRequests; i++)
+    {
+        status = replaySubmit(pCtx, i);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            fprintf(stderr, "Submission %u failed (%d)\n", i, status);
+            return status;
+        }
+    }
+
+    status = replayPollUntil(pCtx, numRequests);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr,
+                "Timed out with %u of %u requests completed\n",
+                pCtx->numCompleted,
+                numRequests);
+        return status;
+    }
+
+    for (i = 0; i < numRequests; i++)
+    {
+        replay_req_t *pReq = &pCtx->reqs[i];
+
+        if (1 != pReq->numCallbacks)
+        {
+            fprintf(stderr,
+                    "Request %u completed %u times\n",
+                    i,
+                    pReq->numCallbacks);
+            numErrors++;
+        }
+        else if (CPA_STATUS_SUCCESS != pReq->status)
+        {
+            continue;
+        }
+        else if (i >= expectOk)
+        {
+            fprintf(stderr, "Request %u beyond the window succeeded\n", i);
+            numErrors++;
+        }
+        else if (pReq->results.produced != pRef->results.produced ||
+                 memcmp(pReq->pDst->pBuffers->pData,
+                        pRef->pDst->pBuffers->pData,
+                        pRef->results.produced))
+        {
+            fprintf(stderr, "Request %u output differs\n", i);
+            numErrors++;
+        }
+        else
+        {
+            numOk++;
+        }
+    }
+    if (numOk != expectOk)
+    {
+        fprintf(stderr,
+                "%u requests succeeded, expected %u\n",
+                numOk,
+                expectOk);
+        numErrors++;
+    }
+
+    status = icp_sal_ReplayGetStats(pCtx->instance, &stats);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        printf("Window %u: held %llu, replayed %llu, failed %llu, "
+               "pending %u\n",
+               stats.replayWindow,
+               (unsigned long long)stats.numHeld,
+               (unsigned long long)stats.numReplayed,
+               (unsigned long long)stats.numFailed,
+               stats.numPending);
+    }
+
+    status = replayRunOne(pCtx, REPLAY_MAX_REQUESTS);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr, "Request after the restart failed (%d)\n", status);
+        numErrors++;
+    }
+
+    printf("%u requests in flight: %u replayed, %u failed, %u errors\n",
+           numRequests,
+           numOk,
+           numRequests - numOk,
+           numErrors);
+
+    return numErrors ? CPA_STATUS_FAIL : CPA_STATUS_SUCCESS;
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+    Cpa32U numRequests = REPLAY_DEFAULT_REQUESTS;
+    Cpa32U window = REPLAY_DEFAULT_WINDOW;
+    CpaStatus status;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:w:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                numRequests = strtoul(optarg, NULL, 0);
+                break;
+            case 'w':
+                window = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                fprintf(stderr,
+                        "Usage: %s [-n num_requests] [-w window]\n",
+                        argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (0 == numRequests || numRequests > REPLAY_MAX_REQUESTS)
+    {
+        fprintf(stderr,
+                "num_requests must be between 1 and %u\n",
+                REPLAY_MAX_REQUESTS);
+        return EXIT_FAILURE;
+    }
+
+#ifndef ICP_HB_FAIL_SIM
+    fprintf(stderr,
+            "Heartbeat failure simulation is not built in, configure "
+            "with --enable-hb-error-simulation\n");
+    return EXIT_FAILURE;
+#else
+    gCtx = calloc(1, sizeof(*gCtx));
+    if (NULL == gCtx)
+        return EXIT_FAILURE;
+
+    if (CPA_STATUS_SUCCESS != qaeMemInit())
+    {
+        fprintf(stderr, "Failed to initialise the memory driver\n");
+        free(gCtx);
+        return EXIT_FAILURE;
+    }
+    status = icp_sal_userStartMultiProcess("SSL", CPA_FALSE);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        fprintf(stderr, "Failed to start user process SSL\n");
+        qaeMemDestroy();
+        free(gCtx);
+        return EXIT_FAILURE;
+    }
+
+    status = replaySetup(gCtx);
+    if (CPA_STATUS_SUCCESS == status)
+        status = replayRun(gCtx, numRequests, window);
+    replayTeardown(gCtx);
+
+    icp_sal_userStop();
+    qaeMemDestroy();
+    free(gCtx);
+
+    printf("%s\n", (CPA_STATUS_SUCCESS == status) ? "PASS" : "FAIL");
+    return (CPA_STATUS_SUCCESS == status) ? EXIT_SUCCESS : EXIT_FAILURE;
+#endif
+}
@@ -0,0 +1,653 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_sym_partial_bench.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Measure many concurrent partial packet streams, one per session.
+ *
+ *      Each stream hashes (or encrypts) a message of partials partial
+ *      packets of size bytes, loops times. Threads share the streams and
+ *      the polling of one instance, so the responses of a stream are
+ *      processed by whichever thread polls, which then sends the next
+ *      partial queued on the session. The streams are run first with one
+ *      partial in flight, the application waiting for each to complete,
+ *      then with depth partials submitted ahead and queued by the library.
+ *      Throughput and completed messages per second are printed, and the
+ *      results of the last loop are checked with OpenSSL.
+ *
+ *      Queued partials are sent from the response callback, which cannot
+ *      wait for ring space, so streams should stay below the number of
+ *      concurrent requests of the instance.
+ *
+ *      Usage: qat_sym_partial_bench [-a sha256|aes-cbc] [-s streams]
+ *                                   [-p partials] [-b size] [-d depth]
+ *                                   [-l loops] [-t threads]
+ *          -a  SHA-256 hash (default) or AES-256-CBC cipher streams
+ *          -s  number of streams and sessions (default 128)
+ *          -p  partial packets per message (default 8)
+ *          -b  bytes per partial packet, a multiple of 64 (default 1024)
+ *          -d  partials in flight per stream of the second run (default
+ *              partials)
+ *          -l  messages per stream (default 10)
+ *          -t  submitting and polling threads (default 4)
+ *
+ *****************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <openssl/evp.h>
+#include <openssl/sha.h>
+
+#include "cpa.h"
+#include "cpa_cy_im.h"
+#include "cpa_cy_sym.h"
+#include "icp_sal_poll.h"
+#include "qae_mem.h"
+#include "qat_bench_common.h"
+
+#define PARTIAL_DEFAULT_STREAMS (128)
+#define PARTIAL_DEFAULT_PARTIALS (8)
+#define PARTIAL_DEFAULT_SIZE (1024)
+#define PARTIAL_DEFAULT_LOOPS (10)
+#define PARTIAL_DEFAULT_THREADS (4)
+#define PARTIAL_MAX_THREADS (64)
+#define PARTIAL_BLOCK_SIZE (64)
+#define PARTIAL_KEY_SIZE (32)
+#define PARTIAL_IV_SIZE (16)
+#define PARTIAL_TIMEOUT_NS (60ULL * 1000 * 1000 * 1000)
+
+typedef struct partial_req_s
+{
+    CpaBufferList src;
+    CpaBufferList dst;
+    CpaFlatBuffer srcFlat;
+    CpaFlatBuffer dstFlat;
+    CpaCySymOpData opData;
+    /* Written back with the chaining IV, so it must be DMA-able */
+    Cpa8U *pIv;
+} partial_req_t;
+
+typedef struct partial_stream_s
+{
+    CpaCySymSessionCtx sessionCtx;
+    partial_req_t *pReqs;
+    Cpa32U numPartials;
+    /* The message, copied to DMA-able memory partial by partial */
+    Cpa8U *pData;
+    Cpa8U *pDigest;
+    Cpa32U next;
+    Cpa32U total;
+    volatile Cpa32U done;
+    volatile Cpa32U errors;
+} partial_stream_t;
+
+typedef struct partial_bench_s
+{
+    CpaInstanceHandle instance;
+    CpaBoolean isCipher;
+    Cpa32U numStreams;
+    Cpa32U numPartials;
+    Cpa32U partialSize;
+    Cpa32U loops;
+    Cpa32U numThreads;
+    Cpa32U depth;
+    Cpa8U key[PARTIAL_KEY_SIZE];
+    Cpa8U iv[PARTIAL_IV_SIZE];
+    partial_stream_t *pStreams;
+} partial_bench_t;
+
+typedef struct partial_thread_s
+{
+    partial_bench_t *pBench;
+    Cpa32U first;
+    CpaStatus status;
+    pthread_t thread;
+} partial_thread_t;
+
+static void partialCallback(void *pCallbackTag,
+                            CpaStatus status,
+                            const CpaCySymOp operationType,
+                            void *pOpData,
+                            CpaBufferList *pDstBuffer,
+                            CpaBoolean verifyResult)
+{
+    partial_stream_t *pStream = pCallbackTag;
+    partial_req_t *pReq =
+        &pStream->pReqs[pStream->done % pStream->numPartials];
+
+    (void)operationType;
+    (void)pDstBuffer;
+    (void)verifyResult;
+    /* Partials of a stream must complete in submission order */
+    if (CPA_STATUS_SUCCESS != status || pOpData != &pReq->opData)
+        pStream->errors++;
+    pStream->done++;
+}
+
+/* Submit the next partial of the stream, returns CPA_STATUS_RETRY when the
+ * ring is full */
+static CpaStatus partialSubmit(partial_bench_t *pBench,
+                               partial_stream_t *pStream)
+{
+    Cpa32U index = pStream->next % pBench->numPartials;
+    partial_req_t *pReq = &pStream->pReqs[index];
+    CpaStatus status;
+
+    /* The IV of a partial is written back on completion, restore the IV
+     * of the message before its first partial */
+    if (0 == index)
+        memcpy(pReq->pIv, pBench->iv, PARTIAL_IV_SIZE);
+    status = cpaCySymPerformOp(pBench->instance,
+                               pStream,
+                               &pReq->opData,
+                               &pReq->src,
+                               pBench->isCipher ? &pReq->dst : &pReq->src,
+                               NULL);
+    if (CPA_STATUS_SUCCESS == status)
+        pStream->next++;
+
+    return status;
+}
+
+static void *partialThread(void *pArg)
+{
+    partial_thread_t *pThread = pArg;
+    partial_bench_t *pBench = pThread->pBench;
+    partial_stream_t *pStream;
+    Cpa64U start = qatBenchTimeNs();
+    Cpa32U remaining;
+    Cpa32U i;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    do
+    {
+        remaining = 0;
+        for (i = pThread->first; i < pBench->numStreams;
+             i += pBench->numThreads)
+        {
+            pStream = &pBench->pStreams[i];
+            while (pStream->next < pStream->total &&
+                   pStream->next - pStream->done < pBench->depth)
+            {
+                status = partialSubmit(pBench, pStream);
+                if (CPA_STATUS_SUCCESS != status)
+                    break;
+            }
+            if (CPA_STATUS_RETRY == status)
+                status = CPA_STATUS_SUCCESS;
+            if (CPA_STATUS_SUCCESS != status)
+                break;
+            if (pStream->done < pStream->total)
+                remaining++;
+        }
+        /* Any thread may process the responses of any stream */
+        icp_sal_CyPollInstance(pBench->instance, 0);
+        if (CPA_STATUS_SUCCESS == status &&
+            qatBenchTimeNs() - start > PARTIAL_TIMEOUT_NS)
+        {
+            fprintf(stderr, "Timed out waiting for partials\n");
+            status = CPA_STATUS_FAIL;
+        }
+    } while (remaining && CPA_STATUS_SUCCESS == status);
+
+    pThread->status = status;
+    return NULL;
+}
+
+/* Check the results of the last message of every stream */
+static CpaStatus partialVerify(partial_bench_t *pBench)
+{
+    Cpa32U messageSize = pBench->numPartials * pBench->partialSize;
+    Cpa8U digest[SHA256_DIGEST_LENGTH];
+    Cpa8U *pOut;
+    partial_stream_t *pStream;
+    EVP_CIPHER_CTX *pCtx;
+    Cpa32U i;
+    Cpa32U j;
+    int len = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pOut = malloc(messageSize);
+    pCtx = EVP_CIPHER_CTX_new();
+    if (NULL == pOut || NULL == pCtx)
+    {
+        free(pOut);
+        EVP_CIPHER_CTX_free(pCtx);
+        return CPA_STATUS_RESOURCE;
+    }
+    for (i = 0; i < pBench->numStreams && CPA_STATUS_SUCCESS == status; i++)
+    {
+        pStream = &pBench->pStreams[i];
+        if (!pBench->isCipher)
+        {
+            SHA256(pStream->pData, messageSize, digest);
+            if (memcmp(digest, pStream->pDigest, sizeof(digest)))
+                status = CPA_STATUS_FAIL;
+            continue;
+        }
+        if (1 != EVP_EncryptInit_ex(
+                     pCtx, EVP_aes_256_cbc(), NULL, pBench->key, pBench->iv) ||
+            1 != EVP_CIPHER_CTX_set_padding(pCtx, 0) ||
+            1 != EVP_EncryptUpdate(
+                     pCtx, pOut, &len, pStream->pData, messageSize))
+        {
+            status = CPA_STATUS_FAIL;
+            break;
+        }
+        for (j = 0; j < pBench->numPartials; j++)
+        {
+            if (memcmp(pOut + j * pBench->partialSize,
+                       pStream->pReqs[j].dstFlat.pData,
+                       pBench->partialSize))
+                status = CPA_STATUS_FAIL;
+        }
+    }
+    EVP_CIPHER_CTX_free(pCtx);
+    free(pOut);
+
+    return status;
+}
+
+static CpaStatus partialRun(partial_bench_t *pBench, Cpa32U depth)
+{
+    partial_thread_t threads[PARTIAL_MAX_THREADS];
+    partial_stream_t *pStream;
+    Cpa64U messages = (Cpa64U)pBench->numStreams * pBench->loops;
+    Cpa64U start;
+    Cpa64U elapsed;
+    Cpa32U errors = 0;
+    Cpa32U i;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    pBench->depth = depth;
+    for (i = 0; i < pBench->numStreams; i++)
+    {
+        pStream = &pBench->pStreams[i];
+        pStream->next = 0;
+        pStream->done = 0;
+        pStream->errors = 0;
+        pStream->total = pBench->numPartials * pBench->loops;
+    }
+
+    start = qatBenchTimeNs();
+    for (i = 0; i < pBench->numThreads; i++)
+    {
+        threads[i].pBench = pBench;
+        threads[i].first = i;
+        threads[i].status = CPA_STATUS_FAIL;
+        if (pthread_create(&threads[i].thread, NULL, partialThread,
+                           &threads[i]))
+            break;
+    }
+    while (i-- > 0)
+    {
+        pthread_join(threads[i].thread, NULL);
+        if (CPA_STATUS_SUCCESS != threads[i].status)
+            status = threads[i].status;
+    }
+    elapsed = qatBenchTimeNs() - start;
+
+    /* Responses still in flight after a failure are drained here */
+    start = qatBenchTimeNs();
+    for (i = 0; i < pBench->numStreams; i++)
+    {
+        pStream = &pBench->pStreams[i];
+        while (pStream->done < pStream->next &&
+               qatBenchTimeNs() - start < PARTIAL_TIMEOUT_NS)
+            icp_sal_CyPollInstance(pBench->instance, 0);
+        errors += pStream->errors;
+    }
+    if (CPA_STATUS_SUCCESS == status && errors)
+        status = CPA_STATUS_FAIL;
+    if (CPA_STATUS_SUCCESS == status)
+        status = partialVerify(pBench);
+
+    if (CPA_STATUS_SUCCESS == status)
+        printf("%6u %10.1f %12.0f %s\n",
+               depth,
+               (double)messages * pBench->numPartials * pBench->partialSize *
+                   8 * 1000.0 / (elapsed ? elapsed : 1),
+               (double)messages * 1000000000.0 / (elapsed ? elapsed : 1),
+               "verified");
+    else
+        printf("%6u %10s %12s FAILED (%d, %u errors)\n",
+               depth,
+               "-",
+               "-",
+               status,
+               errors);
+
+    return status;
+}
+
+static void benchFree(partial_bench_t *pBench)
+{
+    partial_stream_t *pStream;
+    partial_req_t *pReq;
+    Cpa32U i;
+    Cpa32U j;
+
+    for (i = 0; NULL != pBench->pStreams && i < pBench->numStreams; i++)
+    {
+        pStream = &pBench->pStreams[i];
+        for (j = 0; NULL != pStream->pReqs && j < pBench->numPartials; j++)
+        {
+            pReq = &pStream->pReqs[j];
+            if (NULL != pReq->srcFlat.pData)
+                qaeMemFreeNUMA((void **)&pReq->srcFlat.pData);
+            if (NULL != pReq->dstFlat.pData)
+                qaeMemFreeNUMA((void **)&pReq->dstFlat.pData);
+            if (NULL != pReq->src.pPrivateMetaData)
+                qaeMemFreeNUMA(&pReq->src.pPrivateMetaData);
+            if (NULL != pReq->dst.pPrivateMetaData)
+                qaeMemFreeNUMA(&pReq->dst.pPrivateMetaData);
+            if (NULL != pReq->pIv)
+                qaeMemFreeNUMA((void **)&pReq->pIv);
+        }
+        if (NULL != pStream->sessionCtx)
+        {
+            cpaCySymRemoveSession(pBench->instance, pStream->sessionCtx);
+            qaeMemFreeNUMA((void **)&pStream->sessionCtx);
+        }
+        if (NULL != pStream->pDigest)
+            qaeMemFreeNUMA((void **)&pStream->pDigest);
+        free(pStream->pReqs);
+        free(pStream->pData);
+    }
+    free(pBench->pStreams);
+    pBench->pStreams = NULL;
+}
+
+static CpaStatus benchInitList(partial_bench_t *pBench,
+                               CpaBufferList *pList,
+                               CpaFlatBuffer *pFlat,
+                               Cpa32U metaSize)
+{
+    pList->numBuffers = 1;
+    pList->pBuffers = pFlat;
+    pList->pPrivateMetaData = qaeMemAllocNUMA(metaSize, 0, 64);
+    pFlat->dataLenInBytes = pBench->partialSize;
+    pFlat->pData = qaeMemAllocNUMA(pBench->partialSize, 0, 64);
+    if (NULL == pList->pPrivateMetaData || NULL == pFlat->pData)
+        return CPA_STATUS_RESOURCE;
+
+    return CPA_STATUS_SUCCESS;
+}
+
+static CpaStatus benchPrepare(partial_bench_t *pBench)
+{
+    CpaCySymSessionSetupData setup;
+    partial_stream_t *pStream;
+    partial_req_t *pReq;
+    Cpa32U messageSize = pBench->numPartials * pBench->partialSize;
+    Cpa32U sessionSize = 0;
+    Cpa32U metaSize = 0;
+    Cpa32U i;
+    Cpa32U j;
+    CpaStatus status;
+
+    memset(&setup, 0, sizeof(setup));
+    setup.sessionPriority = CPA_CY_PRIORITY_NORMAL;
+    if (pBench->isCipher)
+    {
+        setup.symOperation = CPA_CY_SYM_OP_CIPHER;
+        setup.cipherSetupData.cipherAlgorithm = CPA_CY_SYM_CIPHER_AES_CBC;
+        setup.cipherSetupData.pCipherKey = pBench->key;
+        setup.cipherSetupData.cipherKeyLenInBytes = PARTIAL_KEY_SIZE;
+        setup.cipherSetupData.cipherDirection =
+            CPA_CY_SYM_CIPHER_DIRECTION_ENCRYPT;
+    }
+    else
+    {
+        setup.symOperation = CPA_CY_SYM_OP_HASH;
+        setup.hashSetupData.hashAlgorithm = CPA_CY_SYM_HASH_SHA256;
+        setup.hashSetupData.hashMode = CPA_CY_SYM_HASH_MODE_PLAIN;
+        setup.hashSetupData.digestResultLenInBytes = SHA256_DIGEST_LENGTH;
+    }
+
+    status = cpaCySymSessionCtxGetSize(pBench->instance, &setup, &sessionSize);
+    if (CPA_STATUS_SUCCESS == status)
+        status = cpaCyBufferListGetMetaSize(pBench->instance, 1, &metaSize);
+    if (CPA_STATUS_SUCCESS != status)
+        return status;
+
+    pBench->pStreams = calloc(pBench->numStreams, sizeof(partial_stream_t));
+    if (NULL == pBench->pStreams)
+        return CPA_STATUS_RESOURCE;
+
+    for (i = 0; i < pBench->numStreams; i++)
+    {
+        pStream = &pBench->pStreams[i];
+        pStream->numPartials = pBench->numPartials;
+        pStream->pReqs = calloc(pBench->numPartials, sizeof(partial_req_t));
+        pStream->pData = malloc(messageSize);
+        pStream->pDigest = qaeMemAllocNUMA(SHA256_DIGEST_LENGTH, 0, 64);
+        pStream->sessionCtx = qaeMemAllocNUMA(sessionSize, 0, 64);
+        if (NULL == pStream->pReqs || NULL == pStream->pData ||
+            NULL == pStream->pDigest || NULL == pStream->sessionCtx)
+            return CPA_STATUS_RESOURCE;
+        status = cpaCySymInitSession(
+            pBench->instance, partialCallback, &setup, pStream->sessionCtx);
+        if (CPA_STATUS_SUCCESS != status)
+        {
+            qaeMemFreeNUMA((void **)&pStream->sessionCtx);
+            fprintf(stderr, "Failed to create session %u (%d)\n", i, status);
+            return status;
+        }
+        for (j = 0; j < messageSize; j++)
+            pStream->pData[j] = (Cpa8U)rand();
+
+        for (j = 0; j < pBench->numPartials; j++)
+        {
+            pReq = &pStream->pReqs[j];
+            status =
+                benchInitList(pBench, &pReq->src, &pReq->srcFlat, metaSize);
+            if (CPA_STATUS_SUCCESS == status && pBench->isCipher)
+                status =
+                    benchInitList(pBench, &pReq->dst, &pReq->dstFlat, metaSize);
+            if (CPA_STATUS_SUCCESS != status)
+                return status;
+            memcpy(pReq->srcFlat.pData,
+                   pStream->pData + j * pBench->partialSize,
+                   pBench->partialSize);
+
+            pReq->opData.sessionCtx = pStream->sessionCtx;
+            pReq->opData.packetType = (j == pBench->numPartials - 1)
+                                          ? CPA_CY_SYM_PACKET_TYPE_LAST_PARTIAL
+                                          : CPA_CY_SYM_PACKET_TYPE_PARTIAL;
+            if (pBench->isCipher)
+            {
+                pReq->pIv = qaeMemAllocNUMA(PARTIAL_IV_SIZE, 0, 64);
+                if (NULL == pReq->pIv)
+                    return CPA_STATUS_RESOURCE;
+                pReq->opData.pIv = pReq->pIv;
+                pReq->opData.ivLenInBytes = PARTIAL_IV_SIZE;
+                pReq->opData.messageLenToCipherInBytes = pBench->partialSize;
+            }
+            else
+            {
+                pReq->opData.messageLenToHashInBytes = pBench->partialSize;
+                pReq->opData.pDigestResult = pStream->pDigest;
+            }
+        }
+    }
+
+    return CPA_STATUS_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    partial_bench_t bench;
+    Cpa32U depth = 0;
+    Cpa32U i;
+    CpaStatus status;
+    int opt;
+
+    memset(&bench, 0, sizeof(bench));
+    bench.numStreams = PARTIAL_DEFAULT_STREAMS;
+    bench.numPartials = PARTIAL_DEFAULT_PARTIALS;
+    bench.partialSize = PARTIAL_DEFAULT_SIZE;
+    bench.loops = PARTIAL_DEFAULT_LOOPS;
+    bench.numThreads = PARTIAL_DEFAULT_THREADS;
+    while ((opt = getopt(argc, argv, "a:s:p:b:d:l:t:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'a':
+                if (!strcmp(optarg, "aes-cbc"))
+                    bench.isCipher = CPA_TRUE;
+                else if (strcmp(optarg, "sha256"))
+                    opt = '?';
+                break;
+            case 's':
+                bench.numStreams = strtoul(optarg, NULL, 0);
+                break;
+            case 'p':
+                bench.numPartials = strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                bench.partialSize = strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                depth = strtoul(optarg, NULL, 0);
+                break;
+            case 'l':
+                bench.loops = strtoul(optarg, NULL, 0);
+                break;
+            case 't':
+                bench.numThreads = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                break;
+        }
+        if ('?' == opt)
+        {
+            fprintf(stderr,
+                    "Usage: %s [-a sha256|aes-cbc] [-s streams] "
+                    "[-p partials] [-b size] [-d depth] [-l loops] "
+                    "[-t threads]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (0 == depth)
+        depth = bench.numPartials;
+    if (0 == bench.numStreams || bench.numPartials < 2 || 0 == bench.loops ||
+        0 == bench.partialSize || bench.partialSize % PARTIAL_BLOCK_SIZE ||
+        0 == bench.numThreads || bench.numThreads > PARTIAL_MAX_THREADS ||
+        depth > bench.numPartials)
+    {
+        fprintf(stderr,
+                "streams and loops must be non zero, partials at least 2, "
+                "size a multiple of %u, threads between 1 and %u and depth "
+                "at most partials\n",
+                PARTIAL_BLOCK_SIZE,
+                PARTIAL_MAX_THREADS);
+        return EXIT_FAILURE;
+    }
+    for (i = 0; i < PARTIAL_KEY_SIZE; i++)
+        bench.key[i] = (Cpa8U)rand();
+    for (i = 0; i < PARTIAL_IV_SIZE; i++)
+        bench.iv[i] = (Cpa8U)rand();
+
+    if (CPA_STATUS_SUCCESS != qatBenchProcessStart())
+        return EXIT_FAILURE;
+
+    status = qatBenchInstancesStart(QAT_BENCH_SERVICE_CY, 1, &bench.instance);
+    if (CPA_STATUS_SUCCESS == status)
+    {
+        status = benchPrepare(&bench);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            printf("%s, %u streams of %u x %u byte partials, %u loops, "
+                   "%u threads\n",
+                   bench.isCipher ? "AES-256-CBC" : "SHA-256",
+                   bench.numStreams,
+                   bench.numPartials,
+                   bench.partialSize,
+                   bench.loops,
+                   bench.numThreads);
+            printf("%6s %10s %12s\n", "Depth", "Mbps", "Messages/s");
+            status = partialRun(&bench, 1);
+            if (CPA_STATUS_SUCCESS == status && depth > 1)
+                status = partialRun(&bench, depth);
+        }
+        else
+        {
+            fprintf(stderr, "Failed to set up the streams (%d)\n", status);
+        }
+        benchFree(&bench);
+        qatBenchInstancesStop(QAT_BENCH_SERVICE_CY, 1, &bench.instance);
+    }
+
+    qatBenchProcessStop();
+
+    printf("%s\n", (CPA_STATUS_SUCCESS == status) ? "PASS" : "FAIL");
+    return (CPA_STATUS_SUCCESS == status) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
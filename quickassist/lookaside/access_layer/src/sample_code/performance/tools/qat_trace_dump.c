@@ -0,0 +1,560 @@
+/****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/**
+ *****************************************************************************
+ * @file qat_trace_dump.c
+ *
+ * @ingroup sample_code
+ *
+ * @description
+ *      Convert a request trace written by icp_sal_TraceDump() (for example
+ *      by cpa_sample_code traceEntries=N) into a per-request timeline, or
+ *      measure the cost of the trace points.
+ *
+ *      Records are merged across threads in time order. A request starts
+ *      with its ENQUEUE event; the RING_PUT and TAIL_WRITE events of the
+ *      submitting thread, the DEQUEUE event preceding its CALLBACK_START on
+ *      the polling thread and its CALLBACK_END are attached to it. Each
+ *      timeline line gives the time of every later event relative to the
+ *      enqueue, in nanoseconds, or '-' when the event was not recorded.
+ *
+ *      Usage: qat_trace_dump [-s] trace_file
+ *             qat_trace_dump -o [num_events]
+ *          -s  print only the per-stage latency summary
+ *          -o  time num_events trace points (default 1000000) with tracing
+ *              disabled and enabled and print the cost of each
+ *
+ *****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cpa.h"
+#include "icp_sal_trace.h"
+
+#define TRACE_DEFAULT_OVERHEAD_EVENTS (1000000)
+
+/* Events of a request, in the order they happen */
+#define TRACE_STAGE_ENQUEUE (0)
+#define TRACE_STAGE_RING_PUT (1)
+#define TRACE_STAGE_TAIL_WRITE (2)
+#define TRACE_STAGE_DEQUEUE (3)
+#define TRACE_STAGE_CALLBACK_START (4)
+#define TRACE_STAGE_CALLBACK_END (5)
+#define TRACE_NUM_STAGES (6)
+
+typedef struct trace_request_s
+{
+    Cpa64U id;
+    Cpa64U timeNs[TRACE_NUM_STAGES];
+    /* Bit per stage recorded for the request */
+    Cpa32U stages;
+    Cpa32U submitThread;
+    Cpa32U pollThread;
+    Cpa32U service;
+    Cpa32U ring;
+} trace_request_t;
+
+/* DEQUEUE waiting for the next CALLBACK_START of its thread */
+typedef struct trace_thread_s
+{
+    Cpa32U threadId;
+    Cpa32U ring;
+    Cpa64U dequeueNs;
+    int pending;
+} trace_thread_t;
+
+typedef struct trace_state_s
+{
+    trace_request_t *requests;
+    size_t numRequests;
+    /* Open addressing table from request id to its latest request + 1 */
+    size_t *idTable;
+    size_t idTableMask;
+    trace_thread_t *threads;
+    size_t numThreads;
+} trace_state_t;
+
+/* Intervals reported in the summary, as pairs of stages */
+static const struct
+{
+    const char *name;
+    int from;
+    int to;
+} traceIntervals_g[] = {
+    {"enqueue->tail_write", TRACE_STAGE_ENQUEUE, TRACE_STAGE_TAIL_WRITE},
+    {"tail_write->dequeue", TRACE_STAGE_TAIL_WRITE, TRACE_STAGE_DEQUEUE},
+    {"dequeue->callback", TRACE_STAGE_DEQUEUE, TRACE_STAGE_CALLBACK_START},
+    {"callback", TRACE_STAGE_CALLBACK_START, TRACE_STAGE_CALLBACK_END},
+    {"enqueue->callback_end", TRACE_STAGE_ENQUEUE, TRACE_STAGE_CALLBACK_END}};
+
+#define TRACE_NUM_INTERVALS                                                    \
+    (sizeof(traceIntervals_g) / sizeof(traceIntervals_g[0]))
+
+static size_t hashId(Cpa64U id)
+{
+    id ^= id >> 33;
+    id *= 0xff51afd7ed558ccdULL;
+    id ^= id >> 33;
+    return (size_t)id;
+}
+
+static size_t *findIdSlot(trace_state_t *pState, Cpa64U id)
+{
+    size_t slot = hashId(id) & pState->idTableMask;
+
+    while (0 != pState->idTable[slot] &&
+           pState->requests[pState->idTable[slot] - 1].id != id)
+    {
+        slot = (slot + 1) & pState->idTableMask;
+    }
+    return &pState->idTable[slot];
+}
+
+static trace_request_t *findRequest(trace_state_t *pState, Cpa64U id)
+{
+    size_t *pSlot = findIdSlot(pState, id);
+
+    return (0 == *pSlot) ? NULL : &pState->requests[*pSlot - 1];
+}
+
+static trace_thread_t *findThread(trace_state_t *pState, Cpa32U threadId)
+{
+    size_t i = 0;
+
+    for (i = 0; i < pState->numThreads; i++)
+    {
+        if (pState->threads[i].threadId == threadId)
+        {
+            return &pState->threads[i];
+        }
+    }
+    pState->threads[pState->numThreads].threadId = threadId;
+    return &pState->threads[pState->numThreads++];
+}
+
+static void setStage(trace_request_t *pRequest, int stage, Cpa64U timeNs)
+{
+    if (!(pRequest->stages & (1U << stage)))
+    {
+        pRequest->stages |= 1U << stage;
+        pRequest->timeNs[stage] = timeNs;
+    }
+}
+
+static void processRecord(trace_state_t *pState,
+                          const icp_sal_trace_record_t *pRecord)
+{
+    trace_request_t *pRequest = NULL;
+    trace_thread_t *pThread = NULL;
+    size_t *pSlot = NULL;
+
+    switch (pRecord->event)
+    {
+        case ICP_SAL_TRACE_EVENT_ENQUEUE:
+            pRequest = &pState->requests[pState->numRequests++];
+            memset(pRequest, 0, sizeof(*pRequest));
+            pRequest->id = pRecord->id;
+            pRequest->submitThread = pRecord->threadId;
+            pRequest->service = pRecord->arg;
+            setStage(pRequest, TRACE_STAGE_ENQUEUE, pRecord->timestampNs);
+            pSlot = findIdSlot(pState, pRecord->id);
+            *pSlot = pState->numRequests;
+            break;
+        case ICP_SAL_TRACE_EVENT_RING_PUT:
+        case ICP_SAL_TRACE_EVENT_TAIL_WRITE:
+            pRequest = findRequest(pState, pRecord->id);
+            if (NULL != pRequest &&
+                pRequest->submitThread == pRecord->threadId)
+            {
+                pRequest->ring = pRecord->arg;
+                setStage(pRequest,
+                         (ICP_SAL_TRACE_EVENT_RING_PUT == pRecord->event)
+                             ? TRACE_STAGE_RING_PUT
+                             : TRACE_STAGE_TAIL_WRITE,
+                         pRecord->timestampNs);
+            }
+            break;
+        case ICP_SAL_TRACE_EVENT_DEQUEUE:
+            pThread = findThread(pState, pRecord->threadId);
+            pThread->pending = 1;
+            pThread->ring = pRecord->arg;
+            pThread->dequeueNs = pRecord->timestampNs;
+            break;
+        case ICP_SAL_TRACE_EVENT_CALLBACK_START:
+            pThread = findThread(pState, pRecord->threadId);
+            pRequest = findRequest(pState, pRecord->id);
+            if (NULL != pRequest)
+            {
+                pRequest->pollThread = pRecord->threadId;
+                if (pThread->pending)
+                {
+                    setStage(
+                        pRequest, TRACE_STAGE_DEQUEUE, pThread->dequeueNs);
+                }
+                setStage(pRequest,
+                         TRACE_STAGE_CALLBACK_START,
+                         pRecord->timestampNs);
+            }
+            pThread->pending = 0;
+            break;
+        case ICP_SAL_TRACE_EVENT_CALLBACK_END:
+            pRequest = findRequest(pState, pRecord->id);
+            if (NULL != pRequest)
+            {
+                setStage(
+                    pRequest, TRACE_STAGE_CALLBACK_END, pRecord->timestampNs);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/* Records being sorted by compareRecords */
+static const icp_sal_trace_record_t *sortRecords_g = NULL;
+
+/* Orders record indices by time; records with the same time keep the file
+ * order, which is the order of each thread */
+static int compareRecords(const void *pA, const void *pB)
+{
+    size_t a = *(const size_t *)pA;
+    size_t b = *(const size_t *)pB;
+
+    if (sortRecords_g[a].timestampNs != sortRecords_g[b].timestampNs)
+    {
+        return (sortRecords_g[a].timestampNs > sortRecords_g[b].timestampNs)
+                   ? 1
+                   : -1;
+    }
+    return (a > b) - (a < b);
+}
+
+static int compareU64(const void *pA, const void *pB)
+{
+    Cpa64U a = *(const Cpa64U *)pA;
+    Cpa64U b = *(const Cpa64U *)pB;
+
+    return (a > b) - (a < b);
+}
+
+static icp_sal_trace_record_t *loadTrace(const char *fileName,
+                                         size_t *pNumRecords)
+{
+    icp_sal_trace_file_header_t header = {0};
+    icp_sal_trace_record_t *pRecords = NULL;
+    FILE *pFile = fopen(fileName, "r");
+
+    if (NULL == pFile)
+    {
+        fprintf(stderr, "Cannot open %s\n", fileName);
+        return NULL;
+    }
+    if (1 != fread(&header, sizeof(header), 1, pFile) ||
+        ICP_SAL_TRACE_FILE_MAGIC != header.magic ||
+        ICP_SAL_TRACE_FILE_VERSION != header.version ||
+        sizeof(icp_sal_trace_record_t) != header.recordSize)
+    {
+        fprintf(stderr, "%s is not a trace file\n", fileName);
+        fclose(pFile);
+        return NULL;
+    }
+
+    pRecords = calloc(header.numRecords + 1, sizeof(icp_sal_trace_record_t));
+    if (NULL == pRecords)
+    {
+        fprintf(stderr, "Out of memory\n");
+    }
+    else if (header.numRecords != fread(pRecords,
+                                        sizeof(icp_sal_trace_record_t),
+                                        header.numRecords,
+                                        pFile))
+    {
+        fprintf(stderr, "%s is truncated\n", fileName);
+        free(pRecords);
+        pRecords = NULL;
+    }
+    fclose(pFile);
+
+    *pNumRecords = header.numRecords;
+    return pRecords;
+}
+
+static void printTimeline(const trace_state_t *pState)
+{
+    const trace_request_t *pRequest = NULL;
+    size_t i = 0;
+    int stage = 0;
+
+    printf("%-18s %-4s %-7s %-7s %-10s %-20s %10s %10s %10s %10s %10s\n",
+           "id",
+           "svc",
+           "submit",
+           "poll",
+           "ring",
+           "enqueue_ns",
+           "ring_put",
+           "tail",
+           "dequeue",
+           "cb_start",
+           "cb_end");
+    for (i = 0; i < pState->numRequests; i++)
+    {
+        pRequest = &pState->requests[i];
+        printf("0x%016llx %-4s %-7u %-7u 0x%08x %-20llu",
+               (unsigned long long)pRequest->id,
+               (ICP_SAL_TRACE_SERVICE_SYM == pRequest->service) ? "sym"
+                                                                : "dc",
+               pRequest->submitThread,
+               pRequest->pollThread,
+               pRequest->ring,
+               (unsigned long long)pRequest->timeNs[TRACE_STAGE_ENQUEUE]);
+        for (stage = TRACE_STAGE_RING_PUT; stage < TRACE_NUM_STAGES; stage++)
+        {
+            if (pRequest->stages & (1U << stage))
+            {
+                printf(" %10llu",
+                       (unsigned long long)(pRequest->timeNs[stage] -
+                                            pRequest->timeNs[0]));
+            }
+            else
+            {
+                printf(" %10s", "-");
+            }
+        }
+        printf("\n");
+    }
+}
+
+static int printSummary(const trace_state_t *pState)
+{
+    const trace_request_t *pRequest = NULL;
+    Cpa64U *pValues = NULL;
+    size_t count = 0;
+    size_t i = 0;
+    size_t n = 0;
+    Cpa32U both = 0;
+
+    pValues = calloc(pState->numRequests + 1, sizeof(Cpa64U));
+    if (NULL == pValues)
+    {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    printf("%zu requests\n", pState->numRequests);
+    printf("%-22s %10s %10s %10s %10s\n", "ns", "count", "p50", "p99", "max");
+    for (n = 0; n < TRACE_NUM_INTERVALS; n++)
+    {
+        both = (1U << traceIntervals_g[n].from) |
+               (1U << traceIntervals_g[n].to);
+        count = 0;
+        for (i = 0; i < pState->numRequests; i++)
+        {
+            pRequest = &pState->requests[i];
+            if ((pRequest->stages & both) == both)
+            {
+                pValues[count++] = pRequest->timeNs[traceIntervals_g[n].to] -
+                                   pRequest->timeNs[traceIntervals_g[n].from];
+            }
+        }
+        if (0 == count)
+        {
+            printf("%-22s %10u %10s %10s %10s\n",
+                   traceIntervals_g[n].name,
+                   0,
+                   "-",
+                   "-",
+                   "-");
+            continue;
+        }
+        qsort(pValues, count, sizeof(Cpa64U), compareU64);
+        printf("%-22s %10zu %10llu %10llu %10llu\n",
+               traceIntervals_g[n].name,
+               count,
+               (unsigned long long)pValues[count / 2],
+               (unsigned long long)pValues[count * 99 / 100],
+               (unsigned long long)pValues[count - 1]);
+    }
+    free(pValues);
+    return 0;
+}
+
+static int measureOverhead(Cpa32U numEvents)
+{
+    Cpa64U disabledNs = 0;
+    Cpa64U enabledNs = 0;
+
+    if (CPA_STATUS_SUCCESS !=
+        icp_sal_TraceMeasureOverhead(numEvents, &disabledNs, &enabledNs))
+    {
+        fprintf(stderr, "Failed to measure the trace overhead\n");
+        return 1;
+    }
+    printf("trace point disabled: %llu ns\n", (unsigned long long)disabledNs);
+    printf("trace point enabled:  %llu ns\n", (unsigned long long)enabledNs);
+    icp_sal_TraceFree();
+    return 0;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [-s] trace_file\n"
+            "       %s -o [num_events]\n",
+            program,
+            program);
+}
+
+int main(int argc, char *argv[])
+{
+    trace_state_t state = {0};
+    icp_sal_trace_record_t *pRecords = NULL;
+    size_t *pOrder = NULL;
+    size_t numRecords = 0;
+    size_t tableSize = 1;
+    size_t i = 0;
+    int summaryOnly = 0;
+    int overhead = 0;
+    int opt = 0;
+    int ret = 0;
+
+    while (-1 != (opt = getopt(argc, argv, "soh")))
+    {
+        switch (opt)
+        {
+            case 's':
+                summaryOnly = 1;
+                break;
+            case 'o':
+                overhead = 1;
+                break;
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+    if (overhead)
+    {
+        if (argc - optind > 1)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+        return measureOverhead((argc > optind)
+                                   ? (Cpa32U)strtoul(argv[optind], NULL, 0)
+                                   : TRACE_DEFAULT_OVERHEAD_EVENTS);
+    }
+    if (argc - optind != 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    pRecords = loadTrace(argv[optind], &numRecords);
+    if (NULL == pRecords)
+    {
+        return 1;
+    }
+    while (tableSize < 2 * numRecords)
+    {
+        tableSize <<= 1;
+    }
+    state.idTableMask = tableSize - 1;
+    state.idTable = calloc(tableSize, sizeof(size_t));
+    state.requests = calloc(numRecords + 1, sizeof(trace_request_t));
+    state.threads = calloc(numRecords + 1, sizeof(trace_thread_t));
+    pOrder = calloc(numRecords + 1, sizeof(size_t));
+    if (NULL == state.idTable || NULL == state.requests ||
+        NULL == state.threads || NULL == pOrder)
+    {
+        fprintf(stderr, "Out of memory\n");
+        ret = 1;
+    }
+    else
+    {
+        for (i = 0; i < numRecords; i++)
+        {
+            pOrder[i] = i;
+        }
+        sortRecords_g = pRecords;
+        qsort(pOrder, numRecords, sizeof(size_t), compareRecords);
+        for (i = 0; i < numRecords; i++)
+        {
+            processRecord(&state, &pRecords[pOrder[i]]);
+        }
+        if (!summaryOnly)
+        {
+            printTimeline(&state);
+        }
+        ret = printSummary(&state);
+    }
+
+    free(state.idTable);
+    free(state.requests);
+    free(state.threads);
+    free(pOrder);
+    free(pRecords);
+    return ret;
+}
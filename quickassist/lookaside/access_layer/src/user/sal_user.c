@@ -89,6 +89,7 @@
 
 /* SAL includes */
 #include "icp_sal_user.h"
+#include "icp_sal_telemetry.h"
 #include "lac_log.h"
 #include "lac_mem.h"
 #include "lac_mem_pools.h"
@@ -168,6 +169,22 @@ static CpaStatus do_userStart(const char *process_name)
     return status;
 }
 
+static void do_telemetryStart(void)
+{
+    const char *interval = getenv(ICP_SAL_TELEMETRY_ENV);
+
+    if (NULL == interval)
+    {
+        return;
+    }
+    /* Telemetry is optional, the process starts without it on failure */
+    if (CPA_STATUS_SUCCESS !=
+        icp_sal_TelemetryStart((Cpa32U)strtoul(interval, NULL, 10)))
+    {
+        LAC_LOG_ERROR("Failed to start telemetry\n");
+    }
+}
+
 CpaStatus icp_sal_userStart(const char *process_name)
 {
     char name[ADF_CFG_MAX_SECTION_LEN_IN_BYTES + 1] = {0};
@@ -205,6 +222,10 @@ CpaStatus icp_sal_userStart(const char *process_name)
             return CPA_STATUS_FAIL;
         }
         status = do_userStart(name);
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            do_telemetryStart();
+        }
     }
     if (CPA_STATUS_SUCCESS == status)
     {
@@ -279,6 +300,7 @@ CpaStatus icp_sal_userStop()
     }
     if (1 == start_ref_count)
     {
+        icp_sal_TelemetryStop();
         status = do_userStop();
     }
     if (0 < start_ref_count)
@@ -81,6 +81,7 @@
 /* SAL includes */
 #include "icp_sal_congestion_mgmt.h"
 #include "lac_sal_types_crypto.h"
+#include "sal_types_compression.h"
 #include "lac_sal.h"
 #include "sal_service_state.h"
 
@@ -138,6 +139,24 @@ CpaStatus icp_sal_AsymGetInflightRequests(CpaInstanceHandle instanceHandle,
                                        numInflightRequests);
 }
 
+CpaStatus icp_sal_DcGetInflightRequests(CpaInstanceHandle instanceHandle,
+                                        Cpa32U *maxInflightRequests,
+                                        Cpa32U *numInflightRequests)
+{
+    sal_compression_service_t *dc_handle = NULL;
+
+    dc_handle = (sal_compression_service_t *)instanceHandle;
+
+    LAC_CHECK_NULL_PARAM(dc_handle);
+    LAC_CHECK_NULL_PARAM(maxInflightRequests);
+    LAC_CHECK_NULL_PARAM(numInflightRequests);
+    SAL_RUNNING_CHECK(dc_handle);
+
+    return icp_adf_getInflightRequests(dc_handle->trans_handle_compression_tx,
+                                       maxInflightRequests,
+                                       numInflightRequests);
+}
+
 /*
  *****************************************************************************
  * @ingroup SalCongsMgmt
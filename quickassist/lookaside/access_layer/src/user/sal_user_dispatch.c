@@ -0,0 +1,188 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/*
+ *****************************************************************************
+/*
+ *****************************************************************************
+ * @file sal_user_dispatch.c
+ *
+ * @defgroup SalDispatch
+ *
+ * @description
+ *    This file contains the instance dispatcher API implementation. The
+ *    instances are scored in common code; the choice each thread sticks
+ *    to is kept here, in thread local storage.
+ *****************************************************************************/
+
+/* QAT-API includes */
+#include "cpa.h"
+
+/* ADF includes */
+#include "icp_accel_devices.h"
+
+/* SAL includes */
+#include "icp_sal_dispatch.h"
+#include "lac_common.h"
+#include "lac_log.h"
+#include "lac_sal_types.h"
+#include "lac_sal_ctrl.h"
+
+/* Load of the current instance above which a thread rescans at once */
+#define SAL_DISPATCH_STICKY_LOAD (SAL_DISPATCH_LOAD_SCALE / 2)
+
+/* Calls served from the per-thread choice between two scans */
+#define SAL_DISPATCH_RESCAN_INTERVAL (64)
+
+/* Per-thread choices, one per supported service type */
+#define SAL_DISPATCH_NUM_TYPES (4)
+
+/**
+ ******************************************************************************
+ * @ingroup SalDispatch
+ *      Per-thread choice of the dispatcher for one service type
+ *****************************************************************************/
+typedef struct sal_dispatch_choice_s
+{
+    CpaInstanceHandle instance;
+    /**< Instance last handed to the thread */
+    Cpa64U generation;
+    /**< SalCtrl_DispatchGeneration() when the choice was made */
+    Cpa32U calls;
+    /**< Calls served since the last scan */
+} sal_dispatch_choice_t;
+
+STATIC __thread sal_dispatch_choice_t salDispatchChoice[SAL_DISPATCH_NUM_TYPES];
+
+/**
+ ******************************************************************************
+ * @ingroup SalDispatch
+ *****************************************************************************/
+CpaStatus icp_sal_DispatchGetInstance(
+    const CpaAccelerationServiceType serviceType,
+    CpaInstanceHandle *pInstanceHandle)
+{
+    sal_dispatch_choice_t *pChoice = NULL;
+    CpaInstanceHandle current = NULL;
+    Cpa64U generation = 0;
+    Cpa32U node = 0;
+    Cpa32U score = 0;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    LAC_CHECK_NULL_PARAM(pInstanceHandle);
+
+    switch (serviceType)
+    {
+#ifndef ICP_DC_ONLY
+        case CPA_ACC_SVC_TYPE_CRYPTO:
+            pChoice = &salDispatchChoice[0];
+            break;
+        case CPA_ACC_SVC_TYPE_CRYPTO_SYM:
+            pChoice = &salDispatchChoice[1];
+            break;
+        case CPA_ACC_SVC_TYPE_CRYPTO_ASYM:
+            pChoice = &salDispatchChoice[2];
+            break;
+#endif
+        case CPA_ACC_SVC_TYPE_DATA_COMPRESSION:
+            pChoice = &salDispatchChoice[3];
+            break;
+        default:
+            LAC_INVALID_PARAM_LOG("Invalid service type");
+            return CPA_STATUS_INVALID_PARAM;
+    }
+
+    /* A choice is only trusted while no instance has been freed since */
+    generation = SalCtrl_DispatchGeneration();
+    if (pChoice->generation == generation)
+    {
+        current = pChoice->instance;
+    }
+
+    if (OSAL_SUCCESS != osalGetCurrentNode(&node))
+    {
+        node = 0;
+    }
+
+    if ((NULL != current) &&
+        (pChoice->calls < SAL_DISPATCH_RESCAN_INTERVAL) &&
+        (CPA_STATUS_SUCCESS ==
+         SalCtrl_DispatchScore(current, serviceType, node, &score)) &&
+        (score < SAL_DISPATCH_STICKY_LOAD))
+    {
+        pChoice->calls++;
+        *pInstanceHandle = current;
+        return CPA_STATUS_SUCCESS;
+    }
+
+    status = SalCtrl_DispatchScan(serviceType, node, current, pInstanceHandle);
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        pChoice->instance = NULL;
+        return status;
+    }
+
+    pChoice->instance = *pInstanceHandle;
+    pChoice->generation = generation;
+    pChoice->calls = 0;
+    return CPA_STATUS_SUCCESS;
+}
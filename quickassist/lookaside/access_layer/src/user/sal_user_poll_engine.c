@@ -0,0 +1,520 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+
+/*
+ *****************************************************************************
+ * @file sal_user_poll_engine.c
+ *
+ * @defgroup SalUserPollEngine
+ *
+ * @description
+ *    Adaptive spin-then-block polling engine. One thread per instance
+ *    busy-polls while responses keep arriving, backs off exponentially
+ *    while requests are in flight but slow to complete, and blocks on an
+ *    eventfd signalled by the request rings when nothing is in flight.
+ *****************************************************************************/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* ppoll */
+#endif
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+/* QAT-API includes */
+#include "cpa.h"
+
+/* ADF includes */
+#include "icp_adf_init.h"
+#include "icp_adf_transport.h"
+
+/* SAL includes */
+#include "icp_sal_poll.h"
+#include "lac_common.h"
+#include "lac_log.h"
+#include "lac_mem.h"
+#include "lac_sal_types.h"
+#ifndef ICP_DC_ONLY
+#include "lac_sal_types_crypto.h"
+#endif
+#include "sal_types_compression.h"
+#include "sal_service_state.h"
+
+#define SAL_POLL_ENGINE_DEFAULT_SPIN_POLLS 256
+#define SAL_POLL_ENGINE_DEFAULT_MIN_BACKOFF_USECS 10
+#define SAL_POLL_ENGINE_DEFAULT_MAX_BACKOFF_USECS 1000
+#define SAL_POLL_ENGINE_MAX_TX_RINGS 2
+#define SAL_POLL_ENGINE_NSECS_IN_USEC 1000ULL
+#define SAL_POLL_ENGINE_NSECS_IN_SEC 1000000000ULL
+
+typedef CpaStatus (*sal_poll_engine_poll_fn)(CpaInstanceHandle, Cpa32U);
+
+typedef struct sal_poll_engine_s
+{
+    CpaInstanceHandle instanceHandle;
+    sal_poll_engine_poll_fn pollFn;
+    icp_comms_trans_handle txHandles[SAL_POLL_ENGINE_MAX_TX_RINGS];
+    Cpa32U numTxHandles;
+    /* epoll set holding the instance fd in epoll mode, -1 otherwise */
+    int epollFd;
+    icp_adf_wakeup_t wakeup;
+    icp_sal_poll_engine_config_t config;
+    icp_sal_poll_engine_stats_t stats;
+    volatile CpaBoolean stop;
+    pthread_t thread;
+} sal_poll_engine_t;
+
+/* Serialises engine start and stop against each other */
+static pthread_mutex_t salPollEngineLock = PTHREAD_MUTEX_INITIALIZER;
+
+static inline Cpa64U salPollEngineNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Cpa64U)ts.tv_sec * SAL_POLL_ENGINE_NSECS_IN_SEC + ts.tv_nsec;
+}
+
+static Cpa32U salPollEngineInflight(sal_poll_engine_t *pEngine)
+{
+    Cpa32U i = 0;
+    Cpa32U max = 0;
+    Cpa32U num = 0;
+    Cpa32U total = 0;
+
+    for (i = 0; i < pEngine->numTxHandles; i++)
+    {
+        if (CPA_STATUS_SUCCESS ==
+            icp_adf_getInflightRequests(pEngine->txHandles[i], &max, &num))
+        {
+            total += num;
+        }
+    }
+    return total;
+}
+
+/*
+ * Arm the ring notifiers and wait for a submission, the instance fd or
+ * the backoff timeout. Arming happens before the in-flight check so a
+ * request put on a ring in between is either counted or signalled.
+ */
+static void salPollEngineWait(sal_poll_engine_t *pEngine,
+                              Cpa32U *pBackoffUsecs,
+                              CpaBoolean forceTimeout)
+{
+    struct pollfd fds[2];
+    struct epoll_event event;
+    struct timespec timeout;
+    struct timespec *pTimeout = NULL;
+    nfds_t nfds = 1;
+    uint64_t count = 0;
+    Cpa64U start = 0;
+
+    pEngine->wakeup.armed = 1;
+    __sync_synchronize();
+
+    if (forceTimeout || salPollEngineInflight(pEngine) > 0)
+    {
+        timeout.tv_sec = *pBackoffUsecs / 1000000;
+        timeout.tv_nsec =
+            (*pBackoffUsecs % 1000000) * SAL_POLL_ENGINE_NSECS_IN_USEC;
+        pTimeout = &timeout;
+        *pBackoffUsecs *= 2;
+        if (*pBackoffUsecs > pEngine->config.maxBackoffUsecs)
+        {
+            *pBackoffUsecs = pEngine->config.maxBackoffUsecs;
+        }
+        pEngine->stats.sleeps++;
+    }
+    else
+    {
+        pEngine->stats.blocks++;
+    }
+
+    fds[0].fd = pEngine->wakeup.fd;
+    fds[0].events = POLLIN;
+    fds[0].revents = 0;
+    if (pEngine->epollFd >= 0)
+    {
+        fds[1].fd = pEngine->epollFd;
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+        nfds = 2;
+    }
+
+    start = salPollEngineNow();
+    if (!pEngine->stop && ppoll(fds, nfds, pTimeout, NULL) > 0)
+    {
+        if (fds[0].revents & POLLIN)
+        {
+            if (read(pEngine->wakeup.fd, &count, sizeof(count)) > 0)
+            {
+                pEngine->stats.wakeups++;
+            }
+        }
+        /* Consume the edge of the instance fd */
+        if (nfds > 1 && (fds[1].revents & POLLIN) &&
+            epoll_wait(pEngine->epollFd, &event, 1, 0) > 0)
+        {
+            pEngine->stats.fdWakeups++;
+        }
+    }
+    pEngine->stats.sleepNs += salPollEngineNow() - start;
+    pEngine->wakeup.armed = 0;
+}
+
+static void *salPollEngineThread(void *arg)
+{
+    sal_poll_engine_t *pEngine = (sal_poll_engine_t *)arg;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U idlePolls = 0;
+    Cpa32U backoffUsecs = pEngine->config.minBackoffUsecs;
+    Cpa64U start = 0;
+    Cpa64U end = 0;
+
+    start = salPollEngineNow();
+    while (!pEngine->stop)
+    {
+        status =
+            pEngine->pollFn(pEngine->instanceHandle,
+                            pEngine->config.responseQuota);
+        end = salPollEngineNow();
+        if (CPA_STATUS_SUCCESS == status)
+        {
+            pEngine->stats.busyPolls++;
+            pEngine->stats.busyNs += end - start;
+            idlePolls = 0;
+            backoffUsecs = pEngine->config.minBackoffUsecs;
+        }
+        else
+        {
+            pEngine->stats.idlePolls++;
+            pEngine->stats.spinNs += end - start;
+            /* Errors (e.g. a restarting device) never block untimed */
+            if (CPA_STATUS_RETRY != status ||
+                ++idlePolls >= pEngine->config.spinPolls)
+            {
+                salPollEngineWait(
+                    pEngine, &backoffUsecs, CPA_STATUS_RETRY != status);
+                idlePolls = 0;
+            }
+        }
+        start = salPollEngineNow();
+    }
+    return NULL;
+}
+
+static sal_poll_engine_t *salPollEngineCreate(CpaInstanceHandle instanceHandle)
+{
+    sal_service_t *pService = (sal_service_t *)instanceHandle;
+    sal_poll_engine_t *pEngine = NULL;
+    int fd = -1;
+    Cpa32U isPolled = 0;
+    CpaStatus (*getFdFn)(CpaInstanceHandle, int *) = NULL;
+
+    if (CPA_STATUS_SUCCESS !=
+        LAC_OS_MALLOC(&pEngine, sizeof(sal_poll_engine_t)))
+    {
+        LAC_LOG_ERROR("Failed to allocate polling engine");
+        return NULL;
+    }
+    memset(pEngine, 0, sizeof(sal_poll_engine_t));
+    pEngine->instanceHandle = instanceHandle;
+    pEngine->epollFd = -1;
+
+    switch (pService->type)
+    {
+#ifndef ICP_DC_ONLY
+        case SAL_SERVICE_TYPE_CRYPTO:
+        case SAL_SERVICE_TYPE_CRYPTO_SYM:
+        case SAL_SERVICE_TYPE_CRYPTO_ASYM:
+        {
+            sal_crypto_service_t *pCrypto =
+                (sal_crypto_service_t *)instanceHandle;
+
+            pEngine->pollFn = icp_sal_CyPollInstance;
+            getFdFn = icp_sal_CyGetFileDescriptor;
+            isPolled = pCrypto->isPolled;
+            if (SAL_SERVICE_TYPE_CRYPTO_ASYM != pService->type)
+            {
+                pEngine->txHandles[pEngine->numTxHandles++] =
+                    pCrypto->trans_handle_sym_tx;
+            }
+            if (SAL_SERVICE_TYPE_CRYPTO_SYM != pService->type)
+            {
+                pEngine->txHandles[pEngine->numTxHandles++] =
+                    pCrypto->trans_handle_asym_tx;
+            }
+            break;
+        }
+#endif
+        case SAL_SERVICE_TYPE_COMPRESSION:
+        {
+            sal_compression_service_t *pCompression =
+                (sal_compression_service_t *)instanceHandle;
+
+            pEngine->pollFn = icp_sal_DcPollInstance;
+            getFdFn = icp_sal_DcGetFileDescriptor;
+            isPolled = pCompression->isPolled;
+            pEngine->txHandles[pEngine->numTxHandles++] =
+                pCompression->trans_handle_compression_tx;
+            break;
+        }
+        default:
+            LAC_LOG_ERROR("Polling engine does not support this instance");
+            LAC_OS_FREE(pEngine);
+            return NULL;
+    }
+
+    pEngine->wakeup.fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (pEngine->wakeup.fd < 0)
+    {
+        LAC_LOG_ERROR("Failed to create polling engine eventfd");
+        LAC_OS_FREE(pEngine);
+        return NULL;
+    }
+
+    if (SAL_RESP_EPOLL_CFG_FILE == isPolled &&
+        CPA_STATUS_SUCCESS == getFdFn(instanceHandle, &fd))
+    {
+        struct epoll_event event;
+
+        pEngine->epollFd = epoll_create1(EPOLL_CLOEXEC);
+        event.data.fd = fd;
+        event.events = EPOLLIN | EPOLLET;
+        if (pEngine->epollFd >= 0 &&
+            epoll_ctl(pEngine->epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            close(pEngine->epollFd);
+            pEngine->epollFd = -1;
+        }
+        if (pEngine->epollFd < 0)
+        {
+            LAC_LOG("Polling engine runs without the instance fd\n");
+        }
+    }
+    return pEngine;
+}
+
+static void salPollEngineDestroy(sal_poll_engine_t *pEngine)
+{
+    Cpa32U i = 0;
+
+    for (i = 0; i < pEngine->numTxHandles; i++)
+    {
+        icp_adf_transSetWakeup(pEngine->txHandles[i], NULL);
+    }
+    if (pEngine->epollFd >= 0)
+    {
+        close(pEngine->epollFd);
+    }
+    close(pEngine->wakeup.fd);
+    LAC_OS_FREE(pEngine);
+}
+
+CpaStatus icp_sal_PollEngineStart(CpaInstanceHandle instanceHandle,
+                                  const icp_sal_poll_engine_config_t *pConfig)
+{
+    sal_service_t *pService = (sal_service_t *)instanceHandle;
+    sal_poll_engine_t *pEngine = NULL;
+    sigset_t set;
+    sigset_t oldSet;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+    Cpa32U i = 0;
+
+    LAC_CHECK_NULL_PARAM(pService);
+    SAL_RUNNING_CHECK(pService);
+
+    if (!(pService->type & (SAL_SERVICE_TYPE_CRYPTO |
+                            SAL_SERVICE_TYPE_CRYPTO_SYM |
+                            SAL_SERVICE_TYPE_CRYPTO_ASYM |
+                            SAL_SERVICE_TYPE_COMPRESSION)))
+    {
+        LAC_INVALID_PARAM_LOG("Instance type not supported");
+        return CPA_STATUS_UNSUPPORTED;
+    }
+
+    pthread_mutex_lock(&salPollEngineLock);
+    if (NULL != pService->pollEngine)
+    {
+        pthread_mutex_unlock(&salPollEngineLock);
+        LAC_LOG_ERROR("Polling engine already running on this instance");
+        return CPA_STATUS_FAIL;
+    }
+
+    pEngine = salPollEngineCreate(instanceHandle);
+    if (NULL == pEngine)
+    {
+        pthread_mutex_unlock(&salPollEngineLock);
+        return CPA_STATUS_RESOURCE;
+    }
+
+    if (NULL != pConfig)
+    {
+        pEngine->config = *pConfig;
+    }
+    if (0 == pEngine->config.spinPolls)
+    {
+        pEngine->config.spinPolls = SAL_POLL_ENGINE_DEFAULT_SPIN_POLLS;
+    }
+    if (0 == pEngine->config.minBackoffUsecs)
+    {
+        pEngine->config.minBackoffUsecs =
+            SAL_POLL_ENGINE_DEFAULT_MIN_BACKOFF_USECS;
+    }
+    if (0 == pEngine->config.maxBackoffUsecs)
+    {
+        pEngine->config.maxBackoffUsecs =
+            SAL_POLL_ENGINE_DEFAULT_MAX_BACKOFF_USECS;
+    }
+    if (pEngine->config.maxBackoffUsecs < pEngine->config.minBackoffUsecs)
+    {
+        pEngine->config.maxBackoffUsecs = pEngine->config.minBackoffUsecs;
+    }
+
+    for (i = 0; i < pEngine->numTxHandles; i++)
+    {
+        icp_adf_transSetWakeup(pEngine->txHandles[i], &pEngine->wakeup);
+    }
+
+    /* The engine thread does not handle signals of the application */
+    sigfillset(&set);
+    pthread_sigmask(SIG_SETMASK, &set, &oldSet);
+    if (pthread_create(
+            &pEngine->thread, NULL, salPollEngineThread, (void *)pEngine))
+    {
+        LAC_LOG_ERROR("Failed to create polling engine thread");
+        status = CPA_STATUS_RESOURCE;
+    }
+    pthread_sigmask(SIG_SETMASK, &oldSet, NULL);
+
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        salPollEngineDestroy(pEngine);
+    }
+    else
+    {
+        pService->pollEngine = pEngine;
+    }
+    pthread_mutex_unlock(&salPollEngineLock);
+    return status;
+}
+
+CpaStatus icp_sal_PollEngineStop(CpaInstanceHandle instanceHandle)
+{
+    sal_service_t *pService = (sal_service_t *)instanceHandle;
+    sal_poll_engine_t *pEngine = NULL;
+    uint64_t one = 1;
+
+    LAC_CHECK_NULL_PARAM(pService);
+
+    pthread_mutex_lock(&salPollEngineLock);
+    pEngine = (sal_poll_engine_t *)pService->pollEngine;
+    if (NULL == pEngine)
+    {
+        pthread_mutex_unlock(&salPollEngineLock);
+        return CPA_STATUS_FAIL;
+    }
+    pService->pollEngine = NULL;
+
+    pEngine->stop = CPA_TRUE;
+    __sync_synchronize();
+    if (write(pEngine->wakeup.fd, &one, sizeof(one)) != sizeof(one))
+    {
+        LAC_LOG_ERROR("Failed to wake polling engine thread");
+    }
+    pthread_join(pEngine->thread, NULL);
+    salPollEngineDestroy(pEngine);
+    pthread_mutex_unlock(&salPollEngineLock);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_PollEngineGetStats(CpaInstanceHandle instanceHandle,
+                                     icp_sal_poll_engine_stats_t *pStats)
+{
+    sal_service_t *pService = (sal_service_t *)instanceHandle;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    LAC_CHECK_NULL_PARAM(pService);
+    LAC_CHECK_NULL_PARAM(pStats);
+
+    pthread_mutex_lock(&salPollEngineLock);
+    if (NULL == pService->pollEngine)
+    {
+        status = CPA_STATUS_FAIL;
+    }
+    else
+    {
+        *pStats = ((sal_poll_engine_t *)pService->pollEngine)->stats;
+    }
+    pthread_mutex_unlock(&salPollEngineLock);
+    return status;
+}
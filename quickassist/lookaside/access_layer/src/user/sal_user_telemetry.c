@@ -0,0 +1,531 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/*
+ *****************************************************************************
+ * @file sal_user_telemetry.c
+ *
+ * @defgroup SalTelemetry
+ *
+ * @description
+ *    This file contains the live telemetry API implementations. A publisher
+ *    thread copies the state of the rings, instances and memory pools of the
+ *    process into a shared memory segment that tools such as qat_telemetry
+ *    read without involving the process.
+ *****************************************************************************/
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/* QAT-API includes */
+#include "cpa.h"
+#include "cpa_dc.h"
+#ifndef ICP_DC_ONLY
+#include "cpa_cy_sym.h"
+#endif
+
+/* ADF includes */
+#include "icp_accel_devices.h"
+#include "icp_adf_accel_mgr.h"
+#include "icp_adf_transport.h"
+
+/* SAL includes */
+#include "icp_sal_telemetry.h"
+#include "lac_common.h"
+#include "lac_log.h"
+#include "lac_list.h"
+#include "lac_mem_pools.h"
+#include "lac_sal_types.h"
+#ifndef ICP_DC_ONLY
+#include "lac_sal_types_crypto.h"
+#endif
+#include "sal_types_compression.h"
+#include "sal_service_state.h"
+#include "lac_sal_ctrl.h"
+
+#define SAL_TELEMETRY_NSECS_IN_MSEC 1000000ULL
+#define SAL_TELEMETRY_NSECS_IN_SEC 1000000000ULL
+
+typedef struct sal_telemetry_s
+{
+    icp_sal_telemetry_shm_t *pShm;
+    char shmName[ICP_SAL_TELEMETRY_NAME_LEN];
+    Cpa32U intervalMs;
+    CpaBoolean stop;
+    pthread_cond_t cond;
+    pthread_t thread;
+} sal_telemetry_t;
+
+/* Serialises start and stop against each other and wakes the publisher */
+static pthread_mutex_t salTelemetryLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Held by the publisher while it reads the instances and by
+ * SalCtrl_ServiceShutdown() while it frees them */
+static pthread_mutex_t salTelemetryInstanceLock = PTHREAD_MUTEX_INITIALIZER;
+
+static sal_telemetry_t *salTelemetry = NULL;
+
+void SalCtrl_TelemetryLock(void)
+{
+    pthread_mutex_lock(&salTelemetryInstanceLock);
+}
+
+void SalCtrl_TelemetryUnlock(void)
+{
+    pthread_mutex_unlock(&salTelemetryInstanceLock);
+}
+
+static inline Cpa64U salTelemetryNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (Cpa64U)ts.tv_sec * SAL_TELEMETRY_NSECS_IN_SEC + ts.tv_nsec;
+}
+
+static void salTelemetryRing(icp_comms_trans_handle transHandle,
+                             Cpa32U *pInflight,
+                             Cpa32U *pMaxInflight)
+{
+    if ((NULL == transHandle) ||
+        (CPA_STATUS_SUCCESS !=
+         icp_adf_getInflightRequests(transHandle, pMaxInflight, pInflight)))
+    {
+        *pInflight = 0;
+        *pMaxInflight = 0;
+    }
+}
+
+static inline Cpa32U salTelemetryPeak(Cpa32U inflight,
+                                      Cpa32U prevPeak,
+                                      CpaBoolean sameInstance)
+{
+    if ((CPA_TRUE == sameInstance) && (prevPeak > inflight))
+    {
+        return prevPeak;
+    }
+    return inflight;
+}
+
+/*
+ * Fill in the entry of one instance. The peaks are carried over from the
+ * previous update when the entry described the same instance.
+ */
+static void salTelemetryInstance(icp_sal_telemetry_instance_t *pEntry,
+                                 sal_service_t *pService,
+                                 Cpa16U type,
+                                 Cpa16U accelId)
+{
+    CpaBoolean sameInstance = CPA_FALSE;
+    icp_sal_telemetry_instance_t prev = *pEntry;
+    sal_compression_service_t *pDcService = NULL;
+    CpaDcStats dcStats = {0};
+#ifndef ICP_DC_ONLY
+    sal_crypto_service_t *pCyService = NULL;
+    CpaCySymStats64 symStats = {0};
+#endif
+
+    sameInstance = (prev.type == type) && (prev.accelId == accelId) &&
+                   (prev.instance == pService->instance);
+
+    osalMemSet(pEntry, 0, sizeof(*pEntry));
+    pEntry->type = type;
+    pEntry->accelId = accelId;
+    pEntry->instance = pService->instance;
+
+    if (CPA_TRUE != Sal_ServiceIsRunning(pService))
+    {
+        return;
+    }
+    pEntry->running = 1;
+
+    if (ICP_SAL_TELEMETRY_TYPE_DC == type)
+    {
+        pDcService = (sal_compression_service_t *)pService;
+        salTelemetryRing(pDcService->trans_handle_compression_tx,
+                         &pEntry->dcInflight,
+                         &pEntry->dcMaxInflight);
+        if (CPA_STATUS_SUCCESS == cpaDcGetStats(pService, &dcStats))
+        {
+            pEntry->numRequests =
+                dcStats.numCompRequests + dcStats.numDecompRequests;
+            pEntry->numRequestErrors =
+                dcStats.numCompRequestsErrors + dcStats.numDecompRequestsErrors;
+            pEntry->numCompleted =
+                dcStats.numCompCompleted + dcStats.numDecompCompleted;
+            pEntry->numCompletedErrors = dcStats.numCompCompletedErrors +
+                                         dcStats.numDecompCompletedErrors;
+        }
+    }
+#ifndef ICP_DC_ONLY
+    else
+    {
+        pCyService = (sal_crypto_service_t *)pService;
+        if (ICP_SAL_TELEMETRY_TYPE_ASYM != type)
+        {
+            salTelemetryRing(pCyService->trans_handle_sym_tx,
+                             &pEntry->symInflight,
+                             &pEntry->symMaxInflight);
+            if (CPA_STATUS_SUCCESS ==
+                cpaCySymQueryStats64(pService, &symStats))
+            {
+                pEntry->numRequests = symStats.numSymOpRequests;
+                pEntry->numRequestErrors = symStats.numSymOpRequestErrors;
+                pEntry->numCompleted = symStats.numSymOpCompleted;
+                pEntry->numCompletedErrors = symStats.numSymOpCompletedErrors;
+            }
+        }
+        if (ICP_SAL_TELEMETRY_TYPE_SYM != type)
+        {
+            salTelemetryRing(pCyService->trans_handle_asym_tx,
+                             &pEntry->asymInflight,
+                             &pEntry->asymMaxInflight);
+        }
+    }
+#endif
+
+    pEntry->symPeakInflight = salTelemetryPeak(
+        pEntry->symInflight, prev.symPeakInflight, sameInstance);
+    pEntry->asymPeakInflight = salTelemetryPeak(
+        pEntry->asymInflight, prev.asymPeakInflight, sameInstance);
+    pEntry->dcPeakInflight = salTelemetryPeak(
+        pEntry->dcInflight, prev.dcPeakInflight, sameInstance);
+}
+
+static Cpa32U salTelemetryList(icp_sal_telemetry_shm_t *pShm,
+                               Cpa32U numInstances,
+                               sal_list_t *pList,
+                               Cpa16U type,
+                               Cpa16U accelId)
+{
+    while ((NULL != pList) && (numInstances < ICP_SAL_TELEMETRY_MAX_INSTANCES))
+    {
+        salTelemetryInstance(&pShm->instances[numInstances],
+                             (sal_service_t *)SalList_getObject(pList),
+                             type,
+                             accelId);
+        numInstances++;
+        pList = SalList_next(pList);
+    }
+    return numInstances;
+}
+
+static Cpa32U salTelemetryInstances(icp_sal_telemetry_shm_t *pShm)
+{
+    icp_accel_dev_t **pAdfInsts = NULL;
+    sal_t *pSal = NULL;
+    Cpa16U numDevices = 0;
+    Cpa16U accelId = 0;
+    Cpa32U numInstances = 0;
+    Cpa16U i = 0;
+
+    if ((CPA_STATUS_SUCCESS != icp_adf_getNumInstances(&numDevices)) ||
+        (0 == numDevices))
+    {
+        return 0;
+    }
+    pAdfInsts = osalMemAlloc(numDevices * sizeof(icp_accel_dev_t *));
+    if (NULL == pAdfInsts)
+    {
+        return 0;
+    }
+    if (CPA_STATUS_SUCCESS != icp_adf_getInstances(numDevices, pAdfInsts))
+    {
+        osalMemFree(pAdfInsts);
+        return 0;
+    }
+
+    for (i = 0; i < numDevices; i++)
+    {
+        if ((NULL == pAdfInsts[i]) || (NULL == pAdfInsts[i]->pSalHandle))
+        {
+            continue;
+        }
+        pSal = (sal_t *)pAdfInsts[i]->pSalHandle;
+        accelId = (Cpa16U)pAdfInsts[i]->accelId;
+#ifndef ICP_DC_ONLY
+        numInstances = salTelemetryList(pShm,
+                                        numInstances,
+                                        pSal->crypto_services,
+                                        ICP_SAL_TELEMETRY_TYPE_CY,
+                                        accelId);
+        numInstances = salTelemetryList(pShm,
+                                        numInstances,
+                                        pSal->sym_services,
+                                        ICP_SAL_TELEMETRY_TYPE_SYM,
+                                        accelId);
+        numInstances = salTelemetryList(pShm,
+                                        numInstances,
+                                        pSal->asym_services,
+                                        ICP_SAL_TELEMETRY_TYPE_ASYM,
+                                        accelId);
+#endif
+        numInstances = salTelemetryList(pShm,
+                                        numInstances,
+                                        pSal->compression_services,
+                                        ICP_SAL_TELEMETRY_TYPE_DC,
+                                        accelId);
+    }
+    osalMemFree(pAdfInsts);
+    return numInstances;
+}
+
+/* Update the segment under its sequence counter */
+static void salTelemetryUpdate(icp_sal_telemetry_shm_t *pShm)
+{
+    pShm->seq++;
+    __sync_synchronize();
+
+    SalCtrl_TelemetryLock();
+    pShm->numInstances = salTelemetryInstances(pShm);
+    SalCtrl_TelemetryUnlock();
+    pShm->numPools =
+        Lac_MemPoolTelemetryGet(pShm->pools, ICP_SAL_TELEMETRY_MAX_POOLS);
+    pShm->updateNs = salTelemetryNow();
+    pShm->numUpdates++;
+
+    __sync_synchronize();
+    pShm->seq++;
+}
+
+static void *salTelemetryThread(void *arg)
+{
+    sal_telemetry_t *pTelemetry = (sal_telemetry_t *)arg;
+    struct timespec deadline;
+    Cpa64U next = 0;
+
+    pthread_mutex_lock(&salTelemetryLock);
+    while (CPA_TRUE != pTelemetry->stop)
+    {
+        pthread_mutex_unlock(&salTelemetryLock);
+        salTelemetryUpdate(pTelemetry->pShm);
+        pthread_mutex_lock(&salTelemetryLock);
+
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        next = (Cpa64U)deadline.tv_nsec +
+               pTelemetry->intervalMs * SAL_TELEMETRY_NSECS_IN_MSEC;
+        deadline.tv_sec += next / SAL_TELEMETRY_NSECS_IN_SEC;
+        deadline.tv_nsec = next % SAL_TELEMETRY_NSECS_IN_SEC;
+        while ((CPA_TRUE != pTelemetry->stop) &&
+               (0 == pthread_cond_timedwait(
+                         &pTelemetry->cond, &salTelemetryLock, &deadline)))
+        {
+        }
+    }
+    pthread_mutex_unlock(&salTelemetryLock);
+    return NULL;
+}
+
+static void salTelemetryFree(sal_telemetry_t *pTelemetry)
+{
+    if (NULL != pTelemetry->pShm)
+    {
+        munmap(pTelemetry->pShm, sizeof(icp_sal_telemetry_shm_t));
+        shm_unlink(pTelemetry->shmName);
+    }
+    pthread_cond_destroy(&pTelemetry->cond);
+    osalMemFree(pTelemetry);
+}
+
+static CpaStatus salTelemetryCreate(sal_telemetry_t *pTelemetry)
+{
+    icp_sal_telemetry_shm_t *pShm = NULL;
+    char *processName = NULL;
+    int fd = -1;
+
+    snprintf(pTelemetry->shmName,
+             sizeof(pTelemetry->shmName),
+             "%s%d",
+             ICP_SAL_TELEMETRY_SHM_PREFIX,
+             (int)getpid());
+
+    /* A segment left behind by an earlier process with the same pid */
+    shm_unlink(pTelemetry->shmName);
+    fd = shm_open(
+        pTelemetry->shmName, O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LAC_LOG_ERROR("Failed to create the telemetry segment");
+        return CPA_STATUS_RESOURCE;
+    }
+    if (0 != ftruncate(fd, sizeof(icp_sal_telemetry_shm_t)))
+    {
+        LAC_LOG_ERROR("Failed to size the telemetry segment");
+        close(fd);
+        shm_unlink(pTelemetry->shmName);
+        return CPA_STATUS_RESOURCE;
+    }
+    pShm = mmap(NULL,
+                sizeof(icp_sal_telemetry_shm_t),
+                PROT_READ | PROT_WRITE,
+                MAP_SHARED,
+                fd,
+                0);
+    close(fd);
+    if (MAP_FAILED == pShm)
+    {
+        LAC_LOG_ERROR("Failed to map the telemetry segment");
+        shm_unlink(pTelemetry->shmName);
+        return CPA_STATUS_RESOURCE;
+    }
+
+    /* The segment is zero filled, so seq starts even */
+    pShm->magic = ICP_SAL_TELEMETRY_MAGIC;
+    pShm->version = ICP_SAL_TELEMETRY_VERSION;
+    pShm->size = sizeof(icp_sal_telemetry_shm_t);
+    pShm->pid = (Cpa32U)getpid();
+    pShm->intervalMs = pTelemetry->intervalMs;
+    processName = icpGetProcessName();
+    if (NULL != processName)
+    {
+        snprintf(
+            pShm->processName, sizeof(pShm->processName), "%s", processName);
+    }
+    pTelemetry->pShm = pShm;
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_TelemetryStart(Cpa32U intervalMs)
+{
+    sal_telemetry_t *pTelemetry = NULL;
+    pthread_condattr_t condAttr;
+    CpaStatus status = CPA_STATUS_SUCCESS;
+
+    if (0 == intervalMs)
+    {
+        intervalMs = ICP_SAL_TELEMETRY_DEFAULT_INTERVAL_MS;
+    }
+    if ((intervalMs < ICP_SAL_TELEMETRY_MIN_INTERVAL_MS) ||
+        (intervalMs > ICP_SAL_TELEMETRY_MAX_INTERVAL_MS))
+    {
+        LAC_INVALID_PARAM_LOG("intervalMs");
+        return CPA_STATUS_INVALID_PARAM;
+    }
+
+    pTelemetry = osalMemAlloc(sizeof(sal_telemetry_t));
+    if (NULL == pTelemetry)
+    {
+        LAC_LOG_ERROR("Failed to allocate telemetry memory");
+        return CPA_STATUS_RESOURCE;
+    }
+    osalMemSet(pTelemetry, 0, sizeof(sal_telemetry_t));
+    pTelemetry->intervalMs = intervalMs;
+    pthread_condattr_init(&condAttr);
+    pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    pthread_cond_init(&pTelemetry->cond, &condAttr);
+    pthread_condattr_destroy(&condAttr);
+
+    pthread_mutex_lock(&salTelemetryLock);
+    if (NULL != salTelemetry)
+    {
+        pthread_mutex_unlock(&salTelemetryLock);
+        salTelemetryFree(pTelemetry);
+        LAC_LOG_ERROR("Telemetry is already being published");
+        return CPA_STATUS_FAIL;
+    }
+
+    status = salTelemetryCreate(pTelemetry);
+    if ((CPA_STATUS_SUCCESS == status) &&
+        (0 != pthread_create(
+                  &pTelemetry->thread, NULL, salTelemetryThread, pTelemetry)))
+    {
+        LAC_LOG_ERROR("Failed to create the telemetry thread");
+        status = CPA_STATUS_RESOURCE;
+    }
+    if (CPA_STATUS_SUCCESS != status)
+    {
+        pthread_mutex_unlock(&salTelemetryLock);
+        salTelemetryFree(pTelemetry);
+        return status;
+    }
+    salTelemetry = pTelemetry;
+    pthread_mutex_unlock(&salTelemetryLock);
+
+    return CPA_STATUS_SUCCESS;
+}
+
+CpaStatus icp_sal_TelemetryStop(void)
+{
+    sal_telemetry_t *pTelemetry = NULL;
+
+    pthread_mutex_lock(&salTelemetryLock);
+    pTelemetry = salTelemetry;
+    salTelemetry = NULL;
+    if (NULL != pTelemetry)
+    {
+        pTelemetry->stop = CPA_TRUE;
+        pthread_cond_signal(&pTelemetry->cond);
+    }
+    pthread_mutex_unlock(&salTelemetryLock);
+
+    if (NULL != pTelemetry)
+    {
+        pthread_join(pTelemetry->thread, NULL);
+        salTelemetryFree(pTelemetry);
+    }
+    return CPA_STATUS_SUCCESS;
+}
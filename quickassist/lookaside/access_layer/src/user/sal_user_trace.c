@@ -0,0 +1,113 @@
+/***************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ ***************************************************************************/
+
+/*
+ *****************************************************************************
+ * @file sal_user_trace.c
+ *
+ * @defgroup SalTrace
+ *
+ * @description
+ *    This file contains the request lifecycle trace API implementations
+ *****************************************************************************/
+
+/* QAT-API includes */
+#include "cpa.h"
+
+/* ADF includes */
+#include "icp_adf_trace.h"
+
+/* SAL includes */
+#include "icp_sal_trace.h"
+#include "lac_common.h"
+
+CpaStatus icp_sal_TraceEnable(Cpa32U numEntries)
+{
+    return icp_adf_traceEnable(numEntries);
+}
+
+CpaStatus icp_sal_TraceDisable(void)
+{
+    return icp_adf_traceDisable();
+}
+
+CpaStatus icp_sal_TraceDump(const char *fileName)
+{
+    LAC_CHECK_NULL_PARAM(fileName);
+
+    return icp_adf_traceDump(fileName);
+}
+
+CpaStatus icp_sal_TraceFree(void)
+{
+    return icp_adf_traceFree();
+}
+
+CpaStatus icp_sal_TraceMeasureOverhead(Cpa32U numEvents,
+                                       Cpa64U *pDisabledNs,
+                                       Cpa64U *pEnabledNs)
+{
+    LAC_CHECK_NULL_PARAM(pDisabledNs);
+    LAC_CHECK_NULL_PARAM(pEnabledNs);
+
+    return icp_adf_traceMeasureOverhead(numEvents, pDisabledNs, pEnabledNs);
+}
@@ -260,6 +260,29 @@ OSAL_PUBLIC INT64 osalAtomicTestAndSet(INT64 inValue, OsalAtomic *pAtomicVar);
  */
 OSAL_PUBLIC void osalAtomicRelease(OsalAtomic *pAtomicVar);
 
+/**
+ * @ingroup Osal
+ *
+ * @brief Compare and exchange the value of atomic variable
+ *
+ * @param  oldValue (in)   - value pAtomicVar is expected to hold
+ *
+ * @param  newValue (in)   - value to store if it does
+ *
+ * @param  pAtomicVar (in & out)   - atomic variable
+ *
+ * Atomically sets pAtomicVar to newValue if it equals oldValue.
+ * This function is a full barrier.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  yes
+ *
+ * @return previous value of pAtomicVar, equal to oldValue on success
+ */
+OSAL_PUBLIC INT64 osalAtomicCmpXchg(INT64 oldValue,
+                                    INT64 newValue,
+                                    OsalAtomic *pAtomicVar);
+
 /**
  * @ingroup Osal
  *
@@ -379,6 +402,41 @@ OSAL_PUBLIC OSAL_STATUS osalSleep(UINT32 milliseconds);
  */
 OSAL_PUBLIC void osalYield(void);
 
+/**
+ * @ingroup Osal
+ *
+ * @brief Returns the NUMA node of the CPU the current thread runs on
+ *
+ * The answer may be stale as soon as it is returned if the thread is not
+ * bound to the CPUs of a single node.
+ *
+ * @param pNode - NUMA node of the current CPU
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalGetCurrentNode(UINT32 *pNode);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Fills a buffer with random bytes from the system entropy source
+ *
+ * The bytes are suitable for seeding a DRBG or keying a hash. The call
+ * blocks only until the system entropy source has been initialised.
+ *
+ * @param pBuf - buffer to fill
+ * @param count - number of bytes to fill
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalGetRandomBytes(void *pBuf, UINT32 count);
+
 /**************************************
  * Memory functions
  *************************************/
@@ -1198,6 +1256,93 @@ OSAL_PUBLIC OSAL_STATUS osalSemaphorePost(OsalSemaphore *pSid);
 OSAL_PUBLIC OSAL_STATUS osalSemaphoreGetValue(OsalSemaphore *sid,
                                               UINT32 *value);
 
+/**
+ * @ingroup Osal
+ *
+ * @brief Initializes a completion
+ *
+ * @param pComp - completion object
+ *
+ * Initializes a one-shot completion in the pending state. The completion
+ * is held by value in the caller's structure, so no memory is allocated.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionInit(OsalCompletion *pComp);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Waits for a completion to be signalled
+ *
+ * @param pComp - completion object
+ * @param timeout - timeout, in ms; OSAL_WAIT_FOREVER (-1) if the thread
+ * is to block indefinitely or OSAL_WAIT_NONE (0) if the thread is to
+ * return immediately even if the call fails
+ *
+ * Blocks until osalCompletionSignal() has been called on the completion
+ * or the timeout expires.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionWait(OsalCompletion *pComp,
+                                           INT32 timeout);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Non-blocking check of a completion
+ *
+ * @param pComp - completion object
+ *
+ * Returns OSAL_SUCCESS if the completion has been signalled. A successful
+ * check counts as the wait; the completion must not be waited on again.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionTryWait(OsalCompletion *pComp);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Signals a completion
+ *
+ * @param pComp - completion object
+ *
+ * Marks the completion done and wakes any thread waiting on it.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionSignal(OsalCompletion *pComp);
+
+/**
+ * @ingroup Osal
+ *
+ * @brief Destroys a completion
+ *
+ * @param pComp - completion object
+ *
+ * Destroys a completion; no thread may be waiting on it.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionDestroy(OsalCompletion *pComp);
+
 /**
  * @ingroup Osal
  *
@@ -1399,6 +1544,22 @@ OSAL_PUBLIC OSAL_STATUS osalThreadKill(OsalThread *pTid);
  */
 OSAL_PUBLIC void osalThreadExit(void);
 
+/**
+ * @ingroup Osal
+ *
+ * @brief Returns the CPU the current thread runs on
+ *
+ * The answer may be stale as soon as it is returned if the thread is not
+ * bound to a single CPU, so it is only fit for choosing among per CPU
+ * data where any choice is correct.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  no
+ *
+ * @return - the current CPU, or 0 if it cannot be determined
+ */
+OSAL_PUBLIC UINT32 osalGetCurrentCpu(void);
+
 /**
  * @ingroup Osal
  *
@@ -1687,6 +1848,32 @@ osalHashSHA512Full(UINT8 *in, UINT8 *out, UINT32 len);
 OSAL_STATUS
 osalAESEncrypt(UINT8 *key, UINT32 keyLenInBytes, UINT8 *in, UINT8 *out);
 
+/**
+ * @ingroup Osal
+ *
+ * @brief  Multi block AES encrypt in ECB mode
+ *
+ * @param  key - pointer to symmetric key.
+ *         keyLenInBytes - key length
+ *         in - pointer to data to encrypt
+ *         out - pointer to output buffer for encrypted text
+ *         numBlocks - number of AES blocks (16 bytes) to encrypt
+ *         The key schedule is computed once and applied to every block,
+ *         in and out may point to the same buffer.
+ *
+ * @li Reentrant: yes
+ * @li IRQ safe:  yes
+ *
+ * @return - OSAL_SUCCESS/OSAL_FAIL
+ *
+ */
+OSAL_STATUS
+osalAESEncryptECB(UINT8 *key,
+                  UINT32 keyLenInBytes,
+                  UINT8 *in,
+                  UINT8 *out,
+                  UINT32 numBlocks);
+
 /**
  * @ingroup Osal
  *
@@ -71,6 +71,13 @@ OSAL_PUBLIC OSAL_INLINE void osalAtomicRelease(OsalAtomic *pAtomicVar)
     __sync_lock_release(pAtomicVar);
 }
 
+OSAL_PUBLIC OSAL_INLINE INT64 osalAtomicCmpXchg(INT64 oldValue,
+                                                INT64 newValue,
+                                                OsalAtomic *pAtomicVar)
+{
+    return __sync_val_compare_and_swap(pAtomicVar, oldValue, newValue);
+}
+
 OSAL_PUBLIC OSAL_INLINE INT64 osalAtomicAdd(INT64 inValue,
                                             OsalAtomic *atomicVar)
 {
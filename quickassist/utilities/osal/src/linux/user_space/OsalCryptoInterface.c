@@ -42,6 +42,7 @@
 #include <openssl/md5.h>
 #include <openssl/sha.h>
 #include <openssl/aes.h>
+#include <openssl/evp.h>
 #else
 #include "openssl/md5.h"
 #include "openssl/sha.h"
@@ -266,6 +267,71 @@ osalAESEncrypt(UINT8 *key, UINT32 keyLenInBytes, UINT8 *in, UINT8 *out)
     return OSAL_SUCCESS;
 }
 
+OSAL_STATUS
+osalAESEncryptECB(UINT8 *key,
+                  UINT32 keyLenInBytes,
+                  UINT8 *in,
+                  UINT8 *out,
+                  UINT32 numBlocks)
+{
+#ifdef USE_OPENSSL
+    /* EVP rather than AES_encrypt so that the hardware AES instructions are
+     * used when the CPU has them */
+    const EVP_CIPHER *cipher = NULL;
+    EVP_CIPHER_CTX *ctx = NULL;
+    OSAL_STATUS status = OSAL_FAIL;
+    int outLen = 0;
+
+    switch (keyLenInBytes)
+    {
+        case AES_128_KEY_LEN_BYTES:
+            cipher = EVP_aes_128_ecb();
+            break;
+        case AES_192_KEY_LEN_BYTES:
+            cipher = EVP_aes_192_ecb();
+            break;
+        case AES_256_KEY_LEN_BYTES:
+            cipher = EVP_aes_256_ecb();
+            break;
+        default:
+            return OSAL_FAIL;
+    }
+
+    ctx = EVP_CIPHER_CTX_new();
+    if (NULL == ctx)
+    {
+        return OSAL_FAIL;
+    }
+    if ((1 == EVP_EncryptInit_ex(ctx, cipher, NULL, key, NULL)) &&
+        (1 == EVP_CIPHER_CTX_set_padding(ctx, 0)) &&
+        (1 == EVP_EncryptUpdate(
+                  ctx, out, &outLen, in, (int)(numBlocks * AES_BLOCK_SIZE))))
+    {
+        status = OSAL_SUCCESS;
+    }
+    /* Also clears the key schedule */
+    EVP_CIPHER_CTX_free(ctx);
+    return status;
+#else
+    AES_KEY enc_key;
+    UINT32 i = 0;
+    INT32 status = OSAL_AES_SET_ENCRYPT(
+        key, keyLenInBytes << BYTE_TO_BITS_SHIFT, &enc_key);
+    if (status < 0)
+    {
+        return OSAL_FAIL;
+    }
+    for (i = 0; i < numBlocks; i++)
+    {
+        OSAL_AES_ENCRYPT(in + i * AES_BLOCK_SIZE,
+                         out + i * AES_BLOCK_SIZE,
+                         &enc_key);
+    }
+    osalMemSet(&enc_key, 0, sizeof(enc_key));
+    return OSAL_SUCCESS;
+#endif
+}
+
 #define EXPANDED_KEY_KAT 0xcb5befb4
 static OSAL_STATUS osalAesSetEncryptByteSwap(INT32 *byte_swap)
 {
@@ -0,0 +1,738 @@
+/**
+ * @file OsalFutex.c (linux user space)
+ *
+ * @brief Futex based implementation for semaphore, mutex and completion.
+ *
+ *
+ * @par
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ */
+
+#include <limits.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "Osal.h"
+
+/**********************************************
+ * OSAL Semaphore, Mutex and Completion
+ * Functions implemented directly on Linux
+ * futexes. Selected with --enable-futex-osal
+ * in place of OsalSemaphore.c/OsalMutex.c.
+ *
+ * Every object first tries to take its word
+ * with an atomic operation, then spins for a
+ * short while before sleeping in the kernel.
+ * The spin length adapts to how long the last
+ * acquisitions took. The releasing side only
+ * enters the kernel if a waiter is asleep.
+ *********************************************/
+
+/* Bounds of the adaptive spin, in CPU relax iterations */
+#define OSAL_FUTEX_SPIN_MIN 10
+#define OSAL_FUTEX_SPIN_MAX 200
+
+/* Mutex word values */
+#define OSAL_FUTEX_MUTEX_UNLOCKED 0
+#define OSAL_FUTEX_MUTEX_LOCKED 1
+#define OSAL_FUTEX_MUTEX_CONTENDED 2
+
+/* Completion word values */
+#define OSAL_COMPLETION_PENDING 0
+#define OSAL_COMPLETION_DONE 1
+#define OSAL_COMPLETION_SLEEPING 2
+
+struct OsalFutexSemaphore_s
+{
+    volatile UINT32 count;
+    volatile UINT32 waiters;
+    UINT32 spin;
+};
+
+struct OsalFutexMutex_s
+{
+    volatile UINT32 state;
+    UINT32 spin;
+};
+
+/* Completions are one-shot, so their spin estimate is shared */
+static UINT32 osalCompletionSpin = OSAL_FUTEX_SPIN_MIN;
+
+/* Online CPUs, 0 until first looked up */
+static INT32 osalFutexNumCpus = 0;
+
+static OSAL_INLINE void osalFutexCpuRelax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/*
+ * Returns how long to spin before sleeping. Spinning on a single CPU
+ * only delays the thread that would release us, so it is disabled there.
+ */
+static OSAL_INLINE UINT32 osalFutexSpinLimit(UINT32 *pSpin)
+{
+    INT32 numCpus = __atomic_load_n(&osalFutexNumCpus, __ATOMIC_RELAXED);
+    UINT32 limit;
+
+    if (0 == numCpus)
+    {
+        numCpus = (INT32)sysconf(_SC_NPROCESSORS_ONLN);
+        __atomic_store_n(&osalFutexNumCpus, numCpus, __ATOMIC_RELAXED);
+    }
+    if (numCpus <= 1)
+    {
+        return 0;
+    }
+
+    limit = 2 * __atomic_load_n(pSpin, __ATOMIC_RELAXED) + OSAL_FUTEX_SPIN_MIN;
+
+    return (limit > OSAL_FUTEX_SPIN_MAX) ? OSAL_FUTEX_SPIN_MAX : limit;
+}
+
+/*
+ * Moves the spin estimate an eighth of the way towards the number of
+ * iterations the last wait needed, or towards zero when spinning did not
+ * pay off. Concurrent updates may be lost, which only makes the estimate
+ * slightly less accurate.
+ */
+static OSAL_INLINE void osalFutexSpinUpdate(UINT32 *pSpin, UINT32 spun)
+{
+    INT32 spin = (INT32)__atomic_load_n(pSpin, __ATOMIC_RELAXED);
+
+    spin += ((INT32)spun - spin) / 8;
+    __atomic_store_n(pSpin, (UINT32)spin, __ATOMIC_RELAXED);
+}
+
+/*
+ * Sleeps while *uaddr == val. A NULL deadline waits forever, otherwise
+ * the deadline is an absolute CLOCK_REALTIME time as for sem_timedwait.
+ */
+static INT32 osalFutexWait(volatile UINT32 *uaddr,
+                           UINT32 val,
+                           const struct timespec *deadline)
+{
+    if (NULL == deadline)
+    {
+        return syscall(SYS_futex, uaddr, FUTEX_WAIT_PRIVATE, val, NULL);
+    }
+    return syscall(SYS_futex,
+                   uaddr,
+                   FUTEX_WAIT_BITSET_PRIVATE | FUTEX_CLOCK_REALTIME,
+                   val,
+                   deadline,
+                   NULL,
+                   FUTEX_BITSET_MATCH_ANY);
+}
+
+static OSAL_INLINE void osalFutexWake(volatile UINT32 *uaddr, INT32 nwake)
+{
+    syscall(SYS_futex, uaddr, FUTEX_WAKE_PRIVATE, nwake);
+}
+
+/*
+ * Converts a timeout in ms into an absolute deadline
+ */
+static OSAL_STATUS osalFutexDeadline(INT32 timeout, struct timespec *ts)
+{
+    OsalTimeval timeoutVal, currTime;
+
+    OSAL_MS_TO_TIMEVAL(timeout, &timeoutVal);
+
+    if (OSAL_SUCCESS != osalTimeGet(&currTime))
+    {
+        return OSAL_FAIL;
+    }
+
+    OSAL_TIME_ADD(timeoutVal, currTime);
+    ts->tv_sec = timeoutVal.secs;
+    ts->tv_nsec = timeoutVal.nsecs;
+
+    return OSAL_SUCCESS;
+}
+
+/*
+ * Decrements the count if it is non-zero. The load is sequentially
+ * consistent so that a waiter which has just registered itself cannot
+ * miss a concurrent post.
+ */
+static OSAL_INLINE OSAL_STATUS
+osalFutexSemTryDown(struct OsalFutexSemaphore_s *sem)
+{
+    UINT32 count = __atomic_load_n(&sem->count, __ATOMIC_SEQ_CST);
+
+    while (count > 0)
+    {
+        if (__atomic_compare_exchange_n(&sem->count,
+                                        &count,
+                                        count - 1,
+                                        1,
+                                        __ATOMIC_ACQUIRE,
+                                        __ATOMIC_RELAXED))
+        {
+            return OSAL_SUCCESS;
+        }
+    }
+    return OSAL_FAIL;
+}
+
+/*
+ *   Initializes a semaphore object
+ */
+OSAL_PUBLIC OSAL_STATUS osalSemaphoreInit(OsalSemaphore *sid,
+                                          UINT32 start_value)
+{
+    struct OsalFutexSemaphore_s *sem;
+
+    OSAL_LOCAL_ENSURE(
+        sid, "osalSemaphoreInit():   Null semaphore pointer", OSAL_FAIL);
+
+    if (start_value > SEM_VALUE_MAX)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "osalSemaphoreInit: Failed to initialize semaphore, "
+                "exceeds the max counter value %d \n",
+                SEM_VALUE_MAX);
+        return OSAL_FAIL;
+    }
+
+    sem = osalMemAlloc(sizeof(*sem));
+    if (NULL == sem)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "osalSemaphoreInit: fail to allocate for semaphore \n");
+
+        return OSAL_FAIL;
+    }
+
+    sem->count = start_value;
+    sem->waiters = 0;
+    sem->spin = OSAL_FUTEX_SPIN_MIN;
+    *sid = sem;
+
+    return OSAL_SUCCESS;
+}
+
+/*
+ * Decrements a semaphore, blocking if the
+ * semaphore is unavailable (value is 0).
+ */
+OSAL_PUBLIC OSAL_STATUS osalSemaphoreWait(OsalSemaphore *sid, INT32 timeout)
+{
+    struct OsalFutexSemaphore_s *sem;
+    struct timespec deadline;
+    struct timespec *pDeadline = NULL;
+    UINT32 limit, spun;
+    INT32 err = 0;
+
+    OSAL_LOCAL_ENSURE(
+        sid, "osalSemaphoreWait():   Null semaphore pointer", OSAL_FAIL);
+
+    if (timeout < OSAL_WAIT_FOREVER)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "osalSemaphoreWait(): illegal timeout value \n");
+        return OSAL_FAIL;
+    }
+
+    sem = *sid;
+    if (OSAL_SUCCESS == osalFutexSemTryDown(sem))
+    {
+        return OSAL_SUCCESS;
+    }
+
+    if (OSAL_WAIT_NONE == timeout)
+    {
+        err = EAGAIN;
+        goto fail;
+    }
+
+    limit = osalFutexSpinLimit(&sem->spin);
+    for (spun = 0; spun < limit; spun++)
+    {
+        osalFutexCpuRelax();
+        if (OSAL_SUCCESS == osalFutexSemTryDown(sem))
+        {
+            osalFutexSpinUpdate(&sem->spin, spun);
+            return OSAL_SUCCESS;
+        }
+    }
+    osalFutexSpinUpdate(&sem->spin, 0);
+
+    if (OSAL_WAIT_FOREVER != timeout)
+    {
+        if (OSAL_SUCCESS != osalFutexDeadline(timeout, &deadline))
+        {
+            return OSAL_FAIL;
+        }
+        pDeadline = &deadline;
+    }
+
+    /*
+     * Register as a waiter before re-checking the count; a post either
+     * sees the registration and wakes us or happened early enough for
+     * the re-check to see it.
+     */
+    __atomic_add_fetch(&sem->waiters, 1, __ATOMIC_SEQ_CST);
+    while (OSAL_SUCCESS != osalFutexSemTryDown(sem))
+    {
+        if ((osalFutexWait(&sem->count, 0, pDeadline) < 0) &&
+            (ETIMEDOUT == errno))
+        {
+            err = ETIMEDOUT;
+            break;
+        }
+    }
+    __atomic_sub_fetch(&sem->waiters, 1, __ATOMIC_RELAXED);
+
+    if (0 == err)
+    {
+        return OSAL_SUCCESS;
+    }
+
+fail:
+    osalLog(OSAL_LOG_LVL_ERROR,
+            OSAL_LOG_DEV_STDOUT,
+            "osalSemaphoreWait(): %s\n",
+            strerror(err));
+    return OSAL_FAIL;
+}
+
+/*
+ *  Increments a semaphore object
+ */
+OSAL_PUBLIC OSAL_STATUS osalSemaphorePost(OsalSemaphore *sid)
+{
+    struct OsalFutexSemaphore_s *sem;
+    UINT32 count;
+
+    OSAL_LOCAL_ENSURE(
+        sid, "osalSemaphorePost():   Null semaphore pointer", OSAL_FAIL);
+
+    sem = *sid;
+    count = __atomic_load_n(&sem->count, __ATOMIC_RELAXED);
+    do
+    {
+        if (count >= SEM_VALUE_MAX)
+        {
+            return OSAL_FAIL;
+        }
+    } while (!__atomic_compare_exchange_n(&sem->count,
+                                          &count,
+                                          count + 1,
+                                          1,
+                                          __ATOMIC_SEQ_CST,
+                                          __ATOMIC_RELAXED));
+
+    if (__atomic_load_n(&sem->waiters, __ATOMIC_SEQ_CST) > 0)
+    {
+        osalFutexWake(&sem->count, 1);
+    }
+
+    return OSAL_SUCCESS;
+}
+
+/*
+ * Destroys the semaphore object
+ */
+OSAL_PUBLIC OSAL_STATUS osalSemaphoreDestroy(OsalSemaphore *sid)
+{
+    OSAL_LOCAL_ENSURE(
+        sid, "osalSemaphoreDestroy():   Null semaphore pointer", OSAL_FAIL);
+
+    osalMemFree(*sid);
+    *sid = NULL;
+
+    return OSAL_SUCCESS;
+}
+
+/*
+ * Decrements a semaphore, not blocking the calling thread
+ * if the semaphore is unavailable
+ */
+OSAL_PUBLIC OSAL_STATUS osalSemaphoreTryWait(OsalSemaphore *sid)
+{
+    OSAL_LOCAL_ENSURE(
+        sid, "osalSemaphoreTryWait():   Null semaphore pointer", OSAL_FAIL);
+
+    return osalFutexSemTryDown(*sid);
+}
+
+/*
+ * Retrieves the current value of a semaphore object
+ */
+OSAL_PUBLIC OSAL_STATUS osalSemaphoreGetValue(OsalSemaphore *sid, UINT32 *value)
+{
+    OSAL_LOCAL_ENSURE(
+        sid, "osalSemaphoreGetValue():   Null semaphore pointer", OSAL_FAIL);
+    OSAL_LOCAL_ENSURE(
+        value, "osalSemaphoreGetValue():   Null value pointer", OSAL_FAIL);
+
+    *value = __atomic_load_n(&(*sid)->count, __ATOMIC_RELAXED);
+
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalMutexInit(OsalMutex *mutex)
+{
+    struct OsalFutexMutex_s *pMutex;
+
+    if (NULL == mutex)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "OsalMutexInit: NULL Mutex handle \n");
+
+        return OSAL_FAIL;
+    }
+
+    pMutex = osalMemAlloc(sizeof(*pMutex));
+    if (NULL == pMutex)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "OsalMutexInit: fail to allocate for Mutex \n");
+
+        return OSAL_FAIL;
+    }
+
+    pMutex->state = OSAL_FUTEX_MUTEX_UNLOCKED;
+    pMutex->spin = OSAL_FUTEX_SPIN_MIN;
+    *mutex = pMutex;
+
+    return OSAL_SUCCESS;
+}
+
+static OSAL_INLINE OSAL_STATUS osalFutexMutexTryLock(
+    struct OsalFutexMutex_s *pMutex)
+{
+    UINT32 unlocked = OSAL_FUTEX_MUTEX_UNLOCKED;
+
+    if (__atomic_compare_exchange_n(&pMutex->state,
+                                    &unlocked,
+                                    OSAL_FUTEX_MUTEX_LOCKED,
+                                    0,
+                                    __ATOMIC_ACQUIRE,
+                                    __ATOMIC_RELAXED))
+    {
+        return OSAL_SUCCESS;
+    }
+    return OSAL_FAIL;
+}
+
+/*
+ * timeout expressed in milliseconds.
+ */
+OSAL_PUBLIC OSAL_STATUS osalMutexLock(OsalMutex *mutex, INT32 timeout)
+{
+    struct OsalFutexMutex_s *pMutex;
+    struct timespec deadline;
+    struct timespec *pDeadline = NULL;
+    UINT32 limit, spun;
+
+    OSAL_PTR_ENSURE(mutex, "osalMutexLock():   Null mutex pointer", OSAL_FAIL);
+
+    if ((timeout < 0) && (timeout != OSAL_WAIT_FOREVER))
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "OsalMutexLock(): illegal timeout value \n");
+
+        return OSAL_FAIL;
+    }
+
+    pMutex = *mutex;
+    if (OSAL_SUCCESS == osalFutexMutexTryLock(pMutex))
+    {
+        return OSAL_SUCCESS;
+    }
+
+    if (OSAL_WAIT_NONE == timeout)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "OsalMutexLock(): Failed to Lock Mutex \n");
+
+        return OSAL_FAIL;
+    }
+
+    limit = osalFutexSpinLimit(&pMutex->spin);
+    for (spun = 0; spun < limit; spun++)
+    {
+        osalFutexCpuRelax();
+        if ((OSAL_FUTEX_MUTEX_UNLOCKED ==
+             __atomic_load_n(&pMutex->state, __ATOMIC_RELAXED)) &&
+            (OSAL_SUCCESS == osalFutexMutexTryLock(pMutex)))
+        {
+            osalFutexSpinUpdate(&pMutex->spin, spun);
+            return OSAL_SUCCESS;
+        }
+    }
+    osalFutexSpinUpdate(&pMutex->spin, 0);
+
+    if (OSAL_WAIT_FOREVER != timeout)
+    {
+        if (OSAL_SUCCESS != osalFutexDeadline(timeout, &deadline))
+        {
+            return OSAL_FAIL;
+        }
+        pDeadline = &deadline;
+    }
+
+    /*
+     * Mark the mutex contended so that the owner wakes us on unlock. If
+     * the exchange returns UNLOCKED the lock was taken, conservatively
+     * left in the contended state.
+     */
+    while (OSAL_FUTEX_MUTEX_UNLOCKED !=
+           __atomic_exchange_n(
+               &pMutex->state, OSAL_FUTEX_MUTEX_CONTENDED, __ATOMIC_ACQUIRE))
+    {
+        if ((osalFutexWait(&pMutex->state,
+                           OSAL_FUTEX_MUTEX_CONTENDED,
+                           pDeadline) < 0) &&
+            (ETIMEDOUT == errno))
+        {
+            osalLog(OSAL_LOG_LVL_ERROR,
+                    OSAL_LOG_DEV_STDOUT,
+                    "OsalMutexLock(): Failed to Lock Mutex \n");
+
+            return OSAL_FAIL;
+        }
+    }
+
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalMutexUnlock(OsalMutex *mutex)
+{
+    UINT32 state;
+
+    OSAL_PTR_ENSURE(
+        mutex, "osalMutexUnlock():   Null mutex pointer", OSAL_FAIL);
+
+    state = __atomic_exchange_n(
+        &(*mutex)->state, OSAL_FUTEX_MUTEX_UNLOCKED, __ATOMIC_RELEASE);
+    if (OSAL_FUTEX_MUTEX_CONTENDED == state)
+    {
+        osalFutexWake(&(*mutex)->state, 1);
+    }
+    else if (OSAL_FUTEX_MUTEX_UNLOCKED == state)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "OsalMutexUnlock(): Failed to Unlock Mutex \n");
+
+        return OSAL_FAIL;
+    }
+
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalMutexDestroy(OsalMutex *mutex)
+{
+    OSAL_PTR_ENSURE(
+        mutex, "osalMutexDestroy():   Null mutex pointer", OSAL_FAIL);
+
+    if (OSAL_FUTEX_MUTEX_UNLOCKED !=
+        __atomic_load_n(&(*mutex)->state, __ATOMIC_RELAXED))
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "OsalMutexDestroy(): Failed to Destroy Mutex \n");
+
+        return OSAL_FAIL;
+    }
+
+    osalMemFree((void *)*mutex);
+    *mutex = NULL;
+
+    return OSAL_SUCCESS;
+}
+
+/*
+ * Initializes a completion in the pending state
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionInit(OsalCompletion *pComp)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionInit():   Null completion pointer", OSAL_FAIL);
+
+    __atomic_store_n(&pComp->state, OSAL_COMPLETION_PENDING, __ATOMIC_RELAXED);
+
+    return OSAL_SUCCESS;
+}
+
+/*
+ * Waits for a completion to be signalled
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionWait(OsalCompletion *pComp,
+                                           INT32 timeout)
+{
+    struct timespec deadline;
+    struct timespec *pDeadline = NULL;
+    UINT32 limit, spun, state;
+
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionWait():   Null completion pointer", OSAL_FAIL);
+
+    if (timeout < OSAL_WAIT_FOREVER)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "osalCompletionWait(): illegal timeout value \n");
+        return OSAL_FAIL;
+    }
+
+    if (OSAL_COMPLETION_DONE ==
+        __atomic_load_n(&pComp->state, __ATOMIC_ACQUIRE))
+    {
+        return OSAL_SUCCESS;
+    }
+
+    if (OSAL_WAIT_NONE == timeout)
+    {
+        return OSAL_FAIL;
+    }
+
+    limit = osalFutexSpinLimit(&osalCompletionSpin);
+    for (spun = 0; spun < limit; spun++)
+    {
+        osalFutexCpuRelax();
+        if (OSAL_COMPLETION_DONE ==
+            __atomic_load_n(&pComp->state, __ATOMIC_ACQUIRE))
+        {
+            osalFutexSpinUpdate(&osalCompletionSpin, spun);
+            return OSAL_SUCCESS;
+        }
+    }
+    osalFutexSpinUpdate(&osalCompletionSpin, 0);
+
+    if (OSAL_WAIT_FOREVER != timeout)
+    {
+        if (OSAL_SUCCESS != osalFutexDeadline(timeout, &deadline))
+        {
+            return OSAL_FAIL;
+        }
+        pDeadline = &deadline;
+    }
+
+    for (;;)
+    {
+        state = OSAL_COMPLETION_PENDING;
+        /* Announce the sleeper so that the signaller issues a wake */
+        if (!__atomic_compare_exchange_n(&pComp->state,
+                                         &state,
+                                         OSAL_COMPLETION_SLEEPING,
+                                         0,
+                                         __ATOMIC_ACQUIRE,
+                                         __ATOMIC_ACQUIRE) &&
+            (OSAL_COMPLETION_DONE == state))
+        {
+            return OSAL_SUCCESS;
+        }
+
+        if ((osalFutexWait(&pComp->state, OSAL_COMPLETION_SLEEPING, pDeadline) <
+             0) &&
+            (ETIMEDOUT == errno))
+        {
+            break;
+        }
+    }
+
+    if (OSAL_COMPLETION_DONE ==
+        __atomic_load_n(&pComp->state, __ATOMIC_ACQUIRE))
+    {
+        return OSAL_SUCCESS;
+    }
+
+    osalLog(OSAL_LOG_LVL_ERROR,
+            OSAL_LOG_DEV_STDOUT,
+            "osalCompletionWait(): %s\n",
+            strerror(ETIMEDOUT));
+    return OSAL_FAIL;
+}
+
+/*
+ * Checks whether a completion has been signalled, without blocking
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionTryWait(OsalCompletion *pComp)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionTryWait():   Null completion pointer", OSAL_FAIL);
+
+    return (OSAL_COMPLETION_DONE ==
+            __atomic_load_n(&pComp->state, __ATOMIC_ACQUIRE))
+               ? OSAL_SUCCESS
+               : OSAL_FAIL;
+}
+
+/*
+ * Signals a completion. The futex is only woken if a waiter has gone to
+ * sleep; the wake may land after the waiter has already returned, which
+ * is harmless because futex waiters always re-check their word.
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionSignal(OsalCompletion *pComp)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionSignal():   Null completion pointer", OSAL_FAIL);
+
+    if (OSAL_COMPLETION_SLEEPING ==
+        __atomic_exchange_n(
+            &pComp->state, OSAL_COMPLETION_DONE, __ATOMIC_RELEASE))
+    {
+        osalFutexWake(&pComp->state, INT_MAX);
+    }
+
+    return OSAL_SUCCESS;
+}
+
+/*
+ * Destroys a completion; nothing is allocated so there is nothing to free
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionDestroy(OsalCompletion *pComp)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionDestroy():   Null completion pointer", OSAL_FAIL);
+
+    return OSAL_SUCCESS;
+}
@@ -87,18 +87,17 @@ OSAL_PUBLIC OSAL_STATUS osalSemaphoreInit(OsalSemaphore *sid,
 }
 
 /*
- * Decrements a semaphore, blocking if the
- * semaphore is unavailable (value is 0).
+ * Decrements a POSIX semaphore with an OSAL timeout; shared by the
+ * semaphore and completion wait functions.
  */
-OSAL_PUBLIC OSAL_STATUS osalSemaphoreWait(OsalSemaphore *sid, INT32 timeout)
+static OSAL_STATUS osalPosixSemWait(sem_t *sem,
+                                    INT32 timeout,
+                                    const char *caller)
 {
     INT32 status;
     OsalTimeval timeoutVal, currTime;
     struct timespec ts;
 
-    OSAL_LOCAL_ENSURE(
-        sid, "osalSemaphoreWait():   Null semaphore pointer", OSAL_FAIL);
-
     /*
      * Guard against illegal timeout values
      * OSAL_WAIT_FORVER = -1
@@ -107,7 +106,8 @@ OSAL_PUBLIC OSAL_STATUS osalSemaphoreWait(OsalSemaphore *sid, INT32 timeout)
     {
         osalLog(OSAL_LOG_LVL_ERROR,
                 OSAL_LOG_DEV_STDOUT,
-                "osalSemaphoreWait(): illegal timeout value \n");
+                "%s(): illegal timeout value \n",
+                caller);
         return OSAL_FAIL;
     }
     /*
@@ -122,14 +122,14 @@ OSAL_PUBLIC OSAL_STATUS osalSemaphoreWait(OsalSemaphore *sid, INT32 timeout)
     {
         do
         {
-            status = sem_wait(*sid);
+            status = sem_wait(sem);
         } while (status < 0 && EINTR == errno);
     }
     else if (timeout == OSAL_WAIT_NONE)
     {
         do
         {
-            status = sem_trywait(*sid);
+            status = sem_trywait(sem);
         } while (status < 0 && EINTR == errno);
     }
     else
@@ -154,7 +154,7 @@ OSAL_PUBLIC OSAL_STATUS osalSemaphoreWait(OsalSemaphore *sid, INT32 timeout)
         {
             ts.tv_sec = timeoutVal.secs;
             ts.tv_nsec = timeoutVal.nsecs;
-            status = sem_timedwait(*sid, &ts);
+            status = sem_timedwait(sem, &ts);
         } while ((status == -1) && (errno == EINTR));
     }
 
@@ -162,7 +162,8 @@ OSAL_PUBLIC OSAL_STATUS osalSemaphoreWait(OsalSemaphore *sid, INT32 timeout)
     {
         osalLog(OSAL_LOG_LVL_ERROR,
                 OSAL_LOG_DEV_STDOUT,
-                "osalSemaphoreWait(): %s\n",
+                "%s(): %s\n",
+                caller,
                 strerror(errno));
         return OSAL_FAIL;
     }
@@ -172,6 +173,18 @@ OSAL_PUBLIC OSAL_STATUS osalSemaphoreWait(OsalSemaphore *sid, INT32 timeout)
     }
 }
 
+/*
+ * Decrements a semaphore, blocking if the
+ * semaphore is unavailable (value is 0).
+ */
+OSAL_PUBLIC OSAL_STATUS osalSemaphoreWait(OsalSemaphore *sid, INT32 timeout)
+{
+    OSAL_LOCAL_ENSURE(
+        sid, "osalSemaphoreWait():   Null semaphore pointer", OSAL_FAIL);
+
+    return osalPosixSemWait(*sid, timeout, "osalSemaphoreWait");
+}
+
 /*
  *  Increments a semaphore object
  */
@@ -263,3 +276,73 @@ OSAL_PUBLIC OSAL_STATUS osalSemaphoreGetValue(OsalSemaphore *sid, UINT32 *value)
         return OSAL_SUCCESS;
     }
 }
+
+/**********************************************
+ * OSAL Completion Functions. With the POSIX
+ * backend a completion is a semaphore held by
+ * value, so it needs no allocation either.
+ *********************************************/
+/*
+ * Initializes a completion in the pending state
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionInit(OsalCompletion *pComp)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionInit():   Null completion pointer", OSAL_FAIL);
+
+    if (sem_init(pComp, OSAL_POSIX_UNSHARED_SEMAPHORE, 0) == -1)
+    {
+        osalLog(OSAL_LOG_LVL_ERROR,
+                OSAL_LOG_DEV_STDOUT,
+                "osalCompletionInit(): %s\n",
+                strerror(errno));
+        return OSAL_FAIL;
+    }
+
+    return OSAL_SUCCESS;
+}
+
+/*
+ * Waits for a completion to be signalled
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionWait(OsalCompletion *pComp,
+                                           INT32 timeout)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionWait():   Null completion pointer", OSAL_FAIL);
+
+    return osalPosixSemWait(pComp, timeout, "osalCompletionWait");
+}
+
+/*
+ * Checks whether a completion has been signalled, without blocking
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionTryWait(OsalCompletion *pComp)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionTryWait():   Null completion pointer", OSAL_FAIL);
+
+    return sem_trywait(pComp) ? OSAL_FAIL : OSAL_SUCCESS;
+}
+
+/*
+ * Signals a completion
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionSignal(OsalCompletion *pComp)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionSignal():   Null completion pointer", OSAL_FAIL);
+
+    return sem_post(pComp) ? OSAL_FAIL : OSAL_SUCCESS;
+}
+
+/*
+ * Destroys a completion
+ */
+OSAL_PUBLIC OSAL_STATUS osalCompletionDestroy(OsalCompletion *pComp)
+{
+    OSAL_LOCAL_ENSURE(
+        pComp, "osalCompletionDestroy():   Null completion pointer", OSAL_FAIL);
+
+    return sem_destroy(pComp) ? OSAL_FAIL : OSAL_SUCCESS;
+}
@@ -46,6 +46,9 @@
 #include <time.h>
 #include <sys/utsname.h>
 #include <sys/time.h>
+#include <sys/random.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include <errno.h>
 #include "Osal.h"
 
@@ -484,3 +487,49 @@ OSAL_PUBLIC void osalYield(void)
 {
     sched_yield();
 }
+
+OSAL_PUBLIC OSAL_STATUS osalGetCurrentNode(UINT32 *pNode)
+{
+    unsigned int cpu = 0;
+    unsigned int node = 0;
+
+    if (NULL == pNode)
+    {
+        return OSAL_FAIL;
+    }
+    if (0 != syscall(SYS_getcpu, &cpu, &node, NULL))
+    {
+        return OSAL_FAIL;
+    }
+
+    *pNode = node;
+    return OSAL_SUCCESS;
+}
+
+OSAL_PUBLIC OSAL_STATUS osalGetRandomBytes(void *pBuf, UINT32 count)
+{
+    UINT8 *pDst = (UINT8 *)pBuf;
+    ssize_t got = 0;
+
+    if (NULL == pBuf)
+    {
+        return OSAL_FAIL;
+    }
+    /* Large requests may be returned in parts, and any read may be
+     * interrupted by a signal */
+    while (count > 0)
+    {
+        got = getrandom(pDst, count, 0);
+        if (got < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return OSAL_FAIL;
+        }
+        pDst += got;
+        count -= (UINT32)got;
+    }
+    return OSAL_SUCCESS;
+}
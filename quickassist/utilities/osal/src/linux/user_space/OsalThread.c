@@ -363,6 +363,19 @@ OSAL_PUBLIC void osalThreadExit(void)
 #endif
 }
 
+OSAL_PUBLIC UINT32 osalGetCurrentCpu(void)
+{
+#ifndef ICP_WITHOUT_THREAD
+    int cpu = sched_getcpu();
+
+    if (cpu > 0)
+    {
+        return (UINT32)cpu;
+    }
+#endif
+    return 0;
+}
+
 /* API to set scheduling policy and priority of an executing thread */
 
 OSAL_PUBLIC OSAL_STATUS osalThreadSetPolicyAndPriority(OsalThread *thread,
@@ -65,7 +65,11 @@ extern "C" {
 
 #ifndef ICP_WITHOUT_THREAD
 typedef pthread_t OsalThread;
+#ifdef OSAL_FUTEX
+typedef struct OsalFutexMutex_s *OsalMutex;
+#else
 typedef pthread_mutex_t *OsalMutex;
+#endif
 typedef pthread_mutex_t *OsalFastMutex;
 typedef pthread_spinlock_t OsalLock;
 typedef pthread_attr_t OsalPosixThreadAttr;
@@ -76,7 +80,17 @@ typedef void *OsalFastMutex;
 typedef int OsalLock;
 typedef int OsalPosixThreadAttr;
 #endif
+#ifdef OSAL_FUTEX
+typedef struct OsalFutexSemaphore_s *OsalSemaphore;
+/* One-shot completion, embedded by value in the object it signals */
+typedef struct OsalCompletion_s
+{
+    volatile uint32_t state;
+} OsalCompletion;
+#else
 typedef sem_t *OsalSemaphore;
+typedef sem_t OsalCompletion;
+#endif
 
 typedef int64_t INT64;   /**< 64-bit signed integer */
 typedef uint64_t UINT64; /**< 64-bit unsigned integer */
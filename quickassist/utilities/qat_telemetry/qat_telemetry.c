@@ -0,0 +1,525 @@
+/*****************************************************************************
+ *
+ * This file is provided under a dual BSD/GPLv2 license.  When using or
+ *   redistributing this file, you may do so under either license.
+ * 
+ *   GPL LICENSE SUMMARY
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ * 
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of version 2 of the GNU General Public License as
+ *   published by the Free Software Foundation.
+ * 
+ *   This program is distributed in the hope that it will be useful, but
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *   General Public License for more details.
+ * 
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin St - Fifth Floor, Boston, MA 02110-1301 USA.
+ *   The full GNU General Public License is included in this distribution
+ *   in the file called LICENSE.GPL.
+ * 
+ *   Contact Information:
+ *   Intel Corporation
+ * 
+ *   BSD LICENSE
+ * 
+ *   Copyright(c) 2007-2022 Intel Corporation. All rights reserved.
+ *   All rights reserved.
+ * 
+ *   Redistribution and use in source and binary forms, with or without
+ *   modification, are permitted provided that the following conditions
+ *   are met:
+ * 
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in
+ *       the documentation and/or other materials provided with the
+ *       distribution.
+ *     * Neither the name of Intel Corporation nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ * 
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *   "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *   OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *   DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *   THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *   (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *   OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * 
+ * 
+ *
+ *****************************************************************************/
+
+/*
+ * qat_telemetry - display the live telemetry published by QAT processes.
+ *
+ * Processes publish their telemetry with icp_sal_TelemetryStart() or by
+ * running with QAT_TELEMETRY_INTERVAL_MS set. This tool reads the shared
+ * memory segments of all of them and shows ring saturation, request rates
+ * and memory pool high-water marks.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <signal.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include "cpa.h"
+#include "icp_sal_telemetry.h"
+
+#define SHM_DIR "/dev/shm"
+#define MAX_PROCESSES 64
+#define READ_RETRIES 1000
+
+#define INTERVAL_MIN 1
+#define INTERVAL_MAX 3600
+#define COUNT_MAX 1000000
+
+#define NSECS_IN_SEC 1000000000.0
+
+struct process
+{
+    pid_t pid;
+    int seen;
+    int valid;
+    icp_sal_telemetry_shm_t snap;
+    icp_sal_telemetry_shm_t prev;
+};
+
+/*
+ * The snapshots are kept global to avoid large allocations on the stack.
+ */
+static struct process processes[MAX_PROCESSES];
+static icp_sal_telemetry_shm_t read_buf;
+
+static const char *type_names[] = { "?", "cy", "sym", "asym", "dc" };
+
+static void usage(char *prog)
+{
+    printf("Usage: %s  [options]\n", prog);
+    printf(" -h, --help\n");
+    printf(" -i, --interval=SECONDS (%d..%d, default 1)\n",
+           INTERVAL_MIN,
+           INTERVAL_MAX);
+    printf(" -n, --count=COUNT      Number of reports, 0 (default) for "
+           "no limit\n");
+    printf(" -p, --pid=PID          Only report this process\n");
+}
+
+static int parse_and_validate_arg(char *arg, int *val, int min, int max)
+{
+    if (!arg)
+        return -EINVAL;
+
+    char *end_ptr;
+    errno = 0;
+    long long temp = strtoll(arg, &end_ptr, 10);
+
+    if (errno == ERANGE || *arg == 0 || *end_ptr != 0 || temp < min ||
+        temp > max)
+        return -EINVAL;
+
+    *val = (int)temp;
+    return 0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * NSECS_IN_SEC + ts.tv_nsec;
+}
+
+/*
+ * Copy a segment under its sequence counter. Returns 0 on success.
+ */
+static int read_segment(const char *name, icp_sal_telemetry_shm_t *snap)
+{
+    icp_sal_telemetry_shm_t *shm;
+    struct stat st;
+    Cpa32U seq;
+    int fd;
+    int i;
+    int ret = -EAGAIN;
+
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+        return -errno;
+    if (fstat(fd, &st) || st.st_size < (off_t)sizeof(*shm))
+    {
+        close(fd);
+        return -EINVAL;
+    }
+    shm = mmap(NULL, sizeof(*shm), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED)
+        return -errno;
+
+    if (shm->magic != ICP_SAL_TELEMETRY_MAGIC ||
+        shm->version != ICP_SAL_TELEMETRY_VERSION ||
+        shm->size != sizeof(*shm))
+    {
+        munmap(shm, sizeof(*shm));
+        return -EINVAL;
+    }
+
+    for (i = 0; i < READ_RETRIES; i++)
+    {
+        seq = __atomic_load_n(&shm->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1)
+        {
+            sched_yield();
+            continue;
+        }
+        memcpy(snap, shm, sizeof(*snap));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (seq == __atomic_load_n(&shm->seq, __ATOMIC_RELAXED))
+        {
+            ret = 0;
+            break;
+        }
+    }
+    munmap(shm, sizeof(*shm));
+
+    if (!ret && (snap->numInstances > ICP_SAL_TELEMETRY_MAX_INSTANCES ||
+                 snap->numPools > ICP_SAL_TELEMETRY_MAX_POOLS))
+        ret = -EINVAL;
+    return ret;
+}
+
+static struct process *find_process(pid_t pid)
+{
+    struct process *free_slot = NULL;
+    int i;
+
+    for (i = 0; i < MAX_PROCESSES; i++)
+    {
+        if (processes[i].pid == pid)
+            return &processes[i];
+        if (!free_slot && !processes[i].pid)
+            free_slot = &processes[i];
+    }
+    if (free_slot)
+    {
+        memset(free_slot, 0, sizeof(*free_slot));
+        free_slot->pid = pid;
+    }
+    return free_slot;
+}
+
+static void scan_segments(pid_t pid_filter)
+{
+    const size_t prefix_len = strlen(ICP_SAL_TELEMETRY_SHM_PREFIX) - 1;
+    struct process *proc;
+    struct dirent *entry;
+    char name[NAME_MAX + 2];
+    char *end_ptr;
+    long pid;
+    DIR *dir;
+    int i;
+
+    for (i = 0; i < MAX_PROCESSES; i++)
+        processes[i].seen = 0;
+
+    dir = opendir(SHM_DIR);
+    if (!dir)
+    {
+        perror("Unable to open " SHM_DIR);
+        return;
+    }
+    while ((entry = readdir(dir)) != NULL)
+    {
+        /* The prefix starts with the '/' that shm_open requires */
+        if (strncmp(entry->d_name,
+                    ICP_SAL_TELEMETRY_SHM_PREFIX + 1,
+                    prefix_len))
+            continue;
+        errno = 0;
+        pid = strtol(entry->d_name + prefix_len, &end_ptr, 10);
+        if (errno || *end_ptr || pid <= 0)
+            continue;
+        if (pid_filter && pid != pid_filter)
+            continue;
+
+        proc = find_process((pid_t)pid);
+        if (!proc)
+            continue;
+        snprintf(name, sizeof(name), "/%s", entry->d_name);
+        if (read_segment(name, &read_buf))
+        {
+            proc->valid = 0;
+            continue;
+        }
+        proc->seen = 1;
+        /* Rates need two different updates of the same publisher */
+        if (proc->valid && read_buf.updateNs == proc->snap.updateNs)
+            continue;
+        if (proc->valid && read_buf.updateNs < proc->snap.updateNs)
+            proc->valid = 0;
+        if (proc->valid)
+            proc->prev = proc->snap;
+        proc->snap = read_buf;
+        proc->valid++;
+    }
+    closedir(dir);
+
+    /* Forget processes whose segment went away */
+    for (i = 0; i < MAX_PROCESSES; i++)
+    {
+        if (processes[i].pid && !processes[i].seen)
+            memset(&processes[i], 0, sizeof(processes[i]));
+    }
+}
+
+static double percent(Cpa32U num, Cpa32U max)
+{
+    return max ? 100.0 * num / max : 0.0;
+}
+
+static void print_ring(const icp_sal_telemetry_instance_t *inst,
+                       const char *ring,
+                       Cpa32U inflight,
+                       Cpa32U max_inflight,
+                       Cpa32U peak,
+                       const char *rates)
+{
+    printf("  %-4s %3u %4u  %-4s %6u/%-6u %6.1f%% %6.1f%%  %s\n",
+           type_names[inst->type < 5 ? inst->type : 0],
+           inst->accelId,
+           inst->instance,
+           ring,
+           inflight,
+           max_inflight,
+           percent(inflight, max_inflight),
+           percent(peak, max_inflight),
+           rates);
+}
+
+static void print_instance(const icp_sal_telemetry_instance_t *inst,
+                           const icp_sal_telemetry_instance_t *prev,
+                           double elapsed_s)
+{
+    char rates[64];
+    Cpa64U errors = inst->numRequestErrors + inst->numCompletedErrors;
+
+    if (!inst->running)
+    {
+        printf("  %-4s %3u %4u  (not running)\n",
+               type_names[inst->type < 5 ? inst->type : 0],
+               inst->accelId,
+               inst->instance);
+        return;
+    }
+
+    if (prev && elapsed_s > 0)
+        snprintf(rates,
+                 sizeof(rates),
+                 "%10.0f %10.0f %8llu",
+                 (inst->numRequests - prev->numRequests) / elapsed_s,
+                 (inst->numCompleted - prev->numCompleted) / elapsed_s,
+                 (unsigned long long)errors);
+    else
+        snprintf(rates,
+                 sizeof(rates),
+                 "%10s %10s %8llu",
+                 "-",
+                 "-",
+                 (unsigned long long)errors);
+
+    if (inst->symMaxInflight)
+    {
+        print_ring(inst,
+                   "sym",
+                   inst->symInflight,
+                   inst->symMaxInflight,
+                   inst->symPeakInflight,
+                   rates);
+        rates[0] = 0;
+    }
+    if (inst->asymMaxInflight)
+    {
+        print_ring(inst,
+                   "asym",
+                   inst->asymInflight,
+                   inst->asymMaxInflight,
+                   inst->asymPeakInflight,
+                   rates);
+        rates[0] = 0;
+    }
+    if (inst->dcMaxInflight)
+    {
+        print_ring(inst,
+                   "dc",
+                   inst->dcInflight,
+                   inst->dcMaxInflight,
+                   inst->dcPeakInflight,
+                   rates);
+    }
+}
+
+static const icp_sal_telemetry_instance_t *find_prev(
+    const icp_sal_telemetry_shm_t *prev,
+    const icp_sal_telemetry_instance_t *inst)
+{
+    Cpa32U i;
+
+    for (i = 0; i < prev->numInstances; i++)
+    {
+        if (prev->instances[i].type == inst->type &&
+            prev->instances[i].accelId == inst->accelId &&
+            prev->instances[i].instance == inst->instance)
+            return &prev->instances[i];
+    }
+    return NULL;
+}
+
+static void print_process(const struct process *proc, double now)
+{
+    const icp_sal_telemetry_shm_t *snap = &proc->snap;
+    const icp_sal_telemetry_pool_t *pool;
+    const icp_sal_telemetry_instance_t *prev;
+    double elapsed_s = 0;
+    Cpa32U i;
+
+    printf("Process %u (%s), %llu updates, last %.1f s ago%s\n",
+           snap->pid,
+           snap->processName[0] ? snap->processName : "-",
+           (unsigned long long)snap->numUpdates,
+           (now - snap->updateNs) / NSECS_IN_SEC,
+           (kill(snap->pid, 0) && errno == ESRCH) ? ", exited" : "");
+    if (proc->valid > 1 && snap->updateNs > proc->prev.updateNs)
+        elapsed_s = (snap->updateNs - proc->prev.updateNs) / NSECS_IN_SEC;
+
+    printf("  %-4s %3s %4s  %-4s %13s %7s %7s  %10s %10s %8s\n",
+           "Type",
+           "Acc",
+           "Inst",
+           "Ring",
+           "In-flight",
+           "Sat",
+           "Peak",
+           "Req/s",
+           "Cmpl/s",
+           "Errors");
+    for (i = 0; i < snap->numInstances; i++)
+    {
+        prev = elapsed_s > 0 ? find_prev(&proc->prev, &snap->instances[i])
+                             : NULL;
+        print_instance(&snap->instances[i], prev, elapsed_s);
+    }
+
+    printf("  %-16s %8s %8s %8s %7s %10s\n",
+           "Pool",
+           "Blocks",
+           "Avail",
+           "MinAvail",
+           "HWM",
+           "Fails");
+    for (i = 0; i < snap->numPools; i++)
+    {
+        pool = &snap->pools[i];
+        printf("  %-16.16s %8u %8u %8u %6.1f%% %10llu\n",
+               pool->name,
+               pool->numBlks,
+               pool->availBlks,
+               pool->minAvailBlks,
+               percent(pool->numBlks - pool->minAvailBlks, pool->numBlks),
+               (unsigned long long)pool->numAllocFails);
+    }
+    printf("\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *opts = "hi:n:p:";
+    const struct option optl[] = {
+        { "help", 0, NULL, 'h' }, { "interval", 1, NULL, 'i' },
+        { "count", 1, NULL, 'n' }, { "pid", 1, NULL, 'p' },
+        { NULL, 0, NULL, 0 }
+    };
+    int interval = 1;
+    int count = 0;
+    int pid = 0;
+    int reports = 0;
+    int found;
+    int opt;
+    int i;
+
+    opt = getopt_long(argc, argv, opts, optl, NULL);
+    while (opt != -1)
+    {
+        switch (opt)
+        {
+            case 'h':
+                usage(argv[0]);
+                exit(0);
+            case 'i':
+                if (parse_and_validate_arg(
+                        optarg, &interval, INTERVAL_MIN, INTERVAL_MAX))
+                {
+                    printf("Invalid interval %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'n':
+                if (parse_and_validate_arg(optarg, &count, 0, COUNT_MAX))
+                {
+                    printf("Invalid count %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            case 'p':
+                if (parse_and_validate_arg(optarg, &pid, 1, INT32_MAX))
+                {
+                    printf("Invalid pid %s\n", optarg);
+                    exit(1);
+                }
+                break;
+            default:
+                usage(argv[0]);
+                exit(1);
+        }
+        opt = getopt_long(argc, argv, opts, optl, NULL);
+    }
+
+    for (;;)
+    {
+        scan_segments((pid_t)pid);
+        found = 0;
+        for (i = 0; i < MAX_PROCESSES; i++)
+        {
+            if (processes[i].valid)
+            {
+                print_process(&processes[i], now_ns());
+                found = 1;
+            }
+        }
+        if (!found)
+            printf("No process is publishing QAT telemetry\n\n");
+        fflush(stdout);
+
+        if (count && ++reports >= count)
+            break;
+        sleep(interval);
+    }
+    return 0;
+}